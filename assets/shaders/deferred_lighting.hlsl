@@ -39,11 +39,11 @@ struct PSInput {
     float2 uv : TEXCOORD0;
 };
 
-// G-Buffer textures
+// G-Buffer textures (layout in GBufferData, encoding in GBufferPacking)
 Texture2D g_albedo_ao : register(t0);
-Texture2D g_normal_roughness : register(t1);
+Texture2D g_normal : register(t1);
 Texture2D g_material : register(t2);
-Texture2D g_position_depth : register(t3);
+Texture2D g_depth : register(t3);
 
 SamplerState g_sampler : register(s0);
 
@@ -61,13 +61,16 @@ cbuffer PerFrame : register(b0) {
     float main_light_intensity;
     
     float4x4 inv_view_proj;
+    float4x4 view;
+    
+    uint4 cluster_grid;         // Tiles x, tiles y, depth slices
+    float4 cluster_params;      // Screen width, screen height, slice scale, slice bias
 };
 
 // Light types
 #define LIGHT_TYPE_DIRECTIONAL 0
 #define LIGHT_TYPE_POINT       1
 #define LIGHT_TYPE_SPOT        2
-#define MAX_LIGHTS             32
 
 // Light structure (matches ShaderLightData in C++)
 struct Light {
@@ -83,13 +86,21 @@ struct Light {
     uint type;
     float inner_angle;
     float outer_angle;
-    float _padding1;
+    float falloff;
 };
 
-// Light buffer (cbuffer b1, array of lights)
-cbuffer LightBuffer : register(b1) {
-    Light lights[MAX_LIGHTS];
-};
+// All lights, and per cluster a range of indices into them (built on the CPU, see LightClusterBuilder)
+StructuredBuffer<Light> lights : register(t4);
+StructuredBuffer<uint2> cluster_ranges : register(t5);      // offset, count
+StructuredBuffer<uint> cluster_light_indices : register(t6);
+
+// Cluster of a pixel: screen tile from its position, exponential depth slice from its view depth
+uint GetClusterIndex(float2 pixel, float3 worldPos) {
+    uint2 tile = min(uint2(pixel * cluster_grid.xy / cluster_params.xy), cluster_grid.xy - 1);
+    float view_z = max(mul(view, float4(worldPos, 1.0)).z, 1e-4);
+    uint slice = (uint)clamp(log(view_z) * cluster_params.z + cluster_params.w, 0.0, (float)(cluster_grid.z - 1));
+    return (slice * cluster_grid.y + tile.y) * cluster_grid.x + tile.x;
+}
 
 // PBR Constants
 static const float PI = 3.14159265359;
@@ -178,18 +189,20 @@ float3 CalcDirectionalLight(float3 albedo, float roughness, float metallic, floa
     return brdf * radiance * NoL;
 }
 
+// Fades to zero at the light's range; the falloff exponent shapes the curve
+float DistanceAttenuation(float dist, Light light) {
+    if (light.range <= 0.0) return 1.0;
+    float falloff = light.falloff > 0.0 ? light.falloff : 2.0;
+    return pow(saturate(1.0 - dist / light.range), falloff);
+}
+
 // Point light calculation
 float3 CalcPointLight(float3 albedo, float roughness, float metallic, float specular, float3 worldPos, float3 N, float3 V, Light light) {
     float3 L = light.position - worldPos;
     float dist = length(L);
     L = normalize(L);
     
-    // Attenuation
-    float attenuation = 1.0;
-    if (light.range > 0.0) {
-        attenuation = saturate(1.0 - (dist / light.range));
-        attenuation *= attenuation;
-    }
+    float attenuation = DistanceAttenuation(dist, light);
     
     float NoL = saturate(dot(N, L));
     
@@ -210,12 +223,7 @@ float3 CalcSpotLight(float3 albedo, float roughness, float metallic, float specu
     float cos_angle = dot(normalize(light.direction), -L);
     float spot_atten = saturate((cos_angle - light.outer_angle) / (light.inner_angle - light.outer_angle));
     
-    // Distance attenuation
-    float dist_atten = 1.0;
-    if (light.range > 0.0) {
-        dist_atten = saturate(1.0 - (dist / light.range));
-        dist_atten *= dist_atten;
-    }
+    float dist_atten = DistanceAttenuation(dist, light);
     
     float NoL = saturate(dot(N, L));
     
@@ -226,28 +234,39 @@ float3 CalcSpotLight(float3 albedo, float roughness, float metallic, float specu
     return brdf * radiance * NoL;
 }
 
+float3 DecodeOctahedral(float2 encoded) {
+    float3 n = float3(encoded, 1.0 - abs(encoded.x) - abs(encoded.y));
+    float t = saturate(-n.z);
+    n.xy += float2(n.x >= 0.0 ? -t : t, n.y >= 0.0 ? -t : t);
+    return normalize(n);
+}
+
 float4 PSMain(PSInput input) : SV_TARGET {
-    // Sample G-Buffer
-    float4 albedo_ao = g_albedo_ao.Sample(g_sampler, input.uv);
-    float4 normal_roughness = g_normal_roughness.Sample(g_sampler, input.uv);
-    float4 material = g_material.Sample(g_sampler, input.uv);
-    float4 position_depth = g_position_depth.Sample(g_sampler, input.uv);
+    // Load G-Buffer texels 1:1; with dynamic resolution the viewport covers only part of the targets
+    int3 texel = int3(input.position.xy, 0);
+    float4 albedo_ao = g_albedo_ao.Load(texel);
+    float2 normal = g_normal.Load(texel).rg;
+    float4 material = g_material.Load(texel);
+    float depth = g_depth.Load(texel).r;
     
     // Unpack G-Buffer data
     // RT0: Albedo (RGB) + AO (A)
     float3 albedo = albedo_ao.rgb;
     float ao = albedo_ao.a;
     
-    // RT1: Normal (RGB) + Roughness (A)
-    float3 N = normalize(normal_roughness.rgb * 2.0 - 1.0);
-    float roughness = clamp(normal_roughness.a, MIN_ROUGHNESS, MAX_ROUGHNESS);
+    // RT1: Octahedral normal (RG)
+    float3 N = DecodeOctahedral(normal);
     
-    // RT2: Metallic (R) + Emission (G) + Specular (B) + _padding (A)
-    float metallic = material.r;
-    float emission = material.g;
+    // RT2: Roughness (R) + Metallic (G) + Specular (B) + Emission (A)
+    float roughness = clamp(material.r, MIN_ROUGHNESS, MAX_ROUGHNESS);
+    float metallic = material.g;
     float specular = material.b;
+    float emission = material.a;
     
-    float3 worldPos = position_depth.rgb;
+    // World position from the depth buffer; cluster_params.xy is the size of the shaded region
+    float2 ndc = input.position.xy / cluster_params.xy * float2(2.0, -2.0) + float2(-1.0, 1.0);
+    float4 world = mul(inv_view_proj, float4(ndc, depth, 1.0));
+    float3 worldPos = world.xyz / world.w;
     
     // View direction
     float3 V = normalize(camera_pos - worldPos);
@@ -264,9 +283,10 @@ float4 PSMain(PSInput input) : SV_TARGET {
                                     main_light_dir, main_light_color, main_light_intensity);
     }
     
-    // Additional lights from light buffer
-    for (uint i = 0; i < min(light_count, MAX_LIGHTS); i++) {
-        Light light = lights[i];
+    // Additional lights touching this pixel's cluster
+    uint2 cluster = cluster_ranges[GetClusterIndex(input.position.xy, worldPos)];
+    for (uint i = 0; i < cluster.y; i++) {
+        Light light = lights[cluster_light_indices[cluster.x + i]];
         if (light.intensity <= 0.0) continue;
         
         if (light.type == LIGHT_TYPE_DIRECTIONAL) {
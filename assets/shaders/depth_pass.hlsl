@@ -11,13 +11,28 @@ cbuffer PerFrame : register(b0) {
     float light_intensity;
 };
 
-cbuffer PerObject : register(b1) {
+// Global object table (matches ObjectInfo in render_structs.h), indexed by the object id in the INSTANCE attribute
+struct ObjectInfo {
     float4x4 model;
+    float4x4 prev_model;
     float4x4 inv_model;
+    uint animation_id;
+    uint material_id;
+    uint vertex_id;
+    uint index_id;
+    uint mesh_card_id;
+    uint3 _object_padding;
+    float4 sphere;
+    float3 box_min;
+    float3 box_max;
+    float4 debug_data;
 };
 
+StructuredBuffer<ObjectInfo> objects : register(t0);
+
 struct VSInput {
     float3 position : POSITION0;
+    uint object_id : INSTANCE0;
 };
 
 struct VSOutput {
@@ -26,7 +41,8 @@ struct VSOutput {
 
 VSOutput VSMain(VSInput input) {
     VSOutput output;
-    float4 world_pos = mul(model, float4(input.position, 1.0));
+    ObjectInfo object = objects[input.object_id];
+    float4 world_pos = mul(object.model, float4(input.position, 1.0));
     output.position = mul(proj, mul(view, world_pos));
     return output;
 }
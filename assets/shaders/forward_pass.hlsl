@@ -13,17 +13,32 @@ cbuffer PerFrame : register(b0) {
     float light_intensity;
 };
 
-cbuffer PerObject : register(b1) {
+// Global object table (matches ObjectInfo in render_structs.h), indexed by the object id in the INSTANCE attribute
+struct ObjectInfo {
     float4x4 model;
+    float4x4 prev_model;
     float4x4 inv_model;
+    uint animation_id;
+    uint material_id;
+    uint vertex_id;
+    uint index_id;
+    uint mesh_card_id;
+    uint3 _object_padding;
+    float4 sphere;
+    float3 box_min;
+    float3 box_max;
+    float4 debug_data;
 };
 
+StructuredBuffer<ObjectInfo> objects : register(t0);
+
 // ============================================================================
 // Vertex Shader
 // ============================================================================
 struct VSInput {
     float3 position : POSITION0;
     float3 normal : NORMAL0;
+    uint object_id : INSTANCE0;
 };
 
 struct VSOutput {
@@ -35,9 +50,10 @@ struct VSOutput {
 
 VSOutput VSMain(VSInput input) {
     VSOutput output;
+    ObjectInfo object = objects[input.object_id];
     
     // Transform position to world space
-    float4 world_pos = mul(model, float4(input.position, 1.0));
+    float4 world_pos = mul(object.model, float4(input.position, 1.0));
     output.world_pos = world_pos.xyz;
     
     // Transform to clip space
@@ -45,7 +61,7 @@ VSOutput VSMain(VSInput input) {
     output.position = mul(proj, view_pos);
     
     // Transform normal to world space (using inverse transpose)
-    float3 world_normal = mul((float3x3)inv_model, input.normal);
+    float3 world_normal = mul((float3x3)object.inv_model, input.normal);
     output.world_normal = normalize(world_normal);
     
     // View direction for specular
@@ -1,19 +1,37 @@
 // G-Buffer Pass Shaders
 // Supports both ARM packed texture and individual texture maps
-// Supports both ARM packed texture and individual texture maps
+// Compacted layout: octahedral normals, packed material, no position (rebuilt from depth).
+// Encoding mirrors GBufferPacking in gbuffer_packing.h.
 
 cbuffer PerFrame : register(b0) {
     float4x4 view;
-    float4x4 proj;
+    float4x4 proj;              // Jittered when temporal AA is on
     float3 camera_pos;
     float _padding;
+    float4x4 prev_view_proj;    // Unjittered, previous frame
+    float2 jitter;              // NDC offset in proj
+    float2 _jitter_padding;
 };
 
-cbuffer PerObject : register(b1) {
+// Global object table (matches ObjectInfo in render_structs.h), indexed by the object id in the INSTANCE attribute
+struct ObjectInfo {
     float4x4 model;
+    float4x4 prev_model;
     float4x4 inv_model;
+    uint animation_id;
+    uint material_id;
+    uint vertex_id;
+    uint index_id;
+    uint mesh_card_id;
+    uint3 _object_padding;
+    float4 sphere;
+    float3 box_min;
+    float3 box_max;
+    float4 debug_data;
 };
 
+StructuredBuffer<ObjectInfo> objects : register(t7);
+
 cbuffer Material : register(b2) {
     float4 albedo;
     float roughness;
@@ -48,28 +66,36 @@ struct VSInput {
     float3 position : POSITION0;
     float3 normal : NORMAL0;
     float2 texcoord : TEXCOORD0;
+    uint object_id : INSTANCE0;
 };
 
 struct VSOutput {
     float4 position : SV_POSITION;
-    float3 world_pos : POSITION0;
     float3 world_normal : NORMAL0;
     float2 texcoord : TEXCOORD0;
+    float4 clip_pos : TEXCOORD1;        // Unjittered
+    float4 prev_clip_pos : TEXCOORD2;
 };
 
 VSOutput VSMain(VSInput input) {
     VSOutput output;
+    ObjectInfo object = objects[input.object_id];
     
     // Transform to world space
-    float4 world_pos = mul(model, float4(input.position, 1.0));
-    output.world_pos = world_pos.xyz;
+    float4 world_pos = mul(object.model, float4(input.position, 1.0));
     
     // Transform to clip space
     float4 view_pos = mul(view, world_pos);
     output.position = mul(proj, view_pos);
     
+    // Motion: this frame without jitter against last frame's transform and camera
+    output.clip_pos = output.position;
+    output.clip_pos.xy -= jitter * output.position.w;
+    float4 prev_world_pos = mul(object.prev_model, float4(input.position, 1.0));
+    output.prev_clip_pos = mul(prev_view_proj, prev_world_pos);
+    
     // Transform normal to world space
-    float3 world_normal = mul((float3x3)inv_model, input.normal);
+    float3 world_normal = mul((float3x3)object.inv_model, input.normal);
     output.world_normal = normalize(world_normal);
     
     // Pass through texcoord
@@ -83,18 +109,26 @@ VSOutput VSMain(VSInput input) {
 // ============================================================================
 struct PSInput {
     float4 position : SV_POSITION;
-    float3 world_pos : POSITION0;
     float3 world_normal : NORMAL0;
     float2 texcoord : TEXCOORD0;
+    float4 clip_pos : TEXCOORD1;
+    float4 prev_clip_pos : TEXCOORD2;
 };
 
 struct PSOutput {
     float4 albedo_ao : SV_TARGET0;
-    float4 normal_roughness : SV_TARGET1;
-    float4 material_emission : SV_TARGET2;
-    float4 position_depth : SV_TARGET3;
+    float2 normal : SV_TARGET1;
+    float4 material : SV_TARGET2;
+    float2 velocity : SV_TARGET3;
 };
 
+// Octahedral normal in [-1, 1]: project onto |x| + |y| + |z| = 1, fold the lower half over the diagonals
+float2 EncodeOctahedral(float3 n) {
+    n /= abs(n.x) + abs(n.y) + abs(n.z);
+    float2 sign_not_zero = float2(n.x >= 0.0 ? 1.0 : -1.0, n.y >= 0.0 ? 1.0 : -1.0);
+    return n.z >= 0.0 ? n.xy : (1.0 - abs(n.yx)) * sign_not_zero;
+}
+
 PSOutput PSMain(PSInput input) {
     PSOutput output;
     
@@ -156,32 +190,18 @@ PSOutput PSMain(PSInput input) {
         float3x3 TBN = float3x3(T, B, N);
         N = normalize(mul(tangent_normal, TBN));
     }
-    if (use_normal_map > 0.5) {
-        // Sample normal map and decode from [0,1] to [-1,1]
-        float3 tangent_normal = normal_map.Sample(default_sampler, input.texcoord).xyz * 2.0 - 1.0;
-        
-        // Build tangent space basis
-        float3 up = abs(N.y) < 0.999 ? float3(0, 1, 0) : float3(1, 0, 0);
-        float3 T = normalize(cross(up, N));
-        float3 B = cross(N, T);
-        
-        // Transform from tangent space to world space
-        float3x3 TBN = float3x3(T, B, N);
-        N = normalize(mul(tangent_normal, TBN));
-    }
-    
-    // Pack normal to [0,1] range for storage
-    float3 packed_normal = N * 0.5 + 0.5;
     
     // Output to G-Buffer targets
     // RT0: Albedo (RGB) + AO (A)
     output.albedo_ao = float4(albedo_color, ao);
-    // RT1: Normal (RGB) + Roughness (A)
-    output.normal_roughness = float4(packed_normal, roughness_val);
-    // RT2: Metallic (R) + Emission (G) + Specular (B) + _padding (A)
-    output.material_emission = float4(metallic_val, emission_val, specular, 0.0);
-    // RT3: World Position (RGB) + Depth (A)
-    output.position_depth = float4(input.world_pos, input.position.w);
+    // RT1: Octahedral normal (RG)
+    output.normal = EncodeOctahedral(N);
+    // RT2: Roughness (R) + Metallic (G) + Specular (B) + Emission (A)
+    output.material = float4(roughness_val, metallic_val, specular, emission_val);
+    // RT3: Motion vector in uv, current minus previous (v points down)
+    float2 ndc = input.clip_pos.xy / input.clip_pos.w;
+    float2 prev_ndc = input.prev_clip_pos.xy / input.prev_clip_pos.w;
+    output.velocity = (ndc - prev_ndc) * float2(0.5, -0.5);
     
     return output;
 }
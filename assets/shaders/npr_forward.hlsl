@@ -16,9 +16,21 @@ cbuffer PerFrame : register(b0) {
     float light_intensity;
 };
 
-cbuffer PerObject : register(b1) {
+// Global object table (matches ObjectInfo in render_structs.h), indexed by the object id in the INSTANCE attribute
+struct ObjectInfo {
     float4x4 model;
+    float4x4 prev_model;
     float4x4 inv_model;
+    uint animation_id;
+    uint material_id;
+    uint vertex_id;
+    uint index_id;
+    uint mesh_card_id;
+    uint3 _object_padding;
+    float4 sphere;
+    float3 box_min;
+    float3 box_max;
+    float4 debug_data;
 };
 
 cbuffer Material : register(b2) {
@@ -60,6 +72,7 @@ Texture2D normal_map : register(t1);
 Texture2D light_map : register(t2);    // LightMap: R=metallic, G=ao, B=specular, A=materialType
 Texture2D ramp_map : register(t3);     // Ramp texture for toon shading
 Texture2D depth_texture : register(t4); // Screen space depth for rim light
+StructuredBuffer<ObjectInfo> objects : register(t5);
 
 SamplerState default_sampler : register(s0);
 SamplerState clamp_sampler : register(s1); // For ramp texture (clamp to edge)
@@ -72,6 +85,7 @@ struct VSInput {
     float3 normal : NORMAL0;
     float4 tangent : TANGENT0;
     float2 texcoord : TEXCOORD0;
+    uint object_id : INSTANCE0;
 };
 
 struct VSOutput {
@@ -86,6 +100,7 @@ struct VSOutput {
 
 VSOutput VSMain(VSInput input) {
     VSOutput output;
+    ObjectInfo object = objects[input.object_id];
     
     // Use default values if tangent is not provided
     float4 tangent_val = input.tangent;
@@ -96,7 +111,7 @@ VSOutput VSMain(VSInput input) {
     }
     
     // Transform position to world space
-    float4 world_pos = mul(model, float4(input.position, 1.0));
+    float4 world_pos = mul(object.model, float4(input.position, 1.0));
     output.world_pos = world_pos.xyz;
     
     // Transform to clip space
@@ -105,11 +120,11 @@ VSOutput VSMain(VSInput input) {
     output.clip_pos = output.position;
     
     // Transform normal to world space
-    float3 world_normal = mul((float3x3)inv_model, input.normal);
+    float3 world_normal = mul((float3x3)object.inv_model, input.normal);
     output.world_normal = normalize(world_normal);
     
     // Transform tangent to world space
-    float3 world_tangent = mul((float3x3)model, tangent_val.xyz);
+    float3 world_tangent = mul((float3x3)object.model, tangent_val.xyz);
     output.world_tangent = float4(normalize(world_tangent), tangent_val.w);
     
     // Pass through texcoord
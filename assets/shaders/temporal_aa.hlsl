@@ -0,0 +1,145 @@
+// Temporal AA / Upscale Pass Shaders
+// Reprojects the previous output with the motion vectors, clips it to the current frame's
+// neighbourhood and blends the two at output resolution. Mirrors TemporalAA in temporal_aa.h.
+
+// ============================================================================
+// Vertex Shader
+// ============================================================================
+struct VSOutput {
+    float4 position : SV_POSITION;
+    float2 uv : TEXCOORD0;
+};
+
+// Full-screen triangle, same layout as the deferred lighting pass
+static const float2 positions[3] = {
+    float2(-1.0, -1.0),
+    float2( 3.0, -1.0),
+    float2(-1.0,  3.0)
+};
+
+static const float2 uvs[3] = {
+    float2(0.0, 1.0),
+    float2(2.0, 1.0),
+    float2(0.0, -1.0)
+};
+
+VSOutput VSMain(uint vertex_id : SV_VertexID) {
+    VSOutput output;
+    output.position = float4(positions[vertex_id], 0.0, 1.0);
+    output.uv = uvs[vertex_id];
+    return output;
+}
+
+// ============================================================================
+// Pixel Shader
+// ============================================================================
+struct PSInput {
+    float4 position : SV_POSITION;
+    float2 uv : TEXCOORD0;
+};
+
+struct PSOutput {
+    float4 color : SV_TARGET0;
+    float4 history : SV_TARGET1;
+};
+
+static const float NO_VELOCITY = 1024.0;        // Matches GBufferData::NO_VELOCITY
+
+Texture2D g_scene_color : register(t0);         // Jittered, render_size region at the top left
+Texture2D g_velocity : register(t1);            // Same region, uv motion (current - previous)
+Texture2D g_depth : register(t2);
+Texture2D g_history : register(t3);             // Previous output, output_size
+SamplerState g_sampler : register(s0);
+
+cbuffer TemporalAAParams : register(b0) {
+    float4x4 inv_view_proj;     // Inverse of the jittered view-projection
+    float4x4 prev_view_proj;    // Unjittered, previous frame
+    float2 render_size;
+    float2 output_size;
+    float2 jitter_pixels;       // Render pixels, x right, y down
+    float history_weight;
+    float clamp_gamma;
+    float history_valid;
+    float has_velocity;
+    float2 _padding;
+};
+
+// Pull history towards the box center until it lies inside the box
+float3 clip_to_box(float3 history, float3 box_min, float3 box_max) {
+    float3 center = (box_min + box_max) * 0.5;
+    float3 half_size = (box_max - box_min) * 0.5 + 1e-5;
+    float3 offset = history - center;
+    float3 units = abs(offset / half_size);
+    float max_unit = max(units.x, max(units.y, units.z));
+    return max_unit > 1.0 ? center + offset / max_unit : history;
+}
+
+PSOutput PSMain(PSInput input) {
+    PSOutput output;
+    float2 uv = input.position.xy / output_size;
+
+    // Render texel i was rasterized at i + 0.5 - jitter in unjittered pixels
+    float2 render_pos = uv * render_size;
+    int2 center = int2(floor(render_pos + jitter_pixels));
+    int2 max_texel = int2(render_size) - 1;
+
+    float3 sum = 0.0;
+    float weight_sum = 0.0;
+    float3 moment1 = 0.0;
+    float3 moment2 = 0.0;
+    float3 box_min = 65504.0;
+    float3 box_max = -65504.0;
+    float closest_depth = 1.0;
+    int2 closest = clamp(center, 0, max_texel);
+
+    [unroll]
+    for (int y = -1; y <= 1; ++y) {
+        [unroll]
+        for (int x = -1; x <= 1; ++x) {
+            int2 texel = clamp(center + int2(x, y), 0, max_texel);
+            float3 color = g_scene_color.Load(int3(texel, 0)).rgb;
+            float2 offset = float2(texel) + 0.5 - jitter_pixels - render_pos;
+            float weight = exp(-2.29 * dot(offset, offset));
+            sum += color * weight;
+            weight_sum += weight;
+            moment1 += color;
+            moment2 += color * color;
+            box_min = min(box_min, color);
+            box_max = max(box_max, color);
+
+            // Motion of the nearest surface, so edges carry their foreground motion
+            float depth = g_depth.Load(int3(texel, 0)).r;
+            if (depth < closest_depth) {
+                closest_depth = depth;
+                closest = texel;
+            }
+        }
+    }
+    float3 current = sum / max(weight_sum, 1e-5);
+
+    // Variance box, tightened by the min/max of the neighbourhood
+    float3 mean = moment1 / 9.0;
+    float3 sigma = sqrt(max(moment2 / 9.0 - mean * mean, 0.0));
+    box_min = max(box_min, mean - clamp_gamma * sigma);
+    box_max = min(box_max, mean + clamp_gamma * sigma);
+
+    float2 velocity = has_velocity > 0.5 ? g_velocity.Load(int3(closest, 0)).xy : float2(NO_VELOCITY, NO_VELOCITY);
+    if (velocity.x >= NO_VELOCITY * 0.5) {
+        // Not drawn into the G-buffer (forward or sky): camera motion from depth
+        float2 texel_uv = (float2(closest) + 0.5) / render_size;
+        float4 world = mul(inv_view_proj, float4(texel_uv * float2(2.0, -2.0) + float2(-1.0, 1.0), closest_depth, 1.0));
+        world /= world.w;
+        float4 prev_clip = mul(prev_view_proj, world);
+        float2 prev_uv = prev_clip.xy / prev_clip.w * float2(0.5, -0.5) + 0.5;
+        velocity = (float2(closest) + 0.5 - jitter_pixels) / render_size - prev_uv;
+    }
+
+    float2 history_uv = uv - velocity;
+    bool valid = history_valid > 0.5 && all(history_uv >= 0.0) && all(history_uv <= 1.0);
+    float3 history = clip_to_box(g_history.SampleLevel(g_sampler, history_uv, 0).rgb, box_min, box_max);
+    float3 result = valid ? lerp(current, history, history_weight) : current;
+
+    output.color = float4(result, 1.0);
+    output.history = float4(result, 1.0);
+    return output;
+}
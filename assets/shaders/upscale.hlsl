@@ -0,0 +1,51 @@
+// Upscale Pass Shaders
+// Stretches the dynamic resolution region of the scene color over the back buffer
+
+// ============================================================================
+// Vertex Shader
+// ============================================================================
+struct VSOutput {
+    float4 position : SV_POSITION;
+    float2 uv : TEXCOORD0;
+};
+
+// Full-screen triangle, same layout as the deferred lighting pass
+static const float2 positions[3] = {
+    float2(-1.0, -1.0),
+    float2( 3.0, -1.0),
+    float2(-1.0,  3.0)
+};
+
+static const float2 uvs[3] = {
+    float2(0.0, 1.0),
+    float2(2.0, 1.0),
+    float2(0.0, -1.0)
+};
+
+VSOutput VSMain(uint vertex_id : SV_VertexID) {
+    VSOutput output;
+    output.position = float4(positions[vertex_id], 0.0, 1.0);
+    output.uv = uvs[vertex_id];
+    return output;
+}
+
+// ============================================================================
+// Pixel Shader
+// ============================================================================
+struct PSInput {
+    float4 position : SV_POSITION;
+    float2 uv : TEXCOORD0;
+};
+
+Texture2D g_scene_color : register(t0);
+SamplerState g_sampler : register(s0);
+
+cbuffer UpscaleParams : register(b0) {
+    float2 uv_scale;    // Rendered region / texture size
+    float2 uv_max;      // Center of the region's last texel, keeps bilinear taps inside it
+};
+
+float4 PSMain(PSInput input) : SV_TARGET {
+    float2 uv = min(input.uv * uv_scale, uv_max);
+    return float4(g_scene_color.SampleLevel(g_sampler, uv, 0).rgb, 1.0);
+}
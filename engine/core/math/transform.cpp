@@ -1,4 +1,5 @@
 #include "Transform.h"
+#include <atomic>
 #include <cmath>
 
 Transform::Transform(const Mat4& matrix) {
@@ -20,6 +21,11 @@ Transform::Transform(const Mat4& matrix) {
     update_vector();
 }
 
+uint64_t Transform::next_revision() {
+    static std::atomic<uint64_t> counter{0};
+    return counter.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
 Mat4 Transform::get_matrix() const {
     DirectX::XMMATRIX scale = DirectX::XMMatrixScaling(scale_.x, scale_.y, scale_.z);
     DirectX::XMMATRIX rotation = DirectX::XMMatrixRotationQuaternion(rotation_.load());
@@ -46,16 +52,19 @@ void Transform::set_rotation(const Quaternion& rotation) {
     rotation_ = rotation.normalized();
     euler_angle_ = Math::to_euler_angle(rotation_);
     update_vector();
+    touch();
 }
 
 void Transform::set_rotation(const Vec3& euler_angle) {
     euler_angle_ = euler_angle;
     rotation_ = Math::to_quaternion(euler_angle).normalized();
     update_vector();
+    touch();
 }
 
 Vec3 Transform::translate(const Vec3& translation) {
     position_ += translation;
+    touch();
     return position_;
 }
 
@@ -63,6 +72,7 @@ Vec3 Transform::scale(const Vec3& scale_factor) {
     scale_.x *= scale_factor.x;
     scale_.y *= scale_factor.y;
     scale_.z *= scale_factor.z;
+    touch();
     return scale_;
 }
 
@@ -49,8 +49,8 @@ class Transform {
   inline Vec3 right() const { return right_; }
 
   
-  void set_position(const Vec3& position) { position_ = position; }
-  void set_scale(const Vec3& scale) { scale_ = scale; }
+  void set_position(const Vec3& position) { position_ = position; touch(); }
+  void set_scale(const Vec3& scale) { scale_ = scale; touch(); }
   void set_rotation(const Quaternion& rotation);
   void set_rotation(const Vec3& euler_angle);
 
@@ -80,8 +80,16 @@ class Transform {
     return Transform(get_matrix() * other.get_matrix());
   }
 
+  /**
+   * @brief Changes on every modification. Revisions come from one global counter, so a larger
+   *        revision is always a later change (copies keep the revision of their source).
+   */
+  inline uint64_t get_revision() const { return revision_; }
+
  private:
   void update_vector();
+  void touch() { revision_ = next_revision(); }
+  static uint64_t next_revision();
 
  private:
   Vec3 position_ = Vec3::Zero();
@@ -95,4 +103,6 @@ class Transform {
   Vec3 front_ = Vec3::UnitZ();
   Vec3 up_ = Vec3::UnitY();
   Vec3 right_ = Vec3::UnitX();
+
+  uint64_t revision_ = next_revision();
 };
@@ -4,6 +4,7 @@
 #include "engine/function/framework/entity.h"
 #include "engine/function/input/input.h"
 #include "engine/main/engine_context.h"
+#include "engine/function/render/render_system/frustum_culling.h"
 #include <memory>
 
 void CameraComponent::on_init() {
@@ -80,6 +81,7 @@ void CameraComponent::update_matrix() {
     // The front direction already contains the correct orientation from transform
     view_ = Math::look_at(position_, position_ + front_, Vec3::UnitY());
     proj_ = Math::perspective(Math::to_radians(fovy_), aspect_, near_, far_);
+    frustum_ = extract_frustum(view_ * proj_);
 
 
     move_ = (prev_view_ == view_ && prev_proj_ == proj_) ? false : true;
@@ -5,6 +5,7 @@
 
 #include "engine/main/engine_context.h"
 #include "engine/core/reflect/class_db.h"
+#include "engine/function/render/render_system/render_system.h"
 
 #include <algorithm>
 #include <array>
@@ -13,6 +14,16 @@
 #include <cmath>
 
 
+static RenderLightRegistry* get_light_registry() {
+    auto render_system = EngineContext::render_system();
+    if (!render_system || !render_system->get_light_manager()) return nullptr;
+    return &render_system->get_light_manager()->get_registry();
+}
+
+DirectionalLightComponent::~DirectionalLightComponent() {
+    if (registry_) registry_->remove(this);
+}
+
 void DirectionalLightComponent::on_init() {
     for (int i = 0; i < 4; i++) update_cnts_[i] = update_frequencies_[i];
 }
@@ -22,6 +33,35 @@ void DirectionalLightComponent::on_update(float delta_time) {
         update_cnts_[i]++;
         if (update_cnts_[i] >= update_frequencies_[i]) update_cnts_[i] = 0;
     }
+    if (auto* registry = get_light_registry()) sync_light(*registry);
+}
+
+void DirectionalLightComponent::sync_light(RenderLightRegistry& registry) {
+    if (!enable_ || !get_owner()) {
+        if (registry_) registry_->remove(this);
+        registry_ = nullptr;
+        return;
+    }
+
+    RenderLightDesc desc = light_desc_;
+    auto transform = get_owner()->get_component<TransformComponent>();
+    uint64_t revision = transform ? transform->get_world_revision() : 0;
+    if (!registry_ || revision != transform_revision_) {
+        desc.data.direction = transform ? transform->transform.front() : Vec3(0.0f, -1.0f, 0.0f);
+        transform_revision_ = revision;
+    }
+    desc.data.color = color_;
+    desc.data.intensity = intensity_;
+    desc.data.type = static_cast<uint32_t>(render::LightType::Directional);
+    desc.cast_shadow = cast_shadow_;
+    desc.cascade_split = cascade_split_lambda_;
+
+    // Properties can also be edited through reflection, so compare instead of relying on the setters
+    if (registry_ == &registry && desc == light_desc_) return;
+    if (registry_ && registry_ != &registry) registry_->remove(this);
+    registry.set_light(this, desc);
+    registry_ = &registry;
+    light_desc_ = desc;
 }
 
 void DirectionalLightComponent::update_matrix() {
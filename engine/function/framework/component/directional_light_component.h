@@ -4,6 +4,7 @@
 #include "engine/core/math/math.h"
 #include "engine/core/reflect/math_reflect.h"
 #include "engine/function/render/data/render_structs.h"
+#include "engine/function/render/render_system/render_light_registry.h"
 #include "engine/core/reflect/class_db.h"
 
 #include <array>
@@ -13,7 +14,7 @@ class DirectionalLightComponent : public Component {
     CLASS_DEF(DirectionalLightComponent, Component)
 public:
     DirectionalLightComponent() = default;
-    virtual ~DirectionalLightComponent() = default;
+    virtual ~DirectionalLightComponent();
 
     virtual void on_init();
     virtual void on_update(float delta_time);
@@ -33,10 +34,16 @@ public:
     inline Vec3 get_color() const { return color_; }
     inline float get_intensity() const { return intensity_; }
     inline bool cast_shadow() const { return cast_shadow_; }
+    inline float get_cascade_split() const { return cascade_split_lambda_; }
     inline bool enable() const { return enable_; }
 
     void update_light_info();
 
+    /**
+     * @brief Push the light to registry if its transform or properties changed; disabled lights leave it
+     */
+    void sync_light(RenderLightRegistry& registry);
+
     static void register_class() {
         Registry::add<DirectionalLightComponent>("DirectionalLightComponent")
             .member("color", &DirectionalLightComponent::color_)
@@ -64,6 +71,10 @@ private:
     Vec3 front_ = Vec3::UnitX();
     Vec3 up_ = Vec3::UnitY();
 
+    RenderLightRegistry* registry_ = nullptr;   // Registry holding the light, nullptr if not registered
+    RenderLightDesc light_desc_;                // Last pushed description
+    uint64_t transform_revision_ = 0;           // World revision of light_desc_.data.direction
+
     void update_matrix();
     void update_cascades();
 };
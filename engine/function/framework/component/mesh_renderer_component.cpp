@@ -4,16 +4,20 @@
 #include "engine/function/framework/entity.h"
 #include "engine/main/engine_context.h"
 #include "engine/function/render/render_resource/render_resource_manager.h"
+#include "engine/function/render/render_system/frustum_culling.h"
 #include "engine/core/log/Log.h"
 
 DEFINE_LOG_TAG(LogMeshRenderer, "MeshRenderer");
 
+static RenderProxyScene* get_proxy_scene() {
+    auto render_system = EngineContext::render_system();
+    if (!render_system || !render_system->get_mesh_manager()) return nullptr;
+    return &render_system->get_mesh_manager()->get_proxy_scene();
+}
+
 MeshRendererComponent::~MeshRendererComponent() {
     if (initialized_) {
-        auto render_system = EngineContext::render_system();
-        if (render_system && render_system->get_mesh_manager()) {
-            render_system->get_mesh_manager()->unregister_mesh_renderer(this);
-        }
+        if (auto* proxy_scene = get_proxy_scene()) proxy_scene->remove(this);
     }
     release_object_ids();
 }
@@ -26,27 +30,32 @@ void MeshRendererComponent::on_init() {
         }
     }
     allocate_object_ids();
-    if (model_) {
-        uint32_t submesh_count = model_->get_submesh_count();
-        object_infos_.resize(submesh_count);
-        for (uint32_t i = 0; i < submesh_count; i++) {
-            object_infos_[i] = {};
-            object_infos_[i].material_id = 0;
-            object_infos_[i].vertex_id = 0;
-            object_infos_[i].index_id = 0;
-        }
-    }
-    auto render_system = EngineContext::render_system();
-    if (render_system && render_system->get_mesh_manager()) {
-        render_system->get_mesh_manager()->register_mesh_renderer(this);
-    }
+    proxies_dirty_ = true;
     initialized_ = true;
 }
 
 void MeshRendererComponent::on_update(float delta_time) {
     (void)delta_time;
-    if (!initialized_ || !model_) return;
-    update_object_info();
+    if (!initialized_ || !get_owner()) return;
+    auto transform = get_owner()->get_component<TransformComponent>();
+    if (!transform) return;
+
+    // The render thread fills the GPU object table from the proxies, nothing is uploaded here
+    uint64_t revision = transform->get_world_revision();
+    if (proxies_dirty_ || revision != transform_revision_) {
+        Mat4 model_mat = transform->get_world_matrix();
+        if (auto* proxy_scene = get_proxy_scene()) {
+            if (proxies_dirty_) {
+                std::vector<RenderProxyDesc> descs;
+                collect_render_proxies(descs);
+                proxy_scene->set_proxies(this, std::move(descs), model_mat);
+                proxies_dirty_ = false;
+            } else {
+                proxy_scene->set_transform(this, model_mat);
+            }
+        }
+        transform_revision_ = revision;
+    }
 }
 
 void MeshRendererComponent::allocate_object_ids() {
@@ -71,47 +80,15 @@ void MeshRendererComponent::release_object_ids() {
     object_ids_.clear();
 }
 
-void MeshRendererComponent::update_object_info() {
-    if (!get_owner()) return;
-    auto transform = get_owner()->get_component<TransformComponent>();
-    if (!transform) return;
-    Mat4 model_mat = transform->get_world_matrix();
-    for (uint32_t i = 0; i < object_infos_.size() && i < object_ids_.size(); i++) {
-        object_infos_[i].model = model_mat;
-        object_infos_[i].prev_model = prev_model_;
-        object_infos_[i].inv_model = model_mat.inverse();
-        if (i < materials_.size() && materials_[i]) {
-            object_infos_[i].material_id = materials_[i]->get_material_id();
-        }
-        if (model_ && i < model_->get_submesh_count()) {
-            auto mesh = model_->get_mesh(i);
-            if (mesh) {
-                auto vb = mesh->get_vertex_buffer();
-                auto ib = mesh->get_index_buffer();
-                if (vb) {
-                    object_infos_[i].vertex_id = vb->vertex_id_;
-                }
-                if (ib) {
-                    object_infos_[i].index_id = ib->index_id_;
-                }
-            }
-        }
-        if (object_ids_[i] != 0 && EngineContext::render_resource()) {
-            EngineContext::render_resource()->set_object_info(object_infos_[i], object_ids_[i]);
-        }
-    }
-    prev_model_ = model_mat;
-}
-
 void MeshRendererComponent::set_model(ModelRef model) {
     release_object_ids();
     model_ = model;
+    proxies_dirty_ = true;
     if (model_) {
         uint32_t submesh_count = model_->get_submesh_count();
         materials_.resize(submesh_count);
         if (initialized_) {
             allocate_object_ids();
-            object_infos_.resize(submesh_count);
         }
     }
 }
@@ -124,6 +101,7 @@ void MeshRendererComponent::set_material(MaterialRef material, int32_t index) {
     } else if (static_cast<uint32_t>(index) < materials_.size()) {
         materials_[index] = material;
     }
+    proxies_dirty_ = true;
 }
 
 MaterialRef MeshRendererComponent::get_material(uint32_t index) const {
@@ -133,37 +111,34 @@ MaterialRef MeshRendererComponent::get_material(uint32_t index) const {
     return nullptr;
 }
 
-void MeshRendererComponent::collect_draw_batch(std::vector<render::DrawBatch>& batches) {
-    if (!model_ || !get_owner()) return;
-    auto transform = get_owner()->get_component<TransformComponent>();
-    if (!transform) return;
-    Mat4 model_mat = transform->get_world_matrix();
+void MeshRendererComponent::collect_render_proxies(std::vector<RenderProxyDesc>& descs) const {
+    if (!model_) return;
     for (uint32_t i = 0; i < model_->get_submesh_count(); i++) {
         auto mesh = model_->get_mesh(i);
         if (!mesh) continue;
-        render::DrawBatch batch;
-        batch.object_id = (i < object_ids_.size()) ? object_ids_[i] : 0;
+        RenderProxyDesc desc;
+        desc.object_id = (i < object_ids_.size()) ? object_ids_[i] : 0;
         auto vb = mesh->get_vertex_buffer();
         auto ib = mesh->get_index_buffer();
         if (vb) {
-            batch.vertex_buffer = vb->position_buffer_;
-            batch.normal_buffer = vb->normal_buffer_;
-            batch.tangent_buffer = vb->tangent_buffer_;
-            batch.texcoord_buffer = vb->tex_coord_buffer_;
+            desc.vertex_buffer = vb->position_buffer_;
+            desc.normal_buffer = vb->normal_buffer_;
+            desc.tangent_buffer = vb->tangent_buffer_;
+            desc.texcoord_buffer = vb->tex_coord_buffer_;
         }
         if (ib) {
-            batch.index_buffer = ib->buffer_;
-            batch.index_count = ib->index_num();
+            desc.index_buffer = ib->buffer_;
+            desc.index_count = mesh->get_index_count();    // LOD 0; the buffer also holds coarser levels
         }
-        batch.model_matrix = model_mat;
-        batch.inv_model_matrix = model_mat.inverse();
+        desc.mesh = mesh;
+        desc.local_sphere = mesh->get_bounding_sphere();
+        desc.local_box = mesh->get_bounding_box();
         if (i < materials_.size() && materials_[i]) {
-            batch.material = materials_[i];
+            desc.material = materials_[i];
         } else if (model_->get_material(i)) {
-            batch.material = model_->get_material(i);
+            desc.material = model_->get_material(i);
         }
-        
-        batches.push_back(batch);
+        descs.push_back(std::move(desc));
     }
 }
 
@@ -172,6 +147,13 @@ void MeshRendererComponent::collect_acceleration_structure_instance(
     //####TODO####: Ray tracing support
 }
 
+BoundingBox MeshRendererComponent::get_world_bounding_box() const {
+    if (!model_ || !get_owner()) return BoundingBox{};
+    auto transform = get_owner()->get_component<TransformComponent>();
+    if (!transform) return BoundingBox{};
+    return transform_bounding_box(model_->get_bounding_box(), transform->get_world_matrix());
+}
+
 uint32_t MeshRendererComponent::get_submesh_count() const {
     return model_ ? model_->get_submesh_count() : 0;
 }
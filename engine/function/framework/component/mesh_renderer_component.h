@@ -4,6 +4,7 @@
 #include "engine/function/render/render_resource/model.h"
 #include "engine/function/render/render_resource/material.h"
 #include "engine/function/render/render_pass/mesh_pass.h"
+#include "engine/function/render/render_system/render_proxy_scene.h"
 #include "engine/core/math/math.h"
 #include "engine/core/reflect/class_db.h"
 #include "engine/function/asset/asset_macros.h"
@@ -39,6 +40,9 @@ public:
     
     /**
      * @brief Update component (called each frame)
+     *
+     * Pushes render proxy changes to the render scene only when the model, a material or the
+     * world transform changed since the last update.
      * @param delta_time Time since last frame
      */
     void on_update(float delta_time);
@@ -69,10 +73,10 @@ public:
     MaterialRef get_material(uint32_t index = 0) const;
 
     /**
-     * @brief Collect draw batches for rendering
-     * @param batches Output vector to append draw batches to
+     * @brief Describe one render proxy per submesh
+     * @param descs Output vector to append proxy descriptions to
      */
-    void collect_draw_batch(std::vector<render::DrawBatch>& batches);
+    void collect_render_proxies(std::vector<RenderProxyDesc>& descs) const;
 
     /**
      * @brief Collect ray tracing acceleration structure instances
@@ -81,6 +85,11 @@ public:
     void collect_acceleration_structure_instance(
         std::vector<RHIAccelerationStructureInstanceInfo>& instances);
 
+    /**
+     * @brief World-space AABB enclosing all submeshes
+     */
+    BoundingBox get_world_bounding_box() const;
+
     /**
      * @brief Get the number of submeshes
      */
@@ -93,18 +102,17 @@ public:
 
     // Asset dependency declarations for serialization
 private:
-    void update_object_info();
     void allocate_object_ids();
     void release_object_ids();
 
     // ASSET_DEPS macro declares: ModelRef model_; std::vector<MaterialRef> materials_;
     
-    // Per-submesh object info for GPU
-    std::vector<ObjectInfo> object_infos_;
+    // Per-submesh slots in the GPU object table
     std::vector<uint32_t> object_ids_;
     std::vector<uint32_t> mesh_card_ids_;
 
-    Mat4 prev_model_ = Mat4::Identity();
+    uint64_t transform_revision_ = 0;   // World revision last pushed to the render scene
+    bool proxies_dirty_ = true;         // Model or materials changed since the last push
 
     bool cast_shadow_ = true;
     bool initialized_ = false;
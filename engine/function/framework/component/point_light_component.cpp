@@ -4,10 +4,20 @@
 #include "engine/function/framework/entity.h"
 #include "engine/main/engine_context.h"
 #include "engine/core/reflect/class_db.h"
+#include "engine/function/render/render_system/render_system.h"
 
 REGISTER_CLASS_IMPL(PointLightComponent)
 
+static RenderLightRegistry* get_light_registry() {
+    auto render_system = EngineContext::render_system();
+    if (!render_system || !render_system->get_light_manager()) return nullptr;
+    return &render_system->get_light_manager()->get_registry();
+}
+
 PointLightComponent::~PointLightComponent() {
+    // The world is destroyed before the render system, so the registry is still alive here
+    if (registry_) registry_->remove(this);
+
     /* //####TODO####: RenderResource logic
     if (!EngineContext::destroyed() && point_light_id_ != 0) {
         // EngineContext::render_resource()->release_point_light_id(point_light_id_);
@@ -21,7 +31,36 @@ void PointLightComponent::on_init() {
 }
 
 void PointLightComponent::on_update(float delta_time) {
-    // InitComponentIfNeed();
+    (void)delta_time;
+    if (auto* registry = get_light_registry()) sync_light(*registry);
+}
+
+void PointLightComponent::sync_light(RenderLightRegistry& registry) {
+    if (!enable_ || !get_owner()) {
+        if (registry_) registry_->remove(this);
+        registry_ = nullptr;
+        return;
+    }
+
+    RenderLightDesc desc = light_desc_;
+    auto transform = get_owner()->get_component<TransformComponent>();
+    uint64_t revision = transform ? transform->get_world_revision() : 0;
+    if (!registry_ || revision != transform_revision_) {
+        desc.data.position = transform ? transform->get_world_position() : Vec3::Zero();
+        transform_revision_ = revision;
+    }
+    desc.data.color = color_;
+    desc.data.intensity = intensity_;
+    desc.data.type = static_cast<uint32_t>(render::LightType::Point);
+    desc.data.range = far_;
+    desc.data.falloff = falloff_;
+    desc.cast_shadow = cast_shadow_;
+
+    if (registry_ == &registry && desc == light_desc_) return;
+    if (registry_ && registry_ != &registry) registry_->remove(this);
+    registry.set_light(this, desc);
+    registry_ = &registry;
+    light_desc_ = desc;
 }
 
 void PointLightComponent::update_light_info() {
@@ -4,6 +4,7 @@
 #include "engine/core/math/math.h"
 #include "engine/core/reflect/math_reflect.h"
 #include "engine/function/render/data/render_structs.h"
+#include "engine/function/render/render_system/render_light_registry.h"
 #include "engine/core/reflect/class_db.h"
 #include <cstdint>
 
@@ -17,6 +18,8 @@ public:
     virtual void on_update(float delta_time);
 
     void set_scale(float scale) { this->far_ = scale; }
+    void set_range(float range) { this->far_ = range; }
+    void set_falloff(float falloff) { this->falloff_ = falloff; }
     void set_color(Vec3 color) { this->color_ = color; }
     void set_intensity(float intensity) { this->intensity_ = intensity; }
     void set_cast_shadow(bool cast_shadow) { this->cast_shadow_ = cast_shadow; }
@@ -25,6 +28,8 @@ public:
 
     inline Vec3 get_color() const { return color_; }
     inline float get_intensity() const { return intensity_; }
+    inline float get_range() const { return far_; }
+    inline float get_falloff() const { return falloff_; }
 
     inline BoundingSphere get_bounding_sphere() const { return sphere_; }
     float get_constant_bias() { return constant_bias_; }
@@ -37,6 +42,14 @@ public:
 
     void update_light_info(); // public for manager
 
+    /**
+     * @brief Push the light to registry if its transform or properties changed; disabled lights leave it
+     *
+     * Properties can also be edited through reflection, which bypasses the setters, so the new
+     * description is compared with the last pushed one instead of relying on a flag.
+     */
+    void sync_light(RenderLightRegistry& registry);
+
     // Public members for manager access (based on RD code accessing them directly or via friend)
     // Assuming manager uses getters/setters or public access. 
     // RD code had friend class RenderLightManager.
@@ -53,12 +66,15 @@ public:
             .member("intensity", &PointLightComponent::intensity_)
             .member("cast_shadow", &PointLightComponent::cast_shadow_)
             .member("enable", &PointLightComponent::enable_)
+            .member("range", &PointLightComponent::far_)
+            .member("falloff", &PointLightComponent::falloff_)
             ;
     }
 
 private:
     float near_ = 0.1f;
-    float far_ = 25.0f;
+    float far_ = 25.0f;             // Range: the light fades to zero at this distance
+    float falloff_ = 2.0f;          // Exponent of (1 - distance / range)
     Vec3 color_ = Vec3::Ones();
     float intensity_ = 2.0f;
     float evsm_[2] = {10, 15};
@@ -70,6 +86,10 @@ private:
 
     BoundingSphere sphere_;
     PointLightInfo info_;
+
+    RenderLightRegistry* registry_ = nullptr;   // Registry holding the light, nullptr if not registered
+    RenderLightDesc light_desc_;                // Last pushed description
+    uint64_t transform_revision_ = 0;           // World revision of light_desc_.data.position
 };
 
 CEREAL_REGISTER_TYPE(PointLightComponent);
@@ -33,6 +33,22 @@ public:
         return local * parent_trans->get_world_matrix();
     }
 
+    /**
+     * @brief Latest transform revision along the parent chain
+     *
+     * Changes whenever this transform or any ancestor is modified, so callers can cache
+     * get_world_matrix() and only recompute it when the revision differs.
+     */
+    uint64_t get_world_revision() const {
+        uint64_t revision = transform.get_revision();
+        Entity* owner = get_owner();
+        Entity* parent = owner ? owner->get_parent() : nullptr;
+        auto* parent_trans = parent ? parent->get_component<TransformComponent>() : nullptr;
+        if (!parent_trans) return revision;
+        uint64_t parent_revision = parent_trans->get_world_revision();
+        return parent_revision > revision ? parent_revision : revision;
+    }
+
     /**
      * @brief Get world-space position (extracted from world matrix)
      */
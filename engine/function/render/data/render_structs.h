@@ -12,6 +12,8 @@
 #define DIRECTIONAL_SHADOW_CASCADE_LEVEL 4
 #define MAX_GIZMO_PRIMITIVE_COUNT 8192
 #define CLUSTER_GROUP_SIZE 128
+#define CLUSTER_VERTEX_SIZE 64
+#define CLUSTER_TRIANGLE_SIZE 124
 #define MAX_PER_FRAME_OBJECT_SIZE 16384
 #define MAX_PER_FRAME_CLUSTER_SIZE 65536
 #define MAX_PER_FRAME_CLUSTER_GROUP_SIZE 16384
@@ -306,12 +308,30 @@ struct GizmoDrawData {
 };
 
 struct MeshClusterInfo {
-    uint32_t vertex_id;
-    uint32_t index_id;
-    uint32_t index_offset;
-    float lod_error;
+    uint32_t index_offset = 0;      // First index of the cluster in the mesh index buffer
+    uint32_t triangle_count = 0;    // At most CLUSTER_TRIANGLE_SIZE
+    uint32_t vertex_count = 0;      // Distinct vertices, at most CLUSTER_VERTEX_SIZE
+    float lod_error = 0.0f;
 
     BoundingSphere sphere;
+
+    // Normal cone: every triangle faces away from eyes with dot(normalize(cone_apex - eye), cone_axis) >= cone_cutoff;
+    // cone_cutoff >= 1 means the normals are too spread to cull
+    Vec3 cone_apex = Vec3::Zero();
+    Vec3 cone_axis = Vec3::Zero();
+    float cone_cutoff = 1.0f;
+
+    template<class Archive>
+    void serialize(Archive& ar) {
+        ar(cereal::make_nvp("index_offset", index_offset));
+        ar(cereal::make_nvp("triangle_count", triangle_count));
+        ar(cereal::make_nvp("vertex_count", vertex_count));
+        ar(cereal::make_nvp("lod_error", lod_error));
+        ar(cereal::make_nvp("sphere", sphere));
+        ar(cereal::make_nvp("cone_apex", cone_apex));
+        ar(cereal::make_nvp("cone_axis", cone_axis));
+        ar(cereal::make_nvp("cone_cutoff", cone_cutoff));
+    }
 };
 
 struct MeshClusterGroupInfo {
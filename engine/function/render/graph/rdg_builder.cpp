@@ -560,7 +560,11 @@ RHIBufferRef RDGBuilder::resolve(RDGBufferNodeRef buffer_node) {
 void RDGBuilder::release(RDGTextureNodeRef texture_node, RHIResourceState state) {
     if (texture_node->is_imported()) return;
     if (texture_node->texture_) {
-        RDGTexturePool::get()->release({texture_node->texture_, state});
+        if (texture_node->extraction_) {
+            *texture_node->extraction_ = {texture_node->texture_, state};
+        } else {
+            RDGTexturePool::get()->release({texture_node->texture_, state});
+        }
         texture_node->texture_ = nullptr;
         texture_node->init_state_ = RESOURCE_STATE_UNDEFINED;
     }
@@ -663,6 +667,19 @@ RDGTextureBuilder& RDGTextureBuilder::import(RHITextureRef texture, RHIResourceS
     return *this;
 }
 
+RDGTextureBuilder& RDGTextureBuilder::import(const RDGExtractedTexture& extracted) {
+    // Already resolved, so the graph treats it like a pooled texture from here on
+    this->texture_->texture_ = extracted.texture;
+    this->texture_->info_ = extracted.texture->get_info();
+    this->texture_->init_state_ = extracted.state;
+    return *this;
+}
+
+RDGTextureBuilder& RDGTextureBuilder::extract(RDGExtractedTexture* out) {
+    this->texture_->extraction_ = out;
+    return *this;
+}
+
 RDGTextureBuilder& RDGTextureBuilder::extent(Extent3D extent) {
     texture_->info_.extent = extent;
     return *this;
@@ -63,7 +63,7 @@ class RDGCopyPassBuilder;
  * @brief The main entry point for building and executing the Render Dependency Graph.
  * 
  * **Design Concepts (referenced from UE's RDG):**
- * - RDG has a single-frame lifecycle. Resources allocated (except imported ones) are transient.
+ * - RDG has a single-frame lifecycle. Resources allocated (except imported and extracted ones) are transient.
  * - Resource handles are returned instead of raw pointers, ensuring safety.
  * - Resources are allocated from a pool to minimize overhead.
  * 
@@ -191,6 +191,16 @@ public:
     RDGTextureBuilder(RDGBuilder* builder, RDGTextureNodeRef texture) : builder_(builder), texture_(texture){};
 
     RDGTextureBuilder& import(RHITextureRef texture, RHIResourceState init_state);
+    /**
+     * @brief Bring back a texture extracted by an earlier graph. Unlike import(), it returns to
+     * the pool after its last use in this graph unless it is extracted again.
+     */
+    RDGTextureBuilder& import(const RDGExtractedTexture& extracted);
+    /**
+     * @brief Hand the texture to out after its last pass instead of releasing it to the pool.
+     * out must stay valid until execute() returns.
+     */
+    RDGTextureBuilder& extract(RDGExtractedTexture* out);
     RDGTextureBuilder& extent(Extent3D extent);
     RDGTextureBuilder& format(RHIFormat format);
     RDGTextureBuilder& memory_usage(MemoryUsage memory_usage);
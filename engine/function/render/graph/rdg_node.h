@@ -82,6 +82,15 @@ using RDGResourceNodeRef = RDGResourceNode*;
 
 class RDGPassNode; 
 
+/**
+ * @brief A texture that outlives the graph that produced it, e.g. a temporal history.
+ * Filled by RDGTextureBuilder::extract when the texture's last pass has run.
+ */
+struct RDGExtractedTexture {
+    RHITextureRef texture;
+    RHIResourceState state = RESOURCE_STATE_UNDEFINED;
+};
+
 /**
  * @brief Node representing a Texture resource.
  */
@@ -105,6 +114,7 @@ private:
     RHIResourceState init_state_; 
 
     RHITextureRef texture_; // The actual RHI resource, resolved during execution.
+    RDGExtractedTexture* extraction_ = nullptr; // Receives the texture instead of the pool.
 
     friend class RDGTextureBuilder;
     friend class RDGBuilder;
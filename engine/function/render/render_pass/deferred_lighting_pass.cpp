@@ -2,6 +2,7 @@
 #include "engine/main/engine_context.h"
 #include "engine/function/render/render_system/render_system.h"
 #include "engine/function/render/render_system/render_mesh_manager.h"
+#include "engine/function/render/render_system/light_clustering.h"
 #include "engine/function/render/rhi/rhi_command_list.h"
 #include "engine/function/framework/component/transform_component.h"
 #include "engine/function/framework/component/camera_component.h"
@@ -11,12 +12,51 @@
 #include "engine/core/log/Log.h"
 #include "engine/function/render/render_resource/shader_utils.h"
 
+#include <algorithm>
 #include <cstring>
 
 DEFINE_LOG_TAG(LogDeferredLighting, "DeferredLighting");
 
 namespace render {
 
+namespace {
+
+constexpr uint32_t MIN_STRUCTURED_CAPACITY = 64;
+
+// Write count elements into a dynamic structured buffer, recreating it at twice the size when full
+bool upload_structured(RHIBufferRef& buffer, const void* data, uint32_t count, uint32_t stride, const char* name) {
+    uint64_t size = static_cast<uint64_t>(std::max(count, 1u)) * stride;
+    if (!buffer || buffer->get_info().size < size) {
+        auto backend = EngineContext::rhi();
+        if (!backend) return false;
+
+        uint64_t capacity = buffer ? buffer->get_info().size : static_cast<uint64_t>(MIN_STRUCTURED_CAPACITY) * stride;
+        while (capacity < size) capacity *= 2;
+
+        RHIBufferInfo info = {};
+        info.size = capacity;
+        info.stride = stride;
+        info.memory_usage = MEMORY_USAGE_CPU_TO_GPU;
+        info.type = RESOURCE_TYPE_BUFFER;
+        RHIBufferRef new_buffer = backend->create_buffer(info);
+        if (!new_buffer) {
+            ERR(LogDeferredLighting, "Failed to create {} buffer of {} bytes", name, capacity);
+            return false;
+        }
+        backend->set_name(new_buffer, name);
+        if (buffer) buffer->destroy();
+        buffer = new_buffer;
+    }
+
+    void* mapped = buffer->map();
+    if (!mapped) return false;
+    if (count > 0) memcpy(mapped, data, static_cast<size_t>(count) * stride);
+    buffer->unmap();
+    return true;
+}
+
+} // namespace
+
 DeferredLightingPass::DeferredLightingPass() = default;
 
 DeferredLightingPass::~DeferredLightingPass() {
@@ -26,6 +66,8 @@ DeferredLightingPass::~DeferredLightingPass() {
     if (quad_index_buffer_) quad_index_buffer_->destroy();
     if (per_frame_buffer_) per_frame_buffer_->destroy();
     if (light_buffer_) light_buffer_->destroy();
+    if (cluster_range_buffer_) cluster_range_buffer_->destroy();
+    if (cluster_index_buffer_) cluster_index_buffer_->destroy();
     if (gbuffer_sampler_) gbuffer_sampler_->destroy();
 }
 
@@ -179,19 +221,7 @@ void DeferredLightingPass::create_uniform_buffers() {
         return;
     }
     
-    // Light array buffer (cbuffer b1)
-    RHIBufferInfo light_info = {};
-    light_info.size = sizeof(ShaderLightData) * MAX_LIGHTS;
-    light_info.stride = 0;
-    light_info.memory_usage = MEMORY_USAGE_CPU_TO_GPU;
-    light_info.type = RESOURCE_TYPE_UNIFORM_BUFFER;
-    light_info.creation_flag = BUFFER_CREATION_PERSISTENT_MAP;
-    
-    light_buffer_ = backend->create_buffer(light_info);
-    if (!light_buffer_) {
-        ERR(LogDeferredLighting, "Failed to create light buffer");
-        return;
-    }
+    // Light and cluster buffers are structured buffers sized on first upload (upload_light_data)
     
     // Create sampler for GBuffer textures
     RHISamplerInfo sampler_info = {};
@@ -269,11 +299,51 @@ void DeferredLightingPass::set_main_light(const Vec3& dir, const Vec3& color, fl
 
 void DeferredLightingPass::set_lights(const std::vector<ShaderLightData>& lights) {
     lights_data_ = lights;
-    per_frame_data_.light_count = static_cast<uint32_t>(std::min(lights.size(), static_cast<size_t>(MAX_LIGHTS)));
+    per_frame_data_.light_count = static_cast<uint32_t>(lights.size());
     per_frame_dirty_ = true;
     lights_dirty_ = true;
 }
 
+void DeferredLightingPass::set_light_clusters(const Mat4& view, const LightClusterBuilder* clusters) {
+    clusters_ = clusters;
+    per_frame_data_.view = view;
+    per_frame_data_.cluster_grid[0] = LightClusterBuilder::GRID_X;
+    per_frame_data_.cluster_grid[1] = LightClusterBuilder::GRID_Y;
+    per_frame_data_.cluster_grid[2] = LightClusterBuilder::GRID_Z;
+    per_frame_data_.cluster_grid[3] = 0;
+    if (clusters) {
+        per_frame_data_.cluster_params.z = clusters->get_slice_scale();
+        per_frame_data_.cluster_params.w = clusters->get_slice_bias();
+    }
+    per_frame_dirty_ = true;
+}
+
+void DeferredLightingPass::upload_light_data(RHICommandListRef command) {
+    if (lights_dirty_) {
+        if (upload_structured(light_buffer_, lights_data_.data(), static_cast<uint32_t>(lights_data_.size()),
+                              sizeof(ShaderLightData), "DeferredLighting_Lights")) {
+            lights_dirty_ = false;
+        }
+    }
+
+    // Clusters follow the camera, so they are uploaded every frame; no clusters means no extra lights
+    static const std::vector<LightClusterRange> EMPTY_RANGES(LightClusterBuilder::CLUSTER_COUNT);
+    const std::vector<LightClusterRange>& ranges = clusters_ ? clusters_->get_ranges() : EMPTY_RANGES;
+    upload_structured(cluster_range_buffer_, ranges.data(), static_cast<uint32_t>(ranges.size()),
+                      sizeof(LightClusterRange), "DeferredLighting_ClusterRanges");
+    if (clusters_) {
+        const std::vector<LightClusterIndex>& indices = clusters_->get_indices();
+        upload_structured(cluster_index_buffer_, indices.data(), static_cast<uint32_t>(indices.size()),
+                          sizeof(LightClusterIndex), "DeferredLighting_ClusterIndices");
+    } else {
+        upload_structured(cluster_index_buffer_, nullptr, 0, sizeof(LightClusterIndex), "DeferredLighting_ClusterIndices");
+    }
+
+    if (light_buffer_) command->bind_buffer(light_buffer_, 4, SHADER_FREQUENCY_FRAGMENT);
+    if (cluster_range_buffer_) command->bind_buffer(cluster_range_buffer_, 5, SHADER_FREQUENCY_FRAGMENT);
+    if (cluster_index_buffer_) command->bind_buffer(cluster_index_buffer_, 6, SHADER_FREQUENCY_FRAGMENT);
+}
+
 
 void DeferredLightingPass::build(RDGBuilder& builder) {
     if (!initialized_ || !pipeline_) {
@@ -320,11 +390,13 @@ void DeferredLightingPass::build(RDGBuilder& builder, const GBufferOutputHandles
 void DeferredLightingPass::build(RDGBuilder& builder, RDGTextureHandle color_target) {
     // Get GBuffer texture nodes from blackboard (created by GBufferPass)
     auto albedo_node = builder.get_blackboard().texture("GBuffer_AlbedoAO");
-    auto normal_node = builder.get_blackboard().texture("GBuffer_NormalRoughness");
+    auto normal_node = builder.get_blackboard().texture("GBuffer_Normal");
     auto material_node = builder.get_blackboard().texture("GBuffer_Material");
-    auto position_node = builder.get_blackboard().texture("GBuffer_Position");
+    // Scene depth imported by RenderSystem, or the one created by the mesh manager without it
+    auto depth_node = builder.get_blackboard().texture("Depth");
+    if (!depth_node) depth_node = builder.get_blackboard().texture("DepthPrePass_Depth");
     
-    if (!albedo_node || !normal_node || !material_node || !position_node) {
+    if (!albedo_node || !normal_node || !material_node || !depth_node) {
         ERR(LogDeferredLighting, "Failed to get GBuffer textures from blackboard");
         return;
     }
@@ -334,7 +406,7 @@ void DeferredLightingPass::build(RDGBuilder& builder, RDGTextureHandle color_tar
         albedo_node->get_handle(),
         normal_node->get_handle(),
         material_node->get_handle(),
-        position_node->get_handle()
+        depth_node->get_handle()
     };
     build(builder, color_target, gbuffer);
 }
@@ -350,15 +422,19 @@ void DeferredLightingPass::build(RDGBuilder& builder, RDGTextureHandle color_tar
     auto swapchain = render_system->get_swapchain();
     if (!swapchain) return;
     
-    Extent2D extent = swapchain->get_extent();
+    // Shade the dynamic resolution region only; cluster tiles are laid over it
+    Extent2D extent = render_system->get_render_extent();
+    per_frame_data_.cluster_params.x = static_cast<float>(extent.width);
+    per_frame_data_.cluster_params.y = static_cast<float>(extent.height);
+    per_frame_dirty_ = true;
     
     // Declare read dependencies on GBuffer textures via RDG
     auto rp_builder = builder.create_render_pass("DeferredLighting_Pass")
         .color(0, color_target, ATTACHMENT_LOAD_OP_LOAD, ATTACHMENT_STORE_OP_STORE)
         .read(0, 0, 0, gbuffer.albedo_ao)
-        .read(0, 1, 0, gbuffer.normal_roughness)
-        .read(0, 2, 0, gbuffer.material_emission)
-        .read(0, 3, 0, gbuffer.position_depth);
+        .read(0, 1, 0, gbuffer.normal)
+        .read(0, 2, 0, gbuffer.material)
+        .read(0, 3, 0, gbuffer.depth);
     
     // Capture handles for resolving in execute lambda
     auto gb = gbuffer;
@@ -373,15 +449,15 @@ void DeferredLightingPass::build(RDGBuilder& builder, RDGTextureHandle color_tar
         
         // Resolve GBuffer textures from RDG handles (already allocated by prepare_descriptor_set)
         RHITextureRef albedo_tex = context.builder->resolve(gb.albedo_ao);
-        RHITextureRef normal_tex = context.builder->resolve(gb.normal_roughness);
-        RHITextureRef material_tex = context.builder->resolve(gb.material_emission);
-        RHITextureRef position_tex = context.builder->resolve(gb.position_depth);
+        RHITextureRef normal_tex = context.builder->resolve(gb.normal);
+        RHITextureRef material_tex = context.builder->resolve(gb.material);
+        RHITextureRef depth_tex = context.builder->resolve(gb.depth);
         
         // Bind GBuffer textures (manual binding for DX11 backend)
         if (albedo_tex)  cmd->bind_texture(albedo_tex, 0, SHADER_FREQUENCY_FRAGMENT);
         if (normal_tex)  cmd->bind_texture(normal_tex, 1, SHADER_FREQUENCY_FRAGMENT);
         if (material_tex) cmd->bind_texture(material_tex, 2, SHADER_FREQUENCY_FRAGMENT);
-        if (position_tex) cmd->bind_texture(position_tex, 3, SHADER_FREQUENCY_FRAGMENT);
+        if (depth_tex) cmd->bind_texture(depth_tex, 3, SHADER_FREQUENCY_FRAGMENT);
         
         // Bind sampler for GBuffer textures
         if (gbuffer_sampler_) {
@@ -401,22 +477,8 @@ void DeferredLightingPass::build(RDGBuilder& builder, RDGTextureHandle color_tar
                 static_cast<ShaderFrequency>(SHADER_FREQUENCY_VERTEX | SHADER_FREQUENCY_FRAGMENT));
         }
         
-        // Upload and bind light buffer (cbuffer b1)
-        if (light_buffer_ && lights_dirty_) {
-            void* mapped = light_buffer_->map();
-            if (mapped) {
-                size_t copy_count = std::min(lights_data_.size(), static_cast<size_t>(MAX_LIGHTS));
-                memset(mapped, 0, sizeof(ShaderLightData) * MAX_LIGHTS);
-                if (copy_count > 0) {
-                    memcpy(mapped, lights_data_.data(), sizeof(ShaderLightData) * copy_count);
-                }
-                light_buffer_->unmap();
-            }
-            lights_dirty_ = false;
-        }
-        if (light_buffer_) {
-            cmd->bind_constant_buffer(light_buffer_, 1, SHADER_FREQUENCY_FRAGMENT);
-        }
+        // Lights (t4) and their per-cluster lists (t5, t6)
+        upload_light_data(cmd);
         
         cmd->draw(3, 1, 0, 0);  // 3 vertices for full-screen triangle using SV_VertexID
     })
@@ -8,6 +8,8 @@
 #include <memory>
 #include <vector>
 
+class LightClusterBuilder;
+
 namespace render {
 
 // Forward declarations
@@ -38,11 +40,9 @@ struct ShaderLightData {
     uint32_t type;      // LightType
     float inner_angle;  // For spot light (cosine)
     float outer_angle;  // For spot light (cosine)
-    float _padding1;
+    float falloff;      // For point/spot: exponent of (1 - distance / range); 0 uses 2
 };
 
-static constexpr uint32_t MAX_LIGHTS = 32;
-
 /**
  * @brief Per-frame data for deferred lighting
  */
@@ -60,6 +60,11 @@ struct DeferredLightingPerFrameData {
     float main_light_intensity;
     
     Mat4 inv_view_proj;  // For reconstructing world position from depth
+    Mat4 view;           // View depth of a pixel selects its cluster slice
+
+    // Light clusters: grid size, then screen size and the log depth slice scale / bias
+    uint32_t cluster_grid[4];
+    Vec4 cluster_params;
 };
 
 /**
@@ -96,6 +101,14 @@ public:
      * @brief Set additional lights (point, spot, extra directional)
      */
     void set_lights(const std::vector<ShaderLightData>& lights);
+
+    /**
+     * @brief Per-cluster light lists built from the lights passed to set_lights
+     *
+     * The builder is read when the pass executes, so it must stay alive and unchanged until then.
+     * Without clusters only the main light is applied.
+     */
+    void set_light_clusters(const Mat4& view, const LightClusterBuilder* clusters);
     
     /**
      * @brief Check if pass is ready
@@ -112,6 +125,7 @@ private:
     void create_pipeline();
     void create_uniform_buffers();
     void create_quad_geometry();
+    void upload_light_data(RHICommandListRef command);
 
     ShaderRef vertex_shader_;
     ShaderRef fragment_shader_;
@@ -124,16 +138,21 @@ private:
     
     // Uniform buffers
     RHIBufferRef per_frame_buffer_;
-    RHIBufferRef light_buffer_;  // SSBO for multiple lights
+
+    // Structured buffers, grown by doubling
+    RHIBufferRef light_buffer_;             // t4: ShaderLightData
+    RHIBufferRef cluster_range_buffer_;     // t5: LightClusterRange per cluster
+    RHIBufferRef cluster_index_buffer_;     // t6: LightClusterIndex
     
     // Sampler for GBuffer textures
     RHISamplerRef gbuffer_sampler_;
     
-    DeferredLightingPerFrameData per_frame_data_;
+    DeferredLightingPerFrameData per_frame_data_ = {};
     bool per_frame_dirty_ = true;
     
     std::vector<ShaderLightData> lights_data_;
     bool lights_dirty_ = true;
+    const LightClusterBuilder* clusters_ = nullptr;
     
     bool initialized_ = false;
 };
@@ -16,7 +16,6 @@ DepthPrePass::~DepthPrePass() {
     for (auto& buf : per_frame_buffers_) {
         if (buf) buf->destroy();
     }
-    if (per_object_buffer_) per_object_buffer_->destroy();
 }
 
 void DepthPrePass::init() {
@@ -73,17 +72,6 @@ void DepthPrePass::create_uniform_buffers() {
         frame_info.creation_flag = BUFFER_CREATION_PERSISTENT_MAP;
         per_frame_buffers_[i] = backend->create_buffer(frame_info);
     }
-
-    // Per-object buffer
-    // TODO: Ideally this should use dynamic offsets or a large ring buffer to prevent 
-    // overwriting data within the same frame. For now, we use a single buffer which 
-    // is technically incorrect for multiple objects but matches current project patterns.
-    RHIBufferInfo obj_info = {};
-    obj_info.size = sizeof(PerObjectData);
-    obj_info.type = RESOURCE_TYPE_UNIFORM_BUFFER;
-    obj_info.memory_usage = MEMORY_USAGE_CPU_TO_GPU;
-    obj_info.creation_flag = BUFFER_CREATION_PERSISTENT_MAP;
-    per_object_buffer_ = backend->create_buffer(obj_info);
 }
 
 void DepthPrePass::create_pipeline() {
@@ -108,6 +96,8 @@ void DepthPrePass::create_pipeline() {
     pipe_info.vertex_input_state.vertex_elements[0].semantic_name = "POSITION";
     pipe_info.vertex_input_state.vertex_elements[0].format = FORMAT_R32G32B32_SFLOAT;
     pipe_info.vertex_input_state.vertex_elements[0].offset = 0;
+    // Object id - stream 1
+    pipe_info.vertex_input_state.vertex_elements.push_back(MeshInstanceBuffer::vertex_element(1));
 
     // Rasterizer
     pipe_info.rasterizer_state.cull_mode = CULL_MODE_BACK;
@@ -155,11 +145,11 @@ void DepthPrePass::build(RDGBuilder& builder, RDGTextureHandle depth_target, con
     auto rp_builder = builder.create_render_pass("DepthPrePass")
         .depth_stencil(depth_target, ATTACHMENT_LOAD_OP_CLEAR, ATTACHMENT_STORE_OP_STORE, 1.0f, 0);
 
-    // Get extent for viewport
+    // Get extent for viewport (the dynamic resolution region of the depth target)
     Extent2D extent = {1280, 720};
     auto* render_system = EngineContext::render_system();
-    if (render_system && render_system->get_swapchain()) {
-        extent = render_system->get_swapchain()->get_extent();
+    if (render_system) {
+        extent = render_system->get_render_extent();
     }
 
     rp_builder.execute([this, batches, extent](RDGPassContext context) {
@@ -185,21 +175,15 @@ void DepthPrePass::build(RDGBuilder& builder, RDGTextureHandle depth_target, con
             cmd->bind_constant_buffer(current_frame_buffer, 0, SHADER_FREQUENCY_VERTEX);
         }
 
+        // Object data comes from the global object table, batch i reads object id i of the stream
+        object_ids_.clear();
+        for (const auto& batch : batches) object_ids_.push_back(batch.object_id);
+        if (!instance_buffer_.upload(object_ids_)) return;
+        instance_buffer_.bind(cmd, 0, 1);
+
         // Draw Batches
-        for (const auto& batch : batches) {
-            // Update PerObject Buffer
-            if (per_object_buffer_) {
-                PerObjectData obj_data;
-                obj_data.model = batch.model_matrix;
-                obj_data.inv_model = batch.inv_model_matrix;
-                
-                void* mapped = per_object_buffer_->map();
-                if (mapped) {
-                    memcpy(mapped, &obj_data, sizeof(PerObjectData));
-                    per_object_buffer_->unmap();
-                }
-                cmd->bind_constant_buffer(per_object_buffer_, 1, SHADER_FREQUENCY_VERTEX);
-            }
+        for (uint32_t i = 0; i < batches.size(); ++i) {
+            const DrawBatch& batch = batches[i];
 
             // Vertex Buffer
             if (batch.vertex_buffer) {
@@ -210,7 +194,7 @@ void DepthPrePass::build(RDGBuilder& builder, RDGTextureHandle depth_target, con
             // Draw
             if (batch.index_buffer) {
                 cmd->bind_index_buffer(batch.index_buffer, 0);
-                cmd->draw_indexed(batch.index_count, 1, batch.index_offset, 0, 0);
+                cmd->draw_indexed(batch.index_count, 1, batch.index_offset, 0, i);
             }
         }
     });
@@ -42,9 +42,10 @@ private:
     // Double/Triple buffering for per-frame data to avoid CPU-GPU sync issues
     static constexpr uint32_t kFramesInFlight = 3; 
     std::vector<RHIBufferRef> per_frame_buffers_;
-    
-    // For per-object, we currently use a single buffer per frame (sub-optimal)
-    RHIBufferRef per_object_buffer_;
+
+    // Object table (t0) and object id stream (stream 1)
+    MeshInstanceBuffer instance_buffer_;
+    std::vector<uint32_t> object_ids_;
 
     struct PerFrameData {
         Mat4 view;
@@ -57,11 +58,6 @@ private:
         float light_intensity;
     } per_frame_data_;
 
-    struct PerObjectData {
-        Mat4 model;
-        Mat4 inv_model;
-    };
-
     bool initialized_ = false;
 };
 
@@ -27,7 +27,6 @@ ForwardPass::~ForwardPass() {
     if (wireframe_pipeline_) wireframe_pipeline_->destroy();
     if (root_signature_) root_signature_->destroy();
     if (per_frame_buffer_) per_frame_buffer_->destroy();
-    if (per_object_buffer_) per_object_buffer_->destroy();
 }
 
 void ForwardPass::init() {
@@ -40,7 +39,7 @@ void ForwardPass::init() {
     }
     
     create_uniform_buffers();
-    if (!per_frame_buffer_ || !per_object_buffer_) {
+    if (!per_frame_buffer_) {
         ERR(LogForwardPass, "Failed to create uniform buffers");
         return;
     }
@@ -119,19 +118,6 @@ void ForwardPass::create_uniform_buffers() {
         return;
     }
     
-    RHIBufferInfo object_info = {};
-    object_info.size = sizeof(PerObjectData);
-    object_info.stride = 0;
-    object_info.memory_usage = MEMORY_USAGE_CPU_TO_GPU;
-    object_info.type = RESOURCE_TYPE_UNIFORM_BUFFER;
-    object_info.creation_flag = BUFFER_CREATION_PERSISTENT_MAP;
-    
-    per_object_buffer_ = backend->create_buffer(object_info);
-    if (!per_object_buffer_) {
-        ERR(LogForwardPass, "Failed to create per-object buffer");
-        return;
-    }
-    
     INFO(LogForwardPass, "Uniform buffers created successfully");
 }
 
@@ -158,6 +144,8 @@ void ForwardPass::create_pipeline() {
     pipe_info.vertex_input_state.vertex_elements[1].semantic_name = "NORMAL";
     pipe_info.vertex_input_state.vertex_elements[1].format = FORMAT_R32G32B32_SFLOAT;
     pipe_info.vertex_input_state.vertex_elements[1].offset = 0;
+    // Object id - stream 2
+    pipe_info.vertex_input_state.vertex_elements.push_back(MeshInstanceBuffer::vertex_element(2));
     
     pipe_info.rasterizer_state.cull_mode = CULL_MODE_NONE;
     pipe_info.rasterizer_state.depth_clip_mode = DEPTH_CLIP;
@@ -309,21 +297,10 @@ void ForwardPass::build(RDGBuilder& builder) {
                     static_cast<ShaderFrequency>(SHADER_FREQUENCY_VERTEX | SHADER_FREQUENCY_FRAGMENT));
             }
             
-            std::vector<DrawBatch> batches;
-            mesh_manager->collect_draw_batches(batches);
-            for (const auto& batch : batches) {
-                if (per_object_buffer_) {
-                    PerObjectData object_data;
-                    object_data.model = batch.model_matrix;
-                    object_data.inv_model = batch.inv_model_matrix;
-                    void* mapped = per_object_buffer_->map();
-                    if (mapped) {
-                        memcpy(mapped, &object_data, sizeof(object_data));
-                        per_object_buffer_->unmap();
-                    }
-                    cmd->bind_constant_buffer(per_object_buffer_, 1, SHADER_FREQUENCY_VERTEX);
-                }
-                
+            const std::vector<DrawBatch>& batches = mesh_manager->get_frame_batches();
+            if (!bind_object_ids(cmd, batches)) return;
+            for (uint32_t i = 0; i < batches.size(); ++i) {
+                const DrawBatch& batch = batches[i];
                 if (batch.vertex_buffer) {
                     cmd->bind_vertex_buffer(batch.vertex_buffer, 0, 0);
                 }
@@ -333,7 +310,7 @@ void ForwardPass::build(RDGBuilder& builder) {
                 
                 if (batch.index_buffer) {
                     cmd->bind_index_buffer(batch.index_buffer, 0);
-                    cmd->draw_indexed(batch.index_count, 1, batch.index_offset, 0, 0);
+                    cmd->draw_indexed(batch.index_count, 1, batch.index_offset, 0, i);
                 }
             }
         })
@@ -379,20 +356,11 @@ void ForwardPass::build(RDGBuilder& builder, RDGTextureHandle color_target,
                 static_cast<ShaderFrequency>(SHADER_FREQUENCY_VERTEX | SHADER_FREQUENCY_FRAGMENT));
         }
         
-        for (const auto& batch : batches) {
-            // Per-object data
-            if (per_object_buffer_) {
-                PerObjectData object_data;
-                object_data.model = batch.model_matrix;
-                object_data.inv_model = batch.inv_model_matrix;
-                void* mapped = per_object_buffer_->map();
-                if (mapped) {
-                    memcpy(mapped, &object_data, sizeof(object_data));
-                    per_object_buffer_->unmap();
-                }
-                cmd->bind_constant_buffer(per_object_buffer_, 1, SHADER_FREQUENCY_VERTEX);
-            }
-            
+        // Batch i reads object id i of the stream
+        if (!bind_object_ids(cmd, batches)) return;
+        for (uint32_t i = 0; i < batches.size(); ++i) {
+            const DrawBatch& batch = batches[i];
+
             // Bind vertex buffers
             if (batch.vertex_buffer) {
                 cmd->bind_vertex_buffer(batch.vertex_buffer, 0, 0);
@@ -404,13 +372,21 @@ void ForwardPass::build(RDGBuilder& builder, RDGTextureHandle color_target,
             // Draw
             if (batch.index_buffer) {
                 cmd->bind_index_buffer(batch.index_buffer, 0);
-                cmd->draw_indexed(batch.index_count, 1, batch.index_offset, 0, 0);
+                cmd->draw_indexed(batch.index_count, 1, batch.index_offset, 0, i);
             }
         }
     })
     .finish();
 }
 
+bool ForwardPass::bind_object_ids(RHICommandListRef command, const std::vector<DrawBatch>& batches) {
+    object_ids_.clear();
+    for (const auto& batch : batches) object_ids_.push_back(batch.object_id);
+    if (!instance_buffer_.upload(object_ids_)) return false;
+    instance_buffer_.bind(command, 0, 2);
+    return true;
+}
+
 void ForwardPass::draw_batch(RHICommandContextRef command, const DrawBatch& batch) {
     if (!command || !pipeline_ || !batch.vertex_buffer || !batch.index_buffer || batch.index_count == 0) {
         ERR(LogForwardPass, "draw_batch: invalid parameters");
@@ -432,19 +408,9 @@ void ForwardPass::draw_batch(RHICommandContextRef command, const DrawBatch& batc
             static_cast<ShaderFrequency>(SHADER_FREQUENCY_VERTEX | SHADER_FREQUENCY_FRAGMENT));
     }
     
-    if (per_object_buffer_) {
-        PerObjectData object_data;
-        object_data.model = batch.model_matrix;
-        object_data.inv_model = batch.inv_model_matrix;
-        
-        void* mapped = per_object_buffer_->map();
-        if (mapped) {
-            memcpy(mapped, &object_data, sizeof(object_data));
-            per_object_buffer_->unmap();
-        }
-        
-        command->bind_constant_buffer(per_object_buffer_, 1, SHADER_FREQUENCY_VERTEX);
-    }
+    object_ids_.assign(1, batch.object_id);
+    if (!instance_buffer_.upload(object_ids_)) return;
+    instance_buffer_.bind(command, 0, 2);
     
     if (batch.vertex_buffer) {
         command->bind_vertex_buffer(batch.vertex_buffer, 0, 0);
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "engine/function/render/render_pass/render_pass.h"
+#include "engine/function/render/render_pass/mesh_pass.h"
 #include "engine/function/render/render_resource/shader.h"
 #include "engine/core/math/math.h"
 #include <memory>
@@ -8,9 +9,6 @@
 
 namespace render {
 
-// Forward declarations
-struct DrawBatch;
-
 /**
  * @brief Per-frame uniform data (view, projection, camera, lights)
  */
@@ -27,19 +25,11 @@ struct PerFrameData {
     float light_intensity;
 };
 
-/**
- * @brief Per-object uniform data (model matrix)
- */
-struct PerObjectData {
-    Mat4 model;
-    Mat4 inv_model;
-};
-
 /**
  * @brief Forward rendering pass
  * 
- * Renders meshes with simple forward shading using uniform buffers
- * for MVP matrices.
+ * Renders meshes with simple forward shading. Per-frame data is a uniform buffer,
+ * object data is read from the global object table.
  */
 class ForwardPass : public RenderPass {
 public:
@@ -97,6 +87,11 @@ private:
     void create_pipeline();
     void create_uniform_buffers();
 
+    /**
+     * @brief Upload the object ids of batches in order and bind them with the object table
+     */
+    bool bind_object_ids(RHICommandListRef command, const std::vector<DrawBatch>& batches);
+
     ShaderRef vertex_shader_;
     ShaderRef fragment_shader_;
     RHIGraphicsPipelineRef pipeline_;        // Current active pipeline
@@ -108,7 +103,10 @@ private:
 
     // Uniform buffers
     RHIBufferRef per_frame_buffer_;  // Slot b0: view, proj, camera_pos, lights
-    RHIBufferRef per_object_buffer_; // Slot b1: model matrix
+
+    // Object table (t0) and object id stream (stream 2)
+    MeshInstanceBuffer instance_buffer_;
+    std::vector<uint32_t> object_ids_;
 
     PerFrameData per_frame_data_;
     bool per_frame_dirty_ = true;
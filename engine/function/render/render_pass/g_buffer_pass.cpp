@@ -10,6 +10,7 @@
 #include "engine/function/render/render_resource/material.h"
 #include "engine/function/render/render_resource/texture.h"
 #include "engine/core/log/Log.h"
+#include "engine/core/utils/timer.h"
 
 #include <cstring>
 
@@ -23,7 +24,6 @@ GBufferPass::~GBufferPass() {
     if (pipeline_) pipeline_->destroy();
     if (root_signature_) root_signature_->destroy();
     if (per_frame_buffer_) per_frame_buffer_->destroy();
-    if (per_object_buffer_) per_object_buffer_->destroy();
     if (material_buffer_) material_buffer_->destroy();
     if (default_sampler_) default_sampler_->destroy();
     if (material_buffer_) material_buffer_->destroy();
@@ -40,7 +40,7 @@ void GBufferPass::init() {
     }
     
     create_uniform_buffers();
-    if (!per_frame_buffer_ || !per_object_buffer_ || !material_buffer_) {
+    if (!per_frame_buffer_ || !material_buffer_) {
         ERR(LogGBufferPass, "Failed to create uniform buffers");
         return;
     }
@@ -131,19 +131,6 @@ void GBufferPass::create_uniform_buffers() {
         return;
     }
     
-    RHIBufferInfo object_info = {};
-    object_info.size = sizeof(GBufferPerObjectData);
-    object_info.stride = 0;
-    object_info.memory_usage = MEMORY_USAGE_CPU_TO_GPU;
-    object_info.type = RESOURCE_TYPE_UNIFORM_BUFFER;
-    object_info.creation_flag = BUFFER_CREATION_PERSISTENT_MAP;
-    
-    per_object_buffer_ = backend->create_buffer(object_info);
-    if (!per_object_buffer_) {
-        ERR(LogGBufferPass, "Failed to create per-object buffer");
-        return;
-    }
-    
    // Create material buffer (b2)
     RHIBufferInfo material_info = {};
     material_info.size = sizeof(GBufferMaterialData);
@@ -208,6 +195,7 @@ void GBufferPass::create_pipeline() {
     pipe_info.vertex_input_state.vertex_elements[2].semantic_name = "TEXCOORD";
     pipe_info.vertex_input_state.vertex_elements[2].format = FORMAT_R32G32_SFLOAT;
     pipe_info.vertex_input_state.vertex_elements[2].offset = 0;
+    pipe_info.vertex_input_state.vertex_elements.push_back(MeshInstanceBuffer::vertex_element(3));
     
     pipe_info.rasterizer_state.cull_mode = CULL_MODE_BACK;
     pipe_info.rasterizer_state.fill_mode = FILL_MODE_SOLID;
@@ -218,9 +206,9 @@ void GBufferPass::create_pipeline() {
     pipe_info.depth_stencil_state.depth_test = COMPARE_FUNCTION_LESS_EQUAL;
     
     pipe_info.color_attachment_formats[0] = get_albedo_ao_format();
-    pipe_info.color_attachment_formats[1] = get_normal_roughness_format();
-    pipe_info.color_attachment_formats[2] = get_material_emission_format();
-    pipe_info.color_attachment_formats[3] = get_position_depth_format();
+    pipe_info.color_attachment_formats[1] = get_normal_format();
+    pipe_info.color_attachment_formats[2] = get_material_format();
+    pipe_info.color_attachment_formats[3] = get_velocity_format();
     pipe_info.depth_stencil_attachment_format = get_depth_format();
     
     pipeline_ = backend->create_graphics_pipeline(pipe_info);
@@ -239,12 +227,19 @@ void GBufferPass::set_per_frame_data(const Mat4& view, const Mat4& proj, const V
     per_frame_dirty_ = true;
 }
 
+void GBufferPass::set_temporal_data(const Mat4& prev_view_proj, Vec2 jitter_ndc) {
+    per_frame_data_.prev_view_proj = prev_view_proj;
+    per_frame_data_.jitter = jitter_ndc;
+    per_frame_dirty_ = true;
+}
+
 void GBufferPass::build(RDGBuilder& builder) {
     // Default build does nothing - use the explicit batches version
 }
 
 std::optional<GBufferOutputHandles> GBufferPass::build(RDGBuilder& builder, RDGTextureHandle depth_target, 
                         const std::vector<DrawBatch>& batches) {
+    instancing_stats_ = InstancingStats{};
     if (!initialized_ || !pipeline_) {
         return std::nullopt;
     }
@@ -255,6 +250,7 @@ std::optional<GBufferOutputHandles> GBufferPass::build(RDGBuilder& builder, RDGT
     
     // Store batches for lambda access (avoids copy in capture)
     current_batches_ = batches;
+    MeshPassProcessor::build_indirect_draws(current_batches_, indirect_commands_, indirect_runs_, object_ids_);
     
     auto render_system = EngineContext::render_system();
     if (!render_system) return std::nullopt;
@@ -262,9 +258,11 @@ std::optional<GBufferOutputHandles> GBufferPass::build(RDGBuilder& builder, RDGT
     auto swapchain = render_system->get_swapchain();
     if (!swapchain) return std::nullopt;
     
-    Extent2D extent = swapchain->get_extent();
+    // Targets stay swapchain-sized so the pool reuses them; only the viewport follows the render scale
+    Extent2D full_extent = swapchain->get_extent();
+    Extent2D extent = render_system->get_render_extent();
     
-    Extent3D tex_extent = {extent.width, extent.height, 1};
+    Extent3D tex_extent = {full_extent.width, full_extent.height, 1};
     
     RDGTextureHandle gbuffer_albedo_ao = builder.create_texture("GBuffer_AlbedoAO")
         .extent(tex_extent)
@@ -272,21 +270,21 @@ std::optional<GBufferOutputHandles> GBufferPass::build(RDGBuilder& builder, RDGT
         .allow_render_target()
         .finish();
     
-    RDGTextureHandle gbuffer_normal_roughness = builder.create_texture("GBuffer_NormalRoughness")
+    RDGTextureHandle gbuffer_normal = builder.create_texture("GBuffer_Normal")
         .extent(tex_extent)
-        .format(get_normal_roughness_format())
+        .format(get_normal_format())
         .allow_render_target()
         .finish();
     
     RDGTextureHandle gbuffer_material = builder.create_texture("GBuffer_Material")
         .extent(tex_extent)
-        .format(get_material_emission_format())
+        .format(get_material_format())
         .allow_render_target()
         .finish();
     
-    RDGTextureHandle gbuffer_position = builder.create_texture("GBuffer_Position")
+    RDGTextureHandle gbuffer_velocity = builder.create_texture("GBuffer_Velocity")
         .extent(tex_extent)
-        .format(get_position_depth_format())
+        .format(get_velocity_format())
         .allow_render_target()
         .finish();
     
@@ -295,20 +293,21 @@ std::optional<GBufferOutputHandles> GBufferPass::build(RDGBuilder& builder, RDGT
         .color(GBufferData::ALBEDO_AO_INDEX, gbuffer_albedo_ao, 
                ATTACHMENT_LOAD_OP_CLEAR, ATTACHMENT_STORE_OP_STORE, 
                Color4{0.0f, 0.0f, 0.0f, 1.0f})
-        .color(GBufferData::NORMAL_ROUGHNESS_INDEX, gbuffer_normal_roughness,
+        .color(GBufferData::NORMAL_INDEX, gbuffer_normal,
                ATTACHMENT_LOAD_OP_CLEAR, ATTACHMENT_STORE_OP_STORE,
-               Color4{0.5f, 0.5f, 1.0f, 1.0f})
-        .color(GBufferData::MATERIAL_EMISSION_INDEX, gbuffer_material,
+               Color4{0.0f, 0.0f, 0.0f, 0.0f})     // +Z
+        .color(GBufferData::MATERIAL_INDEX, gbuffer_material,
                ATTACHMENT_LOAD_OP_CLEAR, ATTACHMENT_STORE_OP_STORE,
-               Color4{0.0f, 0.0f, 0.5f, 1.0f})
-        .color(GBufferData::POSITION_DEPTH_INDEX, gbuffer_position,
+               Color4{1.0f, 0.0f, 0.5f, 0.0f})
+        .color(GBufferData::VELOCITY_INDEX, gbuffer_velocity,
                ATTACHMENT_LOAD_OP_CLEAR, ATTACHMENT_STORE_OP_STORE,
-               Color4{0.0f, 0.0f, 0.0f, 0.0f})
+               Color4{GBufferData::NO_VELOCITY, GBufferData::NO_VELOCITY, 0.0f, 0.0f})
         .depth_stencil(depth_target, ATTACHMENT_LOAD_OP_LOAD, ATTACHMENT_STORE_OP_STORE, 
                        1.0f, 0)
         .execute([this, render_system, extent](RDGPassContext context) {
             RHICommandListRef cmd = context.command;
             if (!cmd) return;
+            Timer submit_timer;
             
             cmd->set_viewport({0, 0}, {extent.width, extent.height});
             cmd->set_scissor({0, 0}, {extent.width, extent.height});
@@ -327,6 +326,11 @@ std::optional<GBufferOutputHandles> GBufferPass::build(RDGBuilder& builder, RDGT
                     static_cast<ShaderFrequency>(SHADER_FREQUENCY_VERTEX | SHADER_FREQUENCY_FRAGMENT));
             }
             
+            // One upload of the frame's object ids and draw arguments, each command indexes its range of the stream
+            if (!instance_buffer_.upload(object_ids_)) return;
+            if (!indirect_buffer_.upload(indirect_commands_)) return;
+            instance_buffer_.bind(cmd, 7, 3);
+            
             // Bind material buffer and sampler (used by all batches)
             cmd->bind_constant_buffer(material_buffer_, 2, SHADER_FREQUENCY_FRAGMENT);
             cmd->bind_sampler(default_sampler_, 0, SHADER_FREQUENCY_FRAGMENT);
@@ -337,19 +341,8 @@ std::optional<GBufferOutputHandles> GBufferPass::build(RDGBuilder& builder, RDGT
             RHITextureRef fallback_black = rsys ? rsys->get_fallback_black_texture() : nullptr;
             RHITextureRef fallback_normal = rsys ? rsys->get_fallback_normal_texture() : nullptr;
             
-            // Use stored batches
-            for (const auto& batch : current_batches_) {
-                if (per_object_buffer_) {
-                    GBufferPerObjectData object_data;
-                    object_data.model = batch.model_matrix;
-                    object_data.inv_model = batch.inv_model_matrix;
-                    void* mapped = per_object_buffer_->map();
-                    if (mapped) {
-                        memcpy(mapped, &object_data, sizeof(object_data));
-                        per_object_buffer_->unmap();
-                    }
-                    cmd->bind_constant_buffer(per_object_buffer_, 1, SHADER_FREQUENCY_VERTEX);
-                }
+            for (const auto& run : indirect_runs_) {
+                const DrawBatch& batch = current_batches_[run.batch_index];
                 
                 // Update material data and bind textures
                 auto pbr_mat = std::dynamic_pointer_cast<PBRMaterial>(batch.material);
@@ -456,17 +449,23 @@ std::optional<GBufferOutputHandles> GBufferPass::build(RDGBuilder& builder, RDGT
                 
                 if (batch.index_buffer) {
                     cmd->bind_index_buffer(batch.index_buffer, 0);
-                    cmd->draw_indexed(batch.index_count, 1, batch.index_offset, 0, 0);
+                    indirect_buffer_.draw(cmd, run);
                 }
             }
+            
+            instancing_stats_.batch_count = static_cast<uint32_t>(current_batches_.size());
+            instancing_stats_.draw_count = static_cast<uint32_t>(indirect_commands_.size());
+            instancing_stats_.submit_count = static_cast<uint32_t>(indirect_runs_.size());
+            instancing_stats_.submit_ms = submit_timer.get_total_ms();
         })
         .finish();
     
     return GBufferOutputHandles{
         gbuffer_albedo_ao,
-        gbuffer_normal_roughness,
+        gbuffer_normal,
         gbuffer_material,
-        gbuffer_position
+        depth_target,
+        gbuffer_velocity
     };
 }
 
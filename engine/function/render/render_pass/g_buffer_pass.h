@@ -1,6 +1,7 @@
 #pragma once
 
 #include "engine/function/render/render_pass/render_pass.h"
+#include "engine/function/render/render_pass/mesh_pass.h"
 #include "engine/function/render/render_resource/shader.h"
 #include "engine/core/math/math.h"
 #include <memory>
@@ -9,34 +10,35 @@
 
 namespace render {
 
-// Forward declarations
-struct DrawBatch;
-
 /**
  * @brief Output handles from G-Buffer pass for downstream passes
  */
 struct GBufferOutputHandles {
     RDGTextureHandle albedo_ao;
-    RDGTextureHandle normal_roughness;
-    RDGTextureHandle material_emission;
-    RDGTextureHandle position_depth;
+    RDGTextureHandle normal;
+    RDGTextureHandle material;
+    RDGTextureHandle depth;     // Depth the G-buffer was tested against; world position is rebuilt from it
+    RDGTextureHandle velocity = RDGTextureHandle(UINT32_MAX);  // Motion vectors, read by temporal passes
 };
 
 /**
  * @brief G-Buffer data structure for deferred rendering
  * 
- * Layout:
+ * Layout (12 bytes per pixel plus 4 for motion vectors):
  * - RT0: Albedo (RGB) + AO (A)
- * - RT1: Normal (RGB) + roughness (A) 
- * - RT2: Metallic (R) + emission (G) + specular (B) + _padding (A)
- * - RT3: World Position (RGB) + depth (A)
+ * - RT1: Octahedral normal (RG, snorm), see GBufferPacking
+ * - RT2: Roughness (R) + metallic (G) + specular (B) + emission (A)
+ * - RT3: Motion vector (RG), current minus previous uv; NO_VELOCITY where no G-buffer geometry was drawn
+ * World position is reconstructed from the depth buffer by the lighting pass.
  */
 struct GBufferData {
     static constexpr uint32_t ALBEDO_AO_INDEX = 0;
-    static constexpr uint32_t NORMAL_ROUGHNESS_INDEX = 1;
-    static constexpr uint32_t MATERIAL_EMISSION_INDEX = 2;
-    static constexpr uint32_t POSITION_DEPTH_INDEX = 3;
+    static constexpr uint32_t NORMAL_INDEX = 1;
+    static constexpr uint32_t MATERIAL_INDEX = 2;
+    static constexpr uint32_t VELOCITY_INDEX = 3;
     static constexpr uint32_t COUNT = 4;
+
+    static constexpr float NO_VELOCITY = 1024.0f;   // Matches NO_VELOCITY in temporal_aa.hlsl
 };
 
 /**
@@ -44,17 +46,12 @@ struct GBufferData {
  */
 struct GBufferPerFrameData {
     Mat4 view;
-    Mat4 proj;
+    Mat4 proj;                  // Jittered when temporal AA is on
     Vec3 camera_pos;
     float _padding;
-};
-
-/**
- * @brief Per-object uniform data for G-Buffer pass
- */
-struct GBufferPerObjectData {
-    Mat4 model;
-    Mat4 inv_model;
+    Mat4 prev_view_proj;        // Unjittered, previous frame
+    Vec2 jitter;                // NDC offset in proj, removed from the motion vectors
+    Vec2 _jitter_padding;
 };
 
 /**
@@ -68,6 +65,7 @@ struct GBufferPerObjectData {
  * - t4: Metallic map (when ARM not available)
  * - t5: AO map (when ARM not available)
  * - t6: Emission map
+ * - t7: Per-instance ObjectInfo (vertex shader)
  * 
  * Layout (64 bytes, 16-byte aligned):
  * - offset 0:  albedo (Vec4)
@@ -131,20 +129,35 @@ public:
      */
     void set_per_frame_data(const Mat4& view, const Mat4& proj, const Vec3& camera_pos);
 
+    /**
+     * @brief Previous frame's unjittered view-projection and this frame's jitter, for motion vectors
+     */
+    void set_temporal_data(const Mat4& prev_view_proj, Vec2 jitter_ndc);
+
     /**
      * @brief Check if pass is ready
      */
     bool is_ready() const { return initialized_ && pipeline_ != nullptr; }
 
+    const InstancingStats& get_instancing_stats() const { return instancing_stats_; }
+
     /**
      * @brief Get G-Buffer texture formats
      */
     static RHIFormat get_albedo_ao_format() { return FORMAT_R8G8B8A8_UNORM; }
-    static RHIFormat get_normal_roughness_format() { return FORMAT_R8G8B8A8_UNORM; }
-    static RHIFormat get_material_emission_format() { return FORMAT_R8G8B8A8_UNORM; }
-    static RHIFormat get_position_depth_format() { return FORMAT_R32G32B32A32_SFLOAT; }
+    static RHIFormat get_normal_format() { return FORMAT_R16G16_SNORM; }
+    static RHIFormat get_material_format() { return FORMAT_R8G8B8A8_UNORM; }
+    static RHIFormat get_velocity_format() { return FORMAT_R16G16_SFLOAT; }
     static RHIFormat get_depth_format() { return FORMAT_D32_SFLOAT; }
 
+    /**
+     * @brief Bytes per pixel of the G-buffer color targets (the depth buffer is shared with the prepass)
+     */
+    static uint32_t get_bytes_per_pixel() {
+        return format_pixel_size(get_albedo_ao_format()) + format_pixel_size(get_normal_format()) +
+               format_pixel_size(get_material_format()) + format_pixel_size(get_velocity_format());
+    }
+
 private:
     void create_shaders();
     void create_pipeline();
@@ -159,7 +172,6 @@ private:
 
     // Uniform buffers
     RHIBufferRef per_frame_buffer_;   // Slot b0: view, proj, camera
-    RHIBufferRef per_object_buffer_;  // Slot b1: model matrix
     RHIBufferRef material_buffer_;    // Slot b2: material data
 
     // Sampler
@@ -168,8 +180,14 @@ private:
     GBufferPerFrameData per_frame_data_;
     bool per_frame_dirty_ = true;
 
-    // Stored batches for deferred rendering
+    // Stored batches for deferred rendering, packed into indirect commands
     std::vector<DrawBatch> current_batches_;
+    std::vector<RHIIndexedIndirectCommand> indirect_commands_;
+    std::vector<IndirectDrawRun> indirect_runs_;
+    std::vector<uint32_t> object_ids_;
+    MeshInstanceBuffer instance_buffer_;  // Object table at t7, object id stream 3
+    MeshIndirectBuffer indirect_buffer_;
+    InstancingStats instancing_stats_;
 
     bool initialized_ = false;
 };
@@ -0,0 +1,157 @@
+#include "engine/function/render/render_pass/mesh_pass.h"
+#include "engine/function/render/render_resource/render_resource_manager.h"
+#include "engine/main/engine_context.h"
+#include "engine/core/log/Log.h"
+
+#include <cstring>
+#include <algorithm>
+
+DEFINE_LOG_TAG(LogMeshPass, "MeshPass");
+
+namespace render {
+
+namespace {
+
+// Per-frame upload buffer of at least count elements, doubling from min_capacity as it grows
+bool reserve_upload_buffer(RHIBufferRef& buffer, uint32_t& capacity, uint32_t count, uint32_t min_capacity,
+                           uint32_t stride, ResourceType type, const char* name) {
+    if (count <= capacity && buffer) return true;
+
+    auto backend = EngineContext::rhi();
+    if (!backend) return false;
+
+    uint32_t new_capacity = std::max(capacity, min_capacity);
+    while (new_capacity < count) new_capacity *= 2;
+
+    RHIBufferInfo info = {};
+    info.size = static_cast<uint64_t>(new_capacity) * stride;
+    info.stride = stride;
+    info.memory_usage = MEMORY_USAGE_CPU_TO_GPU;
+    info.type = type;
+    RHIBufferRef new_buffer = backend->create_buffer(info);
+    if (!new_buffer) {
+        ERR(LogMeshPass, "Failed to create {} for {} elements", name, new_capacity);
+        return false;
+    }
+
+    if (buffer) buffer->destroy();
+    buffer = new_buffer;
+    capacity = new_capacity;
+    return true;
+}
+
+} // namespace
+
+bool MeshPassProcessor::can_share_state(const DrawBatch& a, const DrawBatch& b) {
+    return a.vertex_buffer == b.vertex_buffer &&
+           a.normal_buffer == b.normal_buffer &&
+           a.tangent_buffer == b.tangent_buffer &&
+           a.texcoord_buffer == b.texcoord_buffer &&
+           a.index_buffer == b.index_buffer &&
+           a.material == b.material;
+}
+
+bool MeshPassProcessor::can_instance(const DrawBatch& a, const DrawBatch& b) {
+    return a.index_count == b.index_count &&
+           a.index_offset == b.index_offset &&
+           can_share_state(a, b);
+}
+
+void MeshPassProcessor::build_instanced_draws(const std::vector<DrawBatch>& batches,
+                                              std::vector<InstancedDraw>& draws,
+                                              std::vector<uint32_t>& object_ids) {
+    draws.clear();
+    object_ids.clear();
+    object_ids.reserve(batches.size());
+
+    for (uint32_t i = 0; i < batches.size(); ++i) {
+        if (draws.empty() || !can_instance(batches[draws.back().batch_index], batches[i])) {
+            draws.push_back(InstancedDraw{i, i, 0});
+        }
+        draws.back().instance_count++;
+        object_ids.push_back(batches[i].object_id);
+    }
+}
+
+void MeshPassProcessor::build_indirect_draws(const std::vector<DrawBatch>& batches,
+                                             std::vector<RHIIndexedIndirectCommand>& commands,
+                                             std::vector<IndirectDrawRun>& runs,
+                                             std::vector<uint32_t>& object_ids) {
+    commands.clear();
+    runs.clear();
+    object_ids.clear();
+    object_ids.reserve(batches.size());
+
+    uint32_t command_batch = 0;     // Batch that opened the current command
+    for (uint32_t i = 0; i < batches.size(); ++i) {
+        const DrawBatch& batch = batches[i];
+        object_ids.push_back(batch.object_id);
+
+        if (!commands.empty() && can_instance(batches[command_batch], batch)) {
+            commands.back().instance_count++;
+            continue;
+        }
+
+        if (runs.empty() || !can_share_state(batches[runs.back().batch_index], batch)) {
+            runs.push_back(IndirectDrawRun{i, static_cast<uint32_t>(commands.size()), 0});
+        }
+        runs.back().command_count++;
+        commands.push_back(RHIIndexedIndirectCommand{batch.index_count, 1, batch.index_offset, 0, i});
+        command_batch = i;
+    }
+}
+
+MeshInstanceBuffer::~MeshInstanceBuffer() {
+    if (id_stream_) id_stream_->destroy();
+}
+
+VertexElement MeshInstanceBuffer::vertex_element(uint32_t stream_index) {
+    VertexElement element;
+    element.stream_index = stream_index;
+    element.semantic_name = "INSTANCE";
+    element.format = FORMAT_R32_UINT;
+    element.offset = 0;
+    element.use_instance_index = true;
+    return element;
+}
+
+RHIBufferRef MeshInstanceBuffer::get_object_table_buffer() {
+    auto render_resource = EngineContext::render_resource();
+    return render_resource ? render_resource->get_object_table().get_buffer() : nullptr;
+}
+
+bool MeshInstanceBuffer::reserve(uint32_t count) {
+    return reserve_upload_buffer(id_stream_, capacity_, count, MIN_CAPACITY, sizeof(uint32_t),
+                                 RESOURCE_TYPE_VERTEX_BUFFER, "instance id stream");
+}
+
+bool MeshInstanceBuffer::upload(const std::vector<uint32_t>& object_ids) {
+    if (object_ids.empty()) return true;
+    if (!reserve(static_cast<uint32_t>(object_ids.size()))) return false;
+
+    void* mapped = id_stream_->map();
+    if (!mapped) return false;
+    memcpy(mapped, object_ids.data(), object_ids.size() * sizeof(uint32_t));
+    id_stream_->unmap();
+    return true;
+}
+
+MeshIndirectBuffer::~MeshIndirectBuffer() {
+    if (argument_buffer_) argument_buffer_->destroy();
+}
+
+bool MeshIndirectBuffer::upload(const std::vector<RHIIndexedIndirectCommand>& commands) {
+    if (commands.empty()) return true;
+    if (!reserve_upload_buffer(argument_buffer_, capacity_, static_cast<uint32_t>(commands.size()), MIN_CAPACITY,
+                               sizeof(RHIIndexedIndirectCommand), RESOURCE_TYPE_INDIRECT_BUFFER, "indirect argument buffer")) {
+        return false;
+    }
+
+    void* mapped = argument_buffer_->map();
+    if (!mapped) return false;
+    memcpy(mapped, commands.data(), commands.size() * sizeof(RHIIndexedIndirectCommand));
+    argument_buffer_->unmap();
+    return true;
+}
+
+} // namespace render
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "engine/function/render/render_pass/render_pass.h"
+#include "engine/function/render/data/render_structs.h"
 #include "engine/core/math/math.h"
 #include <vector>
 #include <memory>
@@ -27,6 +28,33 @@ struct DrawBatch {
     Mat4 model_matrix = Mat4::Identity();
     Mat4 inv_model_matrix = Mat4::Identity();
     MaterialRef material;            // Material for PBR rendering
+    BoundingSphere world_sphere;     // World-space bounds for culling
+    BoundingBox world_box;
+};
+
+/**
+ * @brief Run of consecutive batches drawn with one instanced call
+ */
+struct InstancedDraw {
+    uint32_t batch_index = 0;       // First batch of the run, supplies buffers and material
+    uint32_t first_instance = 0;    // First object id of the run in the instance stream
+    uint32_t instance_count = 0;
+};
+
+/**
+ * @brief Run of consecutive indirect commands sharing vertex/index buffers and material, submitted with one indirect call
+ */
+struct IndirectDrawRun {
+    uint32_t batch_index = 0;       // First batch of the run, supplies buffers and material
+    uint32_t first_command = 0;     // First command of the run in the argument buffer
+    uint32_t command_count = 0;
+};
+
+struct InstancingStats {
+    uint32_t batch_count = 0;
+    uint32_t draw_count = 0;        // Instanced draws, one indirect command each
+    uint32_t submit_count = 0;      // Draw calls recorded, one per indirect run
+    float submit_ms = 0.0f;         // CPU time recording the draws, instance stream upload included
 };
 
 /**
@@ -36,6 +64,39 @@ class MeshPassProcessor {
 public:
     virtual ~MeshPassProcessor() = default;
 
+    /**
+     * @brief Merge consecutive batches sharing vertex/index buffers, index range and material into instanced draws
+     * 
+     * Batches should be sorted first (see DrawSorter) so identical draws are adjacent.
+     * @param object_ids Output, the object id of every batch in draw order
+     */
+    static void build_instanced_draws(const std::vector<DrawBatch>& batches,
+                                      std::vector<InstancedDraw>& draws,
+                                      std::vector<uint32_t>& object_ids);
+
+    /**
+     * @brief Pack the batches into indexed indirect commands, one per instanced draw, and group
+     *        consecutive commands that need no state change between them into runs
+     *
+     * Commands of one run differ only in index range and instances (LOD levels, meshlet ranges,
+     * submeshes of a shared buffer), so a pass binds the run's state once and submits it with a
+     * single draw_indexed_indirect. first_instance indexes the object id stream as with
+     * build_instanced_draws.
+     * @param commands Output, the packed argument buffer contents
+     * @param object_ids Output, the object id of every batch in draw order
+     */
+    static void build_indirect_draws(const std::vector<DrawBatch>& batches,
+                                     std::vector<RHIIndexedIndirectCommand>& commands,
+                                     std::vector<IndirectDrawRun>& runs,
+                                     std::vector<uint32_t>& object_ids);
+
+    static bool can_instance(const DrawBatch& a, const DrawBatch& b);
+
+    /**
+     * @brief Same vertex/index buffers and material, index range aside
+     */
+    static bool can_share_state(const DrawBatch& a, const DrawBatch& b);
+
     /**
      * @brief Clear collected batches
      */
@@ -69,6 +130,83 @@ protected:
 
 using MeshPassProcessorRef = std::shared_ptr<MeshPassProcessor>;
 
+/**
+ * @brief Per-instance object id stream for mesh draws
+ * 
+ * Object data lives in the global GPUObjectTable; a pass only uploads the object id of every
+ * instance, in draw order, as a per-instance vertex stream. D3D11 does not add the draw's first
+ * instance to SV_InstanceID but does offset per-instance streams, so shaders read the INSTANCE
+ * attribute and index the object table with it.
+ */
+class MeshInstanceBuffer {
+public:
+    static constexpr uint32_t MIN_CAPACITY = 256;
+
+    ~MeshInstanceBuffer();
+
+    /**
+     * @brief Vertex element for the INSTANCE attribute, to append to a pipeline's input layout
+     */
+    static VertexElement vertex_element(uint32_t stream_index);
+
+    /**
+     * @brief Write all object ids, growing the stream if needed. Call while recording the pass.
+     */
+    bool upload(const std::vector<uint32_t>& object_ids);
+
+    /**
+     * @brief GPU buffer of the global object table, see RenderResourceManager::get_object_table
+     */
+    static RHIBufferRef get_object_table_buffer();
+
+    /**
+     * @brief Bind the global object table and the id stream
+     */
+    template<typename CommandRef>
+    void bind(const CommandRef& command, uint32_t buffer_slot, uint32_t stream_index) const {
+        command->bind_buffer(get_object_table_buffer(), buffer_slot, SHADER_FREQUENCY_VERTEX);
+        command->bind_vertex_buffer(id_stream_, stream_index, 0);
+    }
+
+private:
+    bool reserve(uint32_t count);
+
+    RHIBufferRef id_stream_;
+    uint32_t capacity_ = 0;
+};
+
+/**
+ * @brief Indexed indirect argument buffer for mesh draws, filled on the CPU each frame
+ *
+ * The packed commands of MeshPassProcessor::build_indirect_draws are uploaded in one map, then
+ * every run is one draw_indexed_indirect over its slice of the buffer.
+ */
+class MeshIndirectBuffer {
+public:
+    static constexpr uint32_t MIN_CAPACITY = 256;
+
+    ~MeshIndirectBuffer();
+
+    /**
+     * @brief Write all commands, growing the buffer if needed. Call while recording the pass.
+     */
+    bool upload(const std::vector<RHIIndexedIndirectCommand>& commands);
+
+    /**
+     * @brief Submit the commands of one run
+     */
+    template<typename CommandRef>
+    void draw(const CommandRef& command, const IndirectDrawRun& run) const {
+        command->draw_indexed_indirect(argument_buffer_, run.first_command * sizeof(RHIIndexedIndirectCommand), run.command_count);
+    }
+
+    RHIBufferRef get_buffer() const { return argument_buffer_; }
+
+private:
+    RHIBufferRef argument_buffer_;
+    uint32_t capacity_ = 0;
+};
+
 /**
  * @brief Base class for passes that render meshes
  */
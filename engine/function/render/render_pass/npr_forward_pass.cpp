@@ -14,6 +14,7 @@
 #include "engine/function/render/render_resource/texture.h"
 #include "engine/function/render/render_resource/shader_utils.h"
 #include "engine/core/log/Log.h"
+#include "engine/core/utils/timer.h"
 
 #include <cstring>
 
@@ -33,7 +34,6 @@ NPRForwardPass::~NPRForwardPass() {
     if (wireframe_pipeline_) wireframe_pipeline_->destroy();
     if (root_signature_) root_signature_->destroy();
     if (per_frame_buffer_) per_frame_buffer_->destroy();
-    if (per_object_buffer_) per_object_buffer_->destroy();
     if (material_buffer_) material_buffer_->destroy();
     if (default_sampler_) default_sampler_->destroy();
     if (clamp_sampler_) clamp_sampler_->destroy();
@@ -52,7 +52,7 @@ void NPRForwardPass::init() {
     }
     
     create_uniform_buffers();
-    if (!per_frame_buffer_ || !per_object_buffer_ || !material_buffer_) {
+    if (!per_frame_buffer_ || !material_buffer_) {
         ERR(LogNPRForwardPass, "Failed to create uniform buffers");
         return;
     }
@@ -142,20 +142,6 @@ void NPRForwardPass::create_uniform_buffers() {
         return;
     }
     
-    // Create per-object buffer (b1)
-    RHIBufferInfo object_info = {};
-    object_info.size = sizeof(NPRPerObjectData);
-    object_info.stride = 0;
-    object_info.memory_usage = MEMORY_USAGE_CPU_TO_GPU;
-    object_info.type = RESOURCE_TYPE_UNIFORM_BUFFER;
-    object_info.creation_flag = BUFFER_CREATION_PERSISTENT_MAP;
-    
-    per_object_buffer_ = backend->create_buffer(object_info);
-    if (!per_object_buffer_) {
-        ERR(LogNPRForwardPass, "Failed to create per-object buffer");
-        return;
-    }
-    
     // Create material buffer (b2)
     RHIBufferInfo material_info = {};
     material_info.size = sizeof(NPRMaterialData);
@@ -307,6 +293,8 @@ void NPRForwardPass::create_pipeline() {
     pipe_info.vertex_input_state.vertex_elements[3].semantic_name = "TEXCOORD";
     pipe_info.vertex_input_state.vertex_elements[3].format = FORMAT_R32G32_SFLOAT;
     pipe_info.vertex_input_state.vertex_elements[3].offset = 0;
+    // Instance index - stream 4
+    pipe_info.vertex_input_state.vertex_elements.push_back(MeshInstanceBuffer::vertex_element(4));
     
     pipe_info.rasterizer_state.cull_mode = CULL_MODE_NONE;
     pipe_info.rasterizer_state.fill_mode = FILL_MODE_SOLID;
@@ -406,18 +394,10 @@ void NPRForwardPass::draw_batch(RHICommandContextRef cmd, const DrawBatch& batch
         cmd->bind_texture(depth_texture_, 4, SHADER_FREQUENCY_FRAGMENT);
     }
 
-    // Update per-object buffer
-    if (per_object_buffer_) {
-        NPRPerObjectData object_data;
-        object_data.model = batch.model_matrix;
-        object_data.inv_model = batch.inv_model_matrix;
-        void* mapped = per_object_buffer_->map();
-        if (mapped) {
-            memcpy(mapped, &object_data, sizeof(object_data));
-            per_object_buffer_->unmap();
-        }
-        cmd->bind_constant_buffer(per_object_buffer_, 1, SHADER_FREQUENCY_VERTEX);
-    }
+    // Single instance
+    object_ids_.assign(1, batch.object_id);
+    if (!instance_buffer_.upload(object_ids_)) return;
+    instance_buffer_.bind(cmd, 5, 4);
 
     // Update material buffer
     auto npr_mat = std::dynamic_pointer_cast<NPRMaterial>(batch.material);
@@ -538,6 +518,7 @@ void NPRForwardPass::execute_batches(RHICommandListRef cmd, const std::vector<Dr
             initialized_, (pipeline_ != nullptr), (cmd != nullptr));
         return;
     }
+    Timer submit_timer;
 
     // Set viewport and scissor - always set them to ensure valid rendering state
     cmd->set_viewport({0, 0}, {extent.width, extent.height});
@@ -574,20 +555,14 @@ void NPRForwardPass::execute_batches(RHICommandListRef cmd, const std::vector<Dr
         }
     }
 
-    // Draw all batches
-    for (const auto& batch : batches) {
-        // Update per-object buffer
-        if (per_object_buffer_) {
-            NPRPerObjectData object_data;
-            object_data.model = batch.model_matrix;
-            object_data.inv_model = batch.inv_model_matrix;
-            void* mapped = per_object_buffer_->map();
-            if (mapped) {
-                memcpy(mapped, &object_data, sizeof(object_data));
-                per_object_buffer_->unmap();
-            }
-            cmd->bind_constant_buffer(per_object_buffer_, 1, SHADER_FREQUENCY_VERTEX);
-        }
+    // One upload of the object ids and draw arguments, each run binds its state once
+    MeshPassProcessor::build_indirect_draws(batches, indirect_commands_, indirect_runs_, object_ids_);
+    if (!instance_buffer_.upload(object_ids_)) return;
+    if (!indirect_buffer_.upload(indirect_commands_)) return;
+    instance_buffer_.bind(cmd, 5, 4);
+
+    for (const auto& run : indirect_runs_) {
+        const DrawBatch& batch = batches[run.batch_index];
 
         // Update material buffer
         auto npr_mat = std::dynamic_pointer_cast<NPRMaterial>(batch.material);
@@ -691,24 +666,31 @@ void NPRForwardPass::execute_batches(RHICommandListRef cmd, const std::vector<Dr
         // Draw
         if (batch.index_buffer) {
             cmd->bind_index_buffer(batch.index_buffer, 0);
-            cmd->draw_indexed(batch.index_count, 1, batch.index_offset, 0, 0);
+            indirect_buffer_.draw(cmd, run);
         }
     }
+
+    instancing_stats_.batch_count = static_cast<uint32_t>(batches.size());
+    instancing_stats_.draw_count = static_cast<uint32_t>(indirect_commands_.size());
+    instancing_stats_.submit_count = static_cast<uint32_t>(indirect_runs_.size());
+    instancing_stats_.submit_ms = submit_timer.get_total_ms();
 }
 
 void NPRForwardPass::build(RDGBuilder& builder, RDGTextureHandle color_target, 
                            RDGTextureHandle depth_target,
                            const std::vector<DrawBatch>& batches) {
+    instancing_stats_ = InstancingStats{};
     if (!initialized_ || !pipeline_) {
         ERR(LogNPRForwardPass, "Build failed: not initialized or no pipeline");
         return;
     }
     
-    // Get extent from render system (color_target doesn't have direct extent access)
+    // Get extent from render system (color_target doesn't have direct extent access);
+    // under dynamic resolution this is the rendered region, not the target size
     Extent2D extent = {1280, 720};  // Default fallback
     auto* render_system = EngineContext::render_system();
-    if (render_system && render_system->get_swapchain()) {
-        extent = render_system->get_swapchain()->get_extent();
+    if (render_system) {
+        extent = render_system->get_render_extent();
     }
     
     // Create render pass
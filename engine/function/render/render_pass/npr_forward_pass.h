@@ -1,6 +1,7 @@
 #pragma once
 
 #include "engine/function/render/render_pass/render_pass.h"
+#include "engine/function/render/render_pass/mesh_pass.h"
 #include "engine/function/render/graph/rdg_builder.h"
 #include "engine/function/render/rhi/rhi_resource.h"
 #include "engine/function/render/render_resource/shader.h"
@@ -9,9 +10,6 @@
 
 namespace render {
 
-// Forward declarations
-struct DrawBatch;
-
 // NPR Per-frame data structure (matches HLSL cbuffer)
 struct NPRPerFrameData {
     Mat4 view;
@@ -26,12 +24,6 @@ struct NPRPerFrameData {
     float light_intensity;
 };
 
-// NPR Per-object data structure (matches HLSL cbuffer)
-struct NPRPerObjectData {
-    Mat4 model;
-    Mat4 inv_model;
-};
-
 // NPR Material data structure (matches HLSL cbuffer)
 // Size must be 16-byte aligned for DX11 constant buffers
 struct NPRMaterialData {
@@ -101,7 +93,7 @@ public:
     void draw_batch(RHICommandContextRef command, const DrawBatch& batch, const Extent2D& extent);
 
     /**
-     * @brief Execute rendering of batches directly
+     * @brief Execute rendering of batches directly, merging identical consecutive batches into instanced draws
      */
     void execute_batches(RHICommandListRef command, const std::vector<DrawBatch>& batches, const Extent2D& extent);
 
@@ -116,6 +108,7 @@ public:
     bool is_initialized() const { return initialized_; }
     
     RHIGraphicsPipelineRef get_pipeline() const { return pipeline_; }
+    const InstancingStats& get_instancing_stats() const { return instancing_stats_; }
     
     std::string_view get_name() const override { return "NPRForwardPass"; }
     PassType get_type() const override { return PassType::Forward; }
@@ -139,13 +132,20 @@ private:
     
     // Uniform buffers
     RHIBufferRef per_frame_buffer_;
-    RHIBufferRef per_object_buffer_;
     RHIBufferRef material_buffer_;
     
     // Samplers
     RHISamplerRef default_sampler_;
     RHISamplerRef clamp_sampler_;
     
+    // Object table (t5) and object id stream (stream 4)
+    MeshInstanceBuffer instance_buffer_;
+    MeshIndirectBuffer indirect_buffer_;
+    std::vector<RHIIndexedIndirectCommand> indirect_commands_;
+    std::vector<IndirectDrawRun> indirect_runs_;
+    std::vector<uint32_t> object_ids_;
+    InstancingStats instancing_stats_;
+    
     // Depth texture for screen space rim light (from depth prepass)
     RHITextureRef depth_texture_;
     
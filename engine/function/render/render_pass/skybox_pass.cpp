@@ -1,5 +1,5 @@
 #include "engine/function/render/render_pass/skybox_pass.h"
-#include "engine/function/framework/component/skybox_component.h"
+#include "engine/function/render/render_system/render_scene_snapshot.h"
 #include "engine/function/render/render_resource/skybox_material.h"
 #include "engine/function/render/render_resource/mesh.h"
 #include "engine/function/render/render_resource/shader_utils.h"
@@ -326,7 +326,7 @@ void SkyboxPass::build(RDGBuilder& builder) {
 
 void SkyboxPass::build(RDGBuilder& builder, RDGTextureHandle color_target,
                        RDGTextureHandle depth_target, const Mat4& view, const Mat4& proj,
-                       const std::vector<SkyboxComponent*>& skyboxes) {
+                       const std::vector<RenderSkyboxSnapshot>& skyboxes) {
     if (!initialized_ || !pipeline_) {
         WARN(LogSkyboxPass, "SkyboxPass not initialized");
         return;
@@ -361,14 +361,9 @@ void SkyboxPass::build(RDGBuilder& builder, RDGTextureHandle color_target,
     
     // Build render pass for each skybox
     int skybox_index = 0;
-    for (auto* skybox : skyboxes) {
+    for (const auto& skybox : skyboxes) {
         skybox_index++;
-        if (!skybox) {
-            WARN(LogSkyboxPass, "Skybox {} is null", skybox_index);
-            continue;
-        }
-        
-        auto material = skybox->get_material();
+        auto material = skybox.material;
         if (!material) {
             WARN(LogSkyboxPass, "Skybox {} has no material", skybox_index);
             continue;
@@ -399,7 +394,7 @@ void SkyboxPass::build(RDGBuilder& builder, RDGTextureHandle color_target,
         float intensity = material->get_intensity();
         
         // Build skybox at camera position with specified scale
-        float scale = skybox->get_skybox_scale();
+        float scale = skybox.scale;
         Mat4 model = Mat4::Identity();
         model.m[0][0] = scale;
         model.m[1][1] = scale;
@@ -409,6 +404,8 @@ void SkyboxPass::build(RDGBuilder& builder, RDGTextureHandle color_target,
         float captured_intensity = intensity;
         Mat4 captured_model = model;
         RHITextureRef captured_cube_tex = cube_texture->texture_;
+        auto* render_system = EngineContext::render_system();
+        Extent2D extent = render_system ? render_system->get_render_extent() : Extent2D{1280, 720};
         
         // Create render pass
         builder.create_render_pass("SkyboxPass")
@@ -416,13 +413,16 @@ void SkyboxPass::build(RDGBuilder& builder, RDGTextureHandle color_target,
             .depth_stencil(depth_target, ATTACHMENT_LOAD_OP_LOAD, ATTACHMENT_STORE_OP_DONT_CARE, 
                           1.0f, 0, {}, true)  // Read-only depth
             .execute([this, captured_model, captured_intensity, captured_cube_tex,
-                     vertex_buffer, index_buffer, index_count](RDGPassContext context) {
+                     vertex_buffer, index_buffer, index_count, extent](RDGPassContext context) {
                 RHICommandListRef cmd = context.command;
                 if (!cmd) {
                     WARN(LogSkyboxPass, "Execute lambda: command is null");
                     return;
                 }
                 
+                // Same region as the scene passes under dynamic resolution
+                cmd->set_viewport({0, 0}, {extent.width, extent.height});
+                cmd->set_scissor({0, 0}, {extent.width, extent.height});
                 cmd->set_graphics_pipeline(pipeline_);
                 
                 // Update and bind per-frame buffer
@@ -8,7 +8,7 @@
 #include <vector>
 
 // Forward declarations
-class SkyboxComponent;
+struct RenderSkyboxSnapshot;
 class Mesh;
 using MeshRef = std::shared_ptr<Mesh>;
 
@@ -38,11 +38,11 @@ public:
      * @param depth_target Depth attachment target (for depth test)
      * @param view View matrix (will have translation removed)
      * @param proj Projection matrix
-     * @param skyboxes List of skybox components to render
+     * @param skyboxes Skyboxes extracted from the scene this frame
      */
     void build(RDGBuilder& builder, RDGTextureHandle color_target,
                RDGTextureHandle depth_target, const Mat4& view, const Mat4& proj,
-               const std::vector<SkyboxComponent*>& skyboxes);
+               const std::vector<RenderSkyboxSnapshot>& skyboxes);
 
     PassType get_type() const override { return PassType::Forward; }
     std::string_view get_name() const override { return "SkyboxPass"; }
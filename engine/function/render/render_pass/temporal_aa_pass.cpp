@@ -0,0 +1,218 @@
+#include "engine/function/render/render_pass/temporal_aa_pass.h"
+#include "engine/main/engine_context.h"
+#include "engine/function/render/render_system/render_system.h"
+#include "engine/function/render/rhi/rhi_command_list.h"
+#include "engine/function/render/render_resource/shader_utils.h"
+#include "engine/core/log/Log.h"
+#include <cstring>
+
+DEFINE_LOG_TAG(LogTemporalAAPass, "TemporalAAPass");
+
+namespace render {
+
+TemporalAAPass::~TemporalAAPass() {
+    if (pipeline_) pipeline_->destroy();
+    if (root_signature_) root_signature_->destroy();
+    if (params_buffer_) params_buffer_->destroy();
+    if (sampler_) sampler_->destroy();
+}
+
+void TemporalAAPass::init() {
+    INFO(LogTemporalAAPass, "Initializing TemporalAAPass...");
+
+    create_shaders();
+    if (!vertex_shader_ || !fragment_shader_) {
+        ERR(LogTemporalAAPass, "Failed to create shaders");
+        return;
+    }
+
+    create_resources();
+    if (!params_buffer_ || !sampler_) {
+        ERR(LogTemporalAAPass, "Failed to create resources");
+        return;
+    }
+
+    create_pipeline();
+    if (!pipeline_) {
+        ERR(LogTemporalAAPass, "Failed to create pipeline");
+        return;
+    }
+
+    initialized_ = true;
+    INFO(LogTemporalAAPass, "TemporalAAPass initialized successfully");
+}
+
+void TemporalAAPass::create_shaders() {
+    auto backend = EngineContext::rhi();
+    if (!backend) return;
+
+    auto vs_code = ShaderUtils::load_or_compile("temporal_aa_vs.cso", nullptr, "VSMain", "vs_5_0");
+    if (vs_code.empty()) {
+        ERR(LogTemporalAAPass, "Failed to load/compile vertex shader");
+        return;
+    }
+    RHIShaderInfo vs_info = {};
+    vs_info.entry = "VSMain";
+    vs_info.frequency = SHADER_FREQUENCY_VERTEX;
+    vs_info.code = vs_code;
+    if (auto vs = backend->create_shader(vs_info)) {
+        vertex_shader_ = std::make_shared<Shader>();
+        vertex_shader_->shader_ = vs;
+    }
+
+    auto ps_code = ShaderUtils::load_or_compile("temporal_aa_ps.cso", nullptr, "PSMain", "ps_5_0");
+    if (ps_code.empty()) {
+        ERR(LogTemporalAAPass, "Failed to load/compile pixel shader");
+        return;
+    }
+    RHIShaderInfo ps_info = {};
+    ps_info.entry = "PSMain";
+    ps_info.frequency = SHADER_FREQUENCY_FRAGMENT;
+    ps_info.code = ps_code;
+    if (auto ps = backend->create_shader(ps_info)) {
+        fragment_shader_ = std::make_shared<Shader>();
+        fragment_shader_->shader_ = ps;
+    }
+}
+
+void TemporalAAPass::create_resources() {
+    auto backend = EngineContext::rhi();
+    if (!backend) return;
+
+    RHIBufferInfo params_info = {};
+    params_info.size = sizeof(TemporalAAParams);
+    params_info.stride = 0;
+    params_info.memory_usage = MEMORY_USAGE_CPU_TO_GPU;
+    params_info.type = RESOURCE_TYPE_UNIFORM_BUFFER;
+    params_info.creation_flag = BUFFER_CREATION_PERSISTENT_MAP;
+    params_buffer_ = backend->create_buffer(params_info);
+
+    // History is resampled bilinearly at the reprojected position; the current frame uses Load
+    RHISamplerInfo sampler_info = {};
+    sampler_info.min_filter = FILTER_TYPE_LINEAR;
+    sampler_info.mag_filter = FILTER_TYPE_LINEAR;
+    sampler_info.mipmap_mode = MIPMAP_MODE_LINEAR;
+    sampler_info.address_mode_u = ADDRESS_MODE_CLAMP_TO_EDGE;
+    sampler_info.address_mode_v = ADDRESS_MODE_CLAMP_TO_EDGE;
+    sampler_info.address_mode_w = ADDRESS_MODE_CLAMP_TO_EDGE;
+    sampler_ = backend->create_sampler(sampler_info);
+}
+
+void TemporalAAPass::create_pipeline() {
+    auto backend = EngineContext::rhi();
+    if (!backend || !vertex_shader_ || !fragment_shader_) return;
+
+    RHIRootSignatureInfo root_info = {};
+    root_signature_ = backend->create_root_signature(root_info);
+    if (!root_signature_) return;
+
+    RHIGraphicsPipelineInfo pipe_info = {};
+    pipe_info.vertex_shader = vertex_shader_->shader_;
+    pipe_info.fragment_shader = fragment_shader_->shader_;
+    pipe_info.root_signature = root_signature_;
+    pipe_info.primitive_type = PRIMITIVE_TYPE_TRIANGLE_LIST;
+
+    // No vertex input - using SV_VertexID
+    pipe_info.vertex_input_state.vertex_elements.clear();
+
+    pipe_info.rasterizer_state.cull_mode = CULL_MODE_NONE;
+    pipe_info.rasterizer_state.fill_mode = FILL_MODE_SOLID;
+    pipe_info.rasterizer_state.depth_clip_mode = DEPTH_CLIP;
+
+    pipe_info.depth_stencil_state.enable_depth_test = false;
+    pipe_info.depth_stencil_state.enable_depth_write = false;
+
+    auto render_system = EngineContext::render_system();
+    if (render_system) {
+        pipe_info.color_attachment_formats[0] = render_system->get_color_format();
+    } else {
+        pipe_info.color_attachment_formats[0] = FORMAT_R8G8B8A8_UNORM;
+    }
+    pipe_info.color_attachment_formats[1] = get_history_format();
+
+    pipeline_ = backend->create_graphics_pipeline(pipe_info);
+}
+
+void TemporalAAPass::build(RDGBuilder& builder, RDGTextureHandle scene_color, RDGTextureHandle depth,
+                           std::optional<RDGTextureHandle> velocity, Extent2D render_extent,
+                           RDGTextureHandle target, Extent2D output_extent,
+                           const TemporalAAView& view, const TemporalAASettings& settings) {
+    if (!is_ready() || render_extent.width == 0 || render_extent.height == 0) return;
+
+    // History from another output size (or none at all) is not reprojected
+    bool history_valid = view.history_valid && history_.texture &&
+                         history_.texture->get_info().extent.width == output_extent.width &&
+                         history_.texture->get_info().extent.height == output_extent.height;
+    std::optional<RDGTextureHandle> history;
+    if (history_valid) {
+        history = builder.create_texture("TemporalAA_History")
+            .import(history_)
+            .finish();
+    }
+    history_ = {};
+
+    RDGTextureHandle next_history = builder.create_texture("TemporalAA_NextHistory")
+        .extent({output_extent.width, output_extent.height, 1})
+        .format(get_history_format())
+        .allow_render_target()
+        .extract(&history_)
+        .finish();
+
+    TemporalAAParams params = {};
+    params.inv_view_proj = view.inv_view_projection;
+    params.prev_view_proj = view.prev_view_projection;
+    params.render_size = Vec2(static_cast<float>(render_extent.width), static_cast<float>(render_extent.height));
+    params.output_size = Vec2(static_cast<float>(output_extent.width), static_cast<float>(output_extent.height));
+    params.jitter_pixels = view.jitter_pixels;
+    params.history_weight = settings.history_weight;
+    params.clamp_gamma = settings.clamp_gamma;
+    params.history_valid = history_valid ? 1.0f : 0.0f;
+    params.has_velocity = velocity.has_value() ? 1.0f : 0.0f;
+
+    auto rp_builder = builder.create_render_pass("TemporalAA_Pass")
+        .color(0, target, ATTACHMENT_LOAD_OP_DONT_CARE, ATTACHMENT_STORE_OP_STORE)
+        .color(1, next_history, ATTACHMENT_LOAD_OP_DONT_CARE, ATTACHMENT_STORE_OP_STORE)
+        .read(0, 0, 0, scene_color)
+        .read(0, 2, 0, depth);
+    if (velocity) rp_builder.read(0, 1, 0, velocity.value());
+    if (history) rp_builder.read(0, 3, 0, history.value());
+
+    rp_builder.execute([this, scene_color, depth, velocity, history, params, output_extent](RDGPassContext context) {
+        RHICommandListRef cmd = context.command;
+        if (!cmd) return;
+
+        cmd->set_viewport({0, 0}, {output_extent.width, output_extent.height});
+        cmd->set_scissor({0, 0}, {output_extent.width, output_extent.height});
+        cmd->set_graphics_pipeline(pipeline_);
+
+        void* mapped = params_buffer_->map();
+        if (mapped) {
+            memcpy(mapped, &params, sizeof(TemporalAAParams));
+            params_buffer_->unmap();
+        }
+        cmd->bind_constant_buffer(params_buffer_, 0, SHADER_FREQUENCY_FRAGMENT);
+
+        if (RHITextureRef texture = context.builder->resolve(scene_color)) {
+            cmd->bind_texture(texture, 0, SHADER_FREQUENCY_FRAGMENT);
+        }
+        if (velocity) {
+            if (RHITextureRef texture = context.builder->resolve(velocity.value())) {
+                cmd->bind_texture(texture, 1, SHADER_FREQUENCY_FRAGMENT);
+            }
+        }
+        if (RHITextureRef texture = context.builder->resolve(depth)) {
+            cmd->bind_texture(texture, 2, SHADER_FREQUENCY_FRAGMENT);
+        }
+        if (history) {
+            if (RHITextureRef texture = context.builder->resolve(history.value())) {
+                cmd->bind_texture(texture, 3, SHADER_FREQUENCY_FRAGMENT);
+            }
+        }
+        cmd->bind_sampler(sampler_, 0, SHADER_FREQUENCY_FRAGMENT);
+
+        cmd->draw(3, 1, 0, 0);  // Full-screen triangle using SV_VertexID
+    })
+    .finish();
+}
+
+} // namespace render
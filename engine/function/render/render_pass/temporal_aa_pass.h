@@ -0,0 +1,85 @@
+#pragma once
+
+#include "engine/function/render/render_pass/render_pass.h"
+#include "engine/function/render/render_resource/shader.h"
+#include "engine/function/render/render_system/temporal_aa.h"
+#include "engine/core/math/math.h"
+#include <optional>
+
+namespace render {
+
+/**
+ * @brief Constants of the temporal AA shader
+ */
+struct TemporalAAParams {
+    Mat4 inv_view_proj;         // Inverse of the jittered view-projection
+    Mat4 prev_view_proj;        // Unjittered, previous frame
+    Vec2 render_size;
+    Vec2 output_size;
+    Vec2 jitter_pixels;
+    float history_weight;
+    float clamp_gamma;
+    float history_valid;
+    float has_velocity;
+    Vec2 _padding;
+};
+
+/**
+ * @brief Temporal anti-aliasing and upscale to output resolution
+ *
+ * Reads the jittered scene color from the dynamic resolution region, filters a 3x3 neighbourhood
+ * around each output pixel and blends it with the previous output, reprojected with the G-buffer
+ * motion vectors (or camera motion from depth where there are none) and clipped to the
+ * neighbourhood's color box. The result goes to the target and to a new history texture that the
+ * graph extracts for the next frame.
+ */
+class TemporalAAPass : public RenderPass {
+public:
+    TemporalAAPass() = default;
+    ~TemporalAAPass() override;
+
+    void init() override;
+    void build(RDGBuilder& builder) override {}
+
+    /**
+     * @param scene_color Full-size texture holding the jittered render_extent region at its top-left corner
+     * @param depth Depth of the same region
+     * @param velocity G-buffer motion vectors, if the G-buffer was drawn this frame
+     * @param target Output, drawn over its whole output_extent
+     */
+    void build(RDGBuilder& builder, RDGTextureHandle scene_color, RDGTextureHandle depth,
+               std::optional<RDGTextureHandle> velocity, Extent2D render_extent,
+               RDGTextureHandle target, Extent2D output_extent,
+               const TemporalAAView& view, const TemporalAASettings& settings);
+
+    /**
+     * @brief Drop the history, the next frame starts from its own samples
+     */
+    void reset_history() { history_ = {}; }
+    bool has_history() const { return history_.texture != nullptr; }
+
+    std::string_view get_name() const override { return "TemporalAAPass"; }
+    PassType get_type() const override { return PassType::PostProcess; }
+
+    bool is_ready() const { return initialized_ && pipeline_ != nullptr; }
+
+    static RHIFormat get_history_format() { return FORMAT_R16G16B16A16_SFLOAT; }
+
+private:
+    void create_shaders();
+    void create_resources();
+    void create_pipeline();
+
+    ShaderRef vertex_shader_;
+    ShaderRef fragment_shader_;
+    RHIRootSignatureRef root_signature_;
+    RHIGraphicsPipelineRef pipeline_;
+    RHIBufferRef params_buffer_;
+    RHISamplerRef sampler_;
+
+    RDGExtractedTexture history_;   // Last frame's output, extracted from its graph
+
+    bool initialized_ = false;
+};
+
+} // namespace render
@@ -0,0 +1,173 @@
+#include "engine/function/render/render_pass/upscale_pass.h"
+#include "engine/main/engine_context.h"
+#include "engine/function/render/render_system/render_system.h"
+#include "engine/function/render/rhi/rhi_command_list.h"
+#include "engine/function/render/render_resource/shader_utils.h"
+#include "engine/core/log/Log.h"
+#include <cstring>
+
+DEFINE_LOG_TAG(LogUpscalePass, "UpscalePass");
+
+namespace render {
+
+UpscalePass::~UpscalePass() {
+    if (pipeline_) pipeline_->destroy();
+    if (root_signature_) root_signature_->destroy();
+    if (params_buffer_) params_buffer_->destroy();
+    if (sampler_) sampler_->destroy();
+}
+
+void UpscalePass::init() {
+    INFO(LogUpscalePass, "Initializing UpscalePass...");
+
+    create_shaders();
+    if (!vertex_shader_ || !fragment_shader_) {
+        ERR(LogUpscalePass, "Failed to create shaders");
+        return;
+    }
+
+    create_resources();
+    if (!params_buffer_ || !sampler_) {
+        ERR(LogUpscalePass, "Failed to create resources");
+        return;
+    }
+
+    create_pipeline();
+    if (!pipeline_) {
+        ERR(LogUpscalePass, "Failed to create pipeline");
+        return;
+    }
+
+    initialized_ = true;
+    INFO(LogUpscalePass, "UpscalePass initialized successfully");
+}
+
+void UpscalePass::create_shaders() {
+    auto backend = EngineContext::rhi();
+    if (!backend) return;
+
+    auto vs_code = ShaderUtils::load_or_compile("upscale_vs.cso", nullptr, "VSMain", "vs_5_0");
+    if (vs_code.empty()) {
+        ERR(LogUpscalePass, "Failed to load/compile vertex shader");
+        return;
+    }
+    RHIShaderInfo vs_info = {};
+    vs_info.entry = "VSMain";
+    vs_info.frequency = SHADER_FREQUENCY_VERTEX;
+    vs_info.code = vs_code;
+    if (auto vs = backend->create_shader(vs_info)) {
+        vertex_shader_ = std::make_shared<Shader>();
+        vertex_shader_->shader_ = vs;
+    }
+
+    auto ps_code = ShaderUtils::load_or_compile("upscale_ps.cso", nullptr, "PSMain", "ps_5_0");
+    if (ps_code.empty()) {
+        ERR(LogUpscalePass, "Failed to load/compile pixel shader");
+        return;
+    }
+    RHIShaderInfo ps_info = {};
+    ps_info.entry = "PSMain";
+    ps_info.frequency = SHADER_FREQUENCY_FRAGMENT;
+    ps_info.code = ps_code;
+    if (auto ps = backend->create_shader(ps_info)) {
+        fragment_shader_ = std::make_shared<Shader>();
+        fragment_shader_->shader_ = ps;
+    }
+}
+
+void UpscalePass::create_resources() {
+    auto backend = EngineContext::rhi();
+    if (!backend) return;
+
+    RHIBufferInfo params_info = {};
+    params_info.size = sizeof(UpscaleParams);
+    params_info.stride = 0;
+    params_info.memory_usage = MEMORY_USAGE_CPU_TO_GPU;
+    params_info.type = RESOURCE_TYPE_UNIFORM_BUFFER;
+    params_info.creation_flag = BUFFER_CREATION_PERSISTENT_MAP;
+    params_buffer_ = backend->create_buffer(params_info);
+
+    // Bilinear, clamped: the shader keeps taps inside the rendered region
+    RHISamplerInfo sampler_info = {};
+    sampler_info.min_filter = FILTER_TYPE_LINEAR;
+    sampler_info.mag_filter = FILTER_TYPE_LINEAR;
+    sampler_info.mipmap_mode = MIPMAP_MODE_LINEAR;
+    sampler_info.address_mode_u = ADDRESS_MODE_CLAMP_TO_EDGE;
+    sampler_info.address_mode_v = ADDRESS_MODE_CLAMP_TO_EDGE;
+    sampler_info.address_mode_w = ADDRESS_MODE_CLAMP_TO_EDGE;
+    sampler_ = backend->create_sampler(sampler_info);
+}
+
+void UpscalePass::create_pipeline() {
+    auto backend = EngineContext::rhi();
+    if (!backend || !vertex_shader_ || !fragment_shader_) return;
+
+    RHIRootSignatureInfo root_info = {};
+    root_signature_ = backend->create_root_signature(root_info);
+    if (!root_signature_) return;
+
+    RHIGraphicsPipelineInfo pipe_info = {};
+    pipe_info.vertex_shader = vertex_shader_->shader_;
+    pipe_info.fragment_shader = fragment_shader_->shader_;
+    pipe_info.root_signature = root_signature_;
+    pipe_info.primitive_type = PRIMITIVE_TYPE_TRIANGLE_LIST;
+
+    // No vertex input - using SV_VertexID
+    pipe_info.vertex_input_state.vertex_elements.clear();
+
+    pipe_info.rasterizer_state.cull_mode = CULL_MODE_NONE;
+    pipe_info.rasterizer_state.fill_mode = FILL_MODE_SOLID;
+    pipe_info.rasterizer_state.depth_clip_mode = DEPTH_CLIP;
+
+    pipe_info.depth_stencil_state.enable_depth_test = false;
+    pipe_info.depth_stencil_state.enable_depth_write = false;
+
+    auto render_system = EngineContext::render_system();
+    if (render_system) {
+        pipe_info.color_attachment_formats[0] = render_system->get_color_format();
+    } else {
+        pipe_info.color_attachment_formats[0] = FORMAT_R8G8B8A8_UNORM;
+    }
+
+    pipeline_ = backend->create_graphics_pipeline(pipe_info);
+}
+
+void UpscalePass::build(RDGBuilder& builder, RDGTextureHandle source, Extent2D source_extent, Extent2D texture_extent,
+                        RDGTextureHandle target, Extent2D target_extent) {
+    if (!is_ready() || texture_extent.width == 0 || texture_extent.height == 0) return;
+
+    float texture_width = static_cast<float>(texture_extent.width);
+    float texture_height = static_cast<float>(texture_extent.height);
+    params_.uv_scale = Vec2(source_extent.width / texture_width, source_extent.height / texture_height);
+    params_.uv_max = Vec2((source_extent.width - 0.5f) / texture_width, (source_extent.height - 0.5f) / texture_height);
+    UpscaleParams params = params_;
+
+    builder.create_render_pass("Upscale_Pass")
+        .color(0, target, ATTACHMENT_LOAD_OP_DONT_CARE, ATTACHMENT_STORE_OP_STORE)
+        .read(0, 0, 0, source)
+        .execute([this, source, params, target_extent](RDGPassContext context) {
+            RHICommandListRef cmd = context.command;
+            if (!cmd) return;
+
+            cmd->set_viewport({0, 0}, {target_extent.width, target_extent.height});
+            cmd->set_scissor({0, 0}, {target_extent.width, target_extent.height});
+            cmd->set_graphics_pipeline(pipeline_);
+
+            void* mapped = params_buffer_->map();
+            if (mapped) {
+                memcpy(mapped, &params, sizeof(UpscaleParams));
+                params_buffer_->unmap();
+            }
+            cmd->bind_constant_buffer(params_buffer_, 0, SHADER_FREQUENCY_FRAGMENT);
+
+            if (RHITextureRef source_texture = context.builder->resolve(source)) {
+                cmd->bind_texture(source_texture, 0, SHADER_FREQUENCY_FRAGMENT);
+            }
+            cmd->bind_sampler(sampler_, 0, SHADER_FREQUENCY_FRAGMENT);
+
+            cmd->draw(3, 1, 0, 0);  // Full-screen triangle using SV_VertexID
+        })
+        .finish();
+}
+
+} // namespace render
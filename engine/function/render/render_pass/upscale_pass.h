@@ -0,0 +1,62 @@
+#pragma once
+
+#include "engine/function/render/render_pass/render_pass.h"
+#include "engine/function/render/render_resource/shader.h"
+#include "engine/core/math/math.h"
+
+namespace render {
+
+/**
+ * @brief Constants of the upscale shader
+ */
+struct UpscaleParams {
+    Vec2 uv_scale;      // Rendered region / texture size
+    Vec2 uv_max;        // Center of the region's last texel
+};
+
+/**
+ * @brief Bilinear upscale of the dynamic resolution region to the output
+ *
+ * The scene passes render into the top-left source_extent of a full-size texture, so the pooled
+ * targets keep one size whatever the render scale. This pass stretches that region over the
+ * whole target; the editor UI is drawn afterwards at full resolution.
+ */
+class UpscalePass : public RenderPass {
+public:
+    UpscalePass() = default;
+    ~UpscalePass() override;
+
+    void init() override;
+    void build(RDGBuilder& builder) override {}
+
+    /**
+     * @param source Full-size texture holding the rendered region at its top-left corner
+     * @param source_extent Size of the rendered region
+     * @param texture_extent Size of the source texture
+     * @param target Output, drawn over its whole target_extent
+     */
+    void build(RDGBuilder& builder, RDGTextureHandle source, Extent2D source_extent, Extent2D texture_extent,
+               RDGTextureHandle target, Extent2D target_extent);
+
+    std::string_view get_name() const override { return "UpscalePass"; }
+    PassType get_type() const override { return PassType::PostProcess; }
+
+    bool is_ready() const { return initialized_ && pipeline_ != nullptr; }
+
+private:
+    void create_shaders();
+    void create_resources();
+    void create_pipeline();
+
+    ShaderRef vertex_shader_;
+    ShaderRef fragment_shader_;
+    RHIRootSignatureRef root_signature_;
+    RHIGraphicsPipelineRef pipeline_;
+    RHIBufferRef params_buffer_;
+    RHISamplerRef sampler_;
+    UpscaleParams params_ = {};
+
+    bool initialized_ = false;
+};
+
+} // namespace render
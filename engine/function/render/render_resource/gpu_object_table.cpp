@@ -0,0 +1,160 @@
+#include "engine/function/render/render_resource/gpu_object_table.h"
+#include "engine/function/render/rhi/rhi.h"
+#include "engine/core/log/Log.h"
+#include "engine/core/utils/profiler.h"
+#include "engine/core/utils/timer.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+DEFINE_LOG_TAG(LogGPUObjectTable, "GPUObjectTable");
+
+// Shaders declare StructuredBuffer<ObjectInfo> with the same tightly packed layout
+static_assert(sizeof(ObjectInfo) == 280, "ObjectInfo layout must match the HLSL ObjectInfo struct");
+
+GPUObjectTable::~GPUObjectTable() {
+    destroy();
+}
+
+bool GPUObjectTable::init(RHIBackend& backend, uint32_t capacity) {
+    destroy();
+
+    RHIBufferInfo info = {};
+    info.size = static_cast<uint64_t>(capacity) * sizeof(ObjectInfo);
+    info.stride = sizeof(ObjectInfo);
+    info.memory_usage = MEMORY_USAGE_GPU_ONLY;
+    info.type = RESOURCE_TYPE_BUFFER;
+    buffer_ = backend.create_buffer(info);
+    if (!buffer_) {
+        ERR(LogGPUObjectTable, "Failed to create object table for {} objects", capacity);
+        return false;
+    }
+    backend.set_name(buffer_, "GPUObjectTable");
+
+    objects_.assign(capacity, ObjectInfo{});
+    dirty_pages_.assign((capacity + PAGE_SIZE - 1) / PAGE_SIZE, 0);
+
+    // The GPU buffer starts out undefined, upload everything once
+    if (!dirty_pages_.empty()) {
+        std::fill(dirty_pages_.begin(), dirty_pages_.end(), uint8_t(1));
+        dirty_first_ = 0;
+        dirty_last_ = static_cast<uint32_t>(dirty_pages_.size()) - 1;
+    }
+    return true;
+}
+
+void GPUObjectTable::destroy() {
+    if (buffer_) buffer_->destroy();
+    for (auto& staging : staging_) {
+        if (staging) staging->destroy();
+        staging = nullptr;
+    }
+    buffer_ = nullptr;
+    objects_.clear();
+    dirty_pages_.clear();
+    dirty_first_ = UINT32_MAX;
+    dirty_last_ = 0;
+    updated_objects_ = 0;
+    stats_ = GPUObjectTableStats{};
+}
+
+void GPUObjectTable::set(uint32_t object_id, const ObjectInfo& info) {
+    assert(object_id < objects_.size() && "Object ID out of range");
+    objects_[object_id] = info;
+
+    uint32_t page = object_id / PAGE_SIZE;
+    dirty_pages_[page] = 1;
+    dirty_first_ = std::min(dirty_first_, page);
+    dirty_last_ = std::max(dirty_last_, page);
+    updated_objects_++;
+}
+
+bool GPUObjectTable::reserve_staging(RHIBackend& backend, uint64_t size) {
+    staging_index_ = (staging_index_ + 1) % STAGING_COUNT;
+    RHIBufferRef& staging = staging_[staging_index_];
+    if (staging && staging->get_info().size >= size) return true;
+
+    // Grow in whole pages, to the next power of two, so a busy frame does not reallocate every time
+    uint64_t page_bytes = static_cast<uint64_t>(PAGE_SIZE) * sizeof(ObjectInfo);
+    uint64_t capacity = page_bytes;
+    while (capacity < size) capacity *= 2;
+
+    RHIBufferInfo info = {};
+    info.size = capacity;
+    info.memory_usage = MEMORY_USAGE_CPU_ONLY;
+    info.type = RESOURCE_TYPE_BUFFER;
+    RHIBufferRef buffer = backend.create_buffer(info);
+    if (!buffer) {
+        ERR(LogGPUObjectTable, "Failed to create a {} byte staging buffer", capacity);
+        return false;
+    }
+    backend.set_name(buffer, "GPUObjectTableStaging");
+    if (staging) staging->destroy();
+    staging = buffer;
+    return true;
+}
+
+const GPUObjectTableStats& GPUObjectTable::upload(RHIBackend& backend) {
+    PROFILE_SCOPE("GPUObjectTable_Upload");
+    Timer timer;
+
+    stats_ = GPUObjectTableStats{};
+    stats_.updated_objects = updated_objects_;
+    updated_objects_ = 0;
+    if (!buffer_ || !has_dirty_pages()) return stats_;
+
+    // Merge adjacent dirty pages into runs
+    runs_.clear();
+    uint32_t capacity = get_capacity();
+    for (uint32_t page = dirty_first_; page <= dirty_last_; ++page) {
+        if (!dirty_pages_[page]) continue;
+        uint32_t first = page * PAGE_SIZE;
+        uint32_t count = std::min(PAGE_SIZE, capacity - first);
+        if (!runs_.empty() && runs_.back().first + runs_.back().count == first) {
+            runs_.back().count += count;
+        } else {
+            runs_.push_back(CopyRun{first, count});
+        }
+        stats_.uploaded_objects += count;
+    }
+
+    uint64_t size = static_cast<uint64_t>(stats_.uploaded_objects) * sizeof(ObjectInfo);
+    RHICommandContextImmediateRef command = backend.get_immediate_command();
+    if (!command || !reserve_staging(backend, size)) {
+        ERR(LogGPUObjectTable, "Cannot upload {} dirty objects", stats_.uploaded_objects);
+        stats_.uploaded_objects = 0;
+        return stats_;  // Pages stay dirty and are retried next frame
+    }
+
+    RHIBufferRef staging = staging_[staging_index_];
+    auto* data = static_cast<uint8_t*>(staging->map());
+    if (!data) {
+        ERR(LogGPUObjectTable, "Failed to map staging buffer");
+        stats_.uploaded_objects = 0;
+        return stats_;
+    }
+    uint64_t offset = 0;
+    for (const CopyRun& run : runs_) {
+        uint64_t run_size = static_cast<uint64_t>(run.count) * sizeof(ObjectInfo);
+        memcpy(data + offset, &objects_[run.first], run_size);
+        offset += run_size;
+    }
+    staging->unmap();
+
+    offset = 0;
+    for (const CopyRun& run : runs_) {
+        uint64_t run_size = static_cast<uint64_t>(run.count) * sizeof(ObjectInfo);
+        command->copy_buffer(staging, offset, buffer_, static_cast<uint64_t>(run.first) * sizeof(ObjectInfo), run_size);
+        offset += run_size;
+    }
+
+    std::fill(dirty_pages_.begin() + dirty_first_, dirty_pages_.begin() + dirty_last_ + 1, uint8_t(0));
+    dirty_first_ = UINT32_MAX;
+    dirty_last_ = 0;
+
+    stats_.copy_count = static_cast<uint32_t>(runs_.size());
+    stats_.upload_bytes = size;
+    stats_.upload_ms = timer.get_total_ms();
+    return stats_;
+}
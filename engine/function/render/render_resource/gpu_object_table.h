@@ -0,0 +1,76 @@
+#pragma once
+
+#include "engine/function/render/rhi/rhi_resource.h"
+#include "engine/function/render/data/render_structs.h"
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+class RHIBackend;
+
+struct GPUObjectTableStats {
+    uint32_t updated_objects = 0;   // set() calls since the previous upload
+    uint32_t uploaded_objects = 0;  // Objects copied, including clean objects inside dirty pages
+    uint32_t copy_count = 0;        // Runs of adjacent dirty pages, one buffer copy each
+    uint64_t upload_bytes = 0;
+    float upload_ms = 0.0f;
+};
+
+/**
+ * @brief Persistent GPU table of ObjectInfo, indexed by object id
+ *
+ * The render thread writes objects that changed into a CPU shadow copy; upload() then copies only
+ * the dirty pages into a single GPU-resident structured buffer, once per frame. Static objects
+ * cost nothing after their first upload. Passes bind the buffer once and read each instance's
+ * object id from a per-instance stream (see render::MeshInstanceBuffer), so drawing needs no
+ * per-object constant buffer updates. Render thread only.
+ */
+class GPUObjectTable {
+public:
+    static constexpr uint32_t PAGE_SIZE = 64;       // Objects per dirty page
+    static constexpr uint32_t STAGING_COUNT = 3;    // Staging buffers rotated over frames in flight
+
+    ~GPUObjectTable();
+
+    bool init(RHIBackend& backend, uint32_t capacity);
+    void destroy();
+
+    /**
+     * @brief Overwrite one object and mark its page dirty
+     */
+    void set(uint32_t object_id, const ObjectInfo& info);
+    inline const ObjectInfo& get(uint32_t object_id) const { return objects_[object_id]; }
+
+    /**
+     * @brief Copy the dirty pages to the GPU buffer on the immediate context
+     * @return Stats of this upload
+     */
+    const GPUObjectTableStats& upload(RHIBackend& backend);
+
+    inline bool has_dirty_pages() const { return dirty_first_ <= dirty_last_; }
+    inline RHIBufferRef get_buffer() const { return buffer_; }
+    inline uint32_t get_capacity() const { return static_cast<uint32_t>(objects_.size()); }
+    inline const GPUObjectTableStats& get_stats() const { return stats_; }
+
+private:
+    struct CopyRun {
+        uint32_t first = 0;     // First object of the run
+        uint32_t count = 0;
+    };
+
+    bool reserve_staging(RHIBackend& backend, uint64_t size);
+
+    std::vector<ObjectInfo> objects_;
+    std::vector<uint8_t> dirty_pages_;
+    uint32_t dirty_first_ = UINT32_MAX;     // Bounds of the dirty pages, so clean tables are not scanned
+    uint32_t dirty_last_ = 0;
+    uint32_t updated_objects_ = 0;
+    std::vector<CopyRun> runs_;
+
+    RHIBufferRef buffer_;
+    std::array<RHIBufferRef, STAGING_COUNT> staging_ = {};
+    uint32_t staging_index_ = 0;
+
+    GPUObjectTableStats stats_;
+};
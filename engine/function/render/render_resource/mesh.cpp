@@ -21,6 +21,8 @@ Mesh::~Mesh() {
 }
 
 void Mesh::on_load() {
+    if (lods_.empty()) reset_index_ranges();
+    if (generate_clusters_ && clusters_.empty()) build_mesh_clusters(position_, index_, clusters_);
     create_gpu_buffers();
 }
 
@@ -69,10 +71,34 @@ void Mesh::set_data(
     }
 
     calculate_bounds();
+    reset_index_ranges();
     create_gpu_buffers();
     mark_dirty();
 }
 
+void Mesh::generate_lods(uint32_t max_lods) {
+    build_mesh_lods(position_, index_, bounding_box_, bounding_sphere_, max_lods, lod_index_, lods_);
+    create_gpu_buffers();
+    mark_dirty();
+}
+
+void Mesh::generate_clusters(bool cache) {
+    generate_clusters_ = true;
+    cache_clusters_ = cache;
+    build_mesh_clusters(position_, index_, clusters_);
+    create_gpu_buffers();
+    mark_dirty();
+}
+
+void Mesh::reset_index_ranges() {
+    lod_index_.clear();
+    lods_.assign(1, MeshLod{0, static_cast<uint32_t>(index_.size())});
+
+    // Clusters index LOD 0, so they follow its triangles
+    clusters_.clear();
+    if (generate_clusters_) build_mesh_clusters(position_, index_, clusters_);
+}
+
 void Mesh::create_gpu_buffers() {
     if (!EngineContext::rhi()) {
         return;
@@ -103,7 +129,15 @@ void Mesh::create_gpu_buffers() {
 
     if (!index_.empty()) {
         index_buffer_ = std::make_shared<IndexBuffer>();
-        index_buffer_->set_index(index_);
+        if (lod_index_.empty()) {
+            index_buffer_->set_index(index_);
+        } else {
+            std::vector<uint32_t> indices;
+            indices.reserve(index_.size() + lod_index_.size());
+            indices.insert(indices.end(), index_.begin(), index_.end());
+            indices.insert(indices.end(), lod_index_.begin(), lod_index_.end());
+            index_buffer_->set_index(indices);
+        }
     }
 }
 
@@ -145,6 +179,7 @@ void Mesh::merge(const Mesh& other) {
     }
 
     calculate_bounds();
+    reset_index_ranges();
     create_gpu_buffers();
     mark_dirty();
 }
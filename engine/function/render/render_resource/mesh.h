@@ -3,6 +3,8 @@
 #include "engine/core/math/math.h"
 #include "engine/function/render/data/render_structs.h"
 #include "engine/function/render/render_resource/buffer.h"
+#include "engine/function/render/render_resource/mesh_lod.h"
+#include "engine/function/render/render_resource/mesh_cluster.h"
 #include "engine/function/asset/asset.h"
 #include "engine/function/asset/asset_macros.h"
 #include <cereal/access.hpp>
@@ -117,6 +119,29 @@ public:
     inline const std::vector<BoneInfo>& get_bones() const { return bones_; }
     void set_bones(const std::vector<BoneInfo>& bones) { bones_ = bones; }
 
+    /**
+     * @brief Build coarser detail levels from the current indices and rebuild the index buffer
+     * @param max_lods Total level count including LOD 0, at most MAX_MESH_LOD_COUNT
+     */
+    void generate_lods(uint32_t max_lods = MAX_MESH_LOD_COUNT);
+
+    /**
+     * @brief Detail levels as ranges of the index buffer; always holds at least LOD 0
+     */
+    inline const std::vector<MeshLod>& get_lods() const { return lods_; }
+    inline uint32_t get_lod_count() const { return static_cast<uint32_t>(lods_.size()); }
+
+    /**
+     * @brief Split LOD 0 into clusters (meshlets) for culling; reorders the LOD 0 indices
+     * @param cache Save the clusters with the asset; otherwise they are rebuilt on load
+     */
+    void generate_clusters(bool cache = true);
+
+    /**
+     * @brief Clusters of LOD 0 as ranges of the index buffer; empty if none were generated
+     */
+    inline const std::vector<MeshClusterInfo>& get_clusters() const { return clusters_; }
+
     template<class Archive>
     void serialize(Archive& ar) {
         ar(cereal::base_class<Asset>(this));
@@ -132,6 +157,16 @@ public:
         ar(cereal::make_nvp("bones", bones_));
         ar(cereal::make_nvp("bounding_box", bounding_box_));
         ar(cereal::make_nvp("bounding_sphere", bounding_sphere_));
+        ar(cereal::make_nvp("lod_index", lod_index_));
+        ar(cereal::make_nvp("lods", lods_));
+        ar(cereal::make_nvp("generate_clusters", generate_clusters_));
+        ar(cereal::make_nvp("cache_clusters", cache_clusters_));
+        if constexpr (Archive::is_saving::value) {
+            static const std::vector<MeshClusterInfo> NO_CLUSTERS;
+            ar(cereal::make_nvp("clusters", cache_clusters_ ? clusters_ : NO_CLUSTERS));
+        } else {
+            ar(cereal::make_nvp("clusters", clusters_));
+        }
     }
 
 private:
@@ -147,6 +182,14 @@ private:
     std::vector<uint32_t> index_;
     std::vector<BoneInfo> bones_;
 
+    // Indices of LOD 1+, placed after index_ in the index buffer
+    std::vector<uint32_t> lod_index_;
+    std::vector<MeshLod> lods_;
+
+    std::vector<MeshClusterInfo> clusters_;
+    bool generate_clusters_ = false;
+    bool cache_clusters_ = false;
+
     // Bounding volumes
     BoundingBox bounding_box_;
     BoundingSphere bounding_sphere_;
@@ -157,6 +200,7 @@ private:
 
     void create_gpu_buffers();
     void calculate_bounds();
+    void reset_index_ranges();     // Back to LOD 0 only; clusters are rebuilt if enabled
 
     friend class cereal::access;
 };
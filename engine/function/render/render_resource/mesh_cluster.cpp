@@ -0,0 +1,226 @@
+#include "engine/function/render/render_resource/mesh_cluster.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+namespace {
+
+// How much facing the cluster normal is worth against one new vertex when growing a cluster
+constexpr float CLUSTER_CONE_WEIGHT = 0.75f;
+// Unused triangles after the spatial cursor offered when a cluster has no adjacent triangle left
+constexpr uint32_t CLUSTER_FALLBACK_WINDOW = 16;
+// Cones wider than this (min dot of a normal with the axis) are not worth testing
+constexpr float CLUSTER_MIN_CONE_DOT = 0.1f;
+
+uint32_t spread_bits(uint32_t v) {
+    v = (v | (v << 16)) & 0x030000FF;
+    v = (v | (v << 8)) & 0x0300F00F;
+    v = (v | (v << 4)) & 0x030C30C3;
+    v = (v | (v << 2)) & 0x09249249;
+    return v;
+}
+
+// Triangle order along a Morton curve of the centroids, used for seeds and disconnected pieces
+std::vector<uint32_t> spatial_order(const std::vector<Vec3>& centroids) {
+    Vec3 lo = centroids[0], hi = centroids[0];
+    for (const Vec3& c : centroids) {
+        lo = lo.cwiseMin(c);
+        hi = hi.cwiseMax(c);
+    }
+    Vec3 extent = hi - lo;
+    float scale = 1023.0f / (std::max)({extent.x, extent.y, extent.z, 1e-12f});
+
+    std::vector<uint32_t> codes(centroids.size());
+    for (size_t t = 0; t < centroids.size(); ++t) {
+        Vec3 p = (centroids[t] - lo) * scale;
+        codes[t] = spread_bits(static_cast<uint32_t>(p.x)) | (spread_bits(static_cast<uint32_t>(p.y)) << 1) |
+                   (spread_bits(static_cast<uint32_t>(p.z)) << 2);
+    }
+    std::vector<uint32_t> order(centroids.size());
+    std::iota(order.begin(), order.end(), 0u);
+    std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return codes[a] < codes[b]; });
+    return order;
+}
+
+void compute_bounds(const std::vector<Vec3>& positions, const uint32_t* indices, const std::vector<Vec3>& normals,
+                    const uint32_t* triangles, MeshClusterInfo& cluster) {
+    uint32_t index_count = cluster.triangle_count * 3;
+    Vec3 lo = positions[indices[0]], hi = lo;
+    for (uint32_t i = 0; i < index_count; ++i) {
+        lo = lo.cwiseMin(positions[indices[i]]);
+        hi = hi.cwiseMax(positions[indices[i]]);
+    }
+    Vec3 center = (lo + hi) * 0.5f;
+    float radius_sq = 0.0f;
+    for (uint32_t i = 0; i < index_count; ++i) {
+        radius_sq = (std::max)(radius_sq, (positions[indices[i]] - center).squared_length());
+    }
+    cluster.sphere = BoundingSphere{center, std::sqrt(radius_sq)};
+
+    // Cone around the average normal; degenerate triangles are never visible and are ignored
+    Vec3 axis = Vec3::Zero();
+    for (uint32_t t = 0; t < cluster.triangle_count; ++t) axis += normals[triangles[t]];
+    axis = axis.normalized();
+    cluster.cone_axis = axis;
+    cluster.cone_apex = center;
+    cluster.cone_cutoff = 1.0f;
+    if (axis.squared_length() == 0.0f) return;
+
+    float min_dot = 1.0f;
+    for (uint32_t t = 0; t < cluster.triangle_count; ++t) {
+        const Vec3& n = normals[triangles[t]];
+        if (n.squared_length() > 0.0f) min_dot = (std::min)(min_dot, n.dot(axis));
+    }
+    if (min_dot < CLUSTER_MIN_CONE_DOT) return;
+
+    // Move the apex back along the axis until it is behind every triangle plane, so the view
+    // direction to the apex bounds the view direction to any point of the cluster
+    float max_t = 0.0f;
+    for (uint32_t t = 0; t < cluster.triangle_count; ++t) {
+        const Vec3& n = normals[triangles[t]];
+        if (n.squared_length() == 0.0f) continue;
+        float distance = (center - positions[indices[t * 3]]).dot(n);
+        max_t = (std::max)(max_t, distance / n.dot(axis));
+    }
+    cluster.cone_apex = center - axis * max_t;
+    cluster.cone_cutoff = std::sqrt(1.0f - min_dot * min_dot);
+}
+
+} // namespace
+
+void build_mesh_clusters(const std::vector<Vec3>& positions, std::vector<uint32_t>& indices,
+                         std::vector<MeshClusterInfo>& clusters) {
+    clusters.clear();
+    uint32_t triangle_count = static_cast<uint32_t>(indices.size() / 3);
+    uint32_t vertex_count = static_cast<uint32_t>(positions.size());
+    if (triangle_count == 0) return;
+    for (uint32_t index : indices) {
+        if (index >= vertex_count) return;
+    }
+
+    std::vector<Vec3> normals(triangle_count);
+    std::vector<Vec3> centroids(triangle_count);
+    for (uint32_t t = 0; t < triangle_count; ++t) {
+        const Vec3& a = positions[indices[t * 3]];
+        const Vec3& b = positions[indices[t * 3 + 1]];
+        const Vec3& c = positions[indices[t * 3 + 2]];
+        normals[t] = (b - a).cross(c - a).normalized();
+        centroids[t] = (a + b + c) / 3.0f;
+    }
+
+    // Triangles of each vertex
+    std::vector<uint32_t> adjacency_offsets(vertex_count + 1, 0);
+    for (uint32_t index : indices) adjacency_offsets[index + 1]++;
+    for (uint32_t v = 0; v < vertex_count; ++v) adjacency_offsets[v + 1] += adjacency_offsets[v];
+    std::vector<uint32_t> adjacency(indices.size());
+    {
+        std::vector<uint32_t> fill(adjacency_offsets.begin(), adjacency_offsets.end() - 1);
+        for (uint32_t i = 0; i < indices.size(); ++i) adjacency[fill[indices[i]]++] = i / 3;
+    }
+
+    std::vector<uint32_t> order = spatial_order(centroids);
+    uint32_t cursor = 0;
+
+    std::vector<uint8_t> used(triangle_count, 0);
+    std::vector<uint32_t> vertex_stamp(vertex_count, UINT32_MAX);      // Cluster the vertex was added to
+    std::vector<uint32_t> candidate_stamp(triangle_count, UINT32_MAX);
+    std::vector<uint32_t> candidates;
+    std::vector<uint32_t> cluster_triangles;
+    std::vector<uint32_t> sorted_triangles;
+    sorted_triangles.reserve(triangle_count);
+
+    for (uint32_t cluster_id = 0; sorted_triangles.size() < triangle_count; ++cluster_id) {
+        cluster_triangles.clear();
+        uint32_t cluster_vertices = 0;
+        Vec3 normal_sum = Vec3::Zero();
+
+        auto add_triangle = [&](uint32_t t) {
+            used[t] = 1;
+            cluster_triangles.push_back(t);
+            normal_sum += normals[t];
+            for (uint32_t k = 0; k < 3; ++k) {
+                uint32_t v = indices[t * 3 + k];
+                if (vertex_stamp[v] == cluster_id) continue;
+                vertex_stamp[v] = cluster_id;
+                cluster_vertices++;
+                for (uint32_t a = adjacency_offsets[v]; a < adjacency_offsets[v + 1]; ++a) {
+                    uint32_t neighbor = adjacency[a];
+                    if (used[neighbor] || candidate_stamp[neighbor] == cluster_id) continue;
+                    candidate_stamp[neighbor] = cluster_id;
+                    candidates.push_back(neighbor);
+                }
+            }
+        };
+
+        // Continue next to the previous cluster if it left adjacent triangles, else follow the spatial order
+        uint32_t seed = UINT32_MAX;
+        for (uint32_t t : candidates) {
+            if (!used[t]) { seed = t; break; }
+        }
+        candidates.clear();
+        if (seed == UINT32_MAX) {
+            while (used[order[cursor]]) cursor++;
+            seed = order[cursor];
+        }
+        add_triangle(seed);
+
+        while (cluster_triangles.size() < CLUSTER_TRIANGLE_SIZE) {
+            Vec3 axis = normal_sum.normalized();
+            uint32_t best = UINT32_MAX;
+            float best_score = std::numeric_limits<float>::max();
+
+            auto consider = [&](uint32_t t) {
+                uint32_t new_vertices = 0;
+                for (uint32_t k = 0; k < 3; ++k) new_vertices += vertex_stamp[indices[t * 3 + k]] != cluster_id;
+                if (cluster_vertices + new_vertices > CLUSTER_VERTEX_SIZE) return;
+                float score = static_cast<float>(new_vertices) - CLUSTER_CONE_WEIGHT * normals[t].dot(axis);
+                if (score < best_score) {
+                    best_score = score;
+                    best = t;
+                }
+            };
+
+            size_t live = 0;
+            for (uint32_t t : candidates) {
+                if (used[t]) continue;
+                candidates[live++] = t;
+                consider(t);
+            }
+            candidates.resize(live);
+
+            // Nothing adjacent fits: take a spatially close triangle from a disconnected piece
+            if (best == UINT32_MAX) {
+                while (cursor < triangle_count && used[order[cursor]]) cursor++;
+                for (uint32_t i = cursor, n = 0; i < triangle_count && n < CLUSTER_FALLBACK_WINDOW; ++i) {
+                    if (used[order[i]]) continue;
+                    consider(order[i]);
+                    n++;
+                }
+            }
+            if (best == UINT32_MAX) break;
+            add_triangle(best);
+        }
+
+        MeshClusterInfo cluster;
+        cluster.index_offset = static_cast<uint32_t>(sorted_triangles.size() * 3);
+        cluster.triangle_count = static_cast<uint32_t>(cluster_triangles.size());
+        cluster.vertex_count = cluster_vertices;
+        clusters.push_back(cluster);
+        sorted_triangles.insert(sorted_triangles.end(), cluster_triangles.begin(), cluster_triangles.end());
+    }
+
+    std::vector<uint32_t> sorted_indices(indices.size());
+    for (uint32_t t = 0; t < triangle_count; ++t) {
+        for (uint32_t k = 0; k < 3; ++k) sorted_indices[t * 3 + k] = indices[sorted_triangles[t] * 3 + k];
+    }
+    // Trailing indices of an incomplete triangle are kept at the end
+    std::copy(indices.begin() + triangle_count * 3, indices.end(), sorted_indices.begin() + triangle_count * 3);
+    indices.swap(sorted_indices);
+
+    for (MeshClusterInfo& cluster : clusters) {
+        compute_bounds(positions, indices.data() + cluster.index_offset, normals,
+                       sorted_triangles.data() + cluster.index_offset / 3, cluster);
+    }
+}
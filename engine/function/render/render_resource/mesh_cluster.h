@@ -0,0 +1,31 @@
+#pragma once
+
+#include "engine/function/render/data/render_structs.h"
+#include "engine/core/math/math.h"
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Split a triangle list into clusters (meshlets) of at most CLUSTER_VERTEX_SIZE vertices
+ *        and CLUSTER_TRIANGLE_SIZE triangles
+ *
+ * Clusters are grown greedily over shared vertices: each step adds the adjacent triangle that
+ * brings in the fewest new vertices, preferring triangles that face the same way as the cluster
+ * so its normal cone stays narrow. indices is reordered in place so each cluster is one
+ * contiguous range of it; the triangles themselves and their winding are unchanged.
+ *
+ * Front faces are clockwise as seen from the camera (D3D default), so cross(b - a, c - a) points
+ * towards the viewer and the cone marks the eyes that see only back faces.
+ */
+void build_mesh_clusters(const std::vector<Vec3>& positions, std::vector<uint32_t>& indices,
+                         std::vector<MeshClusterInfo>& clusters);
+
+/**
+ * @brief True if every triangle of the cluster is a back face seen from eye (same space as the cluster)
+ */
+inline bool is_cluster_backfacing(const MeshClusterInfo& cluster, const Vec3& eye) {
+    if (cluster.cone_cutoff >= 1.0f) return false;
+    Vec3 to_apex = cluster.cone_apex - eye;
+    float distance = to_apex.length();
+    return to_apex.dot(cluster.cone_axis) >= cluster.cone_cutoff * distance;
+}
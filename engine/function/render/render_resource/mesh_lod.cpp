@@ -0,0 +1,107 @@
+#include "engine/function/render/render_resource/mesh_lod.h"
+
+#include <algorithm>
+#include <cmath>
+#include <unordered_map>
+
+namespace {
+
+// Grid cells per axis of the first coarse level; each further level halves it
+constexpr uint32_t LOD_FIRST_GRID = 64;
+// A level is kept only if it has at most this fraction of the triangles of the previous one
+constexpr float LOD_MIN_REDUCTION = 0.6f;
+
+struct ClusterCell {
+    Vec3 sum = Vec3::Zero();
+    uint32_t count = 0;
+    uint32_t representative = 0;
+    float best_distance = std::numeric_limits<float>::max();
+};
+
+} // namespace
+
+std::vector<uint32_t> simplify_vertex_clustering(const std::vector<Vec3>& positions, const std::vector<uint32_t>& indices,
+                                                 const BoundingBox& box, float cell_size) {
+    std::vector<uint32_t> result;
+    if (cell_size <= 0.0f || positions.empty()) return indices;
+
+    Vec3 extent = box.max - box.min;
+    uint32_t grid[3];
+    for (int axis = 0; axis < 3; ++axis) {
+        grid[axis] = (std::max)(static_cast<uint32_t>(std::ceil(extent(axis) / cell_size)), 1u);
+    }
+    auto cell_of = [&](const Vec3& p) {
+        uint32_t key = 0;
+        for (int axis = 2; axis >= 0; --axis) {
+            float t = (p(axis) - box.min(axis)) / cell_size;
+            uint32_t c = (std::min)(static_cast<uint32_t>((std::max)(t, 0.0f)), grid[axis] - 1);
+            key = key * grid[axis] + c;
+        }
+        return key;
+    };
+
+    // Only vertices referenced by the triangles take part
+    std::unordered_map<uint32_t, ClusterCell> cells;
+    std::vector<uint32_t> vertex_cell(positions.size(), UINT32_MAX);
+    for (uint32_t index : indices) {
+        if (index >= positions.size() || vertex_cell[index] != UINT32_MAX) continue;
+        uint32_t key = cell_of(positions[index]);
+        vertex_cell[index] = key;
+        ClusterCell& cell = cells[key];
+        cell.sum = cell.sum + positions[index];
+        cell.count++;
+    }
+    for (uint32_t v = 0; v < positions.size(); ++v) {
+        if (vertex_cell[v] == UINT32_MAX) continue;
+        ClusterCell& cell = cells[vertex_cell[v]];
+        float distance = (positions[v] - cell.sum / static_cast<float>(cell.count)).squared_length();
+        if (distance < cell.best_distance) {
+            cell.best_distance = distance;
+            cell.representative = v;
+        }
+    }
+
+    result.reserve(indices.size() / 2);
+    for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+        if (indices[i] >= positions.size() || indices[i + 1] >= positions.size() || indices[i + 2] >= positions.size()) continue;
+        uint32_t a = cells[vertex_cell[indices[i]]].representative;
+        uint32_t b = cells[vertex_cell[indices[i + 1]]].representative;
+        uint32_t c = cells[vertex_cell[indices[i + 2]]].representative;
+        if (a == b || b == c || a == c) continue;
+        result.insert(result.end(), { a, b, c });
+    }
+    return result;
+}
+
+void build_mesh_lods(const std::vector<Vec3>& positions, const std::vector<uint32_t>& indices,
+                     const BoundingBox& box, const BoundingSphere& sphere, uint32_t max_lods,
+                     std::vector<uint32_t>& lod_indices, std::vector<MeshLod>& lods) {
+    lod_indices.clear();
+    lods.clear();
+    lods.push_back(MeshLod{0, static_cast<uint32_t>(indices.size())});
+
+    max_lods = (std::min)(max_lods, static_cast<uint32_t>(MAX_MESH_LOD_COUNT));
+    if (indices.size() / 3 < LOD_MIN_TRIANGLES || sphere.radius <= 0.0f) return;
+
+    Vec3 extent = box.max - box.min;
+    float max_extent = (std::max)({extent.x, extent.y, extent.z});
+    if (max_extent <= 0.0f) return;
+
+    uint32_t previous_count = static_cast<uint32_t>(indices.size());
+    for (uint32_t grid = LOD_FIRST_GRID; grid >= 2 && lods.size() < max_lods; grid /= 2) {
+        float cell_size = max_extent / grid;
+        std::vector<uint32_t> simplified = simplify_vertex_clustering(positions, indices, box, cell_size);
+        if (simplified.empty()) break;
+        if (simplified.size() > previous_count * LOD_MIN_REDUCTION) continue;
+
+        // Error of about one cell: it covers LOD_ERROR_PIXELS when the sphere radius covers
+        // radius / cell_size times as many, out of half the reference height
+        MeshLod lod;
+        lod.index_offset = static_cast<uint32_t>(indices.size() + lod_indices.size());
+        lod.index_count = static_cast<uint32_t>(simplified.size());
+        lod.screen_size = 2.0f * LOD_ERROR_PIXELS * sphere.radius / (cell_size * LOD_REFERENCE_HEIGHT);
+        lods.push_back(lod);
+        lod_indices.insert(lod_indices.end(), simplified.begin(), simplified.end());
+        previous_count = lod.index_count;
+    }
+}
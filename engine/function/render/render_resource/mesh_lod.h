@@ -0,0 +1,54 @@
+#pragma once
+
+#include "engine/function/render/data/render_structs.h"
+#include "engine/core/math/math.h"
+#include <cereal/cereal.hpp>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#define MAX_MESH_LOD_COUNT 4
+
+constexpr float LOD_ERROR_PIXELS = 1.0f;
+constexpr float LOD_REFERENCE_HEIGHT = 1080.0f;
+constexpr uint32_t LOD_MIN_TRIANGLES = 256;     // Meshes below this keep a single level
+
+/**
+ * @brief One detail level of a mesh: a range of the mesh index buffer over the shared vertices
+ */
+struct MeshLod {
+    uint32_t index_offset = 0;
+    uint32_t index_count = 0;
+    // Largest projected bounding-sphere size (radius over distance, scaled by the projection, so
+    // 1 is half the screen height) at which this level is used; LOD 0 has no limit
+    float screen_size = std::numeric_limits<float>::max();
+
+    template<class Archive>
+    void serialize(Archive& ar) {
+        ar(cereal::make_nvp("index_offset", index_offset));
+        ar(cereal::make_nvp("index_count", index_count));
+        ar(cereal::make_nvp("screen_size", screen_size));
+    }
+};
+
+/**
+ * @brief Simplify a triangle list by vertex clustering
+ *
+ * Vertices are snapped to a grid of cell_size over box; each occupied cell keeps the input vertex
+ * nearest to the cell average, so the result indexes the original vertex arrays. Triangles that
+ * collapse are dropped.
+ */
+std::vector<uint32_t> simplify_vertex_clustering(const std::vector<Vec3>& positions, const std::vector<uint32_t>& indices,
+                                                 const BoundingBox& box, float cell_size);
+
+/**
+ * @brief Build up to max_lods detail levels from the full-detail indices
+ *
+ * LOD 0 is the input range [0, indices.size()). Coarser levels are appended to lod_indices, whose
+ * offsets continue after the LOD 0 indices, and get a screen_size derived from their cell size:
+ * the size at which the simplification error projects to about LOD_ERROR_PIXELS at
+ * LOD_REFERENCE_HEIGHT.
+ */
+void build_mesh_lods(const std::vector<Vec3>& positions, const std::vector<uint32_t>& indices,
+                     const BoundingBox& box, const BoundingSphere& sphere, uint32_t max_lods,
+                     std::vector<uint32_t>& lod_indices, std::vector<MeshLod>& lods);
@@ -30,9 +30,9 @@ struct ModelProcessSetting {
     bool load_materials = false;          // Load materials from file
     bool tangent_space = false;           // Generate tangent space
     bool generate_bvh = false;            // Generate BVH acceleration structure
-    bool generate_cluster = false;        // Generate mesh clusters
+    bool generate_cluster = true;         // Generate mesh clusters (meshlets) for cluster culling
     bool generate_virtual_mesh = false;   // Generate virtual geometry (Nanite-like)
-    bool cache_cluster = false;           // Cache cluster data to avoid regeneration
+    bool cache_cluster = true;            // Cache cluster data to avoid regeneration
     bool force_png_texture = false;       // Force texture to use .png extension (for unsupported formats)
     ModelMaterialType material_type = ModelMaterialType::PBR;  // Material type to create
     
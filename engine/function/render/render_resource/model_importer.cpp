@@ -528,6 +528,14 @@ std::shared_ptr<Mesh> ModelImporter::process_mesh(
     if (mesh->HasBones()) {
         extract_bone_weights(mesh_asset, mesh, scene);
     }
+
+    // Meshlets of LOD 0 for frustum and normal cone culling
+    if (settings_.generate_cluster) {
+        mesh_asset->generate_clusters(settings_.cache_cluster);
+    }
+
+    // Coarser detail levels for screen-size LOD selection; small meshes keep LOD 0 only
+    mesh_asset->generate_lods();
     
     // Mesh asset will be saved automatically when Model is saved via ASSET_DEPS
     // Just mark it dirty so it will be included in the save
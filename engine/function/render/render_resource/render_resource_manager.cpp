@@ -86,6 +86,7 @@ void RenderResourceManager::destroy() {
     }
 
     material_buffer_rhi_.reset();
+    object_table_.destroy();
 
     initialized_ = false;
     INFO(LogRenderResourceManager, "RenderResourceManager destroyed");
@@ -99,8 +100,6 @@ void RenderResourceManager::init_per_frame_resources() {
         
         per_frame_resources_[i]->camera_buffer = std::make_unique<Buffer<CameraInfo>>(RESOURCE_TYPE_UNIFORM_BUFFER);
         per_frame_resources_[i]->light_buffer = std::make_unique<Buffer<LightInfo>>(RESOURCE_TYPE_UNIFORM_BUFFER);
-        // Create object buffer as raw buffer (array of ObjectInfo)
-        per_frame_resources_[i]->object_buffer_rhi = create_array_buffer<ObjectInfo>(MAX_PER_FRAME_OBJECT_SIZE);
     }
 
     INFO(LogRenderResourceManager, "Per-frame resources initialized");
@@ -114,6 +113,9 @@ void RenderResourceManager::init_global_resources() {
     // Create material buffer for bindless material access (array of MaterialInfo)
     material_buffer_rhi_ = create_array_buffer<MaterialInfo>(MAX_PER_FRAME_RESOURCE_SIZE);
 
+    // One persistent object table instead of a copy per frame in flight; only dirty pages are uploaded
+    object_table_.init(*global_rhi_backend(), MAX_PER_FRAME_OBJECT_SIZE);
+
     default_black_texture_ = std::make_shared<Texture>(TextureType::Texture2D, FORMAT_R8G8B8A8_UNORM, Extent3D{1, 1, 1});
     if (default_black_texture_) {
         uint32_t black_pixel = 0xFF000000;
@@ -165,19 +167,6 @@ void RenderResourceManager::set_camera_info(const CameraInfo& camera_info) {
     }
 }
 
-void RenderResourceManager::set_object_info(const ObjectInfo& object_info, uint32_t object_id) {
-    assert(object_id < MAX_PER_FRAME_OBJECT_SIZE && "Object ID out of range");
-    
-    uint32_t frame_index = EngineContext::current_frame_index() % FRAMES_IN_FLIGHT;
-    if (per_frame_resources_[frame_index]->object_buffer_rhi) {
-        void* mapped = per_frame_resources_[frame_index]->object_buffer_rhi->map();
-        if (mapped) {
-            memcpy((uint8_t*)mapped + object_id * sizeof(ObjectInfo), &object_info, sizeof(ObjectInfo));
-            per_frame_resources_[frame_index]->object_buffer_rhi->unmap();
-        }
-    }
-}
-
 void RenderResourceManager::set_material_info(const MaterialInfo& material_info, uint32_t material_id) {
     assert(material_id < MAX_PER_FRAME_RESOURCE_SIZE && "Material ID out of range");
     
@@ -266,7 +255,3 @@ RHIBufferRef RenderResourceManager::get_per_frame_camera_buffer() {
     return per_frame_resources_[frame_index]->camera_buffer ? per_frame_resources_[frame_index]->camera_buffer->buffer_ : nullptr;
 }
 
-RHIBufferRef RenderResourceManager::get_per_frame_object_buffer() {
-    uint32_t frame_index = EngineContext::current_frame_index() % FRAMES_IN_FLIGHT;
-    return per_frame_resources_[frame_index]->object_buffer_rhi;
-}
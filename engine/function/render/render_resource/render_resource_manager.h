@@ -6,6 +6,7 @@
 #include "engine/function/render/rhi/rhi_structs.h"
 #include "engine/function/render/data/render_structs.h"
 #include "engine/function/render/render_resource/buffer.h"
+#include "engine/function/render/render_resource/gpu_object_table.h"
 #include "engine/function/render/render_resource/texture.h"
 
 #include <array>
@@ -80,6 +81,7 @@ private:
  * This class provides:
  * - ID allocation for materials, objects, lights, etc.
  * - Global buffer management (per-frame and multi-frame resources)
+ * - The GPU object table, indexed by object ID
  * - Bindless resource allocation (simplified)
  * - Shader caching
  */
@@ -109,7 +111,6 @@ public:
 
     // Resource setters
     void set_camera_info(const CameraInfo& camera_info);
-    void set_object_info(const ObjectInfo& object_info, uint32_t object_id);
     void set_material_info(const MaterialInfo& material_info, uint32_t material_id);
     void set_directional_light_info(const DirectionalLightInfo& light_info, uint32_t cascade);
     void set_point_light_info(const PointLightInfo& light_info, uint32_t light_id);
@@ -130,7 +131,11 @@ public:
 
     // Buffer access
     RHIBufferRef get_per_frame_camera_buffer();
-    RHIBufferRef get_per_frame_object_buffer();
+
+    /**
+     * @brief Object data of every render proxy, indexed by object ID (render thread)
+     */
+    GPUObjectTable& get_object_table() { return object_table_; }
 
     // FRAMES_IN_FLIGHT is defined in configs.h
 
@@ -151,13 +156,13 @@ private:
     struct PerFrameResource {
         std::unique_ptr<Buffer<CameraInfo>> camera_buffer;
         std::unique_ptr<Buffer<LightInfo>> light_buffer;
-        RHIBufferRef object_buffer_rhi;  // Raw buffer for bindless object data (array)
     };
     std::array<std::unique_ptr<PerFrameResource>, FRAMES_IN_FLIGHT> per_frame_resources_;
 
     // Multi-frame resources (persistent)
     std::unique_ptr<Buffer<RenderGlobalSetting>> global_setting_buffer_;
     RHIBufferRef material_buffer_rhi_;  // Raw buffer for bindless material data (array)
+    GPUObjectTable object_table_;
 
     // Global textures
     TextureRef depth_texture_;
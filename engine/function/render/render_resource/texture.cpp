@@ -211,10 +211,8 @@ void Texture::load_from_image_data() {
     if (image_data_.empty()) return;
 
     bool rhi_initialized = false;
-    std::vector<RHIBufferRef> staging_buffers;
-    
-    auto immediate_command = EngineContext::rhi()->get_immediate_command();
-    
+    RHIUploadRequest request;
+
     for (uint32_t i = 0; i < (uint32_t)image_data_.size(); ++i) {
         if (image_data_[i].empty()) continue;
 
@@ -235,71 +233,18 @@ void Texture::load_from_image_data() {
             rhi_initialized = true;
         }
 
-        if (EngineContext::rhi()) {
-            uint32_t row_pitch = width * 4;
-            uint32_t aligned_row_pitch = (row_pitch + 255) & ~255;
-            uint32_t total_size = aligned_row_pitch * height;
-            
-            RHIBufferInfo staging_info = {};
-            staging_info.size = total_size;
-            staging_info.memory_usage = MEMORY_USAGE_CPU_ONLY;
-            staging_info.type = RESOURCE_TYPE_BUFFER;
-            staging_info.creation_flag = BUFFER_CREATION_PERSISTENT_MAP;
-
-            RHIBufferRef staging_buffer = EngineContext::rhi()->create_buffer(staging_info);
-            void* mapped = staging_buffer->map();
-            
-            if (aligned_row_pitch == row_pitch) {
-                memcpy(mapped, pixels, total_size);
-            } else {
-                uint8_t* dst = static_cast<uint8_t*>(mapped);
-                uint8_t* src = pixels;
-                for (int y = 0; y < height; ++y) {
-                    memcpy(dst + y * aligned_row_pitch, src + y * row_pitch, row_pitch);
-                }
-            }
-            
-            staging_buffer->unmap();
-            
-            immediate_command->texture_barrier({
-                texture_,
-                RESOURCE_STATE_UNDEFINED,
-                RESOURCE_STATE_TRANSFER_DST,
-                {TEXTURE_ASPECT_COLOR, 0, mip_levels_, i, 1}
-            });
-
-            immediate_command->copy_buffer_to_texture(
-                staging_buffer,
-                0,
-                texture_,
-                {TEXTURE_ASPECT_COLOR, 0, i, 1}
-            );
-            
-            staging_buffers.push_back(staging_buffer);
+        if (EngineContext::rhi() && texture_) {
+            // Copied into the frame's staging arena by the upload batcher, one submission for all assets
+            uint32_t size = (uint32_t)width * height * 4;
+            request.textures.push_back({ texture_, {TEXTURE_ASPECT_COLOR, 0, i, 1}, std::vector<uint8_t>(pixels, pixels + size) });
         }
 
         stbi_image_free(pixels);
     }
 
-    if (rhi_initialized && EngineContext::rhi()) {
-        immediate_command->texture_barrier({
-            texture_,
-            RESOURCE_STATE_TRANSFER_DST,
-            RESOURCE_STATE_TRANSFER_SRC,
-            {TEXTURE_ASPECT_COLOR, 0, mip_levels_, 0, array_layer_}
-        });
-
-        immediate_command->generate_mips(texture_);
-
-        immediate_command->texture_barrier({
-            texture_,
-            RESOURCE_STATE_TRANSFER_SRC,
-            RESOURCE_STATE_SHADER_RESOURCE,
-            {TEXTURE_ASPECT_COLOR, 0, mip_levels_, 0, array_layer_}
-        });
-
-        immediate_command->flush();
-        staging_buffers.clear();
+    if (rhi_initialized && EngineContext::rhi() && !request.textures.empty()) {
+        request.generate_mips.push_back(texture_);
+        EngineContext::rhi()->get_upload_batcher().enqueue(std::move(request));
     }
 }
 
@@ -334,44 +279,23 @@ void Texture::capture_image_data() {
 }
 
 void Texture::set_data(void* data, uint32_t size) {
-    if (!EngineContext::rhi()) {
+    if (!EngineContext::rhi() || !texture_ || !data) {
         return;
     }
-    RHIBufferInfo staging_info = {};
-    staging_info.size = size;
-    staging_info.memory_usage = MEMORY_USAGE_CPU_ONLY;
-    staging_info.type = RESOURCE_TYPE_BUFFER;
-    staging_info.creation_flag = BUFFER_CREATION_PERSISTENT_MAP;
-
-    RHIBufferRef staging_buffer = EngineContext::rhi()->create_buffer(staging_info);
-    void* mapped_data = staging_buffer->map();
-    memcpy(mapped_data, data, size);
-    staging_buffer->unmap();
-
-    auto immediate_command = EngineContext::rhi()->get_immediate_command();
-    
-    immediate_command->texture_barrier({
-        texture_,
-        RESOURCE_STATE_UNDEFINED,
-        RESOURCE_STATE_TRANSFER_DST,
-        {TEXTURE_ASPECT_COLOR, 0, mip_levels_, 0, array_layer_}
-    });
-
-    immediate_command->copy_buffer_to_texture(
-        staging_buffer,
-        0,
-        texture_,
-        {TEXTURE_ASPECT_COLOR, 0, 0, array_layer_}
-    );
-
-    immediate_command->texture_barrier({
-        texture_,
-        RESOURCE_STATE_TRANSFER_DST,
-        RESOURCE_STATE_SHADER_RESOURCE,
-        {TEXTURE_ASPECT_COLOR, 0, mip_levels_, 0, array_layer_}
-    });
-
-    immediate_command->flush();
+
+    // Top mip of each layer, submitted with the next batch like the loaded textures
+    uint32_t layer_size = extent_.width * extent_.height * extent_.depth * format_pixel_size(format_);
+    RHIUploadRequest request;
+    for (uint32_t layer = 0; layer < array_layer_ && layer_size > 0; ++layer) {
+        if ((uint64_t)(layer + 1) * layer_size > size) break;
+        const uint8_t* layer_data = static_cast<const uint8_t*>(data) + (uint64_t)layer * layer_size;
+        request.textures.push_back({ texture_, {TEXTURE_ASPECT_COLOR, 0, layer, 1}, std::vector<uint8_t>(layer_data, layer_data + layer_size) });
+    }
+    if (request.textures.empty()) {
+        ERR(LogRenderResource, "Texture::set_data: {} bytes do not cover one {}x{} layer", size, extent_.width, extent_.height);
+        return;
+    }
+    EngineContext::rhi()->get_upload_batcher().enqueue(std::move(request));
 }
 
 #include <cereal/archives/binary.hpp>
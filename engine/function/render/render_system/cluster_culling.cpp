@@ -0,0 +1,92 @@
+#include "engine/function/render/render_system/cluster_culling.h"
+#include "engine/function/render/render_resource/mesh_cluster.h"
+
+#include <algorithm>
+
+void ClusterCuller::begin_frame() {
+    stats_ = ClusterCullingStats{};
+    timer_.reset();
+}
+
+void ClusterCuller::end_frame() {
+    stats_.cull_ms = timer_.get_elapsed_ms();
+    last_stats_ = stats_;
+}
+
+uint32_t ClusterCuller::cull(const Mat4& view_proj, const Vec3& eye, const Mat4& model, const Mat4& inv_model,
+                             const std::vector<MeshClusterInfo>& clusters, bool backface,
+                             std::vector<ClusterDrawRange>& ranges) {
+    stats_.object_count++;
+
+    Frustum frustum = extract_frustum(model * view_proj);
+    Vec3 local_eye = (Vec4(eye, 1.0f) * inv_model).xyz();
+
+    // A mirrored transform flips the winding the rasterizer sees, so the cones no longer tell back faces
+    float determinant = model.m[0][0] * (model.m[1][1] * model.m[2][2] - model.m[1][2] * model.m[2][1]) -
+                        model.m[0][1] * (model.m[1][0] * model.m[2][2] - model.m[1][2] * model.m[2][0]) +
+                        model.m[0][2] * (model.m[1][0] * model.m[2][1] - model.m[1][1] * model.m[2][0]);
+    backface = backface && determinant > 0.0f;
+
+    runs_.clear();
+    for (const MeshClusterInfo& cluster : clusters) {
+        stats_.tested++;
+        stats_.triangles += cluster.triangle_count;
+
+        bool inside = true;
+        for (const Vec4& plane : frustum.planes) {
+            if (plane.xyz().dot(cluster.sphere.center) + plane.w < -cluster.sphere.radius) {
+                inside = false;
+                break;
+            }
+        }
+        if (!inside) {
+            stats_.frustum_culled++;
+            stats_.frustum_culled_triangles += cluster.triangle_count;
+            continue;
+        }
+        if (backface && is_cluster_backfacing(cluster, local_eye)) {
+            stats_.backface_culled++;
+            stats_.backface_culled_triangles += cluster.triangle_count;
+            continue;
+        }
+
+        uint32_t index_count = cluster.triangle_count * 3;
+        if (!runs_.empty() && runs_.back().index_offset + runs_.back().index_count == cluster.index_offset) {
+            runs_.back().index_count += index_count;
+        } else {
+            runs_.push_back(ClusterDrawRange{cluster.index_offset, index_count});
+        }
+    }
+
+    if (runs_.empty()) {
+        stats_.fully_culled_objects++;
+        return 0;
+    }
+
+    // Too many ranges: keep the largest gaps as splits and draw the rest through
+    if (runs_.size() > MAX_DRAW_RANGES) {
+        gaps_.resize(runs_.size() - 1);
+        for (uint32_t i = 0; i < gaps_.size(); ++i) gaps_[i] = i;
+        auto gap_size = [this](uint32_t i) { return runs_[i + 1].index_offset - (runs_[i].index_offset + runs_[i].index_count); };
+        std::nth_element(gaps_.begin(), gaps_.begin() + (MAX_DRAW_RANGES - 1), gaps_.end(),
+                         [&](uint32_t a, uint32_t b) { return gap_size(a) != gap_size(b) ? gap_size(a) > gap_size(b) : a < b; });
+        gaps_.resize(MAX_DRAW_RANGES - 1);
+        std::sort(gaps_.begin(), gaps_.end());
+
+        uint32_t begin = 0;
+        for (uint32_t split = 0; split <= gaps_.size(); ++split) {
+            uint32_t last = split < gaps_.size() ? gaps_[split] : static_cast<uint32_t>(runs_.size() - 1);
+            runs_[split].index_offset = runs_[begin].index_offset;
+            runs_[split].index_count = runs_[last].index_offset + runs_[last].index_count - runs_[begin].index_offset;
+            begin = last + 1;
+        }
+        runs_.resize(gaps_.size() + 1);
+    }
+
+    for (const ClusterDrawRange& run : runs_) {
+        ranges.push_back(run);
+        stats_.drawn_triangles += run.index_count / 3;
+    }
+    stats_.draw_ranges += static_cast<uint32_t>(runs_.size());
+    return static_cast<uint32_t>(runs_.size());
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "engine/function/render/render_system/frustum_culling.h"
+#include "engine/function/render/data/render_structs.h"
+#include "engine/core/math/math.h"
+#include "engine/core/utils/timer.h"
+#include <cstdint>
+#include <vector>
+
+struct ClusterCullingStats {
+    uint32_t object_count = 0;          // Objects whose clusters were tested
+    uint32_t tested = 0;                // Clusters tested
+    uint32_t frustum_culled = 0;
+    uint32_t backface_culled = 0;
+    uint32_t fully_culled_objects = 0;  // Objects left without any visible cluster
+    uint32_t draw_ranges = 0;           // Index ranges emitted after merging
+    uint64_t triangles = 0;             // Triangles of the tested clusters
+    uint64_t frustum_culled_triangles = 0;
+    uint64_t backface_culled_triangles = 0;
+    uint64_t drawn_triangles = 0;       // Triangles of the emitted ranges, merged gaps included
+    float cull_ms = 0.0f;
+};
+
+/**
+ * @brief Contiguous range of a mesh index buffer to draw
+ */
+struct ClusterDrawRange {
+    uint32_t index_offset = 0;
+    uint32_t index_count = 0;
+};
+
+/**
+ * @brief CPU culling of mesh clusters (meshlets) against the view frustum and their normal cones
+ *
+ * Works in the local space of each object: the frustum planes of model * view_proj and the eye
+ * brought through the inverse model are exact for any affine transform, so the cluster bounds
+ * never need transforming. Clusters of mirrored transforms (negative determinant) or two-sided
+ * materials skip the cone test. Surviving clusters are merged into index ranges; adjacent
+ * clusters form one range, and when more than MAX_DRAW_RANGES remain the smallest gaps are
+ * drawn as well so the draw count per object stays bounded.
+ */
+class ClusterCuller {
+public:
+    static constexpr uint32_t MAX_DRAW_RANGES = 8;      // Per object
+
+    void begin_frame();
+    void end_frame();
+
+    /**
+     * @brief Cull the clusters of one object and append the index ranges to draw
+     * @param view_proj Row-vector view * projection of the camera
+     * @param eye Camera position in world space
+     * @param backface Test the normal cones; false for two-sided materials
+     * @return Number of ranges appended; 0 if every cluster was culled
+     */
+    uint32_t cull(const Mat4& view_proj, const Vec3& eye, const Mat4& model, const Mat4& inv_model,
+                  const std::vector<MeshClusterInfo>& clusters, bool backface, std::vector<ClusterDrawRange>& ranges);
+
+    inline const ClusterCullingStats& get_last_stats() const { return last_stats_; }
+
+private:
+    std::vector<uint8_t> visible_;
+    std::vector<ClusterDrawRange> runs_;
+    std::vector<uint32_t> gaps_;
+    Timer timer_;
+    ClusterCullingStats stats_;
+    ClusterCullingStats last_stats_;
+};
@@ -0,0 +1,118 @@
+#include "engine/function/render/render_system/depth_prepass_selection.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+constexpr float QUARTER_PI = 0.785398163f;  // Disc over its bounding square
+
+uint16_t grid_cell(float ndc, uint32_t cells) {
+    float cell = std::floor((ndc * 0.5f + 0.5f) * static_cast<float>(cells));
+    return static_cast<uint16_t>(std::clamp(cell, 0.0f, static_cast<float>(cells - 1)));
+}
+
+} // namespace
+
+void DepthPrepassSelector::select(const std::vector<render::DrawBatch>& batches, const std::vector<uint8_t>& opaque,
+                                  const Mat4& view, const Mat4& projection, float near_plane,
+                                  std::vector<uint32_t>& selected) {
+    timer_.reset();
+    DepthPrepassStats stats;
+    stats.batch_count = static_cast<uint32_t>(batches.size());
+    selected.clear();
+    candidates_.clear();
+    grid_.assign(GRID_WIDTH * GRID_HEIGHT, 0);
+
+    // Screen rectangle of every batch's bounding sphere; all of them add to the depth complexity
+    for (uint32_t i = 0; i < batches.size(); ++i) {
+        const render::DrawBatch& batch = batches[i];
+        stats.total_triangles += batch.index_count / 3;
+        const BoundingSphere& sphere = batch.world_sphere;
+        Vec3 center = (Vec4(sphere.center.x, sphere.center.y, sphere.center.z, 1.0f) * view).xyz();
+        if (center.z + sphere.radius <= near_plane) continue;
+
+        Candidate candidate;
+        candidate.index = i;
+        candidate.depth = center.z;
+        float x0 = -1.0f, y0 = -1.0f, x1 = 1.0f, y1 = 1.0f;
+        if (center.z - sphere.radius > near_plane) {
+            float scale_x = projection.m[0][0] / center.z;
+            float scale_y = projection.m[1][1] / center.z;
+            x0 = (std::max)(center.x * scale_x - sphere.radius * scale_x, -1.0f);
+            x1 = (std::min)(center.x * scale_x + sphere.radius * scale_x, 1.0f);
+            y0 = (std::max)(center.y * scale_y - sphere.radius * scale_y, -1.0f);
+            y1 = (std::min)(center.y * scale_y + sphere.radius * scale_y, 1.0f);
+            if (x0 >= x1 || y0 >= y1) continue;
+            candidate.coverage = (x1 - x0) * (y1 - y0) * 0.25f * QUARTER_PI;
+        } else {
+            // The sphere crosses the near plane: it may cover the whole screen
+            candidate.coverage = 1.0f;
+        }
+        candidate.rect[0] = grid_cell(x0, GRID_WIDTH);
+        candidate.rect[1] = grid_cell(y0, GRID_HEIGHT);
+        candidate.rect[2] = grid_cell(x1, GRID_WIDTH);
+        candidate.rect[3] = grid_cell(y1, GRID_HEIGHT);
+        for (uint32_t y = candidate.rect[1]; y <= candidate.rect[3]; ++y) {
+            for (uint32_t x = candidate.rect[0]; x <= candidate.rect[2]; ++x) grid_[y * GRID_WIDTH + x]++;
+        }
+
+        bool is_opaque = i >= opaque.size() || opaque[i];
+        if (is_opaque && batch.index_count >= 3) candidates_.push_back(candidate);
+    }
+    stats.candidate_count = static_cast<uint32_t>(candidates_.size());
+
+    // Score: coverage times the other batches under it
+    order_.clear();
+    for (uint32_t c = 0; c < candidates_.size(); ++c) {
+        Candidate& candidate = candidates_[c];
+        if (candidate.coverage < min_coverage_) {
+            stats.small_count++;
+            continue;
+        }
+        uint32_t layers = 0;
+        uint32_t cells = 0;
+        for (uint32_t y = candidate.rect[1]; y <= candidate.rect[3]; ++y) {
+            for (uint32_t x = candidate.rect[0]; x <= candidate.rect[2]; ++x) {
+                layers += grid_[y * GRID_WIDTH + x] - 1;
+                cells++;
+            }
+        }
+        candidate.score = candidate.coverage * static_cast<float>(layers) / static_cast<float>(cells);
+        if (candidate.score <= 0.0f) {
+            stats.small_count++;
+            continue;
+        }
+        order_.push_back(c);
+    }
+
+    // Most hidden pixels per prepass triangle first, until the budget is spent
+    std::sort(order_.begin(), order_.end(), [this, &batches](uint32_t a, uint32_t b) {
+        float score_a = candidates_[a].score / static_cast<float>(batches[candidates_[a].index].index_count);
+        float score_b = candidates_[b].score / static_cast<float>(batches[candidates_[b].index].index_count);
+        return score_a != score_b ? score_a > score_b : a < b;
+    });
+    uint64_t triangles = 0;
+    for (uint32_t c : order_) {
+        const Candidate& candidate = candidates_[c];
+        uint32_t batch_triangles = batches[candidate.index].index_count / 3;
+        if (triangles + batch_triangles > triangle_budget_) {
+            stats.budget_count++;
+            continue;
+        }
+        triangles += batch_triangles;
+        stats.selected_coverage += candidate.coverage;
+        selected.push_back(c);
+    }
+
+    // Front to back, so the prepass itself rejects what its own occluders hide
+    std::sort(selected.begin(), selected.end(), [this](uint32_t a, uint32_t b) {
+        return candidates_[a].depth != candidates_[b].depth ? candidates_[a].depth < candidates_[b].depth : a < b;
+    });
+    for (uint32_t& index : selected) index = candidates_[index].index;
+
+    stats.selected_count = static_cast<uint32_t>(selected.size());
+    stats.selected_triangles = triangles;
+    stats.select_ms = timer_.get_total_ms();
+    last_stats_ = stats;
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "engine/function/render/render_pass/mesh_pass.h"
+#include "engine/core/math/math.h"
+#include "engine/core/utils/timer.h"
+#include <cstdint>
+#include <vector>
+
+struct DepthPrepassStats {
+    uint32_t batch_count = 0;           // Batches the main passes draw
+    uint32_t candidate_count = 0;       // Opaque batches in front of the near plane
+    uint32_t selected_count = 0;        // Batches drawn by the prepass
+    uint32_t small_count = 0;           // Candidates below the minimum coverage or without overdraw
+    uint32_t budget_count = 0;          // Candidates left out by the triangle budget
+    uint64_t selected_triangles = 0;
+    uint64_t total_triangles = 0;       // Of all batches, what the prepass drew before
+    float selected_coverage = 0.0f;     // Sum of the selected batches' screen coverage
+    float select_ms = 0.0f;
+};
+
+/**
+ * @brief Picks the draws worth rendering in the depth prepass
+ *
+ * A prepass draw pays for its vertices twice and only pays off through the pixels it hides from
+ * the main passes. Each opaque batch is scored by the screen coverage of its bounding sphere times
+ * the depth complexity under it, the average number of other batches whose screen rectangles
+ * overlap the same cells of a coarse grid. A large wall in front of a crowded room scores high;
+ * a small prop, or a large object with nothing behind it, scores nothing.
+ *
+ * Candidates above the minimum coverage are taken in order of score per triangle until the
+ * triangle budget is spent; the selection is returned front to back. Batches that are not selected
+ * are still depth tested and written by the main passes, so the result is the same image with
+ * less early-Z rejection for the objects left out.
+ */
+class DepthPrepassSelector {
+public:
+    static constexpr uint32_t DEFAULT_TRIANGLE_BUDGET = 500000;
+    static constexpr float DEFAULT_MIN_COVERAGE = 0.002f;    // Fraction of the screen
+    static constexpr uint32_t GRID_WIDTH = 32;
+    static constexpr uint32_t GRID_HEIGHT = 18;
+
+    void set_triangle_budget(uint32_t triangles) { triangle_budget_ = triangles; }
+    uint32_t get_triangle_budget() const { return triangle_budget_; }
+
+    void set_min_coverage(float coverage) { min_coverage_ = coverage; }
+    float get_min_coverage() const { return min_coverage_; }
+
+    /**
+     * @param opaque Per batch, 0 for batches the prepass must skip (transparent materials)
+     * @param selected Indices of the batches to prepass, front to back
+     */
+    void select(const std::vector<render::DrawBatch>& batches, const std::vector<uint8_t>& opaque, const Mat4& view,
+                const Mat4& projection, float near_plane, std::vector<uint32_t>& selected);
+
+    inline const DepthPrepassStats& get_last_stats() const { return last_stats_; }
+
+private:
+    struct Candidate {
+        uint32_t index = 0;
+        float depth = 0.0f;         // View depth of the sphere center
+        float coverage = 0.0f;
+        float score = 0.0f;
+        uint16_t rect[4] = {};      // Covered grid cells: x0, y0, x1, y1 inclusive
+    };
+
+    uint32_t triangle_budget_ = DEFAULT_TRIANGLE_BUDGET;
+    float min_coverage_ = DEFAULT_MIN_COVERAGE;
+
+    std::vector<Candidate> candidates_;
+    std::vector<uint32_t> grid_;        // Batches overlapping each cell
+    std::vector<uint32_t> order_;
+    Timer timer_;
+    DepthPrepassStats last_stats_;
+};
@@ -0,0 +1,190 @@
+#include "engine/function/render/render_system/draw_sort.h"
+#include "engine/function/render/render_resource/material.h"
+#include "engine/core/utils/profiler.h"
+#include "engine/core/utils/timer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+constexpr uint64_t field(uint32_t value, uint32_t bits, uint32_t shift) {
+    return (static_cast<uint64_t>(value) & ((uint64_t(1) << bits) - 1)) << shift;
+}
+
+uint32_t fold_pointer(const void* pointer, uint32_t bits) {
+    // Fibonacci hashing of the address, the top bits are the best mixed
+    uint64_t value = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(pointer));
+    return static_cast<uint32_t>((value * 0x9E3779B97F4A7C15ull) >> (64 - bits));
+}
+
+template<typename GetBatch>
+DrawStateChanges count_state_changes(size_t count, GetBatch&& get_batch) {
+    DrawStateChanges changes;
+    const Material* last_material = nullptr;
+    uint32_t last_pipeline = 0;
+    const RHIBuffer* last_vertex = nullptr;
+    const RHIBuffer* last_index = nullptr;
+    for (size_t i = 0; i < count; ++i) {
+        const render::DrawBatch& batch = get_batch(i);
+        const Material* material = batch.material.get();
+        uint32_t pipeline = draw_pipeline_id(material);
+        if (i == 0 || pipeline != last_pipeline) changes.pipeline++;
+        if (i == 0 || material != last_material) changes.material++;
+        if (i == 0 || batch.vertex_buffer.get() != last_vertex || batch.index_buffer.get() != last_index) changes.mesh++;
+        last_pipeline = pipeline;
+        last_material = material;
+        last_vertex = batch.vertex_buffer.get();
+        last_index = batch.index_buffer.get();
+    }
+    return changes;
+}
+
+void add_changes(DrawStateChanges& total, const DrawStateChanges& changes) {
+    total.pipeline += changes.pipeline;
+    total.material += changes.material;
+    total.mesh += changes.mesh;
+}
+
+} // namespace
+
+uint64_t DrawSortKey::opaque(DrawSortPass pass, uint32_t pipeline, uint32_t material, uint32_t mesh, uint32_t depth) {
+    return field(static_cast<uint32_t>(pass), PASS_BITS, 60) |
+           field(pipeline, PIPELINE_BITS, 48) |
+           field(material, MATERIAL_BITS, 32) |
+           field(mesh, MESH_BITS, 16) |
+           field(depth, DEPTH_BITS, 0);
+}
+
+uint64_t DrawSortKey::transparent(DrawSortPass pass, uint32_t depth, uint32_t pipeline, uint32_t material, uint32_t mesh) {
+    // Farthest first: invert the depth so it still sorts ascending
+    uint32_t inverted = ((1u << TRANSPARENT_DEPTH_BITS) - 1) - (std::min)(depth, (1u << TRANSPARENT_DEPTH_BITS) - 1);
+    return field(static_cast<uint32_t>(pass), PASS_BITS, 60) |
+           field(inverted, TRANSPARENT_DEPTH_BITS, 36) |
+           field(pipeline, PIPELINE_BITS, 24) |
+           field(material, MATERIAL_BITS, 8) |
+           field(mesh, TRANSPARENT_MESH_BITS, 0);
+}
+
+uint32_t DrawSortKey::quantize_depth(float view_depth, float near_plane, float far_plane, uint32_t bits) {
+    uint32_t max_value = (bits >= 32) ? 0xFFFFFFFFu : ((1u << bits) - 1);
+    if (!(view_depth > near_plane)) return 0;   // Also catches NaN
+    if (view_depth >= far_plane) return max_value;
+
+    // Logarithmic, so precision follows perspective depth
+    float t = std::log(view_depth / near_plane) / std::log(far_plane / near_plane);
+    return static_cast<uint32_t>(t * static_cast<float>(max_value));
+}
+
+uint32_t draw_pipeline_id(const Material* material) {
+    if (!material) return 0;
+    uint32_t id = static_cast<uint32_t>(material->get_material_type()) & 0x3;
+    id = (id << 2) | (material->cull_mode() & 0x3);
+    id = (id << 2) | (material->fill_mode() & 0x3);
+    id = (id << 1) | (material->depth_test() ? 1u : 0u);
+    id = (id << 1) | (material->depth_write() ? 1u : 0u);
+    id = (id << 3) | (material->depth_compare() & 0x7);
+    return id + 1;  // 0 is "no material"
+}
+
+uint32_t draw_mesh_id(const render::DrawBatch& batch) {
+    return fold_pointer(batch.vertex_buffer.get(), 16) ^ (fold_pointer(batch.index_buffer.get(), 16) >> 1);
+}
+
+uint64_t make_draw_sort_key(DrawSortPass pass, const render::DrawBatch& batch, const DrawSortView& view) {
+    const Material* material = batch.material.get();
+    uint32_t pipeline = draw_pipeline_id(material);
+    uint32_t material_id = material ? material->get_material_id() : 0;
+    uint32_t mesh = draw_mesh_id(batch);
+    float view_depth = (batch.world_sphere.center - view.position).dot(view.front);
+
+    if (material && (material->render_pass_mask() & PASS_MASK_TRANSPARENT_PASS)) {
+        // Sort by the far side of the bounds so large overlapping objects stay roughly ordered
+        uint32_t depth = DrawSortKey::quantize_depth(view_depth + batch.world_sphere.radius, view.near_plane,
+                                                     view.far_plane, DrawSortKey::TRANSPARENT_DEPTH_BITS);
+        return DrawSortKey::transparent(DrawSortPass::Transparent, depth, pipeline, material_id, mesh);
+    }
+
+    // Nearest point of the bounds, so an object the camera is inside sorts first
+    uint32_t depth = DrawSortKey::quantize_depth(view_depth - batch.world_sphere.radius, view.near_plane,
+                                                 view.far_plane, DrawSortKey::DEPTH_BITS);
+    return DrawSortKey::opaque(pass, pipeline, material_id, mesh, depth);
+}
+
+DrawSortEntry* radix_sort_draw_keys(DrawSortEntry* entries, DrawSortEntry* scratch, size_t count) {
+    if (count < 2) return entries;
+
+    constexpr uint32_t DIGITS = 8;
+    uint32_t histograms[DIGITS][256];
+    std::memset(histograms, 0, sizeof(histograms));
+    for (size_t i = 0; i < count; ++i) {
+        uint64_t key = entries[i].key;
+        for (uint32_t d = 0; d < DIGITS; ++d) {
+            histograms[d][(key >> (d * 8)) & 0xFF]++;
+        }
+    }
+
+    DrawSortEntry* src = entries;
+    DrawSortEntry* dst = scratch;
+    for (uint32_t d = 0; d < DIGITS; ++d) {
+        uint32_t* histogram = histograms[d];
+        // All keys share this byte, the pass would not move anything
+        if (histogram[(src[0].key >> (d * 8)) & 0xFF] == count) continue;
+
+        uint32_t offset = 0;
+        for (uint32_t b = 0; b < 256; ++b) {
+            uint32_t bucket = histogram[b];
+            histogram[b] = offset;
+            offset += bucket;
+        }
+        for (size_t i = 0; i < count; ++i) {
+            dst[histogram[(src[i].key >> (d * 8)) & 0xFF]++] = src[i];
+        }
+        std::swap(src, dst);
+    }
+    return src;
+}
+
+DrawStateChanges count_draw_state_changes(const std::vector<render::DrawBatch>& batches) {
+    return count_state_changes(batches.size(), [&](size_t i) -> const render::DrawBatch& { return batches[i]; });
+}
+
+void DrawSorter::begin_frame() {
+    last_frame_stats_ = stats_;
+    stats_ = DrawSortStats{};
+}
+
+void DrawSorter::sort(DrawSortPass pass, const std::vector<render::DrawBatch>& source, const std::vector<uint32_t>& indices,
+                      const DrawSortView& view, std::vector<render::DrawBatch>& out) {
+    PROFILE_SCOPE("DrawSorter_Sort");
+    Timer timer;
+
+    size_t count = indices.size();
+    if (entries_.size() < count) {
+        entries_.resize(count);
+        scratch_.resize(count);
+    }
+    for (size_t i = 0; i < count; ++i) {
+        entries_[i] = DrawSortEntry{make_draw_sort_key(pass, source[indices[i]], view), indices[i]};
+    }
+
+    DrawSortEntry* sorted = radix_sort_draw_keys(entries_.data(), scratch_.data(), count);
+
+    size_t first = out.size();
+    out.reserve(first + count);
+    for (size_t i = 0; i < count; ++i) {
+        out.push_back(source[sorted[i].index]);
+    }
+    stats_.sort_ms += timer.get_total_ms();
+
+    // Stats are not part of the sort cost
+    stats_.draw_count += static_cast<uint32_t>(count);
+    stats_.list_count++;
+    add_changes(stats_.unsorted, count_state_changes(count, [&](size_t i) -> const render::DrawBatch& {
+        return source[indices[i]];
+    }));
+    add_changes(stats_.sorted, count_state_changes(count, [&](size_t i) -> const render::DrawBatch& {
+        return out[first + i];
+    }));
+}
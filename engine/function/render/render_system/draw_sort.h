@@ -0,0 +1,130 @@
+#pragma once
+
+#include "engine/function/render/render_pass/mesh_pass.h"
+#include "engine/core/math/math.h"
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Pass field of a draw sort key, lowest sorts first
+ */
+enum class DrawSortPass : uint32_t {
+    DepthPrePass = 0,
+    GBuffer,
+    Forward,
+    NPRForward,
+    Transparent,
+};
+
+/**
+ * @brief Packed 64-bit draw sort keys, compared as plain integers
+ *
+ * Opaque:      pass:4 | pipeline:12 | material:16 | mesh:16 | depth:16   (depth front to back)
+ * Transparent: pass:4 | depth:24 | pipeline:12 | material:16 | mesh:8     (depth back to front)
+ *
+ * Opaque draws are grouped by state first and ordered front to back inside a group for early-Z;
+ * transparent draws must blend in order, so depth dominates.
+ */
+struct DrawSortKey {
+    static constexpr uint32_t PASS_BITS = 4;
+    static constexpr uint32_t PIPELINE_BITS = 12;
+    static constexpr uint32_t MATERIAL_BITS = 16;
+    static constexpr uint32_t MESH_BITS = 16;
+    static constexpr uint32_t DEPTH_BITS = 16;
+    static constexpr uint32_t TRANSPARENT_DEPTH_BITS = 24;
+    static constexpr uint32_t TRANSPARENT_MESH_BITS = 8;
+
+    static uint64_t opaque(DrawSortPass pass, uint32_t pipeline, uint32_t material, uint32_t mesh, uint32_t depth);
+    static uint64_t transparent(DrawSortPass pass, uint32_t depth, uint32_t pipeline, uint32_t material, uint32_t mesh);
+
+    /**
+     * @brief Quantize a view depth logarithmically over [near_plane, far_plane] into bits, clamped
+     */
+    static uint32_t quantize_depth(float view_depth, float near_plane, float far_plane, uint32_t bits);
+};
+
+/**
+ * @brief Camera data needed to build sort keys
+ */
+struct DrawSortView {
+    Vec3 position = Vec3::Zero();
+    Vec3 front = Vec3::UnitZ();
+    float near_plane = 0.1f;
+    float far_plane = 1000.0f;
+};
+
+/**
+ * @brief Id of the pipeline state a material needs (material type, raster and depth state)
+ */
+uint32_t draw_pipeline_id(const Material* material);
+
+/**
+ * @brief Id of the geometry a batch binds, derived from its vertex and index buffers
+ */
+uint32_t draw_mesh_id(const render::DrawBatch& batch);
+
+/**
+ * @brief Build the sort key of a batch. Materials with PASS_MASK_TRANSPARENT_PASS get a back to front key.
+ */
+uint64_t make_draw_sort_key(DrawSortPass pass, const render::DrawBatch& batch, const DrawSortView& view);
+
+struct DrawSortEntry {
+    uint64_t key;
+    uint32_t index;
+};
+
+/**
+ * @brief Stable LSD radix sort on 8-bit digits, O(n)
+ *
+ * Digits where every key has the same byte are skipped. scratch must hold count entries.
+ * @return entries or scratch, whichever holds the sorted result
+ */
+DrawSortEntry* radix_sort_draw_keys(DrawSortEntry* entries, DrawSortEntry* scratch, size_t count);
+
+/**
+ * @brief Binding changes when drawing batches in the given order
+ */
+struct DrawStateChanges {
+    uint32_t pipeline = 0;
+    uint32_t material = 0;
+    uint32_t mesh = 0;
+};
+
+DrawStateChanges count_draw_state_changes(const std::vector<render::DrawBatch>& batches);
+
+struct DrawSortStats {
+    uint32_t draw_count = 0;
+    uint32_t list_count = 0;
+    DrawStateChanges unsorted;          // In submission order
+    DrawStateChanges sorted;
+    float sort_ms = 0.0f;               // Key building, sorting and reordering
+};
+
+/**
+ * @brief Sorts the draw lists of a frame by DrawSortKey
+ *
+ * Key and scratch arrays belong to the sorter and are reused every frame, so steady-state
+ * sorting does not allocate. Stats accumulate over all lists sorted since begin_frame().
+ */
+class DrawSorter {
+public:
+    /**
+     * @brief Finish the previous frame's stats and start accumulating new ones
+     */
+    void begin_frame();
+
+    /**
+     * @brief Append source[indices[i]] to out in key order
+     */
+    void sort(DrawSortPass pass, const std::vector<render::DrawBatch>& source, const std::vector<uint32_t>& indices,
+              const DrawSortView& view, std::vector<render::DrawBatch>& out);
+
+    const DrawSortStats& get_stats() const { return stats_; }
+    const DrawSortStats& get_last_frame_stats() const { return last_frame_stats_; }
+
+private:
+    std::vector<DrawSortEntry> entries_;
+    std::vector<DrawSortEntry> scratch_;
+    DrawSortStats stats_;
+    DrawSortStats last_frame_stats_;
+};
@@ -0,0 +1,393 @@
+#include "engine/function/render/render_system/dynamic_aabb_tree.h"
+
+#include <algorithm>
+
+DynamicAABBTree::DynamicAABBTree() {
+    nodes_.reserve(64);
+}
+
+BoundingBox DynamicAABBTree::combine(const BoundingBox& a, const BoundingBox& b) {
+    BoundingBox result;
+    result.min = a.min.cwiseMin(b.min);
+    result.max = a.max.cwiseMax(b.max);
+    return result;
+}
+
+bool DynamicAABBTree::contains(const BoundingBox& outer, const BoundingBox& inner) {
+    return outer.min.x <= inner.min.x && outer.min.y <= inner.min.y && outer.min.z <= inner.min.z &&
+           inner.max.x <= outer.max.x && inner.max.y <= outer.max.y && inner.max.z <= outer.max.z;
+}
+
+bool DynamicAABBTree::overlaps(const BoundingBox& a, const BoundingBox& b) {
+    return a.min.x <= b.max.x && b.min.x <= a.max.x &&
+           a.min.y <= b.max.y && b.min.y <= a.max.y &&
+           a.min.z <= b.max.z && b.min.z <= a.max.z;
+}
+
+float DynamicAABBTree::surface_area(const BoundingBox& box) {
+    Vec3 d = box.max - box.min;
+    return 2.0f * (d.x * d.y + d.y * d.z + d.z * d.x);
+}
+
+int32_t DynamicAABBTree::allocate_node() {
+    if (free_list_ == NULL_NODE) {
+        nodes_.emplace_back();
+        nodes_.back().height = 0;
+        return static_cast<int32_t>(nodes_.size() - 1);
+    }
+    int32_t node = free_list_;
+    free_list_ = nodes_[node].parent;
+    nodes_[node] = Node{};
+    nodes_[node].height = 0;
+    return node;
+}
+
+void DynamicAABBTree::free_node(int32_t node) {
+    nodes_[node].parent = free_list_;
+    nodes_[node].child1 = NULL_NODE;
+    nodes_[node].child2 = NULL_NODE;
+    nodes_[node].height = -1;
+    nodes_[node].user_data = nullptr;
+    free_list_ = node;
+}
+
+int32_t DynamicAABBTree::create_proxy(const BoundingBox& box, void* user_data) {
+    int32_t proxy = allocate_node();
+    Vec3 margin(AABB_MARGIN, AABB_MARGIN, AABB_MARGIN);
+    nodes_[proxy].box.min = box.min - margin;
+    nodes_[proxy].box.max = box.max + margin;
+    nodes_[proxy].user_data = user_data;
+    insert_leaf(proxy);
+    proxy_count_++;
+    return proxy;
+}
+
+void DynamicAABBTree::destroy_proxy(int32_t proxy) {
+    if (proxy < 0 || proxy >= static_cast<int32_t>(nodes_.size()) || !nodes_[proxy].is_leaf() || nodes_[proxy].height != 0) return;
+    remove_leaf(proxy);
+    free_node(proxy);
+    proxy_count_--;
+}
+
+bool DynamicAABBTree::move_proxy(int32_t proxy, const BoundingBox& box) {
+    if (contains(nodes_[proxy].box, box)) {
+        // Still inside the fattened box, but refit if it shrank well below the margin
+        Vec3 big_margin(4.0f * AABB_MARGIN, 4.0f * AABB_MARGIN, 4.0f * AABB_MARGIN);
+        if (contains(BoundingBox{box.min - big_margin, box.max + big_margin}, nodes_[proxy].box)) {
+            return false;
+        }
+    }
+
+    remove_leaf(proxy);
+    Vec3 margin(AABB_MARGIN, AABB_MARGIN, AABB_MARGIN);
+    nodes_[proxy].box.min = box.min - margin;
+    nodes_[proxy].box.max = box.max + margin;
+    insert_leaf(proxy);
+    return true;
+}
+
+bool DynamicAABBTree::rebalance(float max_growth) {
+    if (proxy_count_ < 3) return false;
+
+    float ratio = get_area_ratio();
+    if (rebuilt_area_ratio_ > 0.0f && ratio <= rebuilt_area_ratio_ * max_growth) return false;
+
+    float before = ratio;
+    rebuild();
+    // The incrementally built tree can be better than a median split, keep the best reference
+    rebuilt_area_ratio_ = (std::min)(before, rebuilt_area_ratio_);
+    return true;
+}
+
+void DynamicAABBTree::rebuild() {
+    if (root_ == NULL_NODE) return;
+
+    std::vector<int32_t> leaves;
+    leaves.reserve(proxy_count_);
+    for (int32_t i = 0; i < static_cast<int32_t>(nodes_.size()); ++i) {
+        if (nodes_[i].height == 0) {
+            leaves.push_back(i);
+        } else if (nodes_[i].height > 0) {
+            free_node(i);
+        }
+    }
+
+    root_ = build_top_down(leaves.data(), static_cast<uint32_t>(leaves.size()), NULL_NODE);
+    rebuilt_area_ratio_ = get_area_ratio();
+}
+
+int32_t DynamicAABBTree::build_top_down(int32_t* leaves, uint32_t count, int32_t parent) {
+    if (count == 1) {
+        nodes_[leaves[0]].parent = parent;
+        return leaves[0];
+    }
+
+    auto centroid = [this](int32_t leaf) { return (nodes_[leaf].box.min + nodes_[leaf].box.max) * 0.5f; };
+    Vec3 lo = centroid(leaves[0]);
+    Vec3 hi = lo;
+    for (uint32_t i = 1; i < count; ++i) {
+        Vec3 c = centroid(leaves[i]);
+        lo = lo.cwiseMin(c);
+        hi = hi.cwiseMax(c);
+    }
+    Vec3 extent = hi - lo;
+    int axis = extent.x >= extent.y && extent.x >= extent.z ? 0 : (extent.y >= extent.z ? 1 : 2);
+
+    uint32_t half = count / 2;
+    std::nth_element(leaves, leaves + half, leaves + count, [&](int32_t a, int32_t b) {
+        return centroid(a)(axis) < centroid(b)(axis);
+    });
+
+    int32_t node = allocate_node();
+    int32_t child1 = build_top_down(leaves, half, node);
+    int32_t child2 = build_top_down(leaves + half, count - half, node);
+
+    Node& n = nodes_[node];
+    n.parent = parent;
+    n.child1 = child1;
+    n.child2 = child2;
+    n.box = combine(nodes_[child1].box, nodes_[child2].box);
+    n.height = 1 + (std::max)(nodes_[child1].height, nodes_[child2].height);
+    return node;
+}
+
+void DynamicAABBTree::clear() {
+    nodes_.clear();
+    root_ = NULL_NODE;
+    free_list_ = NULL_NODE;
+    proxy_count_ = 0;
+    rebuilt_area_ratio_ = 0.0f;
+}
+
+void DynamicAABBTree::insert_leaf(int32_t leaf) {
+    if (root_ == NULL_NODE) {
+        root_ = leaf;
+        nodes_[root_].parent = NULL_NODE;
+        return;
+    }
+
+    // Find the best sibling by the surface area heuristic
+    BoundingBox leaf_box = nodes_[leaf].box;
+    int32_t index = root_;
+    while (!nodes_[index].is_leaf()) {
+        const Node& node = nodes_[index];
+        float area = surface_area(node.box);
+        float combined_area = surface_area(combine(node.box, leaf_box));
+
+        // Cost of making a new parent for this node and the leaf
+        float cost = 2.0f * combined_area;
+        // Minimum cost of pushing the leaf further down the tree
+        float inheritance_cost = 2.0f * (combined_area - area);
+
+        auto descend_cost = [&](int32_t child) {
+            const Node& c = nodes_[child];
+            float new_area = surface_area(combine(leaf_box, c.box));
+            return c.is_leaf() ? new_area + inheritance_cost : (new_area - surface_area(c.box)) + inheritance_cost;
+        };
+        float cost1 = descend_cost(node.child1);
+        float cost2 = descend_cost(node.child2);
+
+        if (cost < cost1 && cost < cost2) break;
+        index = cost1 < cost2 ? node.child1 : node.child2;
+    }
+    int32_t sibling = index;
+
+    int32_t old_parent = nodes_[sibling].parent;
+    int32_t new_parent = allocate_node();
+    nodes_[new_parent].parent = old_parent;
+    nodes_[new_parent].box = combine(leaf_box, nodes_[sibling].box);
+    nodes_[new_parent].height = nodes_[sibling].height + 1;
+    nodes_[new_parent].child1 = sibling;
+    nodes_[new_parent].child2 = leaf;
+    nodes_[sibling].parent = new_parent;
+    nodes_[leaf].parent = new_parent;
+
+    if (old_parent != NULL_NODE) {
+        if (nodes_[old_parent].child1 == sibling) {
+            nodes_[old_parent].child1 = new_parent;
+        } else {
+            nodes_[old_parent].child2 = new_parent;
+        }
+    } else {
+        root_ = new_parent;
+    }
+
+    refit_ancestors(nodes_[leaf].parent);
+}
+
+void DynamicAABBTree::remove_leaf(int32_t leaf) {
+    if (leaf == root_) {
+        root_ = NULL_NODE;
+        return;
+    }
+
+    int32_t parent = nodes_[leaf].parent;
+    int32_t grand_parent = nodes_[parent].parent;
+    int32_t sibling = nodes_[parent].child1 == leaf ? nodes_[parent].child2 : nodes_[parent].child1;
+
+    if (grand_parent != NULL_NODE) {
+        // Replace the parent with the sibling
+        if (nodes_[grand_parent].child1 == parent) {
+            nodes_[grand_parent].child1 = sibling;
+        } else {
+            nodes_[grand_parent].child2 = sibling;
+        }
+        nodes_[sibling].parent = grand_parent;
+        free_node(parent);
+        refit_ancestors(grand_parent);
+    } else {
+        root_ = sibling;
+        nodes_[sibling].parent = NULL_NODE;
+        free_node(parent);
+    }
+    nodes_[leaf].parent = NULL_NODE;
+}
+
+void DynamicAABBTree::refit_ancestors(int32_t index) {
+    while (index != NULL_NODE) {
+        index = balance(index);
+
+        Node& node = nodes_[index];
+        const Node& child1 = nodes_[node.child1];
+        const Node& child2 = nodes_[node.child2];
+        node.height = 1 + (std::max)(child1.height, child2.height);
+        node.box = combine(child1.box, child2.box);
+
+        index = node.parent;
+    }
+}
+
+int32_t DynamicAABBTree::balance(int32_t ia) {
+    Node& a = nodes_[ia];
+    if (a.is_leaf() || a.height < 2) return ia;
+
+    int32_t ib = a.child1;
+    int32_t ic = a.child2;
+    Node& b = nodes_[ib];
+    Node& c = nodes_[ic];
+    int32_t balance_factor = c.height - b.height;
+
+    // Rotate c up
+    if (balance_factor > 1) {
+        int32_t i_f = c.child1;
+        int32_t i_g = c.child2;
+        Node& f = nodes_[i_f];
+        Node& g = nodes_[i_g];
+
+        c.child1 = ia;
+        c.parent = a.parent;
+        a.parent = ic;
+        if (c.parent != NULL_NODE) {
+            if (nodes_[c.parent].child1 == ia) {
+                nodes_[c.parent].child1 = ic;
+            } else {
+                nodes_[c.parent].child2 = ic;
+            }
+        } else {
+            root_ = ic;
+        }
+
+        if (f.height > g.height) {
+            c.child2 = i_f;
+            a.child2 = i_g;
+            g.parent = ia;
+            a.box = combine(b.box, g.box);
+            c.box = combine(a.box, f.box);
+            a.height = 1 + (std::max)(b.height, g.height);
+            c.height = 1 + (std::max)(a.height, f.height);
+        } else {
+            c.child2 = i_g;
+            a.child2 = i_f;
+            f.parent = ia;
+            a.box = combine(b.box, f.box);
+            c.box = combine(a.box, g.box);
+            a.height = 1 + (std::max)(b.height, f.height);
+            c.height = 1 + (std::max)(a.height, g.height);
+        }
+        return ic;
+    }
+
+    // Rotate b up
+    if (balance_factor < -1) {
+        int32_t i_d = b.child1;
+        int32_t i_e = b.child2;
+        Node& d = nodes_[i_d];
+        Node& e = nodes_[i_e];
+
+        b.child1 = ia;
+        b.parent = a.parent;
+        a.parent = ib;
+        if (b.parent != NULL_NODE) {
+            if (nodes_[b.parent].child1 == ia) {
+                nodes_[b.parent].child1 = ib;
+            } else {
+                nodes_[b.parent].child2 = ib;
+            }
+        } else {
+            root_ = ib;
+        }
+
+        if (d.height > e.height) {
+            b.child2 = i_d;
+            a.child1 = i_e;
+            e.parent = ia;
+            a.box = combine(c.box, e.box);
+            b.box = combine(a.box, d.box);
+            a.height = 1 + (std::max)(c.height, e.height);
+            b.height = 1 + (std::max)(a.height, d.height);
+        } else {
+            b.child2 = i_e;
+            a.child1 = i_d;
+            d.parent = ia;
+            a.box = combine(c.box, d.box);
+            b.box = combine(a.box, e.box);
+            a.height = 1 + (std::max)(c.height, d.height);
+            b.height = 1 + (std::max)(a.height, e.height);
+        }
+        return ib;
+    }
+
+    return ia;
+}
+
+float DynamicAABBTree::get_area_ratio() const {
+    if (root_ == NULL_NODE) return 0.0f;
+    float root_area = surface_area(nodes_[root_].box);
+    if (root_area <= 0.0f) return 0.0f;
+
+    float total_area = 0.0f;
+    for (const auto& node : nodes_) {
+        if (node.height > 0) total_area += surface_area(node.box);
+    }
+    return total_area / root_area;
+}
+
+bool DynamicAABBTree::validate() const {
+    if (root_ == NULL_NODE) return proxy_count_ == 0;
+    if (nodes_[root_].parent != NULL_NODE) return false;
+
+    uint32_t leaf_count = 0;
+    std::vector<int32_t> stack = {root_};
+    while (!stack.empty()) {
+        int32_t index = stack.back();
+        stack.pop_back();
+        const Node& node = nodes_[index];
+        if (node.height < 0) return false;
+
+        if (node.is_leaf()) {
+            if (node.height != 0 || node.child2 != NULL_NODE) return false;
+            leaf_count++;
+            continue;
+        }
+
+        const Node& child1 = nodes_[node.child1];
+        const Node& child2 = nodes_[node.child2];
+        if (child1.parent != index || child2.parent != index) return false;
+        if (node.height != 1 + (std::max)(child1.height, child2.height)) return false;
+        if (!contains(node.box, child1.box) || !contains(node.box, child2.box)) return false;
+
+        stack.push_back(node.child1);
+        stack.push_back(node.child2);
+    }
+    return leaf_count == proxy_count_;
+}
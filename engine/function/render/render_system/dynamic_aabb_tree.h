@@ -0,0 +1,268 @@
+#pragma once
+
+#include "engine/function/render/data/render_structs.h"
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Incrementally updated bounding volume hierarchy over fattened AABBs
+ *
+ * Leaves store a user pointer and an AABB enlarged by AABB_MARGIN, so small movements
+ * are absorbed by move_proxy() without touching the tree. Insertion picks the sibling with
+ * the surface area heuristic and keeps the tree height balanced with AVL style rotations;
+ * insert, remove and refit are O(log n). Incremental updates slowly degrade the tree, so
+ * rebalance() rebuilds it top-down once its surface area cost has grown past a threshold.
+ *
+ * Queries take a callable invoked once per overlapping proxy id; returning false stops
+ * the query (for query_ray, the callable returns the new max distance instead).
+ */
+class DynamicAABBTree {
+public:
+    static constexpr int32_t NULL_NODE = -1;
+    static constexpr float AABB_MARGIN = 0.1f;
+
+    DynamicAABBTree();
+
+    /**
+     * @brief Insert a leaf for box
+     * @return Proxy id, stable until destroy_proxy
+     */
+    int32_t create_proxy(const BoundingBox& box, void* user_data);
+
+    void destroy_proxy(int32_t proxy);
+
+    /**
+     * @brief Refit the proxy to a new box
+     * @return true if the box left the fattened box and the leaf was reinserted
+     */
+    bool move_proxy(int32_t proxy, const BoundingBox& box);
+
+    /**
+     * @brief Rebuild the tree if its area ratio grew by more than max_growth since the last rebuild. O(n) check.
+     * @return true if the tree was rebuilt
+     */
+    bool rebalance(float max_growth = 1.25f);
+
+    /**
+     * @brief Rebuild all internal nodes top-down (median split on the longest axis), O(n log n). Proxy ids are kept.
+     */
+    void rebuild();
+
+    void clear();
+
+    inline void* get_user_data(int32_t proxy) const { return nodes_[proxy].user_data; }
+    inline const BoundingBox& get_fat_box(int32_t proxy) const { return nodes_[proxy].box; }
+    inline uint32_t get_proxy_count() const { return proxy_count_; }
+    inline int32_t get_height() const { return root_ == NULL_NODE ? 0 : nodes_[root_].height; }
+
+    /**
+     * @brief Sum of internal node surface areas over the root surface area, lower is better
+     */
+    float get_area_ratio() const;
+
+    /**
+     * @brief Check parent links, heights and bounds, for tests
+     */
+    bool validate() const;
+
+    template<typename F>
+    void query_box(const BoundingBox& box, F&& callback) const;
+
+    template<typename F>
+    void query_sphere(const BoundingSphere& sphere, F&& callback) const;
+
+    /**
+     * @brief Report proxies intersecting the frustum. Subtrees fully inside are reported without further plane tests.
+     */
+    template<typename F>
+    void query_frustum(const Frustum& frustum, F&& callback) const;
+
+    /**
+     * @brief Report proxies whose fat box is hit by the ray within max_distance
+     * @param callback float(int32_t proxy, float max_distance): return the new max distance
+     *        (e.g. the exact hit distance to find the closest hit), or 0 to stop
+     */
+    template<typename F>
+    void query_ray(const Vec3& origin, const Vec3& direction, float max_distance, F&& callback) const;
+
+private:
+    struct Node {
+        BoundingBox box;
+        void* user_data = nullptr;
+        int32_t parent = NULL_NODE;     // Next free node while on the free list
+        int32_t child1 = NULL_NODE;
+        int32_t child2 = NULL_NODE;
+        int32_t height = -1;            // 0 for leaves, -1 for free nodes
+
+        inline bool is_leaf() const { return child1 == NULL_NODE; }
+    };
+
+    int32_t allocate_node();
+    void free_node(int32_t node);
+    void insert_leaf(int32_t leaf);
+    void remove_leaf(int32_t leaf);
+    int32_t balance(int32_t node);
+    void refit_ancestors(int32_t node);
+    int32_t build_top_down(int32_t* leaves, uint32_t count, int32_t parent);
+
+    static BoundingBox combine(const BoundingBox& a, const BoundingBox& b);
+    static bool contains(const BoundingBox& outer, const BoundingBox& inner);
+    static bool overlaps(const BoundingBox& a, const BoundingBox& b);
+    static float surface_area(const BoundingBox& box);
+
+    std::vector<Node> nodes_;
+    int32_t root_ = NULL_NODE;
+    int32_t free_list_ = NULL_NODE;
+    uint32_t proxy_count_ = 0;
+    float rebuilt_area_ratio_ = 0.0f;   // Area ratio right after the last rebuild, 0 if never rebuilt
+
+    // Traversal stack, inline storage covers any balanced tree of practical size
+    class NodeStack {
+    public:
+        inline void push(int32_t value) {
+            if (count_ < INLINE_CAPACITY) {
+                inline_[count_++] = value;
+            } else {
+                overflow_.push_back(value);
+                count_++;
+            }
+        }
+        inline int32_t pop() {
+            --count_;
+            if (count_ < INLINE_CAPACITY) return inline_[count_];
+            int32_t value = overflow_.back();
+            overflow_.pop_back();
+            return value;
+        }
+        inline bool empty() const { return count_ == 0; }
+
+    private:
+        static constexpr uint32_t INLINE_CAPACITY = 256;
+        int32_t inline_[INLINE_CAPACITY];
+        std::vector<int32_t> overflow_;
+        uint32_t count_ = 0;
+    };
+};
+
+template<typename F>
+void DynamicAABBTree::query_box(const BoundingBox& box, F&& callback) const {
+    if (root_ == NULL_NODE) return;
+    NodeStack stack;
+    stack.push(root_);
+    while (!stack.empty()) {
+        int32_t index = stack.pop();
+        const Node& node = nodes_[index];
+        if (!overlaps(node.box, box)) continue;
+        if (node.is_leaf()) {
+            if (!callback(index)) return;
+        } else {
+            stack.push(node.child1);
+            stack.push(node.child2);
+        }
+    }
+}
+
+template<typename F>
+void DynamicAABBTree::query_sphere(const BoundingSphere& sphere, F&& callback) const {
+    if (root_ == NULL_NODE) return;
+    float radius_sq = sphere.radius * sphere.radius;
+    NodeStack stack;
+    stack.push(root_);
+    while (!stack.empty()) {
+        int32_t index = stack.pop();
+        const Node& node = nodes_[index];
+
+        Vec3 closest = sphere.center.cwiseMax(node.box.min).cwiseMin(node.box.max);
+        if ((closest - sphere.center).squared_length() > radius_sq) continue;
+
+        if (node.is_leaf()) {
+            if (!callback(index)) return;
+        } else {
+            stack.push(node.child1);
+            stack.push(node.child2);
+        }
+    }
+}
+
+template<typename F>
+void DynamicAABBTree::query_frustum(const Frustum& frustum, F&& callback) const {
+    if (root_ == NULL_NODE) return;
+
+    // Stack entries carry a bit for "fully inside", so subtrees skip the plane tests
+    constexpr int32_t INSIDE_BIT = int32_t(1) << 30;
+    NodeStack stack;
+    stack.push(root_);
+    while (!stack.empty()) {
+        int32_t entry = stack.pop();
+        int32_t index = entry & ~INSIDE_BIT;
+        bool inside = (entry & INSIDE_BIT) != 0;
+        const Node& node = nodes_[index];
+
+        if (!inside) {
+            bool outside = false;
+            inside = true;
+            for (const Vec4& plane : frustum.planes) {
+                // Distance of the corner furthest along (p) and against (n) the plane normal
+                float p = plane.x * (plane.x >= 0.0f ? node.box.max.x : node.box.min.x) +
+                          plane.y * (plane.y >= 0.0f ? node.box.max.y : node.box.min.y) +
+                          plane.z * (plane.z >= 0.0f ? node.box.max.z : node.box.min.z) + plane.w;
+                if (p < 0.0f) {
+                    outside = true;
+                    break;
+                }
+                float n = plane.x * (plane.x >= 0.0f ? node.box.min.x : node.box.max.x) +
+                          plane.y * (plane.y >= 0.0f ? node.box.min.y : node.box.max.y) +
+                          plane.z * (plane.z >= 0.0f ? node.box.min.z : node.box.max.z) + plane.w;
+                if (n < 0.0f) inside = false;
+            }
+            if (outside) continue;
+        }
+
+        if (node.is_leaf()) {
+            if (!callback(index)) return;
+        } else {
+            int32_t flag = inside ? INSIDE_BIT : 0;
+            stack.push(node.child1 | flag);
+            stack.push(node.child2 | flag);
+        }
+    }
+}
+
+template<typename F>
+void DynamicAABBTree::query_ray(const Vec3& origin, const Vec3& direction, float max_distance, F&& callback) const {
+    if (root_ == NULL_NODE) return;
+
+    Vec3 inv_dir(1.0f / direction.x, 1.0f / direction.y, 1.0f / direction.z);
+    auto slab = [&](const BoundingBox& box, float max_t) {
+        float t_min = 0.0f;
+        float t_max = max_t;
+        for (int axis = 0; axis < 3; ++axis) {
+            float t1 = (box.min(axis) - origin(axis)) * inv_dir(axis);
+            float t2 = (box.max(axis) - origin(axis)) * inv_dir(axis);
+            if (t1 > t2) std::swap(t1, t2);
+            // NaN (origin on a slab with zero direction) compares false and keeps the bound
+            t_min = t1 > t_min ? t1 : t_min;
+            t_max = t2 < t_max ? t2 : t_max;
+            if (t_min > t_max) return false;
+        }
+        return true;
+    };
+
+    NodeStack stack;
+    stack.push(root_);
+    while (!stack.empty()) {
+        int32_t index = stack.pop();
+        const Node& node = nodes_[index];
+        if (!slab(node.box, max_distance)) continue;
+
+        if (node.is_leaf()) {
+            float value = callback(index, max_distance);
+            if (value <= 0.0f) return;
+            max_distance = value < max_distance ? value : max_distance;
+        } else {
+            stack.push(node.child1);
+            stack.push(node.child2);
+        }
+    }
+}
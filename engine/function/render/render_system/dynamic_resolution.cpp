@@ -0,0 +1,84 @@
+#include "engine/function/render/render_system/dynamic_resolution.h"
+
+#include <algorithm>
+#include <cmath>
+
+void DynamicResolutionController::set_settings(const DynamicResolutionSettings& settings) {
+    settings_ = settings;
+    settings_.min_scale = std::clamp(settings_.min_scale, 0.1f, 1.0f);
+    settings_.max_scale = std::clamp(settings_.max_scale, settings_.min_scale, 1.0f);
+    continuous_scale_ = std::clamp(continuous_scale_, settings_.min_scale, settings_.max_scale);
+    stats_.scale = std::clamp(stats_.scale, settings_.min_scale, settings_.max_scale);
+}
+
+void DynamicResolutionController::set_enabled(bool enable) {
+    if (enable == enabled_) return;
+    enabled_ = enable;
+    reset();
+}
+
+float DynamicResolutionController::update(float frame_ms) {
+    if (!enabled_) {
+        stats_.scale = settings_.max_scale;
+        return stats_.scale;
+    }
+    // No timing yet, e.g. GPU timestamps still in flight
+    if (!(frame_ms > 0.0f) || !(settings_.target_ms > 0.0f)) return stats_.scale;
+
+    stats_.frame_ms = frame_ms;
+    stats_.filtered_ms = stats_.frames == 0 ? frame_ms
+                                            : stats_.filtered_ms + (frame_ms - stats_.filtered_ms) * settings_.smoothing;
+    stats_.frames++;
+
+    float error = (settings_.target_ms - stats_.filtered_ms) / settings_.target_ms;
+    if (std::abs(error) < settings_.deadband) error = 0.0f;
+    stats_.error = error;
+
+    float area = continuous_scale_ * continuous_scale_;
+    area += settings_.kp * (error - errors_[0]) + settings_.ki * error +
+            settings_.kd * (error - 2.0f * errors_[0] + errors_[1]);
+    errors_[1] = errors_[0];
+    errors_[0] = error;
+
+    float min_area = settings_.min_scale * settings_.min_scale;
+    float max_area = settings_.max_scale * settings_.max_scale;
+    area = std::clamp(area, min_area, max_area);
+    float scale = std::sqrt(area);
+    scale = std::clamp(scale, continuous_scale_ - settings_.max_step, continuous_scale_ + settings_.max_step);
+    continuous_scale_ = std::clamp(scale, settings_.min_scale, settings_.max_scale);
+    stats_.area = continuous_scale_ * continuous_scale_;
+
+    // Hysteresis: the applied scale follows once the continuous one is a full quantum away, or at a bound
+    bool at_bound = continuous_scale_ == settings_.min_scale || continuous_scale_ == settings_.max_scale;
+    float applied = quantize(continuous_scale_);
+    if (applied != stats_.scale &&
+        (at_bound || std::abs(continuous_scale_ - stats_.scale) >= settings_.quantum)) {
+        stats_.scale = applied;
+        stats_.changes++;
+    }
+    return stats_.scale;
+}
+
+Extent2D DynamicResolutionController::get_render_extent(Extent2D full_extent) const {
+    float scale = enabled_ ? stats_.scale : settings_.max_scale;
+    Extent2D extent;
+    extent.width = (std::max)(1u, static_cast<uint32_t>(std::lround(full_extent.width * scale)));
+    extent.height = (std::max)(1u, static_cast<uint32_t>(std::lround(full_extent.height * scale)));
+    extent.width = (std::min)(extent.width, full_extent.width);
+    extent.height = (std::min)(extent.height, full_extent.height);
+    return extent;
+}
+
+void DynamicResolutionController::reset() {
+    continuous_scale_ = settings_.max_scale;
+    errors_[0] = errors_[1] = 0.0f;
+    stats_ = DynamicResolutionStats{};
+    stats_.scale = settings_.max_scale;
+    stats_.area = continuous_scale_ * continuous_scale_;
+}
+
+float DynamicResolutionController::quantize(float scale) const {
+    if (settings_.quantum <= 0.0f) return scale;
+    float quantized = std::round(scale / settings_.quantum) * settings_.quantum;
+    return std::clamp(quantized, settings_.min_scale, settings_.max_scale);
+}
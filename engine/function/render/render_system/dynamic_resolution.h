@@ -0,0 +1,82 @@
+#pragma once
+
+#include "engine/core/math/math.h"
+#include "engine/core/math/extent.h"
+#include <cstdint>
+
+struct DynamicResolutionSettings {
+    float target_ms = 16.0f;        // Frame time to hold, a little under the refresh interval
+    float min_scale = 0.5f;         // Per axis
+    float max_scale = 1.0f;
+    float kp = 0.2f;                // Gains on the relative frame time error, in units of pixel area
+    float ki = 0.1f;
+    float kd = 0.05f;
+    float deadband = 0.05f;         // Relative error treated as on target
+    float max_step = 0.05f;         // Largest scale change per frame
+    float quantum = 0.025f;         // Scales are multiples of this, so small corrections do not resize
+    float smoothing = 0.2f;         // Weight of a new sample in the filtered frame time
+};
+
+struct DynamicResolutionStats {
+    float frame_ms = 0.0f;          // Last measured frame time
+    float filtered_ms = 0.0f;
+    float error = 0.0f;             // (target - filtered) / target, positive with headroom
+    float area = 1.0f;              // Continuous controller output, scale squared
+    float scale = 1.0f;             // Applied scale, quantized
+    uint32_t changes = 0;           // Applied scale changes since the last reset
+    uint32_t frames = 0;
+};
+
+/**
+ * @brief Render scale controller that holds a frame time target
+ *
+ * Frame time is assumed to grow with the number of shaded pixels, so the controller works on the
+ * pixel area a = scale^2. Each frame the measured time is filtered and its relative error to the
+ * target e (zero inside the deadband) drives an incremental PID step,
+ *     a += kp * (e - e1) + ki * e + kd * (e - 2 * e1 + e2),
+ * with e1 and e2 the errors of the two previous frames. The incremental form keeps no integral
+ * sum, so clamping the output to [min_scale, max_scale] cannot wind up. The scale also moves at
+ * most max_step per frame; the filter and the small integral gain tolerate timings that arrive a
+ * few frames late, as GPU timestamps do. The applied scale is the continuous one rounded to
+ * quantum and only moves once the continuous scale is a full quantum away from it, so noise
+ * around a boundary does not flip the render size.
+ */
+class DynamicResolutionController {
+public:
+    void set_settings(const DynamicResolutionSettings& settings);
+    inline const DynamicResolutionSettings& get_settings() const { return settings_; }
+
+    /**
+     * @brief Disabled, the scale is max_scale
+     */
+    void set_enabled(bool enable);
+    inline bool is_enabled() const { return enabled_; }
+
+    /**
+     * @brief Feed one frame time and return the scale for the next frame
+     */
+    float update(float frame_ms);
+
+    inline float get_scale() const { return stats_.scale; }
+
+    /**
+     * @brief Render size within full_extent at the current scale, at least one pixel
+     */
+    Extent2D get_render_extent(Extent2D full_extent) const;
+
+    inline const DynamicResolutionStats& get_stats() const { return stats_; }
+
+    /**
+     * @brief Back to max_scale with the controller state cleared
+     */
+    void reset();
+
+private:
+    float quantize(float scale) const;
+
+    DynamicResolutionSettings settings_;
+    bool enabled_ = false;
+    float continuous_scale_ = 1.0f;
+    float errors_[2] = {};          // Errors of the previous two frames
+    DynamicResolutionStats stats_;
+};
@@ -0,0 +1,346 @@
+#include "engine/function/render/render_system/frustum_culling.h"
+#include "engine/core/os/thread_pool.h"
+#include "engine/core/utils/profiler.h"
+#include "engine/core/utils/timer.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <future>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define FRUSTUM_CULL_SIMD_WIDTH 8
+#elif defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define FRUSTUM_CULL_SIMD_WIDTH 4
+#else
+#define FRUSTUM_CULL_SIMD_WIDTH 1
+#endif
+
+Frustum extract_frustum(const Mat4& view_proj) {
+    // Row vectors: clip = p * VP, so clip.x = dot(p, col0) ... clip.w = dot(p, col3)
+    Vec4 c0 = view_proj.col(0);
+    Vec4 c1 = view_proj.col(1);
+    Vec4 c2 = view_proj.col(2);
+    Vec4 c3 = view_proj.col(3);
+
+    Frustum frustum;
+    frustum.planes[0] = c3 + c0;   // left:   -w <= x
+    frustum.planes[1] = c3 - c0;   // right:   x <= w
+    frustum.planes[2] = c3 + c1;   // bottom: -w <= y
+    frustum.planes[3] = c3 - c1;   // top:     y <= w
+    frustum.planes[4] = c2;        // near:    0 <= z
+    frustum.planes[5] = c3 - c2;   // far:     z <= w
+
+    for (auto& plane : frustum.planes) {
+        float length = plane.xyz().length();
+        if (length > 0.0f) {
+            plane = plane / length;
+        }
+    }
+    return frustum;
+}
+
+BoundingBox transform_bounding_box(const BoundingBox& box, const Mat4& matrix) {
+    BoundingBox result;
+    for (int j = 0; j < 3; ++j) {
+        float lo = matrix.m[3][j];
+        float hi = matrix.m[3][j];
+        for (int i = 0; i < 3; ++i) {
+            float a = matrix.m[i][j] * box.min(i);
+            float b = matrix.m[i][j] * box.max(i);
+            lo += (std::min)(a, b);
+            hi += (std::max)(a, b);
+        }
+        result.min(j) = lo;
+        result.max(j) = hi;
+    }
+    return result;
+}
+
+BoundingSphere transform_bounding_sphere(const BoundingSphere& sphere, const Mat4& matrix) {
+    const Vec3& c = sphere.center;
+    BoundingSphere result;
+    result.center = Vec3(
+        c.x * matrix.m[0][0] + c.y * matrix.m[1][0] + c.z * matrix.m[2][0] + matrix.m[3][0],
+        c.x * matrix.m[0][1] + c.y * matrix.m[1][1] + c.z * matrix.m[2][1] + matrix.m[3][1],
+        c.x * matrix.m[0][2] + c.y * matrix.m[1][2] + c.z * matrix.m[2][2] + matrix.m[3][2]);
+
+    float max_scale_sq = 0.0f;
+    for (int i = 0; i < 3; ++i) {
+        Vec3 axis(matrix.m[i][0], matrix.m[i][1], matrix.m[i][2]);
+        max_scale_sq = (std::max)(max_scale_sq, axis.squared_length());
+    }
+    result.radius = sphere.radius * std::sqrt(max_scale_sq);
+    return result;
+}
+
+void CullingBounds::clear() {
+    for (auto* v : {&center_x, &center_y, &center_z, &radius, &min_x, &min_y, &min_z, &max_x, &max_y, &max_z}) {
+        v->clear();
+    }
+}
+
+void CullingBounds::reserve(size_t count) {
+    for (auto* v : {&center_x, &center_y, &center_z, &radius, &min_x, &min_y, &min_z, &max_x, &max_y, &max_z}) {
+        v->reserve(count);
+    }
+}
+
+void CullingBounds::add(const BoundingSphere& sphere, const BoundingBox& box) {
+    center_x.push_back(sphere.center.x);
+    center_y.push_back(sphere.center.y);
+    center_z.push_back(sphere.center.z);
+    radius.push_back(sphere.radius);
+    min_x.push_back(box.min.x);
+    min_y.push_back(box.min.y);
+    min_z.push_back(box.min.z);
+    max_x.push_back(box.max.x);
+    max_y.push_back(box.max.y);
+    max_z.push_back(box.max.z);
+}
+
+void CullingBounds::set(size_t index, const BoundingSphere& sphere, const BoundingBox& box) {
+    center_x[index] = sphere.center.x;
+    center_y[index] = sphere.center.y;
+    center_z[index] = sphere.center.z;
+    radius[index] = sphere.radius;
+    min_x[index] = box.min.x;
+    min_y[index] = box.min.y;
+    min_z[index] = box.min.z;
+    max_x[index] = box.max.x;
+    max_y[index] = box.max.y;
+    max_z[index] = box.max.z;
+}
+
+void CullingBounds::remove_swap(size_t index) {
+    for (auto* v : {&center_x, &center_y, &center_z, &radius, &min_x, &min_y, &min_z, &max_x, &max_y, &max_z}) {
+        (*v)[index] = v->back();
+        v->pop_back();
+    }
+}
+
+BoundingSphere CullingBounds::get_sphere(size_t index) const {
+    return BoundingSphere{Vec3(center_x[index], center_y[index], center_z[index]), radius[index]};
+}
+
+BoundingBox CullingBounds::get_box(size_t index) const {
+    return BoundingBox{Vec3(min_x[index], min_y[index], min_z[index]), Vec3(max_x[index], max_y[index], max_z[index])};
+}
+
+namespace {
+
+enum CullResult : uint8_t {
+    CULL_VISIBLE = 0,
+    CULL_SPHERE,
+    CULL_BOX,
+};
+
+// Per plane, the source arrays for the AABB corner furthest along the plane normal
+struct PlaneVertexSource {
+    const float* x;
+    const float* y;
+    const float* z;
+};
+
+void select_plane_vertices(const Frustum& frustum, const CullingBounds& bounds, PlaneVertexSource out[6]) {
+    for (int p = 0; p < 6; ++p) {
+        const Vec4& plane = frustum.planes[p];
+        out[p].x = plane.x >= 0.0f ? bounds.max_x.data() : bounds.min_x.data();
+        out[p].y = plane.y >= 0.0f ? bounds.max_y.data() : bounds.min_y.data();
+        out[p].z = plane.z >= 0.0f ? bounds.max_z.data() : bounds.min_z.data();
+    }
+}
+
+inline CullResult cull_one(const Frustum& frustum, const CullingBounds& bounds, const PlaneVertexSource pv[6], uint32_t i) {
+    for (int p = 0; p < 6; ++p) {
+        const Vec4& plane = frustum.planes[p];
+        float dist = plane.x * bounds.center_x[i] + plane.y * bounds.center_y[i] + plane.z * bounds.center_z[i] + plane.w;
+        if (dist < -bounds.radius[i]) return CULL_SPHERE;
+    }
+    for (int p = 0; p < 6; ++p) {
+        const Vec4& plane = frustum.planes[p];
+        float dist = plane.x * pv[p].x[i] + plane.y * pv[p].y[i] + plane.z * pv[p].z[i] + plane.w;
+        if (dist < 0.0f) return CULL_BOX;
+    }
+    return CULL_VISIBLE;
+}
+
+#if FRUSTUM_CULL_SIMD_WIDTH == 8
+struct SimdOps {
+    using Reg = __m256;
+    static constexpr uint32_t WIDTH = 8;
+    static constexpr int ALL = 0xFF;
+    static Reg load(const float* p) { return _mm256_loadu_ps(p); }
+    static Reg set1(float v) { return _mm256_set1_ps(v); }
+    static Reg zero() { return _mm256_setzero_ps(); }
+    static Reg add(Reg a, Reg b) { return _mm256_add_ps(a, b); }
+    static Reg sub(Reg a, Reg b) { return _mm256_sub_ps(a, b); }
+    static Reg mul(Reg a, Reg b) { return _mm256_mul_ps(a, b); }
+    static Reg lt(Reg a, Reg b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+    static Reg or_(Reg a, Reg b) { return _mm256_or_ps(a, b); }
+    static int mask(Reg a) { return _mm256_movemask_ps(a); }
+};
+#elif FRUSTUM_CULL_SIMD_WIDTH == 4
+struct SimdOps {
+    using Reg = __m128;
+    static constexpr uint32_t WIDTH = 4;
+    static constexpr int ALL = 0xF;
+    static Reg load(const float* p) { return _mm_loadu_ps(p); }
+    static Reg set1(float v) { return _mm_set1_ps(v); }
+    static Reg zero() { return _mm_setzero_ps(); }
+    static Reg add(Reg a, Reg b) { return _mm_add_ps(a, b); }
+    static Reg sub(Reg a, Reg b) { return _mm_sub_ps(a, b); }
+    static Reg mul(Reg a, Reg b) { return _mm_mul_ps(a, b); }
+    static Reg lt(Reg a, Reg b) { return _mm_cmplt_ps(a, b); }
+    static Reg or_(Reg a, Reg b) { return _mm_or_ps(a, b); }
+    static int mask(Reg a) { return _mm_movemask_ps(a); }
+};
+#endif
+
+template<typename Ops>
+uint32_t cull_range_simd(const Frustum& frustum, const CullingBounds& bounds, const PlaneVertexSource pv[6],
+                         uint32_t begin, uint32_t end, std::vector<uint32_t>& visible,
+                         uint32_t& sphere_culled, uint32_t& box_culled) {
+    using Reg = typename Ops::Reg;
+
+    Reg pa[6], pb[6], pc[6], pd[6];
+    for (int p = 0; p < 6; ++p) {
+        pa[p] = Ops::set1(frustum.planes[p].x);
+        pb[p] = Ops::set1(frustum.planes[p].y);
+        pc[p] = Ops::set1(frustum.planes[p].z);
+        pd[p] = Ops::set1(frustum.planes[p].w);
+    }
+
+    uint32_t i = begin;
+    for (; i + Ops::WIDTH <= end; i += Ops::WIDTH) {
+        Reg cx = Ops::load(&bounds.center_x[i]);
+        Reg cy = Ops::load(&bounds.center_y[i]);
+        Reg cz = Ops::load(&bounds.center_z[i]);
+        Reg neg_r = Ops::sub(Ops::zero(), Ops::load(&bounds.radius[i]));
+
+        Reg sphere_out = Ops::zero();
+        for (int p = 0; p < 6; ++p) {
+            Reg dist = Ops::add(Ops::add(Ops::add(Ops::mul(pa[p], cx), Ops::mul(pb[p], cy)), Ops::mul(pc[p], cz)), pd[p]);
+            sphere_out = Ops::or_(sphere_out, Ops::lt(dist, neg_r));
+        }
+        int sphere_mask = Ops::mask(sphere_out);
+
+        int box_mask = 0;
+        if (sphere_mask != Ops::ALL) {
+            Reg box_out = Ops::zero();
+            for (int p = 0; p < 6; ++p) {
+                Reg vx = Ops::load(pv[p].x + i);
+                Reg vy = Ops::load(pv[p].y + i);
+                Reg vz = Ops::load(pv[p].z + i);
+                Reg dist = Ops::add(Ops::add(Ops::add(Ops::mul(pa[p], vx), Ops::mul(pb[p], vy)), Ops::mul(pc[p], vz)), pd[p]);
+                box_out = Ops::or_(box_out, Ops::lt(dist, Ops::zero()));
+            }
+            box_mask = Ops::mask(box_out) & ~sphere_mask;
+        }
+
+        sphere_culled += std::popcount(static_cast<uint32_t>(sphere_mask));
+        box_culled += std::popcount(static_cast<uint32_t>(box_mask));
+
+        uint32_t visible_mask = static_cast<uint32_t>(~(sphere_mask | box_mask) & Ops::ALL);
+        while (visible_mask) {
+            visible.push_back(i + std::countr_zero(visible_mask));
+            visible_mask &= visible_mask - 1;
+        }
+    }
+    return i;
+}
+
+void cull_range(const Frustum& frustum, const CullingBounds& bounds, uint32_t begin, uint32_t end,
+                std::vector<uint32_t>& visible, uint32_t& sphere_culled, uint32_t& box_culled) {
+    PlaneVertexSource pv[6];
+    select_plane_vertices(frustum, bounds, pv);
+
+    uint32_t i = begin;
+#if FRUSTUM_CULL_SIMD_WIDTH > 1
+    i = cull_range_simd<SimdOps>(frustum, bounds, pv, begin, end, visible, sphere_culled, box_culled);
+#endif
+    // Scalar tail
+    for (; i < end; ++i) {
+        switch (cull_one(frustum, bounds, pv, i)) {
+            case CULL_VISIBLE: visible.push_back(i); break;
+            case CULL_SPHERE: sphere_culled++; break;
+            case CULL_BOX: box_culled++; break;
+        }
+    }
+}
+
+} // namespace
+
+bool FrustumCuller::is_visible(const Frustum& frustum, const BoundingSphere& sphere, const BoundingBox& box) {
+    for (const Vec4& plane : frustum.planes) {
+        float dist = plane.x * sphere.center.x + plane.y * sphere.center.y + plane.z * sphere.center.z + plane.w;
+        if (dist < -sphere.radius) return false;
+    }
+    for (const Vec4& plane : frustum.planes) {
+        float dist = plane.x * (plane.x >= 0.0f ? box.max.x : box.min.x) +
+                     plane.y * (plane.y >= 0.0f ? box.max.y : box.min.y) +
+                     plane.z * (plane.z >= 0.0f ? box.max.z : box.min.z) + plane.w;
+        if (dist < 0.0f) return false;
+    }
+    return true;
+}
+
+uint32_t FrustumCuller::simd_width() {
+    return FRUSTUM_CULL_SIMD_WIDTH;
+}
+
+void FrustumCuller::cull(const Frustum& frustum, const CullingBounds& bounds, std::vector<uint32_t>& visible, ThreadPool* pool) {
+    PROFILE_SCOPE("FrustumCuller_Cull");
+    Timer timer;
+
+    uint32_t count = static_cast<uint32_t>(bounds.size());
+    uint32_t chunk_count = (count + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    if (chunks_.size() < chunk_count) {
+        chunks_.resize(chunk_count);
+    }
+
+    auto run_chunk = [&](uint32_t c) {
+        PROFILE_SCOPE("FrustumCuller_Chunk");
+        ChunkResult& chunk = chunks_[c];
+        chunk.visible.clear();
+        chunk.sphere_culled = 0;
+        chunk.box_culled = 0;
+        uint32_t begin = c * CHUNK_SIZE;
+        uint32_t end = (std::min)(begin + CHUNK_SIZE, count);
+        cull_range(frustum, bounds, begin, end, chunk.visible, chunk.sphere_culled, chunk.box_culled);
+    };
+
+    if (pool && chunk_count > 1) {
+        // Chunk 0 runs on the calling thread while the workers take the rest
+        std::vector<std::future<void>> futures;
+        futures.reserve(chunk_count - 1);
+        for (uint32_t c = 1; c < chunk_count; ++c) {
+            futures.push_back(pool->enqueue(run_chunk, c));
+        }
+        run_chunk(0);
+        for (auto& future : futures) {
+            future.wait();
+        }
+    } else {
+        for (uint32_t c = 0; c < chunk_count; ++c) {
+            run_chunk(c);
+        }
+    }
+
+    FrustumCullingStats stats;
+    stats.tested = count;
+    stats.chunk_count = chunk_count;
+
+    visible.clear();
+    for (uint32_t c = 0; c < chunk_count; ++c) {
+        const ChunkResult& chunk = chunks_[c];
+        visible.insert(visible.end(), chunk.visible.begin(), chunk.visible.end());
+        stats.sphere_culled += chunk.sphere_culled;
+        stats.box_culled += chunk.box_culled;
+    }
+    stats.visible = static_cast<uint32_t>(visible.size());
+    stats.cull_ms = timer.get_total_ms();
+    last_stats_ = stats;
+}
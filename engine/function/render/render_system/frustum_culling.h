@@ -0,0 +1,101 @@
+#pragma once
+
+#include "engine/function/render/data/render_structs.h"
+#include <cstdint>
+#include <vector>
+
+class ThreadPool;
+
+/**
+ * @brief Extract the six frustum planes from a row-vector view * projection matrix
+ *
+ * Planes are normalized and point inwards (dot(plane.xyz, p) + plane.w >= 0 is inside).
+ * Order: left, right, bottom, top, near, far. Assumes D3D style 0..1 clip depth.
+ */
+Frustum extract_frustum(const Mat4& view_proj);
+
+/**
+ * @brief Transform a local-space AABB into a world-space AABB (Arvo's method)
+ */
+BoundingBox transform_bounding_box(const BoundingBox& box, const Mat4& matrix);
+
+/**
+ * @brief Transform a local-space sphere, scaling the radius by the largest axis scale
+ */
+BoundingSphere transform_bounding_sphere(const BoundingSphere& sphere, const Mat4& matrix);
+
+/**
+ * @brief World-space bounds of all render objects, packed as structure of arrays
+ *
+ * Each component lives in its own array so the culler can load 4/8 objects per SIMD register.
+ */
+struct CullingBounds {
+    std::vector<float> center_x, center_y, center_z, radius;
+    std::vector<float> min_x, min_y, min_z;
+    std::vector<float> max_x, max_y, max_z;
+
+    void clear();
+    void reserve(size_t count);
+    void add(const BoundingSphere& sphere, const BoundingBox& box);
+    void set(size_t index, const BoundingSphere& sphere, const BoundingBox& box);
+
+    /**
+     * @brief Remove an entry by moving the last one into its place, O(1)
+     */
+    void remove_swap(size_t index);
+
+    BoundingSphere get_sphere(size_t index) const;
+    BoundingBox get_box(size_t index) const;
+
+    inline size_t size() const { return radius.size(); }
+};
+
+struct FrustumCullingStats {
+    uint32_t tested = 0;
+    uint32_t visible = 0;
+    uint32_t sphere_culled = 0;     // Rejected by the bounding sphere test
+    uint32_t box_culled = 0;        // Survived the sphere test, rejected by the AABB test
+    uint32_t chunk_count = 0;
+    float cull_ms = 0.0f;
+};
+
+/**
+ * @brief SIMD frustum culler over CullingBounds
+ *
+ * Tests bounding spheres first and only runs the AABB (p-vertex) test for lanes that
+ * survive. Uses 8 lanes when compiled with AVX, 4 lanes with SSE, scalar otherwise.
+ * Large inputs are split into CHUNK_SIZE ranges and processed on the thread pool.
+ */
+class FrustumCuller {
+public:
+    static constexpr uint32_t CHUNK_SIZE = 4096;
+
+    /**
+     * @brief Cull all bounds against the frustum
+     * @param visible Output indices of visible objects, in ascending order
+     * @param pool Optional thread pool; nullptr runs every chunk on the calling thread
+     */
+    void cull(const Frustum& frustum, const CullingBounds& bounds, std::vector<uint32_t>& visible, ThreadPool* pool = nullptr);
+
+    const FrustumCullingStats& get_last_stats() const { return last_stats_; }
+
+    /**
+     * @brief Scalar reference test, same result as the SIMD path
+     */
+    static bool is_visible(const Frustum& frustum, const BoundingSphere& sphere, const BoundingBox& box);
+
+    /**
+     * @brief Number of objects tested per SIMD iteration in this build
+     */
+    static uint32_t simd_width();
+
+private:
+    struct ChunkResult {
+        std::vector<uint32_t> visible;
+        uint32_t sphere_culled = 0;
+        uint32_t box_culled = 0;
+    };
+
+    std::vector<ChunkResult> chunks_;
+    FrustumCullingStats last_stats_;
+};
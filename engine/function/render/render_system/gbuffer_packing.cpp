@@ -0,0 +1,43 @@
+#include "engine/function/render/render_system/gbuffer_packing.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+float sign_not_zero(float value) {
+    return value >= 0.0f ? 1.0f : -1.0f;
+}
+
+} // namespace
+
+Vec2 GBufferPacking::encode_octahedral(const Vec3& normal) {
+    // Project onto the octahedron |x| + |y| + |z| = 1, then fold the lower half over the diagonals
+    float inv_l1 = 1.0f / (std::abs(normal.x) + std::abs(normal.y) + std::abs(normal.z));
+    Vec2 p(normal.x * inv_l1, normal.y * inv_l1);
+    if (normal.z < 0.0f) {
+        p = Vec2((1.0f - std::abs(p.y)) * sign_not_zero(p.x), (1.0f - std::abs(p.x)) * sign_not_zero(p.y));
+    }
+    return p;
+}
+
+Vec3 GBufferPacking::decode_octahedral(Vec2 encoded) {
+    Vec3 n(encoded.x, encoded.y, 1.0f - std::abs(encoded.x) - std::abs(encoded.y));
+    float t = std::clamp(-n.z, 0.0f, 1.0f);
+    n.x += n.x >= 0.0f ? -t : t;
+    n.y += n.y >= 0.0f ? -t : t;
+    return n.normalized();
+}
+
+float GBufferPacking::quantize_snorm16(float value) {
+    return std::round(std::clamp(value, -1.0f, 1.0f) * 32767.0f) / 32767.0f;
+}
+
+float GBufferPacking::quantize_unorm8(float value) {
+    return std::round(std::clamp(value, 0.0f, 1.0f) * 255.0f) / 255.0f;
+}
+
+Vec3 GBufferPacking::reconstruct_position(Vec2 uv, float depth, const Mat4& inv_view_proj) {
+    Vec4 world = Vec4(uv.x * 2.0f - 1.0f, 1.0f - uv.y * 2.0f, depth, 1.0f) * inv_view_proj;
+    return Vec3(world.x, world.y, world.z) / world.w;
+}
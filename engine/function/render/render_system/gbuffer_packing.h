@@ -0,0 +1,39 @@
+#pragma once
+
+#include "engine/core/math/math.h"
+
+/**
+ * @brief Encoding of the compacted G-buffer
+ *
+ * Normals are stored as two octahedral coordinates in [-1, 1] (RG16 snorm), material parameters as
+ * four unorm bytes, and world position is not stored at all: the lighting pass rebuilds it from the
+ * depth buffer with the inverse view-projection. The helpers mirror g_buffer.hlsl and
+ * deferred_lighting.hlsl so the round trips can be checked without a GPU.
+ */
+class GBufferPacking {
+public:
+    /**
+     * @brief Octahedral coordinates of a unit normal, in [-1, 1]
+     */
+    static Vec2 encode_octahedral(const Vec3& normal);
+
+    /**
+     * @brief Unit normal from octahedral coordinates
+     */
+    static Vec3 decode_octahedral(Vec2 encoded);
+
+    /**
+     * @brief Value as read back from a 16-bit snorm channel
+     */
+    static float quantize_snorm16(float value);
+
+    /**
+     * @brief Value as read back from an 8-bit unorm channel
+     */
+    static float quantize_unorm8(float value);
+
+    /**
+     * @brief World position of a pixel from its texture coordinates ((0, 0) top left) and depth buffer value
+     */
+    static Vec3 reconstruct_position(Vec2 uv, float depth, const Mat4& inv_view_proj);
+};
@@ -0,0 +1,301 @@
+#include "engine/function/render/render_system/light_clustering.h"
+#include "engine/core/os/thread_pool.h"
+#include "engine/core/utils/profiler.h"
+#include "engine/core/utils/timer.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <future>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define LIGHT_CLUSTER_SIMD_WIDTH 8
+#elif defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define LIGHT_CLUSTER_SIMD_WIDTH 4
+#else
+#define LIGHT_CLUSTER_SIMD_WIDTH 1
+#endif
+
+namespace {
+
+// Below this many clustered lights the slices are cheaper to build on the calling thread
+constexpr uint32_t PARALLEL_MIN_LIGHTS = 256;
+
+// Distance from the sphere center to the box along one axis, 0 inside
+inline float axis_distance(float c, float lo, float hi) {
+    return (std::max)((std::max)(lo - c, c - hi), 0.0f);
+}
+
+#if LIGHT_CLUSTER_SIMD_WIDTH == 8
+struct SimdOps {
+    using Reg = __m256;
+    static constexpr uint32_t WIDTH = 8;
+    static Reg load(const float* p) { return _mm256_loadu_ps(p); }
+    static Reg set1(float v) { return _mm256_set1_ps(v); }
+    static Reg zero() { return _mm256_setzero_ps(); }
+    static Reg add(Reg a, Reg b) { return _mm256_add_ps(a, b); }
+    static Reg sub(Reg a, Reg b) { return _mm256_sub_ps(a, b); }
+    static Reg mul(Reg a, Reg b) { return _mm256_mul_ps(a, b); }
+    static Reg max(Reg a, Reg b) { return _mm256_max_ps(a, b); }
+    static Reg le(Reg a, Reg b) { return _mm256_cmp_ps(a, b, _CMP_LE_OQ); }
+    static int mask(Reg a) { return _mm256_movemask_ps(a); }
+};
+#elif LIGHT_CLUSTER_SIMD_WIDTH == 4
+struct SimdOps {
+    using Reg = __m128;
+    static constexpr uint32_t WIDTH = 4;
+    static Reg load(const float* p) { return _mm_loadu_ps(p); }
+    static Reg set1(float v) { return _mm_set1_ps(v); }
+    static Reg zero() { return _mm_setzero_ps(); }
+    static Reg add(Reg a, Reg b) { return _mm_add_ps(a, b); }
+    static Reg sub(Reg a, Reg b) { return _mm_sub_ps(a, b); }
+    static Reg mul(Reg a, Reg b) { return _mm_mul_ps(a, b); }
+    static Reg max(Reg a, Reg b) { return _mm_max_ps(a, b); }
+    static Reg le(Reg a, Reg b) { return _mm_cmple_ps(a, b); }
+    static int mask(Reg a) { return _mm_movemask_ps(a); }
+};
+#endif
+
+/**
+ * Calls emit(i) for every sphere i of [x, y, z, radius] that touches the box, in ascending order.
+ * Same arithmetic as LightClusterBuilder::sphere_intersects_box, lane by lane.
+ */
+template<typename Emit>
+void test_spheres(const float* x, const float* y, const float* z, const float* radius, uint32_t count,
+                  const BoundingBox& box, Emit&& emit) {
+    uint32_t i = 0;
+#if LIGHT_CLUSTER_SIMD_WIDTH > 1
+    using Ops = SimdOps;
+    using Reg = Ops::Reg;
+    Reg min_x = Ops::set1(box.min.x), max_x = Ops::set1(box.max.x);
+    Reg min_y = Ops::set1(box.min.y), max_y = Ops::set1(box.max.y);
+    Reg min_z = Ops::set1(box.min.z), max_z = Ops::set1(box.max.z);
+    Reg zero = Ops::zero();
+    for (; i + Ops::WIDTH <= count; i += Ops::WIDTH) {
+        Reg cx = Ops::load(x + i);
+        Reg cy = Ops::load(y + i);
+        Reg cz = Ops::load(z + i);
+        Reg r = Ops::load(radius + i);
+        Reg dx = Ops::max(Ops::max(Ops::sub(min_x, cx), Ops::sub(cx, max_x)), zero);
+        Reg dy = Ops::max(Ops::max(Ops::sub(min_y, cy), Ops::sub(cy, max_y)), zero);
+        Reg dz = Ops::max(Ops::max(Ops::sub(min_z, cz), Ops::sub(cz, max_z)), zero);
+        Reg dist_sq = Ops::add(Ops::add(Ops::mul(dx, dx), Ops::mul(dy, dy)), Ops::mul(dz, dz));
+        uint32_t hit_mask = static_cast<uint32_t>(Ops::mask(Ops::le(dist_sq, Ops::mul(r, r))));
+        while (hit_mask) {
+            emit(i + std::countr_zero(hit_mask));
+            hit_mask &= hit_mask - 1;
+        }
+    }
+#endif
+    // Scalar tail
+    for (; i < count; ++i) {
+        if (LightClusterBuilder::sphere_intersects_box(Vec3(x[i], y[i], z[i]), radius[i], box)) emit(i);
+    }
+}
+
+} // namespace
+
+void LightClusterBuilder::LightSoA::clear() {
+    x.clear();
+    y.clear();
+    z.clear();
+    radius.clear();
+    light.clear();
+}
+
+void LightClusterBuilder::LightSoA::push(float px, float py, float pz, float r, uint32_t index) {
+    x.push_back(px);
+    y.push_back(py);
+    z.push_back(pz);
+    radius.push_back(r);
+    light.push_back(index);
+}
+
+bool LightClusterBuilder::sphere_intersects_box(const Vec3& center, float radius, const BoundingBox& box) {
+    float dx = axis_distance(center.x, box.min.x, box.max.x);
+    float dy = axis_distance(center.y, box.min.y, box.max.y);
+    float dz = axis_distance(center.z, box.min.z, box.max.z);
+    return dx * dx + dy * dy + dz * dz <= radius * radius;
+}
+
+uint32_t LightClusterBuilder::simd_width() {
+    return LIGHT_CLUSTER_SIMD_WIDTH;
+}
+
+float LightClusterBuilder::slice_near(uint32_t z) const {
+    if (z == 0) return near_;
+    if (z >= GRID_Z) return far_;
+    return near_ * std::pow(far_ / near_, static_cast<float>(z) / GRID_Z);
+}
+
+BoundingBox LightClusterBuilder::get_cluster_bounds(uint32_t x, uint32_t y, uint32_t z) const {
+    // Tile edges scale with depth, so the extremes sit on the near or far plane of the slice
+    float zn = slice_near(z);
+    float zf = slice_near(z + 1);
+    BoundingBox box;
+    box.min.x = (std::min)(tile_x_[x] * zn, tile_x_[x] * zf);
+    box.max.x = (std::max)(tile_x_[x + 1] * zn, tile_x_[x + 1] * zf);
+    box.min.y = (std::min)(tile_y_[y + 1] * zn, tile_y_[y + 1] * zf);
+    box.max.y = (std::max)(tile_y_[y] * zn, tile_y_[y] * zf);
+    box.min.z = zn;
+    box.max.z = zf;
+    return box;
+}
+
+bool LightClusterBuilder::find_cluster(const Vec3& view_pos, uint32_t& x, uint32_t& y, uint32_t& z) const {
+    if (view_pos.z < near_ || view_pos.z > far_) return false;
+
+    // Tiles are uniform in NDC, so the unit-depth edges are evenly spaced
+    float u = (view_pos.x / view_pos.z - tile_x_[0]) / (tile_x_[GRID_X] - tile_x_[0]);
+    float v = (view_pos.y / view_pos.z - tile_y_[0]) / (tile_y_[GRID_Y] - tile_y_[0]);
+    if (u < 0.0f || u > 1.0f || v < 0.0f || v > 1.0f) return false;
+
+    x = (std::min)(static_cast<uint32_t>(u * GRID_X), GRID_X - 1);
+    y = (std::min)(static_cast<uint32_t>(v * GRID_Y), GRID_Y - 1);
+    float slice = std::log(view_pos.z) * slice_scale_ + slice_bias_;
+    z = static_cast<uint32_t>(std::clamp(slice, 0.0f, static_cast<float>(GRID_Z - 1)));
+    return true;
+}
+
+void LightClusterBuilder::build(const Mat4& view, const Mat4& projection, float near_plane, float far_plane,
+                                const std::vector<render::ShaderLightData>& lights, ThreadPool* pool) {
+    PROFILE_SCOPE("LightClusterBuilder_Build");
+    Timer timer;
+
+    near_ = (std::max)(near_plane, 1e-4f);
+    far_ = (std::max)(far_plane, near_ * 1.001f);
+    float log_ratio = std::log(far_ / near_);
+    slice_scale_ = static_cast<float>(GRID_Z) / log_ratio;
+    slice_bias_ = -std::log(near_) * slice_scale_;
+
+    // ndc = view.x / view.z * m00 + m20, so a tile edge at unit depth is (ndc - m20) / m00
+    for (uint32_t i = 0; i <= GRID_X; ++i) {
+        float ndc = -1.0f + 2.0f * i / GRID_X;
+        tile_x_[i] = (ndc - projection.m[2][0]) / projection.m[0][0];
+    }
+    for (uint32_t i = 0; i <= GRID_Y; ++i) {
+        float ndc = 1.0f - 2.0f * i / GRID_Y;
+        tile_y_[i] = (ndc - projection.m[2][1]) / projection.m[1][1];
+    }
+
+    // Lights to view space; everything without a finite range applies to every cluster
+    lights_.clear();
+    global_lights_.clear();
+    slice_first_.clear();
+    slice_last_.clear();
+    for (uint32_t i = 0; i < lights.size(); ++i) {
+        const render::ShaderLightData& light = lights[i];
+        if (light.intensity <= 0.0f) continue;
+        if (light.type == static_cast<uint32_t>(render::LightType::Directional) || light.range <= 0.0f) {
+            global_lights_.push_back(i);
+            continue;
+        }
+
+        const Vec3& p = light.position;
+        float vx = p.x * view.m[0][0] + p.y * view.m[1][0] + p.z * view.m[2][0] + view.m[3][0];
+        float vy = p.x * view.m[0][1] + p.y * view.m[1][1] + p.z * view.m[2][1] + view.m[3][1];
+        float vz = p.x * view.m[0][2] + p.y * view.m[1][2] + p.z * view.m[2][2] + view.m[3][2];
+        float r = light.range;
+        if (vz + r < near_ || vz - r > far_) continue;
+
+        // One extra slice on each side: the log mapping and the slice planes may disagree by an ulp
+        float lo = std::log((std::max)(vz - r, near_)) * slice_scale_ + slice_bias_;
+        float hi = std::log((std::min)(vz + r, far_)) * slice_scale_ + slice_bias_;
+        int32_t first = static_cast<int32_t>(std::floor(lo)) - 1;
+        int32_t last = static_cast<int32_t>(std::floor(hi)) + 1;
+        slice_first_.push_back(static_cast<uint16_t>(std::clamp(first, 0, static_cast<int32_t>(GRID_Z) - 1)));
+        slice_last_.push_back(static_cast<uint16_t>(std::clamp(last, 0, static_cast<int32_t>(GRID_Z) - 1)));
+        lights_.push(vx, vy, vz, r, i);
+    }
+
+    if (slices_.size() < GRID_Z) slices_.resize(GRID_Z);
+
+    bool parallel = pool && lights_.size() >= PARALLEL_MIN_LIGHTS;
+    if (parallel) {
+        // Slice 0 runs on the calling thread while the workers take the rest
+        std::vector<std::future<void>> futures;
+        futures.reserve(GRID_Z - 1);
+        for (uint32_t z = 1; z < GRID_Z; ++z) {
+            futures.push_back(pool->enqueue([this, z]() { build_slice(z); }));
+        }
+        build_slice(0);
+        for (auto& future : futures) {
+            future.wait();
+        }
+    } else {
+        for (uint32_t z = 0; z < GRID_Z; ++z) {
+            build_slice(z);
+        }
+    }
+
+    // Concatenate the slices into one index list
+    ranges_.resize(CLUSTER_COUNT);
+    indices_.clear();
+    LightClusterStats stats;
+    for (uint32_t z = 0; z < GRID_Z; ++z) {
+        const SliceResult& slice = slices_[z];
+        uint32_t base = static_cast<uint32_t>(indices_.size());
+        for (uint32_t c = 0; c < GRID_X * GRID_Y; ++c) {
+            LightClusterRange range = slice.ranges[c];
+            range.offset += base;
+            ranges_[z * GRID_X * GRID_Y + c] = range;
+            if (range.count > 0) stats.occupied_clusters++;
+            stats.max_cluster_lights = (std::max)(stats.max_cluster_lights, range.count);
+        }
+        for (uint32_t light : slice.indices) {
+            indices_.push_back(LightClusterIndex{light});
+        }
+    }
+
+    stats.light_count = static_cast<uint32_t>(lights.size());
+    stats.global_lights = static_cast<uint32_t>(global_lights_.size());
+    stats.clustered_lights = lights_.size();
+    stats.cluster_count = CLUSTER_COUNT;
+    stats.index_count = static_cast<uint32_t>(indices_.size());
+    stats.job_count = parallel ? GRID_Z : 1;
+    stats.build_ms = timer.get_total_ms();
+    last_stats_ = stats;
+}
+
+void LightClusterBuilder::build_slice(uint32_t z) {
+    PROFILE_SCOPE("LightClusterBuilder_Slice");
+    SliceResult& slice = slices_[z];
+    slice.indices.clear();
+    slice.ranges.assign(GRID_X * GRID_Y, LightClusterRange{});
+
+    // Lights whose depth range overlaps this slice
+    slice.candidates.clear();
+    for (uint32_t i = 0; i < lights_.size(); ++i) {
+        if (slice_first_[i] <= z && z <= slice_last_[i]) {
+            slice.candidates.push(lights_.x[i], lights_.y[i], lights_.z[i], lights_.radius[i], lights_.light[i]);
+        }
+    }
+
+    const LightSoA& candidates = slice.candidates;
+    LightSoA& row = slice.row;
+    for (uint32_t y = 0; y < GRID_Y; ++y) {
+        // The row box is the union of its clusters, so a light outside it touches none of them
+        row.clear();
+        if (candidates.size() > 0) {
+            BoundingBox row_box = get_cluster_bounds(0, y, z);
+            row_box.max.x = get_cluster_bounds(GRID_X - 1, y, z).max.x;
+            test_spheres(candidates.x.data(), candidates.y.data(), candidates.z.data(), candidates.radius.data(),
+                         candidates.size(), row_box, [&](uint32_t i) {
+                row.push(candidates.x[i], candidates.y[i], candidates.z[i], candidates.radius[i], candidates.light[i]);
+            });
+        }
+
+        for (uint32_t x = 0; x < GRID_X; ++x) {
+            LightClusterRange& range = slice.ranges[y * GRID_X + x];
+            range.offset = static_cast<uint32_t>(slice.indices.size());
+            slice.indices.insert(slice.indices.end(), global_lights_.begin(), global_lights_.end());
+            if (row.size() > 0) {
+                test_spheres(row.x.data(), row.y.data(), row.z.data(), row.radius.data(), row.size(),
+                             get_cluster_bounds(x, y, z), [&](uint32_t i) { slice.indices.push_back(row.light[i]); });
+            }
+            range.count = static_cast<uint32_t>(slice.indices.size()) - range.offset;
+        }
+    }
+}
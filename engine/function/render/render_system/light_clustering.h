@@ -0,0 +1,132 @@
+#pragma once
+
+#include "engine/function/render/render_pass/deferred_lighting_pass.h"
+#include "engine/function/render/data/render_structs.h"
+#include "engine/core/math/math.h"
+#include <cstdint>
+#include <vector>
+
+class ThreadPool;
+
+/**
+ * @brief First light index and light count of one cluster (uint2 on the GPU)
+ */
+struct LightClusterRange {
+    uint32_t offset = 0;
+    uint32_t count = 0;
+};
+
+struct LightClusterStats {
+    uint32_t light_count = 0;           // Lights handed to build()
+    uint32_t global_lights = 0;         // Directional / unbounded lights, listed in every cluster
+    uint32_t clustered_lights = 0;      // Point/spot lights that touch at least the view depth range
+    uint32_t cluster_count = 0;
+    uint32_t occupied_clusters = 0;     // Clusters with at least one light
+    uint32_t index_count = 0;           // Entries of the light index list
+    uint32_t max_cluster_lights = 0;
+    uint32_t job_count = 0;
+    float build_ms = 0.0f;
+};
+
+/**
+ * @brief CPU clustered (froxel) light assignment
+ *
+ * The view frustum is split into GRID_X x GRID_Y screen tiles and GRID_Z exponential depth
+ * slices. Every point/spot light is bounded by a sphere of its range and tested against the
+ * view-space AABB of each cluster it may touch: first per depth slice, then per tile row, then
+ * per cluster, 4/8 lights per SIMD iteration. Depth slices are built as jobs on the thread pool.
+ * The result is a per-cluster (offset, count) range into one light index list, which the
+ * deferred lighting shader looks up by pixel position and view depth.
+ *
+ * Row-vector view/projection (D3D style, +Z forward); the projection may be off-center (jitter).
+ */
+class LightClusterBuilder {
+public:
+    static constexpr uint32_t GRID_X = 16;
+    static constexpr uint32_t GRID_Y = 9;
+    static constexpr uint32_t GRID_Z = 24;
+    static constexpr uint32_t CLUSTER_COUNT = GRID_X * GRID_Y * GRID_Z;
+
+    /**
+     * @brief Assign lights to clusters
+     * @param lights Light array as uploaded to the GPU; the index list refers to it
+     * @param pool Optional thread pool; nullptr builds every slice on the calling thread
+     */
+    void build(const Mat4& view, const Mat4& projection, float near_plane, float far_plane,
+               const std::vector<render::ShaderLightData>& lights, ThreadPool* pool = nullptr);
+
+    inline const std::vector<LightClusterRange>& get_ranges() const { return ranges_; }
+    inline const std::vector<LightClusterIndex>& get_indices() const { return indices_; }
+    inline const LightClusterStats& get_last_stats() const { return last_stats_; }
+
+    /**
+     * @brief Flat cluster index; x, y are screen tiles (y = 0 at the top), z the depth slice
+     */
+    static inline uint32_t cluster_index(uint32_t x, uint32_t y, uint32_t z) { return (z * GRID_Y + y) * GRID_X + x; }
+
+    /**
+     * @brief Depth slice lookup: slice = log(view_z) * scale + bias, as done by the shader
+     */
+    inline float get_slice_scale() const { return slice_scale_; }
+    inline float get_slice_bias() const { return slice_bias_; }
+
+    /**
+     * @brief Cluster containing a view-space point, the same mapping the shader uses
+     * @return false if the point lies outside the view frustum
+     */
+    bool find_cluster(const Vec3& view_pos, uint32_t& x, uint32_t& y, uint32_t& z) const;
+
+    /**
+     * @brief View-space bounds of one cluster of the last build
+     */
+    BoundingBox get_cluster_bounds(uint32_t x, uint32_t y, uint32_t z) const;
+
+    /**
+     * @brief Scalar reference sphere vs AABB test, same result as the SIMD path
+     */
+    static bool sphere_intersects_box(const Vec3& center, float radius, const BoundingBox& box);
+
+    /**
+     * @brief Number of lights tested per SIMD iteration in this build
+     */
+    static uint32_t simd_width();
+
+private:
+    // Lights in view space, structure of arrays so the tests can load 4/8 lights per register
+    struct LightSoA {
+        std::vector<float> x, y, z, radius;
+        std::vector<uint32_t> light;    // Index into the light array
+
+        void clear();
+        void push(float px, float py, float pz, float r, uint32_t index);
+        inline uint32_t size() const { return static_cast<uint32_t>(light.size()); }
+    };
+
+    struct SliceResult {
+        LightSoA candidates;            // Lights overlapping the slice depth range
+        LightSoA row;                   // Candidates overlapping the current tile row
+        std::vector<uint32_t> indices;
+        std::vector<LightClusterRange> ranges;  // Offsets relative to this slice
+    };
+
+    void build_slice(uint32_t z);
+
+    float slice_near(uint32_t z) const;
+
+    LightSoA lights_;
+    std::vector<uint32_t> global_lights_;
+    std::vector<uint16_t> slice_first_, slice_last_;   // Per clustered light, its depth slice range
+
+    // View-space tile edges at unit depth: x = edge * view_z
+    float tile_x_[GRID_X + 1] = {};
+    float tile_y_[GRID_Y + 1] = {};     // Top to bottom
+    float near_ = 0.1f;
+    float far_ = 1000.0f;
+    float slice_scale_ = 0.0f;
+    float slice_bias_ = 0.0f;
+
+    std::vector<SliceResult> slices_;
+    std::vector<LightClusterRange> ranges_;
+    std::vector<LightClusterIndex> indices_;
+    LightClusterStats last_stats_;
+};
@@ -0,0 +1,51 @@
+#include "engine/function/render/render_system/lod_selection.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+void LodSelector::begin_frame(const Vec3& eye, float projection_scale) {
+    eye_ = eye;
+    size_scale_ = projection_scale * std::exp2(-bias_);
+    stats_ = LodSelectionStats{};
+    timer_.reset();
+}
+
+uint32_t LodSelector::select(const BoundingSphere& world_sphere, const std::vector<MeshLod>& lods, uint8_t& level) {
+    uint32_t selected = 0;
+    if (lods.size() > 1) {
+        selected = select_level(lods, projected_size(world_sphere, eye_, size_scale_), level, hysteresis_);
+    }
+    if (selected != level) stats_.switches++;
+    level = static_cast<uint8_t>(selected);
+
+    stats_.object_count++;
+    stats_.lod_objects[selected]++;
+    if (!lods.empty()) {
+        stats_.triangles += lods[selected].index_count / 3;
+        stats_.full_triangles += lods[0].index_count / 3;
+    }
+    return selected;
+}
+
+void LodSelector::end_frame() {
+    stats_.select_ms = timer_.get_elapsed_ms();
+    last_stats_ = stats_;
+}
+
+float LodSelector::projected_size(const BoundingSphere& world_sphere, const Vec3& eye, float projection_scale) {
+    float distance = (world_sphere.center - eye).length();
+    if (distance <= world_sphere.radius) return std::numeric_limits<float>::max();
+    return world_sphere.radius * projection_scale / distance;
+}
+
+uint32_t LodSelector::select_level(const std::vector<MeshLod>& lods, float size, uint32_t current, float hysteresis) {
+    uint32_t count = static_cast<uint32_t>(lods.size());
+    if (count <= 1) return 0;
+    uint32_t level = (std::min)(current, count - 1);
+
+    // Level l covers [screen_size of l + 1, screen_size of l); leaving it needs a margin past either edge
+    while (level + 1 < count && size < lods[level + 1].screen_size * (1.0f - hysteresis)) level++;
+    while (level > 0 && size >= lods[level].screen_size * (1.0f + hysteresis)) level--;
+    return level;
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "engine/function/render/render_resource/mesh_lod.h"
+#include "engine/function/render/data/render_structs.h"
+#include "engine/core/math/math.h"
+#include "engine/core/utils/timer.h"
+#include <cstdint>
+#include <vector>
+
+struct LodSelectionStats {
+    uint32_t object_count = 0;
+    uint32_t lod_objects[MAX_MESH_LOD_COUNT] = {};  // Objects drawn at each level
+    uint32_t switches = 0;                          // Objects whose level changed since their last selection
+    uint64_t triangles = 0;                         // Triangles of the selected levels
+    uint64_t full_triangles = 0;                    // Triangles the same objects have at LOD 0
+    float select_ms = 0.0f;
+};
+
+/**
+ * @brief Discrete screen-size LOD selection
+ *
+ * The projected size of an object is its world bounding radius over its distance to the camera,
+ * scaled by the projection (m[1][1]), so 1 means the sphere spans half the screen height. It is
+ * scaled by 2^-bias, so a positive bias picks coarser levels, and compared against the
+ * screen_size of each MeshLod. Around each threshold a band of +-hysteresis (relative) keeps
+ * the previous level, so an object at a switch distance does not pop every frame.
+ *
+ * The selected level of every object is kept by the caller and passed back each frame.
+ */
+class LodSelector {
+public:
+    static constexpr float DEFAULT_HYSTERESIS = 0.1f;
+
+    void set_bias(float bias) { bias_ = bias; }
+    float get_bias() const { return bias_; }
+
+    void set_hysteresis(float hysteresis) { hysteresis_ = hysteresis; }
+    float get_hysteresis() const { return hysteresis_; }
+
+    /**
+     * @brief Start selecting for one view
+     * @param eye Camera position
+     * @param projection_scale projection.m[1][1] of the camera
+     */
+    void begin_frame(const Vec3& eye, float projection_scale);
+
+    /**
+     * @brief Select the level of one object
+     * @param level Level selected for the object last frame; updated in place
+     * @return The selected level
+     */
+    uint32_t select(const BoundingSphere& world_sphere, const std::vector<MeshLod>& lods, uint8_t& level);
+
+    void end_frame();
+
+    inline const LodSelectionStats& get_last_stats() const { return last_stats_; }
+
+    /**
+     * @brief Projected size of a world sphere; infinite when the camera is inside it
+     */
+    static float projected_size(const BoundingSphere& world_sphere, const Vec3& eye, float projection_scale);
+
+    /**
+     * @brief Level for a projected size, starting from current and applying the hysteresis band
+     */
+    static uint32_t select_level(const std::vector<MeshLod>& lods, float size, uint32_t current, float hysteresis);
+
+private:
+    float bias_ = 0.0f;
+    float hysteresis_ = DEFAULT_HYSTERESIS;
+
+    Vec3 eye_ = Vec3::Zero();
+    float size_scale_ = 1.0f;       // projection_scale * 2^-bias
+    Timer timer_;
+    LodSelectionStats stats_;
+    LodSelectionStats last_stats_;
+};
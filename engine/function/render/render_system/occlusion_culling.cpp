@@ -0,0 +1,400 @@
+#include "engine/function/render/render_system/occlusion_culling.h"
+#include "engine/core/os/thread_pool.h"
+#include "engine/core/utils/profiler.h"
+#include "engine/core/utils/timer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <future>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define OCCLUSION_CULL_SIMD_WIDTH 8
+#elif defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define OCCLUSION_CULL_SIMD_WIDTH 4
+#else
+#define OCCLUSION_CULL_SIMD_WIDTH 1
+#endif
+
+namespace {
+
+// Triangles with a smaller doubled screen area (in pixels) cover no pixel center worth testing
+constexpr float MIN_TRIANGLE_AREA = 1e-6f;
+
+#if OCCLUSION_CULL_SIMD_WIDTH == 8
+struct SimdOps {
+    using Reg = __m256;
+    static constexpr uint32_t WIDTH = 8;
+    static Reg load(const float* p) { return _mm256_loadu_ps(p); }
+    static void store(float* p, Reg a) { _mm256_storeu_ps(p, a); }
+    static Reg set1(float v) { return _mm256_set1_ps(v); }
+    static Reg ramp() { return _mm256_setr_ps(0.5f, 1.5f, 2.5f, 3.5f, 4.5f, 5.5f, 6.5f, 7.5f); }
+    static Reg zero() { return _mm256_setzero_ps(); }
+    static Reg add(Reg a, Reg b) { return _mm256_add_ps(a, b); }
+    static Reg mul(Reg a, Reg b) { return _mm256_mul_ps(a, b); }
+    static Reg min(Reg a, Reg b) { return _mm256_min_ps(a, b); }
+    static Reg ge(Reg a, Reg b) { return _mm256_cmp_ps(a, b, _CMP_GE_OQ); }
+    static Reg and_(Reg a, Reg b) { return _mm256_and_ps(a, b); }
+    static Reg select(Reg mask, Reg a, Reg b) { return _mm256_blendv_ps(b, a, mask); }
+    static int mask(Reg a) { return _mm256_movemask_ps(a); }
+};
+#elif OCCLUSION_CULL_SIMD_WIDTH == 4
+struct SimdOps {
+    using Reg = __m128;
+    static constexpr uint32_t WIDTH = 4;
+    static Reg load(const float* p) { return _mm_loadu_ps(p); }
+    static void store(float* p, Reg a) { _mm_storeu_ps(p, a); }
+    static Reg set1(float v) { return _mm_set1_ps(v); }
+    static Reg ramp() { return _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f); }
+    static Reg zero() { return _mm_setzero_ps(); }
+    static Reg add(Reg a, Reg b) { return _mm_add_ps(a, b); }
+    static Reg mul(Reg a, Reg b) { return _mm_mul_ps(a, b); }
+    static Reg min(Reg a, Reg b) { return _mm_min_ps(a, b); }
+    static Reg ge(Reg a, Reg b) { return _mm_cmpge_ps(a, b); }
+    static Reg and_(Reg a, Reg b) { return _mm_and_ps(a, b); }
+    static Reg select(Reg mask, Reg a, Reg b) { return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b)); }
+    static int mask(Reg a) { return _mm_movemask_ps(a); }
+};
+#endif
+
+inline Vec4 transform_point(const Vec3& p, const Mat4& m) {
+    return Vec4(p.x * m.m[0][0] + p.y * m.m[1][0] + p.z * m.m[2][0] + m.m[3][0],
+                p.x * m.m[0][1] + p.y * m.m[1][1] + p.z * m.m[2][1] + m.m[3][1],
+                p.x * m.m[0][2] + p.y * m.m[1][2] + p.z * m.m[2][2] + m.m[3][2],
+                p.x * m.m[0][3] + p.y * m.m[1][3] + p.z * m.m[2][3] + m.m[3][3]);
+}
+
+// Bit per clip plane the vertex lies outside of: -x, +x, -y, +y, near, far
+inline uint32_t outcode(const Vec4& v) {
+    return (v.x < -v.w ? 1u : 0u) | (v.x > v.w ? 2u : 0u) | (v.y < -v.w ? 4u : 0u) |
+           (v.y > v.w ? 8u : 0u) | (v.z < 0.0f ? 16u : 0u) | (v.z > v.w ? 32u : 0u);
+}
+
+inline Vec4 lerp_clip(const Vec4& a, const Vec4& b, float t) {
+    return Vec4(a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t, a.z + (b.z - a.z) * t, a.w + (b.w - a.w) * t);
+}
+
+// First and last pixel whose center lies in [lo, hi], clamped to the buffer; false if there is none
+inline bool pixel_span(float lo, float hi, uint32_t size, int& first, int& last) {
+    lo = (std::min)((std::max)(lo - 0.5f, -1.0f), static_cast<float>(size));
+    hi = (std::min)((std::max)(hi - 0.5f, -1.0f), static_cast<float>(size));
+    // Truncation is floor for values >= 0, hence the +1/-1
+    first = static_cast<int>(lo + 1.0f) - 1;
+    if (static_cast<float>(first) < lo) first++;
+    last = static_cast<int>(hi + 1.0f) - 1;
+    first = (std::max)(first, 0);
+    last = (std::min)(last, static_cast<int>(size) - 1);
+    return first <= last;
+}
+
+// Jobs 1..count-1 go to the pool while job 0 runs on the calling thread
+template<typename Job>
+void run_jobs(ThreadPool* pool, uint32_t count, Job&& job) {
+    if (pool && count > 1) {
+        std::vector<std::future<void>> futures;
+        futures.reserve(count - 1);
+        for (uint32_t i = 1; i < count; ++i) {
+            futures.push_back(pool->enqueue(job, i));
+        }
+        job(0u);
+        for (auto& future : futures) {
+            future.wait();
+        }
+    } else {
+        for (uint32_t i = 0; i < count; ++i) {
+            job(i);
+        }
+    }
+}
+
+} // namespace
+
+uint32_t OcclusionCuller::simd_width() {
+    return OCCLUSION_CULL_SIMD_WIDTH;
+}
+
+std::vector<std::vector<float>> OcclusionCuller::init_levels() {
+    std::vector<std::vector<float>> levels(LEVEL_COUNT);
+    for (uint32_t l = 0; l < LEVEL_COUNT; ++l) {
+        levels[l].assign((WIDTH >> l) * (HEIGHT >> l), 1.0f);
+    }
+    return levels;
+}
+
+void OcclusionCuller::render_occluders(const Mat4& view_proj, const std::vector<OccluderMesh>& occluders, ThreadPool* pool) {
+    PROFILE_SCOPE("OcclusionCuller_Rasterize");
+    Timer timer;
+
+    view_proj_ = view_proj;
+    std::fill(levels_[0].begin(), levels_[0].end(), 1.0f);
+
+    // Setup: occluders are split into contiguous ranges, one triangle list per job
+    uint32_t occluder_count = static_cast<uint32_t>(occluders.size());
+    uint32_t setup_jobs = pool ? (std::min)(occluder_count, BAND_COUNT) : (std::min)(occluder_count, 1u);
+    if (setups_.size() < setup_jobs) setups_.resize(setup_jobs);
+    run_jobs(pool, setup_jobs, [&](uint32_t job) {
+        PROFILE_SCOPE("OcclusionCuller_Setup");
+        uint32_t begin = occluder_count * job / setup_jobs;
+        uint32_t end = occluder_count * (job + 1) / setup_jobs;
+        setup_occluders(view_proj, occluders, begin, end, setups_[job]);
+    });
+    for (uint32_t job = setup_jobs; job < setups_.size(); ++job) {
+        for (auto& band : setups_[job].bands) band.clear();
+        setups_[job].submitted = 0;
+        setups_[job].rasterized = 0;
+    }
+
+    // Bands own disjoint rows, so they write the depth buffer without synchronization
+    run_jobs(pool, setup_jobs > 0 ? BAND_COUNT : 0, [&](uint32_t band) {
+        PROFILE_SCOPE("OcclusionCuller_Band");
+        rasterize_band(band);
+    });
+    build_hiz();
+
+    OcclusionCullingStats stats;
+    stats.occluder_count = occluder_count;
+    for (const SetupResult& setup : setups_) {
+        stats.occluder_triangles += setup.submitted;
+        stats.rasterized_triangles += setup.rasterized;
+    }
+    stats.job_count = setup_jobs > 0 ? setup_jobs + BAND_COUNT : 0;
+    stats.raster_ms = timer.get_total_ms();
+    last_stats_ = stats;
+}
+
+void OcclusionCuller::setup_occluders(const Mat4& view_proj, const std::vector<OccluderMesh>& occluders,
+                                      uint32_t begin, uint32_t end, SetupResult& result) const {
+    for (auto& band : result.bands) band.clear();
+    result.submitted = 0;
+    result.rasterized = 0;
+
+    for (uint32_t o = begin; o < end; ++o) {
+        const OccluderMesh& occluder = occluders[o];
+        if (!occluder.positions || !occluder.indices) continue;
+
+        // Vertices are shared by several triangles: transform and project each once
+        Mat4 world_view_proj = occluder.world * view_proj;
+        result.clip.resize(occluder.vertex_count);
+        result.screen.resize(occluder.vertex_count);
+        for (uint32_t v = 0; v < occluder.vertex_count; ++v) {
+            result.clip[v] = transform_point(occluder.positions[v], world_view_proj);
+            if (result.clip[v].z >= 0.0f) result.screen[v] = to_screen(result.clip[v]);
+        }
+
+        for (uint32_t i = 0; i + 2 < occluder.index_count; i += 3) {
+            uint32_t i0 = occluder.indices[i], i1 = occluder.indices[i + 1], i2 = occluder.indices[i + 2];
+            if (i0 >= occluder.vertex_count || i1 >= occluder.vertex_count || i2 >= occluder.vertex_count) continue;
+            result.submitted++;
+
+            const Vec4* v[3] = { &result.clip[i0], &result.clip[i1], &result.clip[i2] };
+            uint32_t codes[3] = { outcode(*v[0]), outcode(*v[1]), outcode(*v[2]) };
+            if (codes[0] & codes[1] & codes[2]) continue;   // Entirely outside one plane
+
+            if (((codes[0] | codes[1] | codes[2]) & 16u) == 0) {
+                setup_triangle(result.screen[i0], result.screen[i1], result.screen[i2], result);
+                continue;
+            }
+
+            // Clip against the near plane (z >= 0); the polygon has at most 4 vertices
+            Vec3 polygon[4];
+            uint32_t count = 0;
+            for (uint32_t e = 0; e < 3; ++e) {
+                const Vec4& a = *v[e];
+                const Vec4& b = *v[(e + 1) % 3];
+                bool a_in = a.z >= 0.0f;
+                bool b_in = b.z >= 0.0f;
+                if (a_in) polygon[count++] = to_screen(a);
+                if (a_in != b_in) polygon[count++] = to_screen(lerp_clip(a, b, a.z / (a.z - b.z)));
+            }
+            for (uint32_t k = 1; k + 1 < count; ++k) {
+                setup_triangle(polygon[0], polygon[k], polygon[k + 1], result);
+            }
+        }
+    }
+}
+
+Vec3 OcclusionCuller::to_screen(const Vec4& clip) {
+    float inv_w = 1.0f / clip.w;
+    return Vec3((clip.x * inv_w * 0.5f + 0.5f) * WIDTH, (0.5f - clip.y * inv_w * 0.5f) * HEIGHT, clip.z * inv_w);
+}
+
+void OcclusionCuller::setup_triangle(Vec3 v0, Vec3 v1, Vec3 v2, SetupResult& result) const {
+    // Both windings are rasterized: occluders are not guaranteed to be closed or consistently wound
+    float area = (v1.x - v0.x) * (v2.y - v0.y) - (v2.x - v0.x) * (v1.y - v0.y);
+    if (std::abs(area) < MIN_TRIANGLE_AREA) return;
+    if (area < 0.0f) {
+        std::swap(v1, v2);
+        area = -area;
+    }
+
+    // Pixels whose centers lie in the bounding rectangle
+    int min_x, max_x, min_y, max_y;
+    if (!pixel_span((std::min)({v0.x, v1.x, v2.x}), (std::max)({v0.x, v1.x, v2.x}), WIDTH, min_x, max_x)) return;
+    if (!pixel_span((std::min)({v0.y, v1.y, v2.y}), (std::max)({v0.y, v1.y, v2.y}), HEIGHT, min_y, max_y)) return;
+
+    const float x[3] = { v0.x, v1.x, v2.x };
+    const float y[3] = { v0.y, v1.y, v2.y };
+    const float z[3] = { v0.z, v1.z, v2.z };
+    ScreenTriangle tri;
+    for (int e = 0; e < 3; ++e) {
+        int a = e, b = (e + 1) % 3;
+        tri.edge_a[e] = -(y[b] - y[a]);
+        tri.edge_b[e] = x[b] - x[a];
+        tri.edge_c[e] = (y[b] - y[a]) * x[a] - (x[b] - x[a]) * y[a];
+    }
+
+    // Depth plane, pushed to the farthest value it takes within a pixel
+    float inv_area = 1.0f / area;
+    tri.depth_x = ((z[1] - z[0]) * (y[2] - y[0]) - (z[2] - z[0]) * (y[1] - y[0])) * inv_area;
+    tri.depth_y = ((z[2] - z[0]) * (x[1] - x[0]) - (z[1] - z[0]) * (x[2] - x[0])) * inv_area;
+    tri.depth_c = z[0] - tri.depth_x * x[0] - tri.depth_y * y[0] +
+                  0.5f * (std::abs(tri.depth_x) + std::abs(tri.depth_y));
+
+    tri.min_x = static_cast<uint16_t>(min_x);
+    tri.max_x = static_cast<uint16_t>(max_x);
+    tri.min_y = static_cast<uint16_t>(min_y);
+    tri.max_y = static_cast<uint16_t>(max_y);
+    for (uint32_t band = min_y / BAND_HEIGHT; band <= max_y / BAND_HEIGHT; ++band) {
+        result.bands[band].push_back(tri);
+    }
+    result.rasterized++;
+}
+
+void OcclusionCuller::rasterize_band(uint32_t band) {
+    uint32_t band_begin = band * BAND_HEIGHT;
+    uint32_t band_end = band_begin + BAND_HEIGHT;
+    float* depth = levels_[0].data();
+
+    for (const SetupResult& setup : setups_) {
+        for (const ScreenTriangle& tri : setup.bands[band]) {
+            uint32_t row_begin = (std::max)(static_cast<uint32_t>(tri.min_y), band_begin);
+            uint32_t row_end = (std::min)(static_cast<uint32_t>(tri.max_y) + 1, band_end);
+            if (row_begin >= row_end) continue;
+
+            for (uint32_t py = row_begin; py < row_end; ++py) {
+                float center_y = static_cast<float>(py) + 0.5f;
+                float row_edge[3];
+                for (int e = 0; e < 3; ++e) row_edge[e] = tri.edge_b[e] * center_y + tri.edge_c[e];
+                float row_depth = tri.depth_y * center_y + tri.depth_c;
+                float* row = depth + py * WIDTH;
+
+                uint32_t px = tri.min_x;
+#if OCCLUSION_CULL_SIMD_WIDTH > 1
+                using Ops = SimdOps;
+                using Reg = Ops::Reg;
+                // Align to the register width; WIDTH is a multiple of it, so no block runs past the row
+                px &= ~(Ops::WIDTH - 1);
+                Reg zero = Ops::zero();
+                for (; px <= tri.max_x; px += Ops::WIDTH) {
+                    Reg center_x = Ops::add(Ops::set1(static_cast<float>(px)), Ops::ramp());
+                    Reg inside = Ops::ge(Ops::add(Ops::mul(Ops::set1(tri.edge_a[0]), center_x), Ops::set1(row_edge[0])), zero);
+                    inside = Ops::and_(inside, Ops::ge(Ops::add(Ops::mul(Ops::set1(tri.edge_a[1]), center_x), Ops::set1(row_edge[1])), zero));
+                    inside = Ops::and_(inside, Ops::ge(Ops::add(Ops::mul(Ops::set1(tri.edge_a[2]), center_x), Ops::set1(row_edge[2])), zero));
+                    if (Ops::mask(inside) == 0) continue;
+
+                    Reg z = Ops::add(Ops::mul(Ops::set1(tri.depth_x), center_x), Ops::set1(row_depth));
+                    Reg old = Ops::load(row + px);
+                    Ops::store(row + px, Ops::select(inside, Ops::min(old, z), old));
+                }
+#else
+                for (; px <= tri.max_x; ++px) {
+                    float center_x = static_cast<float>(px) + 0.5f;
+                    if (tri.edge_a[0] * center_x + row_edge[0] < 0.0f) continue;
+                    if (tri.edge_a[1] * center_x + row_edge[1] < 0.0f) continue;
+                    if (tri.edge_a[2] * center_x + row_edge[2] < 0.0f) continue;
+                    row[px] = (std::min)(row[px], tri.depth_x * center_x + row_depth);
+                }
+#endif
+            }
+        }
+    }
+}
+
+void OcclusionCuller::build_hiz() {
+    for (uint32_t l = 1; l < LEVEL_COUNT; ++l) {
+        const std::vector<float>& src = levels_[l - 1];
+        std::vector<float>& dst = levels_[l];
+        uint32_t src_width = WIDTH >> (l - 1);
+        uint32_t width = WIDTH >> l;
+        uint32_t height = HEIGHT >> l;
+        for (uint32_t y = 0; y < height; ++y) {
+            const float* top = &src[(2 * y) * src_width];
+            const float* bottom = top + src_width;
+            for (uint32_t x = 0; x < width; ++x) {
+                dst[y * width + x] = (std::max)((std::max)(top[2 * x], top[2 * x + 1]),
+                                                (std::max)(bottom[2 * x], bottom[2 * x + 1]));
+            }
+        }
+    }
+}
+
+bool OcclusionCuller::is_visible(const BoundingBox& box) const {
+    float lo_x = 1.0f, hi_x = -1.0f, lo_y = 1.0f, hi_y = -1.0f;
+    float nearest = 1.0f;
+    for (uint32_t corner = 0; corner < 8; ++corner) {
+        Vec3 p((corner & 1) ? box.max.x : box.min.x,
+               (corner & 2) ? box.max.y : box.min.y,
+               (corner & 4) ? box.max.z : box.min.z);
+        Vec4 clip = transform_point(p, view_proj_);
+        if (clip.z < 0.0f || clip.w <= 0.0f) return true;   // Crosses the near plane
+        float inv_w = 1.0f / clip.w;
+        float x = clip.x * inv_w, y = clip.y * inv_w;
+        lo_x = (std::min)(lo_x, x);
+        hi_x = (std::max)(hi_x, x);
+        lo_y = (std::min)(lo_y, y);
+        hi_y = (std::max)(hi_y, y);
+        nearest = (std::min)(nearest, clip.z * inv_w);
+    }
+    if (lo_x > hi_x || lo_y > hi_y) return true;
+
+    // Every pixel the rectangle touches, not only those whose centers it contains
+    auto to_pixel = [](float v, uint32_t size) {
+        return static_cast<int>((std::min)((std::max)(std::floor(v), 0.0f), static_cast<float>(size - 1)));
+    };
+    int x0 = to_pixel((lo_x * 0.5f + 0.5f) * WIDTH, WIDTH);
+    int x1 = to_pixel((hi_x * 0.5f + 0.5f) * WIDTH, WIDTH);
+    int y0 = to_pixel((0.5f - hi_y * 0.5f) * HEIGHT, HEIGHT);
+    int y1 = to_pixel((0.5f - lo_y * 0.5f) * HEIGHT, HEIGHT);
+
+    // Coarsest level needed for the rectangle to span at most 2x2 texels
+    uint32_t level = 0;
+    while (level + 1 < LEVEL_COUNT && ((x1 >> level) - (x0 >> level) > 1 || (y1 >> level) - (y0 >> level) > 1)) {
+        level++;
+    }
+    const std::vector<float>& hiz = levels_[level];
+    uint32_t width = WIDTH >> level;
+    float farthest = 0.0f;
+    for (int y = y0 >> level; y <= (y1 >> level); ++y) {
+        for (int x = x0 >> level; x <= (x1 >> level); ++x) {
+            farthest = (std::max)(farthest, hiz[y * width + x]);
+        }
+    }
+    return nearest <= farthest;
+}
+
+void OcclusionCuller::cull(const CullingBounds& bounds, std::vector<uint32_t>& indices, ThreadPool* pool) {
+    PROFILE_SCOPE("OcclusionCuller_Test");
+    Timer timer;
+
+    uint32_t count = static_cast<uint32_t>(indices.size());
+    uint32_t chunk_count = (count + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    if (chunks_.size() < chunk_count) chunks_.resize(chunk_count);
+
+    run_jobs(pool, chunk_count, [&](uint32_t c) {
+        std::vector<uint32_t>& visible = chunks_[c];
+        visible.clear();
+        uint32_t end = (std::min)((c + 1) * CHUNK_SIZE, count);
+        for (uint32_t i = c * CHUNK_SIZE; i < end; ++i) {
+            if (is_visible(bounds.get_box(indices[i]))) visible.push_back(indices[i]);
+        }
+    });
+
+    indices.clear();
+    for (uint32_t c = 0; c < chunk_count; ++c) {
+        indices.insert(indices.end(), chunks_[c].begin(), chunks_[c].end());
+    }
+    last_stats_.tested = count;
+    last_stats_.occluded = count - static_cast<uint32_t>(indices.size());
+    last_stats_.test_ms = timer.get_total_ms();
+}
@@ -0,0 +1,119 @@
+#pragma once
+
+#include "engine/function/render/render_system/frustum_culling.h"
+#include "engine/core/math/math.h"
+#include <cstdint>
+#include <vector>
+
+class ThreadPool;
+
+/**
+ * @brief Triangle geometry of one occluder; the arrays must outlive render_occluders()
+ */
+struct OccluderMesh {
+    const Vec3* positions = nullptr;
+    uint32_t vertex_count = 0;
+    const uint32_t* indices = nullptr;
+    uint32_t index_count = 0;
+    Mat4 world = Mat4::Identity();
+};
+
+struct OcclusionCullingStats {
+    uint32_t occluder_count = 0;
+    uint32_t occluder_triangles = 0;    // Triangles submitted by the occluders
+    uint32_t rasterized_triangles = 0;  // Left after clipping, culling of off-screen and degenerate ones
+    uint32_t tested = 0;
+    uint32_t occluded = 0;
+    uint32_t job_count = 0;
+    float raster_ms = 0.0f;             // Setup, rasterization and HiZ build
+    float test_ms = 0.0f;
+};
+
+/**
+ * @brief Software occlusion culling against a low-resolution CPU depth buffer
+ *
+ * A few large occluders are rasterized into a WIDTH x HEIGHT depth buffer (D3D 0..1 depth,
+ * nearest wins), evaluating 4/8 pixels per SIMD iteration. Triangles are set up per occluder
+ * and rasterized per BAND_HEIGHT-row band, both as jobs on the thread pool. A max-depth
+ * hierarchy is built on top, and the AABB of each candidate is projected to a screen rectangle
+ * with its nearest depth and compared against the HiZ level where the rectangle spans at most
+ * 2x2 texels.
+ *
+ * Conservative in depth: each covered pixel stores the farthest depth of the triangle plane
+ * within the pixel, and objects crossing the near plane are always visible. Coverage is sampled
+ * at pixel centers, so an object seen only through a gap narrower than a pixel can be lost.
+ */
+class OcclusionCuller {
+public:
+    static constexpr uint32_t WIDTH = 256;
+    static constexpr uint32_t HEIGHT = 128;
+    static constexpr uint32_t BAND_HEIGHT = 16;
+    static constexpr uint32_t BAND_COUNT = HEIGHT / BAND_HEIGHT;
+    static constexpr uint32_t LEVEL_COUNT = 8;      // Depth buffer plus max-depth mips down to 2x1
+    static constexpr uint32_t CHUNK_SIZE = 1024;    // Candidates per test job
+
+    /**
+     * @brief Clear the depth buffer, rasterize the occluders and build the HiZ
+     * @param view_proj Row-vector view * projection of the camera
+     * @param pool Optional thread pool; nullptr runs every job on the calling thread
+     */
+    void render_occluders(const Mat4& view_proj, const std::vector<OccluderMesh>& occluders, ThreadPool* pool = nullptr);
+
+    /**
+     * @brief Remove occluded objects from indices, keeping the order of the rest
+     * @param indices Indices into bounds, e.g. the output of the frustum culler
+     */
+    void cull(const CullingBounds& bounds, std::vector<uint32_t>& indices, ThreadPool* pool = nullptr);
+
+    /**
+     * @brief Scalar test of one world-space AABB against the HiZ of the last render_occluders()
+     */
+    bool is_visible(const BoundingBox& box) const;
+
+    /**
+     * @brief Depth buffer of the last render_occluders(), WIDTH x HEIGHT, row 0 at the top
+     */
+    inline const std::vector<float>& get_depth_buffer() const { return levels_[0]; }
+    inline float get_depth(uint32_t x, uint32_t y) const { return levels_[0][y * WIDTH + x]; }
+
+    inline const OcclusionCullingStats& get_last_stats() const { return last_stats_; }
+
+    /**
+     * @brief Number of pixels written per SIMD iteration in this build
+     */
+    static uint32_t simd_width();
+
+private:
+    // Screen-space triangle ready for rasterization: edge functions and depth plane in pixels
+    struct ScreenTriangle {
+        float edge_a[3], edge_b[3], edge_c[3];  // e(x, y) = a * x + b * y + c, >= 0 inside
+        float depth_x, depth_y, depth_c;        // z(x, y) = depth_x * x + depth_y * y + depth_c
+        uint16_t min_x, max_x, min_y, max_y;    // Inclusive pixel bounds
+    };
+
+    struct SetupResult {
+        std::vector<ScreenTriangle> bands[BAND_COUNT];  // Binned by the bands each triangle overlaps
+        std::vector<Vec4> clip;                 // Vertices of the occluder being set up
+        std::vector<Vec3> screen;               // Pixel x, y and depth, valid where clip.z >= 0
+        uint32_t submitted = 0;
+        uint32_t rasterized = 0;
+    };
+
+    static std::vector<std::vector<float>> init_levels();
+
+    void setup_occluders(const Mat4& view_proj, const std::vector<OccluderMesh>& occluders,
+                         uint32_t begin, uint32_t end, SetupResult& result) const;
+    void rasterize_band(uint32_t band);
+    void build_hiz();
+
+    static Vec3 to_screen(const Vec4& clip);
+    void setup_triangle(Vec3 v0, Vec3 v1, Vec3 v2, SetupResult& result) const;
+
+    // Level l is (WIDTH >> l) x (HEIGHT >> l); level 0 is the depth buffer, cleared to the far plane
+    std::vector<std::vector<float>> levels_ = init_levels();
+    Mat4 view_proj_ = Mat4::Identity();
+
+    std::vector<SetupResult> setups_;
+    std::vector<std::vector<uint32_t>> chunks_;
+    OcclusionCullingStats last_stats_;
+};
@@ -31,65 +31,49 @@ const std::vector<VolumeLightComponent*>& RenderLightManager::get_volume_lights(
 void RenderLightManager::prepare_lights(uint32_t frame_index) {
     auto& lights = perframe_lights_[frame_index];
 
-    // Clear previous frame data
-    lights.directional_light = nullptr;
-    lights.point_shadow_lights.clear();
+    // Volume lights are not registered; they are still collected from the scene
     lights.volume_lights.clear();
-
-    // Get active scene from world
     auto* world = EngineContext::world();
-    if (!world) {
-        return;
+    auto* scene = world ? world->get_active_scene() : nullptr;
+    if (scene) {
+        for (auto* volume_light : scene->get_volume_lights()) {
+            if (volume_light && volume_light->enable()) {
+                lights.volume_lights.push_back(volume_light);
+                volume_light->update_light_info();
+            }
+        }
     }
-    
-    auto* scene = world->get_active_scene();
-    if (!scene) {
+
+    // Directional and point lights only change with the registry
+    if (lights.light_revision == registry_.get_revision()) {
+        registry_.reset_stats();
         return;
     }
+    lights.light_revision = registry_.get_revision();
 
-    // Collect directional light
-    lights.directional_light = scene->get_directional_light();
-    if (lights.directional_light && lights.directional_light->enable()) {
+    lights.directional_light = static_cast<DirectionalLightComponent*>(registry_.get_main_light_owner());
+    if (lights.directional_light) {
         lights.directional_light->update_light_info();
     }
 
-    // Collect point lights
-    auto point_light_components = scene->get_point_lights();
-    uint32_t shadow_light_count = 0;
-    
-    for (auto* point_light : point_light_components) {
-        if (!point_light) continue;
-
-        // Reset shadow ID
-        point_light->point_shadow_id_ = MAX_POINT_SHADOW_COUNT;
+    // Shadow ids go to the first shadow-casting point lights of the packed array
+    for (auto* point_light : shadow_id_owners_) {
+        if (registry_.contains(point_light)) point_light->set_point_shadow_id(MAX_POINT_SHADOW_COUNT);
+    }
+    shadow_id_owners_.clear();
+    lights.point_shadow_lights.clear();
 
-        // Check if this light should cast shadow
-        if (point_light->enable() && 
-            point_light->cast_shadow() && 
-            shadow_light_count < MAX_POINT_SHADOW_COUNT) {
-            point_light->set_point_shadow_id(shadow_light_count++);
+    const auto& packed = registry_.get_lights();
+    const auto& owners = registry_.get_owners();
+    for (uint32_t i = 0; i < packed.size(); ++i) {
+        if (packed[i].type != static_cast<uint32_t>(render::LightType::Point)) continue;
+        auto* point_light = static_cast<PointLightComponent*>(owners[i]);
+        if (point_light->cast_shadow() && shadow_id_owners_.size() < MAX_POINT_SHADOW_COUNT) {
+            point_light->set_point_shadow_id(static_cast<uint32_t>(shadow_id_owners_.size()));
+            shadow_id_owners_.push_back(point_light);
             lights.point_shadow_lights.push_back(point_light);
-        }
-
-        // Update light info regardless of shadow status
-        if (point_light->enable()) {
             point_light->update_light_info();
         }
     }
-
-    // Collect volume lights
-    auto volume_light_components = scene->get_volume_lights();
-    for (auto* volume_light : volume_light_components) {
-        if (volume_light && volume_light->enable()) {
-            lights.volume_lights.push_back(volume_light);
-            volume_light->update_light_info();
-        }
-    }
-
-    // INFO(LogRenderLightManager, 
-    //      "Frame {}: {} directional light, {} point shadow lights, {} volume lights",
-    //      frame_index,
-    //      lights.directional_light ? 1 : 0,
-    //      lights.point_shadow_lights.size(),
-    //      lights.volume_lights.size());
+    registry_.reset_stats();
 }
@@ -3,6 +3,7 @@
 #include "engine/function/framework/component/directional_light_component.h"
 #include "engine/function/framework/component/point_light_component.h"
 #include "engine/function/framework/component/volume_light_component.h"
+#include "engine/function/render/render_system/render_light_registry.h"
 #include "engine/configs.h"
 
 #include <array>
@@ -13,7 +14,13 @@ class RenderLightManager {
 public:
     void init();
     void tick(uint32_t frame_index);
-    void destroy() {}
+    void destroy() { registry_.clear(); }
+
+    /**
+     * @brief Lights registered by their components; the scene snapshot copies it when it changed
+     */
+    RenderLightRegistry& get_registry() { return registry_; }
+    const RenderLightRegistry& get_registry() const { return registry_; }
 
     DirectionalLightComponent* get_directional_light(uint32_t frame_index);
     const std::vector<PointLightComponent*>& get_point_shadow_lights(uint32_t frame_index);
@@ -26,7 +33,10 @@ private:
         std::vector<PointLightComponent*> point_shadow_lights;
         DirectionalLightComponent* directional_light = nullptr;
         std::vector<VolumeLightComponent*> volume_lights;
+        uint64_t light_revision = UINT64_MAX;   // Registry revision the lists were built from
     };
     
+    RenderLightRegistry registry_;
+    std::vector<PointLightComponent*> shadow_id_owners_;    // Point lights holding a shadow id
     std::array<PerFrameLights, FRAMES_IN_FLIGHT> perframe_lights_;
 };
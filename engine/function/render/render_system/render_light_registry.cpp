@@ -0,0 +1,115 @@
+#include "engine/function/render/render_system/render_light_registry.h"
+
+#include <algorithm>
+#include <cstring>
+
+bool RenderLightDesc::operator==(const RenderLightDesc& other) const {
+    // ShaderLightData is all 4-byte fields with explicit padding, so it compares bytewise
+    return std::memcmp(&data, &other.data, sizeof(data)) == 0 && cast_shadow == other.cast_shadow &&
+           cascade_split == other.cascade_split;
+}
+
+void RenderLightRegistry::set_light(Component* owner, const RenderLightDesc& desc) {
+    auto [it, inserted] = entries_.try_emplace(owner);
+    Entry& entry = it->second;
+    entry.desc = desc;
+    bool directional = desc.data.type == static_cast<uint32_t>(render::LightType::Directional);
+
+    if (inserted) {
+        entry.id = next_id_++;
+        if (directional) directionals_.push_back(owner);
+        pack(owner, entry);
+    } else if (entry.index != NOT_PACKED) {
+        lights_[entry.index] = desc.data;
+        shadows_[entry.index] = desc.cast_shadow ? 1 : 0;
+    }
+    if (directional) update_main_light();
+
+    revision_++;
+    stats_.changed++;
+    update_stats();
+}
+
+void RenderLightRegistry::remove(Component* owner) {
+    auto it = entries_.find(owner);
+    if (it == entries_.end()) return;
+
+    unpack(it->second);
+    entries_.erase(it);
+    auto directional = std::find(directionals_.begin(), directionals_.end(), owner);
+    if (directional != directionals_.end()) {
+        directionals_.erase(directional);
+        if (main_owner_ == owner) main_owner_ = nullptr;
+        update_main_light();
+    }
+
+    revision_++;
+    stats_.removed++;
+    update_stats();
+}
+
+const RenderLightDesc* RenderLightRegistry::get_main_light() const {
+    if (!main_owner_) return nullptr;
+    return &entries_.find(main_owner_)->second.desc;
+}
+
+void RenderLightRegistry::reset_stats() {
+    stats_.changed = 0;
+    stats_.removed = 0;
+}
+
+void RenderLightRegistry::clear() {
+    entries_.clear();
+    lights_.clear();
+    owners_.clear();
+    ids_.clear();
+    shadows_.clear();
+    directionals_.clear();
+    main_owner_ = nullptr;
+    revision_++;
+    reset_stats();
+    update_stats();
+}
+
+void RenderLightRegistry::pack(Component* owner, Entry& entry) {
+    entry.index = static_cast<uint32_t>(lights_.size());
+    lights_.push_back(entry.desc.data);
+    owners_.push_back(owner);
+    ids_.push_back(entry.id);
+    shadows_.push_back(entry.desc.cast_shadow ? 1 : 0);
+}
+
+void RenderLightRegistry::unpack(Entry& entry) {
+    if (entry.index == NOT_PACKED) return;
+
+    // The last light moves into the hole
+    uint32_t last = static_cast<uint32_t>(lights_.size()) - 1;
+    if (entry.index != last) {
+        lights_[entry.index] = lights_[last];
+        owners_[entry.index] = owners_[last];
+        ids_[entry.index] = ids_[last];
+        shadows_[entry.index] = shadows_[last];
+        entries_.find(owners_[entry.index])->second.index = entry.index;
+    }
+    lights_.pop_back();
+    owners_.pop_back();
+    ids_.pop_back();
+    shadows_.pop_back();
+    entry.index = NOT_PACKED;
+}
+
+void RenderLightRegistry::update_main_light() {
+    Component* main = directionals_.empty() ? nullptr : directionals_.front();
+    if (main != main_owner_) {
+        // The previous main light, if still registered, is shaded like any other directional light
+        if (main_owner_) pack(main_owner_, entries_.find(main_owner_)->second);
+        if (main) unpack(entries_.find(main)->second);
+        main_owner_ = main;
+    }
+}
+
+void RenderLightRegistry::update_stats() {
+    stats_.light_count = static_cast<uint32_t>(lights_.size());
+    stats_.directional_count = static_cast<uint32_t>(directionals_.size());
+    stats_.revision = revision_;
+}
@@ -0,0 +1,115 @@
+#pragma once
+
+#include "engine/function/render/render_pass/deferred_lighting_pass.h"
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+class Component;
+
+/**
+ * @brief Everything the renderer needs of one light component
+ */
+struct RenderLightDesc {
+    render::ShaderLightData data = {};
+    bool cast_shadow = false;
+    float cascade_split = 0.95f;    // Directional lights: practical split lambda of the shadow cascades
+
+    bool operator==(const RenderLightDesc& other) const;
+    bool operator!=(const RenderLightDesc& other) const { return !(*this == other); }
+};
+
+struct RenderLightStats {
+    uint32_t light_count = 0;       // Packed lights, the main light excluded
+    uint32_t directional_count = 0;
+    uint32_t changed = 0;           // set_light calls since the last reset_stats
+    uint32_t removed = 0;
+    uint64_t revision = 0;
+};
+
+/**
+ * @brief Registry of enabled light components and their packed, GPU-ready light array
+ *
+ * Light components register on their first update and push a new RenderLightDesc only when their
+ * transform or properties changed; disabled or destroyed lights remove themselves. The packed array
+ * is edited in place (removal moves the last light into the hole), so a frame without light changes
+ * costs nothing here and the revision tells consumers whether to copy or upload it again.
+ *
+ * The first registered directional light is the main light. It is shaded from the per-frame
+ * constants and drives the shadow cascades, so it is kept out of the packed array.
+ * Game thread only; the render thread reads the copy in the scene snapshot.
+ */
+class RenderLightRegistry {
+public:
+    /**
+     * @brief Add owner's light, or replace its description
+     */
+    void set_light(Component* owner, const RenderLightDesc& desc);
+    void remove(Component* owner);
+    bool contains(const Component* owner) const { return entries_.count(owner) != 0; }
+
+    /**
+     * @brief Packed lights in ShaderLightData layout; every light but the main light
+     */
+    inline const std::vector<render::ShaderLightData>& get_lights() const { return lights_; }
+
+    /**
+     * @brief Owner of each packed light
+     */
+    inline const std::vector<Component*>& get_owners() const { return owners_; }
+
+    /**
+     * @brief Id of each packed light; assigned on registration, never reused
+     */
+    inline const std::vector<uint32_t>& get_light_ids() const { return ids_; }
+
+    /**
+     * @brief cast_shadow of each packed light, 0 or 1
+     */
+    inline const std::vector<uint8_t>& get_shadow_flags() const { return shadows_; }
+
+    /**
+     * @brief Main directional light, nullptr if no directional light is registered
+     */
+    const RenderLightDesc* get_main_light() const;
+    inline Component* get_main_light_owner() const { return main_owner_; }
+
+    /**
+     * @brief Incremented by every change; equal revisions mean equal contents
+     */
+    inline uint64_t get_revision() const { return revision_; }
+
+    inline uint32_t size() const { return static_cast<uint32_t>(entries_.size()); }
+    inline const RenderLightStats& get_stats() const { return stats_; }
+    void reset_stats();
+
+    /**
+     * @brief Drop all lights; the revision keeps counting
+     */
+    void clear();
+
+private:
+    static constexpr uint32_t NOT_PACKED = UINT32_MAX;
+
+    struct Entry {
+        RenderLightDesc desc;
+        uint32_t index = NOT_PACKED;    // Slot in lights_; the main light has none
+        uint32_t id = 0;
+    };
+
+    void pack(Component* owner, Entry& entry);
+    void unpack(Entry& entry);
+    void update_main_light();
+    void update_stats();
+
+    std::unordered_map<const Component*, Entry> entries_;
+    std::vector<render::ShaderLightData> lights_;
+    std::vector<Component*> owners_;
+    std::vector<uint32_t> ids_;
+    std::vector<uint8_t> shadows_;
+    std::vector<Component*> directionals_;  // In registration order
+    Component* main_owner_ = nullptr;
+    uint64_t revision_ = 0;
+    uint32_t next_id_ = 1;
+    RenderLightStats stats_;
+};
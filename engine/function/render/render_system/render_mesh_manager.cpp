@@ -1,10 +1,7 @@
 #include "engine/function/render/render_system/render_mesh_manager.h"
 #include "engine/function/framework/component/mesh_renderer_component.h"
 #include "engine/function/framework/component/camera_component.h"
-#include "engine/function/framework/component/directional_light_component.h"
-#include "engine/function/framework/component/point_light_component.h"
 #include "engine/function/framework/component/transform_component.h"
-#include "engine/function/framework/world.h"
 #include "engine/main/engine_context.h"
 #include "engine/function/render/render_system/render_system.h"
 #include "engine/function/render/render_pass/forward_pass.h"
@@ -12,10 +9,17 @@
 #include "engine/function/render/render_pass/g_buffer_pass.h"
 #include "engine/function/render/render_pass/deferred_lighting_pass.h"
 #include "engine/function/render/render_resource/material.h"
+#include "engine/function/render/render_resource/mesh.h"
+#include "engine/function/render/render_resource/render_resource_manager.h"
 #include "engine/function/render/graph/rdg_builder.h"
 #include "engine/function/render/rhi/rhi_command_list.h"
 #include "engine/core/log/Log.h"
+#include "engine/core/os/thread_pool.h"
+#include "engine/core/utils/profiler.h"
+#include <algorithm>
+#include <cmath>
 #include <iostream>
+#include <numeric>
 
 DEFINE_LOG_TAG(LogRenderMeshManager, "RenderMeshManager");
 
@@ -41,7 +45,9 @@ void RenderMeshManager::init() {
 void RenderMeshManager::destroy() {
     INFO(LogRenderMeshManager, "Destroying RenderMeshManager...");
     
-    mesh_renderers_.clear();
+    proxy_scene_.clear();
+    spatial_tree_.clear();
+    spatial_proxies_.clear();
     forward_pass_.reset();
     npr_forward_pass_.reset();
 
@@ -54,39 +60,21 @@ void RenderMeshManager::destroy() {
 
 void RenderMeshManager::tick() {
     if (!initialized_) return;
-    
-    if (!active_camera_) {
-        auto* world = EngineContext::world();
-        if (world) {
-            active_camera_ = world->get_active_camera();
-        }
-    }
-    
-    if (active_camera_) {
-        active_camera_->update_camera_info();
-    }
-    
+    collect_stats_.collect_count = 0;
     prepare_mesh_pass();
 }
 
-void RenderMeshManager::register_mesh_renderer(MeshRendererComponent* component) {
-    if (!component) return;
-    
-    auto it = std::find(mesh_renderers_.begin(), mesh_renderers_.end(), component);
-    if (it == mesh_renderers_.end()) {
-        mesh_renderers_.push_back(component);
-        INFO(LogRenderMeshManager, "Registered mesh renderer, total: {}", mesh_renderers_.size());
-    }
-}
-
-void RenderMeshManager::unregister_mesh_renderer(MeshRendererComponent* component) {
-    if (!component) return;
-    
-    auto it = std::find(mesh_renderers_.begin(), mesh_renderers_.end(), component);
-    if (it != mesh_renderers_.end()) {
-        mesh_renderers_.erase(it);
-        INFO(LogRenderMeshManager, "Unregistered mesh renderer, total: {}", mesh_renderers_.size());
-    }
+render::InstancingStats RenderMeshManager::get_instancing_stats() const {
+    render::InstancingStats total;
+    auto add = [&total](const render::InstancingStats& stats) {
+        total.batch_count += stats.batch_count;
+        total.draw_count += stats.draw_count;
+        total.submit_count += stats.submit_count;
+        total.submit_ms += stats.submit_ms;
+    };
+    if (g_buffer_pass_) add(g_buffer_pass_->get_instancing_stats());
+    if (npr_forward_pass_) add(npr_forward_pass_->get_instancing_stats());
+    return total;
 }
 
 void RenderMeshManager::set_wireframe(bool enable) {
@@ -104,46 +92,309 @@ void RenderMeshManager::prepare_mesh_pass() {
 }
 
 void RenderMeshManager::collect_draw_batches(std::vector<render::DrawBatch>& batches) {
+    PROFILE_SCOPE("RenderMeshManager_CollectDrawBatches");
+    collect_timer_.reset();
     batches.clear();
-    
-    auto* world = EngineContext::world();
-    if (world && world->get_active_scene()) {
-        auto world_renderers = world->get_mesh_renderers();
-        for (auto* renderer : world_renderers) {
-            if (renderer) {
-                renderer->collect_draw_batch(batches);
-            }
+
+    // Only renderers that changed since the last frame cost anything here. With a snapshot, apply
+    // exactly the changes of the game frame it was extracted from.
+    proxy_scene_.update(scene_ ? scene_->proxy_batch : RenderProxyScene::ALL_CHANGES);
+    update_spatial_proxies();
+    update_object_table();
+    if (shadow_cascades_enabled_ && scene_ && scene_->camera.valid && scene_->main_light_cast_shadow) update_shadow_cascades();
+    if (shadow_atlas_enabled_ && scene_ && scene_->camera.valid) update_shadow_atlas();
+
+    if (frustum_culling_enabled_ && scene_ && scene_->camera.valid) {
+        PROFILE_SCOPE("RenderMeshManager_FrustumCull");
+        frustum_culler_.cull(scene_->camera.frustum, proxy_scene_.get_bounds(), visible_indices_, EngineContext::thread_pool());
+    } else {
+        visible_indices_.resize(proxy_scene_.size());
+        std::iota(visible_indices_.begin(), visible_indices_.end(), 0u);
+    }
+
+    // Independent of the frustum culling toggle. Before the mesh passes build their draw lists,
+    // so occluded objects never reach them.
+    if (occlusion_culling_enabled_ && scene_ && scene_->camera.valid) {
+        PROFILE_SCOPE("RenderMeshManager_OcclusionCull");
+        select_occluders();
+        occlusion_culler_.render_occluders(scene_->camera.view * scene_->camera.projection, occluders_,
+                                           EngineContext::thread_pool());
+        occlusion_culler_.cull(proxy_scene_.get_bounds(), visible_indices_, EngineContext::thread_pool());
+    }
+
+    proxy_scene_.build_batches(visible_indices_, batches);
+    if (lod_enabled_ && scene_ && scene_->camera.valid) select_lods(batches);
+    if (cluster_culling_enabled_ && scene_ && scene_->camera.valid) cull_clusters(batches);
+    select_prepass(batches);
+
+    collect_stats_.proxy_count = proxy_scene_.size();
+    collect_stats_.batch_count = static_cast<uint32_t>(batches.size());
+    collect_stats_.collect_count++;
+    collect_stats_.collect_ms = collect_timer_.get_total_ms();
+}
+
+void RenderMeshManager::update_shadow_cascades() {
+    PROFILE_SCOPE("RenderMeshManager_ShadowCascades");
+    const RenderCameraSnapshot& camera = scene_->camera;
+    shadow_cascades_.update(camera.view, camera.projection, camera.near_plane, camera.far_plane,
+                            scene_->main_light_direction, scene_->main_light_cascade_split);
+
+    // Casting shadows is a material setting; proxies without a material cast
+    shadow_caster_mask_.resize(proxy_scene_.size());
+    for (uint32_t i = 0; i < proxy_scene_.size(); ++i) {
+        const MaterialRef& material = proxy_scene_.get_material(i);
+        shadow_caster_mask_[i] = !material || material->cast_shadow();
+    }
+    shadow_cascades_.cull_casters(proxy_scene_.get_bounds(), shadow_caster_mask_, EngineContext::thread_pool());
+
+    auto render_resource = EngineContext::render_resource();
+    if (!render_resource) return;
+    for (uint32_t c = 0; c < shadow_cascades_.get_cascade_count(); ++c) {
+        const ShadowCascade& cascade = shadow_cascades_.get_cascade(c);
+        DirectionalLightInfo info = {};
+        info.view = cascade.view;
+        info.proj = cascade.proj;
+        info.pos = cascade.eye;
+        info.dir = scene_->main_light_direction.normalized();
+        info.depth = cascade.split_far;
+        info.color = scene_->main_light_color;
+        info.intensity = scene_->main_light_intensity;
+        info.cast_shadow = 1;
+        info.frustum = cascade.caster_frustum;
+        info.sphere = cascade.sphere;
+        render_resource->set_directional_light_info(info, c);
+    }
+}
+
+void RenderMeshManager::update_shadow_atlas() {
+    PROFILE_SCOPE("RenderMeshManager_ShadowAtlas");
+    shadow_requests_.clear();
+    for (uint32_t i = 0; i < scene_->lights.size(); ++i) {
+        const render::ShaderLightData& light = scene_->lights[i];
+        if (!scene_->light_cast_shadow[i] || light.type == static_cast<uint32_t>(render::LightType::Directional)) continue;
+        shadow_requests_.push_back({scene_->light_ids[i], light});
+    }
+    const RenderCameraSnapshot& camera = scene_->camera;
+    shadow_atlas_.update(shadow_requests_, camera.frustum, camera.position, camera.projection.m[1][1]);
+}
+
+void RenderMeshManager::select_prepass(const std::vector<render::DrawBatch>& batches) {
+    PROFILE_SCOPE("RenderMeshManager_SelectPrepass");
+    if (!prepass_selection_enabled_ || !scene_ || !scene_->camera.valid) {
+        prepass_batches_ = batches;
+        return;
+    }
+
+    prepass_opaque_.resize(batches.size());
+    for (uint32_t i = 0; i < batches.size(); ++i) {
+        const MaterialRef& material = batches[i].material;
+        prepass_opaque_[i] = !material || !(material->render_pass_mask() & PASS_MASK_TRANSPARENT_PASS);
+    }
+    const RenderCameraSnapshot& camera = scene_->camera;
+    prepass_selector_.select(batches, prepass_opaque_, camera.view, camera.projection, camera.near_plane, prepass_indices_);
+
+    prepass_batches_.clear();
+    for (uint32_t index : prepass_indices_) prepass_batches_.push_back(batches[index]);
+}
+
+void RenderMeshManager::cull_clusters(std::vector<render::DrawBatch>& batches) {
+    PROFILE_SCOPE("RenderMeshManager_ClusterCull");
+    const RenderCameraSnapshot& camera = scene_->camera;
+    Mat4 view_proj = camera.view * camera.projection;
+
+    cluster_culler_.begin_frame();
+    cluster_batches_.clear();
+    for (uint32_t i = 0; i < batches.size(); ++i) {
+        render::DrawBatch& batch = batches[i];
+        const auto& mesh = proxy_scene_.get_mesh(visible_indices_[i]);
+
+        // Clusters cover LOD 0; coarser levels and proxies drawing part of a mesh go through whole
+        if (!mesh || mesh->get_clusters().empty() || batch.index_offset != 0 || batch.index_count != mesh->get_index_count()) {
+            cluster_batches_.push_back(std::move(batch));
+            continue;
+        }
+
+        // Only the GBuffer pipeline culls back faces; NPR draws both sides
+        uint32_t mask = batch.material ? batch.material->render_pass_mask() : 0;
+        bool backface = (mask & PASS_MASK_DEFERRED_PASS) && !(mask & PASS_MASK_NPR_FORWARD);
+
+        cluster_ranges_.clear();
+        cluster_culler_.cull(view_proj, camera.position, batch.model_matrix, batch.inv_model_matrix,
+                             mesh->get_clusters(), backface, cluster_ranges_);
+        for (const ClusterDrawRange& range : cluster_ranges_) {
+            render::DrawBatch& visible = cluster_batches_.emplace_back(batch);
+            visible.index_offset = range.index_offset;
+            visible.index_count = range.index_count;
         }
     }
-    
-    for (auto* renderer : mesh_renderers_) {
-        if (!renderer) continue;
-        
-        bool already_added = false;
-        if (world && world->get_active_scene()) {
-            for (auto* world_renderer : world->get_mesh_renderers()) {
-                if (world_renderer == renderer) {
-                    already_added = true;
-                    break;
-                }
-            }
+    cluster_culler_.end_frame();
+    batches.swap(cluster_batches_);
+}
+
+void RenderMeshManager::select_lods(std::vector<render::DrawBatch>& batches) {
+    PROFILE_SCOPE("RenderMeshManager_SelectLods");
+    lod_selector_.begin_frame(scene_->camera.position, scene_->camera.projection.m[1][1]);
+    for (uint32_t i = 0; i < batches.size(); ++i) {
+        uint32_t index = visible_indices_[i];
+        const auto& mesh = proxy_scene_.get_mesh(index);
+
+        // Levels index the mesh buffer, so they only replace a proxy that draws the whole of LOD 0
+        const std::vector<MeshLod>* lods = &single_lod_;
+        if (mesh && proxy_scene_.get_index_offset(index) == 0 &&
+            proxy_scene_.get_index_count(index) == mesh->get_lods()[0].index_count) {
+            lods = &mesh->get_lods();
+        } else {
+            single_lod_[0].index_offset = batches[i].index_offset;
+            single_lod_[0].index_count = batches[i].index_count;
         }
-        
-        if (!already_added) {
-            renderer->collect_draw_batch(batches);
+
+        uint8_t level = static_cast<uint8_t>(proxy_scene_.get_lod_level(index));
+        uint32_t selected = lod_selector_.select(batches[i].world_sphere, *lods, level);
+        proxy_scene_.set_lod_level(index, selected);
+        batches[i].index_offset = (*lods)[selected].index_offset;
+        batches[i].index_count = (*lods)[selected].index_count;
+    }
+    lod_selector_.end_frame();
+}
+
+void RenderMeshManager::select_occluders() {
+    occluders_.clear();
+    occluder_candidates_.clear();
+
+    const CullingBounds& bounds = proxy_scene_.get_bounds();
+    const Vec3& eye = scene_->camera.position;
+    for (uint32_t index : visible_indices_) {
+        const auto& mesh = proxy_scene_.get_mesh(index);
+        if (!mesh || proxy_scene_.get_index_count(index) > MAX_OCCLUDER_TRIANGLES * 3) continue;
+
+        // Transparent and alpha-tested surfaces do not hide what is behind them
+        const MaterialRef& material = proxy_scene_.get_material(index);
+        if (!material || (material->render_pass_mask() & PASS_MASK_TRANSPARENT_PASS)) continue;
+        if (auto* pbr = dynamic_cast<const PBRMaterial*>(material.get()); pbr && pbr->get_alpha_clip() > 0.0f) continue;
+        if (auto* npr = dynamic_cast<const NPRMaterial*>(material.get()); npr && npr->get_alpha_clip() > 0.0f) continue;
+
+        float dx = bounds.center_x[index] - eye.x;
+        float dy = bounds.center_y[index] - eye.y;
+        float dz = bounds.center_z[index] - eye.z;
+        float size = bounds.radius[index] / (std::max)(std::sqrt(dx * dx + dy * dy + dz * dz), 1e-4f);
+        if (size >= OCCLUDER_MIN_SIZE) occluder_candidates_.emplace_back(size, index);
+    }
+
+    // Largest first; ties by proxy index so the selection does not depend on the visible order
+    std::sort(occluder_candidates_.begin(), occluder_candidates_.end(),
+              [](const auto& a, const auto& b) { return a.first != b.first ? a.first > b.first : a.second < b.second; });
+
+    uint32_t triangles = 0;
+    for (const auto& [size, index] : occluder_candidates_) {
+        if (occluders_.size() == MAX_OCCLUDERS) break;
+        const Mesh& mesh = *proxy_scene_.get_mesh(index);
+        uint32_t offset = proxy_scene_.get_index_offset(index);
+        uint32_t index_count = proxy_scene_.get_index_count(index);
+        if (offset + index_count > mesh.get_index_count()) continue;
+        if (triangles + index_count / 3 > OCCLUDER_TRIANGLE_BUDGET) continue;  // A smaller one may still fit
+        triangles += index_count / 3;
+
+        OccluderMesh occluder;
+        occluder.positions = mesh.get_positions().data();
+        occluder.vertex_count = mesh.get_vertex_count();
+        occluder.indices = mesh.get_indices().data() + offset;
+        occluder.index_count = index_count;
+        occluder.world = proxy_scene_.get_model(index);
+        occluders_.push_back(occluder);
+    }
+}
+
+void RenderMeshManager::update_spatial_proxies() {
+    const auto& changed = proxy_scene_.get_changed_owners();
+    const auto& removed = proxy_scene_.get_removed_owners();
+    if (changed.empty() && removed.empty()) return;
+
+    // Shadow tiles that saw a caster where it was or where it is now are rendered again
+    for (auto* renderer : removed) {
+        auto it = spatial_proxies_.find(renderer);
+        if (it == spatial_proxies_.end()) continue;
+        shadow_atlas_.invalidate(spatial_tree_.get_fat_box(it->second));
+        spatial_tree_.destroy_proxy(it->second);
+        spatial_proxies_.erase(it);
+    }
+    for (auto* renderer : changed) {
+        BoundingBox box = proxy_scene_.get_owner_bounds(renderer);
+        auto [it, inserted] = spatial_proxies_.try_emplace(renderer, DynamicAABBTree::NULL_NODE);
+        if (inserted) {
+            it->second = spatial_tree_.create_proxy(box, renderer);
+        } else {
+            shadow_atlas_.invalidate(spatial_tree_.get_fat_box(it->second));
+            spatial_tree_.move_proxy(it->second, box);
         }
+        shadow_atlas_.invalidate(box);
+    }
+
+    if (++spatial_update_id_ % SPATIAL_REBALANCE_INTERVAL == 0) {
+        spatial_tree_.rebalance();
     }
 }
 
+void RenderMeshManager::update_object_table() {
+    auto render_resource = EngineContext::render_resource();
+    auto backend = EngineContext::rhi();
+    if (!render_resource || !backend) return;
+    GPUObjectTable& table = render_resource->get_object_table();
+    if (table.get_capacity() == 0) return;
+
+    // Objects that moved last frame: prev_model catches up with model
+    for (uint32_t object_id : moving_objects_) {
+        ObjectInfo info = table.get(object_id);
+        if (info.prev_model == info.model) continue;
+        info.prev_model = info.model;
+        table.set(object_id, info);
+    }
+    moving_objects_.clear();
+
+    // Freed slots are cleared, so an object that reuses one starts without motion history
+    for (uint32_t object_id : proxy_scene_.get_removed_object_ids()) {
+        if (object_id != 0) table.set(object_id, ObjectInfo{});
+    }
+
+    for (auto* renderer : proxy_scene_.get_changed_owners()) {
+        for (uint32_t index : proxy_scene_.get_owner_proxies(renderer)) {
+            uint32_t object_id = proxy_scene_.get_object_id(index);
+            if (object_id == 0) continue;
+
+            ObjectInfo info;
+            proxy_scene_.build_object_info(index, info);
+            const Mat4& prev_model = table.get(object_id).model;
+            if (prev_model.m[3][3] != 0.0f && prev_model != info.model) {
+                info.prev_model = prev_model;
+                moving_objects_.push_back(object_id);
+            }
+            table.set(object_id, info);
+        }
+    }
+
+    // Static objects were uploaded when they last changed; only dirty pages go up
+    if (table.has_dirty_pages()) object_table_stats_ = table.upload(*backend);
+}
+
 void RenderMeshManager::cleanup_for_test() {
-    // Clear registered mesh renderers
-    mesh_renderers_.clear();
-    
+    // Drop render proxies of the previous test scene
+    proxy_scene_.clear();
+
     // Clear current batches
     current_batches_.clear();
+    prepass_batches_.clear();
+    collect_stats_ = DrawCollectStats{};
+    light_revision_ = UINT64_MAX;
+    shadow_atlas_.init(ShadowAtlas::DEFAULT_ATLAS_SIZE, ShadowAtlas::DEFAULT_MIN_TILE_SIZE,
+                       ShadowAtlas::DEFAULT_MAX_TILE_SIZE);
+
+    spatial_tree_.clear();
+    spatial_proxies_.clear();
+    moving_objects_.clear();
+    occluders_.clear();
     
     // Reset active camera
     active_camera_ = nullptr;
+    scene_ = nullptr;
     
 
 }
@@ -153,79 +404,40 @@ void RenderMeshManager::build_rdg(RDGBuilder& builder, RDGTextureHandle color_ta
                                    bool enable_pbr, bool enable_npr) {
     if (!initialized_) return;
     
-    if (!active_camera_) {
+    if (!scene_ || !scene_->camera.valid) {
         WARN(LogRenderMeshManager, "No active camera, skipping RDG build");
         return;
     }
-    
-    Vec3 light_dir = Vec3(0.0f, -1.0f, 0.0f);
-    Vec3 light_color = Vec3(1.0f, 1.0f, 1.0f);
-    float light_intensity = 1.0f;
-    std::vector<render::ShaderLightData> additional_lights;
-    
-    auto* world = EngineContext::world();
-    if (world && world->get_active_scene()) {
-        bool main_light_found = false;
-        for (auto& entity : world->get_active_scene()->entities_) {
-            if (!entity) continue;
-            
-            // Directional lights
-            auto* dir_light = entity->get_component<DirectionalLightComponent>();
-            if (dir_light && dir_light->enable()) {
-                auto* transform = entity->get_component<TransformComponent>();
-                Vec3 dir = Vec3(0.0f, -1.0f, 0.0f);
-                if (transform) {
-                    dir = transform->transform.front();
-                }
-                
-                if (!main_light_found) {
-                    // First directional light → main light in cbuffer
-                    light_dir = dir;
-                    light_color = dir_light->get_color();
-                    light_intensity = dir_light->get_intensity();
-                    main_light_found = true;
-                } else {
-                    // Extra directional lights → light buffer
-                    render::ShaderLightData ld = {};
-                    ld.direction = dir;
-                    ld.color = dir_light->get_color();
-                    ld.intensity = dir_light->get_intensity();
-                    ld.type = static_cast<uint32_t>(render::LightType::Directional);
-                    additional_lights.push_back(ld);
-                }
-                continue;
-            }
-            
-            // Point lights
-            auto* pt_light = entity->get_component<PointLightComponent>();
-            if (pt_light && pt_light->enable()) {
-                auto* transform = entity->get_component<TransformComponent>();
-                render::ShaderLightData ld = {};
-                ld.position = transform ? transform->get_world_position() : Vec3::Zero();
-                ld.color = pt_light->get_color();
-                ld.intensity = pt_light->get_intensity();
-                ld.type = static_cast<uint32_t>(render::LightType::Point);
-                ld.range = 25.0f; // default range
-                additional_lights.push_back(ld);
-            }
-        }
-    }
+    const RenderCameraSnapshot& camera = scene_->camera;
     
     std::vector<render::DrawBatch> npr_batches;
     std::vector<render::DrawBatch> pbr_batches;
     std::vector<render::DrawBatch> forward_batches;
     
-    for (const auto& batch : current_batches_) {
+    npr_indices_.clear();
+    pbr_indices_.clear();
+    for (uint32_t i = 0; i < current_batches_.size(); ++i) {
+        const auto& batch = current_batches_[i];
         if (batch.material) {
             auto mask = batch.material->render_pass_mask();
             if (mask & PASS_MASK_NPR_FORWARD) {
-                npr_batches.push_back(batch);
+                npr_indices_.push_back(i);
             } 
             else if (mask & PASS_MASK_DEFERRED_PASS) {
-                pbr_batches.push_back(batch);
+                pbr_indices_.push_back(i);
             } 
         }
     }
+
+    // Group draws by state and order them front to back (transparent: back to front)
+    DrawSortView sort_view;
+    sort_view.position = camera.position;
+    sort_view.front = camera.front;
+    sort_view.near_plane = camera.near_plane;
+    sort_view.far_plane = camera.far_plane;
+    draw_sorter_.begin_frame();
+    draw_sorter_.sort(DrawSortPass::NPRForward, current_batches_, npr_indices_, sort_view, npr_batches);
+    draw_sorter_.sort(DrawSortPass::GBuffer, current_batches_, pbr_indices_, sort_view, pbr_batches);
     
     // Determine if we need depth prepass (any opaque objects to render)
     bool has_opaque_objects = !pbr_batches.empty() || !npr_batches.empty();
@@ -244,37 +456,50 @@ void RenderMeshManager::build_rdg(RDGBuilder& builder, RDGTextureHandle color_ta
             .finish();
     }
     
+    // Rasterization uses the jittered projection; motion vectors are measured without the jitter
+    const Mat4& projection = temporal_view_ ? temporal_view_->projection : camera.projection;
+
     // Deferred rendering path: GBufferPass -> DeferredLightingPass
     if (enable_pbr && !pbr_batches.empty() && g_buffer_pass_ && g_buffer_pass_->is_ready() && 
         deferred_lighting_pass_ && deferred_lighting_pass_->is_ready()) {
         
         // G-Buffer Pass (reads depth from prepass, writes gbuffer)
-        g_buffer_pass_->set_per_frame_data(
-            active_camera_->get_view_matrix(),
-            active_camera_->get_projection_matrix(),
-            active_camera_->get_position()
-        );
-        g_buffer_pass_->build(builder, depth_handle.value(), pbr_batches);
+        g_buffer_pass_->set_per_frame_data(camera.view, projection, camera.position);
+        if (temporal_view_) {
+            g_buffer_pass_->set_temporal_data(temporal_view_->prev_view_projection, temporal_view_->jitter_ndc);
+        } else {
+            g_buffer_pass_->set_temporal_data(camera.view * camera.projection, Vec2::Zero());
+        }
+        std::optional<render::GBufferOutputHandles> gbuffer = g_buffer_pass_->build(builder, depth_handle.value(), pbr_batches);
         
-        // Deferred Lighting Pass (reads gbuffer, writes to color_target)
-        deferred_lighting_pass_->set_per_frame_data(
-            active_camera_->get_position(),
-            (active_camera_->get_view_matrix() * active_camera_->get_projection_matrix()).inverse()
-        );
-        deferred_lighting_pass_->set_main_light(light_dir, light_color, light_intensity);
-        deferred_lighting_pass_->set_lights(additional_lights);
-        deferred_lighting_pass_->build(builder, color_target);  // Auto-gets gbuffer from blackboard
+        // Deferred Lighting Pass (reads gbuffer and depth, writes to color_target)
+        deferred_lighting_pass_->set_per_frame_data(camera.position, (camera.view * projection).inverse());
+        deferred_lighting_pass_->set_main_light(scene_->main_light_direction, scene_->main_light_color,
+                                                scene_->main_light_intensity);
+        // The light buffer is only uploaded again when a light changed
+        if (scene_->light_revision != light_revision_) {
+            deferred_lighting_pass_->set_lights(scene_->lights);
+            light_revision_ = scene_->light_revision;
+        }
+
+        // Each pixel only shades the lights listed for its cluster
+        light_clusters_.build(camera.view, camera.projection, camera.near_plane, camera.far_plane,
+                              scene_->lights, EngineContext::thread_pool());
+        deferred_lighting_pass_->set_light_clusters(camera.view, &light_clusters_);
+        if (gbuffer) {
+            deferred_lighting_pass_->build(builder, color_target, gbuffer.value());
+        }
     }
     
     // NPR Forward rendering path
     if (enable_npr && !npr_batches.empty() && npr_forward_pass_ && npr_forward_pass_->is_ready()) {
         npr_forward_pass_->set_per_frame_data(
-            active_camera_->get_view_matrix(),
-            active_camera_->get_projection_matrix(),
-            active_camera_->get_position(),
-            light_dir,
-            light_color,
-            light_intensity
+            camera.view,
+            projection,
+            camera.position,
+            scene_->main_light_direction,
+            scene_->main_light_color,
+            scene_->main_light_intensity
         );
         npr_forward_pass_->build(builder, color_target, depth_handle.value(), npr_batches);
     }
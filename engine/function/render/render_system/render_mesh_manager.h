@@ -5,9 +5,25 @@
 #include "engine/function/render/render_pass/forward_pass.h"
 #include "engine/function/render/render_pass/npr_forward_pass.h"
 #include "engine/function/render/render_pass/mesh_pass.h"
+#include "engine/function/render/render_system/frustum_culling.h"
+#include "engine/function/render/render_system/occlusion_culling.h"
+#include "engine/function/render/render_system/lod_selection.h"
+#include "engine/function/render/render_system/cluster_culling.h"
+#include "engine/function/render/render_system/dynamic_aabb_tree.h"
+#include "engine/function/render/render_system/draw_sort.h"
+#include "engine/function/render/render_system/light_clustering.h"
+#include "engine/function/render/render_system/shadow_cascades.h"
+#include "engine/function/render/render_system/shadow_atlas.h"
+#include "engine/function/render/render_system/depth_prepass_selection.h"
+#include "engine/function/render/render_system/render_proxy_scene.h"
+#include "engine/function/render/render_system/render_scene_snapshot.h"
+#include "engine/function/render/render_system/temporal_aa.h"
+#include "engine/function/render/render_resource/gpu_object_table.h"
+#include "engine/core/utils/timer.h"
 #include <memory>
 #include <vector>
 #include <optional>
+#include <unordered_map>
 
 // Forward declarations
 class MeshRendererComponent;
@@ -22,12 +38,19 @@ namespace render {
     struct DrawBatch;
 }
 
+struct DrawCollectStats {
+    uint32_t proxy_count = 0;
+    uint32_t batch_count = 0;       // Batches left after culling, LOD and cluster selection
+    uint32_t collect_count = 0;     // Collections this frame; every pass shares the first one
+    float collect_ms = 0.0f;
+};
+
 /**
  * @brief Manages mesh rendering for the engine
  * 
  * RenderMeshManager is responsible for:
  * - Managing render passes (ForwardPass, etc.)
- * - Collecting draw batches from MeshRendererComponents in the scene
+ * - Collecting draw batches from the render proxies of MeshRendererComponents
  * - Building and executing the render graph
  * - Camera management and per-frame data setup
  */
@@ -38,16 +61,19 @@ public:
     void tick();
 
     /**
-     * @brief Register a mesh renderer component for rendering
-     * @param component The component to register
+     * @brief Persistent render proxies; mesh renderers push their changes here
      */
-    void register_mesh_renderer(MeshRendererComponent* component);
+    RenderProxyScene& get_proxy_scene() { return proxy_scene_; }
 
     /**
-     * @brief Unregister a mesh renderer component
-     * @param component The component to unregister
+     * @brief Proxy counts and update cost of the last collect_draw_batches
      */
-    void unregister_mesh_renderer(MeshRendererComponent* component);
+    const RenderProxyStats& get_proxy_stats() const { return proxy_scene_.get_stats(); }
+
+    /**
+     * @brief Objects written to and pages uploaded by the last GPU object table upload
+     */
+    const GPUObjectTableStats& get_object_table_stats() const { return object_table_stats_; }
 
     /**
      * @brief Get the forward pass for configuration
@@ -71,22 +97,179 @@ public:
     void set_wireframe(bool enable);
 
     /**
-     * @brief Set the active camera for rendering
+     * @brief Set the camera rendered when a frame is extracted without one
      * @param camera The active camera component
      */
     void set_active_camera(CameraComponent* camera) { active_camera_ = camera; }
 
     /**
-     * @brief Get the active camera
+     * @brief Get the fallback camera
      */
     CameraComponent* get_active_camera() const { return active_camera_; }
 
     /**
-     * @brief Collect draw batches for rendering
-     * @param batches Output vector to fill with draw batches
+     * @brief Scene snapshot rendered this frame; camera, lights and the proxy batch come from it
+     */
+    void set_scene(const RenderSceneSnapshot* scene) { scene_ = scene; }
+    const RenderSceneSnapshot* get_scene() const { return scene_; }
+
+    /**
+     * @brief Jittered projection and previous view-projection for this frame's main passes
+     *
+     * Culling, LOD and light clusters keep the snapshot's unjittered camera. Null renders without jitter
+     * or motion vectors.
+     */
+    void set_temporal_view(const TemporalAAView* view) { temporal_view_ = view; }
+
+    /**
+     * @brief Apply pending proxy changes and collect draw batches for rendering
+     *
+     * tick() runs this once per frame into get_frame_batches(). Passes read that list instead of
+     * collecting again: a second run repeats culling and LOD selection and advances the motion
+     * history of the object table.
+     * @param batches Output vector to fill with draw batches visible from the active camera
      */
     void collect_draw_batches(std::vector<render::DrawBatch>& batches);
 
+    /**
+     * @brief Draw batches collected by tick() for the current frame, shared by every pass
+     */
+    const std::vector<render::DrawBatch>& get_frame_batches() const { return current_batches_; }
+
+    /**
+     * @brief Batches, collections and cost of draw batch collection in the current frame
+     */
+    const DrawCollectStats& get_collect_stats() const { return collect_stats_; }
+
+    /**
+     * @brief Enable or disable frustum culling of collected draw batches
+     */
+    void set_frustum_culling(bool enable) { frustum_culling_enabled_ = enable; }
+    bool is_frustum_culling_enabled() const { return frustum_culling_enabled_; }
+
+    /**
+     * @brief Visibility stats of the last frustum culling run
+     */
+    const FrustumCullingStats& get_culling_stats() const { return frustum_culler_.get_last_stats(); }
+
+    /**
+     * @brief Enable or disable software occlusion culling. Runs after frustum culling, with or without it
+     */
+    void set_occlusion_culling(bool enable) { occlusion_culling_enabled_ = enable; }
+    bool is_occlusion_culling_enabled() const { return occlusion_culling_enabled_; }
+
+    /**
+     * @brief Occluders, occluded objects and cost of the last occlusion culling run
+     */
+    const OcclusionCullingStats& get_occlusion_stats() const { return occlusion_culler_.get_last_stats(); }
+
+    /**
+     * @brief CPU depth buffer of the last occlusion culling run, for debugging
+     */
+    const OcclusionCuller& get_occlusion_culler() const { return occlusion_culler_; }
+
+    /**
+     * @brief Enable or disable screen-size LOD selection; disabled draws every mesh at LOD 0
+     */
+    void set_lod_selection(bool enable) { lod_enabled_ = enable; }
+    bool is_lod_selection_enabled() const { return lod_enabled_; }
+
+    /**
+     * @brief LOD selector of the main view, for the bias and hysteresis
+     */
+    LodSelector& get_lod_selector() { return lod_selector_; }
+
+    /**
+     * @brief Objects per level and triangles drawn vs. at full detail in the last selection
+     */
+    const LodSelectionStats& get_lod_stats() const { return lod_selector_.get_last_stats(); }
+
+    /**
+     * @brief Enable or disable frustum and normal cone culling of the clusters of LOD 0 batches
+     */
+    void set_cluster_culling(bool enable) { cluster_culling_enabled_ = enable; }
+    bool is_cluster_culling_enabled() const { return cluster_culling_enabled_; }
+
+    /**
+     * @brief Clusters and triangles rejected and index ranges emitted by the last cluster culling run
+     */
+    const ClusterCullingStats& get_cluster_culling_stats() const { return cluster_culler_.get_last_stats(); }
+
+    /**
+     * @brief Enable or disable fitting the main light's shadow cascades and culling their casters
+     */
+    void set_shadow_cascades(bool enable) { shadow_cascades_enabled_ = enable; }
+    bool is_shadow_cascades_enabled() const { return shadow_cascades_enabled_; }
+
+    /**
+     * @brief Cascades and per-cascade caster lists of the main directional light
+     */
+    const ShadowCascadeBuilder& get_shadow_cascades() const { return shadow_cascades_; }
+
+    /**
+     * @brief Casters per cascade, splits and cost of the last cascade update
+     */
+    const ShadowCascadeStats& get_shadow_cascade_stats() const { return shadow_cascades_.get_last_stats(); }
+
+    /**
+     * @brief Enable or disable placing shadowed point and spot lights in the shadow atlas
+     */
+    void set_shadow_atlas(bool enable) { shadow_atlas_enabled_ = enable; }
+    bool is_shadow_atlas_enabled() const { return shadow_atlas_enabled_; }
+
+    /**
+     * @brief Atlas tiles, face matrices and this frame's face updates of point and spot light shadows
+     */
+    const ShadowAtlas& get_shadow_atlas() const { return shadow_atlas_; }
+
+    /**
+     * @brief Occupancy, cached and updated faces and cost of the last atlas update
+     */
+    const ShadowAtlasStats& get_shadow_atlas_stats() const { return shadow_atlas_.get_last_stats(); }
+
+    /**
+     * @brief Enable or disable choosing the depth prepass draws by screen coverage; disabled, every batch is prepassed
+     */
+    void set_prepass_selection(bool enable) { prepass_selection_enabled_ = enable; }
+    bool is_prepass_selection_enabled() const { return prepass_selection_enabled_; }
+
+    /**
+     * @brief Selector of the depth prepass draws, e.g. to change its triangle budget
+     */
+    DepthPrepassSelector& get_prepass_selector() { return prepass_selector_; }
+
+    /**
+     * @brief Batches the depth prepass draws this frame, front to back; a subset of get_frame_batches()
+     */
+    const std::vector<render::DrawBatch>& get_prepass_batches() const { return prepass_batches_; }
+
+    /**
+     * @brief Candidates, selected draws and triangles, and cost of the last prepass selection
+     */
+    const DepthPrepassStats& get_depth_prepass_stats() const { return prepass_selector_.get_last_stats(); }
+
+    /**
+     * @brief Spatial index of mesh renderers, refit while batches are collected
+     *
+     * Proxy user data is the MeshRendererComponent*. Valid until the next collect_draw_batches.
+     */
+    const DynamicAABBTree& get_spatial_tree() const { return spatial_tree_; }
+
+    /**
+     * @brief Sort cost and state changes of the pass draw lists built in the last frame
+     */
+    const DrawSortStats& get_draw_sort_stats() const { return draw_sorter_.get_last_frame_stats(); }
+
+    /**
+     * @brief Batches, instanced draws and submit time of the GBuffer and NPR passes in the last frame
+     */
+    render::InstancingStats get_instancing_stats() const;
+
+    /**
+     * @brief Light counts, list sizes and build time of the last light cluster build
+     */
+    const LightClusterStats& get_light_cluster_stats() const { return light_clusters_.get_last_stats(); }
+
     /**
      * @brief Build RDG for rendering all collected batches
      * @param builder RDG builder
@@ -109,15 +292,79 @@ public:
 
 private:
     void prepare_mesh_pass();
+    void update_spatial_proxies();
+    void update_object_table();
+    void select_occluders();
+    void select_lods(std::vector<render::DrawBatch>& batches);
+    void cull_clusters(std::vector<render::DrawBatch>& batches);
+    void update_shadow_cascades();
+    void update_shadow_atlas();
+    void select_prepass(const std::vector<render::DrawBatch>& batches);
     std::vector<render::DrawBatch> current_batches_;
+    DrawCollectStats collect_stats_;
+    Timer collect_timer_;
+
+    RenderProxyScene proxy_scene_;
+    std::vector<uint32_t> moving_objects_;     // Object ids whose prev_model differs from model
+    GPUObjectTableStats object_table_stats_;
+
+    static constexpr uint32_t SPATIAL_REBALANCE_INTERVAL = 64;   // Updates with changes between area ratio checks
+    DynamicAABBTree spatial_tree_;
+    std::unordered_map<MeshRendererComponent*, int32_t> spatial_proxies_;
+    uint32_t spatial_update_id_ = 0;
+
+    FrustumCuller frustum_culler_;
+    std::vector<uint32_t> visible_indices_;
+    bool frustum_culling_enabled_ = true;
+
+    // Occluders: the largest opaque meshes on screen, small enough to rasterize cheaply
+    static constexpr uint32_t MAX_OCCLUDERS = 32;
+    static constexpr uint32_t MAX_OCCLUDER_TRIANGLES = 4096;    // Per occluder
+    static constexpr uint32_t OCCLUDER_TRIANGLE_BUDGET = 32768; // Per frame
+    static constexpr float OCCLUDER_MIN_SIZE = 0.1f;            // Bounding radius / distance
+    OcclusionCuller occlusion_culler_;
+    std::vector<std::pair<float, uint32_t>> occluder_candidates_;
+    std::vector<OccluderMesh> occluders_;
+    bool occlusion_culling_enabled_ = true;
+
+    LodSelector lod_selector_;
+    std::vector<MeshLod> single_lod_ = std::vector<MeshLod>(1);    // Level list of proxies without mesh LODs
+    bool lod_enabled_ = true;
+
+    ClusterCuller cluster_culler_;
+    std::vector<ClusterDrawRange> cluster_ranges_;
+    std::vector<render::DrawBatch> cluster_batches_;
+    bool cluster_culling_enabled_ = true;
+
+    ShadowCascadeBuilder shadow_cascades_;
+    std::vector<uint8_t> shadow_caster_mask_;   // Per proxy, from the material's cast_shadow
+    bool shadow_cascades_enabled_ = true;
+
+    ShadowAtlas shadow_atlas_;
+    std::vector<ShadowAtlasRequest> shadow_requests_;
+    bool shadow_atlas_enabled_ = true;
+
+    DepthPrepassSelector prepass_selector_;
+    std::vector<uint8_t> prepass_opaque_;       // Per batch, 0 for transparent materials
+    std::vector<uint32_t> prepass_indices_;
+    std::vector<render::DrawBatch> prepass_batches_;
+    bool prepass_selection_enabled_ = true;
+
+    DrawSorter draw_sorter_;
+    std::vector<uint32_t> npr_indices_;
+    std::vector<uint32_t> pbr_indices_;
+
+    LightClusterBuilder light_clusters_;
+    uint64_t light_revision_ = UINT64_MAX;     // Light registry revision last handed to the lighting pass
 
     std::shared_ptr<render::ForwardPass> forward_pass_;
     std::shared_ptr<render::NPRForwardPass> npr_forward_pass_;
     std::shared_ptr<render::GBufferPass> g_buffer_pass_;
     std::shared_ptr<render::DeferredLightingPass> deferred_lighting_pass_;
 
-    std::vector<MeshRendererComponent*> mesh_renderers_;
     CameraComponent* active_camera_ = nullptr;
+    const RenderSceneSnapshot* scene_ = nullptr;
+    const TemporalAAView* temporal_view_ = nullptr;
     
     bool initialized_ = false;
 };
@@ -0,0 +1,302 @@
+#include "engine/function/render/render_system/render_proxy_scene.h"
+#include "engine/function/render/render_resource/material.h"
+#include "engine/core/utils/profiler.h"
+#include "engine/core/utils/timer.h"
+
+#include <algorithm>
+#include <iterator>
+
+RenderProxyScene::PendingChange& RenderProxyScene::pending_for(MeshRendererComponent* owner, ChangeType type) {
+    auto [it, inserted] = pending_index_.try_emplace(owner, static_cast<uint32_t>(pending_.size()));
+    if (inserted) {
+        PendingChange& change = pending_.emplace_back();
+        change.owner = owner;
+        change.type = type;
+        return change;
+    }
+    return pending_[it->second];
+}
+
+void RenderProxyScene::set_proxies(MeshRendererComponent* owner, std::vector<RenderProxyDesc> descs, const Mat4& world) {
+    std::lock_guard lock(pending_mutex_);
+    PendingChange& change = pending_for(owner, ChangeType::Rebuild);
+    change.type = ChangeType::Rebuild;
+    change.world = world;
+    change.descs = std::move(descs);
+}
+
+void RenderProxyScene::set_transform(MeshRendererComponent* owner, const Mat4& world) {
+    std::lock_guard lock(pending_mutex_);
+    PendingChange& change = pending_for(owner, ChangeType::Transform);
+    // A queued rebuild picks up the new matrix, a queued removal stays a removal
+    if (change.type != ChangeType::Remove) change.world = world;
+}
+
+void RenderProxyScene::remove(MeshRendererComponent* owner) {
+    std::lock_guard lock(pending_mutex_);
+    PendingChange& change = pending_for(owner, ChangeType::Remove);
+    change.type = ChangeType::Remove;
+    change.descs.clear();
+}
+
+uint64_t RenderProxyScene::publish() {
+    std::lock_guard lock(pending_mutex_);
+    PublishedChanges& batch = published_.emplace_back();
+    batch.id = ++publish_id_;
+    batch.changes.swap(pending_);
+    pending_index_.clear();
+    return batch.id;
+}
+
+const RenderProxyStats& RenderProxyScene::update(uint64_t up_to) {
+    PROFILE_SCOPE("RenderProxyScene_Update");
+    Timer timer;
+
+    {
+        std::lock_guard lock(pending_mutex_);
+        while (!published_.empty() && published_.front().id <= up_to) {
+            auto& changes = published_.front().changes;
+            if (applying_.empty()) {
+                applying_.swap(changes);
+            } else {
+                std::move(changes.begin(), changes.end(), std::back_inserter(applying_));
+            }
+            published_.pop_front();
+        }
+        if (up_to == ALL_CHANGES) {
+            std::move(pending_.begin(), pending_.end(), std::back_inserter(applying_));
+            pending_.clear();
+            pending_index_.clear();
+        }
+    }
+
+    changed_owners_.clear();
+    removed_owners_.clear();
+    removed_object_ids_.clear();
+    stats_.rebuilt = 0;
+    stats_.moved = 0;
+    stats_.removed = 0;
+
+    for (PendingChange& change : applying_) {
+        switch (change.type) {
+        case ChangeType::Rebuild:
+            apply_rebuild(change);
+            break;
+        case ChangeType::Transform:
+            apply_transform(change.owner, change.world);
+            break;
+        case ChangeType::Remove:
+            if (owner_proxies_.count(change.owner)) {
+                remove_proxies(change.owner);
+                removed_owners_.push_back(change.owner);
+                stats_.removed++;
+            }
+            break;
+        }
+    }
+    applying_.clear();
+
+    stats_.proxy_count = size();
+    stats_.owner_count = static_cast<uint32_t>(owner_proxies_.size());
+    stats_.update_ms = timer.get_total_ms();
+    return stats_;
+}
+
+void RenderProxyScene::apply_rebuild(PendingChange& change) {
+    MeshRendererComponent* owner = change.owner;
+    bool existed = owner_proxies_.count(owner) != 0;
+    if (existed) remove_proxies(owner);
+
+    if (change.descs.empty()) {
+        if (existed) {
+            removed_owners_.push_back(owner);
+            stats_.removed++;
+        }
+        return;
+    }
+
+    Mat4 inv_model = change.world.inverse();
+    std::vector<uint32_t>& indices = owner_proxies_[owner];
+    indices.reserve(change.descs.size());
+    for (RenderProxyDesc& desc : change.descs) {
+        indices.push_back(size());
+        owners_.push_back(owner);
+        object_ids_.push_back(desc.object_id);
+        vertex_buffers_.push_back(std::move(desc.vertex_buffer));
+        normal_buffers_.push_back(std::move(desc.normal_buffer));
+        tangent_buffers_.push_back(std::move(desc.tangent_buffer));
+        texcoord_buffers_.push_back(std::move(desc.texcoord_buffer));
+        index_buffers_.push_back(std::move(desc.index_buffer));
+        index_counts_.push_back(desc.index_count);
+        index_offsets_.push_back(desc.index_offset);
+        materials_.push_back(std::move(desc.material));
+        meshes_.push_back(std::move(desc.mesh));
+        lod_levels_.push_back(0);
+        models_.push_back(change.world);
+        inv_models_.push_back(inv_model);
+        local_spheres_.push_back(desc.local_sphere);
+        local_boxes_.push_back(desc.local_box);
+        bounds_.add(transform_bounding_sphere(desc.local_sphere, change.world),
+                    transform_bounding_box(desc.local_box, change.world));
+    }
+    changed_owners_.push_back(owner);
+    stats_.rebuilt++;
+}
+
+void RenderProxyScene::apply_transform(MeshRendererComponent* owner, const Mat4& world) {
+    auto it = owner_proxies_.find(owner);
+    if (it == owner_proxies_.end()) return;
+
+    // One inverse per owner, shared by its submeshes
+    Mat4 inv_model = world.inverse();
+    for (uint32_t index : it->second) {
+        models_[index] = world;
+        inv_models_[index] = inv_model;
+        bounds_.set(index, transform_bounding_sphere(local_spheres_[index], world),
+                    transform_bounding_box(local_boxes_[index], world));
+    }
+    changed_owners_.push_back(owner);
+    stats_.moved++;
+}
+
+void RenderProxyScene::remove_proxies(MeshRendererComponent* owner) {
+    auto it = owner_proxies_.find(owner);
+    if (it == owner_proxies_.end()) return;
+
+    // Highest index first, so a proxy moved into a hole is never one still to be removed
+    std::vector<uint32_t> indices = std::move(it->second);
+    owner_proxies_.erase(it);
+    std::sort(indices.begin(), indices.end(), std::greater<uint32_t>());
+    for (uint32_t index : indices) {
+        remove_proxy(index);
+    }
+}
+
+void RenderProxyScene::remove_proxy(uint32_t index) {
+    removed_object_ids_.push_back(object_ids_[index]);
+
+    uint32_t last = size() - 1;
+    if (index != last) {
+        // Point the moved proxy's owner at its new slot
+        auto owner_it = owner_proxies_.find(owners_[last]);
+        if (owner_it != owner_proxies_.end()) {
+            std::replace(owner_it->second.begin(), owner_it->second.end(), last, index);
+        }
+
+        owners_[index] = owners_[last];
+        object_ids_[index] = object_ids_[last];
+        vertex_buffers_[index] = std::move(vertex_buffers_[last]);
+        normal_buffers_[index] = std::move(normal_buffers_[last]);
+        tangent_buffers_[index] = std::move(tangent_buffers_[last]);
+        texcoord_buffers_[index] = std::move(texcoord_buffers_[last]);
+        index_buffers_[index] = std::move(index_buffers_[last]);
+        index_counts_[index] = index_counts_[last];
+        index_offsets_[index] = index_offsets_[last];
+        materials_[index] = std::move(materials_[last]);
+        meshes_[index] = std::move(meshes_[last]);
+        lod_levels_[index] = lod_levels_[last];
+        models_[index] = models_[last];
+        inv_models_[index] = inv_models_[last];
+        local_spheres_[index] = local_spheres_[last];
+        local_boxes_[index] = local_boxes_[last];
+    }
+    bounds_.remove_swap(index);
+
+    owners_.pop_back();
+    object_ids_.pop_back();
+    vertex_buffers_.pop_back();
+    normal_buffers_.pop_back();
+    tangent_buffers_.pop_back();
+    texcoord_buffers_.pop_back();
+    index_buffers_.pop_back();
+    index_counts_.pop_back();
+    index_offsets_.pop_back();
+    materials_.pop_back();
+    meshes_.pop_back();
+    lod_levels_.pop_back();
+    models_.pop_back();
+    inv_models_.pop_back();
+    local_spheres_.pop_back();
+    local_boxes_.pop_back();
+}
+
+BoundingBox RenderProxyScene::get_owner_bounds(MeshRendererComponent* owner) const {
+    auto it = owner_proxies_.find(owner);
+    if (it == owner_proxies_.end() || it->second.empty()) return BoundingBox{};
+
+    BoundingBox box = bounds_.get_box(it->second[0]);
+    for (uint32_t index : it->second) {
+        BoundingBox proxy_box = bounds_.get_box(index);
+        box.min = box.min.cwiseMin(proxy_box.min);
+        box.max = box.max.cwiseMax(proxy_box.max);
+    }
+    return box;
+}
+
+const std::vector<uint32_t>& RenderProxyScene::get_owner_proxies(MeshRendererComponent* owner) const {
+    static const std::vector<uint32_t> EMPTY;
+    auto it = owner_proxies_.find(owner);
+    return it != owner_proxies_.end() ? it->second : EMPTY;
+}
+
+void RenderProxyScene::build_batch(uint32_t index, render::DrawBatch& batch) const {
+    batch.object_id = object_ids_[index];
+    batch.vertex_buffer = vertex_buffers_[index];
+    batch.normal_buffer = normal_buffers_[index];
+    batch.tangent_buffer = tangent_buffers_[index];
+    batch.texcoord_buffer = texcoord_buffers_[index];
+    batch.index_buffer = index_buffers_[index];
+    batch.index_count = index_counts_[index];
+    batch.index_offset = index_offsets_[index];
+    batch.model_matrix = models_[index];
+    batch.inv_model_matrix = inv_models_[index];
+    batch.material = materials_[index];
+    batch.world_sphere = bounds_.get_sphere(index);
+    batch.world_box = bounds_.get_box(index);
+}
+
+void RenderProxyScene::build_batches(const std::vector<uint32_t>& indices, std::vector<render::DrawBatch>& batches) const {
+    batches.resize(indices.size());
+    for (size_t i = 0; i < indices.size(); ++i) build_batch(indices[i], batches[i]);
+}
+
+void RenderProxyScene::build_object_info(uint32_t index, ObjectInfo& info) const {
+    info = ObjectInfo{};
+    info.model = models_[index];
+    info.prev_model = models_[index];
+    info.inv_model = inv_models_[index];
+    info.material_id = materials_[index] ? materials_[index]->get_material_id() : 0;
+    info.sphere = bounds_.get_sphere(index);
+    info.box = bounds_.get_box(index);
+}
+
+void RenderProxyScene::clear() {
+    {
+        std::lock_guard lock(pending_mutex_);
+        pending_.clear();
+        pending_index_.clear();
+        published_.clear();
+    }
+    owners_.clear();
+    object_ids_.clear();
+    vertex_buffers_.clear();
+    normal_buffers_.clear();
+    tangent_buffers_.clear();
+    texcoord_buffers_.clear();
+    index_buffers_.clear();
+    index_counts_.clear();
+    index_offsets_.clear();
+    materials_.clear();
+    meshes_.clear();
+    lod_levels_.clear();
+    models_.clear();
+    inv_models_.clear();
+    local_spheres_.clear();
+    local_boxes_.clear();
+    bounds_.clear();
+    owner_proxies_.clear();
+    changed_owners_.clear();
+    removed_owners_.clear();
+    removed_object_ids_.clear();
+    stats_ = RenderProxyStats{};
+}
@@ -0,0 +1,193 @@
+#pragma once
+
+#include "engine/function/render/render_pass/mesh_pass.h"
+#include "engine/function/render/render_system/frustum_culling.h"
+#include "engine/core/math/math.h"
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+class MeshRendererComponent;
+class Mesh;
+
+/**
+ * @brief Geometry and material of one submesh, captured on the game thread when its renderer changes
+ */
+struct RenderProxyDesc {
+    uint32_t object_id = 0;
+    RHIBufferRef vertex_buffer;
+    RHIBufferRef normal_buffer;
+    RHIBufferRef tangent_buffer;
+    RHIBufferRef texcoord_buffer;
+    RHIBufferRef index_buffer;
+    uint32_t index_count = 0;
+    uint32_t index_offset = 0;
+    MaterialRef material;
+    std::shared_ptr<Mesh> mesh;     // CPU geometry, rasterized when the proxy is picked as an occluder
+    BoundingSphere local_sphere;
+    BoundingBox local_box;
+};
+
+struct RenderProxyStats {
+    uint32_t proxy_count = 0;
+    uint32_t owner_count = 0;
+    uint32_t rebuilt = 0;           // Owners whose proxies were recreated
+    uint32_t moved = 0;             // Owners whose transform changed
+    uint32_t removed = 0;
+    float update_ms = 0.0f;
+};
+
+/**
+ * @brief Persistent render proxies of all mesh renderers, one per submesh, stored as structure of arrays
+ *
+ * Renderers push changes (new geometry/materials, a new world matrix, removal) from the game thread;
+ * the changes are queued and coalesced per renderer, so only the latest state of each is applied.
+ * publish() closes the changes of one game frame; update() applies them on the render thread, so
+ * per-frame work is proportional to the number of renderers that changed. The owner pointer is only
+ * used as a key and is never dereferenced.
+ *
+ * World bounds live in a CullingBounds that the frustum culler reads directly; proxy indices are
+ * dense and change when proxies are removed (the last proxy moves into the hole).
+ */
+class RenderProxyScene {
+public:
+    // Game thread
+
+    /**
+     * @brief Replace all proxies of owner. An empty descs removes them.
+     */
+    void set_proxies(MeshRendererComponent* owner, std::vector<RenderProxyDesc> descs, const Mat4& world);
+    void set_transform(MeshRendererComponent* owner, const Mat4& world);
+    void remove(MeshRendererComponent* owner);
+
+    /**
+     * @brief Close the changes queued so far into one batch, at the end of a game tick
+     * @return Batch id; pass it to update() to apply exactly the changes made up to this point
+     */
+    uint64_t publish();
+
+    // Render thread
+
+    static constexpr uint64_t ALL_CHANGES = std::numeric_limits<uint64_t>::max();
+
+    /**
+     * @brief Apply published batches up to and including up_to, in order
+     * @param up_to Batch id from publish(); ALL_CHANGES also applies changes not yet published
+     * @return Stats of this update
+     */
+    const RenderProxyStats& update(uint64_t up_to = ALL_CHANGES);
+
+    /**
+     * @brief Owners that were rebuilt or moved in the last update, and owners that were removed
+     */
+    const std::vector<MeshRendererComponent*>& get_changed_owners() const { return changed_owners_; }
+    const std::vector<MeshRendererComponent*>& get_removed_owners() const { return removed_owners_; }
+
+    /**
+     * @brief Object ids of proxies removed in the last update, rebuilt owners included
+     */
+    const std::vector<uint32_t>& get_removed_object_ids() const { return removed_object_ids_; }
+
+    /**
+     * @brief Proxy indices of owner, empty if it has none
+     */
+    const std::vector<uint32_t>& get_owner_proxies(MeshRendererComponent* owner) const;
+
+    /**
+     * @brief World-space AABB enclosing every proxy of owner, empty box if it has none
+     */
+    BoundingBox get_owner_bounds(MeshRendererComponent* owner) const;
+
+    /**
+     * @brief Fill a draw batch from proxy index
+     */
+    void build_batch(uint32_t index, render::DrawBatch& batch) const;
+
+    /**
+     * @brief Fill one draw batch per proxy index, in order; batches is resized to indices
+     */
+    void build_batches(const std::vector<uint32_t>& indices, std::vector<render::DrawBatch>& batches) const;
+
+    /**
+     * @brief Fill the GPU object data of proxy index; prev_model is set to the current model
+     */
+    void build_object_info(uint32_t index, ObjectInfo& info) const;
+
+    inline uint32_t size() const { return static_cast<uint32_t>(owners_.size()); }
+    inline const CullingBounds& get_bounds() const { return bounds_; }
+    inline MeshRendererComponent* get_owner(uint32_t index) const { return owners_[index]; }
+    inline uint32_t get_object_id(uint32_t index) const { return object_ids_[index]; }
+    inline const Mat4& get_model(uint32_t index) const { return models_[index]; }
+    inline const MaterialRef& get_material(uint32_t index) const { return materials_[index]; }
+    inline const std::shared_ptr<Mesh>& get_mesh(uint32_t index) const { return meshes_[index]; }
+    inline uint32_t get_index_count(uint32_t index) const { return index_counts_[index]; }
+    inline uint32_t get_index_offset(uint32_t index) const { return index_offsets_[index]; }
+    inline uint32_t get_lod_level(uint32_t index) const { return lod_levels_[index]; }
+    inline void set_lod_level(uint32_t index, uint32_t level) { lod_levels_[index] = static_cast<uint8_t>(level); }
+    inline const RenderProxyStats& get_stats() const { return stats_; }
+
+    /**
+     * @brief Drop all proxies and queued changes
+     */
+    void clear();
+
+private:
+    enum class ChangeType : uint8_t { Transform, Rebuild, Remove };
+
+    struct PendingChange {
+        MeshRendererComponent* owner = nullptr;
+        ChangeType type = ChangeType::Transform;
+        Mat4 world = Mat4::Identity();
+        std::vector<RenderProxyDesc> descs;
+    };
+
+    struct PublishedChanges {
+        uint64_t id = 0;
+        std::vector<PendingChange> changes;
+    };
+
+    PendingChange& pending_for(MeshRendererComponent* owner, ChangeType type);
+    void apply_rebuild(PendingChange& change);
+    void apply_transform(MeshRendererComponent* owner, const Mat4& world);
+    void remove_proxies(MeshRendererComponent* owner);
+    void remove_proxy(uint32_t index);
+
+    // Queued changes, at most one per owner per batch
+    std::mutex pending_mutex_;
+    std::vector<PendingChange> pending_;
+    std::unordered_map<MeshRendererComponent*, uint32_t> pending_index_;
+    std::deque<PublishedChanges> published_;
+    uint64_t publish_id_ = 0;
+    std::vector<PendingChange> applying_;
+
+    // Proxy arrays, all indexed by proxy
+    std::vector<MeshRendererComponent*> owners_;
+    std::vector<uint32_t> object_ids_;
+    std::vector<RHIBufferRef> vertex_buffers_;
+    std::vector<RHIBufferRef> normal_buffers_;
+    std::vector<RHIBufferRef> tangent_buffers_;
+    std::vector<RHIBufferRef> texcoord_buffers_;
+    std::vector<RHIBufferRef> index_buffers_;
+    std::vector<uint32_t> index_counts_;
+    std::vector<uint32_t> index_offsets_;
+    std::vector<MaterialRef> materials_;
+    std::vector<std::shared_ptr<Mesh>> meshes_;
+    std::vector<uint8_t> lod_levels_;       // Level selected for the main view last frame
+    std::vector<Mat4> models_;
+    std::vector<Mat4> inv_models_;
+    std::vector<BoundingSphere> local_spheres_;
+    std::vector<BoundingBox> local_boxes_;
+    CullingBounds bounds_;
+
+    // Proxy indices of each owner
+    std::unordered_map<MeshRendererComponent*, std::vector<uint32_t>> owner_proxies_;
+
+    std::vector<MeshRendererComponent*> changed_owners_;
+    std::vector<MeshRendererComponent*> removed_owners_;
+    std::vector<uint32_t> removed_object_ids_;
+    RenderProxyStats stats_;
+};
@@ -0,0 +1,93 @@
+#include "engine/function/render/render_system/render_scene_snapshot.h"
+#include "engine/function/framework/scene.h"
+#include "engine/function/framework/entity.h"
+#include "engine/function/framework/component/camera_component.h"
+#include "engine/function/framework/component/skybox_component.h"
+#include "engine/function/render/render_resource/skybox_material.h"
+#include "engine/core/utils/profiler.h"
+#include "engine/core/utils/timer.h"
+
+RenderSceneSnapshot* RenderSceneBuffer::acquire() {
+    Timer timer;
+    std::unique_lock lock(mutex_);
+    cv_.wait(lock, [this]() { return !in_use_[next_]; });
+
+    // Snapshots are released in the order they were acquired, so the next one is always the oldest
+    uint32_t index = next_;
+    next_ = (next_ + 1) % SNAPSHOT_COUNT;
+    in_use_[index] = true;
+
+    RenderSceneSnapshot* snapshot = &snapshots_[index];
+    snapshot->frame_id = ++frame_id_;
+    snapshot->wait_ms = timer.get_total_ms();
+    return snapshot;
+}
+
+void RenderSceneBuffer::release(const RenderSceneSnapshot* snapshot) {
+    if (!snapshot) return;
+    {
+        std::lock_guard lock(mutex_);
+        in_use_[snapshot - snapshots_.data()] = false;
+    }
+    cv_.notify_all();
+}
+
+void RenderSceneBuffer::extract(Scene* scene, CameraComponent* camera, const RenderLightRegistry* lights,
+                                RenderSceneSnapshot& snapshot) {
+    PROFILE_SCOPE("RenderSceneBuffer_Extract");
+    Timer timer;
+
+    snapshot.camera = RenderCameraSnapshot{};
+    if (camera) {
+        snapshot.camera.valid = true;
+        snapshot.camera.view = camera->get_view_matrix();
+        snapshot.camera.projection = camera->get_projection_matrix();
+        snapshot.camera.position = camera->get_position();
+        snapshot.camera.front = camera->get_front();
+        snapshot.camera.near_plane = camera->get_near();
+        snapshot.camera.far_plane = camera->get_far();
+        snapshot.camera.frustum = camera->get_frustum();
+    }
+
+    snapshot.main_light_direction = Vec3(0.0f, -1.0f, 0.0f);
+    snapshot.main_light_color = Vec3(1.0f, 1.0f, 1.0f);
+    snapshot.main_light_intensity = 1.0f;
+    snapshot.main_light_cast_shadow = false;
+    snapshot.main_light_cascade_split = 0.95f;
+    snapshot.skyboxes.clear();
+
+    if (lights) {
+        if (const RenderLightDesc* main_light = lights->get_main_light()) {
+            snapshot.main_light_direction = main_light->data.direction;
+            snapshot.main_light_color = main_light->data.color;
+            snapshot.main_light_intensity = main_light->data.intensity;
+            snapshot.main_light_cast_shadow = main_light->cast_shadow;
+            snapshot.main_light_cascade_split = main_light->cascade_split;
+        }
+        // Snapshots are recycled, so one that already holds this revision skips the copy
+        if (snapshot.light_revision != lights->get_revision()) {
+            snapshot.lights = lights->get_lights();
+            snapshot.light_ids = lights->get_light_ids();
+            snapshot.light_cast_shadow = lights->get_shadow_flags();
+            snapshot.light_revision = lights->get_revision();
+        }
+        snapshot.light_stats = lights->get_stats();
+    } else {
+        snapshot.lights.clear();
+        snapshot.light_ids.clear();
+        snapshot.light_cast_shadow.clear();
+        snapshot.light_revision = 0;
+        snapshot.light_stats = RenderLightStats{};
+    }
+
+    if (scene) {
+        for (auto& entity : scene->entities_) {
+            if (!entity) continue;
+            if (auto* skybox = entity->get_component<SkyboxComponent>()) {
+                snapshot.skyboxes.push_back(RenderSkyboxSnapshot{skybox->get_material(), skybox->get_skybox_scale()});
+            }
+        }
+    }
+
+    snapshot.extract_ms = timer.get_total_ms();
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+#include "engine/function/render/render_pass/deferred_lighting_pass.h"
+#include "engine/function/render/render_system/render_light_registry.h"
+#include "engine/function/render/data/render_structs.h"
+#include "engine/core/math/math.h"
+#include <array>
+#include <memory>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+class Scene;
+class CameraComponent;
+class SkyboxMaterial;
+
+struct RenderCameraSnapshot {
+    bool valid = false;
+    Mat4 view = Mat4::Identity();
+    Mat4 projection = Mat4::Identity();
+    Vec3 position = Vec3::Zero();
+    Vec3 front = Vec3::UnitZ();
+    float near_plane = 0.1f;
+    float far_plane = 1000.0f;
+    Frustum frustum;
+};
+
+struct RenderSkyboxSnapshot {
+    std::shared_ptr<SkyboxMaterial> material;  // Forward declared: skybox_material.h pulls in the engine context
+    float scale = 1.0f;
+};
+
+/**
+ * @brief Render-relevant copy of one game frame
+ *
+ * Filled on the game thread at the end of its tick and only read by the render thread, so the
+ * game thread can tick the next frame while this one renders. Mesh geometry is not copied: the
+ * persistent RenderProxyScene is advanced to proxy_batch instead.
+ */
+struct RenderSceneSnapshot {
+    uint64_t frame_id = 0;
+    RenderCameraSnapshot camera;
+
+    // First enabled directional light; direction is the light's front vector
+    Vec3 main_light_direction = Vec3(0.0f, -1.0f, 0.0f);
+    Vec3 main_light_color = Vec3(1.0f, 1.0f, 1.0f);
+    float main_light_intensity = 1.0f;
+    bool main_light_cast_shadow = false;
+    float main_light_cascade_split = 0.95f;     // Practical split lambda of its shadow cascades
+
+    // Further directional lights and point lights, copied from the light registry when it changed
+    std::vector<render::ShaderLightData> lights;
+    std::vector<uint32_t> light_ids;            // Stable registry id of each light
+    std::vector<uint8_t> light_cast_shadow;     // cast_shadow of each light
+    uint64_t light_revision = 0;    // Registry revision of lights
+    RenderLightStats light_stats;
+    std::vector<RenderSkyboxSnapshot> skyboxes;
+
+    uint64_t proxy_batch = 0;       // RenderProxyScene::publish() id of this frame
+
+    float extract_ms = 0.0f;        // Copying the scene on the game thread
+    float wait_ms = 0.0f;           // Game thread blocked because every snapshot was in flight
+};
+
+/**
+ * @brief Triple-buffered render scene snapshots shared by the game and render threads
+ *
+ * The game thread acquires a free snapshot, extracts the scene into it and hands it to the render
+ * thread with the RenderPacket; the render thread releases it when the frame has been recorded.
+ * With SNAPSHOT_COUNT snapshots the game thread can run up to two frames ahead.
+ */
+class RenderSceneBuffer {
+public:
+    static constexpr uint32_t SNAPSHOT_COUNT = 3;
+
+    /**
+     * @brief Take a free snapshot, blocking while all of them are in flight (game thread)
+     */
+    RenderSceneSnapshot* acquire();
+
+    /**
+     * @brief Return a snapshot once the render thread is done with it
+     */
+    void release(const RenderSceneSnapshot* snapshot);
+
+    /**
+     * @brief Copy camera, lights and environment of scene into snapshot
+     * @param camera Camera to render from; nullptr leaves the snapshot camera invalid
+     * @param lights Registered lights; the packed array is only copied if the snapshot holds an older revision
+     */
+    static void extract(Scene* scene, CameraComponent* camera, const RenderLightRegistry* lights,
+                        RenderSceneSnapshot& snapshot);
+
+private:
+    std::array<RenderSceneSnapshot, SNAPSHOT_COUNT> snapshots_;
+    std::array<bool, SNAPSHOT_COUNT> in_use_ = {};
+    uint32_t next_ = 0;
+    uint64_t frame_id_ = 0;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+};
@@ -295,6 +295,26 @@ void RenderSystem::init_passes() {
 		INFO(LogRenderSystem, "EditorUIPass initialized successfully");
 	}
 
+	// Initialize upscale pass (dynamic resolution)
+	upscale_pass_ = std::make_shared<render::UpscalePass>();
+	upscale_pass_->init();
+
+	if (upscale_pass_->is_ready()) {
+		INFO(LogRenderSystem, "UpscalePass initialized successfully");
+	} else {
+		WARN(LogRenderSystem, "UpscalePass initialization failed, dynamic resolution disabled");
+	}
+
+	// Initialize temporal AA pass
+	temporal_aa_pass_ = std::make_shared<render::TemporalAAPass>();
+	temporal_aa_pass_->init();
+
+	if (temporal_aa_pass_->is_ready()) {
+		INFO(LogRenderSystem, "TemporalAAPass initialized successfully");
+	} else {
+		WARN(LogRenderSystem, "TemporalAAPass initialization failed, temporal AA disabled");
+	}
+
 	// Initialize depth prepass resources
 }
 
@@ -323,77 +343,76 @@ void RenderSystem::build_and_execute_rdg(uint32_t frame_index, const RenderPacke
 	Extent2D extent = swapchain_->get_extent();
 
 	// Import back buffer as RDG texture
-	RDGTextureHandle color_target = rdg_builder.create_texture("BackBuffer")
+	RDGTextureHandle back_buffer_target = rdg_builder.create_texture("BackBuffer")
 											.import(back_buffer, RESOURCE_STATE_COLOR_ATTACHMENT)
 											.finish();
 
+	// Below full resolution the scene renders into the corner of a full-size target (a stable pool key)
+	// and is upscaled to the back buffer before the UI. Temporal AA resolves at any scale and replaces
+	// the bilinear upscale.
+	if (!temporal_aa_pass_ || !temporal_aa_pass_->is_ready()) {
+		temporal_aa_.set_enabled(false);
+	}
+	bool temporal = temporal_aa_.is_enabled();
+	Extent2D render_extent = render_extent_;
+	bool upscale = !temporal && render_extent != extent && upscale_pass_ && upscale_pass_->is_ready();
+	if (!temporal && !upscale) {
+		render_extent = extent;
+	}
+	// Passes size their viewports from get_render_extent(), so it must match what is rendered
+	render_extent_ = render_extent;
+	RDGTextureHandle color_target = back_buffer_target;
+	if (temporal || upscale) {
+		color_target = rdg_builder.create_texture("SceneColor")
+								.extent({ extent.width, extent.height, 1 })
+								.format(get_color_format())
+								.allow_render_target()
+								.finish();
+	}
+
 	// Import depth texture
 	RDGTextureHandle depth_target = rdg_builder.create_texture("Depth")
 											.import(depth_texture_, RESOURCE_STATE_DEPTH_STENCIL_ATTACHMENT)
 											.finish();
 
-	// Collect draw batches
-	std::vector<render::DrawBatch> batches;
-	mesh_manager_->collect_draw_batches(batches);
-
-	// Get camera data early (needed for both batches and skybox)
-	CameraComponent *camera = packet.active_camera;
-	if (!camera && mesh_manager_) {
-		camera = mesh_manager_->get_active_camera();
-	}
+	// Draw batches were collected once for this frame in tick()
+	const std::vector<render::DrawBatch> &batches = mesh_manager_->get_frame_batches();
 
-	if (!camera) {
+	// Camera data comes from the snapshot (needed for both batches and skybox)
+	const RenderSceneSnapshot *scene = mesh_manager_->get_scene();
+	if (!scene || !scene->camera.valid) {
 		WARN(LogRenderSystem, "No active camera for RDG rendering");
 		rdg_builder.execute();
 		return;
 	}
 
+	// Tracked without temporal AA too, so the motion vectors stay valid when it is switched on
+	const TemporalAAView &temporal_view = temporal_aa_.begin_frame(scene->camera.view, scene->camera.projection,
+			render_extent, extent);
+	mesh_manager_->set_temporal_view(&temporal_view);
+
 	if (batches.empty()) {
 		// No geometry to render, just clear the screen
 		INFO(LogRenderSystem, "ClearPass executed (no geometry to render)");
 		rdg_builder.create_render_pass("ClearPass")
 				.color(0, color_target, ATTACHMENT_LOAD_OP_CLEAR, ATTACHMENT_STORE_OP_STORE,
 						Color4{ 1.0f, 0.0f, 0.0f, 1.0f })
-				.execute([extent](RDGPassContext context) {
-					context.command->set_viewport({ 0, 0 }, { extent.width, extent.height });
-					context.command->set_scissor({ 0, 0 }, { extent.width, extent.height });
+				.execute([render_extent](RDGPassContext context) {
+					context.command->set_viewport({ 0, 0 }, { render_extent.width, render_extent.height });
+					context.command->set_scissor({ 0, 0 }, { render_extent.width, render_extent.height });
 				})
 				.finish();
 		// Note: Continue to skybox pass even with empty batches
 	}
 
-	// Get light data
-	Vec3 light_dir = Vec3(0.0f, -1.0f, 0.0f);
-	Vec3 light_color = Vec3(1.0f, 1.0f, 1.0f);
-	float light_intensity = 1.0f;
-
-	if (packet.active_scene) {
-		for (auto &entity : packet.active_scene->entities_) {
-			if (!entity) {
-				continue;
-			}
-			auto *light = entity->get_component<DirectionalLightComponent>();
-			if (light && light->enable()) {
-				auto *transform = entity->get_component<TransformComponent>();
-				if (transform) {
-					light_dir = -transform->transform.front();
-				}
-				light_color = light->get_color();
-				light_intensity = light->get_intensity();
-				break;
-			}
-		}
-	}
-
 	// Execute depth prepass first (before any forward/render passes)
 	if (enable_depth_prepass_ && depth_prepass_) {
 		PROFILE_SCOPE("RenderSystem_DepthPrepass");
 
-		depth_prepass_->set_per_frame_data(
-				camera->get_view_matrix(),
-				camera->get_projection_matrix());
+		depth_prepass_->set_per_frame_data(scene->camera.view, temporal_view.projection);
 
-		depth_prepass_->build(rdg_builder, depth_target, batches);
+		// Only the draws worth their vertex cost; the rest are depth tested in the main passes
+		depth_prepass_->build(rdg_builder, depth_target, mesh_manager_->get_prepass_batches());
 	}
 
 	// Call custom RDG build function if set (for testing)
@@ -410,26 +429,33 @@ void RenderSystem::build_and_execute_rdg(uint32_t frame_index, const RenderPacke
 	}
 
 	// Build skybox pass (renders after opaque objects)
-	if (enable_skybox_pass_ && skybox_pass_ && skybox_pass_->is_ready() && packet.active_scene) {
+	if (enable_skybox_pass_ && skybox_pass_ && skybox_pass_->is_ready() && !scene->skyboxes.empty()) {
 		PROFILE_SCOPE("RenderSystem_SkyboxPass");
-		
-		// Collect skybox components from scene
-		std::vector<SkyboxComponent*> skyboxes = 
-			packet.active_scene->get_components<SkyboxComponent>();
-		
-		if (!skyboxes.empty()) {
-			skybox_pass_->build(rdg_builder, color_target, depth_target,
-				camera->get_view_matrix(),
-				camera->get_projection_matrix(),
-				skyboxes);
+		skybox_pass_->build(rdg_builder, color_target, depth_target,
+			scene->camera.view,
+			temporal_view.projection,
+			scene->skyboxes);
+	}
+
+	if (temporal) {
+		PROFILE_SCOPE("RenderSystem_TemporalAA");
+		// Pixels without G-buffer motion vectors fall back to camera motion from depth
+		std::optional<RDGTextureHandle> velocity;
+		if (auto velocity_node = rdg_builder.get_blackboard().texture("GBuffer_Velocity")) {
+			velocity = velocity_node->get_handle();
 		}
+		temporal_aa_pass_->build(rdg_builder, color_target, depth_target, velocity, render_extent,
+				back_buffer_target, extent, temporal_view, temporal_aa_.get_settings());
+	} else if (upscale) {
+		PROFILE_SCOPE("RenderSystem_Upscale");
+		upscale_pass_->build(rdg_builder, color_target, render_extent, extent, back_buffer_target, extent);
 	}
 
 	// Build editor UI pass (renders on top of everything)
 	if (show_ui_ && editor_ui_pass_ && editor_ui_pass_->is_ready()) {
 		// Set the UI draw function for this frame (will be called during build)
 		editor_ui_pass_->set_ui_draw_function([this, &packet]() {
-			draw_scene_hierarchy(packet.active_scene);
+			draw_scene_hierarchy(packet.editor_scene);
 			draw_inspector_panel();
 			
 			if (show_buffer_debug_) {
@@ -456,6 +482,147 @@ void RenderSystem::build_and_execute_rdg(uint32_t frame_index, const RenderPacke
 			ImGui::Checkbox("NPR Pass", &enable_npr_pass_);
 			ImGui::Checkbox("Skybox Pass", &enable_skybox_pass_);
 			ImGui::Checkbox("Depth Visualize", &enable_depth_visualize_);
+
+			if (mesh_manager_) {
+				ImGui::Separator();
+				bool frustum_culling = mesh_manager_->is_frustum_culling_enabled();
+				if (ImGui::Checkbox("Frustum Culling", &frustum_culling)) {
+					mesh_manager_->set_frustum_culling(frustum_culling);
+				}
+				const auto& cull_stats = mesh_manager_->get_culling_stats();
+				ImGui::Text("Visible %u / %u (sphere culled %u, box culled %u)",
+						cull_stats.visible, cull_stats.tested,
+						cull_stats.sphere_culled, cull_stats.box_culled);
+				ImGui::Text("Cull %.3f ms, %u chunk(s), %u-wide SIMD",
+						cull_stats.cull_ms, cull_stats.chunk_count, FrustumCuller::simd_width());
+				bool occlusion_culling = mesh_manager_->is_occlusion_culling_enabled();
+				if (ImGui::Checkbox("Occlusion Culling", &occlusion_culling)) {
+					mesh_manager_->set_occlusion_culling(occlusion_culling);
+				}
+				const auto& occlusion_stats = mesh_manager_->get_occlusion_stats();
+				ImGui::Text("Occluded %u / %u (%.1f%%) by %u occluders, %u / %u triangles rasterized",
+						occlusion_stats.occluded, occlusion_stats.tested,
+						occlusion_stats.tested ? 100.0f * occlusion_stats.occluded / occlusion_stats.tested : 0.0f,
+						occlusion_stats.occluder_count, occlusion_stats.rasterized_triangles, occlusion_stats.occluder_triangles);
+				ImGui::Text("Occlusion raster %.3f ms, test %.3f ms, %u-wide SIMD",
+						occlusion_stats.raster_ms, occlusion_stats.test_ms, OcclusionCuller::simd_width());
+				bool lod_selection = mesh_manager_->is_lod_selection_enabled();
+				if (ImGui::Checkbox("LOD Selection", &lod_selection)) {
+					mesh_manager_->set_lod_selection(lod_selection);
+				}
+				LodSelector& lod_selector = mesh_manager_->get_lod_selector();
+				float lod_bias = lod_selector.get_bias();
+				if (ImGui::SliderFloat("LOD Bias", &lod_bias, -2.0f, 4.0f)) {
+					lod_selector.set_bias(lod_bias);
+				}
+				const auto& lod_stats = mesh_manager_->get_lod_stats();
+				ImGui::Text("LOD objects %u / %u / %u / %u, %u switched, %.3f ms",
+						lod_stats.lod_objects[0], lod_stats.lod_objects[1], lod_stats.lod_objects[2],
+						lod_stats.lod_objects[3], lod_stats.switches, lod_stats.select_ms);
+				ImGui::Text("Triangles %llu / %llu at full detail (%.1f%%)",
+						static_cast<unsigned long long>(lod_stats.triangles),
+						static_cast<unsigned long long>(lod_stats.full_triangles),
+						lod_stats.full_triangles ? 100.0 * lod_stats.triangles / lod_stats.full_triangles : 0.0);
+				bool cluster_culling = mesh_manager_->is_cluster_culling_enabled();
+				if (ImGui::Checkbox("Cluster Culling", &cluster_culling)) {
+					mesh_manager_->set_cluster_culling(cluster_culling);
+				}
+				const auto& meshlet_stats = mesh_manager_->get_cluster_culling_stats();
+				ImGui::Text("Clusters %u in %u objects: frustum %u, backface %u, %u ranges, %.3f ms",
+						meshlet_stats.tested, meshlet_stats.object_count, meshlet_stats.frustum_culled,
+						meshlet_stats.backface_culled, meshlet_stats.draw_ranges, meshlet_stats.cull_ms);
+				ImGui::Text("Cluster triangles rejected: frustum %llu, backface %llu; drawn %llu / %llu",
+						static_cast<unsigned long long>(meshlet_stats.frustum_culled_triangles),
+						static_cast<unsigned long long>(meshlet_stats.backface_culled_triangles),
+						static_cast<unsigned long long>(meshlet_stats.drawn_triangles),
+						static_cast<unsigned long long>(meshlet_stats.triangles));
+				bool shadow_cascades = mesh_manager_->is_shadow_cascades_enabled();
+				if (ImGui::Checkbox("Shadow Cascades", &shadow_cascades)) {
+					mesh_manager_->set_shadow_cascades(shadow_cascades);
+				}
+				const auto& shadow_stats = mesh_manager_->get_shadow_cascade_stats();
+				ImGui::Text("Cascade casters %u / %u / %u / %u (%u draws for %u objects), %.3f ms",
+						shadow_stats.casters[0], shadow_stats.casters[1], shadow_stats.casters[2], shadow_stats.casters[3],
+						shadow_stats.caster_total, shadow_stats.object_count, shadow_stats.update_ms);
+				ImGui::Text("Cascade splits %.1f / %.1f / %.1f / %.1f m, texel %.3f / %.3f / %.3f / %.3f m",
+						shadow_stats.split_far[0], shadow_stats.split_far[1], shadow_stats.split_far[2], shadow_stats.split_far[3],
+						shadow_stats.texel_size[0], shadow_stats.texel_size[1], shadow_stats.texel_size[2], shadow_stats.texel_size[3]);
+				bool prepass_selection = mesh_manager_->is_prepass_selection_enabled();
+				if (ImGui::Checkbox("Prepass Selection", &prepass_selection)) {
+					mesh_manager_->set_prepass_selection(prepass_selection);
+				}
+				const auto& prepass_stats = mesh_manager_->get_depth_prepass_stats();
+				ImGui::Text("Prepass %u / %u draws (%u candidates, %u small, %u over budget), %.3f ms",
+						prepass_stats.selected_count, prepass_stats.batch_count, prepass_stats.candidate_count,
+						prepass_stats.small_count, prepass_stats.budget_count, prepass_stats.select_ms);
+				ImGui::Text("Prepass triangles %llu / %llu, coverage %.2f",
+						static_cast<unsigned long long>(prepass_stats.selected_triangles),
+						static_cast<unsigned long long>(prepass_stats.total_triangles), prepass_stats.selected_coverage);
+				bool shadow_atlas = mesh_manager_->is_shadow_atlas_enabled();
+				if (ImGui::Checkbox("Shadow Atlas", &shadow_atlas)) {
+					mesh_manager_->set_shadow_atlas(shadow_atlas);
+				}
+				const auto& atlas_stats = mesh_manager_->get_shadow_atlas_stats();
+				ImGui::Text("Atlas %u / %u lights (%u visible, %u failed), %u tiles, %.1f%% used",
+						atlas_stats.light_count, atlas_stats.request_count, atlas_stats.visible_count, atlas_stats.failed,
+						atlas_stats.tile_count, atlas_stats.occupancy * 100.0f);
+				ImGui::Text("Atlas faces %u rendered, %u cached, %u pending, %u allocations, %.3f ms",
+						atlas_stats.updates, atlas_stats.cached, atlas_stats.pending, atlas_stats.allocations,
+						atlas_stats.update_ms);
+				bool dynamic_resolution = dynamic_resolution_.is_enabled();
+				if (ImGui::Checkbox("Dynamic Resolution", &dynamic_resolution)) {
+					dynamic_resolution_.set_enabled(dynamic_resolution);
+				}
+				const auto& resolution_stats = dynamic_resolution_.get_stats();
+				ImGui::Text("Render scale %.3f (%u x %u), frame %.2f ms (filtered %.2f / %.1f ms), %u changes",
+						resolution_stats.scale, render_extent_.width, render_extent_.height, resolution_stats.frame_ms,
+						resolution_stats.filtered_ms, dynamic_resolution_.get_settings().target_ms, resolution_stats.changes);
+				bool temporal_aa = temporal_aa_.is_enabled();
+				if (ImGui::Checkbox("Temporal AA", &temporal_aa)) {
+					temporal_aa_.set_enabled(temporal_aa);
+				}
+				const TemporalAAView& temporal_view = temporal_aa_.get_view();
+				ImGui::Text("Jitter %+.3f, %+.3f px (%u phases), history %s, weight %.2f",
+						temporal_view.jitter_pixels.x, temporal_view.jitter_pixels.y, temporal_aa_.get_settings().jitter_phases,
+						temporal_view.history_valid ? "valid" : "reset", temporal_aa_.get_settings().history_weight);
+				const auto& sort_stats = mesh_manager_->get_draw_sort_stats();
+				ImGui::Text("Sort %u draws in %u list(s): %.3f ms",
+						sort_stats.draw_count, sort_stats.list_count, sort_stats.sort_ms);
+				ImGui::Text("State changes pipeline %u / material %u / mesh %u (unsorted %u / %u / %u)",
+						sort_stats.sorted.pipeline, sort_stats.sorted.material, sort_stats.sorted.mesh,
+						sort_stats.unsorted.pipeline, sort_stats.unsorted.material, sort_stats.unsorted.mesh);
+				auto instancing_stats = mesh_manager_->get_instancing_stats();
+				ImGui::Text("Instancing %u batches -> %u draws -> %u indirect calls, submit %.3f ms",
+						instancing_stats.batch_count, instancing_stats.draw_count, instancing_stats.submit_count,
+						instancing_stats.submit_ms);
+				if (const RenderSceneSnapshot *light_scene = mesh_manager_->get_scene()) {
+					const auto& light_stats = light_scene->light_stats;
+					ImGui::Text("Lights %u (%u directional): %u changed, %u removed, revision %llu",
+							light_stats.light_count, light_stats.directional_count, light_stats.changed,
+							light_stats.removed, static_cast<unsigned long long>(light_stats.revision));
+				}
+				const auto& collect_stats = mesh_manager_->get_collect_stats();
+				ImGui::Text("Collect: %u proxies -> %u batches, %u collection(s) this frame, %.3f ms",
+						collect_stats.proxy_count, collect_stats.batch_count, collect_stats.collect_count,
+						collect_stats.collect_ms);
+				const auto& proxy_stats = mesh_manager_->get_proxy_stats();
+				ImGui::Text("Proxies %u (%u renderers): rebuilt %u, moved %u, removed %u, %.3f ms",
+						proxy_stats.proxy_count, proxy_stats.owner_count, proxy_stats.rebuilt,
+						proxy_stats.moved, proxy_stats.removed, proxy_stats.update_ms);
+				const auto& table_stats = mesh_manager_->get_object_table_stats();
+				ImGui::Text("Object table: %u written, %u uploaded in %u copies (%.1f KB), %.3f ms",
+						table_stats.updated_objects, table_stats.uploaded_objects, table_stats.copy_count,
+						table_stats.upload_bytes / 1024.0f, table_stats.upload_ms);
+				const auto& cluster_stats = mesh_manager_->get_light_cluster_stats();
+				ImGui::Text("Light clusters: %u lights (%u clustered, %u global), %u/%u clusters lit, %u indices, max %u, %.3f ms",
+						cluster_stats.light_count, cluster_stats.clustered_lights, cluster_stats.global_lights,
+						cluster_stats.occupied_clusters, cluster_stats.cluster_count, cluster_stats.index_count,
+						cluster_stats.max_cluster_lights, cluster_stats.build_ms);
+				if (const auto* snapshot = mesh_manager_->get_scene()) {
+					ImGui::Text("Scene snapshot #%llu: extract %.3f ms, game thread waited %.3f ms",
+							static_cast<unsigned long long>(snapshot->frame_id), snapshot->extract_ms, snapshot->wait_ms);
+				}
+			}
 			
 			if (gizmo_manager_) {
 				gizmo_manager_->draw_controls();
@@ -497,7 +664,7 @@ void RenderSystem::build_and_execute_rdg(uint32_t frame_index, const RenderPacke
 			// ImGuizmo's IsHoveringWindow() requires the draw list to belong to a real
 			// ImGui window that matches g.HoveredWindow; using GetForegroundDrawList()
 			// breaks this check and prevents drag interaction.
-			if (gizmo_manager_ && selected_entity_ && packet.active_camera) {
+			if (gizmo_manager_ && selected_entity_ && packet.editor_camera) {
 				ImGuiIO &io = ImGui::GetIO();
 				
 				// Calculate viewport area (exclude hierarchy and inspector panels)
@@ -524,7 +691,7 @@ void RenderSystem::build_and_execute_rdg(uint32_t frame_index, const RenderPacke
 				
 				// Use the window's own draw list (nullptr) so ImGuizmo's
 				// IsHoveringWindow() correctly matches g.HoveredWindow
-				gizmo_manager_->draw_gizmo(packet.active_camera, selected_entity_,
+				gizmo_manager_->draw_gizmo(packet.editor_camera, selected_entity_,
 						viewport_pos, viewport_size, nullptr);
 				
 				ImGui::End();
@@ -532,7 +699,7 @@ void RenderSystem::build_and_execute_rdg(uint32_t frame_index, const RenderPacke
 				ImGui::PopStyleColor(2);
 				
 				// Draw light gizmo at entity position
-				draw_light_gizmo(packet.active_camera, selected_entity_,
+				draw_light_gizmo(packet.editor_camera, selected_entity_,
 						Extent2D{ static_cast<uint32_t>(io.DisplaySize.x),
 								static_cast<uint32_t>(io.DisplaySize.y) });
 			}
@@ -691,16 +858,28 @@ bool RenderSystem::tick(const RenderPacket &packet) {
 	// Use frame_index from packet for multi-threaded safety
 	uint32_t frame_index = packet.frame_index;
 
-	// Update active camera in mesh manager if provided
-	if (packet.active_camera) {
-		mesh_manager_->set_active_camera(packet.active_camera);
+	// Pick this frame's render size from the last measured frame time. GPU timestamps arrive a few
+	// frames late, the controller allows for that; without them the CPU frame time stands in.
+	{
+		float frame_ms = gpu_profiler_ ? gpu_profiler_->get_total_frame_time_ms() : 0.0f;
+		if (frame_ms <= 0.0f) {
+			frame_ms = CpuProfiler::instance().get_current_frame_time();
+		}
+		dynamic_resolution_.update(frame_ms);
+		render_extent_ = dynamic_resolution_.get_render_extent(swapchain_->get_extent());
 	}
 
+	// Render from the snapshot; callers on the game thread that did not extract one get it here
+	const RenderSceneSnapshot *scene = packet.scene;
+	if (!scene) {
+		scene = extract_scene(packet.editor_scene, packet.editor_camera, frame_index);
+	}
+	mesh_manager_->set_scene(scene);
+
 	// Tick managers (collect render data)
 	{
 		PROFILE_SCOPE("RenderSystem_Managers");
 		mesh_manager_->tick();
-		light_manager_->tick(frame_index);
 		update_global_setting();
 	}
 
@@ -713,6 +892,12 @@ bool RenderSystem::tick(const RenderPacket &packet) {
 
 	Extent2D extent = swapchain_->get_extent();
 
+	// Submit asset uploads queued since the last frame as one batch, within the frame budget
+	{
+		PROFILE_SCOPE("RenderSystem_Uploads");
+		backend_->get_upload_batcher().tick();
+	}
+
 	// Start ImGui new frame BEFORE building RDG (UI building happens in EditorUIPass)
 	if (backend_ && show_ui_) {
 		backend_->imgui_new_frame();
@@ -740,11 +925,7 @@ bool RenderSystem::tick(const RenderPacket &packet) {
 		// Depth visualization
 		if (enable_depth_visualize_ && depth_visualize_initialized_ && depth_visualize_pass_ && depth_visualize_texture_view_) {
 			PROFILE_SCOPE("RenderSystem_DepthVisualize");
-			CameraComponent *camera = packet.active_camera;
-			if (!camera && mesh_manager_) {
-				camera = mesh_manager_->get_active_camera();
-			}
-			if (camera) {
+			if (scene->camera.valid) {
 				Extent2D viz_extent = {
 					depth_visualize_texture_->get_info().extent.width,
 					depth_visualize_texture_->get_info().extent.height
@@ -754,8 +935,8 @@ bool RenderSystem::tick(const RenderPacket &packet) {
 						depth_texture_,
 						depth_visualize_texture_view_,
 						viz_extent,
-						camera->get_near(),
-						camera->get_far());
+						scene->camera.near_plane,
+						scene->camera.far_plane);
 			}
 		}
 
@@ -767,6 +948,10 @@ bool RenderSystem::tick(const RenderPacket &packet) {
 
 	swapchain_->present(resource.finish_semaphore);
 
+	// The frame is recorded, the game thread may reuse the snapshot
+	mesh_manager_->set_scene(nullptr);
+	scene_buffer_.release(scene);
+
 	if (backend_) {
 		backend_->tick();
 	}
@@ -774,6 +959,28 @@ bool RenderSystem::tick(const RenderPacket &packet) {
 	return true;
 }
 
+const RenderSceneSnapshot *RenderSystem::extract_scene(Scene *scene, CameraComponent *camera, uint32_t frame_index) {
+	PROFILE_FUNCTION();
+	RenderSceneSnapshot *snapshot = scene_buffer_.acquire();
+
+	if (!camera && mesh_manager_) {
+		camera = mesh_manager_->get_active_camera();
+	}
+	if (!camera && EngineContext::world()) {
+		camera = EngineContext::world()->get_active_camera();
+	}
+	RenderSceneBuffer::extract(scene, camera, light_manager_ ? &light_manager_->get_registry() : nullptr, *snapshot);
+
+	// Shadow lights follow the registry, on the game thread
+	if (light_manager_) {
+		light_manager_->tick(frame_index);
+	}
+	if (mesh_manager_) {
+		snapshot->proxy_batch = mesh_manager_->get_proxy_scene().publish();
+	}
+	return snapshot;
+}
+
 bool RenderSystem::add_custom_ui_callback(const std::string& name, std::function<void()> func) {
 	std::lock_guard<std::mutex> lock(custom_ui_callbacks_mutex_);
 	auto [it, inserted] = custom_ui_callbacks_.emplace(name, std::move(func));
@@ -821,6 +1028,13 @@ void RenderSystem::cleanup_for_test() {
 	
 	// Reset selected entity
 	selected_entity_ = nullptr;
+
+	// Back to full resolution with the controller state cleared
+	dynamic_resolution_.reset();
+	temporal_aa_.reset();
+	if (temporal_aa_pass_) {
+		temporal_aa_pass_->reset_history();
+	}
 	
 	// Wait for any pending GPU operations
 	// Backend validity already checked above, but double-check for safety
@@ -867,6 +1081,8 @@ void RenderSystem::destroy() {
 	
 	// Clear passes
 	editor_ui_pass_.reset();
+	upscale_pass_.reset();
+	temporal_aa_pass_.reset();
 	skybox_pass_.reset();
 	depth_prepass_.reset();
 
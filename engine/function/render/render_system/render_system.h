@@ -6,13 +6,17 @@
 
 #include "engine/function/render/render_system/render_light_manager.h"
 #include "engine/function/render/render_system/render_mesh_manager.h"
+#include "engine/function/render/render_system/render_scene_snapshot.h"
 #include "engine/function/render/render_system/gizmo_manager.h"
 #include "engine/function/render/render_system/gpu_profiler.h"
+#include "engine/function/render/render_system/dynamic_resolution.h"
 #include "engine/function/render/render_pass/forward_pass.h"
 #include "engine/function/render/render_pass/depth_pre_pass.h"
 #include "engine/function/render/render_pass/depth_visualize_pass.h"
 #include "engine/function/render/render_pass/skybox_pass.h"
 #include "engine/function/render/render_pass/editor_ui_pass.h"
+#include "engine/function/render/render_pass/upscale_pass.h"
+#include "engine/function/render/render_pass/temporal_aa_pass.h"
 // #include "engine/function/render/render_system/render_surface_cache_manager.h"
 #include <imgui.h>
 
@@ -37,9 +41,13 @@ struct RenderPacket {
     uint32_t frame_index = 0;       // Frame index this packet belongs to
     float delta_time = 0.0f;        // Time since last frame in seconds
     
-    // Scene data
-    class Scene* active_scene = nullptr;     // Scene to render
-    class CameraComponent* active_camera = nullptr;  // Camera for this frame
+    // Scene data, extracted on the game thread by RenderSystem::extract_scene and released by tick().
+    // Single-threaded callers may leave it unset; tick() then extracts from the editor pointers.
+    const RenderSceneSnapshot* scene = nullptr;
+
+    // Live scene objects, only for the editor panels and gizmos. Rendering reads the snapshot.
+    class Scene* editor_scene = nullptr;
+    class CameraComponent* editor_camera = nullptr;
     
     // Rendering config
     bool enable_forward_pass = true;
@@ -69,6 +77,15 @@ public:
 
     bool tick(const RenderPacket& packet);
 
+    /**
+     * @brief Copy the render-relevant state of scene into a free snapshot (game thread)
+     *
+     * Also publishes the render proxy changes of this game frame. Blocks while every snapshot is
+     * still being rendered. The snapshot belongs to the render thread until tick() releases it.
+     * @param camera Camera to render from; falls back to the mesh manager's and then the world's camera
+     */
+    const RenderSceneSnapshot* extract_scene(Scene* scene, CameraComponent* camera, uint32_t frame_index);
+
     /**
      * @brief Set a custom RDG build function for testing
      * This allows tests to inject custom render passes into the RDG.
@@ -126,6 +143,13 @@ public:
     RHITextureRef get_depth_texture() { return depth_texture_; }
     RHITextureRef get_prepass_depth_texture() { return depth_texture_; }
 
+    /**
+     * @brief Viewport of the scene passes this frame; render targets stay swapchain-sized
+     */
+    Extent2D get_render_extent() const { return render_extent_; }
+    DynamicResolutionController& get_dynamic_resolution() { return dynamic_resolution_; }
+    TemporalAA& get_temporal_aa() { return temporal_aa_; }
+
     /**
      * @brief Cleanup runtime state for testing (keeps system initialized)
      * 
@@ -228,11 +252,23 @@ public:
     std::shared_ptr<RenderLightManager> light_manager_;
     std::shared_ptr<GizmoManager> gizmo_manager_;
 
+    // Scene state handed from the game thread to the render thread
+    RenderSceneBuffer scene_buffer_;
+
     std::shared_ptr<render::DepthVisualizePass> depth_visualize_pass_;
     std::shared_ptr<render::SkyboxPass> skybox_pass_;
     std::shared_ptr<render::ForwardPass> forward_pass_;
     std::shared_ptr<render::DepthPrePass> depth_prepass_;
     std::shared_ptr<render::EditorUIPass> editor_ui_pass_;
+    std::shared_ptr<render::UpscalePass> upscale_pass_;
+    std::shared_ptr<render::TemporalAAPass> temporal_aa_pass_;
+
+    // Dynamic resolution: the scene renders into the top-left render_extent_ of full-size targets
+    DynamicResolutionController dynamic_resolution_;
+    Extent2D render_extent_ = WINDOW_EXTENT;
+
+    // Jitter sequence and camera history; when enabled it resolves and upscales instead of upscale_pass_
+    TemporalAA temporal_aa_;
     
     // Depth buffer visualization
     RHITextureRef depth_visualize_texture_;
@@ -0,0 +1,344 @@
+#include "engine/function/render/render_system/shadow_atlas.h"
+#include "engine/function/render/render_system/frustum_culling.h"
+#include "engine/function/render/render_system/lod_selection.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+uint32_t log2_floor(uint32_t value) {
+    uint32_t level = 0;
+    while (value > 1) {
+        value >>= 1;
+        level++;
+    }
+    return level;
+}
+
+bool is_power_of_two(uint32_t value) {
+    return value != 0 && (value & (value - 1)) == 0;
+}
+
+bool same_vector(const Vec3& a, const Vec3& b) {
+    return a.x == b.x && a.y == b.y && a.z == b.z;
+}
+
+uint32_t face_count_of(const render::ShaderLightData& light) {
+    if (light.type == static_cast<uint32_t>(render::LightType::Point)) return 6;
+    if (light.type == static_cast<uint32_t>(render::LightType::Spot)) return 1;
+    return 0;
+}
+
+} // namespace
+
+void ShadowAtlasAllocator::init(uint32_t atlas_size, uint32_t min_tile_size) {
+    atlas_size_ = atlas_size;
+    min_tile_size_ = min_tile_size;
+    uint32_t level_count = log2_floor(atlas_size / min_tile_size) + 1;
+    states_.assign(level_count, {});
+    free_nodes_.assign(level_count, {});
+    for (uint32_t level = 0; level < level_count; ++level) {
+        uint32_t side = 1u << level;
+        states_[level].assign(side * side, NodeState::Covered);
+    }
+    states_[0][0] = NodeState::Free;
+    free_nodes_[0].insert(0);
+    tile_count_ = 0;
+    used_texels_ = 0;
+}
+
+bool ShadowAtlasAllocator::allocate(uint32_t size, ShadowAtlasTile& tile) {
+    if (!is_power_of_two(size) || size < min_tile_size_ || size > atlas_size_) return false;
+    uint32_t level = log2_floor(atlas_size_ / size);
+    uint32_t node = 0;
+    if (!take_free_node(level, node)) return false;
+    states_[level][node] = NodeState::Used;
+
+    uint32_t side = 1u << level;
+    tile.x = (node % side) * size;
+    tile.y = (node / side) * size;
+    tile.size = size;
+    tile.level = level;
+    tile.node = node;
+    tile_count_++;
+    used_texels_ += static_cast<uint64_t>(size) * size;
+    return true;
+}
+
+void ShadowAtlasAllocator::free(const ShadowAtlasTile& tile) {
+    if (!tile.valid() || states_[tile.level][tile.node] != NodeState::Used) return;
+    tile_count_--;
+    used_texels_ -= static_cast<uint64_t>(tile.size) * tile.size;
+    set_free(tile.level, tile.node);
+}
+
+float ShadowAtlasAllocator::get_occupancy() const {
+    if (atlas_size_ == 0) return 0.0f;
+    return static_cast<float>(static_cast<double>(used_texels_) / (static_cast<double>(atlas_size_) * atlas_size_));
+}
+
+uint32_t ShadowAtlasAllocator::get_largest_free_size() const {
+    for (uint32_t level = 0; level < free_nodes_.size(); ++level) {
+        if (!free_nodes_[level].empty()) return atlas_size_ >> level;
+    }
+    return 0;
+}
+
+bool ShadowAtlasAllocator::take_free_node(uint32_t level, uint32_t& node) {
+    if (!free_nodes_[level].empty()) {
+        node = *free_nodes_[level].begin();
+        free_nodes_[level].erase(free_nodes_[level].begin());
+        return true;
+    }
+    if (level == 0) return false;
+
+    // Split the smallest free ancestor
+    uint32_t parent = 0;
+    if (!take_free_node(level - 1, parent)) return false;
+    states_[level - 1][parent] = NodeState::Split;
+
+    uint32_t parent_side = 1u << (level - 1);
+    uint32_t side = parent_side * 2;
+    uint32_t x = (parent % parent_side) * 2;
+    uint32_t y = (parent / parent_side) * 2;
+    for (uint32_t dy = 0; dy < 2; ++dy) {
+        for (uint32_t dx = 0; dx < 2; ++dx) {
+            uint32_t child = (y + dy) * side + x + dx;
+            states_[level][child] = NodeState::Free;
+            free_nodes_[level].insert(child);
+        }
+    }
+    node = *free_nodes_[level].begin();
+    free_nodes_[level].erase(free_nodes_[level].begin());
+    return true;
+}
+
+void ShadowAtlasAllocator::set_free(uint32_t level, uint32_t node) {
+    states_[level][node] = NodeState::Free;
+    free_nodes_[level].insert(node);
+    if (level == 0) return;
+
+    uint32_t side = 1u << level;
+    uint32_t x = (node % side) & ~1u;
+    uint32_t y = (node / side) & ~1u;
+    uint32_t siblings[4] = {y * side + x, y * side + x + 1, (y + 1) * side + x, (y + 1) * side + x + 1};
+    for (uint32_t sibling : siblings) {
+        if (states_[level][sibling] != NodeState::Free) return;
+    }
+
+    // All four children are free again: merge them into their parent
+    for (uint32_t sibling : siblings) {
+        states_[level][sibling] = NodeState::Covered;
+        free_nodes_[level].erase(sibling);
+    }
+    set_free(level - 1, (y / 2) * (side / 2) + x / 2);
+}
+
+void ShadowAtlas::init(uint32_t atlas_size, uint32_t min_tile_size, uint32_t max_tile_size) {
+    allocator_.init(atlas_size, min_tile_size);
+    max_tile_size_ = (std::min)(max_tile_size, atlas_size);
+    states_.clear();
+    lights_.clear();
+    updates_.clear();
+    last_stats_ = ShadowAtlasStats{};
+}
+
+uint32_t ShadowAtlas::desired_tile_size(float importance) const {
+    float wanted = static_cast<float>(max_tile_size_) * (std::min)(importance, 1.0f);
+    uint32_t size = allocator_.get_min_tile_size();
+    while (static_cast<float>(size) < wanted && size < max_tile_size_) size *= 2;
+    return size;
+}
+
+void ShadowAtlas::invalidate(const BoundingSphere& bounds) {
+    for (auto& [id, state] : states_) {
+        if (state.tile_size == 0) continue;
+        float reach = state.light.range + bounds.radius;
+        if ((state.light.position - bounds.center).squared_length() < reach * reach) {
+            state.dirty_faces = (1u << state.face_count) - 1;
+        }
+    }
+}
+
+void ShadowAtlas::invalidate(const BoundingBox& box) {
+    invalidate(BoundingSphere{(box.min + box.max) * 0.5f, (box.max - box.min).length() * 0.5f});
+}
+
+void ShadowAtlas::update(const std::vector<ShadowAtlasRequest>& requests, const Frustum& frustum, const Vec3& eye,
+                         float projection_scale) {
+    timer_.reset();
+    frame_++;
+    ShadowAtlasStats stats;
+    stats.request_count = static_cast<uint32_t>(requests.size());
+
+    visible_ids_.clear();
+    order_.clear();
+    for (const ShadowAtlasRequest& request : requests) {
+        uint32_t face_count = face_count_of(request.light);
+        if (face_count == 0 || request.light.range <= 0.0f) continue;
+
+        BoundingSphere sphere{request.light.position, request.light.range};
+        Vec3 extent(sphere.radius, sphere.radius, sphere.radius);
+        if (!FrustumCuller::is_visible(frustum, sphere, BoundingBox{sphere.center - extent, sphere.center + extent})) continue;
+        stats.visible_count++;
+
+        LightState& state = states_[request.light_id];
+        if (state.face_count != face_count) {
+            release(state);
+            state.face_count = face_count;
+        } else if (state.tile_size != 0 && light_changed(state.light, request.light)) {
+            state.dirty_faces = (1u << face_count) - 1;
+        }
+        state.light = request.light;
+        state.seen_frame = frame_;
+        // A camera inside the range sees the light fill the screen
+        state.importance = (std::min)(LodSelector::projected_size(sphere, eye, projection_scale), 1.0f);
+        state.desired_size = desired_tile_size(state.importance);
+
+        visible_ids_.push_back(request.light_id);
+        order_.push_back({state.importance, request.light_id});
+    }
+
+    // Lights that left the view or stopped casting give their tiles back
+    for (auto it = states_.begin(); it != states_.end();) {
+        if (it->second.seen_frame != frame_) {
+            release(it->second);
+            it = states_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    // Most important lights pick first and may take space from the least important ones
+    std::sort(order_.begin(), order_.end(), [](const auto& a, const auto& b) {
+        return a.first != b.first ? a.first > b.first : a.second < b.second;
+    });
+    size_t victim = order_.size();
+    for (size_t i = 0; i < order_.size(); ++i) {
+        LightState& state = states_[order_[i].second];
+        bool grow = state.desired_size > state.tile_size;
+        bool shrink = state.desired_size * 4 <= state.tile_size;
+        if (state.tile_size != 0 && !grow && !shrink) continue;
+
+        release(state);
+        bool allocated = allocate(state, state.desired_size);
+        while (!allocated) {
+            while (victim > i + 1 && states_[order_[victim - 1].second].tile_size == 0) victim--;
+            if (victim <= i + 1) break;
+            release(states_[order_[--victim].second]);
+            allocated = allocate(state, state.desired_size);
+        }
+        if (allocated) {
+            stats.allocations++;
+        } else {
+            stats.failed++;
+        }
+    }
+
+    // Output the placed lights and gather their dirty faces
+    lights_.clear();
+    candidates_.clear();
+    uint32_t face_total = 0;
+    float atlas_size = static_cast<float>(allocator_.get_atlas_size());
+    for (uint32_t id : visible_ids_) {
+        LightState& state = states_[id];
+        if (state.tile_size == 0) continue;
+
+        uint32_t index = static_cast<uint32_t>(lights_.size());
+        ShadowAtlasLight& light = lights_.emplace_back();
+        light.light_id = id;
+        light.face_count = state.face_count;
+        light.importance = state.importance;
+        for (uint32_t face = 0; face < state.face_count; ++face) {
+            const ShadowAtlasTile& tile = state.tiles[face];
+            light.tiles[face] = tile;
+            light.view_proj[face] = face_view_proj(state.light, face);
+            light.uv_rects[face] = Vec4(tile.size / atlas_size, tile.size / atlas_size, tile.x / atlas_size, tile.y / atlas_size);
+            if (state.dirty_faces & (1u << face)) {
+                state.wait[face]++;
+                candidates_.push_back({state.importance * static_cast<float>(state.wait[face]), ShadowAtlasUpdate{index, face}});
+            }
+        }
+        face_total += state.face_count;
+    }
+
+    // Only the budget of faces is rendered; the longer a face waited, the higher it ranks
+    std::stable_sort(candidates_.begin(), candidates_.end(), [](const auto& a, const auto& b) { return a.first > b.first; });
+    updates_.clear();
+    for (const auto& [priority, update] : candidates_) {
+        if (updates_.size() == update_budget_) break;
+        LightState& state = states_[lights_[update.light].light_id];
+        state.dirty_faces &= ~(1u << update.face);
+        state.rendered_faces |= 1u << update.face;
+        state.wait[update.face] = 0;
+        updates_.push_back(update);
+    }
+    for (ShadowAtlasLight& light : lights_) {
+        const LightState& state = states_[light.light_id];
+        light.ready = state.rendered_faces == (1u << state.face_count) - 1;
+    }
+
+    stats.light_count = static_cast<uint32_t>(lights_.size());
+    stats.tile_count = allocator_.get_tile_count();
+    stats.occupancy = allocator_.get_occupancy();
+    stats.updates = static_cast<uint32_t>(updates_.size());
+    stats.pending = static_cast<uint32_t>(candidates_.size() - updates_.size());
+    stats.cached = face_total - static_cast<uint32_t>(candidates_.size());
+    stats.update_ms = timer_.get_total_ms();
+    last_stats_ = stats;
+}
+
+void ShadowAtlas::release(LightState& state) {
+    for (ShadowAtlasTile& tile : state.tiles) {
+        allocator_.free(tile);
+        tile = ShadowAtlasTile{};
+    }
+    state.tile_size = 0;
+    state.dirty_faces = 0;
+    state.rendered_faces = 0;
+    state.wait = {};
+}
+
+bool ShadowAtlas::allocate(LightState& state, uint32_t size) {
+    for (; size >= allocator_.get_min_tile_size(); size /= 2) {
+        uint32_t face = 0;
+        while (face < state.face_count && allocator_.allocate(size, state.tiles[face])) face++;
+        if (face == state.face_count) {
+            state.tile_size = size;
+            state.dirty_faces = (1u << state.face_count) - 1;
+            state.rendered_faces = 0;
+            state.wait = {};
+            return true;
+        }
+        // Not every face fits at this size: give back the ones that did and try smaller tiles
+        for (uint32_t i = 0; i < face; ++i) {
+            allocator_.free(state.tiles[i]);
+            state.tiles[i] = ShadowAtlasTile{};
+        }
+    }
+    return false;
+}
+
+bool ShadowAtlas::light_changed(const render::ShaderLightData& a, const render::ShaderLightData& b) {
+    // Color and intensity do not change the shadow map
+    return !same_vector(a.position, b.position) || !same_vector(a.direction, b.direction) || a.range != b.range ||
+           a.outer_angle != b.outer_angle;
+}
+
+Mat4 ShadowAtlas::face_view_proj(const render::ShaderLightData& light, uint32_t face) {
+    const Vec3& pos = light.position;
+    if (light.type == static_cast<uint32_t>(render::LightType::Spot)) {
+        Vec3 dir = light.direction.normalized();
+        Vec3 up = std::abs(dir.y) > 0.99f ? Vec3::UnitZ() : Vec3::UnitY();
+        float fov = 2.0f * std::acos(std::clamp(light.outer_angle, 0.0f, 1.0f));
+        fov = std::clamp(fov, Math::to_radians(1.0f), Math::to_radians(179.0f));
+        return Math::look_at(pos, pos + dir, up) * Math::perspective(fov, 1.0f, NEAR_PLANE, light.range);
+    }
+
+    // Cube faces in the same order and orientation as PointLightComponent::update_light_info
+    static const Vec3 FRONTS[6] = {Vec3::UnitX(), -Vec3::UnitX(), Vec3::UnitY(), -Vec3::UnitY(), Vec3::UnitZ(), -Vec3::UnitZ()};
+    static const Vec3 UPS[6] = {-Vec3::UnitY(), -Vec3::UnitY(), Vec3::UnitZ(), -Vec3::UnitZ(), -Vec3::UnitY(), -Vec3::UnitY()};
+    return Math::look_at(pos, pos + FRONTS[face], UPS[face]) *
+           Math::perspective(Math::to_radians(90.0f), 1.0f, NEAR_PLANE, light.range);
+}
@@ -0,0 +1,212 @@
+#pragma once
+
+#include "engine/function/render/render_pass/deferred_lighting_pass.h"
+#include "engine/function/render/data/render_structs.h"
+#include "engine/core/math/math.h"
+#include "engine/core/utils/timer.h"
+#include <array>
+#include <cstdint>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Square region of the shadow atlas, in texels
+ */
+struct ShadowAtlasTile {
+    uint32_t x = 0;
+    uint32_t y = 0;
+    uint32_t size = 0;              // 0: no tile
+    uint32_t level = 0;             // Quadtree level; the whole atlas is level 0
+    uint32_t node = 0;              // Node index within the level, y * (1 << level) + x / size
+
+    inline bool valid() const { return size != 0; }
+};
+
+/**
+ * @brief Quadtree allocator of power-of-two tiles in a square atlas
+ *
+ * A node is free, used, split into four children, or covered by a free or used ancestor. An
+ * allocation takes the lowest free node of its level, splitting the smallest free ancestor when
+ * the level has none, so small tiles fill up partially used regions before new ones are opened.
+ * Freeing a node merges it with its three siblings once all of them are free again.
+ */
+class ShadowAtlasAllocator {
+public:
+    void init(uint32_t atlas_size, uint32_t min_tile_size);
+
+    /**
+     * @param size Tile size, a power of two between the minimum tile size and the atlas size
+     * @return false if no free region of that size is left
+     */
+    bool allocate(uint32_t size, ShadowAtlasTile& tile);
+    void free(const ShadowAtlasTile& tile);
+
+    inline uint32_t get_atlas_size() const { return atlas_size_; }
+    inline uint32_t get_min_tile_size() const { return min_tile_size_; }
+    inline uint32_t get_tile_count() const { return tile_count_; }
+    inline uint64_t get_used_texels() const { return used_texels_; }
+    float get_occupancy() const;
+
+    /**
+     * @brief Size of the largest tile that could be allocated now, 0 if the atlas is full
+     */
+    uint32_t get_largest_free_size() const;
+
+private:
+    enum class NodeState : uint8_t { Covered, Free, Used, Split };
+
+    bool take_free_node(uint32_t level, uint32_t& node);
+    void set_free(uint32_t level, uint32_t node);
+
+    uint32_t atlas_size_ = 0;
+    uint32_t min_tile_size_ = 0;
+    std::vector<std::vector<NodeState>> states_;    // Per level
+    std::vector<std::set<uint32_t>> free_nodes_;    // Per level, ordered so allocation is deterministic
+    uint32_t tile_count_ = 0;
+    uint64_t used_texels_ = 0;
+};
+
+/**
+ * @brief Point or spot light that wants a shadow this frame
+ */
+struct ShadowAtlasRequest {
+    uint32_t light_id = 0;          // Stable id of the light, see RenderLightRegistry::get_light_ids
+    render::ShaderLightData light = {};
+};
+
+/**
+ * @brief Atlas placement of one shadowed light
+ */
+struct ShadowAtlasLight {
+    uint32_t light_id = 0;
+    uint32_t face_count = 0;        // 6 for point lights (cube faces), 1 for spot lights
+    std::array<ShadowAtlasTile, 6> tiles;
+    std::array<Mat4, 6> view_proj;
+    std::array<Vec4, 6> uv_rects;   // Per face: atlas UV scale xy and offset zw
+    float importance = 0.0f;        // Projected size of the light's range sphere
+    bool ready = false;             // Every face was rendered at its current tile
+};
+
+/**
+ * @brief One atlas tile to render this frame
+ */
+struct ShadowAtlasUpdate {
+    uint32_t light = 0;             // Index into ShadowAtlas::get_lights()
+    uint32_t face = 0;
+};
+
+struct ShadowAtlasStats {
+    uint32_t request_count = 0;     // Shadow casting point and spot lights
+    uint32_t visible_count = 0;     // Of those, range sphere in the view frustum
+    uint32_t light_count = 0;       // Lights holding tiles
+    uint32_t failed = 0;            // Visible lights that found no space
+    uint32_t tile_count = 0;
+    float occupancy = 0.0f;         // Used texels / atlas texels
+    uint32_t allocations = 0;       // Lights (re)allocated this frame
+    uint32_t updates = 0;           // Faces rendered this frame
+    uint32_t cached = 0;            // Faces reused without rendering
+    uint32_t pending = 0;           // Dirty faces left for later frames by the budget
+    float update_ms = 0.0f;
+};
+
+/**
+ * @brief Shadow atlas of point and spot lights: tile sizes by screen importance, cached static tiles
+ *
+ * The importance of a light is the projected size of its range sphere (1: half the screen height).
+ * It picks the tile size, a power of two up to the maximum tile size; point lights get six tiles
+ * of that size, one per cube face. Lights grow their tiles immediately but only shrink once they
+ * want at most a quarter of the current size, so a light near a size boundary keeps its tiles.
+ * Lights outside the view frustum give their tiles back, and lights are (re)allocated in order of
+ * importance, falling back to smaller tiles when the atlas is full.
+ *
+ * A face has to be rendered when its tile is new, its light moved or changed, or a shadow caster
+ * moved within the light's range (invalidate()). Otherwise the cached tile is reused. At most the
+ * update budget of faces is rendered per frame, picked by importance times the frames they waited,
+ * so the rest of the dirty faces follow in later frames and none of them starve. A light is only
+ * ready to be sampled once every face was rendered at its current tile.
+ */
+class ShadowAtlas {
+public:
+    static constexpr uint32_t DEFAULT_ATLAS_SIZE = 8192;
+    static constexpr uint32_t DEFAULT_MIN_TILE_SIZE = 64;
+    static constexpr uint32_t DEFAULT_MAX_TILE_SIZE = 1024;
+    static constexpr uint32_t DEFAULT_UPDATE_BUDGET = 24;      // Faces per frame, four point lights
+    static constexpr float NEAR_PLANE = 0.05f;
+
+    ShadowAtlas() { init(DEFAULT_ATLAS_SIZE, DEFAULT_MIN_TILE_SIZE, DEFAULT_MAX_TILE_SIZE); }
+
+    /**
+     * @brief Reset the atlas; every light is allocated again on the next update
+     */
+    void init(uint32_t atlas_size, uint32_t min_tile_size, uint32_t max_tile_size);
+
+    void set_update_budget(uint32_t faces) { update_budget_ = faces; }
+    uint32_t get_update_budget() const { return update_budget_; }
+
+    /**
+     * @brief Tile size for a projected size: max_tile_size * importance, rounded up to a power of two
+     */
+    uint32_t desired_tile_size(float importance) const;
+
+    /**
+     * @brief Mark every face of the lights reaching bounds as dirty, e.g. when a caster moved
+     */
+    void invalidate(const BoundingSphere& bounds);
+    void invalidate(const BoundingBox& box);
+
+    /**
+     * @brief Place this frame's shadowed lights and pick the faces to render
+     * @param eye Camera position
+     * @param projection_scale projection.m[1][1] of the camera
+     */
+    void update(const std::vector<ShadowAtlasRequest>& requests, const Frustum& frustum, const Vec3& eye,
+                float projection_scale);
+
+    /**
+     * @brief Visible lights holding tiles, in request order
+     */
+    inline const std::vector<ShadowAtlasLight>& get_lights() const { return lights_; }
+
+    /**
+     * @brief Faces to render this frame, most important first
+     */
+    inline const std::vector<ShadowAtlasUpdate>& get_updates() const { return updates_; }
+
+    inline const ShadowAtlasAllocator& get_allocator() const { return allocator_; }
+    inline const ShadowAtlasStats& get_last_stats() const { return last_stats_; }
+
+private:
+    struct LightState {
+        render::ShaderLightData light = {};    // As of the last update
+        std::array<ShadowAtlasTile, 6> tiles;
+        uint32_t face_count = 0;
+        uint32_t tile_size = 0;
+        uint32_t dirty_faces = 0;           // Bit per face: must be rendered
+        uint32_t rendered_faces = 0;        // Bit per face: rendered at the current tile
+        std::array<uint32_t, 6> wait = {};  // Frames each dirty face has waited
+        float importance = 0.0f;
+        uint32_t desired_size = 0;
+        uint64_t seen_frame = 0;
+    };
+
+    void release(LightState& state);
+    bool allocate(LightState& state, uint32_t size);
+    static bool light_changed(const render::ShaderLightData& a, const render::ShaderLightData& b);
+    static Mat4 face_view_proj(const render::ShaderLightData& light, uint32_t face);
+
+    ShadowAtlasAllocator allocator_;
+    uint32_t max_tile_size_ = DEFAULT_MAX_TILE_SIZE;
+    uint32_t update_budget_ = DEFAULT_UPDATE_BUDGET;
+    uint64_t frame_ = 0;
+
+    std::unordered_map<uint32_t, LightState> states_;
+    std::vector<uint32_t> visible_ids_;
+    std::vector<std::pair<float, uint32_t>> order_;
+    std::vector<std::pair<float, ShadowAtlasUpdate>> candidates_;
+    std::vector<ShadowAtlasLight> lights_;
+    std::vector<ShadowAtlasUpdate> updates_;
+
+    Timer timer_;
+    ShadowAtlasStats last_stats_;
+};
@@ -0,0 +1,120 @@
+#include "engine/function/render/render_system/shadow_cascades.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// Cascade radii are rounded up to this step so float noise in the fit cannot change the texel size
+constexpr float CASCADE_RADIUS_STEP = 1.0f / 16.0f;
+
+} // namespace
+
+void ShadowCascadeBuilder::compute_splits(float near_plane, float far_plane, float lambda, uint32_t count, float* splits) {
+    for (uint32_t i = 0; i <= count; ++i) {
+        float f = static_cast<float>(i) / static_cast<float>(count);
+        float logarithmic = near_plane * std::pow(far_plane / near_plane, f);
+        float uniform = near_plane + (far_plane - near_plane) * f;
+        splits[i] = lambda * logarithmic + (1.0f - lambda) * uniform;
+    }
+    splits[0] = near_plane;
+    splits[count] = far_plane;
+}
+
+ShadowCascade ShadowCascadeBuilder::fit_cascade(const Mat4& inv_view, const Mat4& projection,
+                                                float split_near, float split_far, const Vec3& light_dir, uint32_t resolution) {
+    ShadowCascade cascade;
+    cascade.split_near = split_near;
+    cascade.split_far = split_far;
+
+    // Smallest sphere around the slice, in view space where it only depends on the split depths and
+    // the field of view: its center sits on the view axis, equally far from the near and far corners
+    float tan_sq = 1.0f / (projection.m[0][0] * projection.m[0][0]) + 1.0f / (projection.m[1][1] * projection.m[1][1]);
+    float near_sq = split_near * split_near * tan_sq;      // Squared half diagonals of the slice ends
+    float far_sq = split_far * split_far * tan_sq;
+    float center_z = 0.5f * (split_near + split_far) + 0.5f * (far_sq - near_sq) / (split_far - split_near);
+    center_z = (std::min)(center_z, split_far);
+    float radius = std::sqrt((split_far - center_z) * (split_far - center_z) + far_sq);
+    radius = std::ceil(radius / CASCADE_RADIUS_STEP) * CASCADE_RADIUS_STEP;
+    Vec3 center = (Vec4(0.0f, 0.0f, center_z, 1.0f) * inv_view).xyz();
+    cascade.sphere = BoundingSphere{center, radius};
+
+    Vec3 dir = light_dir.normalized();
+    Vec3 up = std::abs(dir.y) > 0.99f ? Vec3::UnitZ() : Vec3::UnitY();
+    cascade.eye = center - dir * radius;
+    cascade.view = Math::look_at(cascade.eye, center, up);
+    cascade.proj = Math::ortho(-radius, radius, -radius, radius, 0.0f, 2.0f * radius);
+
+    // Snap: offset the projection so the world origin falls on a texel corner
+    float half_resolution = 0.5f * static_cast<float>(resolution);
+    Vec4 origin = Vec4(0.0f, 0.0f, 0.0f, 1.0f) * (cascade.view * cascade.proj);
+    float origin_x = origin.x * half_resolution;
+    float origin_y = origin.y * half_resolution;
+    cascade.proj.m[3][0] += (std::round(origin_x) - origin_x) / half_resolution;
+    cascade.proj.m[3][1] += (std::round(origin_y) - origin_y) / half_resolution;
+    cascade.texel_size = 2.0f * radius / static_cast<float>(resolution);
+
+    set_depth_range(cascade, 0.0f, 2.0f * radius);
+
+    cascade.caster_frustum = extract_frustum(cascade.view_proj);
+    cascade.caster_frustum.planes[4] = Vec4(0.0f, 0.0f, 0.0f, 1.0f);   // Near: everything towards the light
+    return cascade;
+}
+
+void ShadowCascadeBuilder::set_depth_range(ShadowCascade& cascade, float depth_near, float depth_far) {
+    // Orthographic LH depth: z' = (z - near) / (far - near)
+    cascade.depth_near = depth_near;
+    cascade.depth_far = depth_far;
+    cascade.proj.m[2][2] = 1.0f / (depth_far - depth_near);
+    cascade.proj.m[3][2] = -depth_near / (depth_far - depth_near);
+    cascade.view_proj = cascade.view * cascade.proj;
+}
+
+void ShadowCascadeBuilder::update(const Mat4& view, const Mat4& projection, float near_plane, float far_plane,
+                                  const Vec3& light_dir, float split_lambda) {
+    timer_.reset();
+    stats_ = ShadowCascadeStats{};
+    stats_.cascade_count = DIRECTIONAL_SHADOW_CASCADE_LEVEL;
+
+    float splits[DIRECTIONAL_SHADOW_CASCADE_LEVEL + 1];
+    compute_splits(near_plane, (std::min)(far_plane, max_distance_), split_lambda, DIRECTIONAL_SHADOW_CASCADE_LEVEL, splits);
+
+    Mat4 inv_view = view.inverse();
+    for (uint32_t c = 0; c < DIRECTIONAL_SHADOW_CASCADE_LEVEL; ++c) {
+        cascades_[c] = fit_cascade(inv_view, projection, splits[c], splits[c + 1], light_dir, resolution_);
+        stats_.split_far[c] = cascades_[c].split_far;
+        stats_.texel_size[c] = cascades_[c].texel_size;
+    }
+}
+
+void ShadowCascadeBuilder::cull_casters(const CullingBounds& bounds, const std::vector<uint8_t>& casts_shadow, ThreadPool* pool) {
+    stats_.object_count = static_cast<uint32_t>(bounds.size());
+    if (!casts_shadow.empty()) {
+        stats_.non_casters = static_cast<uint32_t>(std::count(casts_shadow.begin(), casts_shadow.end(), uint8_t(0)));
+    }
+
+    for (uint32_t c = 0; c < DIRECTIONAL_SHADOW_CASCADE_LEVEL; ++c) {
+        ShadowCascade& cascade = cascades_[c];
+        std::vector<uint32_t>& casters = casters_[c];
+        culler_.cull(cascade.caster_frustum, bounds, casters, pool);
+        if (!casts_shadow.empty()) {
+            casters.erase(std::remove_if(casters.begin(), casters.end(), [&](uint32_t index) { return !casts_shadow[index]; }),
+                          casters.end());
+        }
+
+        // Pull the near plane back to the caster closest to the light
+        Vec3 dir = (cascade.sphere.center - cascade.eye).normalized();
+        float depth_near = 0.0f;
+        for (uint32_t index : casters) {
+            Vec3 center(bounds.center_x[index], bounds.center_y[index], bounds.center_z[index]);
+            depth_near = (std::min)(depth_near, (center - cascade.eye).dot(dir) - bounds.radius[index]);
+        }
+        set_depth_range(cascade, depth_near, cascade.depth_far);
+
+        stats_.casters[c] = static_cast<uint32_t>(casters.size());
+        stats_.caster_total += stats_.casters[c];
+    }
+
+    stats_.update_ms = timer_.get_elapsed_ms();
+    last_stats_ = stats_;
+}
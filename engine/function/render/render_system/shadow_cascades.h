@@ -0,0 +1,117 @@
+#pragma once
+
+#include "engine/function/render/render_system/frustum_culling.h"
+#include "engine/function/render/data/render_structs.h"
+#include "engine/core/math/math.h"
+#include "engine/core/utils/timer.h"
+#include <array>
+#include <cstdint>
+#include <vector>
+
+class ThreadPool;
+
+/**
+ * @brief Orthographic shadow view of one slice of the camera frustum
+ */
+struct ShadowCascade {
+    float split_near = 0.0f;        // View depth range of the slice
+    float split_far = 0.0f;
+    Mat4 view = Mat4::Identity();
+    Mat4 proj = Mat4::Identity();
+    Mat4 view_proj = Mat4::Identity();
+    Vec3 eye = Vec3::Zero();        // Light-space origin, on the light side of the slice
+    float depth_near = 0.0f;        // Light-space depth range, widened to the casters in front of the slice
+    float depth_far = 0.0f;
+    BoundingSphere sphere;          // World-space bounds of the slice
+    float texel_size = 0.0f;        // World units per shadow map texel
+    Frustum caster_frustum;         // Side and far planes of the cascade; the near plane is pushed to the light
+};
+
+struct ShadowCascadeStats {
+    uint32_t cascade_count = 0;
+    uint32_t object_count = 0;      // Proxies tested against every cascade
+    uint32_t non_casters = 0;       // Proxies whose material does not cast shadows
+    std::array<uint32_t, DIRECTIONAL_SHADOW_CASCADE_LEVEL> casters = {};
+    uint32_t caster_total = 0;      // Sum over the cascades, the draws a shadow pass would record
+    std::array<float, DIRECTIONAL_SHADOW_CASCADE_LEVEL> split_far = {};
+    std::array<float, DIRECTIONAL_SHADOW_CASCADE_LEVEL> texel_size = {};
+    float update_ms = 0.0f;
+};
+
+/**
+ * @brief Cascaded shadow maps of the main directional light: splits, fitting and caster lists
+ *
+ * The view depth range up to the shadow distance is split with the practical split scheme, a
+ * blend of logarithmic and uniform splits. Each slice is bounded by its smallest enclosing sphere,
+ * computed in view space, so the cascade size does not change when the camera moves or rotates.
+ * The orthographic projection is then offset so the world origin lands on a texel corner, which
+ * keeps the texel grid fixed in the world while the camera moves and removes shimmering edges.
+ *
+ * A shadow caster may lie anywhere between the light and the slice, so the caster volume of a
+ * cascade is its box with the near plane removed. Casters are culled against it with the SIMD
+ * frustum culler, and the depth range of the cascade is widened to the nearest caster.
+ */
+class ShadowCascadeBuilder {
+public:
+    static constexpr uint32_t DEFAULT_RESOLUTION = 2048;
+    static constexpr float DEFAULT_MAX_DISTANCE = 150.0f;
+    static constexpr float DEFAULT_SPLIT_LAMBDA = 0.95f;
+
+    /**
+     * @brief Practical split scheme: lerp(uniform, logarithmic, lambda)
+     * @param splits Output, count + 1 view depths from near_plane to far_plane
+     */
+    static void compute_splits(float near_plane, float far_plane, float lambda, uint32_t count, float* splits);
+
+    /**
+     * @brief Fit a texel-snapped orthographic cascade around one slice of the camera frustum
+     * @param inv_view Inverse of the camera view matrix
+     * @param projection Symmetric perspective projection of the camera
+     * @param light_dir Direction the light travels
+     */
+    static ShadowCascade fit_cascade(const Mat4& inv_view, const Mat4& projection,
+                                     float split_near, float split_far, const Vec3& light_dir, uint32_t resolution);
+
+    /**
+     * @brief Set the light-space depth range of a cascade, keeping its snapped x/y
+     */
+    static void set_depth_range(ShadowCascade& cascade, float depth_near, float depth_far);
+
+    /**
+     * @brief Split the camera frustum and fit every cascade
+     */
+    void update(const Mat4& view, const Mat4& projection, float near_plane, float far_plane,
+                const Vec3& light_dir, float split_lambda);
+
+    /**
+     * @brief Build the caster list of every cascade and widen its depth range to them
+     * @param casts_shadow Per proxy, non-zero if it casts shadows; empty treats every proxy as a caster
+     * @param pool Optional thread pool for the frustum culler
+     */
+    void cull_casters(const CullingBounds& bounds, const std::vector<uint8_t>& casts_shadow, ThreadPool* pool = nullptr);
+
+    void set_resolution(uint32_t resolution) { resolution_ = resolution; }
+    uint32_t get_resolution() const { return resolution_; }
+    void set_max_distance(float distance) { max_distance_ = distance; }
+    float get_max_distance() const { return max_distance_; }
+
+    inline uint32_t get_cascade_count() const { return DIRECTIONAL_SHADOW_CASCADE_LEVEL; }
+    inline const ShadowCascade& get_cascade(uint32_t cascade) const { return cascades_[cascade]; }
+
+    /**
+     * @brief Proxy indices of the casters of a cascade, in ascending order
+     */
+    inline const std::vector<uint32_t>& get_casters(uint32_t cascade) const { return casters_[cascade]; }
+
+    inline const ShadowCascadeStats& get_last_stats() const { return last_stats_; }
+
+private:
+    std::array<ShadowCascade, DIRECTIONAL_SHADOW_CASCADE_LEVEL> cascades_;
+    std::array<std::vector<uint32_t>, DIRECTIONAL_SHADOW_CASCADE_LEVEL> casters_;
+    FrustumCuller culler_;
+    uint32_t resolution_ = DEFAULT_RESOLUTION;
+    float max_distance_ = DEFAULT_MAX_DISTANCE;
+    Timer timer_;
+    ShadowCascadeStats stats_;
+    ShadowCascadeStats last_stats_;
+};
@@ -0,0 +1,101 @@
+#include "engine/function/render/render_system/temporal_aa.h"
+
+#include <algorithm>
+#include <cmath>
+
+float TemporalAA::halton(uint32_t index, uint32_t base) {
+    float fraction = 1.0f;
+    float result = 0.0f;
+    while (index > 0) {
+        fraction /= static_cast<float>(base);
+        result += fraction * static_cast<float>(index % base);
+        index /= base;
+    }
+    return result;
+}
+
+Vec2 TemporalAA::jitter_offset(uint32_t frame, uint32_t phase_count) {
+    // Index 0 of the sequence is (0, 0) in both bases, so the cycle starts at 1
+    uint32_t index = frame % (std::max)(phase_count, 1u) + 1;
+    return Vec2(halton(index, 2) - 0.5f, halton(index, 3) - 0.5f);
+}
+
+Vec2 TemporalAA::jitter_to_ndc(Vec2 jitter_pixels, Extent2D render_extent) {
+    // NDC y points up, pixel rows go down
+    return Vec2(2.0f * jitter_pixels.x / static_cast<float>((std::max)(render_extent.width, 1u)),
+                -2.0f * jitter_pixels.y / static_cast<float>((std::max)(render_extent.height, 1u)));
+}
+
+Mat4 TemporalAA::jitter_projection(const Mat4& projection, Vec2 jitter_pixels, Extent2D render_extent) {
+    // clip.xy += jitter * clip.w, which is a fixed NDC offset for any projection
+    Vec2 ndc = jitter_to_ndc(jitter_pixels, render_extent);
+    Mat4 jittered = projection;
+    for (int row = 0; row < 4; ++row) {
+        jittered.m[row][0] += ndc.x * projection.m[row][3];
+        jittered.m[row][1] += ndc.y * projection.m[row][3];
+    }
+    return jittered;
+}
+
+Vec2 TemporalAA::project_to_uv(const Vec3& world, const Mat4& view_projection) {
+    Vec4 clip = Vec4(world.x, world.y, world.z, 1.0f) * view_projection;
+    float inv_w = 1.0f / clip.w;
+    return Vec2(clip.x * inv_w * 0.5f + 0.5f, 0.5f - clip.y * inv_w * 0.5f);
+}
+
+Vec2 TemporalAA::velocity(const Vec3& world, const Vec3& prev_world, const Mat4& view_projection,
+                          const Mat4& prev_view_projection) {
+    return project_to_uv(world, view_projection) - project_to_uv(prev_world, prev_view_projection);
+}
+
+Vec3 TemporalAA::clip_to_box(const Vec3& history, const Vec3& box_min, const Vec3& box_max) {
+    Vec3 center = (box_min + box_max) * 0.5f;
+    Vec3 half = (box_max - box_min) * 0.5f + Vec3(1e-5f, 1e-5f, 1e-5f);
+    Vec3 offset = history - center;
+    float units = (std::max)({std::abs(offset.x) / half.x, std::abs(offset.y) / half.y, std::abs(offset.z) / half.z});
+    return units > 1.0f ? center + offset / units : history;
+}
+
+float TemporalAA::sample_weight(Vec2 offset) {
+    // Gaussian fit of a Blackman-Harris window of width 3.3 pixels
+    return std::exp(-2.29f * offset.squared_length());
+}
+
+void TemporalAA::set_settings(const TemporalAASettings& settings) {
+    settings_ = settings;
+    settings_.jitter_phases = (std::max)(settings_.jitter_phases, 1u);
+    settings_.history_weight = std::clamp(settings_.history_weight, 0.0f, 0.99f);
+    settings_.clamp_gamma = (std::max)(settings_.clamp_gamma, 0.0f);
+}
+
+void TemporalAA::set_enabled(bool enable) {
+    if (enable == enabled_) return;
+    enabled_ = enable;
+    reset();
+}
+
+const TemporalAAView& TemporalAA::begin_frame(const Mat4& view, const Mat4& projection, Extent2D render_extent,
+                                              Extent2D output_extent) {
+    Mat4 view_projection = view * projection;
+    if (output_extent != output_extent_) {
+        output_extent_ = output_extent;
+        view_.frame = 0;
+    }
+
+    // Motion vectors are kept up to date without the pass too; only the jitter depends on it
+    view_.history_valid = enabled_ && view_.frame > 0;
+    view_.prev_view_projection = view_.frame > 0 ? view_.view_projection : view_projection;
+    view_.view_projection = view_projection;
+    view_.jitter_pixels = enabled_ ? jitter_offset(sequence_++, settings_.jitter_phases) : Vec2::Zero();
+    view_.jitter_ndc = jitter_to_ndc(view_.jitter_pixels, render_extent);
+    view_.projection = enabled_ ? jitter_projection(projection, view_.jitter_pixels, render_extent) : projection;
+    view_.inv_view_projection = (view * view_.projection).inverse();
+    view_.frame++;
+    return view_;
+}
+
+void TemporalAA::reset() {
+    sequence_ = 0;
+    view_.frame = 0;
+    view_.history_valid = false;
+}
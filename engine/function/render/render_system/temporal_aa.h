@@ -0,0 +1,106 @@
+#pragma once
+
+#include "engine/core/math/math.h"
+#include "engine/core/math/extent.h"
+#include <cstdint>
+
+struct TemporalAASettings {
+    uint32_t jitter_phases = 8;     // Length of the Halton (2, 3) jitter cycle
+    float history_weight = 0.9f;    // Weight of the reprojected history in the blend
+    float clamp_gamma = 1.25f;      // Neighbourhood box half size, in standard deviations
+};
+
+/**
+ * @brief Camera data of one temporally jittered frame
+ *
+ * The scene passes rasterize with projection; motion vectors and reprojection use the unjittered
+ * view_projection of this and the previous frame, so the jitter itself never shows up as motion.
+ */
+struct TemporalAAView {
+    Mat4 projection = Mat4::Identity();             // Jittered
+    Mat4 view_projection = Mat4::Identity();        // Unjittered
+    Mat4 prev_view_projection = Mat4::Identity();   // Unjittered, previous frame
+    Mat4 inv_view_projection = Mat4::Identity();    // Inverse of the jittered view-projection
+    Vec2 jitter_pixels = Vec2::Zero();              // Sample offset in render pixels, x right, y down
+    Vec2 jitter_ndc = Vec2::Zero();
+    uint32_t frame = 0;                             // Frames since the history was reset
+    bool history_valid = false;                     // The previous frame can be reprojected
+};
+
+/**
+ * @brief Jitter sequence and reprojection math of the temporal AA / upscale pass
+ *
+ * Each frame the projection is offset by a sub-pixel amount from the Halton (2, 3) sequence, so
+ * consecutive frames sample different points of every pixel. TemporalAAPass reprojects the previous
+ * output with per-pixel motion vectors, clamps it to the current frame's neighbourhood to reject
+ * disoccluded and changed history, and blends the two at output resolution. The static helpers
+ * mirror assets/shaders/temporal_aa.hlsl so the math can be checked without a GPU.
+ */
+class TemporalAA {
+public:
+    /**
+     * @brief Radical inverse of index (1-based) in base, in [0, 1)
+     */
+    static float halton(uint32_t index, uint32_t base);
+
+    /**
+     * @brief Jitter of frame within a cycle of phase_count, in render pixels in [-0.5, 0.5)
+     */
+    static Vec2 jitter_offset(uint32_t frame, uint32_t phase_count);
+
+    static Vec2 jitter_to_ndc(Vec2 jitter_pixels, Extent2D render_extent);
+
+    /**
+     * @brief Offset projection so geometry moves by jitter_pixels on screen; works for off-center
+     * and orthographic projections
+     */
+    static Mat4 jitter_projection(const Mat4& projection, Vec2 jitter_pixels, Extent2D render_extent);
+
+    /**
+     * @brief Texture coordinates of a world position, (0, 0) top left
+     */
+    static Vec2 project_to_uv(const Vec3& world, const Mat4& view_projection);
+
+    /**
+     * @brief Motion vector as written to the velocity target: current uv minus previous uv
+     */
+    static Vec2 velocity(const Vec3& world, const Vec3& prev_world, const Mat4& view_projection,
+                         const Mat4& prev_view_projection);
+
+    /**
+     * @brief Clip a history color towards the box center until it lies inside [box_min, box_max]
+     */
+    static Vec3 clip_to_box(const Vec3& history, const Vec3& box_min, const Vec3& box_max);
+
+    /**
+     * @brief Reconstruction filter weight of a sample at offset pixels from the output position
+     */
+    static float sample_weight(Vec2 offset);
+
+    void set_settings(const TemporalAASettings& settings);
+    inline const TemporalAASettings& get_settings() const { return settings_; }
+
+    void set_enabled(bool enable);
+    inline bool is_enabled() const { return enabled_; }
+
+    /**
+     * @brief Advance the jitter and set up this frame's matrices
+     *
+     * The history is dropped when the output size changes or the previous frame was not jittered.
+     */
+    const TemporalAAView& begin_frame(const Mat4& view, const Mat4& projection, Extent2D render_extent,
+                                      Extent2D output_extent);
+    inline const TemporalAAView& get_view() const { return view_; }
+
+    /**
+     * @brief Next frame starts without history, e.g. after a camera cut
+     */
+    void reset();
+
+private:
+    TemporalAASettings settings_;
+    bool enabled_ = false;
+    uint32_t sequence_ = 0;
+    Extent2D output_extent_ = {0, 0};
+    TemporalAAView view_;
+};
@@ -1,60 +1,25 @@
 #include "engine/function/render/rhi/rhi.h"
 #include "engine/function/render/render_system/gpu_profiler.h"
 #include "engine/core/log/Log.h"
+#include "engine/function/render/rhi/rhi_dummy.h"
 #include "engine/platform/dx11/platform_rhi.h"
+#ifdef RENDERER_VULKAN
+#include "engine/platform/vulkan/platform_rhi.h"
+#endif
 #include <algorithm>
 
 RHIBackendRef RHIBackend::backend_ = nullptr;
 
 GPUProfilerRef RHIBackend::create_gpu_profiler() { return nullptr; }
 
-class DummyRHIBackend : public RHIBackend {
-public:
-    DummyRHIBackend(const RHIBackendInfo& info) : RHIBackend(info) {}
-
-    void init_imgui(void* window_handle) override {}
-    void imgui_new_frame() override {}
-    void imgui_render() override {}
-    void imgui_shutdown() override {}
-
-    RHIQueueRef get_queue(const RHIQueueInfo& info) override { return nullptr; }
-    RHISurfaceRef create_surface(void* native_window_handle) override { return nullptr; }
-    RHISwapchainRef create_swapchain(const RHISwapchainInfo& info) override { return nullptr; }
-    RHICommandPoolRef create_command_pool(const RHICommandPoolInfo& info) override { return nullptr; }
-    RHICommandContextRef create_command_context(RHICommandPoolRef pool) override { return nullptr; }
-
-    RHIBufferRef create_buffer(const RHIBufferInfo& info) override { return nullptr; }
-    RHITextureRef create_texture(const RHITextureInfo& info) override { return nullptr; }
-    RHITextureViewRef create_texture_view(const RHITextureViewInfo& info) override { return nullptr; }
-    RHISamplerRef create_sampler(const RHISamplerInfo& info) override { return nullptr; }
-    RHIShaderRef create_shader(const RHIShaderInfo& info) override { return nullptr; }
-    RHIShaderBindingTableRef create_shader_binding_table(const RHIShaderBindingTableInfo& info) override { return nullptr; }
-    RHITopLevelAccelerationStructureRef create_top_level_acceleration_structure(const RHITopLevelAccelerationStructureInfo& info) override { return nullptr; }
-    RHIBottomLevelAccelerationStructureRef create_bottom_level_acceleration_structure(const RHIBottomLevelAccelerationStructureInfo& info) override { return nullptr; }
-
-    RHIRootSignatureRef create_root_signature(const RHIRootSignatureInfo& info) override { return nullptr; }
-
-    RHIRenderPassRef create_render_pass(const RHIRenderPassInfo& info) override { return nullptr; }
-    RHIGraphicsPipelineRef create_graphics_pipeline(const RHIGraphicsPipelineInfo& info) override { return nullptr; }
-    RHIComputePipelineRef create_compute_pipeline(const RHIComputePipelineInfo& info) override { return nullptr; }
-    RHIRayTracingPipelineRef create_ray_tracing_pipeline(const RHIRayTracingPipelineInfo& info) override { return nullptr; }
-
-    RHIFenceRef create_fence(bool signaled) override { return nullptr; }
-    RHISemaphoreRef create_semaphore() override { return nullptr; }
-
-    RHICommandContextImmediateRef get_immediate_command() override { return nullptr; }
-
-    std::vector<uint8_t> compile_shader(const char* source, const char* entry, const char* profile) override { return {}; }
-
-    void set_name(RHIResourceRef resource, const std::string& name) override {
-        if (resource) resource->set_name(name);
-    }
-};
-
 RHIBackendRef RHIBackend::init(const RHIBackendInfo& info) {
     if (backend_ == nullptr) {
         if (info.type == BACKEND_DX11) {
             backend_ = std::make_shared<DX11Backend>(info);
+#ifdef RENDERER_VULKAN
+        } else if (info.type == BACKEND_VULKAN) {
+            backend_ = std::make_shared<VulkanBackend>(info);
+#endif
         } else {
             backend_ = std::make_shared<DummyRHIBackend>(info);
         }
@@ -62,36 +27,122 @@ RHIBackendRef RHIBackend::init(const RHIBackendInfo& info) {
     return backend_;
 }
 
-void RHIBackend::tick() {
-    for (auto& resources : resource_map_) {
-        if (resources.empty()) continue;
-
-        for (size_t i = 0; i < resources.size(); ++i) {
-            RHIResourceRef& resource = resources[i];
-            if (resource) {
-                if (resource.use_count() == 1) {
-                    resource->last_use_tick_++;
-                } else {
-                    resource->last_use_tick_ = 0;
-                }
+void RHIBackend::register_resource(RHIResourceRef resource) {
+    if (!resource) return;
+    size_t shard_index = std::hash<std::thread::id>()(std::this_thread::get_id()) % RESOURCE_SHARD_COUNT;
+    auto& shard = resource_shards_[shard_index];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    shard.resource_map[resource->get_type()].push_back(std::move(resource));
+}
 
-                if (resource->last_use_tick_ > 6) {
-                    resource->destroy();
-                    resource = nullptr;
+uint32_t RHIBackend::get_registered_resource_count() {
+    uint32_t count = 0;
+    for (auto& shard : resource_shards_) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        for (auto& resources : shard.resource_map) {
+            count += (uint32_t)resources.size();
+        }
+    }
+    return count;
+}
+
+RHICommandContextImmediateRef RHIBackend::get_upload_command() {
+    std::thread::id thread_id = std::this_thread::get_id();
+    {
+        std::lock_guard<std::mutex> lock(upload_command_mutex_);
+        auto it = upload_commands_.find(thread_id);
+        if (it != upload_commands_.end()) return it->second;
+    }
+
+    RHICommandContextImmediateRef command = create_upload_command();
+    if (!command) return get_immediate_command();
+
+    std::lock_guard<std::mutex> lock(upload_command_mutex_);
+    upload_commands_[thread_id] = command;
+    return command;
+}
+
+RHIReadbackPool& RHIBackend::get_readback_pool() {
+    std::lock_guard<std::mutex> lock(owned_systems_mutex_);
+    if (!readback_pool_) readback_pool_ = std::make_unique<RHIReadbackPool>(*this);
+    return *readback_pool_;
+}
+
+RHIUploadBatcher& RHIBackend::get_upload_batcher() {
+    std::lock_guard<std::mutex> lock(owned_systems_mutex_);
+    if (!upload_batcher_) upload_batcher_ = std::make_unique<RHIUploadBatcher>(*this);
+    return *upload_batcher_;
+}
+
+void RHIBackend::release_upload_command() {
+    RHICommandContextImmediateRef command;
+    {
+        std::lock_guard<std::mutex> lock(upload_command_mutex_);
+        auto it = upload_commands_.find(std::this_thread::get_id());
+        if (it == upload_commands_.end()) return;
+        command = std::move(it->second);
+        upload_commands_.erase(it);
+    }
+    command->flush();
+    command->destroy();
+}
+
+void RHIBackend::tick() {
+    RHIReadbackPool* readback_pool = nullptr;
+    {
+        // get_readback_pool() may be creating the pool on another thread
+        std::lock_guard<std::mutex> lock(owned_systems_mutex_);
+        readback_pool = readback_pool_.get();
+    }
+    if (readback_pool) readback_pool->tick();
+
+    for (auto& shard : resource_shards_) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        for (auto& resources : shard.resource_map) {
+            if (resources.empty()) continue;
+
+            for (size_t i = 0; i < resources.size(); ++i) {
+                RHIResourceRef& resource = resources[i];
+                if (resource) {
+                    if (resource.use_count() == 1) {
+                        resource->last_use_tick_++;
+                    } else {
+                        resource->last_use_tick_ = 0;
+                    }
+
+                    if (resource->last_use_tick_ > 6) {
+                        resource->destroy();
+                        resource = nullptr;
+                    }
                 }
             }
+
+            resources.erase(std::remove(resources.begin(), resources.end(), nullptr), resources.end());
         }
+    }
+}
 
-        resources.erase(std::remove(resources.begin(), resources.end(), nullptr), resources.end());
+void RHIBackend::destroy_upload_commands() {
+    std::lock_guard<std::mutex> lock(upload_command_mutex_);
+    for (auto& [thread_id, command] : upload_commands_) {
+        if (command) command->destroy();
     }
+    upload_commands_.clear();
 }
 
 void RHIBackend::destroy() {
-    for (int32_t i = resource_map_.size() - 1; i >= 0; i--) {
-        auto& resources = resource_map_[i];
-        for (RHIResourceRef& resource : resources) {
-            if (resource) {
-                resource->destroy();
+    destroy_upload_commands();
+    if (upload_batcher_) upload_batcher_->destroy();
+    if (readback_pool_) readback_pool_->destroy();
+
+    // Destroy in reverse type order across all shards, so views go before textures, etc.
+    for (int32_t i = RHI_RESOURCE_TYPE_MAX_CNT - 1; i >= 0; i--) {
+        for (auto& shard : resource_shards_) {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            for (RHIResourceRef& resource : shard.resource_map[i]) {
+                if (resource) {
+                    resource->destroy();
+                }
             }
         }
     }
@@ -1,12 +1,17 @@
 #pragma once
 
 #include "engine/core/log/Log.h"
+#include "engine/function/render/rhi/rhi_readback.h"
 #include "engine/function/render/rhi/rhi_resource.h"
+#include "engine/function/render/rhi/rhi_upload_batcher.h"
 #include "engine/function/render/rhi/rhi_structs.h"
 
 #include <array>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <unordered_map>
 #include <vector>
 
 class GPUProfiler;
@@ -15,6 +20,7 @@ using GPUProfilerRef = std::unique_ptr<GPUProfiler>;
 enum RHIBackendType {
     BACKEND_VULKAN = 0,
     BACKEND_DX11,
+    BACKEND_NULL,   // No device; resources and commands are no-ops (tests, headless tools)
 
     BACKEND_MAX_ENUM,
 };
@@ -95,9 +101,45 @@ public:
 
     virtual RHISemaphoreRef create_semaphore() = 0;
 
+    /**
+     * @brief Create a timeline semaphore whose completed value starts at initial_value.
+     */
+    virtual RHITimelineSemaphoreRef create_timeline_semaphore(uint64_t initial_value = 0) = 0;
+
     // Immediate Command Interface
     virtual RHICommandContextImmediateRef get_immediate_command() = 0;
 
+    /**
+     * @brief Get an upload context owned by the calling thread.
+     *
+     * Asset loads running on ThreadPool workers should record their copies here
+     * instead of on the shared immediate context. The context is created lazily
+     * on first use per thread via create_upload_command(); backends without
+     * per-thread upload support fall back to get_immediate_command().
+     */
+    RHICommandContextImmediateRef get_upload_command();
+
+    /**
+     * @brief Release the upload context owned by the calling thread (e.g. when a worker exits).
+     */
+    void release_upload_command();
+
+    /**
+     * @brief Pool shared by all async readbacks (RHICommandList::readback_buffer / readback_texture).
+     */
+    RHIReadbackPool& get_readback_pool();
+
+    /**
+     * @brief Batcher that merges asset uploads into one staging arena and one submission per frame.
+     *        The render loop drains it with tick() before recording the frame.
+     */
+    RHIUploadBatcher& get_upload_batcher();
+
+    /**
+     * @brief Number of resources currently tracked for garbage collection / destruction.
+     */
+    uint32_t get_registered_resource_count();
+
     // Shader Compilation
     /**
      * @brief Compile shader source code to platform-specific bytecode
@@ -132,11 +174,37 @@ protected:
     RHIBackend() = delete;
     RHIBackend(const RHIBackendInfo& info) : backend_info_(info) {}
 
-    void register_resource(RHIResourceRef resource) {
-        resource_map_[resource->get_type()].push_back(resource);
-    }
+    /**
+     * @brief Track a resource for garbage collection and destruction. Safe to call from any thread.
+     *
+     * Registration goes to a shard picked by the calling thread's id so that
+     * concurrent creators on different workers rarely touch the same mutex.
+     */
+    void register_resource(RHIResourceRef resource);
+
+    /**
+     * @brief Create a new upload context for the calling thread. Override per-platform.
+     * @return nullptr to make get_upload_command() fall back to the immediate context.
+     */
+    virtual RHICommandContextImmediateRef create_upload_command() { return nullptr; }
+
+    void destroy_upload_commands();
+
+    static constexpr uint32_t RESOURCE_SHARD_COUNT = 16;
+
+    struct ResourceShard {
+        std::mutex mutex;
+        std::array<std::vector<RHIResourceRef>, RHI_RESOURCE_TYPE_MAX_CNT> resource_map;
+    };
+
+    std::array<ResourceShard, RESOURCE_SHARD_COUNT> resource_shards_;
 
-    std::array<std::vector<RHIResourceRef>, RHI_RESOURCE_TYPE_MAX_CNT> resource_map_;
+    std::mutex owned_systems_mutex_; // Guards lazy creation of the readback pool and upload batcher
+    std::unique_ptr<RHIReadbackPool> readback_pool_;
+    std::unique_ptr<RHIUploadBatcher> upload_batcher_;
+
+    std::mutex upload_command_mutex_;
+    std::unordered_map<std::thread::id, RHICommandContextImmediateRef> upload_commands_;
 
     RHIBackendInfo backend_info_;
 };
@@ -206,6 +274,11 @@ public:
     virtual void bind_texture(RHITextureRef texture, uint32_t slot, ShaderFrequency frequency) = 0;
 
     virtual void bind_rw_texture(RHITextureRef texture, uint32_t slot, uint32_t mip_level, ShaderFrequency frequency) = 0;
+
+    /**
+     * @brief Bind a structured buffer (RESOURCE_TYPE_BUFFER with a stride) as a read-only shader resource
+     */
+    virtual void bind_buffer(RHIBufferRef buffer, uint32_t slot, ShaderFrequency frequency) = 0;
     
     virtual void bind_sampler(RHISamplerRef sampler, uint32_t slot, ShaderFrequency frequency) = 0;
 
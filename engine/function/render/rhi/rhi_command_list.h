@@ -4,6 +4,7 @@
 #include "engine/function/render/rhi/rhi.h"
 #include <cassert>
 #include <cstring>
+#include <future>
 #include <string>
 #include <vector>
 
@@ -17,6 +18,7 @@ struct CommandListImmediateInfo {
 struct CommandListInfo {
     RHICommandPoolRef pool;
     RHICommandContextRef context;
+    RHIBackend* backend = nullptr; // Owner of the readback pool, defaults to RHIBackend::get()
 
     bool bypass = false;
 };
@@ -41,6 +43,7 @@ class RHICommandList {
 public:
     RHICommandList(const CommandListInfo& info) : info_(info) {}
     ~RHICommandList() {
+        for (auto& readback : readbacks_) readback.promise->set_value({}); // Never executed
         if (info_.pool && info_.context) {
             info_.pool->return_to_pool(info_.context);
         }
@@ -60,6 +63,18 @@ public:
     void copy_texture(RHITextureRef src, TextureSubresourceLayers src_subresource, RHITextureRef dst, TextureSubresourceLayers dst_subresource);
     void generate_mips(RHITextureRef src);
 
+    /**
+     * @brief Copy a buffer range into a pooled readback buffer.
+     * @return Future resolved by RHIBackend::tick() once the submission of this list has
+     *         completed on the GPU. Backends without fences resolve it inside execute().
+     */
+    std::future<RHIReadbackResult> readback_buffer(RHIBufferRef src, uint64_t src_offset, uint64_t size);
+
+    /**
+     * @brief Copy one texture subresource into a pooled readback buffer, tightly packed.
+     */
+    std::future<RHIReadbackResult> readback_texture(RHITextureRef src, TextureSubresourceLayers src_subresource);
+
     void push_event(const std::string& name, Color3 color = {0.0f, 0.0f, 0.0f});
     void pop_event();
 
@@ -86,6 +101,7 @@ public:
     void bind_constant_buffer(RHIBufferRef buffer, uint32_t slot, ShaderFrequency frequency);
     void bind_texture(RHITextureRef texture, uint32_t slot, ShaderFrequency frequency);
     void bind_rw_texture(RHITextureRef texture, uint32_t slot, uint32_t mip_level, ShaderFrequency frequency);
+    void bind_buffer(RHIBufferRef buffer, uint32_t slot, ShaderFrequency frequency);
     void bind_sampler(RHISamplerRef sampler, uint32_t slot, ShaderFrequency frequency);
     void bind_vertex_buffer(RHIBufferRef vertex_buffer, uint32_t stream_index = 0, uint32_t offset = 0);
     void bind_index_buffer(RHIBufferRef index_buffer, uint32_t offset = 0);
@@ -104,10 +120,18 @@ public:
     void imgui_render_draw_data();
 
 protected:
+    struct Readback {
+        RHIBufferRef buffer;
+        uint64_t size = 0;
+        RHIReadbackPromiseRef promise;
+    };
+
     CommandListInfo info_;
     std::vector<RHICommand*> commands_;
+    std::vector<Readback> readbacks_; // Recorded, handed to the readback pool on execute()
 
     void add_command(RHICommand* command) { commands_.push_back(command); }
+    RHIBackend* get_backend() { return info_.backend ? info_.backend : RHIBackend::get().get(); }
 };
 
 class RHICommandListImmediate {
@@ -324,6 +348,14 @@ struct RHICommandBindRWTexture : public RHICommand {
     void execute(RHICommandContextRef context) override { context->bind_rw_texture(texture, slot, mip_level, frequency); }
 };
 
+struct RHICommandBindBuffer : public RHICommand {
+    RHIBufferRef buffer;
+    uint32_t slot;
+    ShaderFrequency frequency;
+    RHICommandBindBuffer(RHIBufferRef b, uint32_t s, ShaderFrequency f) : buffer(b), slot(s), frequency(f) {}
+    void execute(RHICommandContextRef context) override { context->bind_buffer(buffer, slot, frequency); }
+};
+
 struct RHICommandBindSampler : public RHICommand {
     RHISamplerRef sampler;
     uint32_t slot;
@@ -484,7 +516,14 @@ inline void RHICommandList::execute(RHIFenceRef fence, RHISemaphoreRef wait_sema
         }
         commands_.clear();
     }
+    if (!readbacks_.empty() && !fence) fence = get_backend()->create_fence(false);
     info_.context->execute(fence, wait_semaphore, signal_semaphore);
+
+    if (!readbacks_.empty()) {
+        RHIReadbackPool& pool = get_backend()->get_readback_pool();
+        for (auto& readback : readbacks_) pool.submit(readback.buffer, readback.size, readback.promise, fence);
+        readbacks_.clear();
+    }
 }
 
 inline void RHICommandList::texture_barrier(const RHITextureBarrier& barrier) {
@@ -522,6 +561,39 @@ inline void RHICommandList::generate_mips(RHITextureRef src) {
     else ADD_COMMAND(RHICommandGenerateMips, src);
 }
 
+inline std::future<RHIReadbackResult> RHICommandList::readback_buffer(RHIBufferRef src, uint64_t src_offset, uint64_t size) {
+    auto promise = std::make_shared<std::promise<RHIReadbackResult>>();
+    auto future = promise->get_future();
+
+    RHIBufferRef dst = (src && size > 0) ? get_backend()->get_readback_pool().acquire(size) : nullptr;
+    if (!dst) {
+        promise->set_value({});
+        return future;
+    }
+    copy_buffer(src, src_offset, dst, 0, size);
+    readbacks_.push_back({ dst, size, promise });
+    return future;
+}
+
+inline std::future<RHIReadbackResult> RHICommandList::readback_texture(RHITextureRef src, TextureSubresourceLayers src_subresource) {
+    auto promise = std::make_shared<std::promise<RHIReadbackResult>>();
+    auto future = promise->get_future();
+
+    uint64_t size = 0;
+    if (src) {
+        Extent3D extent = src->mip_extent(src_subresource.mip_level);
+        size = (uint64_t)extent.width * extent.height * format_pixel_size(src->get_info().format);
+    }
+    RHIBufferRef dst = size > 0 ? get_backend()->get_readback_pool().acquire(size) : nullptr;
+    if (!dst) {
+        promise->set_value({});
+        return future;
+    }
+    copy_texture_to_buffer(src, src_subresource, dst, 0);
+    readbacks_.push_back({ dst, size, promise });
+    return future;
+}
+
 inline void RHICommandList::push_event(const std::string& name, Color3 color) {
     if (info_.bypass) info_.context->push_event(name, color);
     else ADD_COMMAND(RHICommandPushEvent, name, color);
@@ -618,6 +690,11 @@ inline void RHICommandList::bind_rw_texture(RHITextureRef texture, uint32_t slot
     else ADD_COMMAND(RHICommandBindRWTexture, texture, slot, mip_level, frequency);
 }
 
+inline void RHICommandList::bind_buffer(RHIBufferRef buffer, uint32_t slot, ShaderFrequency frequency) {
+    if (info_.bypass) info_.context->bind_buffer(buffer, slot, frequency);
+    else ADD_COMMAND(RHICommandBindBuffer, buffer, slot, frequency);
+}
+
 inline void RHICommandList::bind_sampler(RHISamplerRef sampler, uint32_t slot, ShaderFrequency frequency) {
     if (info_.bypass) info_.context->bind_sampler(sampler, slot, frequency);
     else ADD_COMMAND(RHICommandBindSampler, sampler, slot, frequency);
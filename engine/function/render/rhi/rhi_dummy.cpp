@@ -0,0 +1,211 @@
+#include "engine/function/render/rhi/rhi_dummy.h"
+#include "engine/function/render/rhi/rhi_command_list.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+RHIBufferRef DummyRHIBackend::create_buffer(const RHIBufferInfo& info) {
+    auto buffer = std::make_shared<DummyRHIBuffer>(info);
+    register_resource(buffer);
+    return buffer;
+}
+
+RHITextureRef DummyRHIBackend::create_texture(const RHITextureInfo& info) {
+    auto texture = std::make_shared<DummyRHITexture>(info);
+    register_resource(texture);
+    return texture;
+}
+
+RHICommandPoolRef DummyRHIBackend::create_command_pool(const RHICommandPoolInfo& info) {
+    auto pool = std::make_shared<DummyRHICommandPool>(info, *this);
+    register_resource(pool);
+    return pool;
+}
+
+RHICommandContextRef DummyRHIBackend::create_command_context(RHICommandPoolRef pool) {
+    auto context = std::make_shared<DummyRHICommandContext>(pool);
+    register_resource(context);
+    return context;
+}
+
+RHICommandContextImmediateRef DummyRHIBackend::get_immediate_command() {
+    std::lock_guard<std::mutex> lock(immediate_command_mutex_);
+    if (!immediate_command_) immediate_command_ = std::make_shared<DummyRHICommandContextImmediate>();
+    return immediate_command_;
+}
+
+RHITimelineSemaphoreRef DummyRHIBackend::create_timeline_semaphore(uint64_t initial_value) {
+    auto semaphore = std::make_shared<DummyRHITimelineSemaphore>(initial_value);
+    register_resource(semaphore);
+    return semaphore;
+}
+
+uint64_t DummyRHITimelineSemaphore::get_completed_value() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return value_;
+}
+
+void DummyRHITimelineSemaphore::signal(uint64_t value) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (value <= value_) return;
+        value_ = value;
+    }
+    cv_.notify_all();
+}
+
+bool DummyRHITimelineSemaphore::wait(uint64_t value, uint64_t timeout_ms) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    auto reached = [&]() { return value_ >= value; };
+    if (timeout_ms == UINT64_MAX) {
+        cv_.wait(lock, reached);
+        return true;
+    }
+    return cv_.wait_for(lock, std::chrono::milliseconds(timeout_ms), reached);
+}
+
+DummyRHITexture::DummyRHITexture(const RHITextureInfo& info) : RHITexture(info) {
+    uint32_t mip_levels = std::max(1u, info.mip_levels);
+    uint32_t array_layers = std::max(1u, info.array_layers);
+    subresources_.resize((size_t)mip_levels * array_layers);
+    for (uint32_t layer = 0; layer < array_layers; ++layer) {
+        for (uint32_t mip = 0; mip < mip_levels; ++mip) {
+            subresources_[layer * mip_levels + mip].resize(get_subresource_size(mip));
+        }
+    }
+}
+
+uint64_t DummyRHITexture::get_subresource_size(uint32_t mip_level) {
+    Extent3D extent = mip_extent(mip_level);
+    return (uint64_t)extent.width * extent.height * extent.depth * format_pixel_size(info_.format);
+}
+
+uint8_t* DummyRHITexture::get_data(uint32_t mip_level, uint32_t array_layer) {
+    uint32_t mip_levels = std::max(1u, info_.mip_levels);
+    size_t index = (size_t)array_layer * mip_levels + mip_level;
+    if (mip_level >= mip_levels || index >= subresources_.size()) return nullptr;
+    return subresources_[index].data();
+}
+
+RHICommandListRef DummyRHICommandPool::create_command_list(bool bypass) {
+    RHICommandContextRef context = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!idle_contexts_.empty()) {
+            context = idle_contexts_.front();
+            idle_contexts_.pop();
+        }
+    }
+
+    if (!context) {
+        context = backend_.create_command_context(std::static_pointer_cast<RHICommandPool>(shared_from_this()));
+        std::lock_guard<std::mutex> lock(mutex_);
+        contexts_.push_back(context);
+    }
+
+    CommandListInfo info;
+    info.pool = std::static_pointer_cast<RHICommandPool>(shared_from_this());
+    info.context = context;
+    info.backend = &backend_;
+    info.bypass = bypass;
+
+    return std::make_shared<RHICommandList>(info);
+}
+
+static void dummy_copy_buffer(RHIBufferRef src, uint64_t src_offset, RHIBufferRef dst, uint64_t dst_offset, uint64_t size) {
+    if (!src || !dst) return;
+    if (src_offset + size > src->get_info().size || dst_offset + size > dst->get_info().size) return;
+    auto* src_data = static_cast<uint8_t*>(src->map());
+    auto* dst_data = static_cast<uint8_t*>(dst->map());
+    if (src_data && dst_data) memmove(dst_data + dst_offset, src_data + src_offset, size);
+    dst->unmap();
+    src->unmap();
+}
+
+static void dummy_copy_texture_to_buffer(RHITextureRef src, TextureSubresourceLayers src_subresource, RHIBufferRef dst, uint64_t dst_offset) {
+    auto texture = std::dynamic_pointer_cast<DummyRHITexture>(src);
+    if (!texture || !dst) return;
+    uint8_t* src_data = texture->get_data(src_subresource.mip_level, src_subresource.base_array_layer);
+    uint64_t size = texture->get_subresource_size(src_subresource.mip_level);
+    if (!src_data || dst_offset + size > dst->get_info().size) return;
+    auto* dst_data = static_cast<uint8_t*>(dst->map());
+    if (dst_data) memcpy(dst_data + dst_offset, src_data, size);
+    dst->unmap();
+}
+
+static void dummy_copy_buffer_to_texture(RHIBufferRef src, uint64_t src_offset, RHITextureRef dst, TextureSubresourceLayers dst_subresource) {
+    auto texture = std::dynamic_pointer_cast<DummyRHITexture>(dst);
+    if (!texture || !src) return;
+    uint8_t* dst_data = texture->get_data(dst_subresource.mip_level, dst_subresource.base_array_layer);
+    if (!dst_data) return;
+
+    // Staging rows are 256-byte aligned, texture storage is tightly packed
+    RHIFormat format = texture->get_info().format;
+    Extent3D extent = texture->mip_extent(dst_subresource.mip_level);
+    uint64_t row_size = (uint64_t)extent.width * format_pixel_size(format);
+    uint64_t row_pitch = texture_upload_row_pitch(format, extent.width);
+    uint64_t row_count = (uint64_t)extent.height * extent.depth;
+    if (row_count == 0 || src_offset + row_pitch * (row_count - 1) + row_size > src->get_info().size) return;
+
+    auto* src_data = static_cast<uint8_t*>(src->map());
+    if (src_data) {
+        for (uint64_t row = 0; row < row_count; ++row) {
+            memcpy(dst_data + row * row_size, src_data + src_offset + row * row_pitch, row_size);
+        }
+    }
+    src->unmap();
+}
+
+static void dummy_copy_texture(RHITextureRef src, TextureSubresourceLayers src_subresource, RHITextureRef dst, TextureSubresourceLayers dst_subresource) {
+    auto src_texture = std::dynamic_pointer_cast<DummyRHITexture>(src);
+    auto dst_texture = std::dynamic_pointer_cast<DummyRHITexture>(dst);
+    if (!src_texture || !dst_texture) return;
+    uint64_t size = src_texture->get_subresource_size(src_subresource.mip_level);
+    if (size != dst_texture->get_subresource_size(dst_subresource.mip_level)) return;
+    uint8_t* src_data = src_texture->get_data(src_subresource.mip_level, src_subresource.base_array_layer);
+    uint8_t* dst_data = dst_texture->get_data(dst_subresource.mip_level, dst_subresource.base_array_layer);
+    if (src_data && dst_data) memcpy(dst_data, src_data, size);
+}
+
+void DummyRHICommandContext::copy_buffer(RHIBufferRef src, uint64_t src_offset, RHIBufferRef dst, uint64_t dst_offset, uint64_t size) {
+    dummy_copy_buffer(src, src_offset, dst, dst_offset, size);
+}
+
+void DummyRHICommandContext::copy_texture_to_buffer(RHITextureRef src, TextureSubresourceLayers src_subresource, RHIBufferRef dst, uint64_t dst_offset) {
+    dummy_copy_texture_to_buffer(src, src_subresource, dst, dst_offset);
+}
+
+void DummyRHICommandContext::copy_buffer_to_texture(RHIBufferRef src, uint64_t src_offset, RHITextureRef dst, TextureSubresourceLayers dst_subresource) {
+    dummy_copy_buffer_to_texture(src, src_offset, dst, dst_subresource);
+}
+
+void DummyRHICommandContext::copy_texture(RHITextureRef src, TextureSubresourceLayers src_subresource, RHITextureRef dst, TextureSubresourceLayers dst_subresource) {
+    dummy_copy_texture(src, src_subresource, dst, dst_subresource);
+}
+
+bool DummyRHICommandContext::read_texture(RHITextureRef texture, void* data, uint32_t size) {
+    auto dummy_texture = std::dynamic_pointer_cast<DummyRHITexture>(texture);
+    if (!dummy_texture || !data) return false;
+    uint8_t* src_data = dummy_texture->get_data(0, 0);
+    uint64_t src_size = dummy_texture->get_subresource_size(0);
+    if (!src_data || size < src_size) return false;
+    memcpy(data, src_data, src_size);
+    return true;
+}
+
+void DummyRHICommandContextImmediate::copy_buffer(RHIBufferRef src, uint64_t src_offset, RHIBufferRef dst, uint64_t dst_offset, uint64_t size) {
+    dummy_copy_buffer(src, src_offset, dst, dst_offset, size);
+}
+
+void DummyRHICommandContextImmediate::copy_texture_to_buffer(RHITextureRef src, TextureSubresourceLayers src_subresource, RHIBufferRef dst, uint64_t dst_offset) {
+    dummy_copy_texture_to_buffer(src, src_subresource, dst, dst_offset);
+}
+
+void DummyRHICommandContextImmediate::copy_buffer_to_texture(RHIBufferRef src, uint64_t src_offset, RHITextureRef dst, TextureSubresourceLayers dst_subresource) {
+    dummy_copy_buffer_to_texture(src, src_offset, dst, dst_subresource);
+}
+
+void DummyRHICommandContextImmediate::copy_texture(RHITextureRef src, TextureSubresourceLayers src_subresource, RHITextureRef dst, TextureSubresourceLayers dst_subresource) {
+    dummy_copy_texture(src, src_subresource, dst, dst_subresource);
+}
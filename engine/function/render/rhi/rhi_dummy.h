@@ -0,0 +1,225 @@
+#pragma once
+
+#include "engine/function/render/rhi/rhi.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
+/**
+ * @brief CPU-side buffer used by the null backend.
+ *
+ * Backs the buffer with host memory so systems that only map/unmap buffers
+ * (uploads, readbacks) can run headless and be unit-tested.
+ */
+class DummyRHIBuffer : public RHIBuffer {
+public:
+    DummyRHIBuffer(const RHIBufferInfo& info) : RHIBuffer(info), data_(info.size) {}
+
+    virtual void* map() override { return data_.data(); }
+    virtual void unmap() override {}
+
+    virtual void destroy() override { data_.clear(); data_.shrink_to_fit(); }
+    virtual void* raw_handle() override { return data_.data(); }
+
+private:
+    std::vector<uint8_t> data_;
+};
+
+/**
+ * @brief CPU-side texture used by the null backend, one tightly packed allocation per subresource.
+ */
+class DummyRHITexture : public RHITexture {
+public:
+    DummyRHITexture(const RHITextureInfo& info);
+
+    uint8_t* get_data(uint32_t mip_level, uint32_t array_layer);
+    uint64_t get_subresource_size(uint32_t mip_level);
+
+    virtual void destroy() override { subresources_.clear(); }
+
+private:
+    std::vector<std::vector<uint8_t>> subresources_; // [array_layer * mip_levels + mip_level]
+};
+
+class DummyRHIBackend;
+
+/**
+ * @brief Command pool of the null backend. Creates its contexts through the owning backend
+ *        instead of the RHIBackend singleton, so tests can run several backends side by side.
+ */
+class DummyRHICommandPool : public RHICommandPool {
+public:
+    DummyRHICommandPool(const RHICommandPoolInfo& info, DummyRHIBackend& backend) : RHICommandPool(info), backend_(backend) {}
+
+    virtual RHICommandListRef create_command_list(bool bypass = true) override;
+
+private:
+    DummyRHIBackend& backend_;
+};
+
+/**
+ * @brief Command context of the null backend. Copies between CPU-side resources are
+ *        executed immediately; everything else is dropped.
+ */
+class DummyRHICommandContext : public RHICommandContext {
+public:
+    DummyRHICommandContext(RHICommandPoolRef pool) : RHICommandContext(pool) {}
+
+    virtual void begin_command() override {}
+    virtual void end_command() override {}
+    virtual void execute(RHIFenceRef wait_fence, RHISemaphoreRef wait_semaphore, RHISemaphoreRef signal_semaphore) override {}
+
+    virtual void texture_barrier(const RHITextureBarrier& barrier) override {}
+    virtual void buffer_barrier(const RHIBufferBarrier& barrier) override {}
+    virtual void copy_texture_to_buffer(RHITextureRef src, TextureSubresourceLayers src_subresource, RHIBufferRef dst, uint64_t dst_offset) override;
+    virtual void copy_buffer_to_texture(RHIBufferRef src, uint64_t src_offset, RHITextureRef dst, TextureSubresourceLayers dst_subresource) override;
+    virtual void copy_buffer(RHIBufferRef src, uint64_t src_offset, RHIBufferRef dst, uint64_t dst_offset, uint64_t size) override;
+    virtual void copy_texture(RHITextureRef src, TextureSubresourceLayers src_subresource, RHITextureRef dst, TextureSubresourceLayers dst_subresource) override;
+    virtual void generate_mips(RHITextureRef src) override {}
+
+    virtual void push_event(const std::string& name, Color3 color) override {}
+    virtual void pop_event() override {}
+
+    virtual void begin_render_pass(RHIRenderPassRef render_pass) override {}
+    virtual void end_render_pass() override {}
+
+    virtual void set_viewport(Offset2D min, Offset2D max) override {}
+    virtual void set_scissor(Offset2D min, Offset2D max) override {}
+    virtual void set_depth_bias(float constant_bias, float slope_bias, float clamp_bias) override {}
+    virtual void set_line_width(float width) override {}
+
+    virtual void set_graphics_pipeline(RHIGraphicsPipelineRef graphics_pipeline) override {}
+    virtual void set_compute_pipeline(RHIComputePipelineRef compute_pipeline) override {}
+    virtual void set_ray_tracing_pipeline(RHIRayTracingPipelineRef ray_tracing_pipeline) override {}
+
+    virtual void push_constants(void* data, uint16_t size, ShaderFrequency frequency) override {}
+    virtual void bind_descriptor_set(RHIDescriptorSetRef descriptor, uint32_t set) override {}
+    virtual void bind_constant_buffer(RHIBufferRef buffer, uint32_t slot, ShaderFrequency frequency) override {}
+    virtual void bind_texture(RHITextureRef texture, uint32_t slot, ShaderFrequency frequency) override {}
+    virtual void bind_rw_texture(RHITextureRef texture, uint32_t slot, uint32_t mip_level, ShaderFrequency frequency) override {}
+    virtual void bind_buffer(RHIBufferRef buffer, uint32_t slot, ShaderFrequency frequency) override {}
+    virtual void bind_sampler(RHISamplerRef sampler, uint32_t slot, ShaderFrequency frequency) override {}
+    virtual void bind_vertex_buffer(RHIBufferRef vertex_buffer, uint32_t stream_index, uint32_t offset) override {}
+    virtual void bind_index_buffer(RHIBufferRef index_buffer, uint32_t offset) override {}
+
+    virtual void dispatch(uint32_t group_count_x, uint32_t group_count_y, uint32_t group_count_z) override {}
+    virtual void dispatch_indirect(RHIBufferRef argument_buffer, uint32_t argument_offset) override {}
+    virtual void trace_rays(uint32_t group_count_x, uint32_t group_count_y, uint32_t group_count_z) override {}
+
+    virtual void draw(uint32_t vertex_count, uint32_t instance_count, uint32_t first_vertex, uint32_t first_instance) override {}
+    virtual void draw_indexed(uint32_t index_count, uint32_t instance_count, uint32_t first_index, uint32_t vertex_offset, uint32_t first_instance) override {}
+    virtual void draw_indirect(RHIBufferRef argument_buffer, uint32_t offset, uint32_t draw_count) override {}
+    virtual void draw_indexed_indirect(RHIBufferRef argument_buffer, uint32_t offset, uint32_t draw_count) override {}
+
+    virtual bool read_texture(RHITextureRef texture, void* data, uint32_t size) override;
+
+    virtual void imgui_create_fonts_texture() override {}
+    virtual void imgui_render_draw_data() override {}
+};
+
+/**
+ * @brief Immediate context of the null backend. Copies run on the CPU; flush() only counts submissions.
+ */
+class DummyRHICommandContextImmediate : public RHICommandContextImmediate {
+public:
+    virtual void flush() override { flush_count_++; }
+
+    virtual void texture_barrier(const RHITextureBarrier& barrier) override {}
+    virtual void buffer_barrier(const RHIBufferBarrier& barrier) override {}
+    virtual void copy_texture_to_buffer(RHITextureRef src, TextureSubresourceLayers src_subresource, RHIBufferRef dst, uint64_t dst_offset) override;
+    virtual void copy_buffer_to_texture(RHIBufferRef src, uint64_t src_offset, RHITextureRef dst, TextureSubresourceLayers dst_subresource) override;
+    virtual void copy_buffer(RHIBufferRef src, uint64_t src_offset, RHIBufferRef dst, uint64_t dst_offset, uint64_t size) override;
+    virtual void copy_texture(RHITextureRef src, TextureSubresourceLayers src_subresource, RHITextureRef dst, TextureSubresourceLayers dst_subresource) override;
+    virtual void generate_mips(RHITextureRef src) override {}
+
+    uint32_t get_flush_count() const { return flush_count_; }
+
+private:
+    std::atomic<uint32_t> flush_count_ = 0;
+};
+
+/**
+ * @brief CPU timeline semaphore used by the null backend.
+ */
+class DummyRHITimelineSemaphore : public RHITimelineSemaphore {
+public:
+    DummyRHITimelineSemaphore(uint64_t initial_value) : value_(initial_value) {}
+
+    virtual uint64_t get_completed_value() override;
+    virtual void signal(uint64_t value) override;
+    virtual bool wait(uint64_t value, uint64_t timeout_ms = UINT64_MAX) override;
+
+private:
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    uint64_t value_;
+};
+
+/**
+ * @brief Queue of the null backend. Submitted work completes immediately, so
+ *        queue signals take effect at once and queue waits block the caller.
+ */
+class DummyRHIQueue : public RHIQueue {
+public:
+    DummyRHIQueue(const RHIQueueInfo& info) : RHIQueue(info) {}
+
+    virtual void wait_idle() override {}
+};
+
+/**
+ * @brief Null RHI backend. Selected for any backend type without a platform implementation.
+ *
+ * Creates no GPU objects; resources that have a meaningful CPU representation
+ * (buffers, textures) are emulated in host memory and registered like real resources.
+ * Command contexts execute copies immediately and have no fences, so async readbacks
+ * resolve as soon as the command list is executed.
+ */
+class DummyRHIBackend : public RHIBackend {
+public:
+    DummyRHIBackend(const RHIBackendInfo& info) : RHIBackend(info) {}
+
+    void init_imgui(void* window_handle) override {}
+    void imgui_new_frame() override {}
+    void imgui_render() override {}
+    void imgui_shutdown() override {}
+
+    RHIQueueRef get_queue(const RHIQueueInfo& info) override { return std::make_shared<DummyRHIQueue>(info); }
+    RHISurfaceRef create_surface(void* native_window_handle) override { return nullptr; }
+    RHISwapchainRef create_swapchain(const RHISwapchainInfo& info) override { return nullptr; }
+    RHICommandPoolRef create_command_pool(const RHICommandPoolInfo& info) override;
+    RHICommandContextRef create_command_context(RHICommandPoolRef pool) override;
+
+    RHIBufferRef create_buffer(const RHIBufferInfo& info) override;
+    RHITextureRef create_texture(const RHITextureInfo& info) override;
+    RHITextureViewRef create_texture_view(const RHITextureViewInfo& info) override { return nullptr; }
+    RHISamplerRef create_sampler(const RHISamplerInfo& info) override { return nullptr; }
+    RHIShaderRef create_shader(const RHIShaderInfo& info) override { return nullptr; }
+    RHIShaderBindingTableRef create_shader_binding_table(const RHIShaderBindingTableInfo& info) override { return nullptr; }
+    RHITopLevelAccelerationStructureRef create_top_level_acceleration_structure(const RHITopLevelAccelerationStructureInfo& info) override { return nullptr; }
+    RHIBottomLevelAccelerationStructureRef create_bottom_level_acceleration_structure(const RHIBottomLevelAccelerationStructureInfo& info) override { return nullptr; }
+
+    RHIRootSignatureRef create_root_signature(const RHIRootSignatureInfo& info) override { return nullptr; }
+
+    RHIRenderPassRef create_render_pass(const RHIRenderPassInfo& info) override { return nullptr; }
+    RHIGraphicsPipelineRef create_graphics_pipeline(const RHIGraphicsPipelineInfo& info) override { return nullptr; }
+    RHIComputePipelineRef create_compute_pipeline(const RHIComputePipelineInfo& info) override { return nullptr; }
+    RHIRayTracingPipelineRef create_ray_tracing_pipeline(const RHIRayTracingPipelineInfo& info) override { return nullptr; }
+
+    RHIFenceRef create_fence(bool signaled) override { return nullptr; }
+    RHISemaphoreRef create_semaphore() override { return nullptr; }
+    RHITimelineSemaphoreRef create_timeline_semaphore(uint64_t initial_value = 0) override;
+
+    RHICommandContextImmediateRef get_immediate_command() override;
+
+    std::vector<uint8_t> compile_shader(const char* source, const char* entry, const char* profile) override { return {}; }
+
+    void set_name(RHIResourceRef resource, const std::string& name) override {
+        if (resource) resource->set_name(name);
+    }
+
+private:
+    std::mutex immediate_command_mutex_;
+    RHICommandContextImmediateRef immediate_command_;
+};
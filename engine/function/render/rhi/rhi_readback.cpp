@@ -0,0 +1,97 @@
+#include "engine/function/render/rhi/rhi_readback.h"
+#include "engine/function/render/rhi/rhi.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+RHIBufferRef RHIReadbackPool::acquire(uint64_t size) {
+    uint64_t bucket_size = std::bit_ceil(std::max(size, MIN_BUFFER_SIZE));
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = std::find_if(free_buffers_.begin(), free_buffers_.end(), [&](const RHIBufferRef& buffer) {
+            return buffer->get_info().size == bucket_size;
+        });
+        if (it != free_buffers_.end()) {
+            RHIBufferRef buffer = *it;
+            free_buffers_.erase(it);
+            return buffer;
+        }
+    }
+
+    RHIBufferInfo info = {};
+    info.size = bucket_size;
+    info.memory_usage = MEMORY_USAGE_GPU_TO_CPU;
+    info.type = RESOURCE_TYPE_BUFFER;
+    return backend_.create_buffer(info);
+}
+
+void RHIReadbackPool::submit(RHIBufferRef buffer, uint64_t size, RHIReadbackPromiseRef promise, RHIFenceRef fence) {
+    PendingReadback readback = { buffer, size, promise, fence };
+    if (!fence) {
+        resolve(readback);
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    pending_.push_back(std::move(readback));
+}
+
+void RHIReadbackPool::resolve(PendingReadback& readback) {
+    RHIReadbackResult result;
+    if (readback.buffer) {
+        void* mapped = readback.buffer->map();
+        if (mapped) {
+            result.data.resize(readback.size);
+            memcpy(result.data.data(), mapped, readback.size);
+            result.success = true;
+        }
+        readback.buffer->unmap();
+    }
+    readback.promise->set_value(std::move(result));
+
+    if (!readback.buffer) return;
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (free_buffers_.size() < MAX_FREE_BUFFERS) free_buffers_.push_back(std::move(readback.buffer));
+}
+
+void RHIReadbackPool::tick() {
+    std::vector<PendingReadback> ready;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto split = std::stable_partition(pending_.begin(), pending_.end(), [](const PendingReadback& readback) {
+            return !readback.fence->is_signaled();
+        });
+        std::move(split, pending_.end(), std::back_inserter(ready));
+        pending_.erase(split, pending_.end());
+    }
+    for (auto& readback : ready) resolve(readback);
+}
+
+void RHIReadbackPool::flush() {
+    std::vector<PendingReadback> pending;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pending.swap(pending_);
+    }
+    for (auto& readback : pending) {
+        readback.fence->wait();
+        resolve(readback);
+    }
+}
+
+void RHIReadbackPool::destroy() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& readback : pending_) readback.promise->set_value({});
+    pending_.clear();
+    free_buffers_.clear();
+}
+
+uint32_t RHIReadbackPool::get_pending_count() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return (uint32_t)pending_.size();
+}
+
+uint32_t RHIReadbackPool::get_free_buffer_count() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return (uint32_t)free_buffers_.size();
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "engine/function/render/rhi/rhi_resource.h"
+
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+class RHIBackend;
+
+/**
+ * @brief CPU copy of a buffer or texture region produced by an async readback.
+ *
+ * Texture readbacks are tightly packed (row pitch = width * format_pixel_size).
+ */
+struct RHIReadbackResult {
+    std::vector<uint8_t> data;
+    bool success = false;
+};
+
+using RHIReadbackPromiseRef = std::shared_ptr<std::promise<RHIReadbackResult>>;
+
+/**
+ * @brief Pool of CPU-readable (MEMORY_USAGE_GPU_TO_CPU) buffers and the readbacks waiting on them.
+ *
+ * RHICommandList::readback_buffer / readback_texture copy into a buffer acquired here.
+ * When the list is executed every request is queued together with the submission fence;
+ * tick() resolves the futures whose fence has passed and recycles their buffers.
+ * Mapping the buffer happens only there, so backends that finish texture copies on the CPU
+ * (DX11 packs a staging texture into the buffer in map()) never stall the recording thread.
+ * Requests submitted without a fence (null backend) resolve immediately.
+ */
+class RHIReadbackPool {
+public:
+    RHIReadbackPool(RHIBackend& backend) : backend_(backend) {}
+
+    /**
+     * @brief Get a readback buffer of at least size bytes. Sizes are bucketed to powers of two.
+     */
+    RHIBufferRef acquire(uint64_t size);
+
+    /**
+     * @brief Queue a recorded readback. The promise is fulfilled once fence has signaled.
+     */
+    void submit(RHIBufferRef buffer, uint64_t size, RHIReadbackPromiseRef promise, RHIFenceRef fence);
+
+    /**
+     * @brief Resolve every readback whose fence has signaled. Called from RHIBackend::tick().
+     */
+    void tick();
+
+    /**
+     * @brief Block until every pending readback has resolved.
+     */
+    void flush();
+
+    /**
+     * @brief Fail all pending readbacks and drop pooled buffers.
+     */
+    void destroy();
+
+    uint32_t get_pending_count();
+    uint32_t get_free_buffer_count();
+
+private:
+    struct PendingReadback {
+        RHIBufferRef buffer;
+        uint64_t size = 0;
+        RHIReadbackPromiseRef promise;
+        RHIFenceRef fence;
+    };
+
+    void resolve(PendingReadback& readback);
+
+    static constexpr uint64_t MIN_BUFFER_SIZE = 256;
+    static constexpr uint32_t MAX_FREE_BUFFERS = 16;
+
+    RHIBackend& backend_;
+
+    std::mutex mutex_;
+    std::vector<RHIBufferRef> free_buffers_;
+    std::vector<PendingReadback> pending_;
+};
@@ -14,6 +14,14 @@ Extent3D RHITexture::mip_extent(uint32_t mip_level) {
     return size;
 }
 
+void RHIQueue::signal(RHITimelineSemaphoreRef semaphore, uint64_t value) {
+    if (semaphore) semaphore->signal(value);
+}
+
+void RHIQueue::wait(RHITimelineSemaphoreRef semaphore, uint64_t value) {
+    if (semaphore) semaphore->wait(value);
+}
+
 RHICommandListRef RHICommandPool::create_command_list(bool bypass) {
     RHICommandContextRef context = nullptr;
     {
@@ -32,6 +40,7 @@ RHICommandListRef RHICommandPool::create_command_list(bool bypass) {
     CommandListInfo info;
     info.pool = std::static_pointer_cast<RHICommandPool>(shared_from_this());
     info.context = context;
+    info.backend = RHIBackend::get().get();
     info.bypass = bypass;
 
     return std::make_shared<RHICommandList>(info);
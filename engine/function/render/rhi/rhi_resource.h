@@ -40,6 +40,18 @@ public:
 
     virtual void wait_idle() = 0;
 
+    /**
+     * @brief Set the timeline to value once all work submitted to this queue so far has completed.
+     *        The default signals immediately, which is only correct for queues that execute synchronously.
+     */
+    virtual void signal(RHITimelineSemaphoreRef semaphore, uint64_t value);
+
+    /**
+     * @brief Make work submitted after this call wait until the timeline reaches value.
+     *        The default blocks the calling thread.
+     */
+    virtual void wait(RHITimelineSemaphoreRef semaphore, uint64_t value);
+
 protected:
     RHIQueueInfo info_;
 };
@@ -285,9 +297,42 @@ public:
     virtual bool init() { return true; }
 
     virtual void wait() = 0;
+
+    /**
+     * @brief Non-blocking poll. The default reports signaled, which is only correct for synchronous backends.
+     */
+    virtual bool is_signaled() { return true; }
 };
 
 class RHISemaphore : public RHIResource {
 public:
     RHISemaphore() : RHIResource(RHI_SEMAPHORE) {}
 };
+
+/**
+ * @brief Monotonically increasing 64-bit sync counter (Vulkan timeline semaphore / D3D12 fence style).
+ *
+ * Producers signal increasing values from the CPU or through RHIQueue::signal,
+ * consumers wait for a value or poll get_completed_value(). Values never go backwards;
+ * signalling a value lower than the current one is ignored.
+ */
+class RHITimelineSemaphore : public RHIResource {
+public:
+    RHITimelineSemaphore() : RHIResource(RHI_TIMELINE_SEMAPHORE) {}
+
+    virtual uint64_t get_completed_value() = 0;
+
+    /**
+     * @brief Signal value from the CPU.
+     */
+    virtual void signal(uint64_t value) = 0;
+
+    /**
+     * @brief Block the calling thread until the timeline reaches value.
+     * @param timeout_ms Maximum time to wait, UINT64_MAX waits forever
+     * @return true if the value was reached, false on timeout
+     */
+    virtual bool wait(uint64_t value, uint64_t timeout_ms = UINT64_MAX) = 0;
+
+    bool is_completed(uint64_t value) { return get_completed_value() >= value; }
+};
@@ -36,6 +36,7 @@ using RHISwapchainRef = std::shared_ptr<class RHISwapchain>;
 using RHICommandPoolRef = std::shared_ptr<class RHICommandPool>;
 using RHIFenceRef = std::shared_ptr<class RHIFence>;
 using RHISemaphoreRef = std::shared_ptr<class RHISemaphore>;
+using RHITimelineSemaphoreRef = std::shared_ptr<class RHITimelineSemaphore>;
 
 enum RHIResourceType : uint32_t {
     RHI_BUFFER = 0,
@@ -63,6 +64,7 @@ enum RHIResourceType : uint32_t {
     RHI_COMMAND_CONTEXT_IMMEDIATE,
     RHI_FENCE,
     RHI_SEMAPHORE,
+    RHI_TIMELINE_SEMAPHORE,
 
     RHI_RESOURCE_TYPE_MAX_CNT,
 };
@@ -334,6 +336,63 @@ static bool is_rw_format(RHIFormat format) {
     }
 }
 
+static uint32_t format_pixel_size(RHIFormat format) {
+    switch (format) {
+        case FORMAT_B8G8R8A8_UNORM:
+        case FORMAT_D24_UNORM_S8_UINT:
+            return 4;
+        case FORMAT_D32_SFLOAT_S8_UINT:
+            return 8;
+
+        case FORMAT_R16_SFLOAT:
+        case FORMAT_R16G16_SFLOAT:
+        case FORMAT_R16G16B16_SFLOAT:
+        case FORMAT_R16G16B16A16_SFLOAT:
+        case FORMAT_R16_UNORM:
+        case FORMAT_R16G16_UNORM:
+        case FORMAT_R16G16B16_UNORM:
+        case FORMAT_R16G16B16A16_UNORM:
+        case FORMAT_R16_SNORM:
+        case FORMAT_R16G16_SNORM:
+        case FORMAT_R16G16B16_SNORM:
+        case FORMAT_R16G16B16A16_SNORM:
+        case FORMAT_R16_UINT:
+        case FORMAT_R16G16_UINT:
+        case FORMAT_R16G16B16_UINT:
+        case FORMAT_R16G16B16A16_UINT:
+        case FORMAT_R16_SINT:
+        case FORMAT_R16G16_SINT:
+        case FORMAT_R16G16B16_SINT:
+        case FORMAT_R16G16B16A16_SINT:
+            return 2 * format_channel_counts(format);
+
+        case FORMAT_R32_SFLOAT:
+        case FORMAT_R32G32_SFLOAT:
+        case FORMAT_R32G32B32_SFLOAT:
+        case FORMAT_R32G32B32A32_SFLOAT:
+        case FORMAT_R32_UINT:
+        case FORMAT_R32G32_UINT:
+        case FORMAT_R32G32B32_UINT:
+        case FORMAT_R32G32B32A32_UINT:
+        case FORMAT_R32_SINT:
+        case FORMAT_R32G32_SINT:
+        case FORMAT_R32G32B32_SINT:
+        case FORMAT_R32G32B32A32_SINT:
+        case FORMAT_D32_SFLOAT:
+            return 4 * format_channel_counts(format);
+
+        default:
+            return format_channel_counts(format); // 8-bit components
+    }
+}
+
+/**
+ * @brief Row pitch of texel data in a staging buffer consumed by copy_buffer_to_texture (256-byte aligned rows).
+ */
+static uint32_t texture_upload_row_pitch(RHIFormat format, uint32_t width) {
+    return (width * format_pixel_size(format) + 255) & ~255u;
+}
+
 enum FilterType : uint32_t {
     FILTER_TYPE_NEAREST = 0,
     FILTER_TYPE_LINEAR,
@@ -0,0 +1,287 @@
+#include "engine/function/render/rhi/rhi_upload_batcher.h"
+#include "engine/function/render/rhi/rhi.h"
+#include "engine/core/log/Log.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+DEFINE_LOG_TAG(LogUploadBatcher, "UploadBatcher");
+
+static uint64_t align_up(uint64_t value, uint64_t alignment) {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+static uint64_t texture_staging_size(const RHIUploadTextureData& upload) {
+    Extent3D extent = upload.texture->mip_extent(upload.subresource.mip_level);
+    RHIFormat format = upload.texture->get_info().format;
+    return (uint64_t)texture_upload_row_pitch(format, extent.width) * extent.height * extent.depth;
+}
+
+uint64_t RHIUploadRequest::staging_size() const {
+    uint64_t size = 0;
+    for (const auto& upload : textures) {
+        if (upload.texture) size += texture_staging_size(upload) + RHIUploadBatcher::TEXTURE_PLACEMENT_ALIGNMENT;
+    }
+    for (const auto& upload : buffers) {
+        size += align_up(upload.data.size(), RHIUploadBatcher::BUFFER_PLACEMENT_ALIGNMENT);
+    }
+    return size;
+}
+
+void RHIUploadBatcher::enqueue(RHIUploadRequest&& request) {
+    uint64_t size = request.staging_size();
+    std::unique_lock<std::mutex> lock(mutex_);
+    // Keep submission order: once something overflows, later requests queue behind it
+    if (!overflow_.empty()) {
+        overflow_.push_back(std::move(request));
+        return;
+    }
+    // try_stage may unlock while it waits for an arena; whatever overflowed meanwhile was enqueued after this request
+    if (!try_stage(lock, request, size)) overflow_.push_front(std::move(request));
+}
+
+bool RHIUploadBatcher::init_timeline() {
+    if (timeline_) return true;
+    queue_ = backend_.get_queue({ QUEUE_TYPE_GRAPHICS, 0 });
+    timeline_ = backend_.create_timeline_semaphore(0);
+    if (!queue_ || !timeline_) {
+        ERR(LogUploadBatcher, "Failed to create the upload timeline");
+        queue_ = nullptr;
+        timeline_ = nullptr;
+        return false;
+    }
+    return true;
+}
+
+bool RHIUploadBatcher::open_arena(std::unique_lock<std::mutex>& lock, uint64_t size) {
+    if (!init_timeline()) return false;
+    uint32_t index = (arena_index_ + 1) % STAGING_ARENA_COUNT;
+    arena_index_ = index;
+
+    // The copies of the arena's last submission may still be reading it. Wait unlocked: the
+    // render thread needs mutex_ to reach the submission that signals this value.
+    uint64_t last_value = arena_timeline_values_[index];
+    if (arenas_[index] && !timeline_->is_completed(last_value)) {
+        RHITimelineSemaphoreRef timeline = timeline_;
+        arena_opening_ = true;
+        lock.unlock();
+        timeline->wait(last_value);
+        lock.lock();
+        arena_opening_ = false;
+        if (!timeline_) return false; // Destroyed while waiting
+    }
+    RHIBufferRef& arena = arenas_[index];
+
+    uint64_t capacity = std::max(size, frame_budget_);
+    if (!arena || arena->get_info().size < capacity) {
+        RHIBufferInfo info = {};
+        info.size = capacity;
+        info.memory_usage = MEMORY_USAGE_CPU_ONLY;
+        info.type = RESOURCE_TYPE_BUFFER;
+        info.creation_flag = BUFFER_CREATION_PERSISTENT_MAP;
+        arena = backend_.create_buffer(info);
+        if (!arena) {
+            ERR(LogUploadBatcher, "Failed to create a {} byte staging arena", capacity);
+            return false;
+        }
+        backend_.set_name(arena, "UploadStagingArena");
+    }
+
+    open_arena_data_ = static_cast<uint8_t*>(arena->map());
+    if (!open_arena_data_) {
+        arena->unmap();
+        ERR(LogUploadBatcher, "Failed to map staging arena");
+        return false;
+    }
+    open_arena_ = arena;
+    open_arena_offset_ = 0;
+    return true;
+}
+
+bool RHIUploadBatcher::try_stage(std::unique_lock<std::mutex>& lock, RHIUploadRequest& request, uint64_t size) {
+    if (arena_opening_) return false;
+
+    // A request that does not fit an empty arena gets a bigger one to itself
+    if (open_arena_ && staged_.empty() && size > open_arena_->get_info().size) {
+        open_arena_->unmap();
+        open_arena_ = nullptr;
+    }
+    if (!open_arena_ && !open_arena(lock, size)) return false;
+    if (!staged_.empty() && open_arena_offset_ + size > std::min(frame_budget_, open_arena_->get_info().size)) return false;
+
+    StagedRequest staged;
+    for (auto& upload : request.textures) {
+        uint64_t offset = align_up(open_arena_offset_, TEXTURE_PLACEMENT_ALIGNMENT);
+        staged.texture_offsets.push_back(offset);
+        if (!upload.texture) continue;
+
+        RHIFormat format = upload.texture->get_info().format;
+        Extent3D extent = upload.texture->mip_extent(upload.subresource.mip_level);
+        uint64_t row_size = (uint64_t)extent.width * format_pixel_size(format);
+        uint64_t row_pitch = texture_upload_row_pitch(format, extent.width);
+        uint64_t row_count = (uint64_t)extent.height * extent.depth;
+        if (upload.data.size() < row_size * row_count) {
+            WARN(LogUploadBatcher, "Texture upload of {} bytes is smaller than the subresource ({} bytes), skipped",
+                 upload.data.size(), row_size * row_count);
+            upload.texture = nullptr;
+            continue;
+        }
+
+        uint8_t* dst = open_arena_data_ + offset;
+        if (row_pitch == row_size) {
+            memcpy(dst, upload.data.data(), row_size * row_count);
+        } else {
+            for (uint64_t row = 0; row < row_count; ++row) {
+                memcpy(dst + row * row_pitch, upload.data.data() + row * row_size, row_size);
+            }
+        }
+        upload.data = {};
+        open_arena_offset_ = offset + row_pitch * row_count;
+    }
+    for (auto& upload : request.buffers) {
+        uint64_t offset = align_up(open_arena_offset_, BUFFER_PLACEMENT_ALIGNMENT);
+        staged.buffer_offsets.push_back(offset);
+        staged.buffer_sizes.push_back(upload.data.size());
+        memcpy(open_arena_data_ + offset, upload.data.data(), upload.data.size());
+        open_arena_offset_ = offset + upload.data.size();
+        upload.data = {};
+    }
+
+    staged.request = std::move(request);
+    staged_.push_back(std::move(staged));
+    return true;
+}
+
+void RHIUploadBatcher::tick() {
+    std::lock_guard<std::mutex> submit_lock(submit_mutex_);
+    submit_staged();
+}
+
+void RHIUploadBatcher::flush() {
+    std::lock_guard<std::mutex> submit_lock(submit_mutex_);
+    // Overflow is staged by one submission and sent by the next; stop if staging keeps failing
+    uint32_t idle_rounds = 0;
+    while (get_pending_count() > 0 && idle_rounds < 2) {
+        idle_rounds = submit_staged().request_count > 0 ? 0 : idle_rounds + 1;
+    }
+}
+
+uint32_t RHIUploadBatcher::get_pending_count() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return (uint32_t)(staged_.size() + overflow_.size());
+}
+
+RHIUploadBatcherStats RHIUploadBatcher::get_last_stats() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return last_stats_;
+}
+
+RHIUploadBatcherStats RHIUploadBatcher::get_total_stats() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return total_stats_;
+}
+
+void RHIUploadBatcher::destroy() {
+    std::lock_guard<std::mutex> submit_lock(submit_mutex_);
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (open_arena_) open_arena_->unmap();
+    open_arena_ = nullptr;
+    open_arena_data_ = nullptr;
+    staged_.clear();
+    overflow_.clear();
+    arenas_ = {};
+    arena_timeline_values_ = {};
+    timeline_value_ = 0;
+    timeline_ = nullptr;
+    queue_ = nullptr;
+}
+
+RHIUploadBatcherStats RHIUploadBatcher::submit_staged() {
+    std::vector<StagedRequest> batch;
+    RHIBufferRef arena;
+    uint64_t staging_bytes = 0;
+    uint64_t timeline_value = 0;
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        batch.swap(staged_);
+        arena = open_arena_;
+        staging_bytes = open_arena_offset_;
+        if (!batch.empty() && arena) {
+            // Reserved before the overflow opens the next arena, signaled once the copies are flushed
+            timeline_value = ++timeline_value_;
+            arena_timeline_values_[arena_index_] = timeline_value;
+        }
+        if (open_arena_) open_arena_->unmap();
+        open_arena_ = nullptr;
+        open_arena_data_ = nullptr;
+        open_arena_offset_ = 0;
+
+        // Stage the overflow into the next arena, to be submitted next frame
+        while (!overflow_.empty()) {
+            RHIUploadRequest& request = overflow_.front();
+            if (!try_stage(lock, request, request.staging_size())) break;
+            overflow_.pop_front();
+        }
+    }
+
+    RHIUploadBatcherStats stats = {};
+    stats.request_count = (uint32_t)batch.size();
+    stats.staging_bytes = staging_bytes;
+
+    if (!batch.empty()) {
+        RHICommandContextImmediateRef command = backend_.get_immediate_command();
+        if (!command) {
+            ERR(LogUploadBatcher, "No immediate command to submit {} upload request(s)", batch.size());
+        } else {
+            for (auto& staged : batch) {
+                RHIUploadRequest& request = staged.request;
+                for (size_t i = 0; i < request.textures.size(); ++i) {
+                    auto& upload = request.textures[i];
+                    if (!upload.texture) continue;
+                    TextureSubresourceRange range = {TEXTURE_ASPECT_COLOR, upload.subresource.mip_level, 1, upload.subresource.base_array_layer, 1};
+                    command->texture_barrier({upload.texture, RESOURCE_STATE_UNDEFINED, RESOURCE_STATE_TRANSFER_DST, range});
+                    command->copy_buffer_to_texture(arena, staged.texture_offsets[i], upload.texture, upload.subresource);
+                    bool mips_pending = std::find(request.generate_mips.begin(), request.generate_mips.end(), upload.texture) != request.generate_mips.end();
+                    if (!mips_pending) {
+                        command->texture_barrier({upload.texture, RESOURCE_STATE_TRANSFER_DST, RESOURCE_STATE_SHADER_RESOURCE, range});
+                    }
+                    stats.copy_count++;
+                }
+                for (size_t i = 0; i < request.buffers.size(); ++i) {
+                    auto& upload = request.buffers[i];
+                    if (!upload.buffer || staged.buffer_sizes[i] == 0) continue;
+                    command->copy_buffer(arena, staged.buffer_offsets[i], upload.buffer, upload.offset, staged.buffer_sizes[i]);
+                    stats.copy_count++;
+                }
+                for (auto& texture : request.generate_mips) {
+                    if (!texture) continue;
+                    const RHITextureInfo& info = texture->get_info();
+                    TextureSubresourceRange range = {TEXTURE_ASPECT_COLOR, 0, info.mip_levels, 0, info.array_layers};
+                    command->texture_barrier({texture, RESOURCE_STATE_TRANSFER_DST, RESOURCE_STATE_TRANSFER_SRC, range});
+                    command->generate_mips(texture);
+                    command->texture_barrier({texture, RESOURCE_STATE_TRANSFER_SRC, RESOURCE_STATE_SHADER_RESOURCE, range});
+                }
+            }
+            command->flush();
+            stats.submission_count = 1;
+        }
+
+        if (timeline_value > 0) {
+            if (command) queue_->signal(timeline_, timeline_value);
+            else timeline_->signal(timeline_value); // Nothing was recorded, the arena is free again
+        }
+
+        for (auto& staged : batch) {
+            if (staged.request.on_complete) staged.request.on_complete();
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    last_stats_ = stats;
+    total_stats_.request_count += stats.request_count;
+    total_stats_.copy_count += stats.copy_count;
+    total_stats_.submission_count += stats.submission_count;
+    total_stats_.staging_bytes += stats.staging_bytes;
+    return stats;
+}
@@ -0,0 +1,136 @@
+#pragma once
+
+#include "engine/function/render/rhi/rhi_resource.h"
+
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+class RHIBackend;
+
+/**
+ * @brief Texel data for one texture subresource, tightly packed (row = width * format_pixel_size).
+ */
+struct RHIUploadTextureData {
+    RHITextureRef texture;
+    TextureSubresourceLayers subresource;
+    std::vector<uint8_t> data;
+};
+
+struct RHIUploadBufferData {
+    RHIBufferRef buffer;
+    uint64_t offset = 0;
+    std::vector<uint8_t> data;
+};
+
+/**
+ * @brief All uploads of one asset. A request is never split across batches, and
+ *        on_complete runs after the batch containing it has been submitted.
+ */
+struct RHIUploadRequest {
+    std::vector<RHIUploadTextureData> textures;
+    std::vector<RHIUploadBufferData> buffers;
+    std::vector<RHITextureRef> generate_mips; // Recorded after all copies of the request
+
+    std::function<void()> on_complete;
+
+    uint64_t staging_size() const;
+};
+
+struct RHIUploadBatcherStats {
+    uint32_t request_count = 0;
+    uint32_t copy_count = 0;
+    uint32_t submission_count = 0;
+    uint64_t staging_bytes = 0;
+};
+
+/**
+ * @brief Accumulates uploads from many assets into one staging arena and one submission per frame.
+ *
+ * Loaders (any thread) enqueue requests; their data is written straight into the frame's
+ * open staging arena while it stays within the frame budget, and held back in an overflow
+ * queue otherwise. The render thread calls tick() once per frame, which records the copies
+ * of everything staged in the open arena on the immediate context, flushes it once, and then
+ * opens the next arena and stages as much of the overflow as the budget allows. Arenas rotate
+ * over STAGING_ARENA_COUNT frames; each submission signals a timeline value, and an arena is
+ * only written again once the GPU has reached the value of its last submission. That wait
+ * happens with the batcher unlocked, so a loader blocked on it never stalls the render thread;
+ * requests enqueued meanwhile go to the overflow queue.
+ */
+class RHIUploadBatcher {
+public:
+    static constexpr uint64_t DEFAULT_FRAME_BUDGET = 32ull * 1024 * 1024;
+    static constexpr uint32_t STAGING_ARENA_COUNT = 3;
+    static constexpr uint64_t TEXTURE_PLACEMENT_ALIGNMENT = 512;
+    static constexpr uint64_t BUFFER_PLACEMENT_ALIGNMENT = 16;
+
+    RHIUploadBatcher(RHIBackend& backend) : backend_(backend) {}
+
+    void enqueue(RHIUploadRequest&& request);
+
+    /**
+     * @brief Submit the requests staged for this frame. A single request larger than the
+     *        budget gets an arena of its own, so it is never split or starved.
+     */
+    void tick();
+
+    /**
+     * @brief Submit every pending request, ignoring the frame budget.
+     */
+    void flush();
+
+    void destroy();
+
+    void set_frame_budget(uint64_t bytes) { frame_budget_ = bytes; }
+    uint64_t get_frame_budget() const { return frame_budget_; }
+
+    /**
+     * @brief Requests enqueued but not yet submitted (staged or overflowing).
+     */
+    uint32_t get_pending_count();
+
+    /**
+     * @brief Statistics of the last tick(), and totals since creation.
+     */
+    RHIUploadBatcherStats get_last_stats();
+    RHIUploadBatcherStats get_total_stats();
+
+private:
+    struct StagedRequest {
+        RHIUploadRequest request; // Data vectors released once copied into the arena
+        std::vector<uint64_t> texture_offsets;
+        std::vector<uint64_t> buffer_offsets;
+        std::vector<uint64_t> buffer_sizes;
+    };
+
+    // Both require mutex_ held through lock, and release it while waiting for a reused arena
+    bool try_stage(std::unique_lock<std::mutex>& lock, RHIUploadRequest& request, uint64_t size);
+    bool open_arena(std::unique_lock<std::mutex>& lock, uint64_t size);
+    RHIUploadBatcherStats submit_staged();
+    bool init_timeline();                                       // Requires mutex_
+
+    RHIBackend& backend_;
+    uint64_t frame_budget_ = DEFAULT_FRAME_BUDGET;
+
+    std::mutex submit_mutex_; // Taken before mutex_
+    std::mutex mutex_;
+
+    std::array<RHIBufferRef, STAGING_ARENA_COUNT> arenas_ = {};
+    std::array<uint64_t, STAGING_ARENA_COUNT> arena_timeline_values_ = {}; // Value signaled by the arena's last submission
+    uint32_t arena_index_ = 0;
+    bool arena_opening_ = false; // A thread is waiting for the next arena with mutex_ released
+    RHIQueueRef queue_;
+    RHITimelineSemaphoreRef timeline_;
+    uint64_t timeline_value_ = 0; // Last value handed to a submission
+    RHIBufferRef open_arena_;
+    uint8_t* open_arena_data_ = nullptr;
+    uint64_t open_arena_offset_ = 0;
+    std::vector<StagedRequest> staged_;
+    std::deque<RHIUploadRequest> overflow_;
+
+    RHIUploadBatcherStats last_stats_ = {};
+    RHIUploadBatcherStats total_stats_ = {};
+};
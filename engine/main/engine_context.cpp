@@ -181,19 +181,26 @@ void EngineContext::main_loop_internal() {
 		// Fill packet with data from World/Scene
 		if (instance_->world_) {
 			Scene* active_scene = instance_->world_->get_active_scene();
-			packet.active_scene = active_scene;
+			packet.editor_scene = active_scene;
 			
 			// Find active camera in scene
 			if (active_scene) {
 				PROFILE_SCOPE("MainLoop_FindCamera");
 				for (const auto& entity : active_scene->entities_) {
 					if (auto* camera = entity->get_component<CameraComponent>()) {
-						packet.active_camera = camera;
+						packet.editor_camera = camera;
 						break;
 					}
 				}
 			}
 		}
+
+		// Copy what the renderer needs, so the next game tick can run while this frame renders
+		if (instance_->render_system_) {
+			PROFILE_SCOPE("MainLoop_ExtractScene");
+			packet.scene = instance_->render_system_->extract_scene(
+				packet.editor_scene, packet.editor_camera, instance_->current_frame_index_);
+		}
 		
 		if (instance_->mode_.test(StartMode::SingleThread) && instance_->render_system_) {
 			PROFILE_SCOPE("MainLoop_Render");
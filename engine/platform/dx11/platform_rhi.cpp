@@ -9,6 +9,8 @@
 #include <imgui_impl_dx11.h>
 #include <imgui_impl_win32.h>
 #include <d3dcompiler.h>
+#include <algorithm>
+#include <chrono>
 
 #include <imgui.h>
 #include "imgui_impl_win32.h"
@@ -31,6 +33,8 @@ public:
             case FORMAT_R8G8B8A8_UNORM: return DXGI_FORMAT_R8G8B8A8_UNORM;
             case FORMAT_B8G8R8A8_UNORM: return DXGI_FORMAT_B8G8R8A8_UNORM;
             case FORMAT_R16G16B16A16_SFLOAT: return DXGI_FORMAT_R16G16B16A16_FLOAT;
+            case FORMAT_R16G16_SFLOAT: return DXGI_FORMAT_R16G16_FLOAT;
+            case FORMAT_R16G16_SNORM: return DXGI_FORMAT_R16G16_SNORM;
             case FORMAT_R32G32B32A32_SFLOAT: return DXGI_FORMAT_R32G32B32A32_FLOAT;
             case FORMAT_R32G32_SFLOAT: return DXGI_FORMAT_R32G32_FLOAT;
             case FORMAT_R32_SFLOAT: return DXGI_FORMAT_R32_FLOAT;
@@ -134,12 +138,40 @@ bool DX11Buffer::init() {
         desc.CPUAccessFlags = D3D11_CPU_ACCESS_READ | D3D11_CPU_ACCESS_WRITE;
     }
 
+    // Structured buffer: generic buffer with an element stride, readable from shaders
+    bool structured = (info_.type & RESOURCE_TYPE_BUFFER) && info_.stride > 0 && desc.Usage != D3D11_USAGE_STAGING;
+    if (structured) {
+        desc.BindFlags |= D3D11_BIND_SHADER_RESOURCE;
+        desc.MiscFlags = D3D11_RESOURCE_MISC_BUFFER_STRUCTURED;
+        desc.StructureByteStride = info_.stride;
+    }
+
+    // Argument buffer of DrawIndexedInstancedIndirect. A dynamic buffer needs a bind flag, the
+    // shader resource one is harmless here and lets a compute pass read the arguments later.
+    if (info_.type & RESOURCE_TYPE_INDIRECT_BUFFER) {
+        desc.MiscFlags |= D3D11_RESOURCE_MISC_DRAWINDIRECT_ARGS;
+        if (desc.BindFlags == 0 && desc.Usage == D3D11_USAGE_DYNAMIC) desc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+    }
+
     HRESULT hr = backend->get_device()->CreateBuffer(&desc, nullptr, buffer_.GetAddressOf());
     if (FAILED(hr)) {
         ERR(LogRHI, "Failed to create DX11 Buffer (HRESULT: 0x{:08X})", (uint32_t)hr);
         return false;
     }
 
+    if (structured) {
+        D3D11_SHADER_RESOURCE_VIEW_DESC srv_desc = {};
+        srv_desc.Format = DXGI_FORMAT_UNKNOWN;
+        srv_desc.ViewDimension = D3D11_SRV_DIMENSION_BUFFER;
+        srv_desc.Buffer.FirstElement = 0;
+        srv_desc.Buffer.NumElements = (UINT)(info_.size / info_.stride);
+        hr = backend->get_device()->CreateShaderResourceView(buffer_.Get(), &srv_desc, srv_.GetAddressOf());
+        if (FAILED(hr)) {
+            ERR(LogRHI, "Failed to create structured buffer SRV (HRESULT: 0x{:08X})", (uint32_t)hr);
+            return false;
+        }
+    }
+
     if (!get_name().empty()) {
         backend->set_name(shared_from_this(), get_name());
     }
@@ -179,9 +211,11 @@ void* DX11Buffer::map() {
         return nullptr;
     }
 
+    auto lock = backend->lock_context();
     HRESULT hr = backend->get_context()->Map(buffer_.Get(), 0, map_type, 0, &mapped_res);
     if (SUCCEEDED(hr)) {
         mapped_data_ = mapped_res.pData;
+        resolve_texture_copies(backend->get_context().Get());
         return mapped_data_;
     }
     return nullptr;
@@ -191,11 +225,64 @@ void DX11Buffer::unmap() {
     if (!buffer_ || !mapped_data_) return;
     auto backend = backend_.lock();
     if (!backend || !backend->is_valid()) return;
+    auto lock = backend->lock_context();
     backend->get_context()->Unmap(buffer_.Get(), 0);
     mapped_data_ = nullptr;
 }
 
-void DX11Buffer::destroy() { buffer_.Reset(); }
+bool DX11Buffer::record_texture_copy(ID3D11DeviceContext* context, ID3D11Texture2D* src, uint32_t src_subresource,
+                                     const D3D11_TEXTURE2D_DESC& staging_desc, uint64_t offset, uint32_t row_pitch) {
+    if (!buffer_ || !context || !src) return false;
+    if (offset + (uint64_t)row_pitch * staging_desc.Height > info_.size) return false;
+
+    ComPtr<ID3D11Texture2D> staging;
+    if (readback_texture_) {
+        D3D11_TEXTURE2D_DESC cached_desc;
+        readback_texture_->GetDesc(&cached_desc);
+        if (cached_desc.Width == staging_desc.Width && cached_desc.Height == staging_desc.Height &&
+            cached_desc.Format == staging_desc.Format) {
+            staging = std::move(readback_texture_);
+        }
+    }
+    if (!staging) {
+        auto backend = backend_.lock();
+        if (!backend || !backend->is_valid()) return false;
+        HRESULT hr = backend->get_device()->CreateTexture2D(&staging_desc, nullptr, staging.GetAddressOf());
+        if (FAILED(hr)) {
+            ERR(LogRHI, "Failed to create readback staging texture (HRESULT: 0x{:08X})", (uint32_t)hr);
+            return false;
+        }
+    }
+
+    // Only the copy is recorded here; the Map happens in map(), once the caller's fence has passed
+    context->CopySubresourceRegion(staging.Get(), 0, 0, 0, 0, src, src_subresource, nullptr);
+    pending_texture_copies_.push_back({ std::move(staging), offset, row_pitch, staging_desc.Height });
+    return true;
+}
+
+void DX11Buffer::resolve_texture_copies(ID3D11DeviceContext* context) {
+    for (auto& copy : pending_texture_copies_) {
+        D3D11_MAPPED_SUBRESOURCE mapped;
+        HRESULT hr = context->Map(copy.staging.Get(), 0, D3D11_MAP_READ, 0, &mapped);
+        if (SUCCEEDED(hr)) {
+            uint8_t* dst = static_cast<uint8_t*>(mapped_data_) + copy.offset;
+            const uint8_t* src = static_cast<const uint8_t*>(mapped.pData);
+            for (uint32_t row = 0; row < copy.height; row++) {
+                memcpy(dst + (uint64_t)row * copy.row_pitch, src + (uint64_t)row * mapped.RowPitch, copy.row_pitch);
+            }
+            context->Unmap(copy.staging.Get(), 0);
+        }
+        readback_texture_ = std::move(copy.staging);
+    }
+    pending_texture_copies_.clear();
+}
+
+void DX11Buffer::destroy() {
+    pending_texture_copies_.clear();
+    readback_texture_.Reset();
+    srv_.Reset();
+    buffer_.Reset();
+}
 
 // --- DX11Texture ---
 DX11Texture::DX11Texture(const RHITextureInfo& info, std::shared_ptr<DX11Backend> backend, ComPtr<ID3D11Texture2D> handle)
@@ -896,13 +983,154 @@ void DX11Fence::wait() {
     if (!context) {
         return;
     }
-    while (context->GetData(query_.Get(), nullptr, 0, 0) == S_FALSE) {
+    while (true) {
+        {
+            auto lock = backend->lock_context();
+            if (context->GetData(query_.Get(), nullptr, 0, 0) != S_FALSE) break;
+        }
         Sleep(0);
     }
 }
 
+bool DX11Fence::is_signaled() {
+    if (!query_) return true;
+    auto backend = backend_.lock();
+    if (!backend || !backend->is_valid()) return true;
+    auto context = backend->get_context();
+    if (!context) return true;
+    auto lock = backend->lock_context();
+    return context->GetData(query_.Get(), nullptr, 0, D3D11_ASYNC_GETDATA_DONOTFLUSH) != S_FALSE;
+}
+
 void DX11Fence::destroy() { query_.Reset(); }
 
+// --- DX11Queue ---
+void DX11Queue::signal(RHITimelineSemaphoreRef semaphore, uint64_t value) {
+    if (!semaphore) return;
+    auto backend = backend_.lock();
+    if (!backend || !backend->is_valid()) {
+        semaphore->signal(value);
+        return;
+    }
+
+    ComPtr<ID3D11Query> query;
+    D3D11_QUERY_DESC desc = { D3D11_QUERY_EVENT, 0 };
+    if (FAILED(backend->get_device()->CreateQuery(&desc, query.GetAddressOf()))) {
+        ERR(LogRHI, "DX11Queue::signal: failed to create event query, signalling on CPU");
+        semaphore->signal(value);
+        return;
+    }
+
+    auto lock = backend->lock_context();
+    backend->get_context()->End(query.Get());
+    resource_cast(semaphore)->enqueue_gpu_signal(query, value);
+}
+
+void DX11Queue::wait(RHITimelineSemaphoreRef semaphore, uint64_t value) {
+    if (!semaphore) return;
+    // A single in-order queue already waits for anything it signalled itself;
+    // only values produced elsewhere (CPU signals) require blocking.
+    if (resource_cast(semaphore)->get_submitted_value() >= value) return;
+    semaphore->wait(value);
+}
+
+// --- DX11TimelineSemaphore ---
+DX11TimelineSemaphore::DX11TimelineSemaphore(uint64_t initial_value, std::shared_ptr<DX11Backend> backend)
+    : backend_(backend), completed_value_(initial_value), submitted_value_(initial_value) {
+}
+
+void DX11TimelineSemaphore::enqueue_gpu_signal(ComPtr<ID3D11Query> query, uint64_t value) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (value <= submitted_value_) return;
+    submitted_value_ = value;
+    pending_signals_.push_back({ query, value });
+}
+
+uint64_t DX11TimelineSemaphore::get_submitted_value() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return submitted_value_;
+}
+
+void DX11TimelineSemaphore::retire_finished_signals() {
+    auto backend = backend_.lock();
+    if (!backend || !backend->is_valid()) return;
+
+    bool advanced = false;
+    {
+        // Lock order: backend context first, then the semaphore
+        auto context_lock = backend->lock_context();
+        std::lock_guard<std::mutex> lock(mutex_);
+        while (!pending_signals_.empty()) {
+            auto& front = pending_signals_.front();
+            if (backend->get_context()->GetData(front.query.Get(), nullptr, 0, D3D11_ASYNC_GETDATA_DONOTFLUSH) == S_FALSE) break;
+            if (front.value > completed_value_) {
+                completed_value_ = front.value;
+                advanced = true;
+            }
+            pending_signals_.pop_front();
+        }
+    }
+    if (advanced) cv_.notify_all();
+}
+
+void DX11TimelineSemaphore::flush_pending_signals() {
+    auto backend = backend_.lock();
+    if (!backend || !backend->is_valid()) return;
+    auto context_lock = backend->lock_context();
+    backend->get_context()->Flush();
+}
+
+uint64_t DX11TimelineSemaphore::get_completed_value() {
+    retire_finished_signals();
+    std::lock_guard<std::mutex> lock(mutex_);
+    return completed_value_;
+}
+
+void DX11TimelineSemaphore::signal(uint64_t value) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (value <= completed_value_) return;
+        completed_value_ = value;
+        submitted_value_ = std::max(submitted_value_, value);
+    }
+    cv_.notify_all();
+}
+
+bool DX11TimelineSemaphore::wait(uint64_t value, uint64_t timeout_ms) {
+    auto start = std::chrono::steady_clock::now();
+    bool flushed = false;
+    while (true) {
+        retire_finished_signals();
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (completed_value_ >= value) return true;
+
+        if (timeout_ms != UINT64_MAX) {
+            auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+            if ((uint64_t)elapsed >= timeout_ms) return false;
+        }
+
+        if (pending_signals_.empty()) {
+            // Nothing in flight on the GPU; the value can only come from a CPU signal
+            cv_.wait_for(lock, std::chrono::milliseconds(1), [&]() { return completed_value_ >= value; });
+        } else {
+            lock.unlock();
+            if (!flushed) {
+                // The pending queries may not have reached the GPU yet, see the class comment
+                flush_pending_signals();
+                flushed = true;
+            } else {
+                Sleep(0);
+            }
+        }
+    }
+}
+
+void DX11TimelineSemaphore::destroy() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    pending_signals_.clear();
+}
+
 // --- DX11Backend ---
 DX11Backend::DX11Backend(const RHIBackendInfo& info) : RHIBackend(info) {
     UINT flags = 0;
@@ -1057,7 +1285,10 @@ void DX11Backend::destroy() {
         ImGui::DestroyContext();
     }
     
-    // Release immediate context wrapper first (it holds references to backend)
+    // Release immediate and per-thread upload context wrappers first (they hold references to backend)
+    destroy_upload_commands();
+    if (upload_batcher_) upload_batcher_->destroy();
+    if (readback_pool_) readback_pool_->destroy();
     immediate_context_.reset();
     
     // Release D3D11 resources
@@ -1135,7 +1366,7 @@ void DX11Backend::imgui_shutdown() {
     ImGui_ImplWin32_Shutdown();
     ImGui::DestroyContext();
 }
-RHIQueueRef DX11Backend::get_queue(const RHIQueueInfo& info) { return std::make_shared<DX11Queue>(info); }
+RHIQueueRef DX11Backend::get_queue(const RHIQueueInfo& info) { return std::make_shared<DX11Queue>(info, shared_from_this()); }
 
 RHISurfaceRef DX11Backend::create_surface(void* native_window_handle) {
     HWND hwnd = static_cast<HWND>(native_window_handle);
@@ -1235,8 +1466,18 @@ RHIFenceRef DX11Backend::create_fence(bool signaled) {
     return fence;
 }
 RHISemaphoreRef DX11Backend::create_semaphore() { return std::make_shared<DX11Semaphore>(*this); }
+RHITimelineSemaphoreRef DX11Backend::create_timeline_semaphore(uint64_t initial_value) {
+    auto semaphore = std::make_shared<DX11TimelineSemaphore>(initial_value, shared_from_this());
+    register_resource(semaphore);
+    return semaphore;
+}
 RHICommandContextImmediateRef DX11Backend::get_immediate_command() { return immediate_context_; }
 
+RHICommandContextImmediateRef DX11Backend::create_upload_command() {
+    if (!is_valid()) return nullptr;
+    return std::make_shared<DX11CommandContextImmediate>(*this, true);
+}
+
 std::vector<uint8_t> DX11Backend::compile_shader(const char* source, const char* entry, const char* profile) {
     ID3DBlob* blob = nullptr;
     ID3DBlob* error_blob = nullptr;
@@ -1287,6 +1528,7 @@ void DX11CommandContext::begin_command() {}
 void DX11CommandContext::end_command() {}
 void DX11CommandContext::execute(RHIFenceRef fence, RHISemaphoreRef ws, RHISemaphoreRef ss) {
     if (!context_) return;
+    auto lock = lock_context();
     
     // Clear all CS bindings to prevent UAV/SRV hazards across command batches.
     // DX11 shares one immediate context, so a UAV left bound on CS will cause
@@ -1309,14 +1551,21 @@ void DX11CommandContext::execute(RHIFenceRef fence, RHISemaphoreRef ws, RHISemap
     }
     context_->Flush();
 }
+std::unique_lock<std::recursive_mutex> DX11CommandContext::lock_context() {
+    // Workers upload through the same immediate context, so every call takes the lock for its own duration only
+    auto backend = backend_.lock();
+    if (!backend) return {};
+    return backend->lock_context();
+}
 void DX11CommandContext::texture_barrier(const RHITextureBarrier& b) {}
 void DX11CommandContext::buffer_barrier(const RHIBufferBarrier& b) {}
 void DX11CommandContext::copy_texture_to_buffer(RHITextureRef s, TextureSubresourceLayers ss, RHIBufferRef d, uint64_t doff) {
+    auto lock = lock_context();
     auto backend = backend_.lock();
     if (!backend || !backend->is_valid()) return;
     
-    // CopyResource cannot be used between different resource types (texture vs buffer)
-    // We need to create a staging texture, copy to it, then copy data to buffer
+    // CopyResource cannot be used between different resource types (texture vs buffer),
+    // so the subresource goes through a staging texture whose rows are packed into the buffer
     auto* dx11_texture = static_cast<DX11Texture*>(s.get());
     auto* dx11_buffer = static_cast<DX11Buffer*>(d.get());
     if (!dx11_texture || !dx11_buffer) return;
@@ -1330,7 +1579,7 @@ void DX11CommandContext::copy_texture_to_buffer(RHITextureRef s, TextureSubresou
     uint32_t height = tex_info.extent.height >> ss.mip_level;
     if (width == 0) width = 1;
     if (height == 0) height = 1;
-    uint32_t row_pitch = width * 4; // Assuming RGBA8 format
+    uint32_t row_pitch = width * format_pixel_size(tex_info.format);
     uint32_t aligned_row_pitch = (row_pitch + 255) & ~255;
     uint32_t total_size = aligned_row_pitch * height;
     
@@ -1346,13 +1595,25 @@ void DX11CommandContext::copy_texture_to_buffer(RHITextureRef s, TextureSubresou
     staging_desc.BindFlags = 0;
     staging_desc.CPUAccessFlags = D3D11_CPU_ACCESS_READ;
     
+    // Calculate source subresource index
+    uint32_t src_subresource = D3D11CalcSubresource(ss.mip_level, ss.base_array_layer, tex_info.mip_levels);
+    
+    // Staging destinations (readback pool buffers) only record the copy here. The staging texture
+    // is mapped when the buffer is, i.e. in RHIReadbackPool::resolve() after the fence has passed.
+    const auto& buf_info = dx11_buffer->get_info();
+    if (buf_info.memory_usage == MEMORY_USAGE_GPU_TO_CPU ||
+        buf_info.memory_usage == MEMORY_USAGE_CPU_ONLY) {
+        if (!dx11_buffer->record_texture_copy(context_.Get(), src_texture, src_subresource, staging_desc, doff, row_pitch)) {
+            ERR(LogRHI, "copy_texture_to_buffer: failed to record the copy into the staging buffer");
+        }
+        return;
+    }
+    
+    // GPU-side destinations need the texel data on the CPU right away, which stalls on the copy
     ComPtr<ID3D11Texture2D> staging_texture;
     HRESULT hr = backend->get_device()->CreateTexture2D(&staging_desc, nullptr, staging_texture.GetAddressOf());
     if (FAILED(hr)) return;
     
-    // Calculate source subresource index
-    uint32_t src_subresource = D3D11CalcSubresource(ss.mip_level, ss.base_array_layer, tex_info.mip_levels);
-    
     // Copy from source texture to staging texture
     context_->CopySubresourceRegion(staging_texture.Get(), 0, 0, 0, 0, src_texture, src_subresource, nullptr);
     
@@ -1361,12 +1622,8 @@ void DX11CommandContext::copy_texture_to_buffer(RHITextureRef s, TextureSubresou
     hr = context_->Map(staging_texture.Get(), 0, D3D11_MAP_READ, 0, &mapped);
     if (FAILED(hr)) return;
     
-    // Get buffer info to check if we can map it directly
-    // For GPU_DEFAULT buffers, we need to use UpdateSubresource
-    // For CPU accessible buffers, we can map directly
-    const auto& buf_info = dx11_buffer->get_info();
-    if (buf_info.memory_usage == MEMORY_USAGE_CPU_ONLY || 
-        buf_info.memory_usage == MEMORY_USAGE_CPU_TO_GPU) {
+    // Dynamic buffers can be written directly, GPU_DEFAULT buffers go through a temporary staging buffer
+    if (buf_info.memory_usage == MEMORY_USAGE_CPU_TO_GPU) {
         // Buffer is CPU accessible, map it
         D3D11_MAPPED_SUBRESOURCE buf_mapped;
         hr = context_->Map(dx11_buffer->get_handle().Get(), 0, D3D11_MAP_WRITE, 0, &buf_mapped);
@@ -1384,12 +1641,12 @@ void DX11CommandContext::copy_texture_to_buffer(RHITextureRef s, TextureSubresou
         // GPU_DEFAULT buffer, use UpdateSubresource via staging approach
         // Create a temporary staging buffer
         RHIBufferInfo staging_buf_info = {};
-        staging_buf_info.size = width * height * 4;
+        staging_buf_info.size = row_pitch * height;
         staging_buf_info.type = RESOURCE_TYPE_BUFFER;
         staging_buf_info.memory_usage = MEMORY_USAGE_CPU_ONLY;
         
         D3D11_BUFFER_DESC buf_desc = {};
-        buf_desc.ByteWidth = width * height * 4;
+        buf_desc.ByteWidth = row_pitch * height;
         buf_desc.Usage = D3D11_USAGE_STAGING;
         buf_desc.CPUAccessFlags = D3D11_CPU_ACCESS_READ | D3D11_CPU_ACCESS_WRITE;
         
@@ -1425,6 +1682,7 @@ void DX11CommandContext::copy_texture_to_buffer(RHITextureRef s, TextureSubresou
     context_->Unmap(staging_texture.Get(), 0);
 }
 void DX11CommandContext::copy_buffer_to_texture(RHIBufferRef s, uint64_t soff, RHITextureRef d, TextureSubresourceLayers ds) {
+    auto lock = lock_context();
     // For buffer to texture copy in DX11, we need to use UpdateSubresource
     // since CopyResource requires resources of the same type.
     auto* dx11_buffer = static_cast<DX11Buffer*>(s.get());
@@ -1439,13 +1697,10 @@ void DX11CommandContext::copy_buffer_to_texture(RHIBufferRef s, uint64_t soff, R
     
     // Get texture info for proper row pitch calculation
     const auto& tex_info = dx11_texture->get_info();
-    uint32_t width = tex_info.extent.width;
-    uint32_t height = tex_info.extent.height;
-    uint32_t bpp = 4; // Assuming RGBA8 format
-    
-    // Calculate row pitch with 256-byte alignment (as done in texture.cpp)
-    uint32_t row_pitch = width * bpp;
-    uint32_t aligned_row_pitch = (row_pitch + 255) & ~255;
+    Extent3D extent = dx11_texture->mip_extent(ds.mip_level);
+    uint32_t width = extent.width;
+    uint32_t height = extent.height;
+    uint32_t aligned_row_pitch = texture_upload_row_pitch(tex_info.format, width);
     
     // Use UpdateSubresource to copy data to the specific subresource
     uint32_t dst_subresource = D3D11CalcSubresource(ds.mip_level, ds.base_array_layer, tex_info.mip_levels);
@@ -1463,15 +1718,16 @@ void DX11CommandContext::copy_buffer_to_texture(RHIBufferRef s, uint64_t soff, R
         dx11_texture->get_handle().Get(),
         dst_subresource,
         &box,
-        mapped.pData,
+        static_cast<uint8_t*>(mapped.pData) + soff,
         aligned_row_pitch,
         aligned_row_pitch * height
     );
     
     context_->Unmap(dx11_buffer->get_handle().Get(), 0);
 }
-void DX11CommandContext::copy_buffer(RHIBufferRef s, uint64_t soff, RHIBufferRef d, uint64_t doff, uint64_t sz) { D3D11_BOX box = { (UINT)soff, 0, 0, (UINT)(soff + sz), 1, 1 }; context_->CopySubresourceRegion((ID3D11Resource*)d->raw_handle(), 0, (UINT)doff, 0, 0, (ID3D11Resource*)s->raw_handle(), 0, &box); }
+void DX11CommandContext::copy_buffer(RHIBufferRef s, uint64_t soff, RHIBufferRef d, uint64_t doff, uint64_t sz) { auto lock = lock_context(); D3D11_BOX box = { (UINT)soff, 0, 0, (UINT)(soff + sz), 1, 1 }; context_->CopySubresourceRegion((ID3D11Resource*)d->raw_handle(), 0, (UINT)doff, 0, 0, (ID3D11Resource*)s->raw_handle(), 0, &box); }
 void DX11CommandContext::copy_texture(RHITextureRef s, TextureSubresourceLayers ss, RHITextureRef d, TextureSubresourceLayers ds) {
+    auto lock = lock_context();
     // Use CopySubresourceRegion to support subresource-level copy
     auto* src_tex = static_cast<DX11Texture*>(s.get());
     auto* dst_tex = static_cast<DX11Texture*>(d.get());
@@ -1493,6 +1749,7 @@ void DX11CommandContext::copy_texture(RHITextureRef s, TextureSubresourceLayers
     );
 }
 void DX11CommandContext::generate_mips(RHITextureRef s) {
+    auto lock = lock_context();
     auto texture = std::static_pointer_cast<DX11Texture>(s);
     if (!texture) return;
     
@@ -1508,6 +1765,7 @@ void DX11CommandContext::generate_mips(RHITextureRef s) {
     context_->GenerateMips(srv.Get());
 }
 void DX11CommandContext::push_event(const std::string& name, Color3 color) {
+    auto lock = lock_context();
     Microsoft::WRL::ComPtr<ID3DUserDefinedAnnotation> annotation;
     if (SUCCEEDED(context_.As(&annotation))) {
         std::wstring wname(name.begin(), name.end());
@@ -1515,12 +1773,14 @@ void DX11CommandContext::push_event(const std::string& name, Color3 color) {
     }
 }
 void DX11CommandContext::pop_event() {
+    auto lock = lock_context();
     Microsoft::WRL::ComPtr<ID3DUserDefinedAnnotation> annotation;
     if (SUCCEEDED(context_.As(&annotation))) {
         annotation->EndEvent();
     }
 }
 void DX11CommandContext::begin_render_pass(RHIRenderPassRef rp) {
+    auto lock = lock_context();
     if (!rp) return;
     const auto& info = rp->get_info();
     
@@ -1556,6 +1816,7 @@ void DX11CommandContext::begin_render_pass(RHIRenderPassRef rp) {
     }
 }
 void DX11CommandContext::end_render_pass() {
+    auto lock = lock_context();
     // Unbind render targets to prevent resource conflicts
     ID3D11RenderTargetView* null_rtvs[MAX_RENDER_TARGETS] = {};
     ID3D11DepthStencilView* null_dsv = nullptr;
@@ -1569,12 +1830,13 @@ void DX11CommandContext::end_render_pass() {
     context_->VSSetShaderResources(0, SRV_SLOTS_TO_CLEAR, null_srvs);
     context_->PSSetShaderResources(0, SRV_SLOTS_TO_CLEAR, null_srvs);
 }
-void DX11CommandContext::set_viewport(Offset2D min, Offset2D max) { D3D11_VIEWPORT vp = { (float)min.x, (float)min.y, (float)(max.x - min.x), (float)(max.y - min.y), 0.0f, 1.0f }; context_->RSSetViewports(1, &vp); }
-void DX11CommandContext::set_scissor(Offset2D min, Offset2D max) { D3D11_RECT rect = { (LONG)min.x, (LONG)min.y, (LONG)max.x, (LONG)max.y }; context_->RSSetScissorRects(1, &rect); }
+void DX11CommandContext::set_viewport(Offset2D min, Offset2D max) { auto lock = lock_context(); D3D11_VIEWPORT vp = { (float)min.x, (float)min.y, (float)(max.x - min.x), (float)(max.y - min.y), 0.0f, 1.0f }; context_->RSSetViewports(1, &vp); }
+void DX11CommandContext::set_scissor(Offset2D min, Offset2D max) { auto lock = lock_context(); D3D11_RECT rect = { (LONG)min.x, (LONG)min.y, (LONG)max.x, (LONG)max.y }; context_->RSSetScissorRects(1, &rect); }
 void DX11CommandContext::set_depth_bias(float c, float s, float cl) {}
 void DX11CommandContext::set_line_width(float w) {}
-void DX11CommandContext::set_graphics_pipeline(RHIGraphicsPipelineRef p) { resource_cast(p)->bind(context_.Get()); }
+void DX11CommandContext::set_graphics_pipeline(RHIGraphicsPipelineRef p) { auto lock = lock_context(); resource_cast(p)->bind(context_.Get()); }
 void DX11CommandContext::set_compute_pipeline(RHIComputePipelineRef p) {
+    auto lock = lock_context();
     if (!context_) return;
     if (p) {
         resource_cast(p)->bind(context_.Get());
@@ -1586,12 +1848,14 @@ void DX11CommandContext::set_ray_tracing_pipeline(RHIRayTracingPipelineRef p) {}
 void DX11CommandContext::push_constants(void* d, uint16_t s, ShaderFrequency f) {}
 void DX11CommandContext::bind_descriptor_set(RHIDescriptorSetRef d, uint32_t s) {}
 void DX11CommandContext::bind_constant_buffer(RHIBufferRef b, uint32_t s, ShaderFrequency f) {
+    auto lock = lock_context();
     ID3D11Buffer* cb = (ID3D11Buffer*)b->raw_handle();
     if (f & SHADER_FREQUENCY_VERTEX) context_->VSSetConstantBuffers(s, 1, &cb);
     if (f & SHADER_FREQUENCY_FRAGMENT) context_->PSSetConstantBuffers(s, 1, &cb);
     if (f & SHADER_FREQUENCY_COMPUTE) context_->CSSetConstantBuffers(s, 1, &cb);
 }
 void DX11CommandContext::bind_texture(RHITextureRef t, uint32_t s, ShaderFrequency f) {
+    auto lock = lock_context();
     if (!t) {
         ID3D11ShaderResourceView* null_srv = nullptr;
         if (f & SHADER_FREQUENCY_VERTEX) context_->VSSetShaderResources(s, 1, &null_srv);
@@ -1618,6 +1882,7 @@ void DX11CommandContext::bind_texture(RHITextureRef t, uint32_t s, ShaderFrequen
 }
 
 void DX11CommandContext::bind_rw_texture(RHITextureRef t, uint32_t s, uint32_t mip_level, ShaderFrequency f) {
+    auto lock = lock_context();
     if (!(f & SHADER_FREQUENCY_COMPUTE)) return; // UAV only valid for compute
     
     if (!t) {
@@ -1660,7 +1925,22 @@ void DX11CommandContext::bind_rw_texture(RHITextureRef t, uint32_t s, uint32_t m
     if (backend) backend->check_debug_messages("bind_rw_texture");
 #endif
 }
+void DX11CommandContext::bind_buffer(RHIBufferRef b, uint32_t s, ShaderFrequency f) {
+    auto lock = lock_context();
+    ID3D11ShaderResourceView* srv_ptr = nullptr;
+    if (b) {
+        srv_ptr = static_cast<DX11Buffer*>(b.get())->get_srv().Get();
+        if (!srv_ptr) {
+            WARN(LogRHI, "bind_buffer: buffer has no SRV, create it as RESOURCE_TYPE_BUFFER with a stride");
+            return;
+        }
+    }
+    if (f & SHADER_FREQUENCY_VERTEX) context_->VSSetShaderResources(s, 1, &srv_ptr);
+    if (f & SHADER_FREQUENCY_FRAGMENT) context_->PSSetShaderResources(s, 1, &srv_ptr);
+    if (f & SHADER_FREQUENCY_COMPUTE) context_->CSSetShaderResources(s, 1, &srv_ptr);
+}
 void DX11CommandContext::bind_sampler(RHISamplerRef s, uint32_t slot, ShaderFrequency f) {
+    auto lock = lock_context();
     auto* dx11_sampler = static_cast<DX11Sampler*>(s.get());
     if (!dx11_sampler) return;
     
@@ -1669,15 +1949,17 @@ void DX11CommandContext::bind_sampler(RHISamplerRef s, uint32_t slot, ShaderFreq
     if (f & SHADER_FREQUENCY_FRAGMENT) context_->PSSetSamplers(slot, 1, &sampler);
     if (f & SHADER_FREQUENCY_COMPUTE) context_->CSSetSamplers(slot, 1, &sampler);
 }
-void DX11CommandContext::bind_vertex_buffer(RHIBufferRef b, uint32_t s, uint32_t o) { ID3D11Buffer* vb = (ID3D11Buffer*)b->raw_handle(); UINT stride = b->get_info().stride; UINT uo = (UINT)o; context_->IASetVertexBuffers(s, 1, &vb, &stride, &uo); }
-void DX11CommandContext::bind_index_buffer(RHIBufferRef b, uint32_t o) { context_->IASetIndexBuffer((ID3D11Buffer*)b->raw_handle(), DXGI_FORMAT_R32_UINT, (UINT)o); }
+void DX11CommandContext::bind_vertex_buffer(RHIBufferRef b, uint32_t s, uint32_t o) { auto lock = lock_context(); ID3D11Buffer* vb = (ID3D11Buffer*)b->raw_handle(); UINT stride = b->get_info().stride; UINT uo = (UINT)o; context_->IASetVertexBuffers(s, 1, &vb, &stride, &uo); }
+void DX11CommandContext::bind_index_buffer(RHIBufferRef b, uint32_t o) { auto lock = lock_context(); context_->IASetIndexBuffer((ID3D11Buffer*)b->raw_handle(), DXGI_FORMAT_R32_UINT, (UINT)o); }
 void DX11CommandContext::dispatch(uint32_t x, uint32_t y, uint32_t z) {
+    auto lock = lock_context();
     context_->Dispatch(x, y, z);
 #ifdef _DEBUG
     { auto b = backend_.lock(); if (b) b->check_debug_messages("dispatch"); }
 #endif
 }
 void DX11CommandContext::dispatch_indirect(RHIBufferRef b, uint32_t o) {
+    auto lock = lock_context();
     context_->DispatchIndirect((ID3D11Buffer*)b->raw_handle(), (UINT)o);
 #ifdef _DEBUG
     { auto bk = backend_.lock(); if (bk) bk->check_debug_messages("dispatch_indirect"); }
@@ -1685,38 +1967,51 @@ void DX11CommandContext::dispatch_indirect(RHIBufferRef b, uint32_t o) {
 }
 void DX11CommandContext::trace_rays(uint32_t x, uint32_t y, uint32_t z) {}
 void DX11CommandContext::draw(uint32_t vc, uint32_t ic, uint32_t fv, uint32_t fi) {
-    if (ic > 1) context_->DrawInstanced(vc, ic, fv, fi); else context_->Draw(vc, fv);
+    auto lock = lock_context();
+    if (ic > 1 || fi > 0) context_->DrawInstanced(vc, ic, fv, fi); else context_->Draw(vc, fv);
 #ifdef _DEBUG
     { auto b = backend_.lock(); if (b) b->check_debug_messages("draw"); }
 #endif
 }
 void DX11CommandContext::draw_indexed(uint32_t ic, uint32_t instc, uint32_t fi, uint32_t vo, uint32_t finst) {
-    if (instc > 1) context_->DrawIndexedInstanced(ic, instc, fi, vo, finst); else context_->DrawIndexed(ic, fi, vo);
+    auto lock = lock_context();
+    // A non-zero first instance offsets per-instance vertex streams, so it needs the instanced call too
+    if (instc > 1 || finst > 0) context_->DrawIndexedInstanced(ic, instc, fi, vo, finst); else context_->DrawIndexed(ic, fi, vo);
 #ifdef _DEBUG
     { auto b = backend_.lock(); if (b) b->check_debug_messages("draw_indexed"); }
 #endif
 }
+// D3D11 has no multi-draw indirect: one call per packed command
 void DX11CommandContext::draw_indirect(RHIBufferRef b, uint32_t o, uint32_t c) {
-    context_->DrawInstancedIndirect((ID3D11Buffer*)b->raw_handle(), (UINT)o);
+    auto lock = lock_context();
+    for (uint32_t i = 0; i < c; ++i) {
+        context_->DrawInstancedIndirect((ID3D11Buffer*)b->raw_handle(), (UINT)(o + i * sizeof(RHIIndirectCommand)));
+    }
 #ifdef _DEBUG
     { auto bk = backend_.lock(); if (bk) bk->check_debug_messages("draw_indirect"); }
 #endif
 }
 void DX11CommandContext::draw_indexed_indirect(RHIBufferRef b, uint32_t o, uint32_t c) {
-    context_->DrawIndexedInstancedIndirect((ID3D11Buffer*)b->raw_handle(), (UINT)o);
+    auto lock = lock_context();
+    for (uint32_t i = 0; i < c; ++i) {
+        context_->DrawIndexedInstancedIndirect((ID3D11Buffer*)b->raw_handle(), (UINT)(o + i * sizeof(RHIIndexedIndirectCommand)));
+    }
 #ifdef _DEBUG
     { auto bk = backend_.lock(); if (bk) bk->check_debug_messages("draw_indexed_indirect"); }
 #endif
 }
 void DX11CommandContext::imgui_create_fonts_texture() {
+    auto lock = lock_context();
     ImGui_ImplDX11_CreateDeviceObjects();
 }
 
 void DX11CommandContext::imgui_render_draw_data() {
+    auto lock = lock_context();
     ImGui_ImplDX11_RenderDrawData(ImGui::GetDrawData());
 }
 
 bool DX11CommandContext::read_texture(RHITextureRef texture, void* data, uint32_t size) {
+    auto lock = lock_context();
     if (!texture || !data || size == 0) return false;
     
     auto* dx11_texture = static_cast<DX11Texture*>(texture.get());
@@ -1775,15 +2070,42 @@ RHIDescriptorSetRef DX11RootSignature::create_descriptor_set(uint32_t set) { ret
 
 // DX11CommandContextImmediate implementation
 
-DX11CommandContextImmediate::DX11CommandContextImmediate(DX11Backend& backend) : backend_(backend) {
+DX11CommandContextImmediate::DX11CommandContextImmediate(DX11Backend& backend, bool deferred) : backend_(backend) {
+    if (deferred) {
+        HRESULT hr = backend_.get_device()->CreateDeferredContext(0, deferred_context_.GetAddressOf());
+        if (FAILED(hr)) {
+            WARN(LogRHI, "CreateDeferredContext failed (HRESULT: 0x{:08X}), upload context falls back to immediate context", (uint32_t)hr);
+            deferred_context_.Reset();
+        }
+    }
 }
 
 ID3D11DeviceContext* DX11CommandContextImmediate::get_context() {
+    if (deferred_context_) return deferred_context_.Get();
     return backend_.get_context().Get();
 }
 
+std::unique_lock<std::recursive_mutex> DX11CommandContextImmediate::lock_if_immediate() {
+    if (deferred_context_) return {};
+    return backend_.lock_context();
+}
+
 void DX11CommandContextImmediate::flush() {
+    if (deferred_context_) {
+        ComPtr<ID3D11CommandList> command_list;
+        HRESULT hr = deferred_context_->FinishCommandList(FALSE, command_list.GetAddressOf());
+        if (FAILED(hr)) {
+            ERR(LogRHI, "FinishCommandList failed (HRESULT: 0x{:08X})", (uint32_t)hr);
+            return;
+        }
+        auto lock = backend_.lock_context();
+        backend_.get_context()->ExecuteCommandList(command_list.Get(), TRUE);
+        backend_.get_context()->Flush();
+        return;
+    }
+
     // Flush immediate context to ensure all commands are submitted to GPU
+    auto lock = backend_.lock_context();
     backend_.get_context()->Flush();
 }
 
@@ -1834,7 +2156,9 @@ void DX11CommandContextImmediate::copy_texture_to_buffer(RHITextureRef s, Textur
     HRESULT hr = backend_.get_device()->CreateTexture2D(&staging_desc, nullptr, staging_texture.GetAddressOf());
     if (FAILED(hr)) return;
     
-    ID3D11DeviceContext* ctx = get_context();
+    // Readback needs Map(READ), which deferred contexts can't do; always use the immediate context
+    auto lock = backend_.lock_context();
+    ID3D11DeviceContext* ctx = backend_.get_context().Get();
     
     uint32_t src_subresource = D3D11CalcSubresource(ss.mip_level, ss.base_array_layer, tex_info.mip_levels);
     ctx->CopySubresourceRegion(staging_texture.Get(), 0, 0, 0, 0, src_texture, src_subresource, nullptr);
@@ -1871,20 +2195,21 @@ void DX11CommandContextImmediate::copy_buffer_to_texture(RHIBufferRef s, uint64_
     
     if (!dx11_buffer || !dx11_texture) return;
     
+    // Staging data is read through the immediate context; the copy itself is recorded on get_context()
+    auto lock = backend_.lock_context();
+    ID3D11DeviceContext* immediate = backend_.get_context().Get();
     ID3D11DeviceContext* ctx = get_context();
     
     // Map the source buffer to get CPU pointer
     D3D11_MAPPED_SUBRESOURCE mapped;
-    HRESULT hr = ctx->Map(dx11_buffer->get_handle().Get(), 0, D3D11_MAP_READ, 0, &mapped);
+    HRESULT hr = immediate->Map(dx11_buffer->get_handle().Get(), 0, D3D11_MAP_READ, 0, &mapped);
     if (FAILED(hr)) return;
     
     const auto& tex_info = dx11_texture->get_info();
-    uint32_t width = tex_info.extent.width;
-    uint32_t height = tex_info.extent.height;
-    uint32_t bpp = 4; // Assuming RGBA8 format
-    
-    uint32_t row_pitch = width * bpp;
-    uint32_t aligned_row_pitch = (row_pitch + 255) & ~255;
+    Extent3D extent = dx11_texture->mip_extent(ds.mip_level);
+    uint32_t width = extent.width;
+    uint32_t height = extent.height;
+    uint32_t aligned_row_pitch = texture_upload_row_pitch(tex_info.format, width);
     uint32_t dst_subresource = D3D11CalcSubresource(ds.mip_level, ds.base_array_layer, tex_info.mip_levels);
     
     D3D11_BOX box = {};
@@ -1906,10 +2231,11 @@ void DX11CommandContextImmediate::copy_buffer_to_texture(RHIBufferRef s, uint64_
         aligned_row_pitch * height
     );
     
-    ctx->Unmap(dx11_buffer->get_handle().Get(), 0);
+    immediate->Unmap(dx11_buffer->get_handle().Get(), 0);
 }
 
 void DX11CommandContextImmediate::copy_buffer(RHIBufferRef s, uint64_t soff, RHIBufferRef d, uint64_t doff, uint64_t sz) {
+    auto lock = lock_if_immediate();
     ID3D11DeviceContext* ctx = get_context();
     
     D3D11_BOX box = { (UINT)soff, 0, 0, (UINT)(soff + sz), 1, 1 };
@@ -1924,6 +2250,7 @@ void DX11CommandContextImmediate::copy_texture(RHITextureRef s, TextureSubresour
     auto* dst_tex = static_cast<DX11Texture*>(d.get());
     if (!src_tex || !dst_tex) return;
     
+    auto lock = lock_if_immediate();
     ID3D11DeviceContext* ctx = get_context();
     
     const auto& src_info = src_tex->get_info();
@@ -1942,6 +2269,7 @@ void DX11CommandContextImmediate::generate_mips(RHITextureRef s) {
     auto texture = std::static_pointer_cast<DX11Texture>(s);
     if (!texture) return;
     
+    auto lock = lock_if_immediate();
     ID3D11DeviceContext* ctx = get_context();
     
     auto srv = texture->get_srv();
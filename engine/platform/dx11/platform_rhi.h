@@ -10,6 +10,9 @@
 #include <wrl/client.h>
 #include <vector>
 #include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
 #include <string>
 
 using Microsoft::WRL::ComPtr;
@@ -21,10 +24,16 @@ class DX11Backend;
  */
 class DX11Queue : public RHIQueue {
 public:
-    DX11Queue(const RHIQueueInfo& info) : RHIQueue(info) {}
+    DX11Queue(const RHIQueueInfo& info, std::shared_ptr<DX11Backend> backend) : RHIQueue(info), backend_(backend) {}
 
     virtual void wait_idle() override final {}
     virtual void* raw_handle() override final { return nullptr; }
+
+    virtual void signal(RHITimelineSemaphoreRef semaphore, uint64_t value) override final;
+    virtual void wait(RHITimelineSemaphoreRef semaphore, uint64_t value) override final;
+
+private:
+    std::weak_ptr<DX11Backend> backend_;
 };
 
 /**
@@ -106,10 +115,38 @@ public:
 
     ComPtr<ID3D11Buffer> get_handle() const { return buffer_; }
 
+    /**
+     * @brief SRV over the whole buffer, only for structured buffers (RESOURCE_TYPE_BUFFER with a stride)
+     */
+    ComPtr<ID3D11ShaderResourceView> get_srv() const { return srv_; }
+
+    /**
+     * @brief Record a texture subresource copy into this staging buffer without waiting on the GPU.
+     *
+     * D3D11 cannot copy a texture into a buffer, so the subresource is copied into a staging texture
+     * kept with the buffer; the next map() packs its rows into the buffer at offset. Call with the
+     * immediate context locked.
+     */
+    bool record_texture_copy(ID3D11DeviceContext* context, ID3D11Texture2D* src, uint32_t src_subresource,
+                             const D3D11_TEXTURE2D_DESC& staging_desc, uint64_t offset, uint32_t row_pitch);
+
 private:
+    struct PendingTextureCopy {
+        ComPtr<ID3D11Texture2D> staging;
+        uint64_t offset = 0;
+        uint32_t row_pitch = 0;
+        uint32_t height = 0;
+    };
+
+    void resolve_texture_copies(ID3D11DeviceContext* context);
+
     ComPtr<ID3D11Buffer> buffer_;
+    ComPtr<ID3D11ShaderResourceView> srv_;
     std::weak_ptr<DX11Backend> backend_;
     void* mapped_data_ = nullptr;
+
+    std::vector<PendingTextureCopy> pending_texture_copies_;
+    ComPtr<ID3D11Texture2D> readback_texture_; // Reused by the next texture copy of the same size and format
 };
 
 /**
@@ -313,6 +350,7 @@ public:
     DX11Fence(bool signaled, std::shared_ptr<DX11Backend> backend);
     virtual bool init() override final;
     virtual void wait() override final;
+    virtual bool is_signaled() override final;
     virtual void destroy() override final;
     virtual void* raw_handle() override final { return query_.Get(); }
 
@@ -335,6 +373,48 @@ public:
     virtual void* raw_handle() override final { return nullptr; }
 };
 
+/**
+ * @brief DX11 implementation of RHITimelineSemaphore
+ *
+ * DX11 has no native fence object (ID3D11Fence needs 11.3+), so GPU signals are
+ * emulated with one event query per signalled value. Finished queries are retired
+ * in submission order whenever the completed value is polled.
+ *
+ * Polling uses D3D11_ASYNC_GETDATA_DONOTFLUSH, and DX11Queue::signal records its
+ * End(query) after the caller's last Flush, so the query may still sit in the
+ * driver's command buffer. wait() therefore flushes the immediate context once
+ * before spinning; otherwise `queue->signal(t, v); t->wait(v)` would never return.
+ */
+class DX11TimelineSemaphore : public RHITimelineSemaphore {
+public:
+    DX11TimelineSemaphore(uint64_t initial_value, std::shared_ptr<DX11Backend> backend);
+
+    virtual uint64_t get_completed_value() override final;
+    virtual void signal(uint64_t value) override final;
+    virtual bool wait(uint64_t value, uint64_t timeout_ms = UINT64_MAX) override final;
+    virtual void destroy() override final;
+
+    // Called by DX11Queue::signal with the backend context locked
+    void enqueue_gpu_signal(ComPtr<ID3D11Query> query, uint64_t value);
+    uint64_t get_submitted_value();
+
+private:
+    void retire_finished_signals();
+    void flush_pending_signals();
+
+    struct PendingSignal {
+        ComPtr<ID3D11Query> query;
+        uint64_t value;
+    };
+
+    std::weak_ptr<DX11Backend> backend_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::deque<PendingSignal> pending_signals_;
+    uint64_t completed_value_;
+    uint64_t submitted_value_;
+};
+
 /**
  * @brief DX11 implementation of RHICommandContext
  */
@@ -378,6 +458,7 @@ public:
     virtual void bind_index_buffer(RHIBufferRef buffer, uint32_t offset) override final;
     virtual void bind_texture(RHITextureRef texture, uint32_t slot, ShaderFrequency frequency) override final;
     virtual void bind_rw_texture(RHITextureRef texture, uint32_t slot, uint32_t mip_level, ShaderFrequency frequency) override final;
+    virtual void bind_buffer(RHIBufferRef buffer, uint32_t slot, ShaderFrequency frequency) override final;
     virtual void bind_sampler(RHISamplerRef sampler, uint32_t slot, ShaderFrequency frequency) override final;
 
     virtual void dispatch(uint32_t group_count_x, uint32_t group_count_y, uint32_t group_count_z) override final;
@@ -398,6 +479,8 @@ public:
     bool is_valid() const { return !backend_.expired() && context_; }
 
 private:
+    std::unique_lock<std::recursive_mutex> lock_context();
+
     std::weak_ptr<DX11Backend> backend_;
     ComPtr<ID3D11DeviceContext> context_;
 };
@@ -408,12 +491,19 @@ private:
  * Uses immediate context for synchronous resource upload operations.
  * All commands are executed immediately on the GPU, and flush() waits
  * for GPU completion.
+ *
+ * Upload contexts handed out to worker threads (deferred = true) record into
+ * an ID3D11DeviceContext deferred context instead; flush() finishes the
+ * command list and executes it on the immediate context under the backend's
+ * context lock.
  */
 class DX11CommandContextImmediate : public RHICommandContextImmediate {
 public:
-    DX11CommandContextImmediate(DX11Backend& backend);
+    DX11CommandContextImmediate(DX11Backend& backend, bool deferred = false);
     virtual ~DX11CommandContextImmediate() = default;
 
+    virtual void destroy() override final { deferred_context_.Reset(); }
+
     virtual void flush() override final;
 
     virtual void texture_barrier(const RHITextureBarrier& barrier) override final;
@@ -428,9 +518,11 @@ public:
 
 private:
     DX11Backend& backend_;
+    ComPtr<ID3D11DeviceContext> deferred_context_;
     
-    // Get the immediate context for all operations
+    // Get the recording context: the deferred context for upload contexts, otherwise the immediate one
     ID3D11DeviceContext* get_context();
+    std::unique_lock<std::recursive_mutex> lock_if_immediate();
 };
 
 /**
@@ -477,6 +569,7 @@ public:
 
     virtual RHIFenceRef create_fence(bool signaled) override final;
     virtual RHISemaphoreRef create_semaphore() override final;
+    virtual RHITimelineSemaphoreRef create_timeline_semaphore(uint64_t initial_value = 0) override final;
 
     virtual RHICommandContextImmediateRef get_immediate_command() override final;
 
@@ -484,9 +577,20 @@ public:
 
     virtual GPUProfilerRef create_gpu_profiler() override final;
 
+protected:
+    virtual RHICommandContextImmediateRef create_upload_command() override final;
+
+public:
     ComPtr<IDXGIFactory> get_factory() const { return factory_; }
     ComPtr<ID3D11Device> get_device() const { return device_; }
     ComPtr<ID3D11DeviceContext> get_context() const { return context_; }
+
+    /**
+     * @brief Lock the immediate context. ID3D11DeviceContext is not free-threaded,
+     *        so every thread other than the one recording the frame must hold this
+     *        while touching get_context() (Map/Unmap, ExecuteCommandList, ...).
+     */
+    std::unique_lock<std::recursive_mutex> lock_context() { return std::unique_lock<std::recursive_mutex>(context_mutex_); }
     
     // Check if backend is still valid (device not destroyed)
     bool is_valid() const { return device_ != nullptr; }
@@ -500,6 +604,7 @@ private:
     ComPtr<ID3D11DeviceContext> context_;
     ComPtr<ID3D11InfoQueue> info_queue_;
     RHICommandContextImmediateRef immediate_context_;
+    std::recursive_mutex context_mutex_;
 
     struct StagingTextureKey {
         uint32_t width, height;
@@ -543,6 +648,7 @@ DX11_RESOURCE_TRAIT(RHIComputePipeline, DX11ComputePipeline)
 DX11_RESOURCE_TRAIT(RHIRayTracingPipeline, DX11RayTracingPipeline)
 DX11_RESOURCE_TRAIT(RHIFence, DX11Fence)
 DX11_RESOURCE_TRAIT(RHISemaphore, DX11Semaphore)
+DX11_RESOURCE_TRAIT(RHITimelineSemaphore, DX11TimelineSemaphore)
 
 template<typename RHIType>
 static inline typename DX11ResourceTraits<RHIType>::type* resource_cast(RHIType* resource) {
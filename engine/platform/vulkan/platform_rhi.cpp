@@ -0,0 +1,804 @@
+#include "platform_rhi.h"
+#include "engine/core/log/Log.h"
+
+#include <shaderc/shaderc.h>
+#include <cstring>
+
+DEFINE_LOG_TAG(LogVulkanRHI, "VulkanRHI");
+
+class VulkanUtil {
+public:
+    struct BufferAccess {
+        VkPipelineStageFlags stage;
+        VkAccessFlags access;
+    };
+
+    static BufferAccess buffer_state_to_access(RHIResourceState state) {
+        switch (state) {
+            case RESOURCE_STATE_UNDEFINED: return { VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, 0 };
+            case RESOURCE_STATE_TRANSFER_SRC: return { VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_READ_BIT };
+            case RESOURCE_STATE_TRANSFER_DST: return { VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT };
+            case RESOURCE_STATE_VERTEX_BUFFER: return { VK_PIPELINE_STAGE_VERTEX_INPUT_BIT, VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT };
+            case RESOURCE_STATE_INDEX_BUFFER: return { VK_PIPELINE_STAGE_VERTEX_INPUT_BIT, VK_ACCESS_INDEX_READ_BIT };
+            case RESOURCE_STATE_INDIRECT_ARGUMENT: return { VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT, VK_ACCESS_INDIRECT_COMMAND_READ_BIT };
+            case RESOURCE_STATE_SHADER_RESOURCE: return { VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_ACCESS_SHADER_READ_BIT };
+            case RESOURCE_STATE_UNORDERED_ACCESS: return { VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT };
+            default: return { VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT };
+        }
+    }
+
+    static VkBufferUsageFlags resource_type_to_buffer_usage(ResourceType type) {
+        VkBufferUsageFlags usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+        if (type & RESOURCE_TYPE_UNIFORM_BUFFER) usage |= VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT;
+        if (type & (RESOURCE_TYPE_BUFFER | RESOURCE_TYPE_RW_BUFFER)) usage |= VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+        if (type & RESOURCE_TYPE_VERTEX_BUFFER) usage |= VK_BUFFER_USAGE_VERTEX_BUFFER_BIT;
+        if (type & RESOURCE_TYPE_INDEX_BUFFER) usage |= VK_BUFFER_USAGE_INDEX_BUFFER_BIT;
+        if (type & RESOURCE_TYPE_INDIRECT_BUFFER) usage |= VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT;
+        return usage;
+    }
+
+    static void record_buffer_barrier(VkCommandBuffer command_buffer, const RHIBufferBarrier& barrier) {
+        auto buffer = std::static_pointer_cast<VulkanBuffer>(barrier.buffer);
+        if (!buffer) return;
+
+        BufferAccess src = buffer_state_to_access(barrier.src_state);
+        BufferAccess dst = buffer_state_to_access(barrier.dst_state);
+
+        VkBufferMemoryBarrier vk_barrier = {};
+        vk_barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+        vk_barrier.srcAccessMask = src.access;
+        vk_barrier.dstAccessMask = dst.access;
+        vk_barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        vk_barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        vk_barrier.buffer = buffer->get_handle();
+        vk_barrier.offset = barrier.offset;
+        vk_barrier.size = barrier.size == 0 ? VK_WHOLE_SIZE : barrier.size;
+
+        vkCmdPipelineBarrier(command_buffer, src.stage, dst.stage, 0, 0, nullptr, 1, &vk_barrier, 0, nullptr);
+    }
+
+    static void record_copy_buffer(VkCommandBuffer command_buffer, RHIBufferRef src, uint64_t src_offset, RHIBufferRef dst, uint64_t dst_offset, uint64_t size) {
+        if (!src || !dst || size == 0) return;
+
+        VkBufferCopy region = {};
+        region.srcOffset = src_offset;
+        region.dstOffset = dst_offset;
+        region.size = size;
+        vkCmdCopyBuffer(command_buffer, std::static_pointer_cast<VulkanBuffer>(src)->get_handle(), std::static_pointer_cast<VulkanBuffer>(dst)->get_handle(), 1, &region);
+    }
+
+    // Make transfer writes visible to the host, so mapped readback buffers can be read once the submission completes
+    static void record_host_read_barrier(VkCommandBuffer command_buffer) {
+        VkMemoryBarrier host_barrier = {};
+        host_barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        host_barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        host_barrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+        vkCmdPipelineBarrier(command_buffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT, 0, 1, &host_barrier, 0, nullptr, 0, nullptr);
+    }
+
+    static bool shader_kind_from_profile(const char* profile, shaderc_shader_kind& kind) {
+        if (!profile || std::strlen(profile) < 2) return false;
+        if (std::strncmp(profile, "vs", 2) == 0) kind = shaderc_vertex_shader;
+        else if (std::strncmp(profile, "ps", 2) == 0) kind = shaderc_fragment_shader;
+        else if (std::strncmp(profile, "gs", 2) == 0) kind = shaderc_geometry_shader;
+        else if (std::strncmp(profile, "hs", 2) == 0) kind = shaderc_tess_control_shader;
+        else if (std::strncmp(profile, "ds", 2) == 0) kind = shaderc_tess_evaluation_shader;
+        else if (std::strncmp(profile, "cs", 2) == 0) kind = shaderc_compute_shader;
+        else return false;
+        return true;
+    }
+};
+
+// --- VulkanQueue ---
+void VulkanQueue::wait_idle() {
+    auto backend = backend_.lock();
+    if (!backend || !backend->is_valid()) return;
+    auto lock = backend->lock_queue();
+    vkQueueWaitIdle(backend->get_queue_handle());
+}
+
+void* VulkanQueue::raw_handle() {
+    auto backend = backend_.lock();
+    return backend ? (void*)backend->get_queue_handle() : nullptr;
+}
+
+void VulkanQueue::signal(RHITimelineSemaphoreRef semaphore, uint64_t value) {
+    if (!semaphore) return;
+    auto backend = backend_.lock();
+    if (!backend || !backend->is_valid()) {
+        semaphore->signal(value);
+        return;
+    }
+
+    // An empty batch: its signal operation waits for everything submitted to the queue before it
+    VkSemaphore handle = std::static_pointer_cast<VulkanTimelineSemaphore>(semaphore)->get_handle();
+
+    VkTimelineSemaphoreSubmitInfo timeline_info = {};
+    timeline_info.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+    timeline_info.signalSemaphoreValueCount = 1;
+    timeline_info.pSignalSemaphoreValues = &value;
+
+    VkSubmitInfo submit_info = {};
+    submit_info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submit_info.pNext = &timeline_info;
+    submit_info.signalSemaphoreCount = 1;
+    submit_info.pSignalSemaphores = &handle;
+
+    if (backend->submit(submit_info, VK_NULL_HANDLE) != VK_SUCCESS) {
+        ERR(LogVulkanRHI, "VulkanQueue::signal: vkQueueSubmit failed, signalling on CPU");
+        semaphore->signal(value);
+    }
+}
+
+void VulkanQueue::wait(RHITimelineSemaphoreRef semaphore, uint64_t value) {
+    if (!semaphore) return;
+    auto backend = backend_.lock();
+    if (!backend || !backend->is_valid()) {
+        semaphore->wait(value);
+        return;
+    }
+
+    VkSemaphore handle = std::static_pointer_cast<VulkanTimelineSemaphore>(semaphore)->get_handle();
+    VkPipelineStageFlags wait_stage = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+
+    VkTimelineSemaphoreSubmitInfo timeline_info = {};
+    timeline_info.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+    timeline_info.waitSemaphoreValueCount = 1;
+    timeline_info.pWaitSemaphoreValues = &value;
+
+    VkSubmitInfo submit_info = {};
+    submit_info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submit_info.pNext = &timeline_info;
+    submit_info.waitSemaphoreCount = 1;
+    submit_info.pWaitSemaphores = &handle;
+    submit_info.pWaitDstStageMask = &wait_stage;
+
+    if (backend->submit(submit_info, VK_NULL_HANDLE) != VK_SUCCESS) {
+        ERR(LogVulkanRHI, "VulkanQueue::wait: vkQueueSubmit failed, waiting on CPU");
+        semaphore->wait(value);
+    }
+}
+
+// --- VulkanCommandPool ---
+VulkanCommandPool::VulkanCommandPool(const RHICommandPoolInfo& info, std::shared_ptr<VulkanBackend> backend)
+    : RHICommandPool(info), backend_(backend) {
+}
+
+bool VulkanCommandPool::init() {
+    auto backend = backend_.lock();
+    if (!backend || !backend->is_valid()) return false;
+
+    VkCommandPoolCreateInfo create_info = {};
+    create_info.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+    create_info.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+    create_info.queueFamilyIndex = backend->get_queue_family();
+    if (vkCreateCommandPool(backend->get_device(), &create_info, nullptr, &pool_) != VK_SUCCESS) {
+        ERR(LogVulkanRHI, "vkCreateCommandPool failed");
+        return false;
+    }
+    return true;
+}
+
+void VulkanCommandPool::destroy() {
+    auto backend = backend_.lock();
+    if (pool_ != VK_NULL_HANDLE && backend && backend->is_valid()) {
+        vkDestroyCommandPool(backend->get_device(), pool_, nullptr);
+    }
+    pool_ = VK_NULL_HANDLE;
+}
+
+// --- VulkanBuffer ---
+VulkanBuffer::VulkanBuffer(const RHIBufferInfo& info, std::shared_ptr<VulkanBackend> backend)
+    : RHIBuffer(info), backend_(backend) {
+}
+
+bool VulkanBuffer::init() {
+    auto backend = backend_.lock();
+    if (!backend || !backend->is_valid()) {
+        ERR(LogVulkanRHI, "Failed to init VulkanBuffer: backend is destroyed or invalid");
+        return false;
+    }
+    VkDevice device = backend->get_device();
+
+    VkBufferCreateInfo create_info = {};
+    create_info.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    create_info.size = info_.size;
+    create_info.usage = VulkanUtil::resource_type_to_buffer_usage(info_.type);
+    create_info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    if (vkCreateBuffer(device, &create_info, nullptr, &buffer_) != VK_SUCCESS) {
+        ERR(LogVulkanRHI, "vkCreateBuffer failed (size {})", info_.size);
+        return false;
+    }
+
+    VkMemoryRequirements requirements;
+    vkGetBufferMemoryRequirements(device, buffer_, &requirements);
+
+    bool host_visible = info_.memory_usage != MEMORY_USAGE_GPU_ONLY;
+    uint32_t memory_type = UINT32_MAX;
+    if (host_visible) {
+        // Readbacks prefer cached memory so the CPU does not read through write-combined pages
+        if (info_.memory_usage == MEMORY_USAGE_GPU_TO_CPU) {
+            memory_type = backend->find_memory_type(requirements.memoryTypeBits,
+                VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT | VK_MEMORY_PROPERTY_HOST_CACHED_BIT);
+        }
+        if (memory_type == UINT32_MAX) {
+            memory_type = backend->find_memory_type(requirements.memoryTypeBits, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+        }
+    } else {
+        memory_type = backend->find_memory_type(requirements.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+        if (memory_type == UINT32_MAX) memory_type = backend->find_memory_type(requirements.memoryTypeBits, 0);
+    }
+    if (memory_type == UINT32_MAX) {
+        ERR(LogVulkanRHI, "VulkanBuffer: no compatible memory type (memory usage {})", (uint32_t)info_.memory_usage);
+        destroy();
+        return false;
+    }
+
+    VkMemoryAllocateInfo allocate_info = {};
+    allocate_info.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    allocate_info.allocationSize = requirements.size;
+    allocate_info.memoryTypeIndex = memory_type;
+    if (vkAllocateMemory(device, &allocate_info, nullptr, &memory_) != VK_SUCCESS) {
+        ERR(LogVulkanRHI, "vkAllocateMemory failed (size {})", requirements.size);
+        destroy();
+        return false;
+    }
+    vkBindBufferMemory(device, buffer_, memory_, 0);
+
+    if (host_visible && vkMapMemory(device, memory_, 0, VK_WHOLE_SIZE, 0, &mapped_data_) != VK_SUCCESS) {
+        ERR(LogVulkanRHI, "vkMapMemory failed");
+        destroy();
+        return false;
+    }
+    return true;
+}
+
+void* VulkanBuffer::map() { return mapped_data_; }
+
+void VulkanBuffer::destroy() {
+    auto backend = backend_.lock();
+    if (backend && backend->is_valid()) {
+        VkDevice device = backend->get_device();
+        if (mapped_data_) vkUnmapMemory(device, memory_);
+        if (buffer_ != VK_NULL_HANDLE) vkDestroyBuffer(device, buffer_, nullptr);
+        if (memory_ != VK_NULL_HANDLE) vkFreeMemory(device, memory_, nullptr);
+    }
+    mapped_data_ = nullptr;
+    buffer_ = VK_NULL_HANDLE;
+    memory_ = VK_NULL_HANDLE;
+}
+
+// --- VulkanFence ---
+bool VulkanFence::init() {
+    auto backend = backend_.lock();
+    if (!backend || !backend->is_valid()) return false;
+
+    VkFenceCreateInfo create_info = {};
+    create_info.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+    create_info.flags = signaled_ ? VK_FENCE_CREATE_SIGNALED_BIT : 0;
+    if (vkCreateFence(backend->get_device(), &create_info, nullptr, &fence_) != VK_SUCCESS) {
+        ERR(LogVulkanRHI, "vkCreateFence failed");
+        return false;
+    }
+    return true;
+}
+
+void VulkanFence::wait() {
+    auto backend = backend_.lock();
+    if (!backend || !backend->is_valid() || fence_ == VK_NULL_HANDLE) return;
+    // Same contract as the DX11 fence: wait for the work, then re-arm for the next execute()
+    vkWaitForFences(backend->get_device(), 1, &fence_, VK_TRUE, UINT64_MAX);
+    vkResetFences(backend->get_device(), 1, &fence_);
+}
+
+bool VulkanFence::is_signaled() {
+    auto backend = backend_.lock();
+    if (!backend || !backend->is_valid() || fence_ == VK_NULL_HANDLE) return true;
+    return vkGetFenceStatus(backend->get_device(), fence_) == VK_SUCCESS;
+}
+
+void VulkanFence::destroy() {
+    auto backend = backend_.lock();
+    if (fence_ != VK_NULL_HANDLE && backend && backend->is_valid()) {
+        vkDestroyFence(backend->get_device(), fence_, nullptr);
+    }
+    fence_ = VK_NULL_HANDLE;
+}
+
+// --- VulkanSemaphore ---
+bool VulkanSemaphore::init() {
+    auto backend = backend_.lock();
+    if (!backend || !backend->is_valid()) return false;
+
+    VkSemaphoreCreateInfo create_info = {};
+    create_info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+    if (vkCreateSemaphore(backend->get_device(), &create_info, nullptr, &semaphore_) != VK_SUCCESS) {
+        ERR(LogVulkanRHI, "vkCreateSemaphore failed");
+        return false;
+    }
+    return true;
+}
+
+void VulkanSemaphore::destroy() {
+    auto backend = backend_.lock();
+    if (semaphore_ != VK_NULL_HANDLE && backend && backend->is_valid()) {
+        vkDestroySemaphore(backend->get_device(), semaphore_, nullptr);
+    }
+    semaphore_ = VK_NULL_HANDLE;
+}
+
+// --- VulkanTimelineSemaphore ---
+bool VulkanTimelineSemaphore::init() {
+    auto backend = backend_.lock();
+    if (!backend || !backend->is_valid()) return false;
+
+    VkSemaphoreTypeCreateInfo type_info = {};
+    type_info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO;
+    type_info.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+    type_info.initialValue = initial_value_;
+
+    VkSemaphoreCreateInfo create_info = {};
+    create_info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+    create_info.pNext = &type_info;
+    if (vkCreateSemaphore(backend->get_device(), &create_info, nullptr, &semaphore_) != VK_SUCCESS) {
+        ERR(LogVulkanRHI, "vkCreateSemaphore (timeline) failed");
+        return false;
+    }
+    return true;
+}
+
+uint64_t VulkanTimelineSemaphore::get_completed_value() {
+    auto backend = backend_.lock();
+    if (!backend || !backend->is_valid() || semaphore_ == VK_NULL_HANDLE) return initial_value_;
+
+    uint64_t value = 0;
+    vkGetSemaphoreCounterValue(backend->get_device(), semaphore_, &value);
+    return value;
+}
+
+void VulkanTimelineSemaphore::signal(uint64_t value) {
+    auto backend = backend_.lock();
+    if (!backend || !backend->is_valid() || semaphore_ == VK_NULL_HANDLE) return;
+
+    // vkSignalSemaphore requires a strictly larger value; lower ones are ignored like on the other backends
+    if (value <= get_completed_value()) return;
+
+    VkSemaphoreSignalInfo signal_info = {};
+    signal_info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_SIGNAL_INFO;
+    signal_info.semaphore = semaphore_;
+    signal_info.value = value;
+    vkSignalSemaphore(backend->get_device(), &signal_info);
+}
+
+bool VulkanTimelineSemaphore::wait(uint64_t value, uint64_t timeout_ms) {
+    auto backend = backend_.lock();
+    if (!backend || !backend->is_valid() || semaphore_ == VK_NULL_HANDLE) return false;
+
+    VkSemaphoreWaitInfo wait_info = {};
+    wait_info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+    wait_info.semaphoreCount = 1;
+    wait_info.pSemaphores = &semaphore_;
+    wait_info.pValues = &value;
+
+    uint64_t timeout_ns = (timeout_ms >= UINT64_MAX / 1000000) ? UINT64_MAX : timeout_ms * 1000000;
+    return vkWaitSemaphores(backend->get_device(), &wait_info, timeout_ns) == VK_SUCCESS;
+}
+
+void VulkanTimelineSemaphore::destroy() {
+    auto backend = backend_.lock();
+    if (semaphore_ != VK_NULL_HANDLE && backend && backend->is_valid()) {
+        vkDestroySemaphore(backend->get_device(), semaphore_, nullptr);
+    }
+    semaphore_ = VK_NULL_HANDLE;
+}
+
+// --- VulkanCommandContext ---
+VulkanCommandContext::VulkanCommandContext(RHICommandPoolRef pool, std::shared_ptr<VulkanBackend> backend)
+    : RHICommandContext(pool), pool_(std::static_pointer_cast<VulkanCommandPool>(pool)), backend_(backend) {
+    if (!pool_ || pool_->get_handle() == VK_NULL_HANDLE || !backend->is_valid()) return;
+
+    VkCommandBufferAllocateInfo allocate_info = {};
+    allocate_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+    allocate_info.commandPool = pool_->get_handle();
+    allocate_info.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+    allocate_info.commandBufferCount = 1;
+    if (vkAllocateCommandBuffers(backend->get_device(), &allocate_info, &command_buffer_) != VK_SUCCESS) {
+        ERR(LogVulkanRHI, "vkAllocateCommandBuffers failed");
+        command_buffer_ = VK_NULL_HANDLE;
+    }
+}
+
+void VulkanCommandContext::destroy() {
+    auto backend = backend_.lock();
+    if (command_buffer_ != VK_NULL_HANDLE && pool_ && pool_->get_handle() != VK_NULL_HANDLE && backend && backend->is_valid()) {
+        vkFreeCommandBuffers(backend->get_device(), pool_->get_handle(), 1, &command_buffer_);
+    }
+    command_buffer_ = VK_NULL_HANDLE;
+}
+
+void VulkanCommandContext::begin_command() {
+    if (command_buffer_ == VK_NULL_HANDLE) return;
+
+    VkCommandBufferBeginInfo begin_info = {};
+    begin_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    begin_info.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    vkBeginCommandBuffer(command_buffer_, &begin_info);
+}
+
+void VulkanCommandContext::end_command() {
+    if (command_buffer_ == VK_NULL_HANDLE) return;
+    VulkanUtil::record_host_read_barrier(command_buffer_);
+    vkEndCommandBuffer(command_buffer_);
+}
+
+void VulkanCommandContext::execute(RHIFenceRef fence, RHISemaphoreRef wait_semaphore, RHISemaphoreRef signal_semaphore) {
+    auto backend = backend_.lock();
+    if (command_buffer_ == VK_NULL_HANDLE || !backend || !backend->is_valid()) return;
+
+    VkPipelineStageFlags wait_stage = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+    VkSemaphore wait_handle = wait_semaphore ? std::static_pointer_cast<VulkanSemaphore>(wait_semaphore)->get_handle() : VK_NULL_HANDLE;
+    VkSemaphore signal_handle = signal_semaphore ? std::static_pointer_cast<VulkanSemaphore>(signal_semaphore)->get_handle() : VK_NULL_HANDLE;
+
+    VkSubmitInfo submit_info = {};
+    submit_info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submit_info.commandBufferCount = 1;
+    submit_info.pCommandBuffers = &command_buffer_;
+    if (wait_handle != VK_NULL_HANDLE) {
+        submit_info.waitSemaphoreCount = 1;
+        submit_info.pWaitSemaphores = &wait_handle;
+        submit_info.pWaitDstStageMask = &wait_stage;
+    }
+    if (signal_handle != VK_NULL_HANDLE) {
+        submit_info.signalSemaphoreCount = 1;
+        submit_info.pSignalSemaphores = &signal_handle;
+    }
+
+    VkFence fence_handle = fence ? std::static_pointer_cast<VulkanFence>(fence)->get_handle() : VK_NULL_HANDLE;
+    if (backend->submit(submit_info, fence_handle) != VK_SUCCESS) {
+        ERR(LogVulkanRHI, "VulkanCommandContext::execute: vkQueueSubmit failed");
+    }
+}
+
+void VulkanCommandContext::buffer_barrier(const RHIBufferBarrier& barrier) {
+    if (command_buffer_ == VK_NULL_HANDLE) return;
+    VulkanUtil::record_buffer_barrier(command_buffer_, barrier);
+}
+
+void VulkanCommandContext::copy_buffer(RHIBufferRef src, uint64_t src_offset, RHIBufferRef dst, uint64_t dst_offset, uint64_t size) {
+    if (command_buffer_ == VK_NULL_HANDLE) return;
+    VulkanUtil::record_copy_buffer(command_buffer_, src, src_offset, dst, dst_offset, size);
+}
+
+// --- VulkanCommandContextImmediate ---
+VulkanCommandContextImmediate::VulkanCommandContextImmediate(VulkanBackend& backend) : backend_(backend) {
+    VkDevice device = backend_.get_device();
+
+    VkCommandPoolCreateInfo pool_info = {};
+    pool_info.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+    pool_info.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+    pool_info.queueFamilyIndex = backend_.get_queue_family();
+    if (vkCreateCommandPool(device, &pool_info, nullptr, &pool_) != VK_SUCCESS) {
+        ERR(LogVulkanRHI, "VulkanCommandContextImmediate: vkCreateCommandPool failed");
+        return;
+    }
+
+    VkCommandBufferAllocateInfo allocate_info = {};
+    allocate_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+    allocate_info.commandPool = pool_;
+    allocate_info.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+    allocate_info.commandBufferCount = 1;
+    if (vkAllocateCommandBuffers(device, &allocate_info, &command_buffer_) != VK_SUCCESS) {
+        ERR(LogVulkanRHI, "VulkanCommandContextImmediate: vkAllocateCommandBuffers failed");
+        command_buffer_ = VK_NULL_HANDLE;
+        return;
+    }
+
+    VkFenceCreateInfo fence_info = {};
+    fence_info.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+    if (vkCreateFence(device, &fence_info, nullptr, &fence_) != VK_SUCCESS) {
+        ERR(LogVulkanRHI, "VulkanCommandContextImmediate: vkCreateFence failed");
+        fence_ = VK_NULL_HANDLE;
+    }
+}
+
+void VulkanCommandContextImmediate::destroy() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!backend_.is_valid()) return;
+    VkDevice device = backend_.get_device();
+    if (fence_ != VK_NULL_HANDLE) vkDestroyFence(device, fence_, nullptr);
+    if (pool_ != VK_NULL_HANDLE) vkDestroyCommandPool(device, pool_, nullptr); // Frees command_buffer_ too
+    fence_ = VK_NULL_HANDLE;
+    pool_ = VK_NULL_HANDLE;
+    command_buffer_ = VK_NULL_HANDLE;
+    recording_ = false;
+}
+
+VkCommandBuffer VulkanCommandContextImmediate::get_recording_buffer() {
+    if (command_buffer_ == VK_NULL_HANDLE) return VK_NULL_HANDLE;
+    if (!recording_) {
+        VkCommandBufferBeginInfo begin_info = {};
+        begin_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        begin_info.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+        if (vkBeginCommandBuffer(command_buffer_, &begin_info) != VK_SUCCESS) return VK_NULL_HANDLE;
+        recording_ = true;
+    }
+    return command_buffer_;
+}
+
+void VulkanCommandContextImmediate::flush() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!recording_ || fence_ == VK_NULL_HANDLE) return;
+    recording_ = false;
+
+    VulkanUtil::record_host_read_barrier(command_buffer_);
+    if (vkEndCommandBuffer(command_buffer_) != VK_SUCCESS) {
+        ERR(LogVulkanRHI, "VulkanCommandContextImmediate::flush: vkEndCommandBuffer failed");
+        vkResetCommandBuffer(command_buffer_, 0);
+        return;
+    }
+
+    VkSubmitInfo submit_info = {};
+    submit_info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submit_info.commandBufferCount = 1;
+    submit_info.pCommandBuffers = &command_buffer_;
+    if (backend_.submit(submit_info, fence_) != VK_SUCCESS) {
+        ERR(LogVulkanRHI, "VulkanCommandContextImmediate::flush: vkQueueSubmit failed");
+        vkResetCommandBuffer(command_buffer_, 0);
+        return;
+    }
+
+    VkDevice device = backend_.get_device();
+    vkWaitForFences(device, 1, &fence_, VK_TRUE, UINT64_MAX);
+    vkResetFences(device, 1, &fence_);
+    vkResetCommandBuffer(command_buffer_, 0);
+}
+
+void VulkanCommandContextImmediate::buffer_barrier(const RHIBufferBarrier& barrier) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    VkCommandBuffer command_buffer = get_recording_buffer();
+    if (command_buffer == VK_NULL_HANDLE) return;
+    VulkanUtil::record_buffer_barrier(command_buffer, barrier);
+}
+
+void VulkanCommandContextImmediate::copy_buffer(RHIBufferRef src, uint64_t src_offset, RHIBufferRef dst, uint64_t dst_offset, uint64_t size) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    VkCommandBuffer command_buffer = get_recording_buffer();
+    if (command_buffer == VK_NULL_HANDLE) return;
+    VulkanUtil::record_copy_buffer(command_buffer, src, src_offset, dst, dst_offset, size);
+}
+
+// --- VulkanBackend ---
+VulkanBackend::VulkanBackend(const RHIBackendInfo& info) : RHIBackend(info) {
+    if (!init_device()) {
+        ERR(LogVulkanRHI, "Vulkan initialization failed, backend is invalid");
+        destroy();
+        return;
+    }
+    immediate_context_ = std::make_shared<VulkanCommandContextImmediate>(*this);
+}
+
+bool VulkanBackend::init_device() {
+    VkApplicationInfo app_info = {};
+    app_info.sType = VK_STRUCTURE_TYPE_APPLICATION_INFO;
+    app_info.pApplicationName = "Renderer";
+    app_info.pEngineName = "Renderer";
+    app_info.apiVersion = VK_API_VERSION_1_2;
+
+    const char* validation_layer = "VK_LAYER_KHRONOS_validation";
+    VkInstanceCreateInfo instance_info = {};
+    instance_info.sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
+    instance_info.pApplicationInfo = &app_info;
+    if (backend_info_.enable_debug) {
+        instance_info.enabledLayerCount = 1;
+        instance_info.ppEnabledLayerNames = &validation_layer;
+    }
+
+    VkResult result = vkCreateInstance(&instance_info, nullptr, &instance_);
+    if (result == VK_ERROR_LAYER_NOT_PRESENT) {
+        WARN(LogVulkanRHI, "Vulkan validation layer requested but not available");
+        instance_info.enabledLayerCount = 0;
+        result = vkCreateInstance(&instance_info, nullptr, &instance_);
+    }
+    if (result != VK_SUCCESS) {
+        ERR(LogVulkanRHI, "vkCreateInstance failed (VkResult {})", (int32_t)result);
+        instance_ = VK_NULL_HANDLE;
+        return false;
+    }
+
+    uint32_t device_count = 0;
+    vkEnumeratePhysicalDevices(instance_, &device_count, nullptr);
+    std::vector<VkPhysicalDevice> devices(device_count);
+    vkEnumeratePhysicalDevices(instance_, &device_count, devices.data());
+
+    // Take the first Vulkan 1.2 device with timeline semaphores and a graphics + compute queue,
+    // preferring real GPUs over software implementations
+    int32_t best_score = -1;
+    for (VkPhysicalDevice device : devices) {
+        VkPhysicalDeviceProperties properties;
+        vkGetPhysicalDeviceProperties(device, &properties);
+        if (properties.apiVersion < VK_API_VERSION_1_2) continue;
+
+        VkPhysicalDeviceTimelineSemaphoreFeatures timeline_features = {};
+        timeline_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES;
+        VkPhysicalDeviceFeatures2 features = {};
+        features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+        features.pNext = &timeline_features;
+        vkGetPhysicalDeviceFeatures2(device, &features);
+        if (!timeline_features.timelineSemaphore) continue;
+
+        uint32_t family_count = 0;
+        vkGetPhysicalDeviceQueueFamilyProperties(device, &family_count, nullptr);
+        std::vector<VkQueueFamilyProperties> families(family_count);
+        vkGetPhysicalDeviceQueueFamilyProperties(device, &family_count, families.data());
+
+        uint32_t family = UINT32_MAX;
+        for (uint32_t i = 0; i < family_count; ++i) {
+            VkQueueFlags required = VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT;
+            if ((families[i].queueFlags & required) == required) {
+                family = i;
+                break;
+            }
+        }
+        if (family == UINT32_MAX) continue;
+
+        int32_t score = properties.deviceType == VK_PHYSICAL_DEVICE_TYPE_CPU ? 0 : 1;
+        if (score > best_score) {
+            best_score = score;
+            physical_device_ = device;
+            queue_family_ = family;
+        }
+    }
+    if (physical_device_ == VK_NULL_HANDLE) {
+        ERR(LogVulkanRHI, "No Vulkan 1.2 device with timeline semaphores found");
+        return false;
+    }
+
+    VkPhysicalDeviceProperties properties;
+    vkGetPhysicalDeviceProperties(physical_device_, &properties);
+    INFO(LogVulkanRHI, "Vulkan device: {}", properties.deviceName);
+    vkGetPhysicalDeviceMemoryProperties(physical_device_, &memory_properties_);
+
+    float priority = 1.0f;
+    VkDeviceQueueCreateInfo queue_info = {};
+    queue_info.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
+    queue_info.queueFamilyIndex = queue_family_;
+    queue_info.queueCount = 1;
+    queue_info.pQueuePriorities = &priority;
+
+    VkPhysicalDeviceTimelineSemaphoreFeatures timeline_features = {};
+    timeline_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES;
+    timeline_features.timelineSemaphore = VK_TRUE;
+
+    VkDeviceCreateInfo device_info = {};
+    device_info.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
+    device_info.pNext = &timeline_features;
+    device_info.queueCreateInfoCount = 1;
+    device_info.pQueueCreateInfos = &queue_info;
+    if (vkCreateDevice(physical_device_, &device_info, nullptr, &device_) != VK_SUCCESS) {
+        ERR(LogVulkanRHI, "vkCreateDevice failed");
+        device_ = VK_NULL_HANDLE;
+        return false;
+    }
+    vkGetDeviceQueue(device_, queue_family_, 0, &queue_);
+    return true;
+}
+
+void VulkanBackend::tick() { RHIBackend::tick(); }
+
+void VulkanBackend::destroy() {
+    if (device_ != VK_NULL_HANDLE) {
+        vkDeviceWaitIdle(device_);
+
+        if (immediate_context_) immediate_context_->destroy();
+        immediate_context_.reset();
+
+        // Resources, upload contexts, batcher and readback pool still need the device
+        RHIBackend::destroy();
+
+        vkDestroyDevice(device_, nullptr);
+        device_ = VK_NULL_HANDLE;
+    }
+    if (instance_ != VK_NULL_HANDLE) {
+        vkDestroyInstance(instance_, nullptr);
+        instance_ = VK_NULL_HANDLE;
+    }
+}
+
+void VulkanBackend::set_name(RHIResourceRef resource, const std::string& name) {
+    if (!resource) return;
+    resource->set_name(name);
+}
+
+uint32_t VulkanBackend::find_memory_type(uint32_t type_bits, VkMemoryPropertyFlags properties) const {
+    for (uint32_t i = 0; i < memory_properties_.memoryTypeCount; ++i) {
+        if ((type_bits & (1u << i)) && (memory_properties_.memoryTypes[i].propertyFlags & properties) == properties) return i;
+    }
+    return UINT32_MAX;
+}
+
+VkResult VulkanBackend::submit(const VkSubmitInfo& submit_info, VkFence fence) {
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    return vkQueueSubmit(queue_, 1, &submit_info, fence);
+}
+
+RHIQueueRef VulkanBackend::get_queue(const RHIQueueInfo& info) { return std::make_shared<VulkanQueue>(info, shared_from_this()); }
+
+RHICommandPoolRef VulkanBackend::create_command_pool(const RHICommandPoolInfo& info) {
+    auto pool = std::make_shared<VulkanCommandPool>(info, shared_from_this());
+    if (!pool->init()) {
+        return nullptr;
+    }
+    register_resource(pool); return pool;
+}
+
+RHICommandContextRef VulkanBackend::create_command_context(RHICommandPoolRef pool) {
+    auto context = std::make_shared<VulkanCommandContext>(pool, shared_from_this());
+    register_resource(context); return context;
+}
+
+RHIBufferRef VulkanBackend::create_buffer(const RHIBufferInfo& info) {
+    auto buffer = std::make_shared<VulkanBuffer>(info, shared_from_this());
+    if (!buffer->init()) {
+        return nullptr;
+    }
+    register_resource(buffer); return buffer;
+}
+
+RHIFenceRef VulkanBackend::create_fence(bool signaled) {
+    auto fence = std::make_shared<VulkanFence>(signaled, shared_from_this());
+    if (!fence->init()) {
+        return nullptr;
+    }
+    register_resource(fence); return fence;
+}
+
+RHISemaphoreRef VulkanBackend::create_semaphore() {
+    auto semaphore = std::make_shared<VulkanSemaphore>(shared_from_this());
+    if (!semaphore->init()) {
+        return nullptr;
+    }
+    register_resource(semaphore); return semaphore;
+}
+
+RHITimelineSemaphoreRef VulkanBackend::create_timeline_semaphore(uint64_t initial_value) {
+    auto semaphore = std::make_shared<VulkanTimelineSemaphore>(initial_value, shared_from_this());
+    if (!semaphore->init()) {
+        return nullptr;
+    }
+    register_resource(semaphore); return semaphore;
+}
+
+RHICommandContextImmediateRef VulkanBackend::create_upload_command() {
+    if (!is_valid()) return nullptr;
+    return std::make_shared<VulkanCommandContextImmediate>(*this);
+}
+
+std::vector<uint8_t> VulkanBackend::compile_shader(const char* source, const char* entry, const char* profile) {
+    shaderc_shader_kind kind;
+    if (!source || !VulkanUtil::shader_kind_from_profile(profile, kind)) {
+        ERR(LogVulkanRHI, "compile_shader: unsupported profile {}", profile ? profile : "(null)");
+        return {};
+    }
+
+    shaderc_compiler_t compiler = shaderc_compiler_initialize();
+    shaderc_compile_options_t options = shaderc_compile_options_initialize();
+    shaderc_compile_options_set_source_language(options, shaderc_source_language_glsl);
+    shaderc_compile_options_set_target_env(options, shaderc_target_env_vulkan, shaderc_env_version_vulkan_1_2);
+    shaderc_compile_options_set_optimization_level(options, shaderc_optimization_level_performance);
+
+    shaderc_compilation_result_t result = shaderc_compile_into_spv(
+        compiler, source, std::strlen(source), kind, "shader", entry ? entry : "main", options);
+
+    std::vector<uint8_t> spirv;
+    if (shaderc_result_get_compilation_status(result) == shaderc_compilation_status_success) {
+        const uint8_t* bytes = reinterpret_cast<const uint8_t*>(shaderc_result_get_bytes(result));
+        spirv.assign(bytes, bytes + shaderc_result_get_length(result));
+    } else {
+        ERR(LogVulkanRHI, "Shader compilation failed ({}): {}", profile, shaderc_result_get_error_message(result));
+    }
+
+    shaderc_result_release(result);
+    shaderc_compile_options_release(options);
+    shaderc_compiler_release(compiler);
+    return spirv;
+}
@@ -0,0 +1,348 @@
+#pragma once
+
+#include "engine/function/render/rhi/rhi.h"
+#include "engine/function/render/rhi/rhi_resource.h"
+#include "engine/function/render/rhi/rhi_structs.h"
+
+#include <vulkan/vulkan.h>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * Minimal Vulkan backend.
+ *
+ * Covers what the headless systems need: buffers with host-visible or device-local
+ * memory, buffer copies and barriers, fences, timeline semaphores, queue signal/wait
+ * and GLSL -> SPIR-V compilation. It targets Vulkan 1.2 and runs on software
+ * implementations (lavapipe, SwiftShader), so it can be exercised without a GPU.
+ *
+ * Textures, pipelines, swapchains and ImGui are not implemented yet: their creators
+ * return nullptr and the matching command context calls are no-ops.
+ */
+
+class VulkanBackend;
+
+/**
+ * @brief Vulkan implementation of RHIQueue. Every queue type maps to the single universal queue of the backend.
+ */
+class VulkanQueue : public RHIQueue {
+public:
+    VulkanQueue(const RHIQueueInfo& info, std::shared_ptr<VulkanBackend> backend) : RHIQueue(info), backend_(backend) {}
+
+    virtual void wait_idle() override final;
+    virtual void* raw_handle() override final;
+
+    virtual void signal(RHITimelineSemaphoreRef semaphore, uint64_t value) override final;
+    virtual void wait(RHITimelineSemaphoreRef semaphore, uint64_t value) override final;
+
+private:
+    std::weak_ptr<VulkanBackend> backend_;
+};
+
+/**
+ * @brief Vulkan implementation of RHICommandPool
+ */
+class VulkanCommandPool : public RHICommandPool {
+public:
+    VulkanCommandPool(const RHICommandPoolInfo& info, std::shared_ptr<VulkanBackend> backend);
+
+    virtual bool init();
+    virtual void destroy() override final;
+    virtual void* raw_handle() override final { return pool_; }
+
+    VkCommandPool get_handle() const { return pool_; }
+
+private:
+    VkCommandPool pool_ = VK_NULL_HANDLE;
+    std::weak_ptr<VulkanBackend> backend_;
+};
+
+/**
+ * @brief Vulkan implementation of RHIBuffer.
+ *
+ * GPU_ONLY buffers live in device-local memory, every other memory usage in
+ * host-visible, host-coherent memory that stays persistently mapped.
+ */
+class VulkanBuffer : public RHIBuffer {
+public:
+    VulkanBuffer(const RHIBufferInfo& info, std::shared_ptr<VulkanBackend> backend);
+
+    virtual bool init() override final;
+    virtual void* map() override final;
+    virtual void unmap() override final {}
+
+    virtual void destroy() override final;
+    virtual void* raw_handle() override final { return buffer_; }
+
+    VkBuffer get_handle() const { return buffer_; }
+
+private:
+    VkBuffer buffer_ = VK_NULL_HANDLE;
+    VkDeviceMemory memory_ = VK_NULL_HANDLE;
+    void* mapped_data_ = nullptr;
+    std::weak_ptr<VulkanBackend> backend_;
+};
+
+/**
+ * @brief Vulkan implementation of RHIFence
+ */
+class VulkanFence : public RHIFence {
+public:
+    VulkanFence(bool signaled, std::shared_ptr<VulkanBackend> backend) : signaled_(signaled), backend_(backend) {}
+
+    virtual bool init() override final;
+    virtual void wait() override final;
+    virtual bool is_signaled() override final;
+    virtual void destroy() override final;
+    virtual void* raw_handle() override final { return fence_; }
+
+    VkFence get_handle() const { return fence_; }
+
+private:
+    VkFence fence_ = VK_NULL_HANDLE;
+    bool signaled_;
+    std::weak_ptr<VulkanBackend> backend_;
+};
+
+/**
+ * @brief Vulkan implementation of RHISemaphore (binary semaphore)
+ */
+class VulkanSemaphore : public RHISemaphore {
+public:
+    VulkanSemaphore(std::shared_ptr<VulkanBackend> backend) : backend_(backend) {}
+
+    virtual bool init();
+    virtual void destroy() override final;
+    virtual void* raw_handle() override final { return semaphore_; }
+
+    VkSemaphore get_handle() const { return semaphore_; }
+
+private:
+    VkSemaphore semaphore_ = VK_NULL_HANDLE;
+    std::weak_ptr<VulkanBackend> backend_;
+};
+
+/**
+ * @brief Vulkan implementation of RHITimelineSemaphore, a native Vulkan 1.2 timeline semaphore
+ */
+class VulkanTimelineSemaphore : public RHITimelineSemaphore {
+public:
+    VulkanTimelineSemaphore(uint64_t initial_value, std::shared_ptr<VulkanBackend> backend)
+        : initial_value_(initial_value), backend_(backend) {}
+
+    virtual bool init();
+    virtual uint64_t get_completed_value() override final;
+    virtual void signal(uint64_t value) override final;
+    virtual bool wait(uint64_t value, uint64_t timeout_ms = UINT64_MAX) override final;
+    virtual void destroy() override final;
+    virtual void* raw_handle() override final { return semaphore_; }
+
+    VkSemaphore get_handle() const { return semaphore_; }
+
+private:
+    VkSemaphore semaphore_ = VK_NULL_HANDLE;
+    uint64_t initial_value_;
+    std::weak_ptr<VulkanBackend> backend_;
+};
+
+/**
+ * @brief Vulkan implementation of RHICommandContext.
+ *
+ * Records into one primary command buffer allocated from its pool. Only copies
+ * between buffers and buffer barriers are recorded; the rest of the interface is
+ * accepted and ignored until textures and pipelines exist in this backend.
+ */
+class VulkanCommandContext : public RHICommandContext {
+public:
+    VulkanCommandContext(RHICommandPoolRef pool, std::shared_ptr<VulkanBackend> backend);
+
+    virtual void destroy() override final;
+    virtual void* raw_handle() override final { return command_buffer_; }
+
+    virtual void begin_command() override final;
+    virtual void end_command() override final;
+    virtual void execute(RHIFenceRef fence, RHISemaphoreRef wait_semaphore, RHISemaphoreRef signal_semaphore) override final;
+
+    virtual void texture_barrier(const RHITextureBarrier& barrier) override final {}
+    virtual void buffer_barrier(const RHIBufferBarrier& barrier) override final;
+
+    virtual void copy_texture_to_buffer(RHITextureRef src, TextureSubresourceLayers src_subresource, RHIBufferRef dst, uint64_t dst_offset) override final {}
+    virtual void copy_buffer_to_texture(RHIBufferRef src, uint64_t src_offset, RHITextureRef dst, TextureSubresourceLayers dst_subresource) override final {}
+    virtual void copy_buffer(RHIBufferRef src, uint64_t src_offset, RHIBufferRef dst, uint64_t dst_offset, uint64_t size) override final;
+    virtual void copy_texture(RHITextureRef src, TextureSubresourceLayers src_subresource, RHITextureRef dst, TextureSubresourceLayers dst_subresource) override final {}
+    virtual void generate_mips(RHITextureRef src) override final {}
+
+    virtual void push_event(const std::string& name, Color3 color) override final {}
+    virtual void pop_event() override final {}
+
+    virtual void begin_render_pass(RHIRenderPassRef render_pass) override final {}
+    virtual void end_render_pass() override final {}
+
+    virtual void set_viewport(Offset2D min, Offset2D max) override final {}
+    virtual void set_scissor(Offset2D min, Offset2D max) override final {}
+    virtual void set_depth_bias(float constant_bias, float slope_bias, float clamp_bias) override final {}
+    virtual void set_line_width(float width) override final {}
+
+    virtual void set_graphics_pipeline(RHIGraphicsPipelineRef graphics_pipeline) override final {}
+    virtual void set_compute_pipeline(RHIComputePipelineRef compute_pipeline) override final {}
+    virtual void set_ray_tracing_pipeline(RHIRayTracingPipelineRef ray_tracing_pipeline) override final {}
+
+    virtual void push_constants(void* data, uint16_t size, ShaderFrequency frequency) override final {}
+    virtual void bind_descriptor_set(RHIDescriptorSetRef descriptor, uint32_t set) override final {}
+    virtual void bind_constant_buffer(RHIBufferRef buffer, uint32_t slot, ShaderFrequency frequency) override final {}
+    virtual void bind_texture(RHITextureRef texture, uint32_t slot, ShaderFrequency frequency) override final {}
+    virtual void bind_rw_texture(RHITextureRef texture, uint32_t slot, uint32_t mip_level, ShaderFrequency frequency) override final {}
+    virtual void bind_buffer(RHIBufferRef buffer, uint32_t slot, ShaderFrequency frequency) override final {}
+    virtual void bind_sampler(RHISamplerRef sampler, uint32_t slot, ShaderFrequency frequency) override final {}
+    virtual void bind_vertex_buffer(RHIBufferRef vertex_buffer, uint32_t stream_index, uint32_t offset) override final {}
+    virtual void bind_index_buffer(RHIBufferRef index_buffer, uint32_t offset) override final {}
+
+    virtual void dispatch(uint32_t group_count_x, uint32_t group_count_y, uint32_t group_count_z) override final {}
+    virtual void dispatch_indirect(RHIBufferRef argument_buffer, uint32_t argument_offset) override final {}
+    virtual void trace_rays(uint32_t group_count_x, uint32_t group_count_y, uint32_t group_count_z) override final {}
+
+    virtual void draw(uint32_t vertex_count, uint32_t instance_count, uint32_t first_vertex, uint32_t first_instance) override final {}
+    virtual void draw_indexed(uint32_t index_count, uint32_t instance_count, uint32_t first_index, uint32_t vertex_offset, uint32_t first_instance) override final {}
+    virtual void draw_indirect(RHIBufferRef argument_buffer, uint32_t offset, uint32_t draw_count) override final {}
+    virtual void draw_indexed_indirect(RHIBufferRef argument_buffer, uint32_t offset, uint32_t draw_count) override final {}
+
+    virtual bool read_texture(RHITextureRef texture, void* data, uint32_t size) override final { return false; }
+
+    virtual void imgui_create_fonts_texture() override final {}
+    virtual void imgui_render_draw_data() override final {}
+
+private:
+    VkCommandBuffer command_buffer_ = VK_NULL_HANDLE;
+    std::shared_ptr<VulkanCommandPool> pool_;
+    std::weak_ptr<VulkanBackend> backend_;
+};
+
+/**
+ * @brief Vulkan implementation of RHICommandContextImmediate.
+ *
+ * Commands are recorded into a command buffer owned by this context; flush()
+ * submits it and blocks until the GPU has finished, so data copied into a
+ * host-visible buffer can be mapped right after flush() returns.
+ */
+class VulkanCommandContextImmediate : public RHICommandContextImmediate {
+public:
+    VulkanCommandContextImmediate(VulkanBackend& backend);
+
+    virtual void destroy() override final;
+
+    virtual void flush() override final;
+
+    virtual void texture_barrier(const RHITextureBarrier& barrier) override final {}
+    virtual void buffer_barrier(const RHIBufferBarrier& barrier) override final;
+
+    virtual void copy_texture_to_buffer(RHITextureRef src, TextureSubresourceLayers src_subresource, RHIBufferRef dst, uint64_t dst_offset) override final {}
+    virtual void copy_buffer_to_texture(RHIBufferRef src, uint64_t src_offset, RHITextureRef dst, TextureSubresourceLayers dst_subresource) override final {}
+    virtual void copy_buffer(RHIBufferRef src, uint64_t src_offset, RHIBufferRef dst, uint64_t dst_offset, uint64_t size) override final;
+    virtual void copy_texture(RHITextureRef src, TextureSubresourceLayers src_subresource, RHITextureRef dst, TextureSubresourceLayers dst_subresource) override final {}
+
+    virtual void generate_mips(RHITextureRef src) override final {}
+
+private:
+    // Begin the command buffer on first use after a flush. Call with mutex_ held.
+    VkCommandBuffer get_recording_buffer();
+
+    VulkanBackend& backend_;
+    VkCommandPool pool_ = VK_NULL_HANDLE;
+    VkCommandBuffer command_buffer_ = VK_NULL_HANDLE;
+    VkFence fence_ = VK_NULL_HANDLE;
+    bool recording_ = false;
+    std::mutex mutex_;
+};
+
+/**
+ * @brief Vulkan implementation of RHIBackend
+ */
+class VulkanBackend : public RHIBackend, public std::enable_shared_from_this<VulkanBackend> {
+public:
+    VulkanBackend(const RHIBackendInfo& info);
+
+    virtual void tick() override final;
+    virtual void destroy() override final;
+
+    virtual void set_name(RHIResourceRef resource, const std::string& name) override final;
+
+    virtual void init_imgui(void* window_handle) override final {}
+    virtual void imgui_new_frame() override final {}
+    virtual void imgui_render() override final {}
+    virtual void imgui_shutdown() override final {}
+
+    virtual RHIQueueRef get_queue(const RHIQueueInfo& info) override final;
+    virtual RHISurfaceRef create_surface(void* native_window_handle) override final { return nullptr; }
+    virtual RHISwapchainRef create_swapchain(const RHISwapchainInfo& info) override final { return nullptr; }
+    virtual RHICommandPoolRef create_command_pool(const RHICommandPoolInfo& info) override final;
+    virtual RHICommandContextRef create_command_context(RHICommandPoolRef pool) override final;
+
+    virtual RHIBufferRef create_buffer(const RHIBufferInfo& info) override final;
+    virtual RHITextureRef create_texture(const RHITextureInfo& info) override final { return nullptr; }
+    virtual RHITextureViewRef create_texture_view(const RHITextureViewInfo& info) override final { return nullptr; }
+    virtual RHISamplerRef create_sampler(const RHISamplerInfo& info) override final { return nullptr; }
+    virtual RHIShaderRef create_shader(const RHIShaderInfo& info) override final { return nullptr; }
+    virtual RHIShaderBindingTableRef create_shader_binding_table(const RHIShaderBindingTableInfo& info) override final { return nullptr; }
+    virtual RHITopLevelAccelerationStructureRef create_top_level_acceleration_structure(const RHITopLevelAccelerationStructureInfo& info) override final { return nullptr; }
+    virtual RHIBottomLevelAccelerationStructureRef create_bottom_level_acceleration_structure(const RHIBottomLevelAccelerationStructureInfo& info) override final { return nullptr; }
+
+    virtual RHIRootSignatureRef create_root_signature(const RHIRootSignatureInfo& info) override final { return nullptr; }
+
+    virtual RHIRenderPassRef create_render_pass(const RHIRenderPassInfo& info) override final { return nullptr; }
+    virtual RHIGraphicsPipelineRef create_graphics_pipeline(const RHIGraphicsPipelineInfo& info) override final { return nullptr; }
+    virtual RHIComputePipelineRef create_compute_pipeline(const RHIComputePipelineInfo& info) override final { return nullptr; }
+    virtual RHIRayTracingPipelineRef create_ray_tracing_pipeline(const RHIRayTracingPipelineInfo& info) override final { return nullptr; }
+
+    virtual RHIFenceRef create_fence(bool signaled) override final;
+    virtual RHISemaphoreRef create_semaphore() override final;
+    virtual RHITimelineSemaphoreRef create_timeline_semaphore(uint64_t initial_value = 0) override final;
+
+    virtual RHICommandContextImmediateRef get_immediate_command() override final { return immediate_context_; }
+
+    /**
+     * @brief Compile GLSL to SPIR-V. The profile prefix selects the stage: "vs", "ps", "gs", "hs", "ds" or "cs".
+     */
+    virtual std::vector<uint8_t> compile_shader(const char* source, const char* entry, const char* profile) override final;
+
+    virtual bool is_valid() const override final { return device_ != VK_NULL_HANDLE; }
+
+protected:
+    virtual RHICommandContextImmediateRef create_upload_command() override final;
+
+public:
+    VkPhysicalDevice get_physical_device() const { return physical_device_; }
+    VkDevice get_device() const { return device_; }
+    VkQueue get_queue_handle() const { return queue_; }
+    uint32_t get_queue_family() const { return queue_family_; }
+
+    /**
+     * @brief Find a memory type allowed by type_bits that has all of the required property flags.
+     * @return UINT32_MAX if there is none
+     */
+    uint32_t find_memory_type(uint32_t type_bits, VkMemoryPropertyFlags properties) const;
+
+    /**
+     * @brief Submit to the universal queue. VkQueue is externally synchronized, every submission goes through here.
+     */
+    VkResult submit(const VkSubmitInfo& submit_info, VkFence fence);
+
+    /**
+     * @brief Lock the universal queue for calls other than vkQueueSubmit (vkQueueWaitIdle, ...).
+     */
+    std::unique_lock<std::mutex> lock_queue() { return std::unique_lock<std::mutex>(queue_mutex_); }
+
+private:
+    bool init_device();
+
+    VkInstance instance_ = VK_NULL_HANDLE;
+    VkPhysicalDevice physical_device_ = VK_NULL_HANDLE;
+    VkDevice device_ = VK_NULL_HANDLE;
+    VkQueue queue_ = VK_NULL_HANDLE;
+    uint32_t queue_family_ = 0;
+    VkPhysicalDeviceMemoryProperties memory_properties_ = {};
+    std::mutex queue_mutex_;
+
+    RHICommandContextImmediateRef immediate_context_;
+};
@@ -205,14 +205,16 @@ int main() {
         Scene* active_scene = EngineContext::world()
                                   ? EngineContext::world()->get_active_scene()
                                   : nullptr;
-        packet.active_scene = active_scene;
+        packet.editor_scene = active_scene;
 
         if (active_scene) {
-            packet.active_camera = active_scene->get_camera();
+            packet.editor_camera = active_scene->get_camera();
         }
 
         // Render
         if (EngineContext::render_system()) {
+            packet.scene = EngineContext::render_system()->extract_scene(
+                packet.editor_scene, packet.editor_camera, packet.frame_index);
             if (!EngineContext::render_system()->tick(packet)) {
                 INFO(LogGame, "RenderSystem returned false, exiting");
                 break;
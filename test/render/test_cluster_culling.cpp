@@ -0,0 +1,249 @@
+#include <catch2/catch_test_macros.hpp>
+#include "test/test_utils.h"
+#include "engine/core/math/math.h"
+#include "engine/core/utils/timer.h"
+#include "engine/core/log/Log.h"
+#include "engine/function/render/render_resource/mesh_cluster.h"
+#include "engine/function/render/render_system/cluster_culling.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <random>
+#include <vector>
+
+/**
+ * @file test/render/test_cluster_culling.cpp
+ * @brief Meshlet building and CPU cluster culling tests: cluster limits and bounds, conservative cones, frustum/backface rejection. No GPU required.
+ */
+
+DEFINE_LOG_TAG(LogClusterTest, "ClusterTest");
+
+namespace {
+
+using test_utils::TestMesh;
+using test_utils::make_sphere;
+using test_utils::translation;
+
+Vec3 triangle_normal(const TestMesh& mesh, uint32_t first_index) {
+    const Vec3& a = mesh.positions[mesh.indices[first_index]];
+    const Vec3& b = mesh.positions[mesh.indices[first_index + 1]];
+    const Vec3& c = mesh.positions[mesh.indices[first_index + 2]];
+    return (b - a).cross(c - a);
+}
+
+bool is_backfacing(const TestMesh& mesh, uint32_t first_index, const Vec3& eye) {
+    return triangle_normal(mesh, first_index).dot(mesh.positions[mesh.indices[first_index]] - eye) >= 0.0f;
+}
+
+std::array<uint32_t, 3> sorted_triangle(const std::vector<uint32_t>& indices, size_t first) {
+    // Rotate so the smallest index comes first, keeping the winding
+    std::array<uint32_t, 3> t = { indices[first], indices[first + 1], indices[first + 2] };
+    while (t[0] > t[1] || t[0] > t[2]) std::rotate(t.begin(), t.begin() + 1, t.end());
+    return t;
+}
+
+Mat4 camera_view_proj(const Vec3& eye, const Vec3& target) {
+    test_utils::TestCamera camera = test_utils::make_camera(eye, target, 0.1f, 100.0f);
+    return camera.view * camera.projection;
+}
+
+} // namespace
+
+TEST_CASE("Mesh clusters respect the limits and keep every triangle", "[cluster]") {
+    TestMesh mesh = make_sphere(64, 128);
+    std::vector<uint32_t> original = mesh.indices;
+
+    std::vector<MeshClusterInfo> clusters;
+    Timer timer;
+    build_mesh_clusters(mesh.positions, mesh.indices, clusters);
+    float build_ms = timer.get_elapsed_ms();
+    REQUIRE(!clusters.empty());
+
+    uint32_t triangle_count = static_cast<uint32_t>(original.size() / 3);
+    uint32_t offset = 0;
+    uint32_t full = 0;
+    for (const MeshClusterInfo& cluster : clusters) {
+        CHECK(cluster.index_offset == offset);
+        CHECK(cluster.triangle_count > 0);
+        CHECK(cluster.triangle_count <= CLUSTER_TRIANGLE_SIZE);
+        CHECK(cluster.vertex_count <= CLUSTER_VERTEX_SIZE);
+
+        std::vector<uint32_t> vertices(mesh.indices.begin() + cluster.index_offset,
+                                       mesh.indices.begin() + cluster.index_offset + cluster.triangle_count * 3);
+        std::sort(vertices.begin(), vertices.end());
+        vertices.erase(std::unique(vertices.begin(), vertices.end()), vertices.end());
+        CHECK(vertices.size() == cluster.vertex_count);
+
+        // The sphere bounds every vertex
+        for (uint32_t v : vertices) {
+            CHECK((mesh.positions[v] - cluster.sphere.center).length() <= cluster.sphere.radius * 1.0001f + 1e-6f);
+        }
+        if (cluster.triangle_count == CLUSTER_TRIANGLE_SIZE || cluster.vertex_count >= CLUSTER_VERTEX_SIZE - 2) full++;
+        offset += cluster.triangle_count * 3;
+    }
+    CHECK(offset == original.size());
+    INFO(LogClusterTest, "{} triangles -> {} clusters ({:.1f} triangles each, {} full) in {:.2f} ms",
+         triangle_count, clusters.size(), static_cast<float>(triangle_count) / clusters.size(), full, build_ms);
+    CHECK(static_cast<float>(triangle_count) / clusters.size() > CLUSTER_TRIANGLE_SIZE * 0.5f);
+
+    // Same triangles with the same winding, only reordered
+    std::vector<std::array<uint32_t, 3>> before, after;
+    for (size_t i = 0; i < original.size(); i += 3) {
+        before.push_back(sorted_triangle(original, i));
+        after.push_back(sorted_triangle(mesh.indices, i));
+    }
+    std::sort(before.begin(), before.end());
+    std::sort(after.begin(), after.end());
+    CHECK(before == after);
+}
+
+TEST_CASE("Cluster normal cones are conservative", "[cluster]") {
+    TestMesh mesh = make_sphere(48, 96);
+    std::vector<MeshClusterInfo> clusters;
+    build_mesh_clusters(mesh.positions, mesh.indices, clusters);
+
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> coord(-6.0f, 6.0f);
+    uint32_t culled = 0, tests = 0;
+    for (int i = 0; i < 200; ++i) {
+        Vec3 eye(coord(rng), coord(rng), coord(rng));
+        if (eye.length() < 1.05f) continue;
+        for (const MeshClusterInfo& cluster : clusters) {
+            tests++;
+            if (!is_cluster_backfacing(cluster, eye)) continue;
+            culled++;
+            for (uint32_t t = 0; t < cluster.triangle_count; ++t) {
+                REQUIRE(is_backfacing(mesh, cluster.index_offset + t * 3, eye));
+            }
+        }
+    }
+    INFO(LogClusterTest, "{} / {} cluster tests backface culled", culled, tests);
+    CHECK(culled > tests / 4);
+}
+
+TEST_CASE("Cluster culling rejects clusters outside the frustum and facing away", "[cluster]") {
+    TestMesh mesh = make_sphere(64, 128);
+    std::vector<MeshClusterInfo> clusters;
+    build_mesh_clusters(mesh.positions, mesh.indices, clusters);
+    uint32_t triangle_count = static_cast<uint32_t>(mesh.indices.size() / 3);
+
+    Vec3 center(0.0f, 0.0f, 10.0f);
+    Mat4 model = translation(center);
+    Mat4 inv_model = model.inverse();
+
+    ClusterCuller culler;
+    std::vector<ClusterDrawRange> ranges;
+
+    // Every front-facing triangle that reaches the screen is inside one of the ranges
+    auto check_no_visible_lost = [&](const Vec3& eye, const Mat4& view_proj) {
+        Frustum frustum = extract_frustum(view_proj);
+        for (uint32_t i = 0; i < mesh.indices.size(); i += 3) {
+            Vec3 local_eye = eye - center;
+            if (is_backfacing(mesh, i, local_eye)) continue;
+            bool on_screen = false;
+            for (uint32_t k = 0; k < 3 && !on_screen; ++k) {
+                Vec3 p = mesh.positions[mesh.indices[i + k]] + center;
+                on_screen = std::all_of(std::begin(frustum.planes), std::end(frustum.planes),
+                                        [&](const Vec4& plane) { return plane.xyz().dot(p) + plane.w >= 0.0f; });
+            }
+            if (!on_screen) continue;
+            bool drawn = std::any_of(ranges.begin(), ranges.end(), [&](const ClusterDrawRange& r) {
+                return i >= r.index_offset && i < r.index_offset + r.index_count;
+            });
+            REQUIRE(drawn);
+        }
+    };
+
+    SECTION("Whole object in view: about half faces away") {
+        Vec3 eye(0.0f, 0.0f, 0.0f);
+        Mat4 view_proj = camera_view_proj(eye, center);
+        culler.begin_frame();
+        uint32_t count = culler.cull(view_proj, eye, model, inv_model, clusters, true, ranges);
+        culler.end_frame();
+        const auto& stats = culler.get_last_stats();
+        INFO(LogClusterTest, "Facing: {} / {} clusters backface culled, {} / {} triangles rejected, {} ranges, drawn {}",
+             stats.backface_culled, stats.tested, stats.backface_culled_triangles, stats.triangles, count, stats.drawn_triangles);
+
+        CHECK(count >= 1);
+        CHECK(count <= ClusterCuller::MAX_DRAW_RANGES);
+        CHECK(stats.frustum_culled == 0);
+        CHECK(stats.backface_culled_triangles > triangle_count / 4);
+        CHECK(stats.drawn_triangles < triangle_count);
+        CHECK(stats.drawn_triangles + stats.backface_culled_triangles >= triangle_count);
+        check_no_visible_lost(eye, view_proj);
+
+        // Two-sided materials keep everything
+        ranges.clear();
+        culler.begin_frame();
+        culler.cull(view_proj, eye, model, inv_model, clusters, false, ranges);
+        culler.end_frame();
+        CHECK(culler.get_last_stats().backface_culled == 0);
+        CHECK(culler.get_last_stats().drawn_triangles == triangle_count);
+    }
+
+    SECTION("Close up: most clusters are off screen") {
+        Vec3 eye(0.0f, 0.0f, 8.6f);
+        Mat4 view_proj = camera_view_proj(eye, Vec3(0.6f, 0.0f, 10.0f));
+        culler.begin_frame();
+        culler.cull(view_proj, eye, model, inv_model, clusters, true, ranges);
+        culler.end_frame();
+        const auto& stats = culler.get_last_stats();
+        INFO(LogClusterTest, "Close up: frustum {} / backface {} of {} triangles rejected, {} ranges, drawn {}",
+             stats.frustum_culled_triangles, stats.backface_culled_triangles, stats.triangles, stats.draw_ranges,
+             stats.drawn_triangles);
+        CHECK(stats.frustum_culled > 0);
+        CHECK(stats.frustum_culled_triangles + stats.backface_culled_triangles > triangle_count / 2);
+        check_no_visible_lost(eye, view_proj);
+    }
+
+    SECTION("Object behind the camera is culled entirely") {
+        Vec3 eye(0.0f, 0.0f, 0.0f);
+        Mat4 view_proj = camera_view_proj(eye, Vec3(0.0f, 0.0f, -10.0f));
+        culler.begin_frame();
+        CHECK(culler.cull(view_proj, eye, model, inv_model, clusters, true, ranges) == 0);
+        culler.end_frame();
+        CHECK(ranges.empty());
+        CHECK(culler.get_last_stats().fully_culled_objects == 1);
+    }
+
+    SECTION("Mirrored transforms skip the cone test") {
+        Mat4 mirrored = model;
+        mirrored.m[0][0] = -1.0f;
+        Vec3 eye(0.0f, 0.0f, 0.0f);
+        culler.begin_frame();
+        culler.cull(camera_view_proj(eye, center), eye, mirrored, mirrored.inverse(), clusters, true, ranges);
+        culler.end_frame();
+        CHECK(culler.get_last_stats().backface_culled == 0);
+    }
+}
+
+TEST_CASE("Cluster culling benchmark", "[cluster][.benchmark]") {
+    TestMesh mesh = make_sphere(256, 512);
+    std::vector<MeshClusterInfo> clusters;
+    Timer timer;
+    build_mesh_clusters(mesh.positions, mesh.indices, clusters);
+    float build_ms = timer.get_elapsed_ms();
+
+    // A grid of 256 spheres in front of the camera
+    Vec3 eye(0.0f, 2.0f, -5.0f);
+    Mat4 view_proj = camera_view_proj(eye, Vec3(0.0f, 0.0f, 20.0f));
+    std::vector<Mat4> models;
+    for (int x = 0; x < 16; ++x) {
+        for (int z = 0; z < 16; ++z) models.push_back(translation(Vec3(x * 3.0f - 24.0f, 0.0f, z * 3.0f)));
+    }
+
+    ClusterCuller culler;
+    std::vector<ClusterDrawRange> ranges;
+    culler.begin_frame();
+    for (const Mat4& model : models) culler.cull(view_proj, eye, model, model.inverse(), clusters, true, ranges);
+    culler.end_frame();
+    const auto& stats = culler.get_last_stats();
+    INFO(LogClusterTest, "{} triangles -> {} clusters in {:.1f} ms", mesh.indices.size() / 3, clusters.size(), build_ms);
+    INFO(LogClusterTest, "{} objects, {} clusters: frustum {} / backface {} culled, {:.1f}% of triangles rejected, {} ranges, {:.3f} ms",
+         stats.object_count, stats.tested, stats.frustum_culled, stats.backface_culled,
+         100.0 * (stats.frustum_culled_triangles + stats.backface_culled_triangles) / stats.triangles,
+         stats.draw_ranges, stats.cull_ms);
+    CHECK(stats.tested == clusters.size() * models.size());
+    CHECK(stats.draw_ranges <= models.size() * ClusterCuller::MAX_DRAW_RANGES);
+}
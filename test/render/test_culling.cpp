@@ -0,0 +1,465 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include "test/test_utils.h"
+#include "engine/main/engine_context.h"
+#include "engine/core/os/thread_pool.h"
+#include "engine/core/math/math.h"
+#include "engine/core/utils/timer.h"
+#include "engine/core/log/Log.h"
+#include "engine/function/render/render_system/frustum_culling.h"
+#include "engine/function/render/render_system/dynamic_aabb_tree.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+/**
+ * @file test/render/test_culling.cpp
+ * @brief CPU visibility tests (frustum culling, dynamic AABB tree). No GPU required.
+ */
+
+DEFINE_LOG_TAG(LogCullingTest, "CullingTest");
+
+namespace {
+
+using test_utils::TestCamera;
+
+Frustum make_test_frustum(Vec3 eye, Vec3 target, float far_plane = 100.0f) {
+    TestCamera camera = test_utils::make_camera(eye, target, 0.1f, far_plane);
+    return extract_frustum(camera.view * camera.projection);
+}
+
+BoundingBox make_box(Vec3 center, float half_extent) {
+    BoundingBox box;
+    box.min = center - Vec3(half_extent, half_extent, half_extent);
+    box.max = center + Vec3(half_extent, half_extent, half_extent);
+    return box;
+}
+
+BoundingSphere sphere_around_box(Vec3 center, float half_extent) {
+    return BoundingSphere{center, half_extent * 1.7320508f};
+}
+
+// Random objects scattered in a cube around the origin
+CullingBounds make_random_bounds(uint32_t count, float extent, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> position(-extent, extent);
+    std::uniform_real_distribution<float> size(0.1f, 4.0f);
+
+    CullingBounds bounds;
+    bounds.reserve(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        Vec3 center(position(rng), position(rng), position(rng));
+        float half = size(rng);
+        bounds.add(sphere_around_box(center, half), make_box(center, half));
+    }
+    return bounds;
+}
+
+BoundingSphere sphere_at(const CullingBounds& bounds, uint32_t i) {
+    return BoundingSphere{Vec3(bounds.center_x[i], bounds.center_y[i], bounds.center_z[i]), bounds.radius[i]};
+}
+
+BoundingBox box_at(const CullingBounds& bounds, uint32_t i) {
+    BoundingBox box;
+    box.min = Vec3(bounds.min_x[i], bounds.min_y[i], bounds.min_z[i]);
+    box.max = Vec3(bounds.max_x[i], bounds.max_y[i], bounds.max_z[i]);
+    return box;
+}
+
+std::vector<BoundingBox> make_random_boxes(uint32_t count, float extent, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> position(-extent, extent);
+    std::uniform_real_distribution<float> size(0.1f, 2.0f);
+
+    std::vector<BoundingBox> boxes(count);
+    for (auto& box : boxes) {
+        box = make_box(Vec3(position(rng), position(rng), position(rng)), size(rng));
+    }
+    return boxes;
+}
+
+bool box_overlaps_sphere(const BoundingBox& box, const BoundingSphere& sphere) {
+    Vec3 closest = sphere.center.cwiseMax(box.min).cwiseMin(box.max);
+    return (closest - sphere.center).squared_length() <= sphere.radius * sphere.radius;
+}
+
+bool box_in_frustum(const Frustum& frustum, const BoundingBox& box) {
+    for (const Vec4& plane : frustum.planes) {
+        float p = plane.x * (plane.x >= 0.0f ? box.max.x : box.min.x) +
+                  plane.y * (plane.y >= 0.0f ? box.max.y : box.min.y) +
+                  plane.z * (plane.z >= 0.0f ? box.max.z : box.min.z) + plane.w;
+        if (p < 0.0f) return false;
+    }
+    return true;
+}
+
+bool ray_hits_box(const Vec3& origin, const Vec3& dir, float max_t, const BoundingBox& box) {
+    float t_min = 0.0f;
+    float t_max = max_t;
+    for (int axis = 0; axis < 3; ++axis) {
+        float inv = 1.0f / dir(axis);
+        float t1 = (box.min(axis) - origin(axis)) * inv;
+        float t2 = (box.max(axis) - origin(axis)) * inv;
+        if (t1 > t2) std::swap(t1, t2);
+        t_min = t1 > t_min ? t1 : t_min;
+        t_max = t2 < t_max ? t2 : t_max;
+        if (t_min > t_max) return false;
+    }
+    return true;
+}
+
+} // namespace
+
+TEST_CASE("Frustum plane extraction", "[culling]") {
+    // Left-handed: camera at origin looking down +Z, with a 90 degree fov so the planes sit on the diagonals
+    Mat4 view = Math::look_at(Vec3::Zero(), Vec3::UnitZ(), Vec3::UnitY());
+    Mat4 proj = Math::perspective(Math::to_radians(90.0f), 16.0f / 9.0f, 0.1f, 100.0f);
+    Frustum frustum = extract_frustum(view * proj);
+
+    for (const auto& plane : frustum.planes) {
+        CHECK(plane.xyz().length() == Catch::Approx(1.0f).margin(1e-4));
+    }
+
+    auto visible = [&](Vec3 p, float half) {
+        return FrustumCuller::is_visible(frustum, sphere_around_box(p, half), make_box(p, half));
+    };
+
+    CHECK(visible(Vec3(0.0f, 0.0f, 10.0f), 0.5f));
+    CHECK_FALSE(visible(Vec3(0.0f, 0.0f, -10.0f), 0.5f));   // Behind the camera
+    CHECK_FALSE(visible(Vec3(0.0f, 0.0f, 150.0f), 0.5f));   // Past the far plane
+    CHECK_FALSE(visible(Vec3(0.0f, 30.0f, 10.0f), 0.5f));   // Above the 90 degree vertical fov
+    CHECK_FALSE(visible(Vec3(-40.0f, 0.0f, 10.0f), 0.5f));  // Left of the horizontal fov
+    CHECK(visible(Vec3(0.0f, 10.4f, 10.0f), 0.5f));         // Straddles the top plane
+}
+
+TEST_CASE("Bounding volume transform", "[culling]") {
+    BoundingBox box = make_box(Vec3::Zero(), 1.0f);
+    BoundingSphere sphere{Vec3::Zero(), 1.0f};
+
+    SECTION("Translate and scale") {
+        Mat4 m = Mat4::Identity();
+        m.m[0][0] = 2.0f;
+        m.m[1][1] = 3.0f;
+        m.m[2][2] = 0.5f;
+        m.m[3][0] = 10.0f;
+        m.m[3][1] = -5.0f;
+
+        BoundingBox world_box = transform_bounding_box(box, m);
+        CHECK(world_box.min.x == Catch::Approx(8.0f));
+        CHECK(world_box.max.x == Catch::Approx(12.0f));
+        CHECK(world_box.min.y == Catch::Approx(-8.0f));
+        CHECK(world_box.max.y == Catch::Approx(-2.0f));
+        CHECK(world_box.min.z == Catch::Approx(-0.5f));
+        CHECK(world_box.max.z == Catch::Approx(0.5f));
+
+        BoundingSphere world_sphere = transform_bounding_sphere(sphere, m);
+        CHECK(world_sphere.center.x == Catch::Approx(10.0f));
+        CHECK(world_sphere.center.y == Catch::Approx(-5.0f));
+        CHECK(world_sphere.radius == Catch::Approx(3.0f));
+    }
+
+    SECTION("Rotation grows the box to enclose the rotated corners") {
+        // 45 degrees around Y
+        float c = 0.70710678f;
+        Mat4 m = Mat4::Identity();
+        m.m[0][0] = c;  m.m[0][2] = -c;
+        m.m[2][0] = c;  m.m[2][2] = c;
+
+        BoundingBox world_box = transform_bounding_box(box, m);
+        CHECK(world_box.max.x == Catch::Approx(2.0f * c));
+        CHECK(world_box.max.z == Catch::Approx(2.0f * c));
+        CHECK(world_box.max.y == Catch::Approx(1.0f));
+        CHECK(transform_bounding_sphere(sphere, m).radius == Catch::Approx(1.0f));
+    }
+}
+
+TEST_CASE("SIMD frustum culling matches scalar reference", "[culling]") {
+    // Not a multiple of the SIMD width or chunk size, so the scalar tail is exercised
+    const uint32_t count = 3 * FrustumCuller::CHUNK_SIZE + 13;
+    CullingBounds bounds = make_random_bounds(count, 120.0f, 1234);
+    Frustum frustum = make_test_frustum(Vec3(5.0f, 2.0f, -20.0f), Vec3(0.0f, 0.0f, 40.0f));
+
+    std::vector<uint32_t> expected;
+    for (uint32_t i = 0; i < count; ++i) {
+        if (FrustumCuller::is_visible(frustum, sphere_at(bounds, i), box_at(bounds, i))) {
+            expected.push_back(i);
+        }
+    }
+    REQUIRE(!expected.empty());
+    REQUIRE(expected.size() < count);
+
+    FrustumCuller culler;
+    std::vector<uint32_t> visible;
+
+    SECTION("Single thread") {
+        culler.cull(frustum, bounds, visible);
+    }
+    SECTION("Thread pool") {
+        REQUIRE(EngineContext::thread_pool() != nullptr);
+        culler.cull(frustum, bounds, visible, EngineContext::thread_pool());
+    }
+
+    CHECK(visible == expected);
+
+    const auto& stats = culler.get_last_stats();
+    CHECK(stats.tested == count);
+    CHECK(stats.visible == expected.size());
+    CHECK(stats.chunk_count == 4);
+    CHECK(stats.visible + stats.sphere_culled + stats.box_culled == count);
+    CHECK(stats.box_culled > 0);
+}
+
+TEST_CASE("Frustum culling benchmark", "[culling][.benchmark]") {
+    const uint32_t count = 100000;
+    const int iterations = 20;
+    CullingBounds bounds = make_random_bounds(count, 500.0f, 42);
+    Frustum frustum = make_test_frustum(Vec3(0.0f, 10.0f, -50.0f), Vec3(0.0f, 0.0f, 100.0f), 1000.0f);
+
+    // Before: per-object scalar test on array-of-structs bounds
+    std::vector<BoundingSphere> spheres(count);
+    std::vector<BoundingBox> boxes(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        spheres[i] = sphere_at(bounds, i);
+        boxes[i] = box_at(bounds, i);
+    }
+    std::vector<uint32_t> scalar_visible;
+    Timer timer;
+    for (int it = 0; it < iterations; ++it) {
+        scalar_visible.clear();
+        for (uint32_t i = 0; i < count; ++i) {
+            if (FrustumCuller::is_visible(frustum, spheres[i], boxes[i])) {
+                scalar_visible.push_back(i);
+            }
+        }
+    }
+    float scalar_ms = timer.get_total_ms() / iterations;
+
+    FrustumCuller culler;
+    std::vector<uint32_t> visible;
+
+    timer.reset();
+    for (int it = 0; it < iterations; ++it) {
+        culler.cull(frustum, bounds, visible);
+    }
+    float simd_ms = timer.get_total_ms() / iterations;
+    REQUIRE(visible == scalar_visible);
+
+    timer.reset();
+    for (int it = 0; it < iterations; ++it) {
+        culler.cull(frustum, bounds, visible, EngineContext::thread_pool());
+    }
+    float parallel_ms = timer.get_total_ms() / iterations;
+    REQUIRE(visible == scalar_visible);
+
+    const auto& stats = culler.get_last_stats();
+    INFO(LogCullingTest, "{} objects: visible {}, sphere culled {}, box culled {}",
+         stats.tested, stats.visible, stats.sphere_culled, stats.box_culled);
+    INFO(LogCullingTest, "Scalar {:.3f} ms, {}-wide SIMD {:.3f} ms, SIMD + thread pool ({} chunks) {:.3f} ms",
+         scalar_ms, FrustumCuller::simd_width(), simd_ms, stats.chunk_count, parallel_ms);
+}
+
+TEST_CASE("Dynamic AABB tree", "[culling][spatial]") {
+    const uint32_t count = 2000;
+    std::vector<BoundingBox> boxes = make_random_boxes(count, 100.0f, 7);
+
+    DynamicAABBTree tree;
+    std::vector<int32_t> proxies(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        proxies[i] = tree.create_proxy(boxes[i], reinterpret_cast<void*>(uintptr_t(i + 1)));
+    }
+    REQUIRE(tree.get_proxy_count() == count);
+    REQUIRE(tree.validate());
+    CHECK(tree.get_height() <= 2 * static_cast<int32_t>(std::log2(count)) + 2);
+
+    // Every query must match a brute force pass over the fattened boxes
+    auto check_queries = [&](const std::vector<bool>& alive) {
+        auto expect = [&](auto&& predicate) {
+            std::vector<int32_t> result;
+            for (uint32_t i = 0; i < count; ++i) {
+                if (alive[i] && predicate(tree.get_fat_box(proxies[i]))) result.push_back(proxies[i]);
+            }
+            std::sort(result.begin(), result.end());
+            return result;
+        };
+        auto sorted = [](std::vector<int32_t> v) { std::sort(v.begin(), v.end()); return v; };
+
+        BoundingBox query_box = make_box(Vec3(10.0f, -5.0f, 20.0f), 25.0f);
+        std::vector<int32_t> hits;
+        tree.query_box(query_box, [&](int32_t proxy) { hits.push_back(proxy); return true; });
+        CHECK(sorted(hits) == expect([&](const BoundingBox& b) {
+            return b.min.x <= query_box.max.x && query_box.min.x <= b.max.x &&
+                   b.min.y <= query_box.max.y && query_box.min.y <= b.max.y &&
+                   b.min.z <= query_box.max.z && query_box.min.z <= b.max.z;
+        }));
+
+        BoundingSphere sphere{Vec3(-30.0f, 10.0f, 0.0f), 30.0f};
+        hits.clear();
+        tree.query_sphere(sphere, [&](int32_t proxy) { hits.push_back(proxy); return true; });
+        CHECK(sorted(hits) == expect([&](const BoundingBox& b) { return box_overlaps_sphere(b, sphere); }));
+
+        Frustum frustum = make_test_frustum(Vec3(0.0f, 0.0f, -120.0f), Vec3::Zero(), 200.0f);
+        hits.clear();
+        tree.query_frustum(frustum, [&](int32_t proxy) { hits.push_back(proxy); return true; });
+        CHECK(sorted(hits) == expect([&](const BoundingBox& b) { return box_in_frustum(frustum, b); }));
+
+        Vec3 origin(-150.0f, 1.0f, 2.0f);
+        Vec3 dir = Vec3(1.0f, 0.02f, 0.01f).normalized();
+        hits.clear();
+        tree.query_ray(origin, dir, 400.0f, [&](int32_t proxy, float max_t) { hits.push_back(proxy); return max_t; });
+        CHECK(sorted(hits) == expect([&](const BoundingBox& b) { return ray_hits_box(origin, dir, 400.0f, b); }));
+    };
+
+    std::vector<bool> alive(count, true);
+    check_queries(alive);
+
+    SECTION("Refit") {
+        // Moves inside the margin keep the leaf in place
+        BoundingBox nudged = boxes[0];
+        nudged.min.x += 0.05f;
+        nudged.max.x += 0.05f;
+        CHECK_FALSE(tree.move_proxy(proxies[0], nudged));
+
+        std::mt19937 rng(99);
+        std::uniform_real_distribution<float> offset(-20.0f, 20.0f);
+        for (uint32_t i = 0; i < count; i += 3) {
+            Vec3 delta(offset(rng), offset(rng), offset(rng));
+            BoundingBox moved{boxes[i].min + delta, boxes[i].max + delta};
+            CHECK(tree.move_proxy(proxies[i], moved));
+        }
+        REQUIRE(tree.validate());
+        check_queries(alive);
+    }
+
+    SECTION("Remove and rebalance") {
+        for (uint32_t i = 0; i < count; i += 2) {
+            tree.destroy_proxy(proxies[i]);
+            alive[i] = false;
+        }
+        REQUIRE(tree.get_proxy_count() == count / 2);
+        REQUIRE(tree.validate());
+        check_queries(alive);
+
+        // Reuse freed nodes
+        for (uint32_t i = 0; i < count; i += 2) {
+            proxies[i] = tree.create_proxy(boxes[i], nullptr);
+            alive[i] = true;
+        }
+        float ratio_before = tree.get_area_ratio();
+        int32_t height_before = tree.get_height();
+        CHECK(tree.rebalance());
+        REQUIRE(tree.validate());
+        CHECK(tree.get_area_ratio() < ratio_before);
+        CHECK(tree.get_height() <= height_before);
+        check_queries(alive);
+
+        // Nothing changed since the rebuild
+        CHECK_FALSE(tree.rebalance());
+    }
+
+    SECTION("Early out") {
+        uint32_t reported = 0;
+        tree.query_box(make_box(Vec3::Zero(), 200.0f), [&](int32_t) { return ++reported < 10; });
+        CHECK(reported == 10);
+    }
+}
+
+TEST_CASE("Dynamic AABB tree benchmark", "[culling][spatial][.benchmark]") {
+    for (uint32_t count : {10000u, 100000u, 1000000u}) {
+        // Keep density constant so every size sees a similar number of hits per query
+        float extent = 100.0f * std::cbrt(count / 1000.0f);
+        // Camera inside the cloud, sees a small part of it like a player camera would
+        Frustum frustum = make_test_frustum(Vec3(0.0f, 0.0f, -extent * 0.5f), Vec3::Zero(), extent * 0.5f);
+        std::vector<BoundingBox> boxes = make_random_boxes(count, extent, 5);
+
+        Timer timer;
+        DynamicAABBTree tree;
+        std::vector<int32_t> proxies(count);
+        for (uint32_t i = 0; i < count; ++i) {
+            proxies[i] = tree.create_proxy(boxes[i], nullptr);
+        }
+        float build_ms = timer.get_total_ms();
+
+        // Per frame, 10% of the objects move: most stay in their fat box, some jump
+        std::mt19937 rng(11);
+        std::uniform_real_distribution<float> jitter(-0.05f, 0.05f);
+        std::uniform_real_distribution<float> jump(-10.0f, 10.0f);
+        uint32_t moved = count / 10;
+        uint32_t reinserted = 0;
+        timer.reset();
+        for (uint32_t i = 0; i < moved; ++i) {
+            uint32_t index = (i * 7919u) % count;
+            float d = (i % 10 == 0) ? jump(rng) : jitter(rng);
+            Vec3 delta(d, d, d);
+            boxes[index] = BoundingBox{boxes[index].min + delta, boxes[index].max + delta};
+            reinserted += tree.move_proxy(proxies[index], boxes[index]) ? 1 : 0;
+        }
+        float update_ms = timer.get_total_ms();
+
+        float ratio_before = tree.get_area_ratio();
+        timer.reset();
+        tree.rebuild();
+        float rebuild_ms = timer.get_total_ms();
+
+        const uint32_t query_count = 1000;
+        std::uniform_real_distribution<float> position(-extent, extent);
+        std::vector<BoundingSphere> spheres(query_count);
+        for (auto& sphere : spheres) sphere = BoundingSphere{Vec3(position(rng), position(rng), position(rng)), 10.0f};
+
+        // Tree queries
+        uint32_t tree_frustum_hits = 0;
+        timer.reset();
+        tree.query_frustum(frustum, [&](int32_t) { tree_frustum_hits++; return true; });
+        float tree_frustum_ms = timer.get_total_ms();
+
+        uint32_t tree_sphere_hits = 0;
+        timer.reset();
+        for (const auto& sphere : spheres) {
+            tree.query_sphere(sphere, [&](int32_t) { tree_sphere_hits++; return true; });
+        }
+        float tree_sphere_ms = timer.get_total_ms();
+
+        uint32_t tree_ray_hits = 0;
+        timer.reset();
+        for (const auto& sphere : spheres) {
+            Vec3 dir = (Vec3::Zero() - sphere.center).normalized();
+            tree.query_ray(sphere.center, dir, 50.0f, [&](int32_t, float max_t) { tree_ray_hits++; return max_t; });
+        }
+        float tree_ray_ms = timer.get_total_ms();
+
+        // Linear scans over the same (tight) boxes, as the engine does today
+        uint32_t scan_frustum_hits = 0;
+        timer.reset();
+        for (const auto& box : boxes) scan_frustum_hits += box_in_frustum(frustum, box) ? 1 : 0;
+        float scan_frustum_ms = timer.get_total_ms();
+
+        uint32_t scan_sphere_hits = 0;
+        timer.reset();
+        for (const auto& sphere : spheres) {
+            for (const auto& box : boxes) scan_sphere_hits += box_overlaps_sphere(box, sphere) ? 1 : 0;
+        }
+        float scan_sphere_ms = timer.get_total_ms();
+
+        uint32_t scan_ray_hits = 0;
+        timer.reset();
+        for (const auto& sphere : spheres) {
+            Vec3 dir = (Vec3::Zero() - sphere.center).normalized();
+            for (const auto& box : boxes) scan_ray_hits += ray_hits_box(sphere.center, dir, 50.0f, box) ? 1 : 0;
+        }
+        float scan_ray_ms = timer.get_total_ms();
+
+        REQUIRE(tree.validate());
+        // Fat boxes can only add hits
+        CHECK(tree_frustum_hits >= scan_frustum_hits);
+        CHECK(tree_sphere_hits >= scan_sphere_hits);
+        CHECK(tree_ray_hits >= scan_ray_hits);
+
+        INFO(LogCullingTest, "{} objects: build {:.2f} ms, update {} moved ({} reinserted) {:.2f} ms, rebuild {:.2f} ms (area ratio {:.1f} -> {:.1f}, height {})",
+             count, build_ms, moved, reinserted, update_ms, rebuild_ms, ratio_before, tree.get_area_ratio(), tree.get_height());
+        INFO(LogCullingTest, "  frustum: tree {:.3f} ms / scan {:.3f} ms ({} hits)",
+             tree_frustum_ms, scan_frustum_ms, scan_frustum_hits);
+        INFO(LogCullingTest, "  {} sphere queries: tree {:.3f} ms / scan {:.2f} ms; {} ray queries: tree {:.3f} ms / scan {:.2f} ms",
+             query_count, tree_sphere_ms, scan_sphere_ms, query_count, tree_ray_ms, scan_ray_ms);
+    }
+}
@@ -0,0 +1,160 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include "test/test_utils.h"
+#include "engine/core/math/math.h"
+#include "engine/core/log/Log.h"
+#include "engine/function/render/render_system/depth_prepass_selection.h"
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+/**
+ * @file test/render/test_depth_prepass.cpp
+ * @brief Depth prepass selection tests: coverage and depth complexity scoring, triangle budget, transparent and near-plane batches. No GPU required.
+ */
+
+DEFINE_LOG_TAG(LogDepthPrepassTest, "DepthPrepassTest");
+
+namespace {
+
+constexpr float NEAR_PLANE = 0.1f;
+
+using test_utils::TestCamera;
+
+render::DrawBatch make_batch(uint32_t id, const Vec3& center, float radius, uint32_t triangles) {
+    render::DrawBatch batch;
+    batch.object_id = id;
+    batch.index_count = triangles * 3;
+    batch.world_sphere = BoundingSphere{center, radius};
+    batch.world_box = BoundingBox{center - Vec3(radius, radius, radius), center + Vec3(radius, radius, radius)};
+    return batch;
+}
+
+bool contains(const std::vector<uint32_t>& indices, uint32_t index) {
+    for (uint32_t i : indices) {
+        if (i == index) return true;
+    }
+    return false;
+}
+
+} // namespace
+
+TEST_CASE("Prepass selects large occluders with geometry behind them", "[depth_prepass]") {
+    TestCamera camera = test_utils::make_camera(Vec3::Zero(), Vec3::UnitZ(), NEAR_PLANE);
+    std::vector<render::DrawBatch> batches;
+    batches.push_back(make_batch(1, Vec3(0.0f, 0.0f, 10.0f), 4.0f, 12));        // Wall in front of the props
+    for (uint32_t i = 0; i < 20; ++i) {                                          // Props behind the wall
+        batches.push_back(make_batch(2 + i, Vec3((i % 5) * 1.5f - 3.0f, (i / 5) * 1.0f - 2.0f, 30.0f), 0.5f, 2000));
+    }
+    batches.push_back(make_batch(30, Vec3(60.0f, 0.0f, 60.0f), 10.0f, 12));     // Large, but alone on screen
+    batches.push_back(make_batch(31, Vec3(0.0f, 0.0f, 500.0f), 0.2f, 12));      // Tiny
+    batches.push_back(make_batch(32, Vec3(0.0f, 0.0f, -20.0f), 2.0f, 12));      // Behind the camera
+
+    DepthPrepassSelector selector;
+    std::vector<uint32_t> selected;
+    selector.select(batches, {}, camera.view, camera.projection, NEAR_PLANE, selected);
+
+    REQUIRE_FALSE(selected.empty());
+    CHECK(selected[0] == 0);
+    CHECK_FALSE(contains(selected, 21));
+    CHECK_FALSE(contains(selected, 22));
+    CHECK_FALSE(contains(selected, 23));
+
+    const DepthPrepassStats& stats = selector.get_last_stats();
+    CHECK(stats.batch_count == 24);
+    CHECK(stats.candidate_count == 23);     // All but the one behind the camera
+    CHECK(stats.selected_count == selected.size());
+    CHECK(stats.selected_count + stats.small_count + stats.budget_count == stats.candidate_count);
+    CHECK(stats.selected_triangles < stats.total_triangles);
+    CHECK(stats.selected_coverage > 0.0f);
+
+    // A transparent wall hides nothing
+    std::vector<uint8_t> opaque(batches.size(), 1);
+    opaque[0] = 0;
+    selector.select(batches, opaque, camera.view, camera.projection, NEAR_PLANE, selected);
+    CHECK_FALSE(contains(selected, 0));
+    CHECK(selector.get_last_stats().candidate_count == 22);
+}
+
+TEST_CASE("Prepass selection respects the triangle budget and sorts front to back", "[depth_prepass]") {
+    TestCamera camera = test_utils::make_camera(Vec3::Zero(), Vec3::UnitZ(), NEAR_PLANE);
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<float> offset(-8.0f, 8.0f);
+    std::uniform_real_distribution<float> depth(10.0f, 60.0f);
+    std::uniform_int_distribution<uint32_t> triangles(100, 5000);
+    std::vector<render::DrawBatch> batches;
+    for (uint32_t i = 0; i < 200; ++i) {
+        batches.push_back(make_batch(i + 1, Vec3(offset(rng), offset(rng) * 0.5f, depth(rng)), 3.0f, triangles(rng)));
+    }
+
+    DepthPrepassSelector selector;
+    selector.set_triangle_budget(UINT32_MAX);
+    std::vector<uint32_t> selected;
+    selector.select(batches, {}, camera.view, camera.projection, NEAR_PLANE, selected);
+    uint64_t unlimited = selector.get_last_stats().selected_triangles;
+    REQUIRE(selector.get_last_stats().selected_count > 10);
+    CHECK(selector.get_last_stats().budget_count == 0);
+
+    selector.set_triangle_budget(static_cast<uint32_t>(unlimited / 4));
+    selector.select(batches, {}, camera.view, camera.projection, NEAR_PLANE, selected);
+    const DepthPrepassStats& stats = selector.get_last_stats();
+    CHECK(stats.selected_triangles <= unlimited / 4);
+    CHECK(stats.budget_count > 0);
+    CHECK_FALSE(selected.empty());
+
+    uint64_t triangle_sum = 0;
+    for (uint32_t i = 0; i < selected.size(); ++i) {
+        triangle_sum += batches[selected[i]].index_count / 3;
+        if (i > 0) CHECK(batches[selected[i - 1]].world_sphere.center.z <= batches[selected[i]].world_sphere.center.z);
+    }
+    CHECK(triangle_sum == stats.selected_triangles);
+
+    // No budget left: nothing is prepassed and every batch falls back to the main passes' depth test
+    selector.set_triangle_budget(0);
+    selector.select(batches, {}, camera.view, camera.projection, NEAR_PLANE, selected);
+    CHECK(selected.empty());
+    CHECK(selector.get_last_stats().selected_triangles == 0);
+}
+
+TEST_CASE("Batches crossing the near plane cover the whole screen", "[depth_prepass]") {
+    TestCamera camera = test_utils::make_camera(Vec3::Zero(), Vec3::UnitZ(), NEAR_PLANE);
+    std::vector<render::DrawBatch> batches = {
+        make_batch(1, Vec3(0.0f, 0.0f, 0.5f), 2.0f, 12),    // Camera inside its bounds
+        make_batch(2, Vec3(5.0f, 0.0f, 40.0f), 1.0f, 12),
+        make_batch(3, Vec3(-5.0f, 2.0f, 40.0f), 1.0f, 12),
+    };
+    DepthPrepassSelector selector;
+    selector.set_min_coverage(0.5f);
+    std::vector<uint32_t> selected;
+    selector.select(batches, {}, camera.view, camera.projection, NEAR_PLANE, selected);
+    REQUIRE(selected.size() == 1);
+    CHECK(selected[0] == 0);
+    CHECK(selector.get_last_stats().selected_coverage == Catch::Approx(1.0f));
+    CHECK(selector.get_last_stats().small_count == 2);
+}
+
+TEST_CASE("Prepass selection benchmark", "[depth_prepass][.benchmark]") {
+    constexpr uint32_t BATCH_COUNT = 10000;
+    TestCamera camera = test_utils::make_camera(Vec3::Zero(), Vec3::UnitZ(), NEAR_PLANE);
+    std::mt19937 rng(9);
+    std::uniform_real_distribution<float> offset(-60.0f, 60.0f);
+    std::uniform_real_distribution<float> depth(2.0f, 200.0f);
+    std::uniform_real_distribution<float> radius(0.2f, 6.0f);
+    std::uniform_int_distribution<uint32_t> triangles(50, 20000);
+    std::vector<render::DrawBatch> batches;
+    for (uint32_t i = 0; i < BATCH_COUNT; ++i) {
+        batches.push_back(make_batch(i + 1, Vec3(offset(rng), offset(rng) * 0.3f, depth(rng)), radius(rng), triangles(rng)));
+    }
+
+    DepthPrepassSelector selector;
+    std::vector<uint32_t> selected;
+    selector.select(batches, {}, camera.view, camera.projection, NEAR_PLANE, selected);
+    const DepthPrepassStats& stats = selector.get_last_stats();
+    CHECK(stats.selected_triangles <= selector.get_triangle_budget());
+    CHECK(stats.selected_count < stats.candidate_count);
+
+    INFO(LogDepthPrepassTest, "{} batches: {} candidates, {} prepassed ({} small, {} over budget), {} / {} triangles, {:.3f} ms",
+         BATCH_COUNT, stats.candidate_count, stats.selected_count, stats.small_count, stats.budget_count,
+         stats.selected_triangles, stats.total_triangles, stats.select_ms);
+}
@@ -0,0 +1,175 @@
+#include <catch2/catch_test_macros.hpp>
+#include "engine/core/math/math.h"
+#include "engine/core/utils/timer.h"
+#include "engine/core/log/Log.h"
+#include "engine/function/render/render_system/draw_sort.h"
+#include "engine/function/render/render_resource/material.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+/**
+ * @file test/render/test_draw_sort.cpp
+ * @brief Draw sort key and radix sort tests. No GPU required.
+ */
+
+DEFINE_LOG_TAG(LogDrawSortTest, "DrawSortTest");
+
+namespace {
+
+std::vector<DrawSortEntry> make_random_entries(uint32_t count, uint64_t key_mask, uint32_t seed) {
+    std::mt19937_64 rng(seed);
+    std::vector<DrawSortEntry> entries(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        entries[i] = DrawSortEntry{rng() & key_mask, i};
+    }
+    return entries;
+}
+
+render::DrawBatch make_batch(const MaterialRef& material, float depth) {
+    render::DrawBatch batch;
+    batch.material = material;
+    batch.world_sphere = BoundingSphere{Vec3(0.0f, 0.0f, depth), 0.5f};
+    return batch;
+}
+
+} // namespace
+
+TEST_CASE("Draw sort key layout", "[draw_sort]") {
+    SECTION("Opaque fields sort by significance") {
+        uint64_t base = DrawSortKey::opaque(DrawSortPass::GBuffer, 2, 2, 2, 2);
+        CHECK(DrawSortKey::opaque(DrawSortPass::DepthPrePass, 9, 9, 9, 9) < base);
+        CHECK(DrawSortKey::opaque(DrawSortPass::GBuffer, 1, 9, 9, 9) < base);
+        CHECK(DrawSortKey::opaque(DrawSortPass::GBuffer, 2, 1, 9, 9) < base);
+        CHECK(DrawSortKey::opaque(DrawSortPass::GBuffer, 2, 2, 1, 9) < base);
+        CHECK(DrawSortKey::opaque(DrawSortPass::GBuffer, 2, 2, 2, 1) < base);
+        // Out of range values are masked, never spill into higher fields
+        CHECK(DrawSortKey::opaque(DrawSortPass::GBuffer, 2, 2, 2, 0x1FFFF) < DrawSortKey::opaque(DrawSortPass::GBuffer, 2, 2, 3, 0));
+    }
+
+    SECTION("Transparent sorts after opaque, far to near") {
+        uint64_t opaque = DrawSortKey::opaque(DrawSortPass::NPRForward, 4095, 65535, 65535, 65535);
+        uint64_t far_key = DrawSortKey::transparent(DrawSortPass::Transparent, 1000, 1, 1, 1);
+        uint64_t near_key = DrawSortKey::transparent(DrawSortPass::Transparent, 10, 1, 1, 1);
+        CHECK(opaque < far_key);
+        CHECK(far_key < near_key);
+    }
+
+    SECTION("Depth quantization") {
+        CHECK(DrawSortKey::quantize_depth(0.0f, 0.1f, 1000.0f, 16) == 0);
+        CHECK(DrawSortKey::quantize_depth(5000.0f, 0.1f, 1000.0f, 16) == 0xFFFF);
+        uint32_t last = 0;
+        for (float depth = 0.2f; depth < 1000.0f; depth *= 1.5f) {
+            uint32_t q = DrawSortKey::quantize_depth(depth, 0.1f, 1000.0f, 16);
+            CHECK(q > last);
+            last = q;
+        }
+    }
+}
+
+TEST_CASE("Radix sort matches stable sort", "[draw_sort]") {
+    // Full 64-bit keys, and few distinct keys so stability is exercised
+    for (uint64_t mask : {~0ull, 0x00F0'0000'0000'000Full}) {
+        std::vector<DrawSortEntry> entries = make_random_entries(20000, mask, 7);
+        std::vector<DrawSortEntry> expected = entries;
+        std::stable_sort(expected.begin(), expected.end(),
+                         [](const DrawSortEntry& a, const DrawSortEntry& b) { return a.key < b.key; });
+
+        std::vector<DrawSortEntry> scratch(entries.size());
+        DrawSortEntry* sorted = radix_sort_draw_keys(entries.data(), scratch.data(), entries.size());
+        for (size_t i = 0; i < expected.size(); ++i) {
+            REQUIRE(sorted[i].key == expected[i].key);
+            REQUIRE(sorted[i].index == expected[i].index);
+        }
+    }
+
+    SECTION("Trivial inputs") {
+        std::vector<DrawSortEntry> scratch(1);
+        CHECK(radix_sort_draw_keys(nullptr, nullptr, 0) == nullptr);
+        DrawSortEntry single{42, 0};
+        CHECK(radix_sort_draw_keys(&single, scratch.data(), 1) == &single);
+    }
+}
+
+TEST_CASE("Draw sorter groups state and orders depth", "[draw_sort]") {
+    auto opaque_a = std::make_shared<Material>();
+    auto opaque_b = std::make_shared<Material>();
+    opaque_b->set_cull_mode(CULL_MODE_NONE);
+    auto transparent = std::make_shared<Material>();
+    transparent->set_render_pass_mask(PASS_MASK_TRANSPARENT_PASS);
+    transparent->set_depth_write(false);
+    std::vector<MaterialRef> materials = {opaque_a, opaque_b, transparent};
+
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<float> depth(1.0f, 500.0f);
+    std::vector<render::DrawBatch> batches;
+    std::vector<uint32_t> indices;
+    for (uint32_t i = 0; i < 300; ++i) {
+        batches.push_back(make_batch(materials[i % 3], depth(rng)));
+        indices.push_back(i);
+    }
+
+    DrawSortView view;
+    view.position = Vec3::Zero();
+    view.front = Vec3::UnitZ();
+    view.near_plane = 0.1f;
+    view.far_plane = 1000.0f;
+
+    DrawSorter sorter;
+    sorter.begin_frame();
+    std::vector<render::DrawBatch> sorted;
+    sorter.sort(DrawSortPass::Forward, batches, indices, view, sorted);
+    REQUIRE(sorted.size() == batches.size());
+
+    // Opaque groups first, each front to back; transparent last, back to front
+    uint32_t material_runs = 1;
+    for (size_t i = 1; i < sorted.size(); ++i) {
+        const auto& prev = sorted[i - 1];
+        const auto& cur = sorted[i];
+        if (cur.material != prev.material) {
+            material_runs++;
+            continue;
+        }
+        if (cur.material == transparent) {
+            CHECK(cur.world_sphere.center.z <= prev.world_sphere.center.z);
+        } else {
+            CHECK(cur.world_sphere.center.z >= prev.world_sphere.center.z);
+        }
+    }
+    CHECK(material_runs == 3);
+    CHECK(sorted.back().material == transparent);
+
+    const DrawSortStats& stats = sorter.get_stats();
+    CHECK(stats.draw_count == 300);
+    CHECK(stats.list_count == 1);
+    CHECK(stats.sorted.material == 3);
+    CHECK(stats.unsorted.material == 300);
+    CHECK(stats.sorted.pipeline == 3);     // Cull mode and depth write differ
+
+    sorter.begin_frame();
+    CHECK(sorter.get_last_frame_stats().draw_count == 300);
+    CHECK(sorter.get_stats().draw_count == 0);
+}
+
+TEST_CASE("Draw sort benchmark", "[draw_sort][.benchmark]") {
+    for (uint32_t count : {10000u, 100000u}) {
+        std::vector<DrawSortEntry> entries = make_random_entries(count, ~0ull, 5);
+        std::vector<DrawSortEntry> reference = entries;
+        std::vector<DrawSortEntry> scratch(count);
+
+        Timer timer;
+        DrawSortEntry* sorted = radix_sort_draw_keys(entries.data(), scratch.data(), count);
+        float radix_ms = timer.get_total_ms();
+
+        timer.reset();
+        std::sort(reference.begin(), reference.end(),
+                  [](const DrawSortEntry& a, const DrawSortEntry& b) { return a.key < b.key; });
+        float std_sort_ms = timer.get_total_ms();
+
+        for (uint32_t i = 0; i < count; ++i) {
+            REQUIRE(sorted[i].key == reference[i].key);
+        }
+        INFO(LogDrawSortTest, "{} keys: radix {:.3f} ms, std::sort {:.3f} ms", count, radix_ms, std_sort_ms);
+    }
+}
@@ -0,0 +1,196 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include "engine/core/log/Log.h"
+#include "engine/function/render/render_system/dynamic_resolution.h"
+
+#include <cmath>
+#include <deque>
+#include <random>
+#include <vector>
+
+/**
+ * @file test/render/test_dynamic_resolution.cpp
+ * @brief Dynamic resolution controller tests driven by synthetic frame time traces. Headless, no GPU required.
+ */
+
+DEFINE_LOG_TAG(LogDynamicResolutionTest, "DynamicResolutionTest");
+
+namespace {
+
+constexpr uint32_t TIMING_DELAY = 3;    // GPU timestamps are read back frames in flight later
+
+/**
+ * @brief Synthetic GPU: fixed cost plus a cost per pixel, measured TIMING_DELAY frames late
+ */
+struct SyntheticFrames {
+    float fixed_ms = 4.0f;
+    float full_res_ms = 20.0f;          // Pixel cost at scale 1
+    float noise = 0.0f;                 // Relative, uniform
+    std::mt19937 rng{17};
+    std::deque<float> in_flight;
+
+    float frame(float scale) {
+        std::uniform_real_distribution<float> jitter(-noise, noise);
+        float ms = (fixed_ms + full_res_ms * scale * scale) * (1.0f + jitter(rng));
+        in_flight.push_back(ms);
+        if (in_flight.size() <= TIMING_DELAY) return 0.0f;
+        float measured = in_flight.front();
+        in_flight.pop_front();
+        return measured;
+    }
+};
+
+struct TraceResult {
+    std::vector<float> scales;
+    std::vector<float> frame_ms;
+};
+
+TraceResult run(DynamicResolutionController& controller, SyntheticFrames& gpu, uint32_t frames) {
+    TraceResult result;
+    for (uint32_t i = 0; i < frames; ++i) {
+        float scale = controller.get_scale();
+        result.frame_ms.push_back((gpu.fixed_ms + gpu.full_res_ms * scale * scale));
+        controller.update(gpu.frame(scale));
+        result.scales.push_back(controller.get_scale());
+    }
+    return result;
+}
+
+float mean(const std::vector<float>& values, size_t first) {
+    float sum = 0.0f;
+    for (size_t i = first; i < values.size(); ++i) sum += values[i];
+    return sum / static_cast<float>(values.size() - first);
+}
+
+float deviation(const std::vector<float>& values, size_t first) {
+    float m = mean(values, first);
+    float sum = 0.0f;
+    for (size_t i = first; i < values.size(); ++i) sum += (values[i] - m) * (values[i] - m);
+    return std::sqrt(sum / static_cast<float>(values.size() - first));
+}
+
+uint32_t changes(const std::vector<float>& values, size_t first) {
+    uint32_t count = 0;
+    for (size_t i = first + 1; i < values.size(); ++i) count += values[i] != values[i - 1];
+    return count;
+}
+
+} // namespace
+
+TEST_CASE("Dynamic resolution settles on the frame time target", "[dynamic_resolution]") {
+    DynamicResolutionController controller;
+    controller.set_enabled(true);
+    SyntheticFrames gpu;    // 24 ms at full resolution, 16 ms at scale ~0.77
+    TraceResult trace = run(controller, gpu, 600);
+
+    float expected = std::sqrt((controller.get_settings().target_ms - gpu.fixed_ms) / gpu.full_res_ms);
+    CHECK(mean(trace.scales, 300) == Catch::Approx(expected).margin(0.05f));
+    CHECK(mean(trace.frame_ms, 300) == Catch::Approx(controller.get_settings().target_ms).epsilon(0.08f));
+    CHECK(changes(trace.scales, 300) == 0);
+    for (float scale : trace.scales) {
+        CHECK(scale >= controller.get_settings().min_scale);
+        CHECK(scale <= controller.get_settings().max_scale);
+    }
+
+    // Quantized: the applied scale is a multiple of the quantum
+    float steps = controller.get_scale() / controller.get_settings().quantum;
+    CHECK(steps == Catch::Approx(std::round(steps)).margin(1e-3f));
+    INFO(LogDynamicResolutionTest, "Settled at scale {:.3f} (expected {:.3f}), {:.2f} ms, {} changes",
+         controller.get_scale(), expected, mean(trace.frame_ms, 300), controller.get_stats().changes);
+}
+
+TEST_CASE("Dynamic resolution stays stable under noisy timings", "[dynamic_resolution]") {
+    DynamicResolutionController controller;
+    controller.set_enabled(true);
+    SyntheticFrames gpu;
+    gpu.noise = 0.15f;
+    TraceResult trace = run(controller, gpu, 2000);
+
+    // No limit cycle: the scale wanders within a few quanta and rarely changes
+    CHECK(deviation(trace.scales, 500) < 0.04f);
+    CHECK(changes(trace.scales, 500) < 75);     // Under 5% of the frames resize
+    CHECK(mean(trace.frame_ms, 500) == Catch::Approx(controller.get_settings().target_ms).epsilon(0.1f));
+    INFO(LogDynamicResolutionTest, "Noisy trace: scale {:.3f} +- {:.3f}, {} changes in 1500 frames",
+         mean(trace.scales, 500), deviation(trace.scales, 500), changes(trace.scales, 500));
+}
+
+TEST_CASE("Dynamic resolution follows load changes without winding up", "[dynamic_resolution]") {
+    DynamicResolutionController controller;
+    controller.set_enabled(true);
+    const DynamicResolutionSettings& settings = controller.get_settings();
+    SyntheticFrames gpu;
+
+    SECTION("Light scene stays at full resolution") {
+        gpu.full_res_ms = 8.0f;
+        TraceResult trace = run(controller, gpu, 300);
+        CHECK(controller.get_scale() == settings.max_scale);
+        CHECK(controller.get_stats().changes == 0);
+    }
+
+    SECTION("Overload clamps to the minimum and recovers") {
+        gpu.full_res_ms = 100.0f;
+        run(controller, gpu, 300);
+        CHECK(controller.get_scale() == Catch::Approx(settings.min_scale));
+
+        // Hundreds of frames at the bound must not delay the way back
+        gpu.full_res_ms = 8.0f;
+        TraceResult trace = run(controller, gpu, 200);
+        uint32_t recovered = 0;
+        while (recovered < trace.scales.size() && trace.scales[recovered] != settings.max_scale) recovered++;
+        CHECK(recovered < 60);
+        CHECK(changes(trace.scales, recovered) == 0);
+    }
+
+    SECTION("A load step is absorbed within the slew limit") {
+        run(controller, gpu, 300);
+        float before = controller.get_scale();
+        gpu.full_res_ms = 40.0f;
+        TraceResult trace = run(controller, gpu, 400);
+        for (size_t i = 1; i < trace.scales.size(); ++i) {
+            CHECK(std::abs(trace.scales[i] - trace.scales[i - 1]) <= settings.max_step + settings.quantum);
+        }
+        float expected = std::sqrt((settings.target_ms - gpu.fixed_ms) / gpu.full_res_ms);
+        CHECK(controller.get_scale() < before);
+        CHECK(mean(trace.scales, 200) == Catch::Approx(expected).margin(0.05f));
+        CHECK(changes(trace.scales, 200) == 0);
+    }
+}
+
+TEST_CASE("Dynamic resolution render extents and settings", "[dynamic_resolution]") {
+    DynamicResolutionController controller;
+    Extent2D full = {1280, 720};
+
+    // Disabled: full size whatever the timings say
+    CHECK(controller.update(100.0f) == 1.0f);
+    CHECK(controller.get_render_extent(full) == full);
+
+    DynamicResolutionSettings settings;
+    settings.min_scale = 0.5f;
+    settings.max_scale = 0.8f;
+    controller.set_settings(settings);
+    controller.set_enabled(true);
+    CHECK(controller.get_scale() == Catch::Approx(0.8f));
+    Extent2D extent = controller.get_render_extent(full);
+    CHECK(extent.width == 1024);
+    CHECK(extent.height == 576);
+
+    // Timings that are not available yet leave the scale alone
+    CHECK(controller.update(0.0f) == Catch::Approx(0.8f));
+    CHECK(controller.get_stats().frames == 0);
+
+    SyntheticFrames gpu;
+    gpu.full_res_ms = 200.0f;
+    run(controller, gpu, 200);
+    CHECK(controller.get_render_extent(full).width == 640);
+    CHECK(controller.get_render_extent(full).height == 360);
+
+    // Invalid bounds are clamped into (0, 1]
+    settings.min_scale = 2.0f;
+    settings.max_scale = 3.0f;
+    controller.set_settings(settings);
+    CHECK(controller.get_settings().min_scale == 1.0f);
+    CHECK(controller.get_settings().max_scale == 1.0f);
+
+    controller.set_enabled(false);
+    CHECK(controller.get_render_extent(full) == full);
+}
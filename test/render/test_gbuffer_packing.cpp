@@ -0,0 +1,127 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include "engine/core/math/math.h"
+#include "engine/core/log/Log.h"
+#include "engine/function/render/render_system/gbuffer_packing.h"
+#include "engine/function/render/render_system/temporal_aa.h"
+#include "engine/function/render/render_pass/g_buffer_pass.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+/**
+ * @file test/render/test_gbuffer_packing.cpp
+ * @brief Compacted G-buffer tests: octahedral normal and material round trips at storage precision, world position from depth, memory per resolution. No GPU required.
+ */
+
+DEFINE_LOG_TAG(LogGBufferPackingTest, "GBufferPackingTest");
+
+namespace {
+
+// Normals spread evenly over the sphere, plus the axes and the octahedron's folds
+std::vector<Vec3> make_normals() {
+    std::vector<Vec3> normals = {
+        Vec3::UnitX(), -Vec3::UnitX(), Vec3::UnitY(), -Vec3::UnitY(), Vec3::UnitZ(), -Vec3::UnitZ(),
+        Vec3(1.0f, 1.0f, 0.0f).normalized(), Vec3(-1.0f, 1.0f, 0.0f).normalized(),
+        Vec3(1.0f, -1.0f, -1e-6f).normalized(), Vec3(1.0f, 1.0f, -1.0f).normalized(),
+        Vec3(-1.0f, -1.0f, -1.0f).normalized(), Vec3(0.0f, 1.0f, -1.0f).normalized()};
+    constexpr uint32_t COUNT = 20000;
+    const float golden_angle = PI * (3.0f - std::sqrt(5.0f));
+    for (uint32_t i = 0; i < COUNT; ++i) {
+        float z = 1.0f - 2.0f * (static_cast<float>(i) + 0.5f) / static_cast<float>(COUNT);
+        float radius = std::sqrt(1.0f - z * z);
+        float phi = golden_angle * static_cast<float>(i);
+        normals.push_back(Vec3(radius * std::cos(phi), radius * std::sin(phi), z));
+    }
+    return normals;
+}
+
+float angle_degrees(const Vec3& a, const Vec3& b) {
+    // atan2 keeps its precision for tiny angles, where acos of a dot product close to 1 does not
+    return Math::to_angle(std::atan2(a.cross(b).length(), a.dot(b)));
+}
+
+} // namespace
+
+TEST_CASE("Octahedral normals round trip at snorm16 precision", "[gbuffer]") {
+    float max_error = 0.0f;
+    float max_error_unquantized = 0.0f;
+    for (const Vec3& normal : make_normals()) {
+        Vec2 encoded = GBufferPacking::encode_octahedral(normal);
+        CHECK(encoded.x >= -1.0f);
+        CHECK(encoded.x <= 1.0f);
+        CHECK(encoded.y >= -1.0f);
+        CHECK(encoded.y <= 1.0f);
+
+        Vec3 exact = GBufferPacking::decode_octahedral(encoded);
+        max_error_unquantized = (std::max)(max_error_unquantized, angle_degrees(normal, exact));
+
+        Vec2 stored(GBufferPacking::quantize_snorm16(encoded.x), GBufferPacking::quantize_snorm16(encoded.y));
+        Vec3 decoded = GBufferPacking::decode_octahedral(stored);
+        CHECK(decoded.length() == Catch::Approx(1.0f).margin(1e-5f));
+        max_error = (std::max)(max_error, angle_degrees(normal, decoded));
+    }
+    CHECK(max_error_unquantized < 1e-3f);
+    // The previous RGB8 normals were off by a few tenths of a degree
+    CHECK(max_error < 0.01f);
+    INFO(LogGBufferPackingTest, "Octahedral snorm16 max error {:.5f} deg (unquantized {:.5f} deg)",
+         max_error, max_error_unquantized);
+}
+
+TEST_CASE("Material parameters round trip at unorm8 precision", "[gbuffer]") {
+    for (uint32_t i = 0; i <= 1000; ++i) {
+        float value = static_cast<float>(i) / 1000.0f;
+        CHECK(std::abs(GBufferPacking::quantize_unorm8(value) - value) <= 0.5f / 255.0f + 1e-6f);
+    }
+    CHECK(GBufferPacking::quantize_unorm8(0.0f) == 0.0f);
+    CHECK(GBufferPacking::quantize_unorm8(1.0f) == 1.0f);
+    CHECK(GBufferPacking::quantize_unorm8(-0.5f) == 0.0f);
+    CHECK(GBufferPacking::quantize_unorm8(4.0f) == 1.0f);
+    CHECK(GBufferPacking::quantize_snorm16(-2.0f) == -1.0f);
+    CHECK(GBufferPacking::quantize_snorm16(0.0f) == 0.0f);
+}
+
+TEST_CASE("World position is reconstructed from depth", "[gbuffer]") {
+    Vec3 eye(2.0f, 1.5f, -6.0f);
+    Mat4 view = Math::look_at(eye, Vec3(0.0f, 0.5f, 4.0f), Vec3::UnitY());
+    Mat4 projection = Math::perspective(Math::to_radians(60.0f), 16.0f / 9.0f, 0.1f, 1000.0f);
+    // The G-buffer rasterizes with the temporal AA jitter; the inverse must use the same matrix
+    Mat4 jittered = TemporalAA::jitter_projection(projection, Vec2(0.3f, -0.2f), {1280, 720});
+    Vec3 points[] = {Vec3(0.0f, 0.5f, 4.0f), Vec3(-3.0f, 2.0f, 10.0f), Vec3(5.0f, -1.0f, 40.0f),
+                     Vec3(1.0f, 1.0f, 200.0f), Vec3(2.1f, 1.4f, -5.5f)};
+
+    for (const Mat4& proj : {projection, jittered}) {
+        Mat4 view_projection = view * proj;
+        Mat4 inv_view_projection = view_projection.inverse();
+        for (const Vec3& point : points) {
+            Vec4 clip = Vec4(point.x, point.y, point.z, 1.0f) * view_projection;
+            float depth = clip.z / clip.w;
+            Vec2 uv = TemporalAA::project_to_uv(point, view_projection);
+            Vec3 position = GBufferPacking::reconstruct_position(uv, depth, inv_view_projection);
+            float distance = (point - eye).length();
+            CHECK((position - point).length() < 1e-4f * distance * distance + 1e-4f);
+        }
+    }
+}
+
+TEST_CASE("Compacted layout halves the G-buffer memory", "[gbuffer]") {
+    // Previous layout: AlbedoAO, NormalRoughness and Material in RGBA8, Position in RGBA32F, velocity in RG16F
+    const uint32_t legacy_bytes = 3 * format_pixel_size(FORMAT_R8G8B8A8_UNORM) +
+                                  format_pixel_size(FORMAT_R32G32B32A32_SFLOAT) +
+                                  format_pixel_size(FORMAT_R16G16_SFLOAT);
+    const uint32_t compact_bytes = render::GBufferPass::get_bytes_per_pixel();
+    CHECK(legacy_bytes == 32);
+    CHECK(compact_bytes == 16);
+    CHECK(render::GBufferData::COUNT == 4);
+
+    constexpr Extent2D RESOLUTIONS[] = {{1280, 720}, {1920, 1080}, {2560, 1440}, {3840, 2160}};
+    for (const Extent2D& extent : RESOLUTIONS) {
+        uint64_t pixels = static_cast<uint64_t>(extent.width) * extent.height;
+        double legacy_mb = static_cast<double>(pixels * legacy_bytes) / (1024.0 * 1024.0);
+        double compact_mb = static_cast<double>(pixels * compact_bytes) / (1024.0 * 1024.0);
+        CHECK(compact_mb < legacy_mb);
+        INFO(LogGBufferPackingTest, "{}x{}: {:.1f} MB -> {:.1f} MB, {:.1f} MB saved per frame",
+             extent.width, extent.height, legacy_mb, compact_mb, legacy_mb - compact_mb);
+    }
+}
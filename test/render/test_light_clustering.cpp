@@ -0,0 +1,228 @@
+#include <catch2/catch_test_macros.hpp>
+#include "test/test_utils.h"
+#include "engine/main/engine_context.h"
+#include "engine/core/os/thread_pool.h"
+#include "engine/core/math/math.h"
+#include "engine/core/utils/timer.h"
+#include "engine/core/log/Log.h"
+#include "engine/function/render/render_system/light_clustering.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+/**
+ * @file test/render/test_light_clustering.cpp
+ * @brief Clustered light assignment tests: SIMD build against a scalar reference, shader-side lookup, cost. No GPU required.
+ */
+
+DEFINE_LOG_TAG(LogLightClusterTest, "LightClusterTest");
+
+namespace {
+
+constexpr float NEAR_PLANE = 0.1f;
+constexpr float FAR_PLANE = 200.0f;
+const Vec3 CAMERA_EYE(0.0f, 5.0f, -20.0f);
+const Vec3 CAMERA_TARGET(0.0f, 0.0f, 30.0f);
+
+using test_utils::TestCamera;
+
+render::ShaderLightData make_point_light(const Vec3& position, float range) {
+    render::ShaderLightData light = {};
+    light.position = position;
+    light.color = Vec3(1.0f, 1.0f, 1.0f);
+    light.intensity = 1.0f;
+    light.range = range;
+    light.type = static_cast<uint32_t>(render::LightType::Point);
+    return light;
+}
+
+// Point lights scattered in a box in front of the camera, some of them behind it or out of view
+std::vector<render::ShaderLightData> make_random_lights(uint32_t count, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> xz(-100.0f, 100.0f);
+    std::uniform_real_distribution<float> height(-5.0f, 20.0f);
+    std::uniform_real_distribution<float> range(0.5f, 8.0f);
+
+    std::vector<render::ShaderLightData> lights;
+    for (uint32_t i = 0; i < count; ++i) {
+        lights.push_back(make_point_light(Vec3(xz(rng), height(rng), xz(rng) + 80.0f), range(rng)));
+    }
+    return lights;
+}
+
+Vec3 to_view(const Mat4& view, const Vec3& p) {
+    return Vec3(p.x * view.m[0][0] + p.y * view.m[1][0] + p.z * view.m[2][0] + view.m[3][0],
+                p.x * view.m[0][1] + p.y * view.m[1][1] + p.z * view.m[2][1] + view.m[3][1],
+                p.x * view.m[0][2] + p.y * view.m[1][2] + p.z * view.m[2][2] + view.m[3][2]);
+}
+
+std::vector<uint32_t> cluster_lights(const LightClusterBuilder& builder, uint32_t cluster) {
+    const LightClusterRange& range = builder.get_ranges()[cluster];
+    std::vector<uint32_t> result;
+    for (uint32_t i = 0; i < range.count; ++i) result.push_back(builder.get_indices()[range.offset + i].light_id);
+    return result;
+}
+
+} // namespace
+
+TEST_CASE("Light clusters match the scalar reference", "[light_cluster]") {
+    TestCamera camera = test_utils::make_camera(CAMERA_EYE, CAMERA_TARGET, NEAR_PLANE, FAR_PLANE);
+    std::vector<render::ShaderLightData> lights = make_random_lights(3000, 3);
+
+    LightClusterBuilder builder;
+    builder.build(camera.view, camera.projection, NEAR_PLANE, FAR_PLANE, lights);
+    REQUIRE(builder.get_ranges().size() == LightClusterBuilder::CLUSTER_COUNT);
+
+    // Brute force: every light against every cluster box
+    std::vector<Vec3> view_positions;
+    for (const auto& light : lights) view_positions.push_back(to_view(camera.view, light.position));
+
+    uint32_t reference_total = 0;
+    bool all_match = true;
+    for (uint32_t z = 0; z < LightClusterBuilder::GRID_Z; ++z) {
+        for (uint32_t y = 0; y < LightClusterBuilder::GRID_Y; ++y) {
+            for (uint32_t x = 0; x < LightClusterBuilder::GRID_X; ++x) {
+                BoundingBox box = builder.get_cluster_bounds(x, y, z);
+                std::vector<uint32_t> expected;
+                for (uint32_t i = 0; i < lights.size(); ++i) {
+                    if (LightClusterBuilder::sphere_intersects_box(view_positions[i], lights[i].range, box)) expected.push_back(i);
+                }
+                reference_total += static_cast<uint32_t>(expected.size());
+                if (cluster_lights(builder, LightClusterBuilder::cluster_index(x, y, z)) != expected) all_match = false;
+            }
+        }
+    }
+    CHECK(all_match);
+    CHECK(builder.get_last_stats().index_count == reference_total);
+    CHECK(builder.get_last_stats().occupied_clusters > 0);
+
+    SECTION("Thread pool gives the same lists") {
+        REQUIRE(EngineContext::thread_pool() != nullptr);
+        LightClusterBuilder threaded;
+        threaded.build(camera.view, camera.projection, NEAR_PLANE, FAR_PLANE, lights, EngineContext::thread_pool());
+        CHECK(threaded.get_last_stats().job_count == LightClusterBuilder::GRID_Z);
+        bool same = threaded.get_indices().size() == builder.get_indices().size();
+        for (uint32_t c = 0; same && c < LightClusterBuilder::CLUSTER_COUNT; ++c) {
+            same = cluster_lights(threaded, c) == cluster_lights(builder, c);
+        }
+        CHECK(same);
+    }
+}
+
+TEST_CASE("Light cluster lookup covers every lit point", "[light_cluster]") {
+    TestCamera camera = test_utils::make_camera(CAMERA_EYE, CAMERA_TARGET, NEAR_PLANE, FAR_PLANE);
+    std::vector<render::ShaderLightData> lights = make_random_lights(2000, 8);
+
+    LightClusterBuilder builder;
+    builder.build(camera.view, camera.projection, NEAR_PLANE, FAR_PLANE, lights);
+
+    // Random view-space points inside the frustum, looked up the way the shader does
+    std::mt19937 rng(21);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    std::uniform_real_distribution<float> depth(NEAR_PLANE, FAR_PLANE);
+    float tan_y = 1.0f / camera.projection.m[1][1];
+    float tan_x = 1.0f / camera.projection.m[0][0];
+
+    std::vector<Vec3> view_positions;
+    for (const auto& light : lights) view_positions.push_back(to_view(camera.view, light.position));
+
+    uint32_t lit_points = 0;
+    uint32_t missing = 0;
+    for (int sample = 0; sample < 20000; ++sample) {
+        float z = depth(rng);
+        Vec3 p(unit(rng) * tan_x * z * 0.999f, unit(rng) * tan_y * z * 0.999f, z);
+        uint32_t cx, cy, cz;
+        REQUIRE(builder.find_cluster(p, cx, cy, cz));
+        REQUIRE(builder.get_cluster_bounds(cx, cy, cz).min.z <= p.z * 1.0001f);
+        REQUIRE(builder.get_cluster_bounds(cx, cy, cz).max.z >= p.z * 0.9999f);
+
+        std::vector<uint32_t> listed = cluster_lights(builder, LightClusterBuilder::cluster_index(cx, cy, cz));
+        for (uint32_t i = 0; i < lights.size(); ++i) {
+            if ((view_positions[i] - p).length() > lights[i].range) continue;
+            lit_points++;
+            if (!std::binary_search(listed.begin(), listed.end(), i)) missing++;
+        }
+    }
+    CHECK(lit_points > 0);
+    CHECK(missing == 0);
+
+    // Points outside the frustum have no cluster
+    uint32_t cx, cy, cz;
+    CHECK_FALSE(builder.find_cluster(Vec3(0.0f, 0.0f, -1.0f), cx, cy, cz));
+    CHECK_FALSE(builder.find_cluster(Vec3(0.0f, 0.0f, FAR_PLANE * 2.0f), cx, cy, cz));
+    CHECK_FALSE(builder.find_cluster(Vec3(tan_x * 20.0f, 0.0f, 10.0f), cx, cy, cz));
+}
+
+TEST_CASE("Light cluster special cases", "[light_cluster]") {
+    TestCamera camera = test_utils::make_camera(CAMERA_EYE, CAMERA_TARGET, NEAR_PLANE, FAR_PLANE);
+    LightClusterBuilder builder;
+
+    std::vector<render::ShaderLightData> lights;
+    render::ShaderLightData sun = {};
+    sun.direction = Vec3(0.0f, -1.0f, 0.0f);
+    sun.intensity = 1.0f;
+    sun.type = static_cast<uint32_t>(render::LightType::Directional);
+    lights.push_back(sun);                                                  // 0: every cluster
+    lights.push_back(make_point_light(Vec3(0.0f, 5.0f, -40.0f), 5.0f));     // 1: behind the camera
+    lights.push_back(make_point_light(Vec3(0.0f, 5.0f, 10.0f), 2.0f));      // 2: in view
+    lights.back().intensity = 0.0f;                                         //    but switched off
+    lights.push_back(make_point_light(Vec3(0.0f, 5.0f, 10.0f), 2.0f));      // 3: in view
+
+    builder.build(camera.view, camera.projection, NEAR_PLANE, FAR_PLANE, lights);
+    const LightClusterStats& stats = builder.get_last_stats();
+    CHECK(stats.global_lights == 1);
+    CHECK(stats.clustered_lights == 1);
+
+    uint32_t with_light_3 = 0;
+    bool sun_everywhere = true;
+    for (uint32_t c = 0; c < LightClusterBuilder::CLUSTER_COUNT; ++c) {
+        std::vector<uint32_t> listed = cluster_lights(builder, c);
+        if (listed.empty() || listed[0] != 0) sun_everywhere = false;
+        for (uint32_t light : listed) {
+            CHECK(light != 1);
+            CHECK(light != 2);
+            if (light == 3) with_light_3++;
+        }
+    }
+    CHECK(sun_everywhere);
+    CHECK(with_light_3 > 0);
+    CHECK(with_light_3 < LightClusterBuilder::CLUSTER_COUNT / 4);
+
+    SECTION("No lights") {
+        builder.build(camera.view, camera.projection, NEAR_PLANE, FAR_PLANE, {});
+        CHECK(builder.get_indices().empty());
+        CHECK(builder.get_last_stats().occupied_clusters == 0);
+    }
+}
+
+TEST_CASE("Light clustering benchmark", "[light_cluster][.benchmark]") {
+    TestCamera camera = test_utils::make_camera(CAMERA_EYE, CAMERA_TARGET, NEAR_PLANE, FAR_PLANE);
+    INFO(LogLightClusterTest, "{} clusters ({}x{}x{}), SIMD width {}", LightClusterBuilder::CLUSTER_COUNT,
+         LightClusterBuilder::GRID_X, LightClusterBuilder::GRID_Y, LightClusterBuilder::GRID_Z,
+         LightClusterBuilder::simd_width());
+
+    for (uint32_t count : {256u, 1024u, 4096u, 16384u}) {
+        std::vector<render::ShaderLightData> lights = make_random_lights(count, count);
+        LightClusterBuilder builder;
+
+        // Warm up once, then average; the second build reuses the slice arrays
+        builder.build(camera.view, camera.projection, NEAR_PLANE, FAR_PLANE, lights, EngineContext::thread_pool());
+        constexpr int RUNS = 5;
+        float serial_ms = 0.0f;
+        float pooled_ms = 0.0f;
+        for (int run = 0; run < RUNS; ++run) {
+            builder.build(camera.view, camera.projection, NEAR_PLANE, FAR_PLANE, lights);
+            serial_ms += builder.get_last_stats().build_ms;
+            builder.build(camera.view, camera.projection, NEAR_PLANE, FAR_PLANE, lights, EngineContext::thread_pool());
+            pooled_ms += builder.get_last_stats().build_ms;
+        }
+
+        const LightClusterStats& stats = builder.get_last_stats();
+        CHECK(stats.clustered_lights <= count);
+        INFO(LogLightClusterTest, "{} lights: {} in view depth, {} indices, max {} per cluster, {} occupied; "
+             "build {:.3f} ms serial, {:.3f} ms pooled",
+             count, stats.clustered_lights, stats.index_count, stats.max_cluster_lights, stats.occupied_clusters,
+             serial_ms / RUNS, pooled_ms / RUNS);
+    }
+}
@@ -0,0 +1,207 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include "test/test_utils.h"
+#include "engine/core/math/math.h"
+#include "engine/core/utils/timer.h"
+#include "engine/core/log/Log.h"
+#include "engine/function/render/render_system/render_light_registry.h"
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+/**
+ * @file test/render/test_light_registry.cpp
+ * @brief Light registry tests: packing, main light selection, revisions. Owners are fake keys, no GPU required.
+ */
+
+DEFINE_LOG_TAG(LogLightRegistryTest, "LightRegistryTest");
+
+namespace {
+
+constexpr auto fake_owner = test_utils::fake_owner<Component>;
+
+RenderLightDesc point_light(const Vec3& position, float range) {
+    RenderLightDesc desc;
+    desc.data.position = position;
+    desc.data.color = Vec3::Ones();
+    desc.data.intensity = 1.0f;
+    desc.data.type = static_cast<uint32_t>(render::LightType::Point);
+    desc.data.range = range;
+    desc.data.falloff = 2.0f;
+    return desc;
+}
+
+RenderLightDesc directional_light(float intensity) {
+    RenderLightDesc desc;
+    desc.data.direction = Vec3(0.0f, -1.0f, 0.0f);
+    desc.data.color = Vec3::Ones();
+    desc.data.intensity = intensity;
+    desc.data.type = static_cast<uint32_t>(render::LightType::Directional);
+    desc.cast_shadow = true;
+    return desc;
+}
+
+// Every packed light belongs to its owner, and every owner but the main light is packed once
+void check_integrity(const RenderLightRegistry& registry) {
+    REQUIRE(registry.get_owners().size() == registry.get_lights().size());
+    REQUIRE(registry.get_light_ids().size() == registry.get_lights().size());
+    REQUIRE(registry.get_shadow_flags().size() == registry.get_lights().size());
+    uint32_t expected = registry.size() - (registry.get_main_light() ? 1 : 0);
+    CHECK(registry.get_lights().size() == expected);
+    for (uint32_t i = 0; i < registry.get_owners().size(); ++i) {
+        CHECK(registry.contains(registry.get_owners()[i]));
+        CHECK(registry.get_owners()[i] != registry.get_main_light_owner());
+    }
+}
+
+} // namespace
+
+TEST_CASE("Light registry packs lights and fills holes on removal", "[light_registry]") {
+    RenderLightRegistry registry;
+    for (uint32_t i = 0; i < 4; ++i) {
+        registry.set_light(fake_owner(i + 1), point_light(Vec3(static_cast<float>(i), 0.0f, 0.0f), 10.0f + i));
+    }
+    REQUIRE(registry.get_lights().size() == 4);
+    CHECK(registry.get_main_light() == nullptr);
+    CHECK(registry.get_lights()[2].range == Catch::Approx(12.0f));
+
+    // The last light moves into the removed slot and keeps its id
+    uint32_t moved_id = registry.get_light_ids()[3];
+    uint64_t revision = registry.get_revision();
+    registry.remove(fake_owner(2));
+    CHECK(registry.get_revision() > revision);
+    REQUIRE(registry.get_lights().size() == 3);
+    CHECK(registry.get_owners()[1] == fake_owner(4));
+    CHECK(registry.get_light_ids()[1] == moved_id);
+    CHECK(registry.get_lights()[1].position.x == Catch::Approx(3.0f));
+    check_integrity(registry);
+
+    // Updating the moved light writes its new slot
+    registry.set_light(fake_owner(4), point_light(Vec3(7.0f, 0.0f, 0.0f), 5.0f));
+    CHECK(registry.get_lights()[1].position.x == Catch::Approx(7.0f));
+    CHECK(registry.get_lights()[1].range == Catch::Approx(5.0f));
+    RenderLightDesc shadowed = point_light(Vec3(7.0f, 0.0f, 0.0f), 5.0f);
+    shadowed.cast_shadow = true;
+    registry.set_light(fake_owner(4), shadowed);
+    CHECK(registry.get_shadow_flags()[1] == 1);
+    CHECK(registry.get_light_ids()[1] == moved_id);
+    CHECK(registry.get_stats().changed == 6);
+    CHECK(registry.get_stats().removed == 1);
+
+    registry.reset_stats();
+    registry.remove(fake_owner(99));    // Not registered: no change
+    CHECK(registry.get_stats().removed == 0);
+    check_integrity(registry);
+}
+
+TEST_CASE("The first registered directional light is the main light", "[light_registry]") {
+    RenderLightRegistry registry;
+    registry.set_light(fake_owner(1), point_light(Vec3::Zero(), 10.0f));
+    registry.set_light(fake_owner(2), directional_light(3.0f));
+    registry.set_light(fake_owner(3), directional_light(0.5f));
+
+    REQUIRE(registry.get_main_light() != nullptr);
+    CHECK(registry.get_main_light_owner() == fake_owner(2));
+    CHECK(registry.get_main_light()->data.intensity == Catch::Approx(3.0f));
+    CHECK(registry.get_stats().directional_count == 2);
+    REQUIRE(registry.get_lights().size() == 2);     // The point light and the second sun
+    check_integrity(registry);
+
+    // Main light edits do not touch the packed array
+    registry.set_light(fake_owner(2), directional_light(4.0f));
+    CHECK(registry.get_main_light()->data.intensity == Catch::Approx(4.0f));
+    CHECK(registry.get_lights().size() == 2);
+
+    // Removing the main light promotes the next directional light out of the packed array
+    registry.remove(fake_owner(2));
+    CHECK(registry.get_main_light_owner() == fake_owner(3));
+    CHECK(registry.get_main_light()->data.intensity == Catch::Approx(0.5f));
+    REQUIRE(registry.get_lights().size() == 1);
+    CHECK(registry.get_lights()[0].type == static_cast<uint32_t>(render::LightType::Point));
+    check_integrity(registry);
+
+    registry.remove(fake_owner(3));
+    CHECK(registry.get_main_light() == nullptr);
+    check_integrity(registry);
+
+    uint64_t revision = registry.get_revision();
+    registry.clear();
+    CHECK(registry.size() == 0);
+    CHECK(registry.get_revision() > revision);
+}
+
+TEST_CASE("Light descriptions compare by value", "[light_registry]") {
+    RenderLightDesc a = point_light(Vec3(1.0f, 2.0f, 3.0f), 25.0f);
+    RenderLightDesc b = a;
+    CHECK(a == b);
+    b.data.falloff = 1.0f;
+    CHECK(a != b);
+    b = a;
+    b.cast_shadow = true;
+    CHECK(a != b);
+}
+
+TEST_CASE("Light registry update benchmark", "[light_registry][.benchmark]") {
+    constexpr uint32_t LIGHT_COUNT = 10000;
+    constexpr uint32_t MOVING_COUNT = LIGHT_COUNT / 100;
+
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<float> coord(-200.0f, 200.0f);
+    std::uniform_real_distribution<float> range(2.0f, 30.0f);
+    std::vector<RenderLightDesc> descs(LIGHT_COUNT);
+    for (auto& desc : descs) desc = point_light(Vec3(coord(rng), coord(rng), coord(rng)), range(rng));
+
+    RenderLightRegistry registry;
+    Timer timer;
+    registry.set_light(fake_owner(LIGHT_COUNT + 1), directional_light(3.0f));
+    for (uint32_t i = 0; i < LIGHT_COUNT; ++i) registry.set_light(fake_owner(i + 1), descs[i]);
+    float register_ms = timer.get_total_ms();
+    REQUIRE(registry.get_lights().size() == LIGHT_COUNT);
+
+    // A frame in which no light changed: every light compares its description, the snapshot keeps its copy
+    std::vector<render::ShaderLightData> snapshot = registry.get_lights();
+    uint64_t snapshot_revision = registry.get_revision();
+    timer.reset();
+    uint32_t pushed = 0;
+    for (uint32_t i = 0; i < LIGHT_COUNT; ++i) {
+        if (descs[i] != point_light(descs[i].data.position, descs[i].data.range)) {
+            registry.set_light(fake_owner(i + 1), descs[i]);
+            pushed++;
+        }
+    }
+    if (registry.get_revision() != snapshot_revision) snapshot = registry.get_lights();
+    float idle_ms = timer.get_total_ms();
+    CHECK(pushed == 0);
+    CHECK(registry.get_revision() == snapshot_revision);
+
+    // A frame in which 1% of the lights moved: only they are pushed, then the array is copied once
+    std::vector<uint32_t> moving(MOVING_COUNT);
+    for (auto& index : moving) {
+        index = static_cast<uint32_t>(rng() % LIGHT_COUNT);
+        descs[index].data.position = Vec3(coord(rng), coord(rng), coord(rng));
+    }
+    timer.reset();
+    for (uint32_t index : moving) registry.set_light(fake_owner(index + 1), descs[index]);
+    if (registry.get_revision() != snapshot_revision) snapshot = registry.get_lights();
+    float moving_ms = timer.get_total_ms();
+    CHECK(registry.get_stats().changed == LIGHT_COUNT + 1 + MOVING_COUNT);
+
+    uint32_t mismatches = 0;
+    for (uint32_t i = 0; i < LIGHT_COUNT; ++i) {
+        if (snapshot[i].position.x != descs[reinterpret_cast<uintptr_t>(registry.get_owners()[i]) / 16 - 1].data.position.x) {
+            mismatches++;
+        }
+    }
+    CHECK(mismatches == 0);
+
+    // What the per-frame rebuild costs: every light written into a fresh array
+    timer.reset();
+    std::vector<render::ShaderLightData> rebuilt;
+    for (const auto& desc : descs) rebuilt.push_back(desc.data);
+    float rebuild_ms = timer.get_total_ms();
+    CHECK(rebuilt.size() == LIGHT_COUNT);
+
+    INFO(LogLightRegistryTest, "{} lights: register {:.3f} ms, idle frame {:.3f} ms, {} moved {:.3f} ms, full rebuild {:.3f} ms",
+         LIGHT_COUNT, register_ms, idle_ms, MOVING_COUNT, moving_ms, rebuild_ms);
+}
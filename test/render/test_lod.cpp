@@ -0,0 +1,198 @@
+#include <catch2/catch_test_macros.hpp>
+#include "test/test_utils.h"
+#include "engine/core/math/math.h"
+#include "engine/core/log/Log.h"
+#include "engine/function/render/render_resource/mesh_lod.h"
+#include "engine/function/render/render_system/lod_selection.h"
+
+#include <cmath>
+#include <vector>
+
+/**
+ * @file test/render/test_lod.cpp
+ * @brief Mesh LOD generation and screen-size selection tests: level building, choice at fixed camera distances, hysteresis, bias. No GPU required.
+ */
+
+DEFINE_LOG_TAG(LogLodTest, "LodTest");
+
+namespace {
+
+using test_utils::TestMesh;
+using test_utils::make_sphere;
+
+// 60 degree vertical field of view
+const float PROJECTION_SCALE = 1.0f / std::tan(Math::to_radians(30.0f));
+
+// Camera distance at which a unit sphere projects to size
+float distance_for_size(float size) {
+    return PROJECTION_SCALE / size;
+}
+
+} // namespace
+
+TEST_CASE("Vertex clustering builds coarser levels", "[lod]") {
+    TestMesh mesh = make_sphere(64, 128);
+    uint32_t full_triangles = static_cast<uint32_t>(mesh.indices.size() / 3);
+
+    std::vector<uint32_t> lod_indices;
+    std::vector<MeshLod> lods;
+    build_mesh_lods(mesh.positions, mesh.indices, mesh.box, mesh.sphere, MAX_MESH_LOD_COUNT, lod_indices, lods);
+
+    REQUIRE(lods.size() >= 3);
+    REQUIRE(lods.size() <= MAX_MESH_LOD_COUNT);
+    CHECK(lods[0].index_offset == 0);
+    CHECK(lods[0].index_count == mesh.indices.size());
+
+    uint32_t offset = static_cast<uint32_t>(mesh.indices.size());
+    for (size_t l = 1; l < lods.size(); ++l) {
+        INFO(LogLodTest, "LOD {}: {} triangles ({:.1f}%), screen size {:.4f}", l, lods[l].index_count / 3,
+             100.0f * lods[l].index_count / 3 / full_triangles, lods[l].screen_size);
+        CHECK(lods[l].index_offset == offset);
+        CHECK(lods[l].index_count % 3 == 0);
+        CHECK(lods[l].index_count > 0);
+        CHECK(lods[l].index_count < lods[l - 1].index_count);
+        CHECK(lods[l].screen_size < lods[l - 1].screen_size);
+        offset += lods[l].index_count;
+    }
+    CHECK(offset == mesh.indices.size() + lod_indices.size());
+
+    // Coarse levels reuse the original vertices, which all lie on the sphere
+    for (uint32_t index : lod_indices) {
+        REQUIRE(index < mesh.positions.size());
+    }
+
+    // No degenerate triangles survive
+    for (size_t i = 0; i < lod_indices.size(); i += 3) {
+        CHECK(lod_indices[i] != lod_indices[i + 1]);
+        CHECK(lod_indices[i + 1] != lod_indices[i + 2]);
+        CHECK(lod_indices[i] != lod_indices[i + 2]);
+    }
+
+    SECTION("Small meshes keep a single level") {
+        TestMesh small = make_sphere(8, 12);
+        REQUIRE(small.indices.size() / 3 < LOD_MIN_TRIANGLES);
+        build_mesh_lods(small.positions, small.indices, small.box, small.sphere, MAX_MESH_LOD_COUNT, lod_indices, lods);
+        CHECK(lods.size() == 1);
+        CHECK(lod_indices.empty());
+    }
+}
+
+TEST_CASE("LOD choice at fixed camera distances", "[lod]") {
+    TestMesh mesh = make_sphere(64, 128);
+    std::vector<uint32_t> lod_indices;
+    std::vector<MeshLod> lods;
+    build_mesh_lods(mesh.positions, mesh.indices, mesh.box, mesh.sphere, MAX_MESH_LOD_COUNT, lod_indices, lods);
+    REQUIRE(lods.size() >= 3);
+    uint32_t last = static_cast<uint32_t>(lods.size() - 1);
+
+    LodSelector selector;
+    BoundingSphere sphere = mesh.sphere;
+    auto select_at = [&](float distance) {
+        uint8_t level = 0;
+        selector.begin_frame(Vec3(0.0f, 0.0f, -distance), PROJECTION_SCALE);
+        uint32_t selected = selector.select(sphere, lods, level);
+        selector.end_frame();
+        CHECK(level == selected);
+        return selected;
+    };
+
+    // Close up and inside the bounds: full detail; far away: coarsest
+    CHECK(select_at(0.5f) == 0);
+    CHECK(select_at(2.0f) == 0);
+    CHECK(select_at(distance_for_size(lods[last].screen_size) * 4.0f) == last);
+
+    // Well inside the band of each level, away from the hysteresis margins
+    for (uint32_t l = 0; l <= last; ++l) {
+        float upper = l == 0 ? lods[1].screen_size * 4.0f : lods[l].screen_size;
+        float lower = l == last ? upper * 0.25f : lods[l + 1].screen_size;
+        float distance = distance_for_size(std::sqrt(upper * lower));
+        INFO(LogLodTest, "Distance {:.1f} -> LOD {}", distance, l);
+        CHECK(select_at(distance) == l);
+    }
+
+    // Moving away never selects a finer level
+    uint32_t previous = 0;
+    for (float distance = 1.5f; distance < distance_for_size(lods[last].screen_size) * 2.0f; distance *= 1.1f) {
+        uint32_t selected = select_at(distance);
+        CHECK(selected >= previous);
+        previous = selected;
+    }
+    CHECK(previous == last);
+
+    const auto& stats = selector.get_last_stats();
+    CHECK(stats.object_count == 1);
+    CHECK(stats.lod_objects[last] == 1);
+    CHECK(stats.triangles == lods[last].index_count / 3);
+    CHECK(stats.full_triangles == lods[0].index_count / 3);
+}
+
+TEST_CASE("LOD hysteresis and bias", "[lod]") {
+    TestMesh mesh = make_sphere(64, 128);
+    std::vector<uint32_t> lod_indices;
+    std::vector<MeshLod> lods;
+    build_mesh_lods(mesh.positions, mesh.indices, mesh.box, mesh.sphere, MAX_MESH_LOD_COUNT, lod_indices, lods);
+    REQUIRE(lods.size() >= 2);
+
+    LodSelector selector;
+    float h = selector.get_hysteresis();
+    REQUIRE(h > 0.0f);
+    float threshold = lods[1].screen_size;
+
+    SECTION("Sizes inside the band keep the current level") {
+        // Just below the threshold: LOD 0 stays, LOD 1 stays
+        CHECK(LodSelector::select_level(lods, threshold * (1.0f - 0.5f * h), 0, h) == 0);
+        CHECK(LodSelector::select_level(lods, threshold * (1.0f + 0.5f * h), 1, h) == 1);
+        // Past the band the level changes
+        CHECK(LodSelector::select_level(lods, threshold * (1.0f - 1.5f * h), 0, h) == 1);
+        CHECK(LodSelector::select_level(lods, threshold * (1.0f + 1.5f * h), 1, h) == 0);
+        // Without hysteresis the threshold alone decides
+        CHECK(LodSelector::select_level(lods, threshold * 0.99f, 0, 0.0f) == 1);
+        CHECK(LodSelector::select_level(lods, threshold * 1.01f, 1, 0.0f) == 0);
+    }
+
+    SECTION("An object oscillating around a threshold does not pop") {
+        uint8_t level = 0;
+        uint32_t switches = 0;
+        for (int frame = 0; frame < 100; ++frame) {
+            float size = threshold * (frame % 2 ? 1.0f - 0.5f * h : 1.0f + 0.5f * h);
+            selector.begin_frame(Vec3(0.0f, 0.0f, -distance_for_size(size)), PROJECTION_SCALE);
+            selector.select(mesh.sphere, lods, level);
+            selector.end_frame();
+            switches += selector.get_last_stats().switches;
+        }
+        CHECK(level == 0);
+        CHECK(switches == 0);
+
+        // Once it moves out of the band it switches once and stays
+        for (int frame = 0; frame < 10; ++frame) {
+            selector.begin_frame(Vec3(0.0f, 0.0f, -distance_for_size(threshold * (1.0f - 2.0f * h))), PROJECTION_SCALE);
+            selector.select(mesh.sphere, lods, level);
+            selector.end_frame();
+            switches += selector.get_last_stats().switches;
+        }
+        CHECK(level == 1);
+        CHECK(switches == 1);
+    }
+
+    SECTION("A positive bias selects coarser levels") {
+        float distance = distance_for_size(threshold * 1.5f);
+        uint8_t level = 0;
+        selector.begin_frame(Vec3(0.0f, 0.0f, -distance), PROJECTION_SCALE);
+        CHECK(selector.select(mesh.sphere, lods, level) == 0);
+        selector.end_frame();
+        uint64_t full_detail = selector.get_last_stats().triangles;
+
+        selector.set_bias(1.0f);    // Sizes halved
+        selector.begin_frame(Vec3(0.0f, 0.0f, -distance), PROJECTION_SCALE);
+        CHECK(selector.select(mesh.sphere, lods, level) >= 1);
+        selector.end_frame();
+        CHECK(selector.get_last_stats().triangles < full_detail);
+        CHECK(selector.get_last_stats().switches == 1);
+
+        selector.set_bias(-4.0f);
+        level = static_cast<uint8_t>(lods.size() - 1);
+        selector.begin_frame(Vec3(0.0f, 0.0f, -distance), PROJECTION_SCALE);
+        CHECK(selector.select(mesh.sphere, lods, level) == 0);
+        selector.end_frame();
+    }
+}
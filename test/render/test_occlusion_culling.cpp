@@ -0,0 +1,300 @@
+#include <catch2/catch_test_macros.hpp>
+#include "test/test_utils.h"
+#include "engine/main/engine_context.h"
+#include "engine/core/os/thread_pool.h"
+#include "engine/core/math/math.h"
+#include "engine/core/log/Log.h"
+#include "engine/function/render/render_system/occlusion_culling.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+/**
+ * @file test/render/test_occlusion_culling.cpp
+ * @brief Software occlusion culling tests: rasterizer against a per-pixel reference, HiZ visibility, cost. No GPU required.
+ */
+
+DEFINE_LOG_TAG(LogOcclusionTest, "OcclusionTest");
+
+namespace {
+
+constexpr float NEAR_PLANE = 0.1f;
+constexpr float FAR_PLANE = 500.0f;
+
+using test_utils::TestCamera;
+using test_utils::TestMesh;
+
+OccluderMesh to_occluder(const TestMesh& mesh, const Mat4& world = Mat4::Identity()) {
+    OccluderMesh occluder;
+    occluder.positions = mesh.positions.data();
+    occluder.vertex_count = static_cast<uint32_t>(mesh.positions.size());
+    occluder.indices = mesh.indices.data();
+    occluder.index_count = static_cast<uint32_t>(mesh.indices.size());
+    occluder.world = world;
+    return occluder;
+}
+
+TestMesh make_box(const Vec3& lo, const Vec3& hi) {
+    TestMesh mesh;
+    for (uint32_t corner = 0; corner < 8; ++corner) {
+        mesh.positions.push_back(Vec3((corner & 1) ? hi.x : lo.x, (corner & 2) ? hi.y : lo.y, (corner & 4) ? hi.z : lo.z));
+    }
+    // Two triangles per face, mixed winding on purpose
+    mesh.indices = { 0, 1, 3, 0, 3, 2,  4, 6, 7, 4, 7, 5,  0, 4, 5, 0, 5, 1,
+                     2, 3, 7, 2, 7, 6,  0, 2, 6, 0, 6, 4,  1, 5, 7, 1, 7, 3 };
+    return mesh;
+}
+
+// Wall in the z = depth plane, subdivided into cells x cells quads
+TestMesh make_wall(float half_width, float half_height, float depth, uint32_t cells) {
+    TestMesh mesh;
+    for (uint32_t y = 0; y <= cells; ++y) {
+        for (uint32_t x = 0; x <= cells; ++x) {
+            mesh.positions.push_back(Vec3(-half_width + 2.0f * half_width * x / cells,
+                                          -half_height + 2.0f * half_height * y / cells, depth));
+        }
+    }
+    for (uint32_t y = 0; y < cells; ++y) {
+        for (uint32_t x = 0; x < cells; ++x) {
+            uint32_t i = y * (cells + 1) + x;
+            mesh.indices.insert(mesh.indices.end(), { i, i + 1, i + cells + 2, i, i + cells + 2, i + cells + 1 });
+        }
+    }
+    return mesh;
+}
+
+Mat4 make_view_proj(const Vec3& eye, const Vec3& target) {
+    TestCamera camera = test_utils::make_camera(eye, target, NEAR_PLANE, FAR_PLANE);
+    return camera.view * camera.projection;
+}
+
+Vec4 to_clip(const Vec3& p, const Mat4& m) {
+    return Vec4(p.x * m.m[0][0] + p.y * m.m[1][0] + p.z * m.m[2][0] + m.m[3][0],
+                p.x * m.m[0][1] + p.y * m.m[1][1] + p.z * m.m[2][1] + m.m[3][1],
+                p.x * m.m[0][2] + p.y * m.m[1][2] + p.z * m.m[2][2] + m.m[3][2],
+                p.x * m.m[0][3] + p.y * m.m[1][3] + p.z * m.m[2][3] + m.m[3][3]);
+}
+
+BoundingBox box_at(const Vec3& center, float half) {
+    return BoundingBox{center - Vec3(half, half, half), center + Vec3(half, half, half)};
+}
+
+} // namespace
+
+TEST_CASE("Occlusion rasterizer matches a per-pixel reference", "[occlusion]") {
+    Mat4 view_proj = make_view_proj(Vec3(0.0f, 0.0f, 0.0f), Vec3(0.0f, 0.0f, 1.0f));
+
+    // A tilted triangle, so depth varies across it; it is in front of the camera everywhere
+    TestMesh mesh;
+    mesh.positions = { Vec3(-8.0f, -5.0f, 12.0f), Vec3(9.0f, -3.0f, 30.0f), Vec3(-2.0f, 7.0f, 20.0f) };
+    mesh.indices = { 0, 1, 2 };
+
+    OcclusionCuller culler;
+    culler.render_occluders(view_proj, { to_occluder(mesh) });
+    CHECK(culler.get_last_stats().occluder_triangles == 1);
+    CHECK(culler.get_last_stats().rasterized_triangles == 1);
+
+    // Reference: barycentrics at every pixel center, perspective-correct depth from the clip vertices
+    Vec3 screen[3];
+    for (int i = 0; i < 3; ++i) {
+        Vec4 clip = to_clip(mesh.positions[i], view_proj);
+        screen[i] = Vec3((clip.x / clip.w * 0.5f + 0.5f) * OcclusionCuller::WIDTH,
+                         (0.5f - clip.y / clip.w * 0.5f) * OcclusionCuller::HEIGHT, clip.z / clip.w);
+    }
+    float area = (screen[1].x - screen[0].x) * (screen[2].y - screen[0].y) - (screen[2].x - screen[0].x) * (screen[1].y - screen[0].y);
+
+    uint32_t inside = 0, outside = 0, depth_errors = 0, coverage_errors = 0;
+    for (uint32_t y = 0; y < OcclusionCuller::HEIGHT; ++y) {
+        for (uint32_t x = 0; x < OcclusionCuller::WIDTH; ++x) {
+            float px = x + 0.5f, py = y + 0.5f;
+            float w0 = ((screen[1].x - px) * (screen[2].y - py) - (screen[2].x - px) * (screen[1].y - py)) / area;
+            float w1 = ((screen[2].x - px) * (screen[0].y - py) - (screen[0].x - px) * (screen[2].y - py)) / area;
+            float w2 = 1.0f - w0 - w1;
+            float depth = culler.get_depth(x, y);
+            if (w0 > 1e-3f && w1 > 1e-3f && w2 > 1e-3f) {
+                inside++;
+                float expected = w0 * screen[0].z + w1 * screen[1].z + w2 * screen[2].z;
+                // Stored depth is the farthest value within the pixel: never nearer than the center
+                if (depth < expected - 1e-6f || depth > expected + 1e-3f) depth_errors++;
+            } else if (w0 < -1e-3f || w1 < -1e-3f || w2 < -1e-3f) {
+                outside++;
+                if (depth != 1.0f) coverage_errors++;
+            }
+        }
+    }
+    CHECK(inside > 500);
+    CHECK(outside > 500);
+    CHECK(depth_errors == 0);
+    CHECK(coverage_errors == 0);
+}
+
+TEST_CASE("Occlusion culling hides objects behind a wall", "[occlusion]") {
+    Mat4 view_proj = make_view_proj(Vec3(0.0f, 0.0f, 0.0f), Vec3(0.0f, 0.0f, 1.0f));
+    TestMesh wall = make_box(Vec3(-10.0f, -10.0f, 20.0f), Vec3(10.0f, 10.0f, 21.0f));
+
+    OcclusionCuller culler;
+    culler.render_occluders(view_proj, { to_occluder(wall) });
+
+    CHECK_FALSE(culler.is_visible(box_at(Vec3(0.0f, 0.0f, 40.0f), 1.0f)));    // Right behind
+    CHECK_FALSE(culler.is_visible(box_at(Vec3(6.0f, -5.0f, 80.0f), 4.0f)));   // Far behind, large
+    CHECK(culler.is_visible(box_at(Vec3(0.0f, 0.0f, 10.0f), 1.0f)));          // In front
+    CHECK(culler.is_visible(box_at(Vec3(25.0f, 0.0f, 40.0f), 1.0f)));         // Beside it
+    CHECK(culler.is_visible(box_at(Vec3(20.0f, 0.0f, 40.0f), 1.0f)));         // Peeking past the edge
+    CHECK(culler.is_visible(box_at(Vec3(0.0f, 0.0f, 0.0f), 1.0f)));           // Crosses the near plane
+    CHECK(culler.is_visible(BoundingBox{Vec3(-10.0f, -10.0f, 20.0f), Vec3(10.0f, 10.0f, 21.0f)}));  // The wall itself
+    CHECK(culler.is_visible(box_at(Vec3(0.0f, 0.0f, -30.0f), 1.0f)));         // Behind the camera is left to frustum culling
+
+    // A mixed list keeps the order of the survivors
+    CullingBounds bounds;
+    std::vector<Vec3> centers = { Vec3(0.0f, 0.0f, 40.0f), Vec3(0.0f, 0.0f, 10.0f), Vec3(3.0f, 3.0f, 60.0f), Vec3(25.0f, 0.0f, 40.0f) };
+    for (const Vec3& c : centers) bounds.add(BoundingSphere{c, 1.8f}, box_at(c, 1.0f));
+    std::vector<uint32_t> indices = { 0, 1, 2, 3 };
+    culler.cull(bounds, indices);
+    CHECK(indices == std::vector<uint32_t>{ 1, 3 });
+    CHECK(culler.get_last_stats().tested == 4);
+    CHECK(culler.get_last_stats().occluded == 2);
+
+    SECTION("Occluders are clipped at the near plane") {
+        // A floor passing under and behind the camera still hides what is below it
+        TestMesh floor = make_wall(50.0f, 50.0f, 0.0f, 1);
+        Mat4 rotate = Mat4::Identity();
+        rotate.set_row(1, Vec4(0.0f, 0.0f, 1.0f, 0.0f));
+        rotate.set_row(2, Vec4(0.0f, -1.0f, 0.0f, 0.0f));
+        rotate.set_row(3, Vec4(0.0f, -2.0f, 0.0f, 1.0f));  // Floor at y = -2, spanning z in [-50, 50]
+        Mat4 look_down = make_view_proj(Vec3(0.0f, 0.0f, 0.0f), Vec3(0.0f, -1.0f, 1.0f));
+        culler.render_occluders(look_down, { to_occluder(floor, rotate) });
+        CHECK(culler.get_last_stats().rasterized_triangles > 0);
+        CHECK_FALSE(culler.is_visible(box_at(Vec3(0.0f, -6.0f, 6.0f), 1.0f)));
+        CHECK(culler.is_visible(box_at(Vec3(0.0f, 0.0f, 6.0f), 1.0f)));
+    }
+
+    SECTION("No occluders, nothing culled") {
+        culler.render_occluders(view_proj, {});
+        std::vector<uint32_t> all = { 0, 1, 2, 3 };
+        culler.cull(bounds, all);
+        CHECK(all.size() == 4);
+        CHECK(culler.get_last_stats().occluded == 0);
+    }
+}
+
+TEST_CASE("Occlusion culling is deterministic across threads", "[occlusion]") {
+    Mat4 view_proj = make_view_proj(Vec3(0.0f, 8.0f, -10.0f), Vec3(0.0f, 0.0f, 60.0f));
+
+    // A city block: buildings on a grid, objects scattered between and behind them
+    std::mt19937 rng(9);
+    std::uniform_real_distribution<float> jitter(-2.0f, 2.0f);
+    std::uniform_real_distribution<float> height(6.0f, 30.0f);
+    std::vector<TestMesh> buildings;
+    for (int z = 0; z < 6; ++z) {
+        for (int x = -3; x <= 3; ++x) {
+            Vec3 base(x * 14.0f + jitter(rng), 0.0f, 20.0f + z * 18.0f + jitter(rng));
+            buildings.push_back(make_box(base - Vec3(5.0f, 0.0f, 5.0f), base + Vec3(5.0f, height(rng), 5.0f)));
+        }
+    }
+    std::vector<OccluderMesh> occluders;
+    for (const TestMesh& building : buildings) occluders.push_back(to_occluder(building));
+
+    CullingBounds bounds;
+    std::uniform_real_distribution<float> xz(-60.0f, 60.0f);
+    std::uniform_real_distribution<float> y(0.5f, 10.0f);
+    for (int i = 0; i < 5000; ++i) {
+        Vec3 c(xz(rng), y(rng), xz(rng) + 90.0f);
+        bounds.add(BoundingSphere{c, 0.9f}, box_at(c, 0.5f));
+    }
+    std::vector<uint32_t> all(bounds.size());
+    for (uint32_t i = 0; i < all.size(); ++i) all[i] = i;
+
+    OcclusionCuller serial;
+    serial.render_occluders(view_proj, occluders);
+    std::vector<uint32_t> serial_visible = all;
+    serial.cull(bounds, serial_visible);
+
+    REQUIRE(EngineContext::thread_pool() != nullptr);
+    OcclusionCuller threaded;
+    threaded.render_occluders(view_proj, occluders, EngineContext::thread_pool());
+    std::vector<uint32_t> threaded_visible = all;
+    threaded.cull(bounds, threaded_visible, EngineContext::thread_pool());
+
+    CHECK(threaded.get_depth_buffer() == serial.get_depth_buffer());
+    CHECK(threaded_visible == serial_visible);
+    CHECK(threaded.get_last_stats().job_count > serial.get_last_stats().job_count);
+    CHECK(serial.get_last_stats().occluded > 0);
+    CHECK(serial.get_last_stats().occluded < bounds.size());
+
+    // Scalar per-object test agrees with the chunked cull
+    std::vector<uint32_t> expected;
+    for (uint32_t i : all) {
+        if (serial.is_visible(bounds.get_box(i))) expected.push_back(i);
+    }
+    CHECK(serial_visible == expected);
+
+    // Nothing nearer than every occluder is ever culled
+    float nearest_occluder = 1.0f;
+    for (float d : serial.get_depth_buffer()) nearest_occluder = (std::min)(nearest_occluder, d);
+    uint32_t wrongly_culled = 0;
+    for (uint32_t i : all) {
+        if (std::binary_search(serial_visible.begin(), serial_visible.end(), i)) continue;
+        BoundingBox box = bounds.get_box(i);
+        float nearest = 1.0f;
+        for (uint32_t corner = 0; corner < 8; ++corner) {
+            Vec4 clip = to_clip(Vec3((corner & 1) ? box.max.x : box.min.x, (corner & 2) ? box.max.y : box.min.y,
+                                     (corner & 4) ? box.max.z : box.min.z), view_proj);
+            nearest = (std::min)(nearest, clip.z / clip.w);
+        }
+        if (nearest < nearest_occluder) wrongly_culled++;
+    }
+    CHECK(wrongly_culled == 0);
+}
+
+TEST_CASE("Occlusion culling benchmark", "[occlusion][.benchmark]") {
+    Mat4 view_proj = make_view_proj(Vec3(0.0f, 2.0f, -5.0f), Vec3(0.0f, 2.0f, 60.0f));
+
+    // 32 occluders of 2048 triangles (walls along a street), 16k small objects
+    std::vector<TestMesh> walls;
+    std::vector<OccluderMesh> occluders;
+    for (int i = 0; i < 32; ++i) {
+        walls.push_back(make_wall(6.0f, 8.0f, 0.0f, 32));
+    }
+    for (int i = 0; i < 32; ++i) {
+        Mat4 world = Mat4::Identity();
+        world.set_row(3, Vec4((i % 8 - 3.5f) * 12.0f, 6.0f, 15.0f + (i / 8) * 25.0f, 1.0f));
+        occluders.push_back(to_occluder(walls[i], world));
+    }
+
+    std::mt19937 rng(17);
+    std::uniform_real_distribution<float> x(-60.0f, 60.0f);
+    std::uniform_real_distribution<float> y(0.0f, 12.0f);
+    std::uniform_real_distribution<float> z(5.0f, 150.0f);
+    CullingBounds bounds;
+    for (int i = 0; i < 16384; ++i) {
+        Vec3 c(x(rng), y(rng), z(rng));
+        bounds.add(BoundingSphere{c, 0.9f}, box_at(c, 0.5f));
+    }
+    std::vector<uint32_t> all(bounds.size());
+    for (uint32_t i = 0; i < all.size(); ++i) all[i] = i;
+
+    INFO(LogOcclusionTest, "{}x{} depth buffer, {}-wide SIMD, {} occluders, {} objects",
+         OcclusionCuller::WIDTH, OcclusionCuller::HEIGHT, OcclusionCuller::simd_width(), occluders.size(), all.size());
+
+    constexpr int RUNS = 10;
+    for (ThreadPool* pool : { static_cast<ThreadPool*>(nullptr), EngineContext::thread_pool() }) {
+        OcclusionCuller culler;
+        float raster_ms = 0.0f;
+        float test_ms = 0.0f;
+        std::vector<uint32_t> visible;
+        for (int run = 0; run < RUNS; ++run) {
+            culler.render_occluders(view_proj, occluders, pool);
+            visible = all;
+            culler.cull(bounds, visible, pool);
+            raster_ms += culler.get_last_stats().raster_ms;
+            test_ms += culler.get_last_stats().test_ms;
+        }
+        const OcclusionCullingStats& stats = culler.get_last_stats();
+        CHECK(stats.occluded > 0);
+        INFO(LogOcclusionTest, "{}: {} / {} triangles rasterized, {} of {} occluded ({:.1f}%), "
+             "raster {:.3f} ms, test {:.3f} ms",
+             pool ? "pooled" : "serial", stats.rasterized_triangles, stats.occluder_triangles,
+             stats.occluded, stats.tested, 100.0f * stats.occluded / stats.tested, raster_ms / RUNS, test_ms / RUNS);
+    }
+}
@@ -0,0 +1,292 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include "test/test_utils.h"
+#include "engine/core/math/math.h"
+#include "engine/core/utils/timer.h"
+#include "engine/core/log/Log.h"
+#include "engine/function/render/render_system/render_proxy_scene.h"
+#include "engine/function/render/render_system/frustum_culling.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+/**
+ * @file test/render/test_render_proxy.cpp
+ * @brief Persistent render proxy tests. Owners are fake keys and never dereferenced, no GPU required.
+ */
+
+DEFINE_LOG_TAG(LogRenderProxyTest, "RenderProxyTest");
+
+namespace {
+
+using test_utils::translation;
+constexpr auto fake_owner = test_utils::fake_owner<MeshRendererComponent>;
+
+RenderProxyDesc make_desc(uint32_t object_id) {
+    RenderProxyDesc desc;
+    desc.object_id = object_id;
+    desc.index_count = 36;
+    desc.local_sphere = BoundingSphere{Vec3::Zero(), 1.0f};
+    desc.local_box = BoundingBox{Vec3(-0.5f, -0.5f, -0.5f), Vec3(0.5f, 0.5f, 0.5f)};
+    return desc;
+}
+
+std::vector<RenderProxyDesc> make_descs(uint32_t first_id, uint32_t count) {
+    std::vector<RenderProxyDesc> descs;
+    for (uint32_t i = 0; i < count; ++i) descs.push_back(make_desc(first_id + i));
+    return descs;
+}
+
+// Every proxy must belong to a live owner and carry that owner's bounds
+void check_integrity(const RenderProxyScene& scene) {
+    REQUIRE(scene.get_bounds().size() == scene.size());
+    for (uint32_t i = 0; i < scene.size(); ++i) {
+        render::DrawBatch batch;
+        scene.build_batch(i, batch);
+        BoundingBox owner_box = scene.get_owner_bounds(scene.get_owner(i));
+        CHECK(batch.world_box.min.x >= owner_box.min.x);
+        CHECK(batch.world_box.max.x <= owner_box.max.x);
+        CHECK(batch.world_sphere.center.x == Catch::Approx(batch.model_matrix.m[3][0]));
+    }
+}
+
+} // namespace
+
+TEST_CASE("Render proxies are added, moved and removed", "[render_proxy]") {
+    RenderProxyScene scene;
+    auto* a = fake_owner(1);
+    auto* b = fake_owner(2);
+    auto* c = fake_owner(3);
+
+    scene.set_proxies(a, make_descs(10, 2), translation(Vec3(1.0f, 0.0f, 0.0f)));
+    scene.set_proxies(b, make_descs(20, 1), translation(Vec3(2.0f, 0.0f, 0.0f)));
+    scene.set_proxies(c, make_descs(30, 3), translation(Vec3(3.0f, 0.0f, 0.0f)));
+    const RenderProxyStats& stats = scene.update();
+    CHECK(stats.proxy_count == 6);
+    CHECK(stats.owner_count == 3);
+    CHECK(stats.rebuilt == 3);
+    CHECK(scene.get_changed_owners().size() == 3);
+    check_integrity(scene);
+
+    SECTION("Nothing changed") {
+        scene.update();
+        CHECK(scene.get_stats().rebuilt == 0);
+        CHECK(scene.get_stats().moved == 0);
+        CHECK(scene.get_changed_owners().empty());
+        CHECK(scene.size() == 6);
+    }
+
+    SECTION("Transform moves bounds") {
+        scene.set_transform(b, translation(Vec3(100.0f, 0.0f, 0.0f)));
+        scene.update();
+        CHECK(scene.get_stats().moved == 1);
+        REQUIRE(scene.get_changed_owners().size() == 1);
+        CHECK(scene.get_changed_owners()[0] == b);
+
+        BoundingBox box = scene.get_owner_bounds(b);
+        CHECK(box.min.x == Catch::Approx(99.5f));
+        CHECK(box.max.x == Catch::Approx(100.5f));
+        for (uint32_t i = 0; i < scene.size(); ++i) {
+            if (scene.get_owner(i) != b) continue;
+            render::DrawBatch batch;
+            scene.build_batch(i, batch);
+            CHECK(batch.object_id == 20);
+            CHECK(batch.inv_model_matrix.m[3][0] == Catch::Approx(-100.0f));
+        }
+        check_integrity(scene);
+    }
+
+    SECTION("Removal keeps the remaining proxies intact") {
+        scene.remove(a);
+        scene.update();
+        CHECK(scene.get_stats().removed == 1);
+        REQUIRE(scene.get_removed_owners().size() == 1);
+        CHECK(scene.get_removed_owners()[0] == a);
+        CHECK(scene.size() == 4);
+        CHECK(scene.get_stats().owner_count == 2);
+
+        // The proxies of c were moved into the holes left by a
+        std::vector<uint32_t> ids;
+        for (uint32_t i = 0; i < scene.size(); ++i) {
+            render::DrawBatch batch;
+            scene.build_batch(i, batch);
+            CHECK(batch.object_id != 10);
+            CHECK(batch.object_id != 11);
+            ids.push_back(batch.object_id);
+        }
+        std::sort(ids.begin(), ids.end());
+        CHECK(ids == std::vector<uint32_t>{20, 30, 31, 32});
+        check_integrity(scene);
+
+        scene.set_transform(c, translation(Vec3(-5.0f, 0.0f, 0.0f)));
+        scene.update();
+        CHECK(scene.get_owner_bounds(c).max.x == Catch::Approx(-4.5f));
+        check_integrity(scene);
+    }
+
+    SECTION("Rebuild replaces an owner's proxies") {
+        scene.set_proxies(c, make_descs(40, 1), translation(Vec3(3.0f, 0.0f, 0.0f)));
+        scene.update();
+        CHECK(scene.get_stats().rebuilt == 1);
+        CHECK(scene.size() == 4);
+        check_integrity(scene);
+
+        scene.set_proxies(c, {}, Mat4::Identity());
+        scene.update();
+        CHECK(scene.get_stats().removed == 1);
+        CHECK(scene.size() == 3);
+        check_integrity(scene);
+    }
+}
+
+TEST_CASE("Render proxy changes are coalesced per owner", "[render_proxy]") {
+    RenderProxyScene scene;
+    auto* a = fake_owner(1);
+    auto* b = fake_owner(2);
+
+    SECTION("Latest transform wins") {
+        scene.set_proxies(a, make_descs(1, 1), Mat4::Identity());
+        scene.update();
+        for (int i = 1; i <= 5; ++i) scene.set_transform(a, translation(Vec3(float(i), 0.0f, 0.0f)));
+        scene.update();
+        CHECK(scene.get_stats().moved == 1);
+        CHECK(scene.get_model(0).m[3][0] == Catch::Approx(5.0f));
+    }
+
+    SECTION("Transform after a queued rebuild is applied to the rebuild") {
+        scene.set_proxies(a, make_descs(1, 2), Mat4::Identity());
+        scene.set_transform(a, translation(Vec3(7.0f, 0.0f, 0.0f)));
+        scene.update();
+        CHECK(scene.get_stats().rebuilt == 1);
+        CHECK(scene.get_stats().moved == 0);
+        CHECK(scene.get_owner_bounds(a).min.x == Catch::Approx(6.5f));
+    }
+
+    SECTION("Removal wins over a later transform") {
+        scene.set_proxies(a, make_descs(1, 1), Mat4::Identity());
+        scene.set_proxies(b, make_descs(2, 1), Mat4::Identity());
+        scene.update();
+        scene.remove(a);
+        scene.set_transform(a, translation(Vec3(1.0f, 0.0f, 0.0f)));
+        scene.update();
+        CHECK(scene.size() == 1);
+        CHECK(scene.get_owner(0) == b);
+    }
+
+    SECTION("Re-adding after a removal rebuilds") {
+        scene.set_proxies(a, make_descs(1, 1), Mat4::Identity());
+        scene.update();
+        scene.remove(a);
+        scene.set_proxies(a, make_descs(5, 2), Mat4::Identity());
+        scene.update();
+        CHECK(scene.size() == 2);
+        CHECK(scene.get_stats().rebuilt == 1);
+        CHECK(scene.get_removed_owners().empty());
+    }
+
+    SECTION("Transform of an unknown owner is ignored") {
+        scene.set_transform(a, translation(Vec3(1.0f, 0.0f, 0.0f)));
+        scene.update();
+        CHECK(scene.size() == 0);
+        CHECK(scene.get_changed_owners().empty());
+    }
+}
+
+TEST_CASE("Render proxy incremental update benchmark", "[render_proxy][.benchmark]") {
+    constexpr uint32_t OWNER_COUNT = 100000;
+    constexpr uint32_t MOVING_COUNT = OWNER_COUNT / 100;
+
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> coord(-500.0f, 500.0f);
+    std::vector<Mat4> worlds(OWNER_COUNT);
+    for (auto& world : worlds) world = translation(Vec3(coord(rng), coord(rng), coord(rng)));
+
+    RenderProxyScene scene;
+    for (uint32_t i = 0; i < OWNER_COUNT; ++i) {
+        scene.set_proxies(fake_owner(i + 1), make_descs(i, 1), worlds[i]);
+    }
+    scene.update();
+    REQUIRE(scene.size() == OWNER_COUNT);
+
+    // 1% of the objects move each frame
+    for (uint32_t i = 0; i < MOVING_COUNT; ++i) {
+        uint32_t owner = static_cast<uint32_t>(rng() % OWNER_COUNT);
+        worlds[owner] = translation(Vec3(coord(rng), coord(rng), coord(rng)));
+        scene.set_transform(fake_owner(owner + 1), worlds[owner]);
+    }
+    Timer timer;
+    scene.update();
+    float incremental_ms = timer.get_total_ms();
+    CHECK(scene.get_stats().moved <= MOVING_COUNT);
+
+    // What a full per-frame rebuild costs: inverse and world bounds of every object
+    RenderProxyDesc desc = make_desc(0);
+    CullingBounds bounds;
+    std::vector<Mat4> inv_models(OWNER_COUNT);
+    timer.reset();
+    bounds.reserve(OWNER_COUNT);
+    for (uint32_t i = 0; i < OWNER_COUNT; ++i) {
+        inv_models[i] = worlds[i].inverse();
+        bounds.add(transform_bounding_sphere(desc.local_sphere, worlds[i]),
+                   transform_bounding_box(desc.local_box, worlds[i]));
+    }
+    float full_ms = timer.get_total_ms();
+
+    // Both paths agree on the bounds
+    uint32_t mismatches = 0;
+    for (uint32_t i = 0; i < scene.size(); ++i) {
+        uintptr_t owner = reinterpret_cast<uintptr_t>(scene.get_owner(i)) / 16 - 1;
+        if (scene.get_bounds().center_x[i] != bounds.center_x[owner]) mismatches++;
+    }
+    CHECK(mismatches == 0);
+
+    INFO(LogRenderProxyTest, "{} objects, {} moved: incremental {:.3f} ms, full rebuild {:.3f} ms",
+         OWNER_COUNT, scene.get_stats().moved, incremental_ms, full_ms);
+}
+
+TEST_CASE("Draw batch collection scales linearly with renderers", "[render_proxy][.benchmark]") {
+    constexpr uint32_t COUNTS[] = {100, 1000, 10000, 100000};
+    constexpr uint32_t FRAMES = 5;
+
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<float> coord(-500.0f, 500.0f);
+    float ns_per_renderer[4] = {};
+
+    for (uint32_t c = 0; c < 4; ++c) {
+        uint32_t count = COUNTS[c];
+        RenderProxyScene scene;
+        for (uint32_t i = 0; i < count; ++i) {
+            scene.set_proxies(fake_owner(i + 1), make_descs(i, 1), translation(Vec3(coord(rng), coord(rng), coord(rng))));
+        }
+        scene.update();
+        REQUIRE(scene.size() == count);
+
+        std::vector<uint32_t> indices(count);
+        for (uint32_t i = 0; i < count; ++i) indices[i] = i;
+        std::vector<render::DrawBatch> batches;
+
+        // A frame: 1% of the renderers move, their proxies are updated, every batch is collected once
+        float best_ms = 0.0f;
+        for (uint32_t frame = 0; frame < FRAMES; ++frame) {
+            for (uint32_t i = 0; i < (std::max)(count / 100, 1u); ++i) {
+                uint32_t owner = static_cast<uint32_t>(rng() % count);
+                scene.set_transform(fake_owner(owner + 1), translation(Vec3(coord(rng), coord(rng), coord(rng))));
+            }
+            Timer timer;
+            scene.update();
+            scene.build_batches(indices, batches);
+            float ms = timer.get_total_ms();
+            best_ms = frame == 0 ? ms : (std::min)(best_ms, ms);
+        }
+        REQUIRE(batches.size() == count);
+        CHECK(batches.back().object_id == scene.get_object_id(count - 1));
+
+        ns_per_renderer[c] = best_ms * 1.0e6f / static_cast<float>(count);
+        INFO(LogRenderProxyTest, "{} renderers: collect {:.3f} ms, {:.1f} ns per renderer", count, best_ms, ns_per_renderer[c]);
+    }
+
+    // A lookup per renderer over all renderers would cost 10x more per renderer at every step
+    CHECK(ns_per_renderer[3] < ns_per_renderer[2] * 5.0f);
+}
@@ -0,0 +1,429 @@
+#include <catch2/catch_test_macros.hpp>
+#include "test/test_utils.h"
+#include "engine/function/render/rhi/rhi.h"
+#include "engine/function/render/rhi/rhi_dummy.h"
+#include "engine/function/render/rhi/rhi_command_list.h"
+#include "engine/core/utils/timer.h"
+#include "engine/core/log/Log.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <future>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+/**
+ * @file test/render/test_rhi.cpp
+ * @brief RHI backend tests that run against the null backend (no GPU required).
+ */
+
+DEFINE_LOG_TAG(LogRHITest, "RHITest");
+
+static RHIBufferInfo make_small_buffer_info() {
+    RHIBufferInfo info = {};
+    info.size = 64;
+    info.memory_usage = MEMORY_USAGE_CPU_ONLY;
+    info.type = RESOURCE_TYPE_BUFFER;
+    return info;
+}
+
+TEST_CASE("Concurrent resource registration", "[rhi]") {
+    auto backend = std::make_shared<DummyRHIBackend>(test_utils::make_null_backend_info());
+
+    const uint32_t thread_count = 8;
+    const uint32_t buffers_per_thread = 2000;
+
+    std::vector<std::vector<RHIBufferRef>> created(thread_count);
+    std::vector<std::thread> threads;
+    for (uint32_t t = 0; t < thread_count; ++t) {
+        threads.emplace_back([&, t]() {
+            created[t].reserve(buffers_per_thread);
+            for (uint32_t i = 0; i < buffers_per_thread; ++i) {
+                created[t].push_back(backend->create_buffer(make_small_buffer_info()));
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+
+    REQUIRE(backend->get_registered_resource_count() == thread_count * buffers_per_thread);
+
+    SECTION("Garbage collection still releases unreferenced resources") {
+        created.clear();
+        for (int i = 0; i < 7; ++i) backend->tick();
+        REQUIRE(backend->get_registered_resource_count() == 0);
+    }
+
+    SECTION("Referenced resources survive tick") {
+        for (int i = 0; i < 10; ++i) backend->tick();
+        REQUIRE(backend->get_registered_resource_count() == thread_count * buffers_per_thread);
+    }
+
+    backend->destroy();
+}
+
+TEST_CASE("Upload command is per thread", "[rhi]") {
+    auto backend = std::make_shared<DummyRHIBackend>(test_utils::make_null_backend_info());
+
+    // The null backend has no upload contexts; every thread falls back to the immediate command.
+    auto main_command = backend->get_upload_command();
+    RHICommandContextImmediateRef worker_command;
+    std::thread([&]() { worker_command = backend->get_upload_command(); }).join();
+
+    REQUIRE(main_command == backend->get_immediate_command());
+    REQUIRE(worker_command == backend->get_immediate_command());
+
+    backend->destroy();
+}
+
+TEST_CASE("Timeline semaphore on null backend", "[rhi]") {
+    auto backend = std::make_shared<DummyRHIBackend>(test_utils::make_null_backend_info());
+    auto timeline = backend->create_timeline_semaphore(5);
+    REQUIRE(timeline != nullptr);
+    REQUIRE(timeline->get_completed_value() == 5);
+
+    SECTION("Values are monotonic") {
+        timeline->signal(10);
+        REQUIRE(timeline->get_completed_value() == 10);
+        timeline->signal(7);
+        REQUIRE(timeline->get_completed_value() == 10);
+        REQUIRE(timeline->is_completed(9));
+        REQUIRE_FALSE(timeline->is_completed(11));
+    }
+
+    SECTION("Wait times out on unreached value") {
+        REQUIRE(timeline->wait(5, 0));
+        REQUIRE_FALSE(timeline->wait(6, 10));
+    }
+
+    SECTION("Queue signal completes immediately") {
+        auto queue = backend->get_queue({ QUEUE_TYPE_GRAPHICS, 0 });
+        REQUIRE(queue != nullptr);
+        queue->signal(timeline, 6);
+        REQUIRE(timeline->get_completed_value() == 6);
+    }
+
+    SECTION("Queue wait blocks until another producer signals") {
+        auto queue = backend->get_queue({ QUEUE_TYPE_GRAPHICS, 0 });
+        std::atomic<bool> released = false;
+        std::thread waiter([&]() {
+            queue->wait(timeline, 8);
+            released = true;
+        });
+        timeline->signal(7);
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        CHECK_FALSE(released);
+        timeline->signal(8);
+        waiter.join();
+        REQUIRE(released);
+    }
+
+    SECTION("Multiple producers share one counter") {
+        const uint32_t producer_count = 4;
+        const uint64_t signals_per_producer = 1000;
+        std::atomic<uint64_t> next_value = 6;
+
+        std::vector<std::thread> producers;
+        for (uint32_t p = 0; p < producer_count; ++p) {
+            producers.emplace_back([&]() {
+                for (uint64_t i = 0; i < signals_per_producer; ++i) {
+                    timeline->signal(next_value++);
+                }
+            });
+        }
+
+        uint64_t target = 5 + producer_count * signals_per_producer;
+        REQUIRE(timeline->wait(target, 5000));
+        for (auto& producer : producers) producer.join();
+        REQUIRE(timeline->get_completed_value() == target);
+    }
+
+    backend->destroy();
+}
+
+TEST_CASE("Async readback on null backend", "[rhi]") {
+    auto backend = std::make_shared<DummyRHIBackend>(test_utils::make_null_backend_info());
+    auto pool = backend->create_command_pool({ nullptr });
+    REQUIRE(pool != nullptr);
+
+    RHIBufferInfo buffer_info = {};
+    buffer_info.size = 1024;
+    buffer_info.memory_usage = MEMORY_USAGE_GPU_ONLY;
+    buffer_info.type = RESOURCE_TYPE_BUFFER;
+    auto source = backend->create_buffer(buffer_info);
+    auto* source_data = static_cast<uint8_t*>(source->map());
+    std::iota(source_data, source_data + buffer_info.size, (uint8_t)0);
+    source->unmap();
+
+    for (bool bypass : { true, false }) {
+        DYNAMIC_SECTION("Buffer range, bypass " << bypass) {
+            auto command = pool->create_command_list(bypass);
+            command->begin_command();
+            auto future = command->readback_buffer(source, 16, 100);
+            command->end_command();
+            command->execute();
+
+            REQUIRE(future.wait_for(std::chrono::seconds(0)) == std::future_status::ready);
+            RHIReadbackResult result = future.get();
+            REQUIRE(result.success);
+            REQUIRE(result.data.size() == 100);
+            for (uint32_t i = 0; i < 100; ++i) REQUIRE(result.data[i] == (uint8_t)(16 + i));
+        }
+    }
+
+    SECTION("Texture subresource") {
+        RHITextureInfo texture_info = {};
+        texture_info.format = FORMAT_R8G8B8A8_UNORM;
+        texture_info.extent = { 8, 4, 1 };
+        texture_info.array_layers = 1;
+        texture_info.mip_levels = 2;
+        texture_info.memory_usage = MEMORY_USAGE_GPU_ONLY;
+        texture_info.type = RESOURCE_TYPE_TEXTURE;
+        auto texture = backend->create_texture(texture_info);
+        REQUIRE(texture != nullptr);
+
+        // Upload mip 1 (4x2 RGBA8, staging rows 256-byte aligned) and read it back tightly packed
+        auto command = pool->create_command_list(false);
+        command->begin_command();
+        command->copy_buffer_to_texture(source, 0, texture, { TEXTURE_ASPECT_COLOR, 1, 0, 1 });
+        auto future = command->readback_texture(texture, { TEXTURE_ASPECT_COLOR, 1, 0, 1 });
+        command->end_command();
+        command->execute();
+
+        RHIReadbackResult result = future.get();
+        REQUIRE(result.success);
+        REQUIRE(result.data.size() == 4 * 2 * 4);
+        for (uint32_t i = 0; i < result.data.size(); ++i) {
+            uint32_t row = i / 16, column = i % 16;
+            REQUIRE(result.data[i] == (uint8_t)(row * 256 + column));
+        }
+    }
+
+    SECTION("Readback buffers are recycled") {
+        for (int i = 0; i < 4; ++i) {
+            auto command = pool->create_command_list(true);
+            auto future = command->readback_buffer(source, 0, 300);
+            command->execute();
+            REQUIRE(future.get().success);
+        }
+        // 300 bytes rounds up to one 512-byte bucket that is reused every time
+        REQUIRE(backend->get_readback_pool().get_free_buffer_count() == 1);
+        REQUIRE(backend->get_readback_pool().get_pending_count() == 0);
+    }
+
+    SECTION("Invalid or dropped requests fail instead of hanging") {
+        std::future<RHIReadbackResult> unexecuted;
+        {
+            auto command = pool->create_command_list(true);
+            auto invalid = command->readback_buffer(nullptr, 0, 16);
+            REQUIRE_FALSE(invalid.get().success);
+            unexecuted = command->readback_buffer(source, 0, 16);
+        }
+        REQUIRE(unexecuted.wait_for(std::chrono::seconds(0)) == std::future_status::ready);
+        REQUIRE_FALSE(unexecuted.get().success);
+    }
+
+    backend->destroy();
+}
+
+static RHITextureRef make_upload_texture(RHIBackendRef backend, uint32_t size, uint32_t mip_levels = 1) {
+    RHITextureInfo info = {};
+    info.format = FORMAT_R8G8B8A8_UNORM;
+    info.extent = { size, size, 1 };
+    info.mip_levels = mip_levels;
+    return backend->create_texture(info);
+}
+
+static RHIUploadRequest make_texture_upload(RHITextureRef texture, uint8_t fill) {
+    const auto& info = texture->get_info();
+    RHIUploadRequest request;
+    request.textures.push_back({ texture, {TEXTURE_ASPECT_COLOR, 0, 0, 1},
+                                 std::vector<uint8_t>((size_t)info.extent.width * info.extent.height * 4, fill) });
+    if (info.mip_levels > 1) request.generate_mips.push_back(texture);
+    return request;
+}
+
+TEST_CASE("Upload batcher", "[rhi]") {
+    RHIBackendRef backend = std::make_shared<DummyRHIBackend>(test_utils::make_null_backend_info());
+    auto immediate = std::static_pointer_cast<DummyRHICommandContextImmediate>(backend->get_immediate_command());
+    RHIUploadBatcher& batcher = backend->get_upload_batcher();
+
+    SECTION("Many assets share one submission") {
+        std::vector<RHITextureRef> textures;
+        uint32_t completed = 0;
+        for (uint32_t i = 0; i < 32; ++i) {
+            textures.push_back(make_upload_texture(backend, 30)); // 120-byte rows, padded to 256 in the arena
+            RHIUploadRequest request = make_texture_upload(textures.back(), (uint8_t)i);
+            request.on_complete = [&completed]() { completed++; };
+            batcher.enqueue(std::move(request));
+        }
+        REQUIRE(completed == 0);
+
+        batcher.tick();
+        REQUIRE(completed == 32);
+        REQUIRE(immediate->get_flush_count() == 1);
+        REQUIRE(batcher.get_last_stats().request_count == 32);
+        REQUIRE(batcher.get_pending_count() == 0);
+
+        for (uint32_t i = 0; i < 32; ++i) {
+            auto* texture = static_cast<DummyRHITexture*>(textures[i].get());
+            uint8_t* data = texture->get_data(0, 0);
+            REQUIRE(data[0] == (uint8_t)i);
+            REQUIRE(data[30 * 30 * 4 - 1] == (uint8_t)i);
+        }
+    }
+
+    SECTION("Frame budget limits each tick without splitting a request") {
+        batcher.set_frame_budget(64 * 1024);
+        for (uint32_t i = 0; i < 8; ++i) batcher.enqueue(make_texture_upload(make_upload_texture(backend, 64), 1)); // 16 KB + alignment slack, 3 per tick
+
+        uint32_t ticks = 0;
+        while (batcher.get_pending_count() > 0) {
+            batcher.tick();
+            REQUIRE(batcher.get_last_stats().request_count >= 1);
+            REQUIRE(batcher.get_last_stats().staging_bytes <= batcher.get_frame_budget());
+            ticks++;
+        }
+        REQUIRE(ticks == 3);
+        REQUIRE(immediate->get_flush_count() == 3);
+
+        // A single request larger than the budget still goes through on its own
+        batcher.enqueue(make_texture_upload(make_upload_texture(backend, 256), 1));
+        batcher.tick();
+        REQUIRE(batcher.get_last_stats().request_count == 1);
+        REQUIRE(batcher.get_pending_count() == 0);
+    }
+
+    SECTION("Buffer uploads") {
+        RHIBufferInfo info = {};
+        info.size = 256;
+        info.memory_usage = MEMORY_USAGE_GPU_ONLY;
+        info.type = RESOURCE_TYPE_VERTEX_BUFFER;
+        auto buffer = backend->create_buffer(info);
+
+        RHIUploadRequest request;
+        request.buffers.push_back({ buffer, 64, std::vector<uint8_t>(32, 0xAB) });
+        batcher.enqueue(std::move(request));
+        batcher.flush();
+
+        auto* data = static_cast<uint8_t*>(buffer->map());
+        REQUIRE(data[63] == 0);
+        REQUIRE(data[64] == 0xAB);
+        REQUIRE(data[95] == 0xAB);
+        REQUIRE(data[96] == 0);
+        buffer->unmap();
+    }
+
+    SECTION("Empty tick does not submit") {
+        batcher.tick();
+        REQUIRE(immediate->get_flush_count() == 0);
+    }
+
+    backend->destroy();
+}
+
+TEST_CASE("Resource registration contention benchmark", "[rhi][.benchmark]") {
+    const uint32_t total_buffers = 64000;
+
+    for (uint32_t thread_count : {1u, 2u, 4u, 8u}) {
+        auto backend = std::make_shared<DummyRHIBackend>(test_utils::make_null_backend_info());
+        uint32_t per_thread = total_buffers / thread_count;
+
+        std::vector<std::vector<RHIBufferRef>> created(thread_count);
+        std::vector<std::thread> threads;
+
+        Timer timer;
+        for (uint32_t t = 0; t < thread_count; ++t) {
+            threads.emplace_back([&, t]() {
+                created[t].reserve(per_thread);
+                for (uint32_t i = 0; i < per_thread; ++i) {
+                    created[t].push_back(backend->create_buffer(make_small_buffer_info()));
+                }
+            });
+        }
+        for (auto& thread : threads) thread.join();
+        float create_ms = timer.get_total_ms();
+
+        timer.reset();
+        backend->tick();
+        float tick_ms = timer.get_total_ms();
+
+        INFO(LogRHITest, "{} thread(s): {} buffers created in {:.2f} ms ({:.1f} ns/buffer), tick {:.2f} ms",
+             thread_count, per_thread * thread_count, create_ms,
+             create_ms * 1e6f / (per_thread * thread_count), tick_ms);
+
+        REQUIRE(backend->get_registered_resource_count() == per_thread * thread_count);
+        backend->destroy();
+    }
+}
+
+TEST_CASE("Scene texture upload batching benchmark", "[rhi][.benchmark]") {
+    const uint32_t texture_count = 400;
+    const uint32_t texture_size = 256;
+    const uint32_t mip_levels = 9;
+    std::vector<uint8_t> pixels((size_t)texture_size * texture_size * 4, 0x7F);
+
+    // Before: every texture creates its own staging buffer and flushes the immediate context
+    {
+        RHIBackendRef backend = std::make_shared<DummyRHIBackend>(test_utils::make_null_backend_info());
+        auto immediate = std::static_pointer_cast<DummyRHICommandContextImmediate>(backend->get_immediate_command());
+
+        Timer timer;
+        for (uint32_t i = 0; i < texture_count; ++i) {
+            auto texture = make_upload_texture(backend, texture_size, mip_levels);
+            std::vector<uint8_t> decoded = pixels; // Stands in for the decoder output
+            uint32_t row_pitch = texture_size * 4;
+            uint32_t aligned_row_pitch = texture_upload_row_pitch(FORMAT_R8G8B8A8_UNORM, texture_size);
+
+            RHIBufferInfo staging_info = {};
+            staging_info.size = aligned_row_pitch * texture_size;
+            staging_info.memory_usage = MEMORY_USAGE_CPU_ONLY;
+            staging_info.type = RESOURCE_TYPE_BUFFER;
+            auto staging = backend->create_buffer(staging_info);
+            auto* mapped = static_cast<uint8_t*>(staging->map());
+            for (uint32_t y = 0; y < texture_size; ++y) {
+                memcpy(mapped + y * aligned_row_pitch, decoded.data() + y * row_pitch, row_pitch);
+            }
+            staging->unmap();
+
+            immediate->copy_buffer_to_texture(staging, 0, texture, {TEXTURE_ASPECT_COLOR, 0, 0, 1});
+            immediate->generate_mips(texture);
+            immediate->flush();
+        }
+        float ms = timer.get_total_ms();
+        INFO(LogRHITest, "Per-texture upload: {} textures in {:.2f} ms, {} submissions, {} resources registered",
+             texture_count, ms, immediate->get_flush_count(), backend->get_registered_resource_count());
+        REQUIRE(immediate->get_flush_count() == texture_count);
+        backend->destroy();
+    }
+
+    // After: textures are enqueued and drained by the per-frame batcher
+    {
+        RHIBackendRef backend = std::make_shared<DummyRHIBackend>(test_utils::make_null_backend_info());
+        auto immediate = std::static_pointer_cast<DummyRHICommandContextImmediate>(backend->get_immediate_command());
+        RHIUploadBatcher& batcher = backend->get_upload_batcher();
+
+        Timer timer;
+        for (uint32_t i = 0; i < texture_count; ++i) {
+            auto texture = make_upload_texture(backend, texture_size, mip_levels);
+            std::vector<uint8_t> decoded = pixels;
+            RHIUploadRequest request;
+            request.textures.push_back({ texture, {TEXTURE_ASPECT_COLOR, 0, 0, 1}, std::move(decoded) });
+            request.generate_mips.push_back(texture);
+            batcher.enqueue(std::move(request));
+        }
+        uint32_t frames = 0;
+        while (batcher.get_pending_count() > 0) {
+            batcher.tick();
+            frames++;
+        }
+        float ms = timer.get_total_ms();
+        INFO(LogRHITest, "Batched upload: {} textures in {:.2f} ms, {} submissions over {} frames ({} MB budget), {} resources registered",
+             texture_count, ms, immediate->get_flush_count(), frames,
+             batcher.get_frame_budget() / (1024 * 1024), backend->get_registered_resource_count());
+        REQUIRE(immediate->get_flush_count() == frames);
+        REQUIRE(frames < texture_count);
+        backend->destroy();
+    }
+}
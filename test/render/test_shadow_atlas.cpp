@@ -0,0 +1,291 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include "test/test_utils.h"
+#include "engine/core/math/math.h"
+#include "engine/core/log/Log.h"
+#include "engine/function/render/render_system/shadow_atlas.h"
+#include "engine/function/render/render_system/frustum_culling.h"
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+/**
+ * @file test/render/test_shadow_atlas.cpp
+ * @brief Shadow atlas tests: quadtree allocation, importance-based tile sizes, static tile caching and the update budget. No GPU required.
+ */
+
+DEFINE_LOG_TAG(LogShadowAtlasTest, "ShadowAtlasTest");
+
+namespace {
+
+using test_utils::TestCamera;
+
+ShadowAtlasRequest point_light(uint32_t id, const Vec3& position, float range) {
+    ShadowAtlasRequest request;
+    request.light_id = id;
+    request.light.position = position;
+    request.light.color = Vec3::Ones();
+    request.light.intensity = 1.0f;
+    request.light.type = static_cast<uint32_t>(render::LightType::Point);
+    request.light.range = range;
+    return request;
+}
+
+ShadowAtlasRequest spot_light(uint32_t id, const Vec3& position, const Vec3& direction, float range) {
+    ShadowAtlasRequest request = point_light(id, position, range);
+    request.light.type = static_cast<uint32_t>(render::LightType::Spot);
+    request.light.direction = direction;
+    request.light.inner_angle = std::cos(Math::to_radians(20.0f));
+    request.light.outer_angle = std::cos(Math::to_radians(30.0f));
+    return request;
+}
+
+bool overlaps(const ShadowAtlasTile& a, const ShadowAtlasTile& b) {
+    return a.x < b.x + b.size && b.x < a.x + a.size && a.y < b.y + b.size && b.y < a.y + a.size;
+}
+
+// Every tile lies in the atlas and no two tiles of the placed lights overlap
+void check_tiles(const ShadowAtlas& atlas) {
+    std::vector<ShadowAtlasTile> tiles;
+    for (const ShadowAtlasLight& light : atlas.get_lights()) {
+        for (uint32_t face = 0; face < light.face_count; ++face) tiles.push_back(light.tiles[face]);
+    }
+    uint32_t atlas_size = atlas.get_allocator().get_atlas_size();
+    uint32_t overlapping = 0;
+    for (size_t i = 0; i < tiles.size(); ++i) {
+        REQUIRE(tiles[i].valid());
+        CHECK(tiles[i].x + tiles[i].size <= atlas_size);
+        CHECK(tiles[i].y + tiles[i].size <= atlas_size);
+        for (size_t j = i + 1; j < tiles.size(); ++j) {
+            if (overlaps(tiles[i], tiles[j])) overlapping++;
+        }
+    }
+    CHECK(overlapping == 0);
+    CHECK(atlas.get_allocator().get_tile_count() == tiles.size());
+}
+
+const ShadowAtlasLight* find_light(const ShadowAtlas& atlas, uint32_t id) {
+    for (const ShadowAtlasLight& light : atlas.get_lights()) {
+        if (light.light_id == id) return &light;
+    }
+    return nullptr;
+}
+
+} // namespace
+
+TEST_CASE("Quadtree allocator packs tiles without overlap and merges freed space", "[shadow_atlas]") {
+    ShadowAtlasAllocator allocator;
+    allocator.init(1024, 64);
+    CHECK(allocator.get_largest_free_size() == 1024);
+
+    ShadowAtlasTile tile;
+    CHECK_FALSE(allocator.allocate(100, tile));     // Not a power of two
+    CHECK_FALSE(allocator.allocate(32, tile));      // Below the minimum
+    CHECK_FALSE(allocator.allocate(2048, tile));    // Above the atlas
+
+    // Mixed sizes, a small tile first so the larger ones have to skip its quadrant
+    std::vector<ShadowAtlasTile> tiles;
+    for (uint32_t size : {64u, 512u, 256u, 128u, 64u, 256u, 128u, 512u}) {
+        REQUIRE(allocator.allocate(size, tiles.emplace_back()));
+    }
+    for (size_t i = 0; i < tiles.size(); ++i) {
+        for (size_t j = i + 1; j < tiles.size(); ++j) CHECK_FALSE(overlaps(tiles[i], tiles[j]));
+    }
+    uint64_t texels = 0;
+    for (const auto& t : tiles) texels += static_cast<uint64_t>(t.size) * t.size;
+    CHECK(allocator.get_used_texels() == texels);
+    CHECK(allocator.get_occupancy() == Catch::Approx(static_cast<double>(texels) / (1024.0 * 1024.0)));
+
+    // Fill the remaining space with minimum tiles until the atlas is full
+    uint32_t filled = 0;
+    while (allocator.allocate(64, tile)) filled++;
+    CHECK(allocator.get_occupancy() == Catch::Approx(1.0f));
+    CHECK(allocator.get_largest_free_size() == 0);
+    CHECK(filled == (1024 * 1024 - texels) / (64 * 64));
+
+    // Freeing everything merges the quadtree back into one free atlas
+    allocator.init(1024, 64);
+    tiles.clear();
+    for (uint32_t i = 0; i < 16; ++i) REQUIRE(allocator.allocate(256, tiles.emplace_back()));
+    CHECK_FALSE(allocator.allocate(64, tile));
+    for (const auto& t : tiles) allocator.free(t);
+    CHECK(allocator.get_tile_count() == 0);
+    CHECK(allocator.get_largest_free_size() == 1024);
+    REQUIRE(allocator.allocate(1024, tile));
+    CHECK(tile.x == 0);
+    CHECK(tile.y == 0);
+}
+
+TEST_CASE("Shadow atlas sizes tiles by screen importance", "[shadow_atlas]") {
+    ShadowAtlas atlas;
+    atlas.set_update_budget(64);
+    Vec3 eye = Vec3::Zero();
+    TestCamera camera = test_utils::make_camera(eye, Vec3(0.0f, 0.0f, 100.0f));
+    Frustum frustum = extract_frustum(camera.view * camera.projection);
+
+    std::vector<ShadowAtlasRequest> requests = {
+        point_light(1, Vec3(0.0f, 0.0f, 8.0f), 5.0f),       // Close: large on screen
+        point_light(2, Vec3(0.0f, 0.0f, 200.0f), 5.0f),     // Far: small on screen
+        point_light(3, Vec3(0.0f, 0.0f, -50.0f), 5.0f),     // Behind the camera
+        spot_light(4, Vec3(2.0f, 0.0f, 30.0f), Vec3(0.0f, -1.0f, 0.0f), 10.0f),
+    };
+    atlas.update(requests, frustum, eye, camera.projection.m[1][1]);
+
+    const ShadowAtlasLight* near_light = find_light(atlas, 1);
+    const ShadowAtlasLight* far_light = find_light(atlas, 2);
+    const ShadowAtlasLight* spot = find_light(atlas, 4);
+    REQUIRE(near_light);
+    REQUIRE(far_light);
+    REQUIRE(spot);
+    CHECK(find_light(atlas, 3) == nullptr);
+    CHECK(near_light->face_count == 6);
+    CHECK(spot->face_count == 1);
+    CHECK(near_light->importance > far_light->importance);
+    CHECK(near_light->tiles[0].size > far_light->tiles[0].size);
+    CHECK(near_light->tiles[0].size <= ShadowAtlas::DEFAULT_MAX_TILE_SIZE);
+    CHECK(far_light->tiles[0].size >= ShadowAtlas::DEFAULT_MIN_TILE_SIZE);
+    check_tiles(atlas);
+
+    // UV rects address the face's tile
+    float atlas_size = static_cast<float>(atlas.get_allocator().get_atlas_size());
+    CHECK(spot->uv_rects[0].x == Catch::Approx(spot->tiles[0].size / atlas_size));
+    CHECK(spot->uv_rects[0].z == Catch::Approx(spot->tiles[0].x / atlas_size));
+
+    // A spot face looks down its direction: a point ahead of the light projects to the tile center
+    Vec4 clip = Vec4(2.0f, -5.0f, 30.0f, 1.0f) * spot->view_proj[0];
+    CHECK(clip.x / clip.w == Catch::Approx(0.0f).margin(1e-4f));
+    CHECK(clip.y / clip.w == Catch::Approx(0.0f).margin(1e-4f));
+
+    const ShadowAtlasStats& stats = atlas.get_last_stats();
+    CHECK(stats.request_count == 4);
+    CHECK(stats.visible_count == 3);
+    CHECK(stats.light_count == 3);
+    CHECK(stats.tile_count == 13);
+    CHECK(stats.failed == 0);
+    CHECK(stats.updates == 13);
+    CHECK(stats.occupancy > 0.0f);
+
+    // Walking away shrinks the near light's tiles once it wants a quarter of their size
+    uint32_t near_size = near_light->tiles[0].size;
+    Vec3 far_eye(0.0f, 0.0f, -400.0f);
+    TestCamera far_camera = test_utils::make_camera(far_eye, Vec3(0.0f, 0.0f, 100.0f));
+    Frustum far_frustum = extract_frustum(far_camera.view * far_camera.projection);
+    atlas.update(requests, far_frustum, far_eye, far_camera.projection.m[1][1]);
+    REQUIRE(find_light(atlas, 1));
+    CHECK(find_light(atlas, 1)->tiles[0].size * 4 <= near_size);
+    check_tiles(atlas);
+}
+
+TEST_CASE("Static lights reuse their cached tiles", "[shadow_atlas]") {
+    ShadowAtlas atlas;
+    Vec3 eye(0.0f, 5.0f, -20.0f);
+    TestCamera camera = test_utils::make_camera(eye, Vec3::Zero());
+    Frustum frustum = extract_frustum(camera.view * camera.projection);
+    std::vector<ShadowAtlasRequest> requests;
+    for (uint32_t i = 0; i < 3; ++i) requests.push_back(point_light(i + 1, Vec3(i * 10.0f - 10.0f, 2.0f, 0.0f), 8.0f));
+
+    atlas.update(requests, frustum, eye, camera.projection.m[1][1]);
+    CHECK(atlas.get_last_stats().updates == 18);
+    for (const ShadowAtlasLight& light : atlas.get_lights()) CHECK(light.ready);
+
+    // Nothing changed: every face is reused, color changes do not count
+    requests[0].light.color = Vec3(1.0f, 0.0f, 0.0f);
+    atlas.update(requests, frustum, eye, camera.projection.m[1][1]);
+    CHECK(atlas.get_last_stats().updates == 0);
+    CHECK(atlas.get_last_stats().cached == 18);
+    CHECK(atlas.get_last_stats().allocations == 0);
+
+    // A moved light renders its six faces again, in the same tiles
+    ShadowAtlasTile tile = find_light(atlas, 2)->tiles[0];
+    requests[1].light.position.y += 1.0f;
+    atlas.update(requests, frustum, eye, camera.projection.m[1][1]);
+    CHECK(atlas.get_last_stats().updates == 6);
+    CHECK(atlas.get_updates()[0].light == 1);
+    CHECK(find_light(atlas, 2)->tiles[0].x == tile.x);
+    CHECK(find_light(atlas, 2)->tiles[0].y == tile.y);
+
+    // A caster moving within reach of the first light only invalidates that light
+    atlas.invalidate(BoundingSphere{Vec3(-12.0f, 0.0f, 0.0f), 1.0f});
+    atlas.update(requests, frustum, eye, camera.projection.m[1][1]);
+    CHECK(atlas.get_last_stats().updates == 6);
+    for (const ShadowAtlasUpdate& update : atlas.get_updates()) CHECK(atlas.get_lights()[update.light].light_id == 1);
+
+    // A light that leaves the view gives its tiles back
+    requests.pop_back();
+    atlas.update(requests, frustum, eye, camera.projection.m[1][1]);
+    CHECK(atlas.get_last_stats().tile_count == 12);
+    CHECK(atlas.get_last_stats().updates == 0);
+    check_tiles(atlas);
+}
+
+TEST_CASE("Shadow atlas spreads dirty faces over frames within the budget", "[shadow_atlas]") {
+    constexpr uint32_t LIGHT_COUNT = 40;
+    ShadowAtlas atlas;
+    REQUIRE(atlas.get_update_budget() == ShadowAtlas::DEFAULT_UPDATE_BUDGET);
+    Vec3 eye(0.0f, 20.0f, -60.0f);
+    TestCamera camera = test_utils::make_camera(eye, Vec3::Zero());
+    Frustum frustum = extract_frustum(camera.view * camera.projection);
+
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<float> coord(-30.0f, 30.0f);
+    std::vector<ShadowAtlasRequest> requests;
+    for (uint32_t i = 0; i < LIGHT_COUNT; ++i) requests.push_back(point_light(i + 1, Vec3(coord(rng), 2.0f, coord(rng)), 6.0f));
+
+    uint32_t frames = 0;
+    uint32_t rendered = 0;
+    do {
+        atlas.update(requests, frustum, eye, camera.projection.m[1][1]);
+        CHECK(atlas.get_updates().size() <= atlas.get_update_budget());
+        rendered += atlas.get_last_stats().updates;
+        frames++;
+    } while (atlas.get_last_stats().pending != 0 && frames < 100);
+
+    uint32_t face_count = atlas.get_last_stats().light_count * 6;
+    CHECK(atlas.get_last_stats().failed == 0);
+    CHECK(rendered == face_count);
+    CHECK(frames == (face_count + ShadowAtlas::DEFAULT_UPDATE_BUDGET - 1) / ShadowAtlas::DEFAULT_UPDATE_BUDGET);
+    for (const ShadowAtlasLight& light : atlas.get_lights()) CHECK(light.ready);
+    check_tiles(atlas);
+
+    // The nearest light keeps moving; the others still get their turn
+    uint32_t near = 0;
+    for (uint32_t i = 1; i < LIGHT_COUNT; ++i) {
+        if ((requests[i].light.position - eye).squared_length() < (requests[near].light.position - eye).squared_length()) near = i;
+    }
+    for (uint32_t i = 0; i < LIGHT_COUNT; ++i) {
+        if (i != near) requests[i].light.position.y += 0.5f;
+    }
+    frames = 0;
+    do {
+        requests[near].light.position.y += 0.01f;
+        atlas.update(requests, frustum, eye, camera.projection.m[1][1]);
+        frames++;
+    } while (atlas.get_last_stats().pending != 0 && frames < 100);
+    CHECK(frames < 100);
+    for (const ShadowAtlasLight& light : atlas.get_lights()) CHECK(light.ready);
+
+    INFO(LogShadowAtlasTest, "{} lights: {} tiles, {:.1f}% occupied, {:.3f} ms per update",
+         atlas.get_last_stats().light_count, atlas.get_last_stats().tile_count,
+         atlas.get_last_stats().occupancy * 100.0f, atlas.get_last_stats().update_ms);
+}
+
+TEST_CASE("Shadow atlas falls back to smaller tiles when full", "[shadow_atlas]") {
+    ShadowAtlas atlas;
+    atlas.init(1024, 64, 512);
+    atlas.set_update_budget(1000);
+    Vec3 eye(0.0f, 0.0f, -10.0f);
+    TestCamera camera = test_utils::make_camera(eye, Vec3::Zero());
+    Frustum frustum = extract_frustum(camera.view * camera.projection);
+
+    // Every light fills the screen and wants 512 tiles, but six of them need the whole atlas
+    std::vector<ShadowAtlasRequest> requests;
+    for (uint32_t i = 0; i < 5; ++i) requests.push_back(point_light(i + 1, Vec3(i * 0.5f, 0.0f, 0.0f), 20.0f));
+    atlas.update(requests, frustum, eye, camera.projection.m[1][1]);
+
+    const ShadowAtlasStats& stats = atlas.get_last_stats();
+    CHECK(stats.light_count + stats.failed == 5);
+    CHECK(stats.light_count >= 4);
+    CHECK(stats.occupancy <= 1.0f);
+    check_tiles(atlas);
+}
@@ -0,0 +1,216 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include "test/test_utils.h"
+#include "engine/core/math/math.h"
+#include "engine/core/log/Log.h"
+#include "engine/function/render/render_system/shadow_cascades.h"
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+/**
+ * @file test/render/test_shadow_cascades.cpp
+ * @brief Cascaded shadow map tests: practical splits, slice fitting, texel snapping and per-cascade caster culling. No GPU required.
+ */
+
+DEFINE_LOG_TAG(LogShadowCascadeTest, "ShadowCascadeTest");
+
+namespace {
+
+constexpr float NEAR_PLANE = 0.1f;
+constexpr float FAR_PLANE = 1000.0f;
+
+using test_utils::TestCamera;
+
+Vec3 project(const Vec3& point, const Mat4& view_proj) {
+    Vec4 clip = Vec4(point.x, point.y, point.z, 1.0f) * view_proj;
+    return clip.xyz() / clip.w;
+}
+
+// Point at view depth along the camera ray through an NDC corner
+Vec3 slice_corner(const TestCamera& camera, float x, float y, float depth) {
+    Mat4 inv_view = camera.view.inverse();
+    float tan_y = 1.0f / camera.projection.m[1][1];
+    float tan_x = 1.0f / camera.projection.m[0][0];
+    Vec4 local(x * tan_x * depth, y * tan_y * depth, depth, 1.0f);
+    return (local * inv_view).xyz();
+}
+
+} // namespace
+
+TEST_CASE("Practical cascade splits", "[shadow]") {
+    constexpr uint32_t COUNT = DIRECTIONAL_SHADOW_CASCADE_LEVEL;
+    float splits[COUNT + 1];
+
+    SECTION("Uniform") {
+        ShadowCascadeBuilder::compute_splits(1.0f, 101.0f, 0.0f, COUNT, splits);
+        for (uint32_t i = 0; i <= COUNT; ++i) CHECK(splits[i] == Catch::Approx(1.0f + 100.0f * i / COUNT));
+    }
+
+    SECTION("Logarithmic") {
+        ShadowCascadeBuilder::compute_splits(1.0f, 256.0f, 1.0f, COUNT, splits);
+        for (uint32_t i = 0; i < COUNT; ++i) CHECK(splits[i + 1] / splits[i] == Catch::Approx(4.0f));
+    }
+
+    SECTION("Blend is increasing and covers the range") {
+        ShadowCascadeBuilder::compute_splits(NEAR_PLANE, 150.0f, ShadowCascadeBuilder::DEFAULT_SPLIT_LAMBDA, COUNT, splits);
+        CHECK(splits[0] == NEAR_PLANE);
+        CHECK(splits[COUNT] == 150.0f);
+        for (uint32_t i = 0; i < COUNT; ++i) CHECK(splits[i + 1] > splits[i]);
+
+        // Between the two schemes
+        float logarithmic[COUNT + 1], uniform[COUNT + 1];
+        ShadowCascadeBuilder::compute_splits(NEAR_PLANE, 150.0f, 1.0f, COUNT, logarithmic);
+        ShadowCascadeBuilder::compute_splits(NEAR_PLANE, 150.0f, 0.0f, COUNT, uniform);
+        for (uint32_t i = 1; i < COUNT; ++i) {
+            CHECK(splits[i] >= logarithmic[i]);
+            CHECK(splits[i] <= uniform[i]);
+        }
+        INFO(LogShadowCascadeTest, "Splits (lambda {}): {:.2f} {:.2f} {:.2f} {:.2f} {:.2f}",
+             ShadowCascadeBuilder::DEFAULT_SPLIT_LAMBDA, splits[0], splits[1], splits[2], splits[3], splits[4]);
+    }
+}
+
+TEST_CASE("Cascades contain their frustum slice", "[shadow]") {
+    TestCamera camera = test_utils::make_camera(Vec3(3.0f, 5.0f, -20.0f), Vec3(10.0f, 0.0f, 40.0f), NEAR_PLANE, FAR_PLANE);
+    Vec3 light_dir = Vec3(0.3f, -1.0f, 0.5f).normalized();
+
+    ShadowCascadeBuilder builder;
+    builder.update(camera.view, camera.projection, NEAR_PLANE, FAR_PLANE, light_dir, ShadowCascadeBuilder::DEFAULT_SPLIT_LAMBDA);
+
+    float previous_far = NEAR_PLANE;
+    for (uint32_t c = 0; c < builder.get_cascade_count(); ++c) {
+        const ShadowCascade& cascade = builder.get_cascade(c);
+        CHECK(cascade.split_near == Catch::Approx(previous_far));
+        previous_far = cascade.split_far;
+
+        for (float depth : {cascade.split_near, cascade.split_far}) {
+            for (float y : {-1.0f, 1.0f}) {
+                for (float x : {-1.0f, 1.0f}) {
+                    Vec3 ndc = project(slice_corner(camera, x, y, depth), cascade.view_proj);
+                    CHECK(std::abs(ndc.x) <= 1.0f);
+                    CHECK(std::abs(ndc.y) <= 1.0f);
+                    CHECK(ndc.z >= 0.0f);
+                    CHECK(ndc.z <= 1.0f);
+                }
+            }
+        }
+
+        // The light looks down the shadow view's +z
+        Vec3 view_dir = Vec3(cascade.view.m[0][2], cascade.view.m[1][2], cascade.view.m[2][2]);
+        CHECK(view_dir.dot(light_dir) == Catch::Approx(1.0f));
+        INFO(LogShadowCascadeTest, "Cascade {}: {:.2f}..{:.2f} m, radius {:.2f}, texel {:.4f} m",
+             c, cascade.split_near, cascade.split_far, cascade.sphere.radius, cascade.texel_size);
+    }
+    CHECK(previous_far == Catch::Approx(ShadowCascadeBuilder::DEFAULT_MAX_DISTANCE));
+}
+
+TEST_CASE("Cascade texel snapping", "[shadow]") {
+    Vec3 light_dir = Vec3(-0.4f, -1.0f, 0.2f).normalized();
+    Vec3 probe(12.3f, 0.7f, 25.1f);     // A fixed point in the world
+
+    // Move and turn the camera by sub-texel amounts: the cascade size and the position of the probe
+    // inside its texel must not change
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<float> jitter(-0.37f, 0.37f);
+    ShadowCascadeBuilder builder;
+    float radius[DIRECTIONAL_SHADOW_CASCADE_LEVEL] = {};
+    Vec2 fraction[DIRECTIONAL_SHADOW_CASCADE_LEVEL];
+    for (int frame = 0; frame < 16; ++frame) {
+        Vec3 eye(jitter(rng), 2.0f + jitter(rng), jitter(rng));
+        Vec3 target = eye + Vec3(jitter(rng), 0.0f, 10.0f);
+        TestCamera camera = test_utils::make_camera(eye, target, NEAR_PLANE, FAR_PLANE);
+        builder.update(camera.view, camera.projection, NEAR_PLANE, FAR_PLANE, light_dir, ShadowCascadeBuilder::DEFAULT_SPLIT_LAMBDA);
+
+        for (uint32_t c = 0; c < builder.get_cascade_count(); ++c) {
+            const ShadowCascade& cascade = builder.get_cascade(c);
+            float half = 0.5f * builder.get_resolution();
+            Vec3 ndc = project(probe, cascade.view_proj);
+            Vec2 texel(ndc.x * half, ndc.y * half);
+            Vec2 frac(texel.x - std::floor(texel.x), texel.y - std::floor(texel.y));
+            if (frame == 0) {
+                radius[c] = cascade.sphere.radius;
+                fraction[c] = frac;
+                continue;
+            }
+            CHECK(cascade.sphere.radius == radius[c]);
+            CHECK(std::abs(frac.x - fraction[c].x) < 1e-2f);
+            CHECK(std::abs(frac.y - fraction[c].y) < 1e-2f);
+        }
+    }
+}
+
+TEST_CASE("Per-cascade caster culling", "[shadow]") {
+    TestCamera camera = test_utils::make_camera(Vec3(0.0f, 2.0f, 0.0f), Vec3(0.0f, 2.0f, 10.0f), NEAR_PLANE, FAR_PLANE);
+    Vec3 light_dir = Vec3(0.0f, -1.0f, 0.0f);   // Straight down
+
+    ShadowCascadeBuilder builder;
+    builder.update(camera.view, camera.projection, NEAR_PLANE, FAR_PLANE, light_dir, ShadowCascadeBuilder::DEFAULT_SPLIT_LAMBDA);
+    const ShadowCascade& first = builder.get_cascade(0);
+    float first_far = first.split_far;
+
+    CullingBounds bounds;
+    auto add = [&](const Vec3& center, float radius) {
+        Vec3 extent(radius, radius, radius);
+        bounds.add(BoundingSphere{center, radius}, BoundingBox{center - extent, center + extent});
+    };
+    add(Vec3(0.0f, 2.0f, first_far * 0.5f), 0.2f);            // 0: inside the first slice
+    add(Vec3(0.0f, 500.0f, first_far * 0.5f), 0.2f);          // 1: far above it, between the light and the slice
+    add(Vec3(0.0f, -500.0f, first_far * 0.5f), 0.2f);         // 2: far below, behind the slice from the light
+    add(Vec3(300.0f, 2.0f, first_far * 0.5f), 0.2f);          // 3: to the side of every cascade
+    add(Vec3(0.0f, 2.0f, 100.0f), 1.0f);                      // 4: in the last slice only
+    add(Vec3(0.0f, 2.0f, first_far * 0.5f), 0.2f);            // 5: like 0, material does not cast
+    std::vector<uint8_t> casts_shadow = {1, 1, 1, 1, 1, 0};
+
+    builder.cull_casters(bounds, casts_shadow);
+
+    const auto& casters = builder.get_casters(0);
+    CHECK(casters == std::vector<uint32_t>{0, 1});
+
+    const auto& last = builder.get_casters(DIRECTIONAL_SHADOW_CASCADE_LEVEL - 1);
+    CHECK(std::find(last.begin(), last.end(), 4u) != last.end());
+    CHECK(std::find(last.begin(), last.end(), 3u) == last.end());
+
+    // The depth range reaches back to the caster above the slice
+    const ShadowCascade& fitted = builder.get_cascade(0);
+    Vec3 ndc = project(Vec3(0.0f, 500.0f - 0.2f, first_far * 0.5f), fitted.view_proj);
+    CHECK(ndc.z >= -1e-4f);
+    CHECK(ndc.z <= 1.0f);
+
+    const ShadowCascadeStats& stats = builder.get_last_stats();
+    CHECK(stats.object_count == 6);
+    CHECK(stats.non_casters == 1);
+    CHECK(stats.casters[0] == 2);
+    uint32_t total = 0;
+    for (uint32_t c = 0; c < DIRECTIONAL_SHADOW_CASCADE_LEVEL; ++c) total += stats.casters[c];
+    CHECK(stats.caster_total == total);
+}
+
+TEST_CASE("Caster culling benchmark", "[shadow][.benchmark]") {
+    constexpr uint32_t OBJECT_COUNT = 100000;
+
+    TestCamera camera = test_utils::make_camera(Vec3(0.0f, 10.0f, 0.0f), Vec3(50.0f, 0.0f, 100.0f), NEAR_PLANE, FAR_PLANE);
+    Vec3 light_dir = Vec3(0.5f, -1.0f, 0.3f).normalized();
+
+    std::mt19937 rng(21);
+    std::uniform_real_distribution<float> coord(-1000.0f, 1000.0f);
+    std::uniform_real_distribution<float> height(0.0f, 30.0f);
+    CullingBounds bounds;
+    for (uint32_t i = 0; i < OBJECT_COUNT; ++i) {
+        Vec3 center(coord(rng), height(rng), coord(rng));
+        bounds.add(BoundingSphere{center, 1.0f}, BoundingBox{center - Vec3(1.0f, 1.0f, 1.0f), center + Vec3(1.0f, 1.0f, 1.0f)});
+    }
+
+    ShadowCascadeBuilder builder;
+    for (int frame = 0; frame < 2; ++frame) {
+        builder.update(camera.view, camera.projection, NEAR_PLANE, FAR_PLANE, light_dir, ShadowCascadeBuilder::DEFAULT_SPLIT_LAMBDA);
+        builder.cull_casters(bounds, {});
+    }
+
+    const ShadowCascadeStats& stats = builder.get_last_stats();
+    CHECK(stats.caster_total < DIRECTIONAL_SHADOW_CASCADE_LEVEL * OBJECT_COUNT);
+    INFO(LogShadowCascadeTest, "{} objects: casters per cascade {} / {} / {} / {} ({} draws instead of {}), {:.3f} ms",
+         OBJECT_COUNT, stats.casters[0], stats.casters[1], stats.casters[2], stats.casters[3],
+         stats.caster_total, DIRECTIONAL_SHADOW_CASCADE_LEVEL * OBJECT_COUNT, stats.update_ms);
+}
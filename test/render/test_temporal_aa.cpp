@@ -0,0 +1,195 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include "test/test_utils.h"
+#include "engine/core/math/math.h"
+#include "engine/core/log/Log.h"
+#include "engine/function/render/render_system/temporal_aa.h"
+
+#include <cmath>
+#include <vector>
+
+/**
+ * @file test/render/test_temporal_aa.cpp
+ * @brief Temporal AA tests: Halton jitter sequence, jittered projections, motion vector reprojection, neighbourhood clipping and convergence. No GPU required.
+ */
+
+DEFINE_LOG_TAG(LogTemporalAATest, "TemporalAATest");
+
+namespace {
+
+using test_utils::TestCamera;
+
+constexpr Extent2D RENDER_EXTENT = {800, 450};
+
+Vec2 to_pixels(Vec2 uv, Extent2D extent) {
+    return Vec2(uv.x * static_cast<float>(extent.width), uv.y * static_cast<float>(extent.height));
+}
+
+} // namespace
+
+TEST_CASE("Halton jitter covers the pixel evenly", "[temporal_aa]") {
+    CHECK(TemporalAA::halton(1, 2) == Catch::Approx(0.5f));
+    CHECK(TemporalAA::halton(2, 2) == Catch::Approx(0.25f));
+    CHECK(TemporalAA::halton(3, 2) == Catch::Approx(0.75f));
+    CHECK(TemporalAA::halton(1, 3) == Catch::Approx(1.0f / 3.0f));
+    CHECK(TemporalAA::halton(2, 3) == Catch::Approx(2.0f / 3.0f));
+    CHECK(TemporalAA::halton(3, 3) == Catch::Approx(1.0f / 9.0f));
+
+    constexpr uint32_t PHASES = 8;
+    Vec2 sum = Vec2::Zero();
+    std::vector<Vec2> offsets;
+    for (uint32_t frame = 0; frame < PHASES; ++frame) {
+        Vec2 offset = TemporalAA::jitter_offset(frame, PHASES);
+        CHECK(offset.x >= -0.5f);
+        CHECK(offset.x < 0.5f);
+        CHECK(offset.y >= -0.5f);
+        CHECK(offset.y < 0.5f);
+        for (const Vec2& other : offsets) CHECK((offset - other).length() > 0.1f);
+        offsets.push_back(offset);
+        sum += offset;
+    }
+    // Centered on the pixel: no net shift of the image over a cycle
+    CHECK(std::abs(sum.x / PHASES) < 0.07f);
+    CHECK(std::abs(sum.y / PHASES) < 0.07f);
+
+    // The cycle repeats
+    Vec2 repeated = TemporalAA::jitter_offset(PHASES + 3, PHASES);
+    CHECK(repeated.x == offsets[3].x);
+    CHECK(repeated.y == offsets[3].y);
+}
+
+TEST_CASE("Jittered projections move the image by the jitter", "[temporal_aa]") {
+    TestCamera camera = test_utils::make_camera(Vec3::Zero(), Vec3::UnitZ());
+    Mat4 view = camera.view;
+    Mat4 off_center = camera.projection;
+    off_center.m[2][0] = 0.2f;      // Shifted frustum, as for a tile or a stereo eye
+    Mat4 projections[] = {camera.projection, off_center, Math::ortho(-8.0f, 8.0f, -4.5f, 4.5f, 0.1f, 100.0f)};
+    Vec3 points[] = {Vec3(0.0f, 0.0f, 10.0f), Vec3(3.0f, -1.5f, 20.0f), Vec3(-2.0f, 1.0f, 5.0f)};
+    Vec2 jitter(0.25f, -0.375f);
+
+    for (const Mat4& projection : projections) {
+        Mat4 jittered = TemporalAA::jitter_projection(projection, jitter, RENDER_EXTENT);
+        for (const Vec3& point : points) {
+            Vec2 before = to_pixels(TemporalAA::project_to_uv(point, view * projection), RENDER_EXTENT);
+            Vec2 after = to_pixels(TemporalAA::project_to_uv(point, view * jittered), RENDER_EXTENT);
+            CHECK(after.x - before.x == Catch::Approx(jitter.x).margin(1e-3f));
+            CHECK(after.y - before.y == Catch::Approx(jitter.y).margin(1e-3f));
+        }
+    }
+}
+
+TEST_CASE("Motion vectors reproject to the previous frame without jitter", "[temporal_aa]") {
+    TemporalAA taa;
+    taa.set_enabled(true);
+    TestCamera origin = test_utils::make_camera(Vec3::Zero(), Vec3::UnitZ());
+    Mat4 projection = origin.projection;
+    Extent2D output = {1600, 900};
+
+    const TemporalAAView& first = taa.begin_frame(origin.view, projection, RENDER_EXTENT, output);
+    CHECK_FALSE(first.history_valid);
+    Mat4 first_view_projection = first.view_projection;
+
+    // Camera moves right, one object moves up
+    Vec3 eye(0.5f, 0.0f, 0.0f);
+    Mat4 view = test_utils::make_camera(eye, eye + Vec3::UnitZ()).view;
+    const TemporalAAView& second = taa.begin_frame(view, projection, RENDER_EXTENT, output);
+    REQUIRE(second.history_valid);
+    CHECK(second.prev_view_projection == first_view_projection);
+    CHECK(second.jitter_pixels.length() > 0.0f);
+
+    Vec3 still(1.0f, 0.5f, 12.0f);
+    Vec2 uv = TemporalAA::project_to_uv(still, second.view_projection);
+    Vec2 motion = TemporalAA::velocity(still, still, second.view_projection, second.prev_view_projection);
+    Vec2 history_uv = uv - motion;
+    Vec2 expected = TemporalAA::project_to_uv(still, first_view_projection);
+    CHECK(history_uv.x == Catch::Approx(expected.x).margin(1e-5f));
+    CHECK(history_uv.y == Catch::Approx(expected.y).margin(1e-5f));
+    CHECK(motion.x < 0.0f);         // The camera moved right, the scene moves left
+
+    Vec3 prev_position(-1.0f, 0.0f, 8.0f);
+    Vec3 position = prev_position + Vec3(0.0f, 0.25f, 0.0f);
+    Vec2 object_motion = TemporalAA::velocity(position, prev_position, second.view_projection, second.prev_view_projection);
+    Vec2 object_history = TemporalAA::project_to_uv(position, second.view_projection) - object_motion;
+    Vec2 object_expected = TemporalAA::project_to_uv(prev_position, first_view_projection);
+    CHECK(object_history.x == Catch::Approx(object_expected.x).margin(1e-5f));
+    CHECK(object_history.y == Catch::Approx(object_expected.y).margin(1e-5f));
+    CHECK(object_motion.y < motion.y);  // Up on screen is -v
+
+    // A still camera has no motion although the jitter changes every frame
+    Mat4 second_projection = second.projection;     // The views share the controller's storage
+    const TemporalAAView& third = taa.begin_frame(view, projection, RENDER_EXTENT, output);
+    Vec2 still_motion = TemporalAA::velocity(still, still, third.view_projection, third.prev_view_projection);
+    CHECK(still_motion.length() < 1e-6f);
+    CHECK_FALSE(third.projection == second_projection);
+
+    // The inverse unprojects the jittered sample back to the world
+    Vec4 clip = Vec4(still.x, still.y, still.z, 1.0f) * (view * third.projection);
+    Vec4 world = Vec4(clip.x / clip.w, clip.y / clip.w, clip.z / clip.w, 1.0f) * third.inv_view_projection;
+    CHECK(world.x / world.w == Catch::Approx(still.x).margin(1e-3f));
+    CHECK(world.z / world.w == Catch::Approx(still.z).margin(1e-2f));
+
+    // Resizing the output drops the history, as does a reset
+    CHECK_FALSE(taa.begin_frame(view, projection, RENDER_EXTENT, {1280, 720}).history_valid);
+    CHECK(taa.begin_frame(view, projection, RENDER_EXTENT, {1280, 720}).history_valid);
+    taa.reset();
+    CHECK_FALSE(taa.begin_frame(view, projection, RENDER_EXTENT, {1280, 720}).history_valid);
+
+    // Disabled: no jitter, no history, motion vectors still tracked
+    taa.set_enabled(false);
+    taa.begin_frame(view, projection, RENDER_EXTENT, output);
+    const TemporalAAView& plain = taa.begin_frame(view, projection, RENDER_EXTENT, output);
+    CHECK(plain.projection == projection);
+    CHECK_FALSE(plain.history_valid);
+    CHECK(plain.prev_view_projection == plain.view_projection);
+}
+
+TEST_CASE("Neighbourhood clipping and reconstruction weights", "[temporal_aa]") {
+    Vec3 box_min(0.2f, 0.2f, 0.2f);
+    Vec3 box_max(0.6f, 0.4f, 0.5f);
+
+    Vec3 inside(0.3f, 0.3f, 0.3f);
+    Vec3 kept = TemporalAA::clip_to_box(inside, box_min, box_max);
+    CHECK(kept.x == inside.x);
+    CHECK(kept.y == inside.y);
+    CHECK(kept.z == inside.z);
+
+    // Stale history is pulled onto the box along the line to its center
+    Vec3 stale(1.0f, 0.3f, 0.35f);
+    Vec3 clipped = TemporalAA::clip_to_box(stale, box_min, box_max);
+    CHECK(clipped.x == Catch::Approx(0.6f).margin(1e-4f));
+    CHECK(clipped.y == Catch::Approx(0.3f).margin(1e-4f));
+    CHECK(clipped.z == Catch::Approx(0.35f).margin(1e-4f));
+    Vec3 dark(0.0f, 0.0f, 0.0f);
+    Vec3 clipped_dark = TemporalAA::clip_to_box(dark, box_min, box_max);
+    CHECK(clipped_dark.y == Catch::Approx(0.2f).margin(1e-4f));
+    CHECK(clipped_dark.x >= box_min.x - 1e-4f);
+    CHECK(clipped_dark.z >= box_min.z - 1e-4f);
+
+    CHECK(TemporalAA::sample_weight(Vec2::Zero()) == 1.0f);
+    CHECK(TemporalAA::sample_weight(Vec2(0.5f, 0.0f)) > TemporalAA::sample_weight(Vec2(1.0f, 0.0f)));
+    CHECK(TemporalAA::sample_weight(Vec2(1.0f, 1.0f)) < 0.02f);
+}
+
+TEST_CASE("Jittered samples converge to pixel coverage", "[temporal_aa]") {
+    // One pixel crossed by a vertical edge: point samples left of it are lit. The jittered history
+    // converges to the covered fraction, which no single unjittered sample can produce.
+    TemporalAA taa;
+    const TemporalAASettings& settings = taa.get_settings();
+    for (float edge : {0.2f, 0.5f, 0.7f}) {
+        float history = 0.0f;
+        float sum = 0.0f;
+        uint32_t counted = 0;
+        for (uint32_t frame = 0; frame < 256; ++frame) {
+            Vec2 jitter = TemporalAA::jitter_offset(frame, settings.jitter_phases);
+            float sample = 0.5f + jitter.x < edge ? 1.0f : 0.0f;
+            history = frame == 0 ? sample : history * settings.history_weight + sample * (1.0f - settings.history_weight);
+            if (frame >= 128) {
+                sum += history;
+                counted++;
+            }
+        }
+        float resolved = sum / static_cast<float>(counted);
+        CHECK(resolved == Catch::Approx(edge).margin(0.13f));
+        INFO(LogTemporalAATest, "Edge at {:.2f}: resolved coverage {:.3f}", edge, resolved);
+    }
+}
@@ -8,6 +8,7 @@
 #include "engine/main/engine_context.h"
 #include "engine/function/render/render_system/render_system.h"
 #include "engine/function/render/render_system/render_mesh_manager.h"
+#include "engine/function/render/rhi/rhi.h"
 #include "engine/function/input/input.h"
 #include "engine/core/window/window.h"
 #include "engine/core/utils/profiler.h"
@@ -278,8 +279,10 @@ bool RenderTestApp::run(const Config& config, std::vector<uint8_t>& out_screensh
         EngineContext::world()->tick(0.016f);
         
         RenderPacket packet;
-        packet.active_camera = result.camera;
-        packet.active_scene = result.scene.get();
+        packet.editor_camera = result.camera;
+        packet.editor_scene = result.scene.get();
+        packet.scene = EngineContext::render_system()->extract_scene(
+            packet.editor_scene, packet.editor_camera, frames % FRAMES_IN_FLIGHT);
         packet.frame_index = frames % FRAMES_IN_FLIGHT;
         
         bool should_continue = EngineContext::render_system()->tick(packet);
@@ -308,4 +311,46 @@ bool RenderTestApp::run(const Config& config, std::vector<uint8_t>& out_screensh
     return screenshot_taken;
 }
 
+RHIBackendInfo make_null_backend_info() {
+    RHIBackendInfo info = {};
+    info.type = BACKEND_NULL;
+    info.enable_debug = false;
+    info.enable_ray_tracing = false;
+    return info;
+}
+
+Mat4 translation(const Vec3& position) {
+    Mat4 matrix = Mat4::Identity();
+    matrix.set_row(3, Vec4(position.x, position.y, position.z, 1.0f));
+    return matrix;
+}
+
+TestCamera make_camera(const Vec3& eye, const Vec3& target, float near_plane, float far_plane) {
+    TestCamera camera;
+    camera.view = Math::look_at(eye, target, Vec3::UnitY());
+    camera.projection = Math::perspective(Math::to_radians(60.0f), 16.0f / 9.0f, near_plane, far_plane);
+    return camera;
+}
+
+TestMesh make_sphere(uint32_t rings, uint32_t segments) {
+    TestMesh mesh;
+    for (uint32_t r = 0; r <= rings; ++r) {
+        float theta = PI * r / rings;
+        for (uint32_t s = 0; s <= segments; ++s) {
+            float phi = 2.0f * PI * s / segments;
+            mesh.positions.emplace_back(std::sin(theta) * std::cos(phi), std::cos(theta), std::sin(theta) * std::sin(phi));
+        }
+    }
+    for (uint32_t r = 0; r < rings; ++r) {
+        for (uint32_t s = 0; s < segments; ++s) {
+            uint32_t a = r * (segments + 1) + s;
+            uint32_t b = a + segments + 1;
+            mesh.indices.insert(mesh.indices.end(), { a, a + 1, b, a + 1, b + 1, b });
+        }
+    }
+    mesh.box = BoundingBox{ Vec3(-1.0f, -1.0f, -1.0f), Vec3(1.0f, 1.0f, 1.0f) };
+    mesh.sphere = BoundingSphere{ Vec3::Zero(), 1.0f };
+    return mesh;
+}
+
 } // namespace test_utils
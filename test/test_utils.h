@@ -10,12 +10,16 @@
 
 #include <stb_image_write.h>
 
+#include "engine/core/math/math.h"
+#include "engine/function/render/data/render_structs.h"
+
 // Forward declarations
 class Scene;
 class CameraComponent;
 struct RenderPacket;
 class RDGBuilder;
 struct CpuProfileFrame;
+struct RHIBackendInfo;
 
 namespace test_utils {
 
@@ -275,4 +279,44 @@ private:
     static std::string test_asset_dir_;
 };
 
+/**
+ * @brief Backend info that selects the null RHI backend (no device, no GPU required)
+ */
+RHIBackendInfo make_null_backend_info();
+
+/**
+ * @brief Distinct owner key for registries indexed by component pointer. Never dereferenced.
+ */
+template <typename T>
+T* fake_owner(uintptr_t id) {
+    return reinterpret_cast<T*>(id * 16);
+}
+
+/**
+ * @brief World matrix that only translates (row vectors, translation in the last row)
+ */
+Mat4 translation(const Vec3& position);
+
+struct TestCamera {
+    Mat4 view;
+    Mat4 projection;
+};
+
+/**
+ * @brief Camera at eye looking at target, 60 degree vertical field of view, 16:9
+ */
+TestCamera make_camera(const Vec3& eye, const Vec3& target, float near_plane = 0.1f, float far_plane = 1000.0f);
+
+struct TestMesh {
+    std::vector<Vec3> positions;
+    std::vector<uint32_t> indices;
+    BoundingBox box;
+    BoundingSphere sphere;
+};
+
+/**
+ * @brief UV sphere of unit radius at the origin, wound so front faces are clockwise seen from outside
+ */
+TestMesh make_sphere(uint32_t rings, uint32_t segments);
+
 } // namespace test_utils
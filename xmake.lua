@@ -7,6 +7,17 @@ add_requires("stb", "assimp", "cereal", "stduuid", "catch2")
 add_requires("imgui", {configs = {win32 = true, dx11 = true}})
 add_requires("imguizmo", {configs = {cxflags = "-DIMGUI_DEFINE_MATH_OPERATORS"}})
 
+-- 最小 Vulkan 后端 (engine/platform/vulkan)，xmake f --vulkan=y 开启
+option("vulkan")
+    set_default(false)
+    set_showmenu(true)
+    set_description("Build the minimal Vulkan RHI backend (BACKEND_VULKAN)")
+option_end()
+
+if has_config("vulkan") then
+    add_requires("vulkan-headers", "vulkan-loader", "shaderc")
+end
+
 set_encodings("utf-8")
 add_defines("UNICODE", "_UNICODE")
 -- clangd目前不支持cpp23：(看.clangd可以调整)
@@ -30,6 +41,13 @@ target("engine")
     add_packages("imgui", "imguizmo", "stb", "assimp", "cereal", "glog", "stduuid", {public = true} )
     add_syslinks("d3d11", "dxgi", "dxguid", "D3DCompiler", "d2d1", "dwrite", "winmm", "user32", "gdi32", "ole32")
 
+    if has_config("vulkan") then
+        add_packages("vulkan-headers", "vulkan-loader", "shaderc", {public = true})
+        add_defines("RENDERER_VULKAN", {public = true})
+    else
+        remove_files("engine/platform/vulkan/**.cpp")
+    end
+
     -- Compile shaders before building the engine
     -- before_build(function (target)
         